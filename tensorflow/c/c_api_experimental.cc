@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/c/c_api_experimental.h"
 
+#include <cstring>
+
 #include "absl/strings/substitute.h"
 #include "tensorflow/c/c_api.h"
 #include "tensorflow/c/c_api_internal.h"
@@ -47,6 +49,7 @@ limitations under the License.
 #include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/protobuf/tensorflow_server.pb.h"
+#include "tensorflow/core/util/overflow.h"
 
 using tensorflow::FunctionDef;
 using tensorflow::Node;
@@ -59,6 +62,10 @@ typedef std::unique_ptr<TF_Function, decltype(&TF_DeleteFunction)>
     UniqueFuncPtr;
 }
 
+namespace tensorflow {
+TF_Tensor* TF_TensorFromTensor(const Tensor& src, Status* status);
+}  // namespace tensorflow
+
 // struct TF_Operation { tensorflow::Node node; };
 static TF_Operation* ToTF_Operation(Node* node) {
   return static_cast<TF_Operation*>(static_cast<void*>(node));
@@ -324,6 +331,136 @@ void TF_EnqueueNamedTensor(TF_Session* session, int tensor_id,
   VLOG(1) << "Enqueuing is done.";
 }
 
+void TF_NewTensorBatch(const void* data, size_t data_len,
+                       const TF_TensorDesc* descs, int num_tensors,
+                       TF_Tensor** out_tensors, TF_Status* status) {
+  TF_SetStatus(status, TF_OK, "");
+  for (int i = 0; i < num_tensors; ++i) {
+    out_tensors[i] = nullptr;
+  }
+  auto delete_created = [&](int created) {
+    for (int i = 0; i < created; ++i) {
+      TF_DeleteTensor(out_tensors[i]);
+      out_tensors[i] = nullptr;
+    }
+  };
+  for (int i = 0; i < num_tensors; ++i) {
+    const TF_TensorDesc& desc = descs[i];
+    const size_t elem_size = TF_DataTypeSize(desc.dtype);
+    if (elem_size == 0) {
+      status->status = InvalidArgument(
+          "Tensor ", i, " in the batch has dtype ", desc.dtype,
+          ", which has no fixed element size and cannot be packed.");
+      delete_created(i);
+      return;
+    }
+    int64_t num_elements = 1;
+    for (int d = 0; d < desc.num_dims; ++d) {
+      if (desc.dims[d] < 0) {
+        status->status = InvalidArgument("Tensor ", i,
+                                         " in the batch has negative dimension ",
+                                         desc.dims[d]);
+        delete_created(i);
+        return;
+      }
+      num_elements = tensorflow::MultiplyWithoutOverflow(num_elements,
+                                                         desc.dims[d]);
+      if (num_elements < 0) {
+        status->status =
+            InvalidArgument("Tensor ", i, " in the batch is too large.");
+        delete_created(i);
+        return;
+      }
+    }
+    if (desc.num_bytes != static_cast<size_t>(num_elements) * elem_size) {
+      status->status = InvalidArgument(
+          "Tensor ", i, " in the batch declares ", desc.num_bytes,
+          " bytes, but its dtype and shape require ",
+          static_cast<size_t>(num_elements) * elem_size, " bytes.");
+      delete_created(i);
+      return;
+    }
+    if (desc.offset > data_len || desc.num_bytes > data_len - desc.offset) {
+      status->status = InvalidArgument(
+          "Tensor ", i, " in the batch lies outside of the packed buffer: ",
+          "offset ", desc.offset, " + ", desc.num_bytes, " bytes > buffer of ",
+          data_len, " bytes.");
+      delete_created(i);
+      return;
+    }
+    out_tensors[i] =
+        TF_AllocateTensor(desc.dtype, desc.dims, desc.num_dims, desc.num_bytes);
+    memcpy(TF_TensorData(out_tensors[i]),
+           static_cast<const char*>(data) + desc.offset, desc.num_bytes);
+  }
+}
+
+void TF_SessionRunBatch(TF_Session* session, const TF_Buffer* run_options,
+                        const TF_Output* inputs,
+                        TF_Tensor* const* input_values, int ninputs,
+                        const TF_Output* outputs, TF_Tensor** output_values,
+                        int noutputs, const TF_Operation* const* target_opers,
+                        int ntargets, int num_requests, TF_Status* status) {
+  using tensorflow::RunMetadata;
+  using tensorflow::RunOptions;
+  using tensorflow::Tensor;
+  using tensorflow::strings::StrCat;
+
+  TF_SetStatus(status, TF_OK, "");
+  for (int i = 0; i < num_requests * noutputs; ++i) {
+    output_values[i] = nullptr;
+  }
+
+  // The per-call setup of TF_SessionRun happens once for the whole batch:
+  // the graph is extended, the feed/fetch/target names are resolved and the
+  // RunOptions proto is parsed a single time.
+  if (session->extend_before_run &&
+      !tensorflow::ExtendSessionGraphHelper(session, status)) {
+    return;
+  }
+  RunOptions run_options_proto;
+  if (run_options != nullptr && !run_options_proto.ParseFromArray(
+                                    run_options->data, run_options->length)) {
+    status->status = InvalidArgument("Unparseable RunOptions proto");
+    return;
+  }
+  std::vector<std::string> input_names(ninputs);
+  for (int i = 0; i < ninputs; ++i) {
+    input_names[i] = StrCat(inputs[i].oper->node.name(), ":", inputs[i].index);
+  }
+  std::vector<std::string> output_names(noutputs);
+  for (int i = 0; i < noutputs; ++i) {
+    output_names[i] =
+        StrCat(outputs[i].oper->node.name(), ":", outputs[i].index);
+  }
+  std::vector<std::string> target_names(ntargets);
+  for (int i = 0; i < ntargets; ++i) {
+    target_names[i] = target_opers[i]->node.name();
+  }
+
+  for (int r = 0; r < num_requests; ++r) {
+    std::vector<std::pair<std::string, Tensor>> input_pairs(ninputs);
+    for (int i = 0; i < ninputs; ++i) {
+      input_pairs[i].first = input_names[i];
+      status->status = tensorflow::TF_TensorToTensor(
+          input_values[r * ninputs + i], &input_pairs[i].second);
+      if (!status->status.ok()) return;
+    }
+    std::vector<Tensor> request_outputs;
+    RunMetadata run_metadata_proto;
+    status->status =
+        session->session->Run(run_options_proto, input_pairs, output_names,
+                              target_names, &request_outputs,
+                              &run_metadata_proto);
+    if (!status->status.ok()) return;
+    for (int i = 0; i < noutputs; ++i) {
+      output_values[r * noutputs + i] =
+          tensorflow::TF_TensorFromTensor(request_outputs[i], &status->status);
+      if (!status->status.ok()) return;
+    }
+  }
+}
+
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status) {
   tensorflow::ServerDef server_def;
   if (!tensorflow::protobuf::TextFormat::ParseFromString(text_proto,
@@ -129,6 +129,49 @@ TF_CAPI_EXPORT extern void TF_EnqueueNamedTensor(TF_Session* session,
                                                  int tensor_id,
                                                  TF_Tensor* tensor,
                                                  TF_Status* status);
+
+// Describes one tensor to be created by TF_NewTensorBatch from a packed
+// buffer: `num_bytes` bytes of `dtype` data starting `offset` bytes into the
+// buffer, with shape `dims`. Only dtypes with a fixed per-element size can be
+// packed (in particular not TF_STRING, TF_RESOURCE or TF_VARIANT).
+typedef struct TF_TensorDesc {
+  TF_DataType dtype;
+  const int64_t* dims;
+  int num_dims;
+  uint64_t offset;
+  size_t num_bytes;
+} TF_TensorDesc;
+
+// Creates `num_tensors` tensors from the packed buffer `data` of `data_len`
+// bytes, as described by `descs`, storing them in `out_tensors`. Language
+// bindings with many small inputs can pack them on their side of the FFI
+// boundary and pay a single crossing instead of one TF_NewTensor call per
+// tensor. Each tensor owns a copy of its slice of the buffer, so `data` may
+// be reused or freed as soon as this returns; the caller must eventually
+// call TF_DeleteTensor on each created tensor. On failure, sets `status`,
+// stores nullptr in every `out_tensors` slot and creates nothing.
+TF_CAPI_EXPORT extern void TF_NewTensorBatch(const void* data, size_t data_len,
+                                             const TF_TensorDesc* descs,
+                                             int num_tensors,
+                                             TF_Tensor** out_tensors,
+                                             TF_Status* status);
+
+// Runs `num_requests` executions of the graph in `session` with one call,
+// sharing the per-call setup (graph extension, feed/fetch name resolution
+// and RunOptions parsing) across the whole batch. All requests use the same
+// feeds `inputs`, fetches `outputs` and targets `target_opers`; request r
+// feeds the `ninputs` tensors at `input_values[r * ninputs]` and stores its
+// fetched tensors at `output_values[r * noutputs]`, which the caller takes
+// ownership of as with TF_SessionRun. Requests run sequentially; on the
+// first failure `status` is set, the remaining requests are not run, and the
+// output slots of the failed and skipped requests hold nullptr.
+TF_CAPI_EXPORT extern void TF_SessionRunBatch(
+    TF_Session* session, const TF_Buffer* run_options, const TF_Output* inputs,
+    TF_Tensor* const* input_values, int ninputs, const TF_Output* outputs,
+    TF_Tensor** output_values, int noutputs,
+    const TF_Operation* const* target_opers, int ntargets, int num_requests,
+    TF_Status* status);
+
 // Create a serialized tensorflow.ServerDef proto.
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status);
 
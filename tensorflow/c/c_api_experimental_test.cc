@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/c/c_api_experimental.h"
 
+#include <cstring>
+
 #include "absl/types/optional.h"
 #include "tensorflow/c/c_api.h"
 #include "tensorflow/c/c_api_internal.h"
@@ -361,5 +363,91 @@ TEST_F(CApiExperimentalFunctionTest, GraphRemoveNonExistentFunction) {
   TF_DeleteFunction(funcs[0]);
 }
 
+TEST(CAPI_EXPERIMENTAL, NewTensorBatchPacksBuffer) {
+  // Two tensors packed back to back in one buffer: three int32s followed by
+  // two floats.
+  const int32_t ints[3] = {1, 2, 3};
+  const float floats[2] = {1.5f, 2.5f};
+  char buffer[sizeof(ints) + sizeof(floats)];
+  memcpy(buffer, ints, sizeof(ints));
+  memcpy(buffer + sizeof(ints), floats, sizeof(floats));
+
+  const int64_t int_dims[1] = {3};
+  const int64_t float_dims[1] = {2};
+  TF_TensorDesc descs[2];
+  descs[0] = {TF_INT32, int_dims, 1, 0, sizeof(ints)};
+  descs[1] = {TF_FLOAT, float_dims, 1, sizeof(ints), sizeof(floats)};
+
+  TF_Status* s = TF_NewStatus();
+  TF_Tensor* tensors[2] = {nullptr, nullptr};
+  TF_NewTensorBatch(buffer, sizeof(buffer), descs, 2, tensors, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  ASSERT_EQ(TF_INT32, TF_TensorType(tensors[0]));
+  ASSERT_EQ(1, TF_NumDims(tensors[0]));
+  EXPECT_EQ(3, TF_Dim(tensors[0], 0));
+  EXPECT_EQ(0, memcmp(TF_TensorData(tensors[0]), ints, sizeof(ints)));
+  ASSERT_EQ(TF_FLOAT, TF_TensorType(tensors[1]));
+  EXPECT_EQ(0, memcmp(TF_TensorData(tensors[1]), floats, sizeof(floats)));
+  TF_DeleteTensor(tensors[0]);
+  TF_DeleteTensor(tensors[1]);
+
+  // A descriptor whose byte count disagrees with its dtype and shape fails
+  // the whole batch and leaves every slot empty.
+  descs[1].num_bytes = sizeof(floats) - 1;
+  TF_NewTensorBatch(buffer, sizeof(buffer), descs, 2, tensors, s);
+  EXPECT_EQ(TF_INVALID_ARGUMENT, TF_GetCode(s));
+  EXPECT_EQ(nullptr, tensors[0]);
+  EXPECT_EQ(nullptr, tensors[1]);
+
+  // Variable-length dtypes cannot be packed.
+  descs[1] = {TF_STRING, float_dims, 1, sizeof(ints), sizeof(floats)};
+  TF_NewTensorBatch(buffer, sizeof(buffer), descs, 2, tensors, s);
+  EXPECT_EQ(TF_INVALID_ARGUMENT, TF_GetCode(s));
+  EXPECT_EQ(nullptr, tensors[0]);
+  TF_DeleteStatus(s);
+}
+
+TEST(CAPI_EXPERIMENTAL, SessionRunBatch) {
+  TF_Status* s = TF_NewStatus();
+  TF_Graph* graph = TF_NewGraph();
+  TF_Operation* feed = Placeholder(graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_Operation* two = ScalarConst(2, graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_Operation* add = Add(feed, two, graph, s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  TF_SessionOptions* opts = TF_NewSessionOptions();
+  TF_Session* session = TF_NewSession(graph, opts, s);
+  TF_DeleteSessionOptions(opts);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+
+  constexpr int kNumRequests = 3;
+  TF_Output feed_out = {feed, 0};
+  TF_Output add_out = {add, 0};
+  TF_Tensor* inputs[kNumRequests] = {Int32Tensor(10), Int32Tensor(20),
+                                     Int32Tensor(30)};
+  TF_Tensor* outputs[kNumRequests] = {nullptr, nullptr, nullptr};
+  TF_SessionRunBatch(session, /*run_options=*/nullptr, &feed_out, inputs,
+                     /*ninputs=*/1, &add_out, outputs, /*noutputs=*/1,
+                     /*target_opers=*/nullptr, /*ntargets=*/0, kNumRequests,
+                     s);
+  ASSERT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  for (int r = 0; r < kNumRequests; ++r) {
+    ASSERT_NE(nullptr, outputs[r]);
+    EXPECT_EQ(10 * (r + 1) + 2,
+              *static_cast<int32_t*>(TF_TensorData(outputs[r])));
+    TF_DeleteTensor(inputs[r]);
+    TF_DeleteTensor(outputs[r]);
+  }
+
+  TF_CloseSession(session, s);
+  EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteSession(session, s);
+  EXPECT_EQ(TF_OK, TF_GetCode(s)) << TF_Message(s);
+  TF_DeleteGraph(graph);
+  TF_DeleteStatus(s);
+}
+
 }  // namespace
 }  // namespace tensorflow
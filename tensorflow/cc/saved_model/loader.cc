@@ -17,7 +17,9 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -32,7 +34,15 @@ limitations under the License.
 #include "tensorflow/core/framework/graph_debug_info.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/op_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/grappler/clusters/utils.h"
+#include "tensorflow/core/grappler/clusters/virtual_cluster.h"
+#include "tensorflow/core/grappler/costs/analytical_cost_estimator.h"
+#include "tensorflow/core/grappler/costs/cost_estimator.h"
+#include "tensorflow/core/grappler/grappler_item.h"
 #include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/sampler.h"
@@ -42,10 +52,13 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system_helper.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/protobuf/device_properties.pb.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/protobuf/saver.pb.h"
+#include "tensorflow/core/protobuf/signature_cost_report.pb.h"
 #include "tensorflow/core/public/session.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_bundle/naming.h"
 
 namespace tensorflow {
@@ -266,6 +279,57 @@ Status RunRestore(const RunOptions& run_options, const string& export_dir,
                  nullptr /* outputs */, &run_metadata, session);
 }
 
+// Returns `session_options`, with XLA CPU JIT enabled on the session's
+// optimizer options when TF_SAVED_MODEL_XLA_CPU_JIT=1 is set in the
+// environment. This compiles eligible static-shape subgraphs of the loaded
+// model without any change to how models are published; pointing
+// --tf_xla_persistent_cache_directory at a disk location additionally makes
+// later loads bind to the already-compiled executables instead of
+// recompiling.
+SessionOptions MaybeEnableXlaCpuJit(const SessionOptions& session_options) {
+  bool enable_xla_cpu_jit = false;
+  Status s = ReadBoolFromEnvVar("TF_SAVED_MODEL_XLA_CPU_JIT",
+                                /*default_val=*/false, &enable_xla_cpu_jit);
+  if (!s.ok()) {
+    LOG(WARNING) << "Invalid TF_SAVED_MODEL_XLA_CPU_JIT: " << s;
+  }
+  SessionOptions options = session_options;
+  if (enable_xla_cpu_jit) {
+    OptimizerOptions* optimizer_options =
+        options.config.mutable_graph_options()->mutable_optimizer_options();
+    optimizer_options->set_global_jit_level(OptimizerOptions::ON_1);
+    optimizer_options->set_cpu_global_jit(true);
+  }
+  return options;
+}
+
+// Logs per-signature memory and latency budget estimates when
+// TF_SAVED_MODEL_SIGNATURE_COST_REPORT=1 is set in the environment.
+void MaybeLogSignatureCostReport(const MetaGraphDef& meta_graph) {
+  bool enable_cost_report = false;
+  Status s = ReadBoolFromEnvVar("TF_SAVED_MODEL_SIGNATURE_COST_REPORT",
+                                /*default_val=*/false, &enable_cost_report);
+  if (!s.ok()) {
+    LOG(WARNING) << "Invalid TF_SAVED_MODEL_SIGNATURE_COST_REPORT: " << s;
+  }
+  if (!enable_cost_report) return;
+  SignatureCostReport report;
+  s = EstimateSignatureCosts(meta_graph, &report);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to estimate signature costs: " << s;
+    return;
+  }
+  for (const auto& estimate : report.signature_costs()) {
+    LOG(INFO) << "Signature '" << estimate.signature_key()
+              << "': estimated latency " << estimate.estimated_latency_us()
+              << "us, peak memory " << estimate.peak_memory_bytes()
+              << " bytes (persistent " << estimate.persistent_memory_bytes()
+              << " bytes), " << estimate.num_ops() << " ops ("
+              << estimate.num_ops_with_unknown_shapes()
+              << " with unknown shapes)";
+  }
+}
+
 }  // namespace
 
 SavedModelBundleInterface::~SavedModelBundleInterface() = default;
@@ -274,7 +338,8 @@ Status LoadMetagraphIntoSession(const SessionOptions& session_options,
                                 const MetaGraphDef& meta_graph,
                                 std::unique_ptr<Session>* session) {
   Session* session_p = nullptr;
-  TF_RETURN_IF_ERROR(NewSession(session_options, &session_p));
+  TF_RETURN_IF_ERROR(
+      NewSession(MaybeEnableXlaCpuJit(session_options), &session_p));
   session->reset(session_p);
   TF_RETURN_IF_ERROR(ValidateSavedTensors(meta_graph.graph_def()));
   return (*session)->Create(meta_graph.graph_def());
@@ -284,21 +349,39 @@ Status LoadSavedModelInternal(const SessionOptions& session_options,
                               const RunOptions& run_options,
                               const string& export_dir,
                               const std::unordered_set<string>& tags,
+                              const std::unordered_set<string>& signature_keys,
                               SavedModelBundle* const bundle) {
   TF_RETURN_IF_ERROR(ReadMetaGraphDefFromSavedModel(export_dir, tags,
                                                     &bundle->meta_graph_def));
-  TF_RETURN_IF_ERROR(
-      ReadSavedModelDebugInfoIfPresent(export_dir, &bundle->debug_info));
-  TF_RETURN_IF_ERROR(LoadMetagraphIntoSession(
-      session_options, bundle->meta_graph_def, &bundle->session));
-  TF_RETURN_IF_ERROR(RestoreSession(run_options, bundle->meta_graph_def,
-                                    export_dir, &bundle->session));
-  return OkStatus();
+  if (!signature_keys.empty()) {
+    TF_RETURN_IF_ERROR(internal::PruneMetaGraphDefForSignatures(
+        export_dir, signature_keys, &bundle->meta_graph_def));
+  }
+  // The (possibly large) debug info only shares the export dir with session
+  // creation and variable restore, so read it in parallel with them.
+  Status debug_info_status;
+  std::unique_ptr<Thread> debug_info_thread(Env::Default()->StartThread(
+      ThreadOptions(), "saved_model_debug_info",
+      [&export_dir, &debug_info_status, bundle] {
+        debug_info_status =
+            ReadSavedModelDebugInfoIfPresent(export_dir, &bundle->debug_info);
+      }));
+  Status load_status = LoadMetagraphIntoSession(
+      session_options, bundle->meta_graph_def, &bundle->session);
+  if (load_status.ok()) {
+    load_status = RestoreSession(run_options, bundle->meta_graph_def,
+                                 export_dir, &bundle->session);
+  }
+  // Join the debug info read before returning the bundle.
+  debug_info_thread.reset();
+  TF_RETURN_IF_ERROR(load_status);
+  return debug_info_status;
 }
 
 Status LoadSavedModel(const SessionOptions& session_options,
                       const RunOptions& run_options, const string& export_dir,
                       const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
                       SavedModelBundle* const bundle) {
   metrics::SavedModelReadApi(kCCLoadLabel).IncrementBy(1);
   auto fingerprint_proto =
@@ -311,8 +394,9 @@ Status LoadSavedModel(const SessionOptions& session_options,
 
   // TODO(robson): Add tests for the counters.
   const uint64 start_microseconds = Env::Default()->NowMicros();
-  const Status status = LoadSavedModelInternal(session_options, run_options,
-                                               export_dir, tags, bundle);
+  const Status status =
+      LoadSavedModelInternal(session_options, run_options, export_dir, tags,
+                             signature_keys, bundle);
   auto log_and_count = [&](const string& status_str) {
     LOG(INFO) << "SavedModel load for tags { " << absl::StrJoin(tags, " ")
               << " }; Status: " << status_str << ": " << status << ". Took "
@@ -322,6 +406,7 @@ Status LoadSavedModel(const SessionOptions& session_options,
   if (status.ok()) {
     log_and_count(kLoadAttemptSuccess);
     metrics::SavedModelReadPath().Set(export_dir);
+    MaybeLogSignatureCostReport(bundle->meta_graph_def);
   } else {
     log_and_count(kLoadAttemptFail);
   }
@@ -330,6 +415,14 @@ Status LoadSavedModel(const SessionOptions& session_options,
   return status;
 }
 
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      SavedModelBundle* const bundle) {
+  return LoadSavedModel(session_options, run_options, export_dir, tags,
+                        /*signature_keys=*/{}, bundle);
+}
+
 namespace {
 // Session wrapper that prevents calls to Session::Create(), Session::Extend(),
 // and the deprecated partial-run methods.
@@ -475,6 +568,7 @@ Status RestoreSession(const RunOptions& run_options,
 Status LoadSavedModel(const SessionOptions& session_options,
                       const RunOptions& run_options, const string& export_dir,
                       const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
                       SavedModelBundleLite* const bundle) {
   SavedModelBundle legacy_bundle;
   SessionOptions rewritten_options(session_options);
@@ -490,13 +584,100 @@ Status LoadSavedModel(const SessionOptions& session_options,
   // TODO(mrry): Consider specializing the session creation to reduce peak
   // RAM consumption by using `Session::Create(GraphDef&&)`.
   TF_RETURN_IF_ERROR(LoadSavedModel(rewritten_options, run_options, export_dir,
-                                    tags, &legacy_bundle));
+                                    tags, signature_keys, &legacy_bundle));
   *bundle = SavedModelBundleLite(
       std::make_unique<LiteSessionWrapper>(std::move(legacy_bundle.session)),
       std::move(*legacy_bundle.meta_graph_def.mutable_signature_def()));
   return OkStatus();
 }
 
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      SavedModelBundleLite* const bundle) {
+  return LoadSavedModel(session_options, run_options, export_dir, tags,
+                        /*signature_keys=*/{}, bundle);
+}
+
+Status EstimateSignatureCosts(const MetaGraphDef& meta_graph,
+                              SignatureCostReport* report) {
+  // All estimates are computed against the properties of the local CPU. The
+  // relative sizes of the signatures, which is what bin-packing needs, do not
+  // depend much on the exact host the analysis runs on.
+  std::unordered_map<string, DeviceProperties> devices;
+  devices["/job:localhost/replica:0/task:0/device:CPU:0"] =
+      grappler::GetLocalCPUInfo();
+  grappler::VirtualCluster cluster(devices);
+  for (const auto& entry : meta_graph.signature_def()) {
+    const string& signature_key = entry.first;
+    const SignatureDef& signature = entry.second;
+    if (signature.outputs().empty()) continue;
+    grappler::GrapplerItem item;
+    item.id = signature_key;
+    item.graph = meta_graph.graph_def();
+    bool supported = true;
+    for (const auto& input : signature.inputs()) {
+      const TensorInfo& info = input.second;
+      if (info.encoding_case() != TensorInfo::kName ||
+          info.dtype() == DT_INVALID) {
+        supported = false;
+        break;
+      }
+      // Signatures declare partial shapes; pin unknown dimensions (typically
+      // the batch dimension) to 1 so that static shape inference can
+      // propagate fully defined shapes through the graph.
+      TensorShape shape;
+      if (!info.tensor_shape().unknown_rank()) {
+        for (const auto& dim : info.tensor_shape().dim()) {
+          shape.AddDim(dim.size() >= 0 ? dim.size() : 1);
+        }
+      }
+      item.feed.emplace_back(info.name(), Tensor(info.dtype(), shape));
+    }
+    for (const auto& output : signature.outputs()) {
+      if (output.second.encoding_case() != TensorInfo::kName) {
+        supported = false;
+        break;
+      }
+      item.fetch.push_back(output.second.name());
+    }
+    if (!supported) {
+      VLOG(1) << "Skipping cost estimate for signature '" << signature_key
+              << "': inputs or outputs are not plain tensors.";
+      continue;
+    }
+    grappler::AnalyticalCostEstimator estimator(
+        &cluster, /*use_static_shapes=*/true,
+        /*use_aggressive_shape_inference=*/true);
+    grappler::Costs costs;
+    Status s = estimator.Initialize(item);
+    if (s.ok()) {
+      s = estimator.PredictCosts(item.graph, /*run_metadata=*/nullptr, &costs);
+    }
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to estimate costs for signature '"
+                   << signature_key << "': " << s;
+      continue;
+    }
+    SignatureCostEstimate* estimate = report->add_signature_costs();
+    estimate->set_signature_key(signature_key);
+    estimate->set_estimated_latency_us(
+        costs.execution_time.asMicroSeconds().count());
+    estimate->set_estimated_compute_us(
+        costs.compute_time.asMicroSeconds().count());
+    estimate->set_estimated_memory_access_us(
+        costs.memory_time.asMicroSeconds().count());
+    estimate->set_peak_memory_bytes(costs.max_memory);
+    estimate->set_persistent_memory_bytes(costs.persistent_memory);
+    estimate->set_temporary_memory_bytes(costs.temporary_memory);
+    estimate->set_num_ops(costs.num_ops_total);
+    estimate->set_num_ops_with_unknown_shapes(
+        costs.num_ops_with_unknown_shapes);
+    estimate->set_inaccurate(costs.inaccurate);
+  }
+  return OkStatus();
+}
+
 bool MaybeSavedModelDirectory(const string& export_dir) {
   const string saved_model_pb_path =
       io::JoinPath(export_dir, kSavedModelFilenamePb);
@@ -24,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph_debug_info.pb.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
+#include "tensorflow/core/protobuf/signature_cost_report.pb.h"
 #include "tensorflow/core/public/session.h"
 
 namespace tensorflow {
@@ -135,6 +136,38 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundleLite* bundle);
 
+/// Like the overloads above, but only materializes the portion of the model
+/// needed to serve `signature_keys`: the graph is pruned to the nodes
+/// reachable from the requested signatures (plus the init op and asset
+/// feeds), and only checkpoint restore paths feeding the surviving variables
+/// are run. The bundle's signature map contains only the requested keys.
+/// Returns NotFound if a requested signature does not exist. An empty
+/// `signature_keys` set loads the full model.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundle* bundle);
+
+/// As above, for a SavedModelBundleLite.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundleLite* bundle);
+
+/// Estimates per-signature resource budgets for the given MetaGraphDef using
+/// the grappler analytical cost model: peak-memory, persistent-memory and
+/// latency estimates computed from the signatures' declared input shapes
+/// (unknown dimensions are pinned to 1). Deployment controllers can use the
+/// resulting report to bin-pack models onto hosts before directing traffic at
+/// them. Signatures whose inputs or outputs are not plain tensors are skipped.
+/// Also runs automatically after a successful LoadSavedModel, with the report
+/// written to the INFO log, when TF_SAVED_MODEL_SIGNATURE_COST_REPORT=1 is set
+/// in the environment.
+Status EstimateSignatureCosts(const MetaGraphDef& meta_graph,
+                              SignatureCostReport* report);
+
 /// Checks whether the provided directory could contain a SavedModel. Note that
 /// the method does not load any data by itself. If the method returns `false`,
 /// the export directory definitely does not contain a SavedModel. If the method
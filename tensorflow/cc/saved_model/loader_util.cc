@@ -15,15 +15,59 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/loader_util.h"
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/cc/saved_model/constants.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/protobuf_internal.h"
 
 namespace tensorflow {
 namespace internal {
+namespace {
+
+// Returns the name of the node producing `input`, stripping a control-edge
+// marker and output slot if present (e.g. "^save/Assign" or "mul:0").
+string NodeNameFromInput(const string& input) {
+  size_t start = (!input.empty() && input[0] == '^') ? 1 : 0;
+  size_t end = input.find(':', start);
+  if (end == string::npos) {
+    return input.substr(start);
+  }
+  return input.substr(start, end - start);
+}
+
+// Collects all graph tensor names referenced by `info`, covering the dense,
+// sparse and composite tensor encodings.
+void CollectTensorInfoNames(const TensorInfo& info,
+                            std::vector<string>* names) {
+  switch (info.encoding_case()) {
+    case TensorInfo::kName:
+      names->push_back(info.name());
+      break;
+    case TensorInfo::kCooSparse:
+      names->push_back(info.coo_sparse().values_tensor_name());
+      names->push_back(info.coo_sparse().indices_tensor_name());
+      names->push_back(info.coo_sparse().dense_shape_tensor_name());
+      break;
+    case TensorInfo::kCompositeTensor:
+      for (const auto& component : info.composite_tensor().components()) {
+        names->push_back(component.name());
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
 
 // A SavedModel may store the name of the initialization op to run in the
 // in the SignatureDef (v2) or a collection (v1). If an init_op collection
@@ -91,5 +135,160 @@ Status GetAssetFileDefs(const MetaGraphDef& meta_graph_def,
   return OkStatus();
 }
 
+Status PruneMetaGraphDefForSignatures(
+    const string& export_dir, const std::unordered_set<string>& signature_keys,
+    MetaGraphDef* meta_graph_def) {
+  GraphDef* graph_def = meta_graph_def->mutable_graph_def();
+  std::unordered_map<string, const NodeDef*> nodes_by_name;
+  nodes_by_name.reserve(graph_def->node_size());
+  for (const NodeDef& node : graph_def->node()) {
+    nodes_by_name[node.name()] = &node;
+  }
+
+  // The roots of the subgraph to keep: the requested signatures' inputs and
+  // outputs, the init op, and the asset feed tensors it consumes.
+  std::vector<string> tensor_roots;
+  for (const string& key : signature_keys) {
+    const auto sig_it = meta_graph_def->signature_def().find(key);
+    if (sig_it == meta_graph_def->signature_def().end()) {
+      return errors::NotFound("Could not find signature with key: ", key);
+    }
+    for (const auto& entry : sig_it->second.inputs()) {
+      CollectTensorInfoNames(entry.second, &tensor_roots);
+    }
+    for (const auto& entry : sig_it->second.outputs()) {
+      CollectTensorInfoNames(entry.second, &tensor_roots);
+    }
+  }
+  string init_op_name;
+  TF_RETURN_IF_ERROR(GetInitOp(export_dir, *meta_graph_def, &init_op_name));
+  if (!init_op_name.empty()) {
+    tensor_roots.push_back(init_op_name);
+  }
+  std::vector<AssetFileDef> asset_file_defs;
+  TF_RETURN_IF_ERROR(GetAssetFileDefs(*meta_graph_def, &asset_file_defs));
+  for (const AssetFileDef& asset : asset_file_defs) {
+    tensor_roots.push_back(asset.tensor_info().name());
+  }
+
+  // Backward closure over the graph from the roots.
+  std::unordered_set<string> keep;
+  std::vector<string> stack;
+  stack.reserve(tensor_roots.size());
+  for (const string& tensor : tensor_roots) {
+    stack.push_back(NodeNameFromInput(tensor));
+  }
+  while (!stack.empty()) {
+    const string name = std::move(stack.back());
+    stack.pop_back();
+    if (!keep.insert(name).second) {
+      continue;
+    }
+    const auto node_it = nodes_by_name.find(name);
+    if (node_it == nodes_by_name.end()) {
+      return errors::NotFound("Signature or init op references node \"", name,
+                              "\" which does not exist in the graph.");
+    }
+    for (const string& input : node_it->second->input()) {
+      stack.push_back(NodeNameFromInput(input));
+    }
+  }
+
+  // Keep the saver's restore machinery, restricted to assignments whose
+  // target variable survived the signature closure. Restore paths that feed
+  // only pruned variables are dropped entirely, so their checkpoint reads
+  // never run. Note that a sharded RestoreV2 op shared by several variables
+  // is kept as soon as one of them is kept.
+  if (meta_graph_def->has_saver_def()) {
+    stack.push_back(
+        NodeNameFromInput(meta_graph_def->saver_def().filename_tensor_name()));
+    stack.push_back(
+        NodeNameFromInput(meta_graph_def->saver_def().restore_op_name()));
+    while (!stack.empty()) {
+      const string name = std::move(stack.back());
+      stack.pop_back();
+      if (keep.count(name) > 0) {
+        continue;
+      }
+      const auto node_it = nodes_by_name.find(name);
+      if (node_it == nodes_by_name.end()) {
+        return errors::NotFound("Saver references node \"", name,
+                                "\" which does not exist in the graph.");
+      }
+      const NodeDef& node = *node_it->second;
+      if (node.op() == "Assign" || node.op() == "AssignVariableOp") {
+        // input(0) is the variable being restored; skip the whole
+        // assignment if the variable was pruned.
+        if (node.input_size() < 1 ||
+            keep.count(NodeNameFromInput(node.input(0))) == 0) {
+          continue;
+        }
+      }
+      keep.insert(name);
+      for (const string& input : node.input()) {
+        stack.push_back(NodeNameFromInput(input));
+      }
+    }
+  }
+
+  // Rewrite the graph with only the kept nodes. Control inputs referencing
+  // pruned nodes (e.g. the saver's grouping NoOps) are filtered out; data
+  // inputs must all have been kept by the closure above, which is verified
+  // as we go.
+  protobuf::RepeatedPtrField<NodeDef> pruned_nodes;
+  pruned_nodes.Reserve(keep.size());
+  for (NodeDef& node : *graph_def->mutable_node()) {
+    if (keep.count(node.name()) == 0) {
+      continue;
+    }
+    NodeDef* kept_node = pruned_nodes.Add();
+    *kept_node = std::move(node);
+    auto* inputs = kept_node->mutable_input();
+    for (int i = inputs->size() - 1; i >= 0; --i) {
+      const string& input = inputs->Get(i);
+      if (keep.count(NodeNameFromInput(input)) > 0) {
+        continue;
+      }
+      if (input.empty() || input[0] != '^') {
+        return errors::FailedPrecondition(
+            "Cannot prune SavedModel for the requested signatures: node \"",
+            kept_node->name(), "\" consumes data from pruned node \"", input,
+            "\".");
+      }
+      inputs->erase(inputs->begin() + i);
+    }
+    // Drop colocation constraints on pruned nodes.
+    auto attr_it = kept_node->mutable_attr()->find("_class");
+    if (attr_it != kept_node->mutable_attr()->end()) {
+      auto* classes = attr_it->second.mutable_list()->mutable_s();
+      for (int i = classes->size() - 1; i >= 0; --i) {
+        const string& loc = classes->Get(i);
+        if (loc.compare(0, 5, "loc:@") == 0 &&
+            keep.count(loc.substr(5)) == 0) {
+          classes->erase(classes->begin() + i);
+        }
+      }
+    }
+  }
+  const int original_node_count = graph_def->node_size();
+  graph_def->mutable_node()->Swap(&pruned_nodes);
+  LOG(INFO) << "Pruned SavedModel graph from " << original_node_count << " to "
+            << graph_def->node_size() << " nodes for " << signature_keys.size()
+            << " requested signature(s).";
+
+  // Reduce the signature map to the requested keys. The init-op signature is
+  // retained since RestoreSession looks the init op up again.
+  auto* signature_def_map = meta_graph_def->mutable_signature_def();
+  for (auto it = signature_def_map->begin(); it != signature_def_map->end();) {
+    if (signature_keys.count(it->first) == 0 &&
+        it->first != kSavedModelInitOpSignatureKey) {
+      it = signature_def_map->erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return OkStatus();
+}
+
 }  // namespace internal
 }  // namespace tensorflow
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CC_SAVED_MODEL_LOADER_UTIL_H_
 
 #include <string>
+#include <unordered_set>
 
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
@@ -33,6 +34,17 @@ Status GetInitOp(const string& export_dir, const MetaGraphDef& meta_graph_def,
 Status GetAssetFileDefs(const MetaGraphDef& meta_graph_def,
                         std::vector<AssetFileDef>* asset_file_defs);
 
+// Prunes `meta_graph_def` in place to the subgraph needed to serve
+// `signature_keys`: the nodes reachable from the requested signatures'
+// inputs and outputs, the init op and asset feeds, plus the saver's restore
+// machinery restricted to variables that survive the pruning. Restore paths
+// that only assign to pruned variables are dropped, so their checkpoint
+// reads never run. The signature map is reduced to the requested keys.
+// Returns NotFound if a requested signature does not exist.
+Status PruneMetaGraphDefForSignatures(
+    const string& export_dir, const std::unordered_set<string>& signature_keys,
+    MetaGraphDef* meta_graph_def);
+
 }  // namespace internal
 }  // namespace tensorflow
 
@@ -129,6 +129,39 @@ TEST_F(LoaderTest, ResourceLeakTest) {
   }
 }
 
+TEST_F(LoaderTest, LoadSignatureSubset) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, {"regress_x_to_y"},
+                              &bundle));
+
+  // Only the requested signature remains in the bundle, and it still serves.
+  EXPECT_EQ(bundle.GetSignatures().count("regress_x_to_y"), 1);
+  EXPECT_EQ(bundle.GetSignatures().count("classify_x_to_y"), 0);
+  EXPECT_EQ(bundle.GetSignatures().count("serving_default"), 0);
+  CheckSavedModelBundle(export_dir, bundle);
+}
+
+TEST_F(LoaderTest, LoadSignatureSubsetNotFound) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  Status st = LoadSavedModel(session_options, run_options, export_dir,
+                             {kSavedModelTagServe}, {"missing_signature"},
+                             &bundle);
+  EXPECT_FALSE(st.ok());
+  EXPECT_TRUE(absl::StrContains(st.message(), "missing_signature"))
+      << st.message();
+}
+
 TEST_F(LoaderTest, TagMatch) {
   SavedModelBundle bundle;
   SessionOptions session_options;
@@ -141,6 +174,30 @@ TEST_F(LoaderTest, TagMatch) {
   CheckSavedModelBundle(export_dir, bundle);
 }
 
+TEST_F(LoaderTest, EstimateSignatureCosts) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, &bundle));
+
+  SignatureCostReport report;
+  TF_ASSERT_OK(EstimateSignatureCosts(bundle.meta_graph_def, &report));
+  EXPECT_GT(report.signature_costs_size(), 0);
+  bool found_regress_signature = false;
+  for (const auto& estimate : report.signature_costs()) {
+    EXPECT_FALSE(estimate.signature_key().empty());
+    EXPECT_GT(estimate.num_ops(), 0);
+    if (estimate.signature_key() == "regress_x_to_y") {
+      found_regress_signature = true;
+    }
+  }
+  EXPECT_TRUE(found_regress_signature);
+}
+
 TEST_F(LoaderTest, ReadMetaGraphFromSavedModel) {
   SavedModelBundle bundle;
   SessionOptions session_options;
@@ -0,0 +1,57 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/compiler/jit/cluster_compile_time_model.h"
+
+namespace tensorflow {
+
+namespace {
+// Weight of the most recent observation in the moving average. Chosen so a
+// handful of compilations dominate the estimate while a single outlier (e.g.
+// a cold persistent-cache miss with autotuning) does not.
+constexpr double kEwmaWeight = 0.25;
+}  // namespace
+
+/*static*/ ClusterCompileTimeModel* ClusterCompileTimeModel::Global() {
+  static ClusterCompileTimeModel* model = new ClusterCompileTimeModel;
+  return model;
+}
+
+void ClusterCompileTimeModel::RecordCompilation(int64_t num_nodes,
+                                                int64_t compile_time_us) {
+  if (num_nodes <= 0 || compile_time_us <= 0) {
+    return;
+  }
+  const double observed_us_per_node =
+      static_cast<double>(compile_time_us) / static_cast<double>(num_nodes);
+  mutex_lock l(mu_);
+  if (us_per_node_ == 0.0) {
+    us_per_node_ = observed_us_per_node;
+  } else {
+    us_per_node_ =
+        kEwmaWeight * observed_us_per_node + (1.0 - kEwmaWeight) * us_per_node_;
+  }
+}
+
+int64_t ClusterCompileTimeModel::EstimateCompileTimeUs(
+    int64_t num_nodes) const {
+  mutex_lock l(mu_);
+  if (us_per_node_ == 0.0 || num_nodes <= 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(us_per_node_ * static_cast<double>(num_nodes));
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,52 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_COMPILER_JIT_CLUSTER_COMPILE_TIME_MODEL_H_
+#define TENSORFLOW_COMPILER_JIT_CLUSTER_COMPILE_TIME_MODEL_H_
+
+#include <cstdint>
+
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// Process-wide estimate of how long XLA takes to compile a cluster, expressed
+// as microseconds of compile time per clustered node. The estimate is fed by
+// actual JIT compilations and consumed by auto-clustering to cap the expected
+// compile time of the clusters it forms (see
+// --tf_xla_max_cluster_compile_time_ms). Thread-safe.
+class ClusterCompileTimeModel {
+ public:
+  static ClusterCompileTimeModel* Global();
+
+  // Records an observed compilation of a cluster with `num_nodes` nodes that
+  // took `compile_time_us` microseconds. Observations are folded into an
+  // exponential moving average so the estimate tracks the current workload
+  // and hardware.
+  void RecordCompilation(int64_t num_nodes, int64_t compile_time_us);
+
+  // Returns the estimated compile time in microseconds for a cluster with
+  // `num_nodes` nodes, or 0 if no compilation has been observed yet.
+  int64_t EstimateCompileTimeUs(int64_t num_nodes) const;
+
+ private:
+  mutable mutex mu_;
+  double us_per_node_ TF_GUARDED_BY(mu_) = 0.0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_COMPILER_JIT_CLUSTER_COMPILE_TIME_MODEL_H_
@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
+#include "tensorflow/compiler/jit/cluster_compile_time_model.h"
 #include "tensorflow/compiler/jit/device_compilation_cache.h"
 #include "tensorflow/compiler/jit/device_compilation_cluster_signature.h"
 #include "tensorflow/compiler/jit/device_compilation_profiler.h"
@@ -341,6 +342,18 @@ DeviceCompiler<ExecutableType, ClientType>::CompileStrict(
   const uint64 compile_end_us = env->NowMicros();
   const uint64 compile_time_us = compile_end_us - compile_start_us;
 
+  // Feed the compile-speed estimate used by auto-clustering's compile-time
+  // cap. Executables served from the persistent cache say nothing about
+  // compile speed, so they are not recorded.
+  if (scope == CompileScope::kFunction && !loaded_executable.has_value() &&
+      options.flib_def != nullptr) {
+    const FunctionDef* fdef = options.flib_def->Find(function.name());
+    if (fdef != nullptr) {
+      ClusterCompileTimeModel::Global()->RecordCompilation(
+          fdef->node_def_size(), compile_time_us);
+    }
+  }
+
   device_compiler_internal::LogOnceXlaCompiledFirstCluster();
   TF_RETURN_IF_ERROR(profiler->RegisterCompilation(
       function, compile_time_us, loaded_executable.has_value()));
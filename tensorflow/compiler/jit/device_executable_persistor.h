@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/service/hlo.pb.h"
 #include "xla/util.h"
 #include "tensorflow/core/framework/device.h"
+#include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
@@ -74,6 +75,13 @@ class DeviceExecutablePersistor {
 
     // Cache is read-only if set to true.
     bool persistent_cache_directory_read_only = false;
+
+    // If positive, at most one process compiles a missing cache entry at a
+    // time: a process that finds another process's lock waits up to this many
+    // milliseconds for the entry to appear and loads it instead of compiling.
+    // On timeout (e.g. the locking process died) it compiles anyway. 0
+    // disables cross-process coordination.
+    int64_t single_writer_wait_ms = 0;
   };
 
   DeviceExecutablePersistor(const Config& config,
@@ -146,6 +154,10 @@ class DeviceExecutablePersistor {
       const XlaSerializedCacheKey& key) const;
   std::string GetFilePath(const XlaSerializedCacheKey& key) const;
 
+  // Path of the cross-process lock for `key`. The lock is a directory because
+  // directory creation is atomic and exclusive on the filesystems we support.
+  std::string GetLockPath(const XlaSerializedCacheKey& key) const;
+
   const DeviceType device_type_;
   const bool disable_strict_signature_checks_;
   const std::string persistence_prefix_;
@@ -157,6 +169,9 @@ class DeviceExecutablePersistor {
   // Cache is read-only if set to true.
   const bool persistent_cache_directory_read_only_;
 
+  // See Config::single_writer_wait_ms.
+  const int64_t single_writer_wait_ms_;
+
   DeviceExecutablePersistor(const DeviceExecutablePersistor&) = delete;
   void operator=(const DeviceExecutablePersistor&) = delete;
 };
@@ -170,7 +185,8 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::
       persistence_prefix_(config.persistence_prefix),
       persistent_cache_directory_(config.persistent_cache_directory),
       persistent_cache_directory_read_only_(
-          config.persistent_cache_directory_read_only) {}
+          config.persistent_cache_directory_read_only),
+      single_writer_wait_ms_(config.single_writer_wait_ms) {}
 
 template <typename ExecutableType, typename ClientType>
 std::string DeviceExecutablePersistor<ExecutableType, ClientType>::
@@ -194,6 +210,14 @@ std::string DeviceExecutablePersistor<ExecutableType, ClientType>::GetFilePath(
   return io::JoinPath(persistent_cache_directory_, file_name);
 }
 
+template <typename ExecutableType, typename ClientType>
+std::string DeviceExecutablePersistor<ExecutableType, ClientType>::GetLockPath(
+    const XlaSerializedCacheKey& key) const {
+  const std::string dir_name =
+      absl::StrCat(XlaSerializedCacheKeyToString(key), ".lock");
+  return io::JoinPath(persistent_cache_directory_, dir_name);
+}
+
 template <typename ExecutableType, typename ClientType>
 XlaSerializedCacheKey
 DeviceExecutablePersistor<ExecutableType, ClientType>::BuildSerializedCacheKey(
@@ -368,6 +392,34 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::TryToLoadExecutable(
     TF_ASSIGN_OR_RETURN(serialized_entry, TryToReadSerializedEntry(cache_key));
   }
 
+  if (!serialized_entry.has_value() && single_writer_wait_ms_ > 0 &&
+      !persistent_cache_directory_read_only_) {
+    // Coordinate with other processes sharing the cache directory so that
+    // only one of them compiles this entry. Whoever creates the lock compiles
+    // and releases the lock when the executable is persisted; everyone else
+    // waits for the entry to land. A waiter that times out (e.g. because the
+    // lock holder died) compiles locally; the subsequent atomic rename into
+    // the final location keeps that safe.
+    Env* env = Env::Default();
+    env->RecursivelyCreateDir(persistent_cache_directory_).IgnoreError();
+    const std::string lock_path = GetLockPath(cache_key);
+    if (env->CreateDir(lock_path).ok()) {
+      VLOG(1) << "Acquired compilation lock for: " << signature_str;
+      return std::nullopt;
+    }
+    VLOG(1) << "Another process is compiling, waiting for: " << signature_str;
+    const uint64 deadline_us =
+        env->NowMicros() + single_writer_wait_ms_ * 1000;
+    while (env->NowMicros() < deadline_us) {
+      env->SleepForMicroseconds(100 * 1000);
+      TF_ASSIGN_OR_RETURN(serialized_entry,
+                          TryToReadSerializedEntry(cache_key));
+      if (serialized_entry.has_value()) {
+        break;
+      }
+    }
+  }
+
   if (!serialized_entry.has_value()) {
     return std::nullopt;
   }
@@ -397,6 +449,19 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::TryToPersistExecutable(
 
   XLA_SCOPED_LOGGING_TIMER(
       absl::StrCat("Serializing and saving cache entry: ", signature_str));
+  // Release the cross-process compilation lock (if this process took it in
+  // TryToLoadExecutable) whether or not persisting succeeds, so waiters are
+  // unblocked as soon as possible.
+  auto release_lock = gtl::MakeCleanup([&] {
+    if (single_writer_wait_ms_ > 0) {
+      const xla::HloModuleProto& hlo_module =
+          compilation_result.computation->proto();
+      Env::Default()
+          ->DeleteDir(GetLockPath(
+              BuildSerializedCacheKey(signature_hash, hlo_module)))
+          .IgnoreError();
+    }
+  });
   TF_ASSIGN_OR_RETURN(XlaSerializedCacheEntry serialized_entry,
                       SerializeEntry(signature_hash, options,
                                      compilation_result, executable, client));
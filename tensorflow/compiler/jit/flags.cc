@@ -108,6 +108,11 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
       Flag("tf_xla_max_cluster_size",
            &mark_for_compilation_flags->tf_xla_max_cluster_size,
            "Maximum number of operators in an XLA compilation."),
+      Flag("tf_xla_max_cluster_compile_time_ms",
+           &mark_for_compilation_flags->tf_xla_max_cluster_compile_time_ms,
+           "If positive, maximum estimated compile time in milliseconds of an "
+           "XLA cluster formed by auto-clustering, based on compile times "
+           "observed earlier in the process. 0 disables the cap."),
       Flag(
           "tf_xla_ops_to_cluster",
           &mark_for_compilation_flags->tf_xla_ops_to_cluster,
@@ -167,6 +172,13 @@ void AppendMarkForCompilationPassFlagsInternal(std::vector<Flag>* flag_list) {
       Flag("tf_xla_persistent_cache_read_only",
            &mark_for_compilation_flags->tf_xla_persistent_cache_read_only,
            "If true, the persistent cache will be read-only."),
+      Flag("tf_xla_persistent_cache_single_writer_wait_ms",
+           &mark_for_compilation_flags
+                ->tf_xla_persistent_cache_single_writer_wait_ms,
+           "If positive, processes sharing the persistent cache directory "
+           "coordinate so that only one of them compiles a given missing "
+           "cache entry; the others wait up to this many milliseconds for the "
+           "entry to appear and load it. 0 disables the coordination."),
       Flag("tf_xla_disable_strict_signature_checks",
            &mark_for_compilation_flags->tf_xla_disable_strict_signature_checks,
            "If true, entires loaded into the XLA compile cache will not have "
@@ -230,6 +242,7 @@ void AllocateAndParseFlags() {
   mark_for_compilation_flags->tf_xla_min_cluster_size = 4;
   mark_for_compilation_flags->tf_xla_max_cluster_size =
       std::numeric_limits<int32>::max();
+  mark_for_compilation_flags->tf_xla_max_cluster_compile_time_ms = 0;
   mark_for_compilation_flags->tf_xla_clustering_debug = false;
   mark_for_compilation_flags->tf_xla_cpu_global_jit = false;
   mark_for_compilation_flags->tf_xla_clustering_fuel =
@@ -242,6 +255,8 @@ void AllocateAndParseFlags() {
   mark_for_compilation_flags->tf_xla_persistent_cache_directory = "";
   mark_for_compilation_flags->tf_xla_persistent_cache_device_types = "";
   mark_for_compilation_flags->tf_xla_persistent_cache_read_only = false;
+  mark_for_compilation_flags->tf_xla_persistent_cache_single_writer_wait_ms =
+      0;
   mark_for_compilation_flags->tf_xla_disable_strict_signature_checks = false;
   mark_for_compilation_flags->tf_xla_persistent_cache_prefix =
       "xla_compile_cache";
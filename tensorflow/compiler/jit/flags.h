@@ -62,6 +62,13 @@ struct MarkForCompilationPassFlags {
   // Maximum number of operators in an XLA compilation.
   int32 tf_xla_max_cluster_size;
 
+  // If positive, maximum estimated compile time (in milliseconds) of an XLA
+  // cluster formed by auto-clustering. The estimate is derived from compile
+  // times observed earlier in the process, so the cap only takes effect after
+  // the first compilation. Useful in serving, where a giant cluster's
+  // first-call compile can stall requests. 0 disables the cap.
+  int32 tf_xla_max_cluster_compile_time_ms;
+
   // If non-empty, limit XLA clustering to the following TF operations.
   string tf_xla_ops_to_cluster;
 
@@ -104,6 +111,12 @@ struct MarkForCompilationPassFlags {
 
   bool tf_xla_persistent_cache_read_only;
 
+  // If positive, processes sharing the persistent cache directory coordinate
+  // so that only one of them compiles a given missing cache entry; the others
+  // wait up to this many milliseconds for the entry to appear and load it. 0
+  // (the default) disables cross-process coordination.
+  int64_t tf_xla_persistent_cache_single_writer_wait_ms;
+
   // If true, entries loaded into the XLA compile cache will not have their
   // signatures checked strictly. This should generally not be disabled except
   // for debugging. Defaults to false.
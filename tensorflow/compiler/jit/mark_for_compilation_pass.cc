@@ -34,6 +34,7 @@ limitations under the License.
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_join.h"
+#include "tensorflow/compiler/jit/cluster_compile_time_model.h"
 #include "tensorflow/compiler/jit/compilability_check_util.h"
 #include "tensorflow/compiler/jit/deadness_analysis.h"
 #include "tensorflow/compiler/jit/defs.h"
@@ -112,6 +113,10 @@ class MarkForCompilationPassImpl {
     int max_cluster_size;
     int min_cluster_size;
 
+    // If positive, maximum estimated compile time (in milliseconds) of a
+    // cluster, based on compile speed observed earlier in the process.
+    int max_cluster_compile_time_ms;
+
     // Compiler fuel for the auto-clustering algorithm.
     //
     // We decrement this value by one on every time we choose a compilation
@@ -1548,6 +1553,22 @@ StatusOr<bool> MarkForCompilationPassImpl::TryToContractEdge(Cluster* from,
         from, to, "the new cluster will be larger than the max cluster size");
   }
 
+  // Don't exceed the maximum estimated cluster compile time. The estimate is
+  // zero until the process has compiled at least one cluster, so the first
+  // clustered graphs are only bounded by max_cluster_size.
+  if (debug_options_.max_cluster_compile_time_ms > 0) {
+    const int64_t estimated_compile_time_us =
+        ClusterCompileTimeModel::Global()->EstimateCompileTimeUs(
+            from->cluster_size() + to->cluster_size());
+    if (estimated_compile_time_us >
+        static_cast<int64_t>(debug_options_.max_cluster_compile_time_ms) *
+            1000) {
+      return LogNotContractableAndReturnFalse(
+          from, to,
+          "the new cluster's estimated compile time exceeds the maximum");
+    }
+  }
+
   TF_ASSIGN_OR_RETURN(bool will_introduce_cross_device_dependency,
                       ClusteringWillIntroduceInterDeviceDependency(*from, *to));
 
@@ -1919,6 +1940,8 @@ Status MarkForCompilationPass::Run(
       flags->tf_xla_deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.max_cluster_compile_time_ms =
+      flags->tf_xla_max_cluster_compile_time_ms;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
@@ -1938,6 +1961,8 @@ Status MarkForCompilationPass::RunForTest(
   debug_options.deterministic_cluster_names = deterministic_cluster_names;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
+  debug_options.max_cluster_compile_time_ms =
+      flags->tf_xla_max_cluster_compile_time_ms;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
   debug_options.dump_graphs = flags->tf_xla_clustering_debug;
 
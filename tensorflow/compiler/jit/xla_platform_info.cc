@@ -75,6 +75,9 @@ PjRtDeviceCompiler* CreatePjRtDeviceCompiler(DeviceType compilation_device_type,
       GetMarkForCompilationPassFlags()->tf_xla_disable_strict_signature_checks,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_read_only);
+  persistor_config.single_writer_wait_ms =
+      GetMarkForCompilationPassFlags()
+          ->tf_xla_persistent_cache_single_writer_wait_ms;
 
   return new PjRtDeviceCompiler(
       std::make_unique<PjRtDeviceExecutablePersistor>(
@@ -199,6 +202,9 @@ Status BuildXlaDeviceCompiler(DeviceBase* device, FunctionLibraryRuntime* flr,
       GetMarkForCompilationPassFlags()->tf_xla_disable_strict_signature_checks,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_prefix,
       GetMarkForCompilationPassFlags()->tf_xla_persistent_cache_read_only);
+  persistor_config.single_writer_wait_ms =
+      GetMarkForCompilationPassFlags()
+          ->tf_xla_persistent_cache_single_writer_wait_ms;
 
   if (platform_info.xla_device_metadata()) {
     *xla_device_compiler = CreateXlaDeviceCompiler(
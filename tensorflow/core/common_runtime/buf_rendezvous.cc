@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/buf_rendezvous.h"
 
+#include <vector>
+
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
@@ -41,11 +43,14 @@ BufRendezvous::~BufRendezvous() {
     PurgeTable(errors::Internal("Delete called on non-empty BufRendezvous"),
                &hook_table_);
   }
+  PurgeSlotTable(errors::Internal("Delete called on non-empty BufRendezvous"),
+                 &slot_table_);
 }
 
 void BufRendezvous::StartAbort(const Status& s) {
   CHECK(!s.ok());
   HookTable dummy_table;
+  std::vector<Hook*> dummy_slot_table;
   {
     mutex_lock l(mu_);
     // Use a "derived" status as the status for the rendezvous. Derived
@@ -54,8 +59,10 @@ void BufRendezvous::StartAbort(const Status& s) {
     // related errors.
     status_.Update(StatusGroup::MakeDerived(s));
     hook_table_.swap(dummy_table);
+    slot_table_.swap(dummy_slot_table);
   }
   PurgeTable(s, &dummy_table);
+  PurgeSlotTable(s, &dummy_slot_table);
 }
 
 void BufRendezvous::PurgeTable(const Status& s, HookTable* table) {
@@ -75,6 +82,24 @@ void BufRendezvous::PurgeTable(const Status& s, HookTable* table) {
   table->clear();
 }
 
+void BufRendezvous::PurgeSlotTable(const Status& s,
+                                   std::vector<Hook*>* table) {
+  for (Hook* h : *table) {
+    if (h == nullptr) continue;
+    if (h->cancellation_manager != nullptr) {
+      h->cancellation_manager->TryDeregisterCallback(h->cancellation_token);
+    }
+    if (h->cons_cb != nullptr) {
+      h->cons_cb(s, nullptr);
+    }
+    if (h->prod_cb != nullptr) {
+      h->prod_cb(s);
+    }
+    delete h;
+  }
+  table->clear();
+}
+
 string BufRendezvous::Hook::DebugString() const {
   return absl::StrCat(
       "[dev:", (prod_dev ? prod_dev->name() : "none"),
@@ -255,6 +280,175 @@ void BufRendezvous::CancelHook(const string& key) {
   }
 }
 
+BufRendezvous::Hook** BufRendezvous::SlotEntry(int64_t slot) {
+  DCHECK_GE(slot, 0);
+  if (slot >= static_cast<int64_t>(slot_table_.size())) {
+    slot_table_.resize(slot + 1, nullptr);
+  }
+  return &slot_table_[slot];
+}
+
+void BufRendezvous::ProvideBuf(int64_t slot, Device* dev,
+                               DeviceContext* dev_ctx, const Tensor* v,
+                               const AllocatorAttributes& attr,
+                               const ProducerCallback& done,
+                               CancellationManager* cancellation_manager) {
+  DVLOG(4) << "ProvideBuf: slot = " << slot;
+  Hook* h = nullptr;
+  Status providebuf_status;
+  do {
+    mutex_lock l(mu_);
+    if (!status_.ok()) {
+      providebuf_status = status_;
+      break;
+    } else {
+      CancellationToken cancellation_token = CancellationManager::kInvalidToken;
+      Hook** entry = SlotEntry(slot);
+      if (*entry == nullptr) {
+        if (cancellation_manager != nullptr) {
+          cancellation_token = cancellation_manager->get_cancellation_token();
+        }
+        h = new Hook(cancellation_manager, cancellation_token);
+        *entry = h;
+      } else {
+        if ((*entry)->prod_cb != nullptr) {
+          providebuf_status = errors::Internal(
+              "BufRendezvous::ProvideBuf already called for slot ", slot);
+          break;
+        }
+        h = *entry;
+      }
+      // Populate Hook with all of the prod values.
+      h->prod_dev = dev;
+      h->prod_ctx = dev_ctx;
+      h->prod_value = v;
+      h->prod_attr = attr;
+      h->prod_cb = done;
+      if (h->cons_cb != nullptr) {
+        // If consumer is waiting, kick off right away, removing Hook from
+        // table.
+        *entry = nullptr;
+      } else {
+        if (cancellation_manager != nullptr &&
+            !cancellation_manager->RegisterCallback(
+                cancellation_token, [this, slot]() { CancelHook(slot); })) {
+          // Register cancellation callback with CancellationManager.  If it is
+          // already cancelled, call done immediately with cancelled status.
+          providebuf_status = errors::Cancelled(
+              "Operation was cancelled for BufRendezvous slot ", slot);
+          *entry = nullptr;
+          delete h;
+        }
+        h = nullptr;
+      }
+    }
+  } while (false);
+  if (h) {
+    DVLOG(4) << "ProvideBuf: slot = " << slot << ": calling cons_cb"
+             << h->DebugString();
+    DeregisterCancellation(h);
+    h->cons_cb(OkStatus(), h);
+  }
+  if (!providebuf_status.ok()) {
+    done(providebuf_status);
+  }
+}
+
+void BufRendezvous::ConsumeBuf(int64_t slot, const string& device_name,
+                               const uint64 device_incarnation,
+                               const ConsumerCallback& done,
+                               CancellationManager* cancellation_manager) {
+  DVLOG(4) << "ConsumeBuf: slot = " << slot
+           << " device_name = " << device_name;
+  // Check the incarnation in the request matches the current device
+  // incarnation of the producer.
+  Device* device;
+  Status consumebuf_status = dev_mgr_->LookupDevice(device_name, &device);
+  if (consumebuf_status.ok() &&
+      device->attributes().incarnation() != device_incarnation) {
+    consumebuf_status = errors::FailedPrecondition(
+        "RecvBuf expects a different device incarnation: ", device_incarnation,
+        " vs. ", device->attributes().incarnation(),
+        ". Your worker job that contains the device (\"", device_name,
+        "\") was probably restarted. Check your "
+        "worker job for the reason why it was restarted.");
+  }
+  if (!consumebuf_status.ok()) {
+    done(consumebuf_status, nullptr);
+    return;
+  }
+  Hook* existing_hook = nullptr;
+  do {
+    mutex_lock l(mu_);
+    if (!status_.ok()) {
+      consumebuf_status = status_;
+      break;
+    }
+    Hook** entry = SlotEntry(slot);
+    if (*entry != nullptr) {
+      // Prepare to consume immediately.
+      if ((*entry)->cons_cb) {
+        consumebuf_status =
+            errors::Internal("Second consumer arrived for slot ", slot);
+        break;
+      }
+      existing_hook = *entry;
+      *entry = nullptr;
+      existing_hook->cons_cb = done;
+    } else {
+      // Hang consumer callback on the Hook.
+      CancellationToken cancellation_token = CancellationManager::kInvalidToken;
+      bool already_cancelled = false;
+      if (cancellation_manager != nullptr) {
+        cancellation_token = cancellation_manager->get_cancellation_token();
+        already_cancelled = !cancellation_manager->RegisterCallback(
+            cancellation_token, [this, slot]() { CancelHook(slot); });
+      }
+      if (already_cancelled) {
+        consumebuf_status = errors::Cancelled(
+            "Operation was cancelled for BufRendezvous slot ", slot);
+      } else {
+        Hook* h = new Hook(cancellation_manager, cancellation_token);
+        h->cons_cb = done;
+        *entry = h;
+        return;
+      }
+    }
+  } while (false);
+  if (existing_hook) {
+    DVLOG(4) << "ConsumeBuf: slot = " << slot << ": calling cons_cb"
+             << existing_hook->DebugString();
+    DeregisterCancellation(existing_hook);
+    existing_hook->cons_cb(OkStatus(), existing_hook);
+    return;
+  }
+  if (!consumebuf_status.ok()) {
+    done(consumebuf_status, nullptr);
+    return;
+  }
+}
+
+void BufRendezvous::CancelHook(int64_t slot) {
+  Hook* h = nullptr;
+  {
+    mutex_lock l(mu_);
+    if (slot < 0 || slot >= static_cast<int64_t>(slot_table_.size())) return;
+    h = slot_table_[slot];
+    slot_table_[slot] = nullptr;
+  }
+  if (h != nullptr) {
+    auto s = errors::Cancelled(
+        "Operation was cancelled for BufRendezvous slot ", slot);
+    if (h->prod_cb != nullptr) {
+      h->prod_cb(s);
+    }
+    if (h->cons_cb != nullptr) {
+      h->cons_cb(s, /*Hook=*/nullptr);
+    }
+    delete h;
+  }
+}
+
 /*static*/
 void BufRendezvous::DoneWithHook(Hook* h) {
   h->prod_cb(OkStatus());
@@ -269,6 +463,12 @@ void BufRendezvous::LogContents() {
   for (const auto& it : hook_table_) {
     LOG(INFO) << it.first << ":" << it.second->DebugString();
   }
+  for (int64_t slot = 0; slot < static_cast<int64_t>(slot_table_.size());
+       ++slot) {
+    if (slot_table_[slot] != nullptr) {
+      LOG(INFO) << "slot " << slot << ":" << slot_table_[slot]->DebugString();
+    }
+  }
 }
 
 }  // namespace tensorflow
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
@@ -112,6 +113,27 @@ class BufRendezvous {
   // cancellation manager. No-op if the rendezvous was already successful.
   void CancelHook(const string& key);
 
+  // Variants of the above keyed by a small non-negative slot id instead of a
+  // composed string key.  Slot ids are negotiated once, out of band, e.g. at
+  // collective param resolution (see CollInstanceParams), so that steady-state
+  // steps whose key set is static index an array instead of hashing freshly
+  // composed strings on every hop.  The slot and string key spaces are
+  // disjoint; a value provided under a slot can only be consumed under the
+  // same slot.  Semantics otherwise match the string-keyed calls.
+  void ProvideBuf(int64_t slot, Device* dev, DeviceContext* dev_ctx,
+                  const Tensor* v, const AllocatorAttributes& attr,
+                  const ProducerCallback& done,
+                  CancellationManager* cancellation_manager);
+
+  virtual void ConsumeBuf(int64_t slot, const string& device,
+                          const uint64 incarnation,
+                          const ConsumerCallback& done,
+                          CancellationManager* cancellation_manager);
+
+  // Cancel the rendezvous entry corresponding to `slot`.  Triggered by the
+  // cancellation manager. No-op if the rendezvous was already successful.
+  void CancelHook(int64_t slot);
+
   // Consumer must call this function when it's done reading the Hook provided
   // by the ConsumerCallback.  This function will invoke the producer callback
   // and then delete h.
@@ -127,8 +149,16 @@ class BufRendezvous {
   Status status_ TF_GUARDED_BY(mu_);
   typedef absl::flat_hash_map<string, Hook*> HookTable;
   HookTable hook_table_ TF_GUARDED_BY(mu_);
+  // Indexed by slot id; grown on demand.  A null entry means the slot has no
+  // pending hook.
+  std::vector<Hook*> slot_table_ TF_GUARDED_BY(mu_);
 
   void PurgeTable(const Status& s, HookTable* table);
+  void PurgeSlotTable(const Status& s, std::vector<Hook*>* table);
+
+ private:
+  // Returns the entry for `slot`, growing slot_table_ if necessary.
+  Hook** SlotEntry(int64_t slot) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 };
 }  // namespace tensorflow
 #endif  // TENSORFLOW_CORE_COMMON_RUNTIME_BUF_RENDEZVOUS_H_
@@ -407,5 +407,138 @@ TEST_F(BufRendezvousTest, CancelThenProvideConsume) {
   EXPECT_TRUE(errors::IsCancelled(cons_status));
 }
 
+TEST_F(BufRendezvousTest, SlotCorrectUseProducerFirst) {
+  const int64_t kSlot = 7;
+  Status prod_status;
+  Status cons_status;
+  bool prod_callback_called = false;
+  bool cons_callback_called = false;
+  Notification note;
+  br_->ProvideBuf(
+      kSlot, default_device_, fake_device_context_, &a_, aa_,
+      [&note, &prod_status, &prod_callback_called](const Status& s) {
+        prod_status = s;
+        prod_callback_called = true;
+        note.Notify();
+      },
+      &cm_);
+  EXPECT_FALSE(prod_callback_called);
+  br_->ConsumeBuf(
+      kSlot, *kDefaultDeviceName, kDefaultIncarnation,
+      [this, &cons_status, &cons_callback_called](const Status& s,
+                                                  BufRendezvous::Hook* h) {
+        cons_status = s;
+        cons_callback_called = true;
+        ASSERT_TRUE(h != nullptr);
+        EXPECT_EQ(h->prod_dev, default_device_);
+        EXPECT_EQ(h->prod_ctx, fake_device_context_);
+        EXPECT_EQ(h->prod_value, &a_);
+        br_->DoneWithHook(h);
+      },
+      &cm_);
+  EXPECT_TRUE(cons_callback_called);
+  note.WaitForNotification();
+  EXPECT_TRUE(prod_callback_called);
+  TF_EXPECT_OK(cons_status);
+  TF_EXPECT_OK(prod_status);
+}
+
+TEST_F(BufRendezvousTest, SlotCorrectUseConsumerFirst) {
+  const int64_t kSlot = 0;
+  Status prod_status;
+  Status cons_status;
+  bool prod_callback_called = false;
+  bool cons_callback_called = false;
+  Notification note;
+  br_->ConsumeBuf(
+      kSlot, *kDefaultDeviceName, kDefaultIncarnation,
+      [this, &cons_status, &cons_callback_called](const Status& s,
+                                                  BufRendezvous::Hook* h) {
+        cons_status = s;
+        cons_callback_called = true;
+        ASSERT_TRUE(h != nullptr);
+        EXPECT_EQ(h->prod_value, &a_);
+        br_->DoneWithHook(h);
+      },
+      &cm_);
+  EXPECT_FALSE(cons_callback_called);
+  br_->ProvideBuf(
+      kSlot, default_device_, fake_device_context_, &a_, aa_,
+      [&note, &prod_status, &prod_callback_called](const Status& s) {
+        prod_status = s;
+        prod_callback_called = true;
+        note.Notify();
+      },
+      &cm_);
+  EXPECT_TRUE(cons_callback_called);
+  note.WaitForNotification();
+  EXPECT_TRUE(prod_callback_called);
+  TF_EXPECT_OK(cons_status);
+  TF_EXPECT_OK(prod_status);
+}
+
+TEST_F(BufRendezvousTest, SlotsAreDistinctFromStringKeys) {
+  // A value provided under slot 0 must not match a consumer using a string
+  // key, and distinct slots must not match each other.
+  bool cons_callback_called = false;
+  br_->ProvideBuf(
+      int64_t{0}, default_device_, fake_device_context_, &a_, aa_,
+      [](const Status& s) {}, &cm_);
+  br_->ConsumeBuf(
+      *kDefaultKey, *kDefaultDeviceName, kDefaultIncarnation,
+      [&cons_callback_called](const Status& s, BufRendezvous::Hook* h) {
+        cons_callback_called = true;
+      },
+      &cm_);
+  EXPECT_FALSE(cons_callback_called);
+  br_->ConsumeBuf(
+      int64_t{1}, *kDefaultDeviceName, kDefaultIncarnation,
+      [&cons_callback_called](const Status& s, BufRendezvous::Hook* h) {
+        cons_callback_called = true;
+      },
+      &cm_);
+  EXPECT_FALSE(cons_callback_called);
+  br_->StartAbort(errors::Internal("Falling out of scope"));
+}
+
+TEST_F(BufRendezvousTest, SlotAbortNonEmpty) {
+  const int64_t kSlot = 3;
+  Status cons_status;
+  Status prod_status;
+  br_->ConsumeBuf(
+      kSlot, *kDefaultDeviceName, kDefaultIncarnation,
+      [&cons_status](const Status& s, BufRendezvous::Hook* h) {
+        cons_status = s;
+        EXPECT_EQ(h, nullptr);
+      },
+      &cm_);
+  br_->ProvideBuf(
+      int64_t{4}, default_device_, fake_device_context_, &a_, aa_,
+      [&prod_status](const Status& s) { prod_status = s; }, &cm_);
+  br_->StartAbort(errors::Internal("Falling out of scope"));
+  EXPECT_TRUE(errors::IsInternal(cons_status));
+  EXPECT_TRUE(errors::IsInternal(prod_status));
+}
+
+TEST_F(BufRendezvousTest, SlotProvideThenCancel) {
+  const int64_t kSlot = 2;
+  Status status;
+  Notification note;
+  br_->ProvideBuf(
+      kSlot, default_device_, fake_device_context_, &a_, aa_,
+      [&status, &note](const Status& s) {
+        status = s;
+        note.Notify();
+      },
+      &cm_);
+  cm_.StartCancel();
+  note.WaitForNotification();
+  EXPECT_TRUE(errors::IsCancelled(status));
+  EXPECT_NE(
+      status.message().find(absl::StrCat(
+          "Operation was cancelled for BufRendezvous slot ", kSlot)),
+      string::npos);
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -48,6 +48,12 @@ string BuildGraphOptions::DebugString() const {
       break;
   }
   strings::StrAppend(&rv, "\ncollective_order: ", collective_order_str);
+  if (!stable_feed_values.empty()) {
+    strings::StrAppend(&rv, "\nStable feeds: ");
+    for (auto& it : stable_feed_values) {
+      strings::StrAppend(&rv, it.first, ", ");
+    }
+  }
   return rv;
 }
 
@@ -16,8 +16,10 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_BUILD_GRAPH_OPTIONS_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_BUILD_GRAPH_OPTIONS_H_
 
+#include <map>
 #include <vector>
 
+#include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/graph/collective_order.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/config.pb.h"
@@ -40,6 +42,15 @@ struct BuildGraphOptions {
   // edges, if `kAttrs` encode as attribute on collective op.
   GraphCollectiveOrder collective_order = GraphCollectiveOrder::kNone;
 
+  // Observed values for feeds that the client has declared stable, keyed by
+  // the feed name as it appears in `callable_options`. The optimized graph is
+  // specialized on these values: each such feed is baked into the graph as a
+  // constant, so branches that are dead under the observed value can be
+  // eliminated. The feed remains declared in `callable_options` and may still
+  // be fed at run time; the graph built with these options is only valid for
+  // runs that feed the recorded values.
+  std::map<string, Tensor> stable_feed_values;
+
   string DebugString() const;
 };
 
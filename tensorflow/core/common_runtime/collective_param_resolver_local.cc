@@ -68,7 +68,16 @@ const char* GetCollectiveName(const CollectiveParams* cp, bool nccl) {
       return nccl ? "NcclBroadcast" : "HierarchicalTreeBroadcast";
 
     case REDUCTION_COLLECTIVE:
-      return nccl ? "NcclReduce" : "RingReduce";
+      if (nccl) return "NcclReduce";
+      // Topology-aware CPU reduction, opt-in via communication_hint.  On a
+      // single task it degenerates to RingReduce, so keep the flat ring
+      // there.
+      if (cp->instance.impl_details.communication_hint ==
+              "hierarchical_ring" &&
+          cp->group.device_type == DEVICE_CPU && cp->group.num_tasks > 1) {
+        return "HierarchicalRingReduce";
+      }
+      return "RingReduce";
 
     case GATHER_COLLECTIVE:
       return nccl ? "NcclGather" : "RingGather";
@@ -547,6 +556,39 @@ void CollectiveParamResolverLocal::InitInstanceSharedParams(
     const CollectiveParams* cp, InstanceRec* ir) {
   ir->shared->instance = cp->instance;
   ir->shared->default_rank = -1;
+
+  // Reserve a range of BufRendezvous slots for this instance so that
+  // steady-state steps can rendezvous by array index instead of composing a
+  // string key per hop.  Size the range for the ring family, which needs the
+  // most keys: 2 passes over group_size * num_subdivs sections, each tagged
+  // with one of group_size source ranks.  Subdivisions are only generated at
+  // kernel init, so bound their number the way RingAlg does.
+  const CollImplDetails& impl = cp->instance.impl_details;
+  int64_t max_subdivs;
+  if (!impl.subdiv_offsets.empty()) {
+    max_subdivs = impl.subdiv_offsets.size();
+  } else if (impl.max_subdivs_per_device > 0) {
+    max_subdivs = impl.max_subdivs_per_device;
+  } else if (impl.max_subdivs_per_device == -1) {
+    max_subdivs = 1;  // Subdivision disabled.
+  } else {
+    max_subdivs = 2;  // RingAlg's kMaxSubdivsPerDeviceDefault.
+  }
+  const int64_t group_size = cp->group.group_size;
+  const int64_t num_slots = 2 * max_subdivs * group_size * group_size;
+  // Ranges are keyed by instance_key alone, not (step_id, instance_key), so
+  // repeated steps of the same instance reuse the same dense ids.
+  int64_t slot_base;
+  auto it = instance_slot_bases_.find(cp->instance.instance_key);
+  if (it == instance_slot_bases_.end()) {
+    slot_base = next_buf_rendezvous_slot_;
+    next_buf_rendezvous_slot_ += num_slots;
+    instance_slot_bases_[cp->instance.instance_key] = slot_base;
+  } else {
+    slot_base = it->second;
+  }
+  ir->shared->instance.buf_rendezvous_slot_base = slot_base;
+  ir->shared->instance.num_buf_rendezvous_slots = num_slots;
 }
 
 // NOTE(ayushd): The DeviceLocality objects in attributes will have LocalLinks
@@ -145,7 +145,8 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
   //
   // Preconditions:
   //  cp is populated with all DeviceLocalities
-  void InitInstanceSharedParams(const CollectiveParams* cp, InstanceRec* ir);
+  void InitInstanceSharedParams(const CollectiveParams* cp, InstanceRec* ir)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(instance_mu_);
 
   // Establishes the final order of gp->device_names and gp->task_names by
   // considering localities of all devices.
@@ -206,6 +207,13 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
   gtl::FlatMap<int32_t, gtl::FlatMap<std::tuple<int64_t, int32_t>,
                                      std::unique_ptr<InstanceRec>, TupleHash>>
       instance_table_ TF_GUARDED_BY(instance_mu_);
+  // BufRendezvous slot ranges reserved per instance_key.  A range is reserved
+  // the first time an instance_key is seen and reused for every subsequent
+  // step of the same instance, so that the slot id space stays dense in
+  // steady-state training.  See CollInstanceParams::buf_rendezvous_slot_base.
+  gtl::FlatMap<int32_t, int64_t> instance_slot_bases_
+      TF_GUARDED_BY(instance_mu_);
+  int64_t next_buf_rendezvous_slot_ TF_GUARDED_BY(instance_mu_) = 0;
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
 };
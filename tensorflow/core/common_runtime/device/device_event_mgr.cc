@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/device/device_event_mgr.h"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -33,6 +34,11 @@ namespace {
 //  - Should EventMgrs be shared between devices on a machine with multiple
 //  devices of the same type?
 static const int kNumThreads = 2;
+
+// Cap for the adaptive polling interval.  While polls retire nothing the
+// polling loop backs off exponentially from polling_active_delay_usecs up to
+// this value, and resets as soon as an epoch event completes.
+static const int64_t kMaxPollingDelayUsecs = 1000;
 }  // namespace
 
 namespace device_event_mgr {
@@ -108,8 +114,11 @@ EventMgr::EventMgr(se::StreamExecutor* se, const GPUOptions& gpu_options)
 EventMgr::~EventMgr() {
   StopPollingLoop();
 
-  for (auto& [stream, stream_callbacks] : callbacks_) {
-    for (auto& [event, callback] : stream_callbacks) {
+  for (auto& [stream, state] : callbacks_) {
+    for (auto& callback : state.batch) {
+      threadpool_.Schedule(std::move(callback));
+    }
+    for (auto& callback : state.pending) {
       threadpool_.Schedule(std::move(callback));
     }
   }
@@ -144,8 +153,10 @@ void EventMgr::StopPollingLoop() {
 // While one or more events is outstanding, poll for completed events.  When no
 // events are outstanding, we sleep until one is enqueued.
 void EventMgr::PollLoop() {
+  int64_t delay_usecs = polling_active_delay_usecs_;
   while (true) {
     bool events_still_pending;
+    bool made_progress;
     {
       mutex_lock l(mu_);
       if (stop_polling_) {
@@ -153,13 +164,19 @@ void EventMgr::PollLoop() {
       }
       if (callbacks_.empty()) {
         events_pending_.wait(l);
+        delay_usecs = polling_active_delay_usecs_;
       }
-      PollEvents(/*stream=*/nullptr);  // poll all streams
+      made_progress = PollEvents(/*stream=*/nullptr);  // poll all streams
       events_still_pending = !callbacks_.empty();
     }
 
     if (events_still_pending) {
-      Env::Default()->SleepForMicroseconds(polling_active_delay_usecs_);
+      // Adapt the polling interval to load: poll at full tempo while events
+      // are completing, back off while nothing retires.
+      delay_usecs = made_progress
+                        ? polling_active_delay_usecs_
+                        : std::min(delay_usecs * 2, kMaxPollingDelayUsecs);
+      Env::Default()->SleepForMicroseconds(delay_usecs);
     }
   }
   polling_stopped_->Notify();
@@ -169,24 +186,38 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
   VLOG(2) << "EnqueueCallback with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
           << " unused event objects.";
+  bool was_empty = callbacks_.empty();
+  StreamState& state = callbacks_[stream];
+  state.pending.push_back(std::move(func));
+  // If the stream has no epoch event in flight, record one immediately so
+  // that a lone callback keeps its historical latency.  Otherwise the
+  // callback waits in `pending` and the next epoch's event retires it,
+  // along with everything else that accumulated meanwhile, with a single
+  // event record/poll.
+  if (state.event == nullptr) {
+    RecordEpoch(stream, &state);
+  }
+
+  // Wake up the polling thread if it was sleeping.
+  if (was_empty) {
+    events_pending_.notify_all();
+  }
+}
+
+void EventMgr::RecordEpoch(se::Stream* stream, StreamState* state) {
+  DCHECK(state->event == nullptr);
+  DCHECK(state->batch.empty());
+  DCHECK(!state->pending.empty());
   // Events are created on demand, and repeatedly reused.  There is no
   // limit placed here on the number of allocated Events.
   if (free_events_.empty()) {
     free_events_.push_back(std::make_unique<se::Event>(exec_));
     free_events_.back()->Init();
   }
-
-  std::unique_ptr<se::Event> e = std::move(free_events_.back());
+  state->event = std::move(free_events_.back());
   free_events_.pop_back();
-  stream->ThenRecordEvent(e.get());
-
-  bool was_empty = callbacks_.empty();
-  callbacks_[stream].push_back({std::move(e), std::move(func)});
-
-  // Wake up the polling thread if it was sleeping.
-  if (was_empty) {
-    events_pending_.notify_all();
-  }
+  state->batch.swap(state->pending);
+  stream->ThenRecordEvent(state->event.get());
 }
 
 // This function must be called periodically to check whether pending
@@ -196,57 +227,49 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
 // spikes of up to several hundred outstanding.  (If GPUKernelTracker
 // is used to cap pending kernels there should never be more than
 // that many.)
-void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
+bool EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
   VLOG(2) << "PollEvents with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
           << " unused event objects.";
 
-  // Polls the events for one stream.
+  bool made_progress = false;
+
+  // Polls the epoch event for one stream.
   //
   // `stream_it` should be an iterator into callbacks_.  Modifies stream_it so
   // it points to the next element of callbacks_.
   auto poll_events_for_stream_it =
       [&](auto& stream_it) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-        auto& stream_callbacks = stream_it->second;
-
-        auto it = stream_callbacks.begin();
-        while (it != stream_callbacks.end()) {
-          auto& [event, callback] = *it;
-
-          se::Event::Status s = event->PollForStatus();
-          bool keep_looping = true;
-          switch (s) {
-            case se::Event::Status::kUnknown:
-            case se::Event::Status::kError:
-              // We don't expect to see these.  Someday maybe propagate
-              // a Status error, but for now fail hard.
-              LOG(FATAL) << "Unexpected Event status: " << static_cast<int>(s);
-              break;
-            case se::Event::Status::kPending:
-              // If this event is still pending, then all events after it are
-              // guaranteed to be pending as well, so we can stop looping.
-              keep_looping = false;
-              break;
-            case se::Event::Status::kComplete:
-              free_events_.push_back(std::move(event));
+        StreamState& state = stream_it->second;
+
+        se::Event::Status s = state.event->PollForStatus();
+        switch (s) {
+          case se::Event::Status::kUnknown:
+          case se::Event::Status::kError:
+            // We don't expect to see these.  Someday maybe propagate
+            // a Status error, but for now fail hard.
+            LOG(FATAL) << "Unexpected Event status: " << static_cast<int>(s);
+            break;
+          case se::Event::Status::kPending:
+            // The epoch event retires the whole batch at once, so there is
+            // nothing else to poll for this stream.
+            break;
+          case se::Event::Status::kComplete:
+            made_progress = true;
+            free_events_.push_back(std::move(state.event));
+            for (auto& callback : state.batch) {
               threadpool_.Schedule(std::move(callback));
-              // std::deque::erase() does invalidate iterators, so we can't
-              // erase `it` here.  Instead, we'll wait until the end of the loop
-              // over stream_callbacks and erase all of the completed events at
-              // that point.
-              ++it;
-              break;
-          }
-
-          if (!keep_looping) {
+            }
+            state.batch.clear();
+            // Start the next epoch if callbacks accumulated while this
+            // event was in flight.
+            if (!state.pending.empty()) {
+              RecordEpoch(stream_it->first, &state);
+            }
             break;
-          }
         }
 
-        // Erase all completed events from stream_callbacks.
-        stream_callbacks.erase(stream_callbacks.begin(), it);
-
-        if (stream_callbacks.empty()) {
+        if (state.event == nullptr) {
           // absl::flat_hash_map::erase doesn't invalidate iterators, so this is
           // safe.
           callbacks_.erase(stream_it++);
@@ -267,6 +290,8 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
       poll_events_for_stream_it(stream_it);
     }
   }
+
+  return made_progress;
 }
 
 EventMgrFactory* EventMgrFactory::Singleton() {
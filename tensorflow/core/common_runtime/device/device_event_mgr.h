@@ -16,7 +16,6 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_DEVICE_DEVICE_EVENT_MGR_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_DEVICE_DEVICE_EVENT_MGR_H_
 
-#include <deque>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -92,10 +91,11 @@ class EventMgr {
 
   // This function should be called at roughly the same tempo as QueueTensors()
   // to check whether pending events have recorded, and then retire them.
+  // Returns true if any epoch event completed, i.e. if progress was made.
   //
   // If `stream` is not null, we only poll events for that stream.  Otherwise we
   // poll events for all streams.
-  void PollEvents(se::Stream* stream = nullptr)
+  bool PollEvents(se::Stream* stream = nullptr)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // An internal polling loop that runs at a low frequency to clear straggler
@@ -106,14 +106,28 @@ class EventMgr {
   void StartPollingLoop();
   void StopPollingLoop();
 
+  // Records an epoch event for the stream's accumulated pending callbacks.
+  // REQUIRES: state->event == nullptr and state->pending is non-empty.
+  void RecordEpoch(se::Stream* stream, struct StreamState* state)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // A stack of unused events
   std::vector<std::unique_ptr<se::Event>> free_events_ TF_GUARDED_BY(mu_);
 
-  // Callbacks waiting on their events to complete.
-  absl::flat_hash_map<
-      se::Stream*,
-      std::deque<std::pair<std::unique_ptr<se::Event>, std::function<void()>>>>
-      callbacks_ TF_GUARDED_BY(mu_);
+  // Deferred callbacks for one stream.  Rather than one event per callback,
+  // at most one "epoch" event is in flight per stream at a time; it covers
+  // every callback in `batch`.  Callbacks that arrive while that event is
+  // pending accumulate in `pending` and are retired together by the next
+  // epoch's event, so at high enqueue rates one event retires a whole batch
+  // of callbacks.
+  struct StreamState {
+    std::unique_ptr<se::Event> event;  // in-flight epoch event, if any
+    std::vector<std::function<void()>> batch;    // covered by `event`
+    std::vector<std::function<void()>> pending;  // waiting for the next epoch
+  };
+
+  // Callbacks waiting on their epoch events to complete.
+  absl::flat_hash_map<se::Stream*, StreamState> callbacks_ TF_GUARDED_BY(mu_);
 
   bool stop_polling_ TF_GUARDED_BY(mu_);
   std::unique_ptr<Notification> polling_stopped_;
@@ -57,8 +57,8 @@ class TEST_EventMgrHelper {
   size_t queue_size() {
     mutex_lock l(em_->mu_);
     size_t n = 0;
-    for (const auto& [stream, events_and_callbacks] : em_->callbacks_) {
-      n += events_and_callbacks.size();
+    for (const auto& [stream, state] : em_->callbacks_) {
+      n += state.batch.size() + state.pending.size();
     }
     return n;
   }
@@ -71,6 +71,12 @@ class DeviceMgr {
 
   virtual int NumDevices() const = 0;
 
+  // Returns an opaque version number for the set of devices owned by this
+  // manager. The version changes whenever devices are added or removed, so
+  // callers may cache state derived from the device set (e.g. serialized
+  // DeviceAttributes) and revalidate it with a single cheap call.
+  virtual int64_t DeviceSetVersion() const = 0;
+
   // Returns an arbitrary CPU device if one is present, otherwise return
   // nullptr.
   virtual Device* HostCPU() const = 0;
@@ -105,6 +111,7 @@ class DynamicDeviceMgr : public DeviceMgr {
   void ClearContainers(gtl::ArraySlice<string> containers) const override;
   int NumDeviceType(const string& type) const override;
   int NumDevices() const override;
+  int64_t DeviceSetVersion() const override;
   Device* HostCPU() const override;
 
   // Add devices to device manager. Returns error for repeated device names.
@@ -142,6 +149,9 @@ class DynamicDeviceMgr : public DeviceMgr {
   std::unordered_map<string, int> device_type_counts_
       TF_GUARDED_BY(devices_mu_);
 
+  // Incremented on every successful AddDevices/RemoveDevices call.
+  int64_t device_set_version_ TF_GUARDED_BY(devices_mu_) = 1;
+
   mutable std::atomic<Device*> cpu_device_;  // memoize `HostCPU` result
 
   class DeviceCircularBuffer {
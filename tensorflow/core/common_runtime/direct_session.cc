@@ -17,7 +17,11 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
@@ -60,6 +64,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/core/threadpool_options.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
@@ -148,6 +153,36 @@ thread::ThreadPool* GlobalThreadPool(const SessionOptions& options,
   return thread_pool;
 }
 
+// Returns true if the value fed for a stable feed can be baked into the
+// graph as a constant. Specialization is restricted to scalar flag-like
+// values: these select between branches rather than carry bulk data, so the
+// number of distinct observed values stays small.
+bool IsSpecializableStableFeedValue(const Tensor& tensor) {
+  if (tensor.NumElements() != 1) return false;
+  switch (tensor.dtype()) {
+    case DT_BOOL:
+    case DT_INT32:
+    case DT_INT64:
+    case DT_STRING:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns a string that uniquely identifies the observed values of the
+// stable feeds, for use in the executor cache key.
+string SummarizeStableFeedValues(
+    const std::map<string, Tensor>& stable_feed_values) {
+  string signature;
+  for (const auto& it : stable_feed_values) {
+    strings::StrAppend(&signature, it.first, "=",
+                       DataTypeString(it.second.dtype()), ":",
+                       it.second.SummarizeValue(1), ";");
+  }
+  return signature;
+}
+
 // TODO(vrv): Figure out how to unify the many different functions
 // that generate RendezvousKey, since many of them have to be
 // consistent with each other.
@@ -303,6 +338,274 @@ static RunHandlerPool* GetOrCreateRunHandlerPool(
   return pool;
 }
 
+// Wraps an Executor::Args::Runner so that ready closures are drained in
+// batches: each pool submission chains up to `batch_size` closures inline
+// instead of waking one pool thread per closure. Additional drainers are
+// spawned only when the backlog outgrows what the active ones will pick up,
+// so parallelism is preserved while wakeups are amortized.
+class BatchingInterOpRunner
+    : public std::enable_shared_from_this<BatchingInterOpRunner> {
+ public:
+  BatchingInterOpRunner(Executor::Args::Runner underlying, int32_t batch_size)
+      : underlying_(std::move(underlying)), batch_size_(batch_size) {}
+
+  void Schedule(Executor::Args::Closure c) {
+    bool spawn_drainer = false;
+    {
+      mutex_lock l(mu_);
+      pending_.push_back(std::move(c));
+      if (active_drainers_ * batch_size_ <
+          static_cast<int64_t>(pending_.size())) {
+        ++active_drainers_;
+        spawn_drainer = true;
+      }
+    }
+    if (spawn_drainer) {
+      underlying_([self = shared_from_this()]() { self->Drain(); });
+    }
+  }
+
+ private:
+  void Drain() {
+    while (true) {
+      std::vector<Executor::Args::Closure> batch;
+      {
+        mutex_lock l(mu_);
+        const size_t n =
+            std::min(pending_.size(), static_cast<size_t>(batch_size_));
+        if (n == 0) {
+          --active_drainers_;
+          return;
+        }
+        batch.insert(batch.end(), std::make_move_iterator(pending_.begin()),
+                     std::make_move_iterator(pending_.begin() + n));
+        pending_.erase(pending_.begin(), pending_.begin() + n);
+      }
+      for (Executor::Args::Closure& closure : batch) {
+        closure();
+      }
+    }
+  }
+
+  const Executor::Args::Runner underlying_;
+  const int32_t batch_size_;
+
+  mutex mu_;
+  std::deque<Executor::Args::Closure> pending_ TF_GUARDED_BY(mu_);
+  int64_t active_drainers_ TF_GUARDED_BY(mu_) = 0;
+};
+
+// Wraps an Executor::Args::Runner so that at most `limit` closures are in
+// flight at once; the rest queue and launch as running ones finish. This
+// emulates a smaller inter-op pool without rebuilding threads, which is how
+// the auto-tuner probes candidate parallelism levels.
+class ConcurrencyLimitedRunner
+    : public std::enable_shared_from_this<ConcurrencyLimitedRunner> {
+ public:
+  ConcurrencyLimitedRunner(Executor::Args::Runner underlying, int32_t limit)
+      : underlying_(std::move(underlying)), limit_(limit) {}
+
+  void Schedule(Executor::Args::Closure c) {
+    {
+      mutex_lock l(mu_);
+      if (in_flight_ >= limit_) {
+        pending_.push_back(std::move(c));
+        return;
+      }
+      ++in_flight_;
+    }
+    Launch(std::move(c));
+  }
+
+ private:
+  void Launch(Executor::Args::Closure c) {
+    underlying_([self = shared_from_this(), c = std::move(c)]() mutable {
+      c();
+      self->OnClosureDone();
+    });
+  }
+
+  void OnClosureDone() {
+    Executor::Args::Closure next;
+    {
+      mutex_lock l(mu_);
+      if (pending_.empty()) {
+        --in_flight_;
+        return;
+      }
+      next = std::move(pending_.front());
+      pending_.pop_front();
+    }
+    Launch(std::move(next));
+  }
+
+  const Executor::Args::Runner underlying_;
+  const int32_t limit_;
+
+  mutex mu_;
+  std::deque<Executor::Args::Closure> pending_ TF_GUARDED_BY(mu_);
+  int64_t in_flight_ TF_GUARDED_BY(mu_) = 0;
+};
+
+// Opt-in for the inter-op parallelism auto-tuner. Read per session rather
+// than cached so tests (and long-lived processes spawning sessions) can
+// toggle it.
+bool InterOpAutoTuneEnabled() {
+  bool enabled = false;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_INTER_OP_AUTOTUNE",
+                                 /*default_val=*/false, &enabled));
+  return enabled;
+}
+
+// Hill-climbs the effective inter-op parallelism during a warmup window.
+//
+// The session's pool is created at its configured size; candidate levels
+// below that size are emulated by capping the number of closures in flight,
+// so probing never rebuilds threads. Starting from the full pool size the
+// tuner measures average step latency over a few steps per candidate, walks
+// downwards while latency improves, then probes back up from the best point,
+// and pins the winner. The pinned value is exported to
+// TF_INTER_OP_AUTOTUNE_FILE (when set) so subsequent processes skip the
+// warmup and start tuned.
+//
+// Note that, exactly as with a manually configured small pool, very low
+// parallelism can starve ops that block inside their kernels; the probing
+// floor defaults to 2 and can be raised with TF_INTER_OP_AUTOTUNE_MIN.
+struct DirectSession::InterOpAutoTuner {
+  // Steps averaged per candidate, and a hard cap on the warmup window.
+  static constexpr int kStepsPerCandidate = 5;
+  static constexpr int kMaxTuningSteps = 100;
+  // The first steps of a session are dominated by one-off executor and
+  // kernel instantiation costs; don't let them skew the baseline.
+  static constexpr int kDiscardSteps = 2;
+
+  InterOpAutoTuner(Env* env, int32_t pool_parallelism)
+      : env(env),
+        max_parallelism(pool_parallelism),
+        step(std::max<int32_t>(1, pool_parallelism / 8)),
+        current(pool_parallelism),
+        best(pool_parallelism) {
+    int64_t min_value = 2;
+    TF_CHECK_OK(
+        ReadInt64FromEnvVar("TF_INTER_OP_AUTOTUNE_MIN", 2, &min_value));
+    min_parallelism = std::max<int32_t>(1, static_cast<int32_t>(min_value));
+    TF_CHECK_OK(
+        ReadStringFromEnvVar("TF_INTER_OP_AUTOTUNE_FILE", "", &export_path));
+
+    // Start from a previously exported setting when one is available.
+    string contents;
+    int32_t pinned;
+    if (!export_path.empty() && env->FileExists(export_path).ok() &&
+        ReadFileToString(env, export_path, &contents).ok() &&
+        strings::safe_strto32(contents, &pinned)) {
+      mutex_lock l(mu);
+      best = current = Clamp(pinned);
+      converged = true;
+      LOG(INFO) << "Inter-op auto-tuner pinned at " << best << " (from "
+                << export_path << ")";
+    }
+  }
+
+  // The effective inter-op parallelism to use for the next step.
+  int32_t ParallelismForStep() {
+    mutex_lock l(mu);
+    return converged ? best : current;
+  }
+
+  void RecordStep(uint64 latency_usecs) {
+    mutex_lock l(mu);
+    if (converged) {
+      return;
+    }
+    if (discard_steps > 0) {
+      --discard_steps;
+      return;
+    }
+    ++total_steps;
+    latency_sum += latency_usecs;
+    if (++steps_measured < kStepsPerCandidate) {
+      if (total_steps >= kMaxTuningSteps) Converge();
+      return;
+    }
+    const uint64 avg = latency_sum / steps_measured;
+    latency_sum = 0;
+    steps_measured = 0;
+
+    if (best_latency == 0) {
+      // Baseline at the configured pool size; probe downwards first.
+      best_latency = avg;
+      Advance();
+    } else if (avg < best_latency) {
+      best_latency = avg;
+      best = current;
+      Advance();
+    } else if (direction < 0) {
+      // Walking down stopped paying off; probe back up from the best point.
+      direction = 1;
+      current = best;
+      Advance();
+    } else {
+      Converge();
+    }
+    if (!converged && total_steps >= kMaxTuningSteps) Converge();
+  }
+
+  int32_t Clamp(int32_t value) const {
+    return std::max(min_parallelism, std::min(max_parallelism, value));
+  }
+
+  void Advance() TF_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    const int32_t next = Clamp(current + direction * step);
+    if (next != current) {
+      current = next;
+    } else if (direction < 0) {
+      // Hit the floor; probe back up from the best point.
+      direction = 1;
+      const int32_t up = Clamp(best + step);
+      if (up == best) {
+        Converge();
+      } else {
+        current = up;
+      }
+    } else {
+      Converge();
+    }
+  }
+
+  void Converge() TF_EXCLUSIVE_LOCKS_REQUIRED(mu) {
+    converged = true;
+    current = best;
+    LOG(INFO) << "Inter-op auto-tuner converged: effective parallelism "
+              << best << " of " << max_parallelism
+              << " pool threads (avg step latency " << best_latency << " us)";
+    if (!export_path.empty()) {
+      const Status s =
+          WriteStringToFile(env, export_path, strings::StrCat(best, "\n"));
+      if (!s.ok()) {
+        LOG(WARNING) << "Failed to export inter-op auto-tuner result to "
+                     << export_path << ": " << s.message();
+      }
+    }
+  }
+
+  Env* const env;
+  int32_t max_parallelism;
+  int32_t min_parallelism;
+  int32_t step;
+  string export_path;
+
+  mutex mu;
+  bool converged TF_GUARDED_BY(mu) = false;
+  int32_t current TF_GUARDED_BY(mu);
+  int32_t best TF_GUARDED_BY(mu);
+  int32_t direction TF_GUARDED_BY(mu) = -1;
+  uint64 best_latency TF_GUARDED_BY(mu) = 0;
+  uint64 latency_sum TF_GUARDED_BY(mu) = 0;
+  int steps_measured TF_GUARDED_BY(mu) = 0;
+  int total_steps TF_GUARDED_BY(mu) = 0;
+  int discard_steps TF_GUARDED_BY(mu) = kDiscardSteps;
+};
+
 bool DirectSession::ShouldUseRunHandlerPool(
     const RunOptions& run_options) const {
   if (options_.config.use_per_session_threads()) return false;
@@ -358,6 +661,12 @@ DirectSession::DirectSession(const SessionOptions& options,
         GlobalThreadPool(options, run_in_caller_thread_ ? 1 : 0),
         false /* owned */);
   }
+  if (InterOpAutoTuneEnabled() && !run_in_caller_thread_ &&
+      !thread_pools_.empty() && thread_pools_[0].first != nullptr &&
+      thread_pools_[0].first->NumThreads() > 1) {
+    inter_op_tuner_ = std::make_unique<InterOpAutoTuner>(
+        options_.env, thread_pools_[0].first->NumThreads());
+  }
   // The default value of sync_on_finish will be flipped soon and this
   // environment variable will be removed as well.
   const Status status =
@@ -653,6 +962,33 @@ Status DirectSession::RunInternal(
     };
   }
 
+  const int32_t inter_op_batch_size =
+      options_.config.experimental().inter_op_scheduling_batch_size();
+  if (pool != nullptr && inter_op_batch_size > 1) {
+    // Batch ready closures into chained pool submissions to amortize thread
+    // wakeups. The wrapper is shared because closures may be scheduled from
+    // executor threads after this frame returns.
+    auto batching_runner = std::make_shared<BatchingInterOpRunner>(
+        default_runner, inter_op_batch_size);
+    default_runner = [batching_runner](Executor::Args::Closure c) {
+      batching_runner->Schedule(std::move(c));
+    };
+  }
+
+  // While the inter-op auto-tuner is probing (or pinned below the configured
+  // pool size), cap the closures in flight to emulate the candidate size.
+  if (inter_op_tuner_ != nullptr && pool != nullptr &&
+      handler_ptr == nullptr) {
+    const int32_t parallelism = inter_op_tuner_->ParallelismForStep();
+    if (parallelism < pool->NumThreads()) {
+      auto limited_runner = std::make_shared<ConcurrencyLimitedRunner>(
+          default_runner, parallelism);
+      default_runner = [limited_runner](Executor::Args::Closure c) {
+        limited_runner->Schedule(std::move(c));
+      };
+    }
+  }
+
   // Start parallel Executors.
 
   // We can execute this step synchronously on the calling thread whenever
@@ -679,6 +1015,8 @@ Status DirectSession::RunInternal(
   args.run_all_kernels_inline = pool == nullptr;
   args.start_time_usecs = start_time_usecs;
   args.deadline = deadline;
+  args.priority =
+      run_options.experimental().run_handler_pool_options().priority();
 
   const bool do_trace = (run_options.trace_level() > RunOptions::NO_TRACE);
 
@@ -841,6 +1179,11 @@ Status DirectSession::RunInternal(
       }
     }
   }
+  // Feed the step latency back to the auto-tuner, but only for steps that
+  // actually ran under its effective parallelism.
+  if (inter_op_tuner_ != nullptr && pool != nullptr && handler == nullptr) {
+    inter_op_tuner_->RecordStep(options_.env->NowMicros() - start_time_usecs);
+  }
   metrics::UpdateGraphExecTime(options_.env->NowMicros() - start_time_usecs);
 
   return OkStatus();
@@ -883,6 +1226,20 @@ Status DirectSession::Run(const RunOptions& run_options,
   run_state_args.collective_graph_key =
       run_options.experimental().collective_graph_key();
 
+  // Collect the observed values of stable feeds, so the executors can be
+  // specialized on them. See `DeclareStableFeeds()`.
+  {
+    mutex_lock l(stable_feeds_lock_);
+    if (!stable_feeds_.empty()) {
+      for (const auto& it : inputs) {
+        if (stable_feeds_.count(it.first) > 0 &&
+            IsSpecializableStableFeedValue(it.second)) {
+          run_state_args.stable_feed_values.emplace(it.first, it.second);
+        }
+      }
+    }
+  }
+
   TF_RETURN_IF_ERROR(GetOrCreateExecutors(input_tensor_names, output_names,
                                           target_nodes, &executors_and_keys,
                                           &run_state_args));
@@ -1328,6 +1685,7 @@ Status DirectSession::CreateExecutors(
   options.use_function_convention = !run_state_args->is_partial_run;
   options.collective_graph_key =
       callable_options.run_options().experimental().collective_graph_key();
+  options.stable_feed_values = run_state_args->stable_feed_values;
   if (options_.config.experimental()
           .collective_deterministic_sequential_execution()) {
     options.collective_order = GraphCollectiveOrder::kEdges;
@@ -1507,11 +1865,19 @@ Status DirectSession::GetOrCreateExecutors(
         run_state_args->debug_options.debug_tensor_watch_opts());
   }
 
+  // Executors specialized on stable feed values are cached per observed
+  // value, so the values are mixed into the cache keys.
+  const string stable_feed_signature =
+      SummarizeStableFeedValues(run_state_args->stable_feed_values);
+
   // Fast lookup path, no sorting.
-  const string key = strings::StrCat(
+  string key = strings::StrCat(
       absl::StrJoin(inputs, ","), "->", absl::StrJoin(outputs, ","), "/",
       absl::StrJoin(target_nodes, ","), "/", run_state_args->is_partial_run,
       "/", debug_tensor_watches_summary);
+  if (!stable_feed_signature.empty()) {
+    strings::StrAppend(&key, "/", stable_feed_signature);
+  }
   // Set the handle, if it's needed to log memory or for partial run.
   if (handle_name_counter_value >= 0) {
     run_state_args->handle =
@@ -1541,10 +1907,14 @@ Status DirectSession::GetOrCreateExecutors(
   std::vector<string> tn_sorted(target_nodes.begin(), target_nodes.end());
   std::sort(tn_sorted.begin(), tn_sorted.end());
 
-  const string sorted_key = strings::StrCat(
+  const string base_sorted_key = strings::StrCat(
       absl::StrJoin(inputs_sorted, ","), "->",
       absl::StrJoin(outputs_sorted, ","), "/", absl::StrJoin(tn_sorted, ","),
       "/", run_state_args->is_partial_run, "/", debug_tensor_watches_summary);
+  string sorted_key = base_sorted_key;
+  if (!stable_feed_signature.empty()) {
+    strings::StrAppend(&sorted_key, "/", stable_feed_signature);
+  }
   // Set the handle, if its needed to log memory or for partial run.
   if (handle_name_counter_value >= 0) {
     run_state_args->handle =
@@ -1561,6 +1931,22 @@ Status DirectSession::GetOrCreateExecutors(
     }
   }
 
+  // Cap the number of value-specialized variants created per signature; runs
+  // observing further values fall back to the unspecialized executors.
+  if (!stable_feed_signature.empty()) {
+    bool cap_reached;
+    {
+      mutex_lock l(executor_lock_);
+      cap_reached = stable_feed_specialization_counts_[base_sorted_key] >=
+                    kMaxStableFeedSpecializations;
+    }
+    if (cap_reached) {
+      run_state_args->stable_feed_values.clear();
+      return GetOrCreateExecutors(inputs, outputs, target_nodes,
+                                  executors_and_keys, run_state_args);
+    }
+  }
+
   // Nothing found, so create the executors and store in the cache.
   // The executor_lock_ is intentionally released while executors are
   // being created.
@@ -1596,6 +1982,9 @@ Status DirectSession::GetOrCreateExecutors(
       sorted_key, std::shared_ptr<ExecutorsAndKeys>(std::move(ek)));
   if (insert_result.second) {
     functions_.push_back(std::move(func_info));
+    if (!stable_feed_signature.empty()) {
+      ++stable_feed_specialization_counts_[base_sorted_key];
+    }
   }
 
   // Insert the value under the original key, so the fast path lookup will work
@@ -1606,6 +1995,44 @@ Status DirectSession::GetOrCreateExecutors(
   return OkStatus();
 }
 
+Status DirectSession::PrewarmExecutors(
+    const std::vector<ExecutorSignature>& signatures) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  TF_RETURN_IF_ERROR(CheckGraphCreated("PrewarmExecutors()"));
+  if (signatures.empty()) return OkStatus();
+
+  thread::ThreadPool prewarm_pool(
+      Env::Default(), "prewarm_executors",
+      std::min<int>(signatures.size(), port::MaxParallelism()));
+  mutex status_mu;
+  Status first_error;
+  BlockingCounter counter(signatures.size());
+  for (const ExecutorSignature& signature : signatures) {
+    prewarm_pool.Schedule([this, &signature, &status_mu, &first_error,
+                           &counter]() {
+      DebugOptions debug_options;
+      RunStateArgs run_state_args(debug_options);
+      ExecutorsAndKeys* executors_and_keys;
+      Status s =
+          GetOrCreateExecutors(signature.inputs, signature.outputs,
+                               signature.target_nodes, &executors_and_keys,
+                               &run_state_args);
+      if (!s.ok()) {
+        mutex_lock l(status_mu);
+        if (first_error.ok()) first_error = s;
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  return first_error;
+}
+
+void DirectSession::DeclareStableFeeds(const std::vector<string>& feed_names) {
+  mutex_lock l(stable_feeds_lock_);
+  stable_feeds_.insert(feed_names.begin(), feed_names.end());
+}
+
 Status DirectSession::CreateGraphs(
     const BuildGraphOptions& subgraph_options,
     std::unordered_map<string, std::unique_ptr<Graph>>* outputs,
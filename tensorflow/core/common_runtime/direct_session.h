@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_COMMON_RUNTIME_DIRECT_SESSION_H_
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -118,6 +119,34 @@ class DirectSession : public Session {
     cost_model_manager_.ExportCostModels(cost_models);
   }
 
+  // Builds and caches the executors for the given (inputs, outputs, targets)
+  // signatures ahead of the first Run() call with each signature, performing
+  // the graph pruning and partitioning that would otherwise happen on the
+  // request path. Signatures are warmed in parallel on the inter-op pool.
+  // Returns the first error encountered, after attempting all signatures.
+  //
+  // NOTE: Experimental and subject to change.
+  struct ExecutorSignature {
+    std::vector<string> inputs;
+    std::vector<string> outputs;
+    std::vector<string> target_nodes;
+  };
+  ::tensorflow::Status PrewarmExecutors(
+      const std::vector<ExecutorSignature>& signatures);
+
+  // Declares that the given feeds are stable: each takes one of a small
+  // number of values that stays fixed across many Run() calls, e.g. a
+  // model_variant flag driving a tf.cond. When a stable feed is fed a scalar
+  // flag value, the session specializes the pruned graph on the observed
+  // value — the feed is baked into the optimized graph as a constant, so
+  // branches that are dead under that value are eliminated — and caches one
+  // executor variant per observed value, up to a small number of variants per
+  // (inputs, outputs, targets) signature. Feeds not declared here are
+  // unaffected.
+  //
+  // NOTE: Experimental and subject to change.
+  void DeclareStableFeeds(const std::vector<string>& feed_names);
+
   ::tensorflow::Status MakeCallable(const CallableOptions& callable_options,
                                     CallableHandle* out_handle) override;
 
@@ -236,6 +265,9 @@ class DirectSession : public Session {
     std::unique_ptr<Graph> graph;
     const DebugOptions& debug_options;
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+    // Observed values of stable feeds to specialize the executors on, keyed
+    // by feed name. See `DeclareStableFeeds()`.
+    std::map<string, Tensor> stable_feed_values;
   };
 
   // Retrieves an already existing set of executors to run 'inputs' and
@@ -350,6 +382,12 @@ class DirectSession : public Session {
   // is owned.
   std::vector<std::pair<thread::ThreadPool*, bool>> thread_pools_;
 
+  // When TF_INTER_OP_AUTOTUNE is set, hill-climbs the effective inter-op
+  // parallelism over a warmup window of steps and pins the best setting.
+  // Defined in direct_session.cc.
+  struct InterOpAutoTuner;
+  std::unique_ptr<InterOpAutoTuner> inter_op_tuner_;
+
   Status init_error_;  // Set to an error if construction failed.
 
   // If true, blocks until device has finished all queued operations in a step.
@@ -367,6 +405,20 @@ class DirectSession : public Session {
   std::unordered_map<string, std::shared_ptr<ExecutorsAndKeys>> executors_
       TF_GUARDED_BY(executor_lock_);
 
+  // The maximum number of value-specialized executor variants to create per
+  // (inputs, outputs, targets) signature. Once the cap is reached, runs with
+  // a new stable feed value fall back to the unspecialized executors.
+  static constexpr int kMaxStableFeedSpecializations = 4;
+
+  // Feeds declared stable via `DeclareStableFeeds()`.
+  mutex stable_feeds_lock_;
+  std::unordered_set<string> stable_feeds_ TF_GUARDED_BY(stable_feeds_lock_);
+
+  // The number of value-specialized executor variants created per signature,
+  // keyed by the unspecialized sorted executor cache key.
+  std::unordered_map<string, int> stable_feed_specialization_counts_
+      TF_GUARDED_BY(executor_lock_);
+
   class RunCallableCallFrame;
   struct Callable {
     std::shared_ptr<ExecutorsAndKeys> executors_and_keys;
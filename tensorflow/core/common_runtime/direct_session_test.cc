@@ -43,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/stacktrace.h"
@@ -153,6 +154,129 @@ TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork) {
   EXPECT_FLOAT_EQ(5.0, mat(0, 0));
 }
 
+TEST_F(DirectSessionMinusAXTest, PrewarmExecutors) {
+  Initialize({3, 2, -1, 0});
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def_));
+
+  auto* direct_session = dynamic_cast<DirectSession*>(session.get());
+  ASSERT_TRUE(direct_session != nullptr);
+
+  // Warm the executors for two signatures before the first Run().
+  std::vector<DirectSession::ExecutorSignature> signatures(2);
+  signatures[0].outputs = {y_ + ":0"};
+  signatures[0].target_nodes = {y_neg_};
+  signatures[1].outputs = {y_ + ":0"};
+  TF_ASSERT_OK(direct_session->PrewarmExecutors(signatures));
+
+  // Running a warmed signature produces the same results as a cold run.
+  std::vector<std::pair<string, Tensor>> inputs;
+  std::vector<string> output_names = {y_ + ":0"};
+  std::vector<string> target_nodes = {y_neg_};
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(session->Run(inputs, output_names, target_nodes, &outputs));
+  ASSERT_EQ(1, outputs.size());
+  auto mat = outputs[0].matrix<float>();
+  ASSERT_TRUE(outputs[0].IsInitialized());
+  EXPECT_FLOAT_EQ(5.0, mat(0, 0));
+}
+
+TEST(DirectSessionTest, StableFeedSpecialization) {
+  Graph g(OpRegistry::Global());
+
+  // `pred` selects between two branches through a Switch/Merge pair,
+  // mimicking a tf.cond on a request-constant flag.
+  Node* pred;
+  TF_CHECK_OK(NodeBuilder(g.NewName("pred"), "Placeholder")
+                  .Attr("shape", TensorShape())
+                  .Attr("dtype", DT_BOOL)
+                  .Finalize(&g, &pred));
+  Tensor data_value(DT_FLOAT, TensorShape({}));
+  data_value.scalar<float>()() = 1.0;
+  Node* data = test::graph::Constant(&g, data_value);
+  Node* switch_node = test::graph::Switch(&g, data, pred);
+  Node* on_false = test::graph::Identity(&g, switch_node, 0);
+  Node* on_true = test::graph::Unary(&g, "Neg", switch_node, 1);
+  Node* merge = test::graph::Merge(&g, on_false, on_true);
+
+  GraphDef def;
+  g.ToGraphDef(&def);
+
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+
+  auto* direct_session = dynamic_cast<DirectSession*>(session.get());
+  ASSERT_TRUE(direct_session != nullptr);
+  direct_session->DeclareStableFeeds({pred->name() + ":0"});
+
+  Tensor pred_value(DT_BOOL, TensorShape({}));
+  std::vector<Tensor> outputs;
+  pred_value.scalar<bool>()() = true;
+  TF_ASSERT_OK(session->Run({{pred->name() + ":0", pred_value}},
+                            {merge->name() + ":0"}, {}, &outputs));
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_FLOAT_EQ(-1.0, outputs[0].scalar<float>()());
+
+  // A different observed value gets its own specialized executors.
+  pred_value.scalar<bool>()() = false;
+  TF_ASSERT_OK(session->Run({{pred->name() + ":0", pred_value}},
+                            {merge->name() + ":0"}, {}, &outputs));
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_FLOAT_EQ(1.0, outputs[0].scalar<float>()());
+
+  // Repeating a previously observed value reuses the cached variant.
+  pred_value.scalar<bool>()() = true;
+  TF_ASSERT_OK(session->Run({{pred->name() + ":0", pred_value}},
+                            {merge->name() + ":0"}, {}, &outputs));
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_FLOAT_EQ(-1.0, outputs[0].scalar<float>()());
+}
+
+TEST(DirectSessionTest, InterOpAutoTuneConvergesAndExports) {
+  const string export_path =
+      strings::StrCat(testing::TmpDir(), "/inter_op_autotune");
+  setenv("TF_INTER_OP_AUTOTUNE", "1", 1);
+  setenv("TF_INTER_OP_AUTOTUNE_FILE", export_path.c_str(), 1);
+
+  Graph g(OpRegistry::Global());
+  Tensor v(DT_FLOAT, TensorShape({2, 2}));
+  test::FillValues<float>(&v, {3, 2, -1, 0});
+  Node* a = test::graph::Constant(&g, v);
+  Node* x = test::graph::Constant(&g, v);
+  Node* y = test::graph::Matmul(&g, a, x, false, false);
+  GraphDef def;
+  g.ToGraphDef(&def);
+
+  SessionOptions options;
+  options.config.set_inter_op_parallelism_threads(8);
+  options.config.set_use_per_session_threads(true);
+  std::unique_ptr<Session> session(NewSession(options));
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+
+  // Enough steps to exhaust the tuner's warmup window; every step must
+  // still produce correct results while candidates are being probed.
+  std::vector<Tensor> outputs;
+  for (int i = 0; i < 120; ++i) {
+    TF_ASSERT_OK(session->Run({}, {y->name() + ":0"}, {}, &outputs));
+    ASSERT_EQ(1, outputs.size());
+    EXPECT_FLOAT_EQ(7.0, outputs[0].matrix<float>()(0, 0));
+  }
+
+  // The converged setting is exported for subsequent processes.
+  string contents;
+  TF_ASSERT_OK(ReadFileToString(Env::Default(), export_path, &contents));
+  int32_t pinned = 0;
+  ASSERT_TRUE(strings::safe_strto32(contents, &pinned));
+  EXPECT_GE(pinned, 2);
+  EXPECT_LE(pinned, 8);
+
+  unsetenv("TF_INTER_OP_AUTOTUNE");
+  unsetenv("TF_INTER_OP_AUTOTUNE_FILE");
+}
+
 TEST_F(DirectSessionMinusAXTest, RunSimpleNetwork_Callable) {
   Initialize({3, 2, -1, 0});
   auto session = CreateSession();
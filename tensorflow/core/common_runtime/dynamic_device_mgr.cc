@@ -158,6 +158,11 @@ int DynamicDeviceMgr::NumDevices() const {
   return dynamic_devices_.size();
 }
 
+int64_t DynamicDeviceMgr::DeviceSetVersion() const {
+  tf_shared_lock l(devices_mu_);
+  return device_set_version_;
+}
+
 Status DynamicDeviceMgr::AddDevices(
     std::vector<std::unique_ptr<Device>> devices) {
   mutex_lock l(devices_mu_);
@@ -181,6 +186,7 @@ Status DynamicDeviceMgr::AddDevices(
     device_incarnation_set_.insert(d->attributes().incarnation());
     dynamic_devices_.emplace(d.get(), std::move(d));
   }
+  if (!devices.empty()) device_set_version_++;
   return OkStatus();
 }
 
@@ -221,6 +227,7 @@ Status DynamicDeviceMgr::RemoveDevices(const std::vector<Device*>& devices) {
     stale_devices_.add(std::move(it->second));
     dynamic_devices_.erase(it);
   }
+  if (!devices.empty()) device_set_version_++;
   return OkStatus();
 }
 
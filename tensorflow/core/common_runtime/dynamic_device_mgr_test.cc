@@ -147,6 +147,26 @@ TEST(DynamicDeviceMgrTest, RemoveDeviceByNameFromMgr) {
   EXPECT_EQ(dm->ListDevices().size(), 1);
 }
 
+TEST(DynamicDeviceMgrTest, DeviceSetVersionChangesOnUpdate) {
+  std::unique_ptr<Device> d0(CreateDevice("CPU", "/device:CPU:0"));
+  Device* d0_ptr = d0.get();
+
+  auto dm = std::make_unique<DynamicDeviceMgr>();
+  const int64_t initial_version = dm->DeviceSetVersion();
+
+  std::vector<std::unique_ptr<Device>> devices;
+  devices.emplace_back(std::move(d0));
+  TF_CHECK_OK(dm->AddDevices(std::move(devices)));
+  const int64_t version_after_add = dm->DeviceSetVersion();
+  EXPECT_NE(version_after_add, initial_version);
+  // Read-only calls do not change the version.
+  EXPECT_EQ(dm->DeviceSetVersion(), version_after_add);
+
+  std::vector<Device*> removed_devices{d0_ptr};
+  TF_CHECK_OK(dm->RemoveDevices(removed_devices));
+  EXPECT_NE(dm->DeviceSetVersion(), version_after_add);
+}
+
 TEST(DynamicDeviceMgrTest, AddRepeatedDeviceToMgr) {
   std::unique_ptr<Device> d0(CreateDevice("CPU", "/device:CPU:0"));
   std::unique_ptr<Device> d1(CreateDevice("CPU", "/device:CPU:0"));
@@ -236,9 +236,40 @@ void AttrBuilder::FillAttrValueMapWithoutDefaults(AttrValueMap* m) const {
   }
 }
 
+namespace {
+
+void CombineUnordered(const tensorflow::Fprint128& a,
+                      tensorflow::Fprint128* b) {
+  b->low64 += a.low64;
+  b->high64 += a.high64;
+}
+
+inline tensorflow::Fprint128 CacheKeyHelper(StringPiece s,
+                                            const tensorflow::Fprint128& b) {
+  tensorflow::Fprint128 a = tensorflow::Fingerprint128(s);
+  return FingerprintCat128(a, b);
+}
+
+inline tensorflow::Fprint128 CacheKeyHelper(StringPiece s, uint64 b) {
+  return CacheKeyHelper(s, {b, b});
+}
+
+}  // namespace
+
 void AttrBuilder::AddAttrIfNotPresent(StringPiece attr_name,
                                       const AttrValue& value) {
-  encoded_attrs_.emplace(string(attr_name), value.SerializeAsString());
+  string encoded = value.SerializeAsString();
+  auto result = encoded_attrs_.emplace(string(attr_name), std::move(encoded));
+  if (result.second) {
+    // Fold the new attribute into the running fingerprint. Attributes are
+    // combined order-independently, so the result matches hashing the whole
+    // map; if the attribute was already present the map (and hence the
+    // fingerprint) is unchanged.
+    CombineUnordered(
+        CacheKeyHelper(attr_name, tensorflow::Fingerprint128(
+                                      result.first->second)),
+        &attr_fingerprint_);
+  }
 }
 
 const NodeDef& AttrBuilder::BuildNodeDef() {
@@ -256,8 +287,16 @@ const NodeDef& AttrBuilder::BuildNodeDef() {
 }
 
 void AttrBuilder::CopyAttributes(const AttrBuilder& other) {
-  encoded_attrs_.insert(other.encoded_attrs_.begin(),
-                        other.encoded_attrs_.end());
+  for (const auto& entry : other.encoded_attrs_) {
+    auto result = encoded_attrs_.emplace(entry.first, entry.second);
+    if (result.second) {
+      CombineUnordered(
+          CacheKeyHelper(entry.first,
+                         tensorflow::Fingerprint128(entry.second)),
+          &attr_fingerprint_);
+    }
+  }
+  cached_cache_key_ = std::nullopt;
 }
 
 Status AttrTypeByName(const AttrTypeMap& m, const string& attr_name,
@@ -276,26 +315,6 @@ Status AttrTypeByName(const AttrTypeMap& m, const string& attr_name,
   return OkStatus();
 }
 
-namespace {
-
-void CombineUnordered(const tensorflow::Fprint128& a,
-                      tensorflow::Fprint128* b) {
-  b->low64 += a.low64;
-  b->high64 += a.high64;
-}
-
-inline tensorflow::Fprint128 CacheKeyHelper(StringPiece s,
-                                            const tensorflow::Fprint128& b) {
-  tensorflow::Fprint128 a = tensorflow::Fingerprint128(s);
-  return FingerprintCat128(a, b);
-}
-
-inline tensorflow::Fprint128 CacheKeyHelper(StringPiece s, uint64 b) {
-  return CacheKeyHelper(s, {b, b});
-}
-
-}  // namespace
-
 tensorflow::Fprint128 AttrBuilder::CacheKey(const StringPiece device) {
   if (!cached_cache_key_ || device != device_for_cached_cache_key_) {
     cached_cache_key_ = BuildCacheKeyForDevice(device);
@@ -309,10 +328,10 @@ tensorflow::Fprint128 AttrBuilder::BuildCacheKeyForDevice(
     const StringPiece device) const {
   tensorflow::Fprint128 f = tensorflow::Fingerprint128(op_name());
   f = tsl::FingerprintCat128(f, tensorflow::Fingerprint128(device));
-  for (const auto& p : encoded_attrs_) {
-    CombineUnordered(
-        CacheKeyHelper(p.first, tensorflow::Fingerprint128(p.second)), &f);
-  }
+  // attr_fingerprint_ already combines the per-attribute fingerprints
+  // order-independently, so the key is identical to hashing every entry of
+  // encoded_attrs_ here.
+  CombineUnordered(attr_fingerprint_, &f);
   return f;
 }
 
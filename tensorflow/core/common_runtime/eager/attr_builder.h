@@ -107,6 +107,7 @@ class AttrBuilder : public AbstractOpAttrs {
     num_inputs_ = 0;
     encoded_attrs_.clear();
     node_def_finalized_ = false;
+    attr_fingerprint_ = {0, 0};
     cached_cache_key_ = std::nullopt;
     device_for_cached_cache_key_.clear();
   }
@@ -205,6 +206,12 @@ class AttrBuilder : public AbstractOpAttrs {
   bool node_def_initialized_;
   bool node_def_finalized_;
 
+  // Order-independent fingerprint of the attributes in encoded_attrs_,
+  // maintained incrementally as attributes are added. This makes CacheKey
+  // O(1) in the number of attributes instead of re-hashing the whole map on
+  // every call.
+  tensorflow::Fprint128 attr_fingerprint_{0, 0};
+
   std::optional<tensorflow::Fprint128> cached_cache_key_;
   string device_for_cached_cache_key_;
 };
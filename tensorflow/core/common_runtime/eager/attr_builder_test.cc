@@ -85,6 +85,28 @@ TEST(AttrTypeMap, CacheKey) {
   ASSERT_FALSE(cache_key == a.CacheKey("cpu:0"));
 }
 
+TEST(AttrTypeMap, CacheKeyAttrOrderIndependent) {
+  // The incrementally maintained attr fingerprint must not depend on the
+  // order in which attributes are set.
+  AttrBuilder a("op_name");
+  a.Set("T", TF_FLOAT);
+  a.Set("x", 1.0);
+
+  AttrBuilder b("op_name");
+  b.Set("x", 1.0);
+  b.Set("T", TF_FLOAT);
+
+  ASSERT_TRUE(a.CacheKey("cpu:0") == b.CacheKey("cpu:0"));
+
+  // Reset clears the fingerprint along with the attributes.
+  a.Reset("op_name");
+  a.Set("T", TF_FLOAT);
+  b.Reset("op_name");
+  b.Set("T", TF_FLOAT);
+  ASSERT_TRUE(a.CacheKey("cpu:0") == b.CacheKey("cpu:0"));
+  ASSERT_FALSE(a.CacheKey("cpu:0") == a.CacheKey("cpu:1"));
+}
+
 string ToString(const AttrValueMap& m) {
   std::vector<string> strs;
   for (const auto& e : m) {
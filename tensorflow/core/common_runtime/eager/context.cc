@@ -457,6 +457,7 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
     mutex_lock ml(cache_mu_);
     default_executor_.WaitForAllPendingNodes().IgnoreError();
     kernel_cache_.clear();
+    kernel_cache_generation_.fetch_add(1, std::memory_order_relaxed);
     for (auto& entry : registered_functions_) {
       entry.second->cached_kernel_keys->clear();
     }
@@ -465,6 +466,7 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
     mutex_lock dl(device_cache_mu_);
     device_cache_.clear();
   }
+  tensor_pool_.Clear();
   {
     mutex_lock ml(metadata_mu_);
     step_container_ = std::make_unique<ScopedStepContainer>(
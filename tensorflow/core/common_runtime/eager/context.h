@@ -41,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/eager/eager_executor.h"
 #include "tensorflow/core/common_runtime/eager/kernel_and_device.h"
 #include "tensorflow/core/common_runtime/eager/rendezvous_cache.h"
+#include "tensorflow/core/common_runtime/eager/tensor_pool.h"
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/process_function_library_runtime.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
@@ -283,6 +284,17 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
   void AddKernelToCache(Fprint128 cache_key, KernelAndDevice* kernel);
   void AddDeviceToCache(Fprint128 device_cache_key, Device* device);
 
+  // Incremented every time the kernel cache is cleared. Kernels pinned
+  // outside the cache (e.g. the call-site kernel cache on EagerOperation)
+  // record this value and must not be reused once it changes.
+  uint64 kernel_cache_generation() const {
+    return kernel_cache_generation_.load(std::memory_order_relaxed);
+  }
+
+  // Pool of recycled host tensor buffers for transient eager tensors. See
+  // tensor_pool.h; disabled unless TF_EAGER_TENSOR_POOL_MAX_BYTES is set.
+  EagerTensorPool* tensor_pool() const { return &tensor_pool_; }
+
   bool LogDevicePlacement() const { return log_device_placement_; }
   void SetLogDevicePlacement(bool enable) override {
     log_device_placement_ = enable;
@@ -772,6 +784,10 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
   std::unordered_map<Fprint128, core::RefCountPtr<KernelAndDevice>,
                      Fprint128Hasher>
       kernel_cache_ TF_GUARDED_BY(cache_mu_);
+  std::atomic<uint64> kernel_cache_generation_{0};
+  // Internally synchronized; mutable so const users of the context (e.g.
+  // TensorHandle::CopyToDevice) can draw from the pool.
+  mutable EagerTensorPool tensor_pool_{EagerTensorPool::MaxBytesFromEnv()};
   std::unordered_map<string, RegisteredFunction*> registered_functions_
       TF_GUARDED_BY(cache_mu_);
 
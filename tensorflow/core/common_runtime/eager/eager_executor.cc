@@ -15,13 +15,16 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/eager/eager_executor.h"
 
+#include <algorithm>
 #include <forward_list>
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
@@ -32,24 +35,55 @@ bool IsAsyncWaitForRemoteFunctionEnabled() {
                                  true, &enabled));
   return enabled;
 }
+
+// Number of independent per-device queues used by async executors. 1 (the
+// default) preserves the historical single-queue behavior.
+int NumExecutorDeviceQueues() {
+  int64_t num_queues = 1;
+  TF_CHECK_OK(
+      ReadInt64FromEnvVar("TF_EAGER_EXECUTOR_DEVICE_QUEUES", 1, &num_queues));
+  if (num_queues < 1) {
+    num_queues = 1;
+  }
+  return num_queues;
+}
+
+// Maximum number of adjacent nodes an executor thread takes from its queue in
+// one critical section. Dispatching a small window of nodes per wakeup
+// amortizes the queue synchronization cost over runs of cheap (e.g.
+// elementwise) ops.
+constexpr int kDispatchLookaheadWindow = 8;
 }  // namespace
 
 EagerExecutor::EagerExecutor(bool async, bool enable_streaming_enqueue,
                              int in_flight_nodes_limit)
     : next_node_id_(0),
+      num_queues_(async ? NumExecutorDeviceQueues() : 1),
+      node_queues_(num_queues_),
       ok_(true),
+      num_active_threads_(async ? num_queues_ : 0),
       thread_(async ? tensorflow::Env::Default()->StartThread(
                           tensorflow::ThreadOptions(), "eager_async_executor",
-                          std::bind(&EagerExecutor::Run, this))
+                          std::bind(&EagerExecutor::Run, this, 0))
                     : nullptr),
       last_eager_client_(nullptr),
       enable_async_wait_for_remote_function_(
           IsAsyncWaitForRemoteFunctionEnabled()),
       enable_streaming_enqueue_(enable_streaming_enqueue),
       in_flight_nodes_limit_(in_flight_nodes_limit) {
-  if (async && in_flight_nodes_limit_ > 0) {
-    VLOG(4) << "EagerExecutor InFlightNodes limit is set to "
-            << in_flight_nodes_limit_;
+  if (async) {
+    device_queue_threads_.reserve(num_queues_ - 1);
+    for (int i = 1; i < num_queues_; ++i) {
+      device_queue_threads_.push_back(std::unique_ptr<Thread>(
+          tensorflow::Env::Default()->StartThread(
+              tensorflow::ThreadOptions(),
+              strings::StrCat("eager_async_executor_", i),
+              [this, i] { Run(i); })));
+    }
+    if (in_flight_nodes_limit_ > 0) {
+      VLOG(4) << "EagerExecutor InFlightNodes limit is set to "
+              << in_flight_nodes_limit_;
+    }
   }
 }
 
@@ -160,10 +194,12 @@ Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
     } else {
       status = status_;
       if (status.ok()) {
-        node_queue_.push(std::move(item));
-        // If there were no previous nodes pending, wake the run thread to
-        // start processing requests again.
-        if (node_queue_.size() == 1) {
+        item->queue_index = QueueIndexForNodeLocked(item->node.get());
+        auto& queue = node_queues_[item->queue_index];
+        queue.push_back(std::move(item));
+        // If there were no previous nodes pending in this queue, wake the run
+        // threads to start processing requests again.
+        if (queue.size() == 1) {
           nodes_pending_.notify_all();
         }
         if (in_flight_nodes_limit_ == 0) {
@@ -172,12 +208,12 @@ Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
         // Limit the concurrency by controlling the number of in flight nodes.
         while (true) {
           int64_t in_flight_nodes_count =
-              node_queue_.size() + unfinished_nodes_.size();
+              QueuedNodesCountLocked() + unfinished_nodes_.size();
           if (in_flight_nodes_count < in_flight_nodes_limit_) {
             break;
           }
-          VLOG(4) << "Hitting in-flight node limit node_queue_.size() = "
-                  << node_queue_.size()
+          VLOG(4) << "Hitting in-flight node limit queued nodes count = "
+                  << QueuedNodesCountLocked()
                   << " unfinished_nodes_.size() = " << unfinished_nodes_.size()
                   << ".";
           nodes_done_.wait(l);
@@ -205,9 +241,11 @@ tensorflow::Status EagerExecutor::WaitForAllPendingNodesLocked(
   tensorflow::condition_variable cond;
   // Don't wait if an error is already set.
   if (!status_.ok()) return status_;
-  if (node_queue_.empty() && unfinished_nodes_.empty()) return OkStatus();
-  // node_queue_ must be empty in sync mode.
-  DCHECK(Async() || node_queue_.empty());
+  if (QueuedNodesCountLocked() == 0 && unfinished_nodes_.empty()) {
+    return OkStatus();
+  }
+  // The node queues must be empty in sync mode.
+  DCHECK(Async() || QueuedNodesCountLocked() == 0);
   auto last_id = next_node_id_ - 1;
   DVLOG(3) << "Wait for Node: [id " << last_id << "] ";
   node_done_notifications_.insert(std::make_pair(last_id, &cond));
@@ -222,10 +260,10 @@ void EagerExecutor::ClearError() {
   if (ok()) return;
 
   tensorflow::mutex_lock l(node_queue_mutex_);
-  // If an error was set, node_done_notifications_ and node_queue_ should have
-  // been cleared, and no new entries should have been added since.
+  // If an error was set, node_done_notifications_ and the node queues should
+  // have been cleared, and no new entries should have been added since.
   DCHECK(node_done_notifications_.empty());
-  DCHECK(node_queue_.empty());
+  DCHECK_EQ(QueuedNodesCountLocked(), 0);
   status_ = OkStatus();
   ok_ = true;
   last_eager_client_ = nullptr;
@@ -254,9 +292,11 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
 
     bool need_notification = from_queue;
     if (from_queue) {
-      // Since this was from the async queue, pop it from the front of the queue
-      DCHECK(!node_queue_.empty() && item.get() == node_queue_.front().get());
-      node_queue_.pop();
+      // Since this was from an async queue, pop it from the front of the queue
+      // it was routed to.
+      auto& queue = node_queues_[item->queue_index];
+      DCHECK(!queue.empty() && item.get() == queue.front().get());
+      queue.pop_front();
     } else if (async) {
       // If it is an Async node then we will find the node in the unfinished
       // nodes list. However we only notify if we are at the front of the list
@@ -288,9 +328,11 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
                                 "EagerExecutor. This error cancels all future "
                                 "operations and poisons their output tensors.");
       }
-      while (!node_queue_.empty()) {
-        items_to_destroy.push_front(std::move(node_queue_.front()));
-        node_queue_.pop();
+      for (auto& queue : node_queues_) {
+        while (!queue.empty()) {
+          items_to_destroy.push_front(std::move(queue.front()));
+          queue.pop_front();
+        }
       }
       for (auto& it : unfinished_nodes_) {
         items_to_destroy.push_front(std::move(it.second));
@@ -315,14 +357,17 @@ void EagerExecutor::NodeDone(const core::RefCountPtr<NodeItem>& item,
 
 void EagerExecutor::NotifyWaiters(uint64 id) {
   if (!node_done_notifications_.empty()) {
-    uint64 upperbound_id = 0;
+    // All nodes with an id smaller than the minimum pending id are done.
+    uint64 min_pending_id = next_node_id_;
     if (!unfinished_nodes_.empty()) {
-      upperbound_id = unfinished_nodes_.begin()->first - 1;
-    } else if (!node_queue_.empty()) {
-      upperbound_id = node_queue_.front()->id - 1;
-    } else {
-      upperbound_id = next_node_id_ - 1;
+      min_pending_id = unfinished_nodes_.begin()->first;
+    }
+    for (const auto& queue : node_queues_) {
+      if (!queue.empty()) {
+        min_pending_id = std::min(min_pending_id, queue.front()->id);
+      }
     }
+    uint64 upperbound_id = min_pending_id - 1;
     if (upperbound_id < id) {
       return;
     }
@@ -344,30 +389,51 @@ void EagerExecutor::NotifyWaiters(uint64 id) {
   }
 }
 
-void EagerExecutor::Run() {
-  auto thread_exited_notifier =
-      gtl::MakeCleanup([this] { thread_exited_notification_.Notify(); });
+void EagerExecutor::Run(int queue_index) {
+  auto thread_exited_notifier = gtl::MakeCleanup([this] {
+    if (num_active_threads_.fetch_sub(1) == 1) {
+      thread_exited_notification_.Notify();
+    }
+  });
+  std::vector<core::RefCountPtr<NodeItem>> dispatch_window;
   while (true) {
-    core::RefCountPtr<NodeItem> curr_item;
+    dispatch_window.clear();
     {
       tensorflow::mutex_lock l(node_queue_mutex_);
-      while (node_queue_.empty() || !status_.ok()) {
+      auto& queue = node_queues_[queue_index];
+      while (queue.empty() || !status_.ok()) {
         if (state_ == ExecutorState::kShutDown) return;
         nodes_pending_.wait(l);
       }
-      // Obtain raw pointer since we don't want to remove from the queue until
-      // the node has been run. Otherwise, WaitForAllPendingNodes can return
+      // Obtain raw pointers since we don't want to remove from the queue until
+      // the nodes have been run. Otherwise, WaitForAllPendingNodes can return
       // too early.
-      // Note, we don't std::move from the here because the front of the queue
+      // Note, we don't std::move from here because the front of the queue
       // will then contain a nullptr. This can be a problem in
       // WaitForAllPendingNodes where we get the top EagerNode pointer
       // and register a notification for its completion.
-      curr_item.reset(node_queue_.front().get());
-      curr_item->Ref();
+      // Take a small lookahead window of adjacent nodes in one critical
+      // section so that runs of cheap nodes don't pay for a queue lock and a
+      // wakeup each.
+      auto it = queue.begin();
+      for (int i = 0; i < kDispatchLookaheadWindow && it != queue.end();
+           ++i, ++it) {
+        core::RefCountPtr<NodeItem> item;
+        item.reset(it->get());
+        item->Ref();
+        dispatch_window.push_back(std::move(item));
+      }
     }
-    Status status = RunItem(std::move(curr_item), /*from_queue=*/true);
-    if (!status.ok()) {
-      VLOG(1) << "Failed to run item: " << status;
+    for (auto& curr_item : dispatch_window) {
+      if (!ok()) {
+        // An error occurred; any remaining queued nodes have been drained and
+        // aborted by NodeDone.
+        break;
+      }
+      Status status = RunItem(std::move(curr_item), /*from_queue=*/true);
+      if (!status.ok()) {
+        VLOG(1) << "Failed to run item: " << status;
+      }
     }
   }
 }
@@ -433,17 +499,49 @@ Status EagerExecutor::MoveToUnfinished(core::RefCountPtr<NodeItem> item,
   }
 
   if (from_queue) {
-    DCHECK(!node_queue_.empty() && item.get() == node_queue_.front().get());
-    node_queue_.pop();
+    auto& queue = node_queues_[item->queue_index];
+    DCHECK(!queue.empty() && item.get() == queue.front().get());
+    queue.pop_front();
   }
 
   DVLOG(3) << "Add Node: [id " << item->id << "] to unfinished map.";
-  unfinished_nodes_.emplace_hint(unfinished_nodes_.end(), item->id,
-                                 std::move(item));
+  unfinished_nodes_.emplace(item->id, std::move(item));
 
   return OkStatus();
 }
 
+int EagerExecutor::QueueIndexForNodeLocked(EagerNode* node) {
+  if (num_queues_ == 1) {
+    return 0;
+  }
+  // Remote nodes must stay on queue 0: RunItem tracks last_eager_client_
+  // across remote nodes and is only safe when a single thread runs them.
+  if (node->AsAsyncRemoteExecuteNode() != nullptr) {
+    return 0;
+  }
+  const string device = node->DeviceName();
+  if (device.empty()) {
+    return 0;
+  }
+  auto it = device_queue_assignments_.find(device);
+  if (it != device_queue_assignments_.end()) {
+    return it->second;
+  }
+  // Spread devices over queues 1..num_queues_-1. Queue 0 stays the serial
+  // queue for nodes that do not report a device.
+  int index = 1 + device_queue_assignments_.size() % (num_queues_ - 1);
+  device_queue_assignments_.emplace(device, index);
+  return index;
+}
+
+int64_t EagerExecutor::QueuedNodesCountLocked() const {
+  int64_t count = 0;
+  for (const auto& queue : node_queues_) {
+    count += queue.size();
+  }
+  return count;
+}
+
 void EagerExecutor::AddCleanup(intptr_t key, std::function<void()> callback) {
   cleanups_[key].push_back(callback);
 }
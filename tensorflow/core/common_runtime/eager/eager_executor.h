@@ -18,10 +18,10 @@ limitations under the License.
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
-#include <queue>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -79,6 +79,13 @@ class EagerNode {
 
   // Indicates whether a node failure should make the executor unusable.
   virtual bool Fatal() const { return true; }
+
+  // Returns the name of the device this node is known to execute on, or an
+  // empty string if no single device can be named. When multi-queue async
+  // execution is enabled, the executor routes nodes to per-device queues
+  // based on this name; nodes that do not report a device are serialized on
+  // the default queue.
+  virtual string DeviceName() const { return ""; }
 };
 
 class AsyncEagerNode : public EagerNode {
@@ -107,11 +114,19 @@ class AsyncRemoteExecuteNode : public AsyncEagerNode {
 
 // A class for handling async execution (see TFE_ContextSetAsync).
 // Note that this class is thread-safe.
+//
+// By default all nodes are consumed from a single queue by one background
+// thread. If TF_EAGER_EXECUTOR_DEVICE_QUEUES is set to N > 1, an async
+// executor instead dispatches nodes from N queues, each drained by its own
+// thread. Nodes are routed by EagerNode::DeviceName(): nodes that share a
+// device (and therefore any resources placed on that device) stay in FIFO
+// order relative to each other, while nodes on different devices may run
+// concurrently. Cross-device data dependencies are still enforced by tensor
+// handle readiness. Nodes that do not report a device, as well as remote
+// nodes, are serialized on queue 0.
 // TODO(agarwal): TFE_OpAddInput may currently block if it tries to access the
 // device of the input handle. Fix that.
 // TODO(agarwal): Implement support for control dependencies.
-// TODO(agarwal): Support out-of-order execution and dispatching multiple
-// EagerNode in parallel.
 // TODO(agarwal): Implement optimizations over EagerNode traces.
 class EagerExecutor {
  public:
@@ -195,6 +210,8 @@ class EagerExecutor {
     uint64 id;
     std::unique_ptr<EagerNode> node;
     NodeState state;
+    // Index of the queue in node_queues_ this item was routed to.
+    int queue_index = 0;
   };
 
   const char* StateStringLocked()
@@ -204,15 +221,26 @@ class EagerExecutor {
                 bool from_queue);
   void NotifyWaiters(uint64 id) TF_EXCLUSIVE_LOCKS_REQUIRED(node_queue_mutex_);
 
-  // Starts execution of pending EagerNodes. This function loops till executor
-  // state_ is set to kShutDown. If any errors are encountered, these are set
-  // inside `status_`. The loop blocks anytime there are no pending nodes, or if
-  // `status_` is not ok.
-  void Run();
+  // Starts execution of EagerNodes pending in node_queues_[queue_index]. This
+  // function loops till executor state_ is set to kShutDown. If any errors are
+  // encountered, these are set inside `status_`. The loop blocks anytime there
+  // are no pending nodes in the queue, or if `status_` is not ok. Each call
+  // runs on its own thread; nodes within a queue execute in FIFO order.
+  void Run(int queue_index);
 
   Status RunItem(core::RefCountPtr<NodeItem> item, bool from_queue);
   Status MoveToUnfinished(core::RefCountPtr<NodeItem> item, bool from_queue);
 
+  // Returns the index of the queue `node` should be routed to. Nodes that
+  // share a device share a queue; nodes without a device name and remote
+  // nodes go to queue 0.
+  int QueueIndexForNodeLocked(EagerNode* node)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(node_queue_mutex_);
+
+  // Total number of nodes currently pending in node_queues_.
+  int64_t QueuedNodesCountLocked() const
+      TF_EXCLUSIVE_LOCKS_REQUIRED(node_queue_mutex_);
+
   // The impl of WaitForAllPendingNodes
   // `lock` is the lock that holds node_queue_mutex_.
   Status WaitForAllPendingNodesLocked(mutex_lock* lock)
@@ -229,8 +257,18 @@ class EagerExecutor {
   // Used to signal that some EagerNodes are done.
   condition_variable nodes_done_ TF_GUARDED_BY(node_queue_mutex_);
 
-  // Queue of pending NodeItems. Ordered by NodeItem::id.
-  std::queue<core::RefCountPtr<NodeItem>> node_queue_
+  // Number of queues in node_queues_. 1 unless multi-queue async execution is
+  // enabled through TF_EAGER_EXECUTOR_DEVICE_QUEUES.
+  const int num_queues_;
+
+  // Queues of pending NodeItems. Each queue is ordered by NodeItem::id and
+  // drained by its own thread.
+  std::vector<std::deque<core::RefCountPtr<NodeItem>>> node_queues_
+      TF_GUARDED_BY(node_queue_mutex_);
+
+  // Maps a device name reported by EagerNode::DeviceName() to the index of
+  // the queue its nodes are routed to.
+  absl::flat_hash_map<string, int> device_queue_assignments_
       TF_GUARDED_BY(node_queue_mutex_);
 
   // Ordered by NodeItem::id.
@@ -249,19 +287,28 @@ class EagerExecutor {
   std::multimap<uint64, condition_variable*, std::less<uint64>>
       node_done_notifications_ TF_GUARDED_BY(node_queue_mutex_);
 
-  // thread_exited_notification_ is notified by the `thread_` right before it
-  // exits.
+  // thread_exited_notification_ is notified by the last executor thread right
+  // before it exits.
   Notification thread_exited_notification_;
 
-  // When state_ is set to kShutDown, it indicates that `thread_` should stop as
-  // soon as it is done executing the current EagerNode.
+  // Number of executor threads that have not yet exited. The thread that
+  // decrements this to zero notifies thread_exited_notification_.
+  std::atomic<int> num_active_threads_;
+
+  // When state_ is set to kShutDown, it indicates that the executor threads
+  // should stop as soon as they are done executing the current EagerNode.
   ExecutorState state_ TF_GUARDED_BY(node_queue_mutex_) =
       ExecutorState::kActive;
 
-  // Thread object that calls the `Run` method in async mode.This thread runs
-  // until state_ is set to kShuttingDown. It is `nullptr` in sync mode.
+  // Thread object that calls the `Run` method for queue 0 in async mode. This
+  // thread runs until state_ is set to kShuttingDown. It is `nullptr` in sync
+  // mode.
   const std::unique_ptr<Thread> thread_;
 
+  // Threads draining queues 1..num_queues_-1 when multi-queue async execution
+  // is enabled. Empty otherwise.
+  std::vector<std::unique_ptr<Thread>> device_queue_threads_;
+
   // Last device where remote function with remote inputs was executed.
   const eager::EagerClient* last_eager_client_;
 
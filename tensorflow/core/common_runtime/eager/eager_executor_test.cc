@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/status_matchers.h"
@@ -45,10 +46,12 @@ class TestEagerNode : public EagerNode {
  public:
   explicit TestEagerNode(TestState* state,
                          Status prepare_return_status = OkStatus(),
-                         Status run_return_status = OkStatus())
+                         Status run_return_status = OkStatus(),
+                         string device_name = "")
       : state_(state),
         prepare_return_status_(prepare_return_status),
-        run_return_status_(run_return_status) {}
+        run_return_status_(run_return_status),
+        device_name_(std::move(device_name)) {}
   TestEagerNode(const TestEagerNode&) = delete;
   TestEagerNode& operator=(const TestEagerNode&) = delete;
   Status Prepare() override { return prepare_return_status_; }
@@ -64,11 +67,13 @@ class TestEagerNode : public EagerNode {
 
   void Abort(Status status) override {}
   string DebugString() const override { return "testEagerNode"; }
+  string DeviceName() const override { return device_name_; }
 
  private:
   TestState* state_;
   Status prepare_return_status_;
   Status run_return_status_;
+  string device_name_;
 };
 
 class TestAsyncEagerNode : public AsyncEagerNode {
@@ -269,6 +274,50 @@ TEST(EagerExecutorTest, TestAsyncExecutorFailRunWithAsyncNode) {
   ASSERT_EQ(state->read_state(), TestState::State::kFailure);
 }
 
+TEST(EagerExecutorTest, TestAsyncExecutorWithDeviceQueues) {
+  setenv("TF_EAGER_EXECUTOR_DEVICE_QUEUES", "3", 1);
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+
+  std::vector<std::unique_ptr<TestState>> states;
+  for (int i = 0; i < 4; ++i) {
+    states.push_back(std::make_unique<TestState>());
+  }
+  // Nodes on different devices may run concurrently; nodes without a device
+  // name share the default queue.
+  TF_ASSERT_OK(async_executor->AddOrExecute(std::make_unique<TestEagerNode>(
+      states[0].get(), OkStatus(), OkStatus(), "CPU:0")));
+  TF_ASSERT_OK(async_executor->AddOrExecute(std::make_unique<TestEagerNode>(
+      states[1].get(), OkStatus(), OkStatus(), "CPU:1")));
+  TF_ASSERT_OK(async_executor->AddOrExecute(std::make_unique<TestEagerNode>(
+      states[2].get(), OkStatus(), OkStatus(), "CPU:0")));
+  TF_ASSERT_OK(async_executor->AddOrExecute(
+      std::make_unique<TestEagerNode>(states[3].get())));
+
+  TF_ASSERT_OK(async_executor->WaitForAllPendingNodes());
+  for (const auto& state : states) {
+    ASSERT_EQ(state->read_state(), TestState::State::kSuccess);
+  }
+  unsetenv("TF_EAGER_EXECUTOR_DEVICE_QUEUES");
+}
+
+TEST(EagerExecutorTest, TestAsyncExecutorDeviceQueuesFailRun) {
+  setenv("TF_EAGER_EXECUTOR_DEVICE_QUEUES", "2", 1);
+  auto async_executor = std::make_unique<EagerExecutor>(
+      /*async=*/true, /*enable_streaming_enqueue=*/true);
+
+  auto state = std::make_unique<TestState>();
+  auto node = std::make_unique<TestEagerNode>(
+      state.get(), OkStatus(), errors::Internal("test"), "CPU:0");
+
+  // A failure on any device queue poisons the executor as a whole.
+  TF_ASSERT_OK(async_executor->AddOrExecute(std::move(node)));
+  auto status = async_executor->WaitForAllPendingNodes();
+  ASSERT_EQ(status.code(), tensorflow::error::INTERNAL);
+  ASSERT_EQ(state->read_state(), TestState::State::kFailure);
+  unsetenv("TF_EAGER_EXECUTOR_DEVICE_QUEUES");
+}
+
 TEST(EagerExecutorTest, TestAsyncExecutorAddNodesAfterShutdown) {
   auto async_executor = std::make_unique<EagerExecutor>(
       /*async=*/true, /*enable_streaming_enqueue=*/true);
@@ -246,6 +246,36 @@ class EagerOperation : public ImmediateExecutionOperation {
   // Op name recorded for memory debugging purpose.
   const char* op_name() const { return op_name_; }
 
+  // Call-site kernel cache.
+  //
+  // An operation instance that is reused across calls (e.g. through
+  // TFE_OpReset) pins the kernel resolved for its last call signature, so
+  // that repeated identical calls skip device resolution and the
+  // context-wide kernel cache. The signature must cover everything kernel
+  // resolution depends on (op name, attributes, requested device and
+  // placement policy); `cache_generation` invalidates pinned kernels once
+  // the context kernel cache is cleared. The pinned kernel deliberately
+  // survives Reset().
+  core::RefCountPtr<KernelAndDevice> GetCachedKernel(
+      Fprint128 signature, uint64 cache_generation) const {
+    if (cached_kernel_ == nullptr ||
+        !(cached_kernel_signature_ == signature) ||
+        cached_kernel_cache_generation_ != cache_generation) {
+      return nullptr;
+    }
+    core::RefCountPtr<KernelAndDevice> kernel(cached_kernel_.get());
+    kernel->Ref();
+    return kernel;
+  }
+
+  void SetCachedKernel(KernelAndDevice* kernel, Fprint128 signature,
+                       uint64 cache_generation) {
+    kernel->Ref();
+    cached_kernel_.reset(kernel);
+    cached_kernel_signature_ = signature;
+    cached_kernel_cache_generation_ = cache_generation;
+  }
+
   // For LLVM style RTTI.
   static bool classof(const AbstractOperation* ptr) {
     return ptr->getKind() == kEager;
@@ -314,6 +344,12 @@ class EagerOperation : public ImmediateExecutionOperation {
   int inference_arg_idx_;  // arg definition index for the next input to be
                            // added
   gtl::FlatSet<std::string> inference_attrs_;  // attributes inferred so far
+
+  // Call-site kernel cache; see GetCachedKernel(). Kept across Reset() so
+  // that reused op instances can skip kernel resolution.
+  core::RefCountPtr<KernelAndDevice> cached_kernel_;
+  Fprint128 cached_kernel_signature_{0, 0};
+  uint64 cached_kernel_cache_generation_ = 0;
 };
 
 inline void EagerOperation::UpdateInput(int i, TensorHandle* h) {
@@ -1345,6 +1345,35 @@ Status GetOrCreateKernelAndDevice(
     op->UpdateName(summary_optimizer::StrippedFunctionName(op->Name()));
   }
 
+  // Fast path for call sites that reuse their op instance (e.g. through
+  // TFE_OpReset): if this op resolved a kernel before and the call signature
+  // (op name, attributes, requested device and placement policy) is
+  // unchanged, reuse the pinned kernel without consulting the context-wide
+  // device and kernel caches. Restricted to primitive ops not run as
+  // functions, whose kernel cache key does not depend on the inputs.
+  const bool use_call_site_kernel_cache =
+      !op->is_function() && !ctx.RunEagerOpAsFunction();
+  Fprint128 call_signature{0, 0};
+  if (use_call_site_kernel_cache) {
+    call_signature = GetDeviceCacheKey(op, ctx);
+    core::RefCountPtr<KernelAndDevice> pinned_kernel =
+        op->GetCachedKernel(call_signature, ctx.kernel_cache_generation());
+    if (pinned_kernel != nullptr) {
+      if (device == nullptr) {
+        op->SetDevice(pinned_kernel->device());
+      }
+      int num_outputs = pinned_kernel->num_outputs();
+      if (num_outputs > *num_retvals) {
+        return errors::InvalidArgument("Expecting ", num_outputs,
+                                       " outputs, but *num_retvals is ",
+                                       *num_retvals);
+      }
+      *num_retvals = num_outputs;
+      *out_kernel = std::move(pinned_kernel);
+      return OkStatus();
+    }
+  }
+
   // Set the EagerOperation's device prior to extracting the input_device_ptrs
   // to avoid any redundant H2D/D2H copies.
   if (device == nullptr && !op->is_function()) {
@@ -1368,7 +1397,10 @@ Status GetOrCreateKernelAndDevice(
   std::unordered_map<int, DtypeAndPartialTensorShape>
       input_resource_variable_dtypes_and_shapes;
   const KernelDef* kernel_def = nullptr;
-  if (!op->is_function()) {
+  if (!op->is_function() && ctx.RunEagerOpAsFunction()) {
+    // The kernel def is only consulted when wrapping primitive ops in call
+    // ops (host-memory args and int-on-device handling); skipping the
+    // registry lookup otherwise keeps the cached-kernel path cheap.
     const NodeDef* node_def = &op->MutableAttrs()->BuildNodeDef();
     kernel_def = GetKernelDef(*op, node_def, device);
   }
@@ -1385,6 +1417,10 @@ Status GetOrCreateKernelAndDevice(
                         input_resource_variable_dtypes_and_shapes,
                         reuse_rendezvous_for_functions));
   core::RefCountPtr<KernelAndDevice> kernel = ctx.GetCachedKernel(cache_key);
+  // Only kernels that live in the context cache may be pinned on the op
+  // instance; this keeps kernels excluded from caching (e.g. tf.data ops)
+  // out of the call-site cache as well.
+  bool pin_kernel_on_op = kernel != nullptr;
   AbstractOperationPtr wrapped_op_releaser;
   // We can eliminate some overhead by running simple functions using regular
   // CallOp kernel. However, it is tricky to figure out which functions should
@@ -1560,9 +1596,15 @@ Status GetOrCreateKernelAndDevice(
       // memory growth (https://github.com/tensorflow/tensorflow/issues/58676)
       VLOG(2) << "Caching op " << op->Name();
       ctx.AddKernelToCache(cache_key, kernel.get());
+      pin_kernel_on_op = true;
     }
   }
 
+  if (use_call_site_kernel_cache && pin_kernel_on_op) {
+    op->SetCachedKernel(kernel.get(), call_signature,
+                        ctx.kernel_cache_generation());
+  }
+
   int num_outputs = kernel->num_outputs();
   if (num_outputs > *num_retvals) {
     return errors::InvalidArgument("Expecting ", num_outputs,
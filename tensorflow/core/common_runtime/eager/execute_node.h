@@ -233,6 +233,10 @@ class AsyncExecuteNode : public EagerNode {
     return out;
   }
 
+  string DeviceName() const override {
+    return kernel_->device() != nullptr ? kernel_->device()->name() : "";
+  }
+
  private:
   EagerContext* ctx_;
   absl::InlinedVector<TensorHandle*, 4> inputs_;
@@ -15,22 +15,82 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/eager/shape_inference.h"
 
+#include <algorithm>
+#include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/common_runtime/eager/tensor_handle.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/public/version.h"
 
 namespace tensorflow {
 namespace eager {
 
+namespace {
+
+// Cache of shape inference results, keyed by a fingerprint of the op name,
+// attrs and input shapes. Eager training loops issue the same ops with the
+// same shapes every step, and for remote execution the shape function runs
+// on the critical path of op dispatch (b/141209983); a hit skips running it.
+//
+// Inference shapes are speculative: the authoritative shapes arrive with the
+// op's response and overwrite them, so a 64-bit fingerprint collision can at
+// worst produce a transiently wrong shape hint, not a wrong result.
+struct ShapeInferenceCache {
+  // Bounds memory; the cache is simply dropped when it fills up.
+  static constexpr int kMaxEntries = 4096;
+
+  mutex mu;
+  absl::flat_hash_map<uint64, gtl::InlinedVector<PartialTensorShape, 2>>
+      entries TF_GUARDED_BY(mu);
+};
+
+ShapeInferenceCache* GetShapeInferenceCache() {
+  static ShapeInferenceCache* cache = new ShapeInferenceCache;
+  return cache;
+}
+
+// Fingerprints the inputs to a shape function whose results we may cache:
+// op name, attrs (order-independent) and input shapes. Input tensor values
+// are irrelevant here because the InferenceContext below is constructed
+// without input tensors.
+uint64 ComputeShapeInferenceKey(const NodeDef& ndef,
+                                shape_inference::InferenceContext* ic) {
+  uint64 key = Hash64(ndef.op());
+  std::vector<std::string> attr_names;
+  attr_names.reserve(ndef.attr().size());
+  for (const auto& attr : ndef.attr()) {
+    attr_names.push_back(attr.first);
+  }
+  std::sort(attr_names.begin(), attr_names.end());
+  for (const std::string& name : attr_names) {
+    key = Hash64Combine(key, Hash64(name));
+    key = Hash64Combine(key, AttrValueHash(ndef.attr().at(name)));
+  }
+  for (int i = 0; i < ic->num_inputs(); ++i) {
+    shape_inference::ShapeHandle shape = ic->input(i);
+    const int rank = ic->Rank(shape);
+    key = Hash64Combine(key, static_cast<uint64>(rank));
+    for (int d = 0; d < rank; ++d) {
+      key = Hash64Combine(key,
+                          static_cast<uint64>(ic->Value(ic->Dim(shape, d))));
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
 Status RunShapeInference(const NodeDef& ndef,
                          const FunctionLibraryDefinition& lib_def,
                          const gtl::InlinedVector<TensorHandle*, 4>& inputs,
                          const gtl::InlinedVector<TensorHandle*, 2>& retvals) {
   const tensorflow::OpRegistrationData* op_reg_data;
-  // TODO(b/141209983): Consider adding a shape inference cache.
   // FunctionLibraryDefinition::LookUp delegates to global OpRegistry
   // if op is not a function.
   TF_RETURN_IF_ERROR(lib_def.LookUp(ndef.op(), &op_reg_data));
@@ -45,11 +105,60 @@ Status RunShapeInference(const NodeDef& ndef,
     ic.SetInput(i, shape);
   }
 
+  // Functions may be redefined under the same name between calls, so only
+  // primitive ops participate in the cache.
+  const bool cacheable = !op_reg_data->is_function_op;
+  uint64 key = 0;
+  if (cacheable) {
+    key = ComputeShapeInferenceKey(ndef, &ic);
+    ShapeInferenceCache* cache = GetShapeInferenceCache();
+    mutex_lock l(cache->mu);
+    auto it = cache->entries.find(key);
+    if (it != cache->entries.end() && it->second.size() == retvals.size()) {
+      for (size_t i = 0; i < retvals.size(); i++) {
+        const PartialTensorShape& shape = it->second[i];
+        shape_inference::ShapeHandle shape_handle;
+        if (shape.unknown_rank()) {
+          shape_handle = ic.UnknownShape();
+        } else {
+          std::vector<shape_inference::DimensionHandle> dims(shape.dims());
+          for (int d = 0; d < shape.dims(); ++d) {
+            dims[d] = shape.dim_size(d) < 0 ? ic.UnknownDim()
+                                            : ic.MakeDim(shape.dim_size(d));
+          }
+          shape_handle = ic.MakeShape(dims);
+        }
+        retvals[i]->SetInferenceShape(&ic, shape_handle);
+      }
+      return OkStatus();
+    }
+  }
+
   TF_RETURN_IF_ERROR(ic.Run(op_reg_data->shape_inference_fn));
   CHECK_EQ(ic.num_outputs(), retvals.size());
+  gtl::InlinedVector<PartialTensorShape, 2> output_shapes(retvals.size());
   for (int i = 0; i < ic.num_outputs(); i++) {
     shape_inference::ShapeHandle shape_handle = ic.output(i);
     retvals[i]->SetInferenceShape(&ic, shape_handle);
+    if (cacheable) {
+      const int rank = ic.Rank(shape_handle);
+      if (rank != shape_inference::InferenceContext::kUnknownRank) {
+        std::vector<int64_t> dims(rank);
+        for (int d = 0; d < rank; ++d) {
+          dims[d] = ic.Value(ic.Dim(shape_handle, d));
+        }
+        TF_RETURN_IF_ERROR(PartialTensorShape::MakePartialShape(
+            dims.data(), rank, &output_shapes[i]));
+      }
+    }
+  }
+  if (cacheable) {
+    ShapeInferenceCache* cache = GetShapeInferenceCache();
+    mutex_lock l(cache->mu);
+    if (cache->entries.size() >= ShapeInferenceCache::kMaxEntries) {
+      cache->entries.clear();
+    }
+    cache->entries[key] = std::move(output_shapes);
   }
   // TODO(slebedev): populate TensorHandle::handle_dtypes_and_shapes.
   return OkStatus();
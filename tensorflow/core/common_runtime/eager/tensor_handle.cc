@@ -418,7 +418,15 @@ TensorHandle::TensorHandle(int64_t op_id, int32_t output_num,
 }
 #endif
 
-TensorHandle::~TensorHandle() { DVLOG(3) << "Deleting tensor handle " << this; }
+TensorHandle::~TensorHandle() {
+  DVLOG(3) << "Deleting tensor handle " << this;
+  // Recycle the buffer of a dying host handle so a later allocation of the
+  // same (dtype, shape) can reuse it instead of hitting the allocator.
+  if (ctx_ != nullptr && ctx_->tensor_pool()->enabled() &&
+      device_ == nullptr && Type() == LOCAL) {
+    std::get<LocalTensorHandleData>(data_).DonateBuffer(ctx_->tensor_pool());
+  }
+}
 
 void TensorHandle::Release() {
   DVLOG(3) << "Releasing tensor handle " << this;
@@ -1017,7 +1025,14 @@ Status TensorHandle::CopyToDevice(const EagerContext& ctx,
     attr.set_on_host(true);
   }
   const auto* dstd_info = dstd->tensorflow_accelerator_device_info();
-  tensorflow::Tensor dst(dstd->GetAllocator(attr), src->dtype(), src->shape());
+  // For host destinations, try to reuse a recycled buffer of the right
+  // (dtype, shape) before going to the allocator.
+  tensorflow::Tensor dst;
+  if (!(dst_cpu &&
+        ctx.tensor_pool()->Acquire(src->dtype(), src->shape(), &dst))) {
+    dst = tensorflow::Tensor(dstd->GetAllocator(attr), src->dtype(),
+                             src->shape());
+  }
   if (src->shape().num_elements() == 0) {
     *output = dst;
     return OkStatus();
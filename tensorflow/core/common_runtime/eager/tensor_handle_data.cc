@@ -83,6 +83,19 @@ Status LocalTensorHandleData::Unprotect() {
   return OkStatus();
 }
 
+bool LocalTensorHandleData::DonateBuffer(EagerTensorPool* pool) {
+  if (!IsReady()) {
+    return false;
+  }
+  // The owning handle is going away, so forwarding protection is moot; drop
+  // the extra reference it holds before checking for unique ownership.
+  forwarding_protection_tensor_ = tensorflow::Tensor();
+  if (!tensor_.RefCountIsOne()) {
+    return false;
+  }
+  return pool->Release(tensor_);
+}
+
 Status LocalTensorHandleData::SetTensor(tensorflow::Tensor&& t) {
   DCHECK(!IsReady()) << "SetTensor is only called on non-ready handles.";
 
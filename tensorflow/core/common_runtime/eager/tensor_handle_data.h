@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "absl/types/variant.h"
 #include "tensorflow/core/common_runtime/eager/context.h"
+#include "tensorflow/core/common_runtime/eager/tensor_pool.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
 
@@ -43,6 +44,12 @@ class LocalTensorHandleData {
   Status NumElements(int64_t* num_elements) const;
   Status Unprotect();
 
+  // Donates the underlying buffer to `pool` if this data holds the only
+  // references to it. Drops forwarding protection, so it must only be
+  // called while the owning handle is being destroyed. Returns true if the
+  // buffer was accepted by the pool.
+  bool DonateBuffer(EagerTensorPool* pool);
+
   bool IsReady() const {
     return std::visit([](auto& data) { return data.IsReady(); }, ctrl_);
   }
@@ -0,0 +1,84 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/eager/tensor_pool.h"
+
+#include <utility>
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+/* static */ int64_t EagerTensorPool::MaxBytesFromEnv() {
+  int64_t max_bytes = 0;
+  Status status = ReadInt64FromEnvVar("TF_EAGER_TENSOR_POOL_MAX_BYTES",
+                                      /*default_val=*/0, &max_bytes);
+  if (!status.ok()) {
+    LOG(WARNING) << "Invalid TF_EAGER_TENSOR_POOL_MAX_BYTES; disabling the "
+                    "eager tensor pool: "
+                 << status.message();
+    return 0;
+  }
+  return max_bytes;
+}
+
+bool EagerTensorPool::Acquire(DataType dtype, const TensorShape& shape,
+                              Tensor* out) {
+  if (!enabled()) return false;
+
+  mutex_lock l(mu_);
+  auto it = buckets_.find(BucketKey{dtype, shape});
+  if (it == buckets_.end() || it->second.empty()) {
+    return false;
+  }
+  *out = std::move(it->second.back());
+  it->second.pop_back();
+  total_bytes_ -= out->AllocatedBytes();
+  DVLOG(3) << "EagerTensorPool hit for " << DataTypeString(dtype) << " "
+           << shape.DebugString() << "; " << total_bytes_ << " bytes pooled";
+  return true;
+}
+
+bool EagerTensorPool::Release(const Tensor& t) {
+  if (!enabled()) return false;
+  if (!DataTypeCanUseMemcpy(t.dtype()) || t.NumElements() == 0) {
+    return false;
+  }
+  const int64_t bytes = t.AllocatedBytes();
+
+  mutex_lock l(mu_);
+  if (total_bytes_ + bytes > max_bytes_) {
+    return false;
+  }
+  std::vector<Tensor>& bucket = buckets_[BucketKey{t.dtype(), t.shape()}];
+  if (bucket.size() >= kMaxTensorsPerBucket) {
+    return false;
+  }
+  bucket.push_back(t);
+  total_bytes_ += bytes;
+  DVLOG(3) << "EagerTensorPool retained " << DataTypeString(t.dtype()) << " "
+           << t.shape().DebugString() << "; " << total_bytes_
+           << " bytes pooled";
+  return true;
+}
+
+void EagerTensorPool::Clear() {
+  mutex_lock l(mu_);
+  buckets_.clear();
+  total_bytes_ = 0;
+}
+
+}  // namespace tensorflow
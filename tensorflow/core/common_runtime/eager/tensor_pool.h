@@ -0,0 +1,112 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_TENSOR_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_TENSOR_POOL_H_
+
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// A bounded pool of host tensor buffers bucketed by (dtype, shape).
+//
+// Tight eager loops produce and drop many small transient tensors of
+// identical dtype and shape; each one round-trips the device allocator.
+// This pool lets TensorHandle recycle such buffers: when a local host
+// handle is destroyed and its buffer is uniquely owned, the buffer is
+// donated to the pool, and allocation sites that need a host tensor of a
+// matching (dtype, shape) take it back instead of allocating.
+//
+// The pool is disabled unless TF_EAGER_TENSOR_POOL_MAX_BYTES is set to a
+// positive byte budget. Only tensors whose dtype satisfies
+// DataTypeCanUseMemcpy are pooled (no strings, resources or variants), so
+// recycled buffers never need element destruction and may simply be
+// overwritten. Deallocation of pooled buffers always goes through the
+// allocator that produced them, so mixing allocators is safe.
+//
+// All methods are thread-safe.
+class EagerTensorPool {
+ public:
+  // `max_bytes` bounds the total footprint of pooled buffers; a
+  // non-positive value disables the pool entirely.
+  explicit EagerTensorPool(int64_t max_bytes) : max_bytes_(max_bytes) {}
+
+  // Reads the byte budget from TF_EAGER_TENSOR_POOL_MAX_BYTES (default 0,
+  // i.e. disabled).
+  static int64_t MaxBytesFromEnv();
+
+  bool enabled() const { return max_bytes_ > 0; }
+
+  // If the pool holds a buffer of exactly (dtype, shape), moves it into
+  // `*out` and returns true. The buffer contents are stale and must be
+  // fully overwritten by the caller.
+  bool Acquire(DataType dtype, const TensorShape& shape, Tensor* out);
+
+  // Donates `t`'s buffer to the pool. Returns true if the buffer was
+  // accepted. The caller must guarantee that it holds the only reference
+  // to the buffer apart from `t` itself (i.e. t.RefCountIsOne() from the
+  // caller's side); donations are rejected if the dtype is not
+  // memcpy-able, the tensor is empty, or accepting it would exceed the
+  // byte budget or the per-bucket cap.
+  bool Release(const Tensor& t);
+
+  // Drops all pooled buffers.
+  void Clear();
+
+  int64_t CurrentBytes() const {
+    mutex_lock l(mu_);
+    return total_bytes_;
+  }
+
+ private:
+  struct BucketKey {
+    DataType dtype;
+    TensorShape shape;
+
+    bool operator==(const BucketKey& other) const {
+      return dtype == other.dtype && shape == other.shape;
+    }
+
+    template <typename H>
+    friend H AbslHashValue(H h, const BucketKey& key) {
+      h = H::combine(std::move(h), static_cast<int>(key.dtype));
+      for (auto dim : key.shape.dim_sizes()) {
+        h = H::combine(std::move(h), dim);
+      }
+      return h;
+    }
+  };
+
+  // Bounds the number of buffers retained per (dtype, shape) bucket, so a
+  // single hot shape cannot monopolize the pool.
+  static constexpr int kMaxTensorsPerBucket = 16;
+
+  const int64_t max_bytes_;
+
+  mutable mutex mu_;
+  absl::flat_hash_map<BucketKey, std::vector<Tensor>> buckets_
+      TF_GUARDED_BY(mu_);
+  int64_t total_bytes_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_EAGER_TENSOR_POOL_H_
@@ -0,0 +1,98 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/eager/tensor_pool.h"
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(EagerTensorPool, DisabledPoolRejectsEverything) {
+  EagerTensorPool pool(/*max_bytes=*/0);
+  EXPECT_FALSE(pool.enabled());
+
+  Tensor t(DT_FLOAT, TensorShape({4}));
+  EXPECT_FALSE(pool.Release(t));
+  Tensor out;
+  EXPECT_FALSE(pool.Acquire(DT_FLOAT, TensorShape({4}), &out));
+}
+
+TEST(EagerTensorPool, RecyclesMatchingBuffer) {
+  EagerTensorPool pool(/*max_bytes=*/1 << 20);
+  ASSERT_TRUE(pool.enabled());
+
+  Tensor t(DT_FLOAT, TensorShape({4}));
+  const void* data = t.data();
+  EXPECT_TRUE(pool.Release(t));
+  EXPECT_GT(pool.CurrentBytes(), 0);
+
+  Tensor out;
+  ASSERT_TRUE(pool.Acquire(DT_FLOAT, TensorShape({4}), &out));
+  EXPECT_EQ(out.data(), data);
+  EXPECT_EQ(out.dtype(), DT_FLOAT);
+  EXPECT_EQ(out.shape(), TensorShape({4}));
+  EXPECT_EQ(pool.CurrentBytes(), 0);
+
+  // The pool is now empty again.
+  EXPECT_FALSE(pool.Acquire(DT_FLOAT, TensorShape({4}), &out));
+}
+
+TEST(EagerTensorPool, DtypeAndShapeMustMatchExactly) {
+  EagerTensorPool pool(/*max_bytes=*/1 << 20);
+
+  Tensor t(DT_FLOAT, TensorShape({4}));
+  EXPECT_TRUE(pool.Release(t));
+
+  Tensor out;
+  EXPECT_FALSE(pool.Acquire(DT_FLOAT, TensorShape({2, 2}), &out));
+  EXPECT_FALSE(pool.Acquire(DT_INT32, TensorShape({4}), &out));
+  EXPECT_TRUE(pool.Acquire(DT_FLOAT, TensorShape({4}), &out));
+}
+
+TEST(EagerTensorPool, RespectsByteBudget) {
+  EagerTensorPool pool(/*max_bytes=*/1);
+
+  Tensor t(DT_FLOAT, TensorShape({4}));
+  EXPECT_FALSE(pool.Release(t));
+  EXPECT_EQ(pool.CurrentBytes(), 0);
+}
+
+TEST(EagerTensorPool, RejectsNonMemcpyDtypesAndEmptyTensors) {
+  EagerTensorPool pool(/*max_bytes=*/1 << 20);
+
+  Tensor strings(DT_STRING, TensorShape({2}));
+  EXPECT_FALSE(pool.Release(strings));
+
+  Tensor empty(DT_FLOAT, TensorShape({0}));
+  EXPECT_FALSE(pool.Release(empty));
+}
+
+TEST(EagerTensorPool, ClearDropsPooledBuffers) {
+  EagerTensorPool pool(/*max_bytes=*/1 << 20);
+
+  Tensor t(DT_FLOAT, TensorShape({4}));
+  EXPECT_TRUE(pool.Release(t));
+  pool.Clear();
+  EXPECT_EQ(pool.CurrentBytes(), 0);
+
+  Tensor out;
+  EXPECT_FALSE(pool.Acquire(DT_FLOAT, TensorShape({4}), &out));
+}
+
+}  // namespace
+}  // namespace tensorflow
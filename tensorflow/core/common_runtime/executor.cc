@@ -17,12 +17,16 @@ limitations under the License.
 
 #include <algorithm>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "tensorflow/core/activity_watcher/activity.h"
@@ -31,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/executor_factory.h"
 #include "tensorflow/core/common_runtime/graph_view.h"
 #include "tensorflow/core/common_runtime/immutable_executor_state.h"
+#include "tensorflow/core/common_runtime/op_cost_recorder.h"
 #include "tensorflow/core/common_runtime/pending_counts.h"
 #include "tensorflow/core/common_runtime/propagator_state.h"
 #include "tensorflow/core/common_runtime/renamed_device.h"
@@ -53,6 +58,7 @@ limitations under the License.
 #include "tensorflow/core/graph/edgeset.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
+#include "tensorflow/core/lib/core/arena.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -61,13 +67,16 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/platform/context.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/profile_utils/cpu_utils.h"
+#include "tensorflow/core/platform/random.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/thread_annotations.h"
 #include "tensorflow/core/platform/tracing.h"
@@ -80,6 +89,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/core/util/determinism.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/managed_stack_trace.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
 
@@ -90,6 +100,23 @@ namespace {
 // 1-D, 0 element tensor.
 static const Tensor* const kEmptyTensor = new Tensor;
 
+// If TF_EXECUTOR_ENFORCE_DEADLINE=true, a step whose deadline (from
+// RunOptions.timeout_in_ms) has passed stops launching kernels and fails with
+// DEADLINE_EXCEEDED, cancelling the rest of the step, instead of running to
+// completion after the client has already given up on it.
+bool EnforceDeadline() {
+  static const bool enforce = []() {
+    bool value = false;
+    Status s =
+        ReadBoolFromEnvVar("TF_EXECUTOR_ENFORCE_DEADLINE", false, &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_EXECUTOR_ENFORCE_DEADLINE: " << s;
+    }
+    return value;
+  }();
+  return enforce;
+}
+
 // Helper routines for collecting step stats.
 namespace nodestats {
 inline int64_t NowInNsec() { return EnvTime::NowNanos(); }
@@ -147,14 +174,30 @@ typedef gtl::InlinedVector<AllocatorAttributes, 4> AllocatorAttributeVec;
 
 class ExecutorImpl : public Executor {
  public:
-  explicit ExecutorImpl(const LocalExecutorParams& p) : immutable_state_(p) {}
+  // If `require_flat` is true, Initialize() fails unless the graph is free of
+  // control flow, and RunAsyncInternal() dispatches straight to the
+  // frame/iteration-free fast path without inspecting the graph per step.
+  explicit ExecutorImpl(const LocalExecutorParams& p, bool require_flat = false)
+      : immutable_state_(p), require_flat_(require_flat) {}
 
   Status Initialize(const Graph& graph) {
     TF_RETURN_IF_ERROR(immutable_state_.Initialize(graph));
+    if (require_flat_ && immutable_state_.requires_control_flow_support()) {
+      return errors::InvalidArgument(
+          "The FLAT executor requires a graph without control flow, but the "
+          "given graph contains control-flow ops.");
+    }
     kernel_stats_.Initialize(immutable_state_.graph_view());
+    activation_stats_.Initialize(immutable_state_.graph_view());
     return OkStatus();
   }
 
+  ~ExecutorImpl() override {
+    if (activation_stats_.enabled()) {
+      activation_stats_.Export(immutable_state_.graph_view());
+    }
+  }
+
  private:
   void RunAsyncInternal(const Args& args, DoneCallback done) override;
 
@@ -223,13 +266,111 @@ class ExecutorImpl : public Executor {
     std::unique_ptr<std::atomic_uint_fast64_t[]> cost_estimates_;
   };
 
+  // Per-node activation counters: invocation count and cumulative compute
+  // cycles in flat arrays indexed by node id, so that the graph regions
+  // dominating per-step cost can be found in production without a full
+  // profiler trace. Collection is opt-in via the
+  // TF_EXECUTOR_ACTIVATION_PROFILE_DIR environment variable; when the
+  // executor is destroyed, the counters are exported in collapsed-stack
+  // format ("scope;subscope;OpType <weight>") for flamegraph tooling.
+  // Only synchronous kernels are timed, matching KernelStats above.
+  class ActivationStats {
+   public:
+    ActivationStats() = default;
+
+    void Initialize(const GraphView& gview) {
+      Status s = ReadStringFromEnvVar("TF_EXECUTOR_ACTIVATION_PROFILE_DIR",
+                                      /*default_val=*/"", &export_dir_);
+      if (!s.ok()) {
+        LOG(ERROR) << s.message();
+      }
+      if (export_dir_.empty()) return;
+      num_nodes_ = gview.num_nodes();
+      counts_ = std::make_unique<std::atomic_uint_fast64_t[]>(num_nodes_);
+      cycles_ = std::make_unique<std::atomic_uint_fast64_t[]>(num_nodes_);
+      for (int32_t i = 0; i < num_nodes_; ++i) {
+        counts_[i] = 0;
+        cycles_[i] = 0;
+      }
+    }
+
+    bool enabled() const { return counts_ != nullptr; }
+
+    // Credits one completed invocation of `node` that took `elapsed_cycles`.
+    // Lock-free: each counter is updated with a relaxed atomic add, and
+    // concurrently executing nodes have distinct ids, so the hot path never
+    // contends on a cache line.
+    void Record(const NodeItem& node, uint64 elapsed_cycles) {
+      counts_[node.node_id].fetch_add(1, std::memory_order_relaxed);
+      cycles_[node.node_id].fetch_add(elapsed_cycles,
+                                      std::memory_order_relaxed);
+    }
+
+    // Writes the accumulated counters under the export directory as
+    // "tf_activation_<id>.cycles.collapsed" (weighted by cumulative cycles)
+    // and "tf_activation_<id>.counts.collapsed" (weighted by invocation
+    // count), one collapsed stack per node-name hierarchy.
+    void Export(const GraphView& gview) const;
+
+   private:
+    string export_dir_;
+    int32_t num_nodes_ = 0;
+    std::unique_ptr<std::atomic_uint_fast64_t[]> counts_;
+    std::unique_ptr<std::atomic_uint_fast64_t[]> cycles_;
+  };
+
   ImmutableExecutorState immutable_state_;
   KernelStats kernel_stats_;
+  ActivationStats activation_stats_;
+  const bool require_flat_;
 
   ExecutorImpl(const ExecutorImpl&) = delete;
   void operator=(const ExecutorImpl&) = delete;
 };
 
+void ExecutorImpl::ActivationStats::Export(const GraphView& gview) const {
+  // Collapse node names into "scope;subscope;...;OpType" stacks. Distinct
+  // nodes that collapse to the same stack are summed, and stacks are emitted
+  // in sorted order so exports of the same graph diff cleanly.
+  std::map<string, std::pair<uint64, uint64>> stacks;
+  for (int32_t i = 0; i < num_nodes_; ++i) {
+    const uint64 count = counts_[i].load(std::memory_order_relaxed);
+    if (count == 0) continue;
+    const NodeItem* item = gview.node(i);
+    if (item == nullptr || item->kernel == nullptr) continue;
+    string stack = absl::StrReplaceAll(item->kernel->name(), {{"/", ";"}});
+    absl::StrAppend(&stack, ";", item->kernel->type_string_view());
+    auto& weights = stacks[stack];
+    weights.first += count;
+    weights.second += cycles_[i].load(std::memory_order_relaxed);
+  }
+  if (stacks.empty()) return;
+
+  const string base = io::JoinPath(
+      export_dir_, absl::StrCat("tf_activation_", random::New64()));
+  const auto write_collapsed = [&stacks](const string& path, bool use_cycles) {
+    std::unique_ptr<WritableFile> file;
+    Status s = Env::Default()->NewWritableFile(path, &file);
+    if (s.ok()) {
+      for (const auto& entry : stacks) {
+        s = file->Append(absl::StrCat(
+            entry.first, " ",
+            use_cycles ? entry.second.second : entry.second.first, "\n"));
+        if (!s.ok()) break;
+      }
+      if (s.ok()) s = file->Close();
+    }
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to export executor activation profile to "
+                   << path << ": " << s.message();
+    }
+  };
+  write_collapsed(absl::StrCat(base, ".cycles.collapsed"),
+                  /*use_cycles=*/true);
+  write_collapsed(absl::StrCat(base, ".counts.collapsed"),
+                  /*use_cycles=*/false);
+}
+
 // The state associated with one invocation of ExecutorImpl::Run.
 //
 // ExecutorState dispatches nodes when they become ready, and delegates to an
@@ -284,7 +425,8 @@ class ExecutorState {
  public:
   ExecutorState(const Executor::Args& args,
                 const ImmutableExecutorState& immutable_state_,
-                ExecutorImpl::KernelStats* kernel_stats_);
+                ExecutorImpl::KernelStats* kernel_stats_,
+                ExecutorImpl::ActivationStats* activation_stats_);
   ~ExecutorState();
 
   void RunAsync(Executor::DoneCallback done);
@@ -340,12 +482,25 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Dispatches a batch of ready nodes to the thread pool. The batch is
+  // published once and worker closures claim nodes with an atomic cursor, so
+  // the handoff takes no lock and early finishers steal the remaining nodes
+  // instead of idling behind a serialized queue.
+  void RunReadyBatch(TaggedNodeSeq ready, int64_t scheduled_nsec);
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
   template <typename Closure>
   void RunTask(Closure&& c, int sample_rate = 0);
 
+  // Allocates/destroys the per-kernel `AsyncState`. When the per-step arena is
+  // enabled, the storage comes from `step_arena_` and is reclaimed in bulk
+  // when this `ExecutorState` is destroyed; otherwise it is heap-allocated.
+  template <typename... ArgTypes>
+  AsyncState* NewAsyncState(ArgTypes&&... args);
+  void DestroyAsyncState(AsyncState* state);
+
   // Clean up when this executor is done.
   void Finish();
   void ScheduleFinish();
@@ -365,6 +520,9 @@ class ExecutorState {
   // The deadline for the session to complete by. Empty if unspecified.
   absl::optional<absl::Time> deadline_;
 
+  // Priority of the enclosing request; see Executor::Args::priority.
+  const int64_t priority_;
+
   // Maximum number of kernels that can be scheduled inline. If lots of kernels
   // are ready at the same time, scheduling them in one thread can be very slow.
   // TODO(fishx): Make it configurable if necessary.
@@ -389,6 +547,12 @@ class ExecutorState {
   CallFrameInterface* call_frame_;
   const ImmutableExecutorState& immutable_state_;
   ExecutorImpl::KernelStats* const kernel_stats_;
+  // Per-node activation counters. Disabled unless opted in via
+  // TF_EXECUTOR_ACTIVATION_PROFILE_DIR; checked cheaply on every node.
+  ExecutorImpl::ActivationStats* const activation_stats_;
+  // Per-op-type cost aggregation. Null unless opted in via
+  // TF_EXECUTOR_OP_COST_RECORDING; checked cheaply on every node.
+  OpCostRecorder* const op_cost_recorder_;
   CancellationManager* cancellation_manager_;
   tsl::CoordinationServiceAgent* coordination_service_agent_;
   absl::optional<ManagedStackTrace> stack_trace_ = absl::nullopt;
@@ -398,6 +562,13 @@ class ExecutorState {
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
 
+  // Bump-pointer arena for transient per-step allocations. Non-null only when
+  // `Args::use_per_step_arena` is set. `core::Arena` is thread-compatible, so
+  // allocations take `step_arena_mu_`; the critical section is a pointer bump,
+  // which is much cheaper than contending on the global heap.
+  mutex step_arena_mu_;
+  const std::unique_ptr<core::Arena> step_arena_;
+
   PropagatorStateType propagator_;
 
   // Invoked when the execution finishes.
@@ -418,13 +589,15 @@ class ExecutorState {
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::ExecutorState(
     const Executor::Args& args, const ImmutableExecutorState& immutable_state,
-    ExecutorImpl::KernelStats* kernel_stats)
+    ExecutorImpl::KernelStats* kernel_stats,
+    ExecutorImpl::ActivationStats* activation_stats)
     : vlog_(VLOG_IS_ON(1)),
       log_memory_(LogMemory::IsEnabled()),
       step_id_(args.step_id),
       trace_id_(args.function_trace_id ? *args.function_trace_id : step_id_),
       start_time_usecs_(args.start_time_usecs),
       deadline_(args.deadline),
+      priority_(args.priority),
       rendezvous_(args.rendezvous),
       collective_executor_(args.collective_executor),
       session_state_(args.session_state),
@@ -440,12 +613,17 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       call_frame_(args.call_frame),
       immutable_state_(immutable_state),
       kernel_stats_(kernel_stats),
+      activation_stats_(activation_stats),
+      op_cost_recorder_(OpCostRecorder::Global()),
       cancellation_manager_(args.cancellation_manager),
       coordination_service_agent_(args.coordination_service_agent),
       stack_trace_(args.stack_trace),
       runner_(args.runner),
       sync_on_finish_(args.sync_on_finish),
       run_all_kernels_inline_(args.run_all_kernels_inline),
+      step_arena_(args.use_per_step_arena
+                      ? std::make_unique<core::Arena>(64 << 10)
+                      : nullptr),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
   if (args.user_intra_op_threadpool != nullptr) {
@@ -559,6 +737,31 @@ struct ExecutorState<PropagatorStateType>::AsyncState {
   }
 };
 
+template <class PropagatorStateType>
+template <typename... ArgTypes>
+typename ExecutorState<PropagatorStateType>::AsyncState*
+ExecutorState<PropagatorStateType>::NewAsyncState(ArgTypes&&... args) {
+  if (step_arena_ == nullptr) {
+    return new AsyncState(std::forward<ArgTypes>(args)...);
+  }
+  void* mem;
+  {
+    mutex_lock l(step_arena_mu_);
+    mem = step_arena_->AllocAligned(sizeof(AsyncState), alignof(AsyncState));
+  }
+  return new (mem) AsyncState(std::forward<ArgTypes>(args)...);
+}
+
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::DestroyAsyncState(AsyncState* state) {
+  if (step_arena_ == nullptr) {
+    delete state;
+  } else {
+    // The arena reclaims the storage in bulk when the step finishes.
+    state->~AsyncState();
+  }
+}
+
 // Returns true if `item` might be traced by the given trace and event
 // collectors. Returns false only if `item` definitely will not be traced.
 bool MightTrace(const tracing::EventCollector* event_collector,
@@ -591,6 +794,16 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   Device* device = immutable_state_.params().device;
   const bool is_expensive = kernel_stats_->IsExpensive(item);
 
+  // When op cost recording or activation profiling is opted in, time every
+  // sync kernel with the cycle counter; the two reads and the per-node
+  // accumulation cost well under a microsecond per node.
+  const bool record_op_cost = TF_PREDICT_FALSE(op_cost_recorder_ != nullptr);
+  const bool record_activation = TF_PREDICT_FALSE(activation_stats_->enabled());
+  const uint64 op_cost_start_cycles =
+      (record_op_cost || record_activation)
+          ? profile_utils::CpuUtils::GetCurrentClockCycle()
+          : 0;
+
   if (TF_PREDICT_FALSE(MightTrace(event_collector_, is_expensive))) {
     tracing::ScopedRegion region(tracing::EventCategory::kCompute,
                                  op_kernel->name_view());
@@ -615,6 +828,17 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
   } else {
     device->Compute(op_kernel, &ctx);
   }
+  if (record_op_cost || record_activation) {
+    const uint64 elapsed_cycles =
+        profile_utils::CpuUtils::GetCurrentClockCycle() - op_cost_start_cycles;
+    if (record_op_cost) {
+      op_cost_recorder_->RecordOpCost(op_kernel->type_string_view(),
+                                      elapsed_cycles);
+    }
+    if (record_activation) {
+      activation_stats_->Record(item, elapsed_cycles);
+    }
+  }
   nodestats::SetOpEnd(stats);
   if (outputs->size() < item.num_outputs) outputs->resize(item.num_outputs);
   s = ProcessOutputs(item, &ctx, outputs->data(), stats);
@@ -630,7 +854,7 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
   AsyncOpKernel* async_kernel = item.kernel->AsAsync();
   DCHECK(async_kernel != nullptr);
   AsyncState* state =
-      new AsyncState(params, tagged_node, &item, first_input, stats);
+      NewAsyncState(params, tagged_node, &item, first_input, stats);
 
   nodestats::SetOpStart(stats);
 
@@ -696,7 +920,7 @@ void ExecutorState<PropagatorStateType>::ProcessAsync(
       }
       outputs.clear();
       const bool completed = NodeDone(s, &ready, stats, nullptr);
-      delete state;
+      DestroyAsyncState(state);
       if (completed) ScheduleFinish();
     };
 
@@ -756,6 +980,7 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
   }
   params->start_time_usecs = start_time_usecs_;
   params->deadline = deadline_;
+  params->priority = priority_;
   params->log_memory = log_memory_;
   params->rendezvous = rendezvous_;
   params->collective_executor = collective_executor_;
@@ -801,6 +1026,11 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
 
   EntryVector outputs(1);
 
+  // Checked once per scheduled closure rather than per node to keep the
+  // clock read off the per-node fast path.
+  const bool deadline_exceeded = deadline_.has_value() && EnforceDeadline() &&
+                                 absl::Now() > *deadline_;
+
   bool completed = false;
   int64_t last_iter_num = -1;
   std::unique_ptr<profiler::TraceMeConsumer> iteration_scope;
@@ -890,6 +1120,21 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
     } else if (item.const_tensor != nullptr && !params->track_allocations) {
       ProcessConstTensor(item, &outputs, stats);
     } else {
+      if (TF_PREDICT_FALSE(deadline_exceeded)) {
+        s = errors::DeadlineExceeded("Step ", step_id_,
+                                     " exceeded its deadline before op '",
+                                     item.kernel->name(), "' could run.");
+        // Clear inputs.
+        const int num_inputs = item.num_inputs;
+        for (int i = 0; i < num_inputs; ++i) {
+          (first_input + i)->ClearVal();
+        }
+        propagator_.MaybeMarkCompleted(tagged_node);
+        activity_watcher::ActivityEnd(activity_id);
+        // NodeDone aborts the rest of the step, including cancellation.
+        completed = NodeDone(s, ready.get(), stats, inline_ready);
+        continue;
+      }
       // Prepares inputs.
       bool is_input_dead = false;
       s = PrepareInputs(item, first_input, inputs.get(), &input_alloc_attrs,
@@ -908,6 +1153,12 @@ void ExecutorState<PropagatorStateType>::ProcessInline(
       }
 
       // Set up compute params.
+      const std::vector<DeviceContext*>& device_context_map =
+          immutable_state_.device_context_map();
+      if (TF_PREDICT_FALSE(!device_context_map.empty()) &&
+          id < static_cast<int>(device_context_map.size())) {
+        params->op_device_context = device_context_map[id];
+      }
       params->op_kernel = item.kernel;
       params->frame_iter = propagator_.GetFrameAndIter(tagged_node);
       params->is_input_dead = is_input_dead;
@@ -1298,10 +1549,15 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     const TaggedNode* curr_expensive_node = nullptr;
     TaggedNodeSeq expensive_nodes;
     if (inline_ready == nullptr) {
-      // Schedule to run all the ready ops in thread pool.
-      for (auto& tagged_node : *ready) {
-        RunTask([=]() { Process(tagged_node, scheduled_nsec); },
-                /*sample_rate=*/ready->size());
+      if (ready->size() > 1) {
+        // Hand the whole batch to the thread pool at once; workers claim
+        // nodes lock-free instead of dequeuing through per-node closures.
+        RunReadyBatch(std::move(*ready), scheduled_nsec);
+      } else {
+        for (auto& tagged_node : *ready) {
+          RunTask([=]() { Process(tagged_node, scheduled_nsec); },
+                  /*sample_rate=*/ready->size());
+        }
       }
     } else {
       for (auto& tagged_node : *ready) {
@@ -1371,6 +1627,35 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
   ready->clear();
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::RunReadyBatch(TaggedNodeSeq ready,
+                                                       int64_t scheduled_nsec) {
+  // The batch outlives the scheduling thread; each worker closure holds a
+  // reference. `next` is the claim cursor: a worker owns node `i` iff its
+  // fetch_add returned `i`, so no two workers process the same node and the
+  // handoff involves no mutex.
+  struct ReadyBatch {
+    TaggedNodeSeq nodes;
+    std::atomic<size_t> next{0};
+  };
+  auto batch = std::make_shared<ReadyBatch>();
+  batch->nodes = std::move(ready);
+  const size_t num_nodes = batch->nodes.size();
+  const size_t num_workers =
+      std::min(num_nodes, static_cast<size_t>(port::MaxParallelism()));
+  for (size_t w = 0; w < num_workers; ++w) {
+    RunTask(
+        [this, batch, scheduled_nsec]() {
+          for (size_t i = batch->next.fetch_add(1, std::memory_order_relaxed);
+               i < batch->nodes.size();
+               i = batch->next.fetch_add(1, std::memory_order_relaxed)) {
+            Process(batch->nodes[i], scheduled_nsec);
+          }
+        },
+        /*sample_rate=*/num_workers);
+  }
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleFinish() {
   // Checks condition to decide if needs to invoke Finish(). If there are
@@ -1508,16 +1793,23 @@ void ExecutorState<PropagatorStateType>::Finish() {
 }
 
 void ExecutorImpl::RunAsyncInternal(const Args& args, DoneCallback done) {
-  if (OpOrderDeterminismRequired()) {
-    (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
-                                               &kernel_stats_))
+  if (require_flat_) {
+    // Initialize() verified that the graph has no control flow, so frame and
+    // iteration bookkeeping can be skipped unconditionally.
+    (new ExecutorState<SimplePropagatorState>(
+         args, immutable_state_, &kernel_stats_, &activation_stats_))
+        ->RunAsync(std::move(done));
+  } else if (OpOrderDeterminismRequired()) {
+    (new ExecutorState<OrderedPropagatorState>(
+         args, immutable_state_, &kernel_stats_, &activation_stats_))
         ->RunAsync(std::move(done));
   } else if (immutable_state_.requires_control_flow_support()) {
-    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_))
+    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_,
+                                        &activation_stats_))
         ->RunAsync(std::move(done));
   } else {
-    (new ExecutorState<SimplePropagatorState>(args, immutable_state_,
-                                              &kernel_stats_))
+    (new ExecutorState<SimplePropagatorState>(
+         args, immutable_state_, &kernel_stats_, &activation_stats_))
         ->RunAsync(std::move(done));
   }
 }
@@ -1571,6 +1863,27 @@ class DefaultExecutorRegistrar {
 };
 static DefaultExecutorRegistrar registrar;
 
+// Registers the "FLAT" executor: a specialization for control-flow-free
+// graphs (e.g. static-shape serving graphs) that drops all frame/iteration
+// tracking and runs a straight topological schedule. Graph construction fails
+// if the graph contains control-flow ops.
+class FlatExecutorRegistrar {
+ public:
+  FlatExecutorRegistrar() { ExecutorFactory::Register("FLAT", new Factory); }
+
+ private:
+  class Factory : public ExecutorFactory {
+    Status NewExecutor(const LocalExecutorParams& params, const Graph& graph,
+                       std::unique_ptr<Executor>* out_executor) override {
+      auto impl = std::make_unique<ExecutorImpl>(params, /*require_flat=*/true);
+      TF_RETURN_IF_ERROR(impl->Initialize(graph));
+      *out_executor = std::move(impl);
+      return OkStatus();
+    }
+  };
+};
+static FlatExecutorRegistrar flat_registrar;
+
 }  // namespace
 
 }  // namespace tensorflow
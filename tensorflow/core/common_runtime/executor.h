@@ -112,6 +112,12 @@ class Executor {
     int64_t start_time_usecs = 0;
     // The deadline for the kernel to complete by. Empty if unspecified.
     absl::optional<absl::Time> deadline;
+    // Priority of the request this step belongs to, from
+    // RunOptions.experimental.run_handler_pool_options. Larger means more
+    // important; 0 if unspecified. Exposed to kernels through
+    // OpKernelContext::priority() so cooperative kernels (e.g. batching)
+    // can let interactive work overtake batch work.
+    int64_t priority = 0;
     absl::optional<ManagedStackTrace> stack_trace = absl::nullopt;
 
     // If true, calls Sync() on the device.
@@ -124,6 +130,13 @@ class Executor {
     // If true, all kernels will be treated as "inexpensive", and hence executed
     // on the scheduling thread.
     bool run_all_kernels_inline = false;
+
+    // If true, transient per-step executor state (e.g. the bookkeeping kept
+    // alive for asynchronous kernels) is allocated from a bump-pointer arena
+    // that is released in bulk when the step completes, instead of from the
+    // global heap. This reduces malloc contention for small-op-heavy graphs
+    // on many-core hosts.
+    bool use_per_step_arena = false;
   };
   typedef std::function<void(const Status&)> DoneCallback;
 
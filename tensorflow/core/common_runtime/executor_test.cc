@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <algorithm>
 
+#include "absl/strings/match.h"
 #include "tensorflow/cc/framework/ops.h"
 #include "tensorflow/cc/ops/array_ops.h"
 #include "tensorflow/cc/ops/const_op.h"
@@ -40,8 +41,10 @@ limitations under the License.
 #include "tensorflow/core/graph/algorithm.h"
 #include "tensorflow/core/graph/testlib.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/random/simple_philox.h"
 #include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/test.h"
@@ -186,6 +189,58 @@ TEST_F(ExecutorTest, SimpleAdd) {
   EXPECT_EQ(2.0, V(out));  // out = 1.0 + 1.0 = 2.0
 }
 
+TEST_F(ExecutorTest, ActivationProfileExport) {
+  const string dir = io::JoinPath(testing::TmpDir(), "activation_profile");
+  TF_ASSERT_OK(Env::Default()->RecursivelyCreateDir(dir));
+  setenv("TF_EXECUTOR_ACTIVATION_PROFILE_DIR", dir.c_str(), 1);
+
+  // c = a + b, as in SimpleAdd above.
+  auto g = std::make_unique<Graph>(OpRegistry::Global());
+  auto in0 = test::graph::Recv(g.get(), "a", "float", ALICE, 1, BOB);
+  auto in1 = test::graph::Recv(g.get(), "b", "float", ALICE, 1, BOB);
+  auto tmp = test::graph::Add(g.get(), in0, in1);
+  test::graph::Send(g.get(), tmp, "c", BOB, 1, ALICE);
+  Create(std::move(g));
+  unsetenv("TF_EXECUTOR_ACTIVATION_PROFILE_DIR");
+
+  Rendezvous::Args args;
+  TF_ASSERT_OK(
+      rendez_->Send(Key(ALICE, kIncarnation, BOB, "a"), args, V(1.0), false));
+  TF_ASSERT_OK(
+      rendez_->Send(Key(ALICE, kIncarnation, BOB, "b"), args, V(1.0), false));
+  TF_ASSERT_OK(Run(rendez_));
+  Tensor out = V(-1);
+  bool is_dead = false;
+  TF_ASSERT_OK(
+      rendez_->Recv(Key(BOB, kIncarnation, ALICE, "c"), args, &out, &is_dead));
+  EXPECT_EQ(2.0, V(out));
+
+  // The collapsed-stack files are written when the executor is destroyed.
+  delete exec_;
+  exec_ = nullptr;
+
+  std::vector<string> children;
+  TF_ASSERT_OK(Env::Default()->GetChildren(dir, &children));
+  string cycles_path;
+  string counts_path;
+  for (const string& child : children) {
+    if (absl::EndsWith(child, ".cycles.collapsed")) {
+      cycles_path = io::JoinPath(dir, child);
+    } else if (absl::EndsWith(child, ".counts.collapsed")) {
+      counts_path = io::JoinPath(dir, child);
+    }
+  }
+  ASSERT_FALSE(cycles_path.empty());
+  ASSERT_FALSE(counts_path.empty());
+
+  // The Add node must show up as a leaf frame in both exports.
+  string contents;
+  TF_ASSERT_OK(ReadFileToString(Env::Default(), cycles_path, &contents));
+  EXPECT_TRUE(absl::StrContains(contents, ";Add ")) << contents;
+  TF_ASSERT_OK(ReadFileToString(Env::Default(), counts_path, &contents));
+  EXPECT_TRUE(absl::StrContains(contents, ";Add ")) << contents;
+}
+
 TEST_F(ExecutorTest, SelfAdd) {
   // v0 <- a
   // v1 = v0 + v0
@@ -432,6 +432,14 @@ class FunctionLibraryRuntimeImpl : public FunctionLibraryRuntime {
   };
   std::unique_ptr<absl::flat_hash_map<Handle, std::unique_ptr<Item>>> items_
       TF_GUARDED_BY(mu_);
+  // Number of shape-specialized instantiations created per shape-generic
+  // canonical key, for callers that set `InstantiateOptions::input_shapes`.
+  // Once a function reaches the bound, further shape signatures share the
+  // shape-generic instantiation. Counts are not decremented on release, so
+  // the bound is conservative over the lifetime of this runtime.
+  static constexpr int kMaxShapeSpecializationsPerFunction = 8;
+  absl::flat_hash_map<string, int> shape_specialization_counts_
+      TF_GUARDED_BY(mu_);
   std::unique_ptr<FunctionHandleCache> function_handle_cache_;
   ProcessFunctionLibraryRuntime* parent_ = nullptr;  // not owned.
 
@@ -773,6 +781,27 @@ Status FunctionLibraryRuntimeImpl::Instantiate(
   // in the canonical key.
   InstantiateOptions options_copy(options);
   options_copy.target = device_name_;
+
+  // When shape-specialized instantiation is requested, bound the number of
+  // specialized variants per shape-generic signature: once the bound is
+  // reached, new shape signatures fall back to the shape-generic
+  // instantiation instead of creating another item.
+  string shape_generic_key;
+  if (!options_copy.input_shapes.empty()) {
+    InstantiateOptions generic_options(options_copy);
+    generic_options.input_shapes.clear();
+    shape_generic_key = Canonicalize(function_name, attrs, generic_options);
+    const string specialized_key =
+        Canonicalize(function_name, attrs, options_copy);
+    mutex_lock l(mu_);
+    if (parent_->GetHandle(specialized_key) == kInvalidHandle) {
+      auto count = shape_specialization_counts_.find(shape_generic_key);
+      if (count != shape_specialization_counts_.end() &&
+          count->second >= kMaxShapeSpecializationsPerFunction) {
+        options_copy.input_shapes.clear();
+      }
+    }
+  }
   const string key = Canonicalize(function_name, attrs, options_copy);
 
   {
@@ -823,6 +852,21 @@ Status FunctionLibraryRuntimeImpl::Instantiate(
     Int32FulltypePass int32_fulltype("FunctionLibraryRuntime::Instantiate");
     TF_RETURN_IF_ERROR(
         int32_fulltype.ProcessGraph(fbody->graph, /*ints_on_device=*/false));
+    if (!options_copy.input_shapes.empty()) {
+      // Record the requested shapes on the `_Arg` nodes so that shape
+      // inference over the specialized body can take advantage of them.
+      if (options_copy.input_shapes.size() != fbody->arg_nodes.size()) {
+        return errors::InvalidArgument(
+            "Expected ", fbody->arg_nodes.size(), " input shapes for function ",
+            function_name, " but got ", options_copy.input_shapes.size(), ".");
+      }
+      for (Node* arg : fbody->arg_nodes) {
+        int index;
+        TF_RETURN_IF_ERROR(GetNodeAttr(arg->attrs(), "index", &index));
+        arg->AddAttr("_output_shapes", std::vector<PartialTensorShape>{
+                                           options_copy.input_shapes[index]});
+      }
+    }
   }
 
   LocalHandle local_handle;
@@ -851,6 +895,9 @@ Status FunctionLibraryRuntimeImpl::Instantiate(
       }
       local_handle = next_handle_++;
       items_->emplace(local_handle, std::unique_ptr<Item>(item));
+      if (!options_copy.input_shapes.empty()) {
+        ++shape_specialization_counts_[shape_generic_key];
+      }
     }
   }
 
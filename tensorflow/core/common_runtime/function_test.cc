@@ -721,6 +721,49 @@ TEST_F(FunctionLibraryRuntimeTest, StateHandle) {
   }
 }
 
+TEST_F(FunctionLibraryRuntimeTest, ShapeSpecializedInstantiation) {
+  Init({test::function::XTimesTwo()});
+  auto T = DT_FLOAT;
+
+  FunctionLibraryRuntime::Handle generic_handle;
+  TF_CHECK_OK(Instantiate(flr0_, "XTimesTwo", {{"T", T}}, &generic_handle));
+
+  // Distinct input shapes yield distinct instantiations.
+  FunctionLibraryRuntime::InstantiateOptions options;
+  options.input_shapes = {PartialTensorShape({2})};
+  FunctionLibraryRuntime::Handle handle_2;
+  TF_CHECK_OK(Instantiate(flr0_, "XTimesTwo", {{"T", T}}, options, &handle_2));
+  EXPECT_NE(generic_handle, handle_2);
+
+  options.input_shapes = {PartialTensorShape({4})};
+  FunctionLibraryRuntime::Handle handle_4;
+  TF_CHECK_OK(Instantiate(flr0_, "XTimesTwo", {{"T", T}}, options, &handle_4));
+  EXPECT_NE(generic_handle, handle_4);
+  EXPECT_NE(handle_2, handle_4);
+
+  // Re-instantiating with the same shape reuses the specialized handle.
+  FunctionLibraryRuntime::Handle handle_4_again;
+  TF_CHECK_OK(
+      Instantiate(flr0_, "XTimesTwo", {{"T", T}}, options, &handle_4_again));
+  EXPECT_EQ(handle_4, handle_4_again);
+
+  // A specialized instantiation still runs correctly.
+  auto x = test::AsTensor<float>({1, 2, 3, 4});
+  Tensor y;
+  FunctionLibraryRuntime::Options opts;
+  TF_CHECK_OK(Run(flr0_, handle_4, opts, {x}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6, 8}));
+
+  // Past the per-function bound, new shape signatures fall back to the
+  // shape-generic instantiation.
+  FunctionLibraryRuntime::Handle handle = kInvalidHandle;
+  for (int64_t dim = 5; dim < 32; ++dim) {
+    options.input_shapes = {PartialTensorShape({dim})};
+    TF_CHECK_OK(Instantiate(flr0_, "XTimesTwo", {{"T", T}}, options, &handle));
+  }
+  EXPECT_EQ(generic_handle, handle);
+}
+
 namespace {
 class DummyExecutorRegistrar {
  public:
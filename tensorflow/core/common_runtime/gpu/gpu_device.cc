@@ -39,6 +39,7 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -52,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_device.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_process_state.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_util.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_util.h"
 #include "tensorflow/core/common_runtime/gpu_device_context.h"
 #include "tensorflow/core/common_runtime/local_device.h"
@@ -473,15 +475,28 @@ BaseGPUDevice::BaseGPUDevice(const SessionOptions& options, const string& name,
 
 BaseGPUDevice::~BaseGPUDevice() {
   delete accelerator_device_info_;
-  if (scratch_) gpu_allocator_->DeallocateRaw(scratch_);
+  for (char* scratch : scratch_) {
+    if (scratch) gpu_allocator_->DeallocateRaw(scratch);
+  }
+  // stream_device_contexts_[0] is device_context_, released below.
+  for (size_t i = 1; i < stream_device_contexts_.size(); ++i) {
+    stream_device_contexts_[i]->Unref();
+  }
   device_context_->Unref();
 }
 
 // This should be idempotent if already initialized.
 Status BaseGPUDevice::InitScratchBuffers() {
   mutex_lock l(scratch_init_mutex_);
-  if (!scratch_) {
-    DCHECK(stream_);
+  DCHECK(stream_);
+  // One scratch buffer per compute stream, since concurrent kernels on
+  // different streams must not share the Eigen scratchpad/semaphore.
+  const size_t num_streams = std::max<size_t>(1, stream_device_contexts_.size());
+  if (scratch_.size() < num_streams) {
+    scratch_.resize(num_streams, nullptr);
+  }
+  for (size_t i = 0; i < num_streams; ++i) {
+    if (scratch_[i]) continue;
     size_t scratch_buffer_size = Eigen::kGpuScratchSize + sizeof(unsigned int);
     profiler::ScopedMemoryDebugAnnotation op_annotation("ScratchBuffer");
     void* scratch_buffer = gpu_allocator_->AllocateRaw(
@@ -495,7 +510,7 @@ Status BaseGPUDevice::InitScratchBuffers() {
         se::DeviceMemoryBase(scratch_buffer, scratch_buffer_size));
     TF_RETURN_IF_ERROR(executor_->SynchronousMemZero(
         &mem, Eigen::kGpuScratchSize + sizeof(unsigned int)));
-    scratch_ = static_cast<char*>(scratch_buffer);
+    scratch_[i] = static_cast<char*>(scratch_buffer);
   }
   return OkStatus();
 }
@@ -557,6 +572,31 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
 #endif
                            stream_->host_to_device, stream_->device_to_host,
                            stream_->device_to_device, host_memory_allocator);
+  stream_device_contexts_.push_back(device_context_);
+
+#ifndef TF_GPU_USE_PJRT
+  // Optionally create additional compute streams so that independent
+  // subgraphs can run concurrently (see FillContextMap). Off by default;
+  // the PJRT path owns its streams and is left untouched.
+  int64_t max_streams = 1;
+  TF_RETURN_IF_ERROR(
+      ReadInt64FromEnvVar("TF_GPU_MAX_STREAMS", 1, &max_streams));
+  if (max_streams < 1) {
+    return errors::InvalidArgument("TF_GPU_MAX_STREAMS must be >= 1, got ",
+                                   max_streams);
+  }
+  for (int i = 1; i < max_streams; ++i) {
+    StreamGroup* group = StreamGroupFactory::Global().GetOrCreate(
+        tf_device_id_, i, executor_, options.config.gpu_options());
+    stream_device_contexts_.push_back(
+        new GPUDeviceContext(i, group->compute,
+#if TENSORFLOW_USE_ROCM
+                             group->nccl,
+#endif
+                             group->host_to_device, group->device_to_host,
+                             group->device_to_device, host_memory_allocator));
+  }
+#endif  // TF_GPU_USE_PJRT
 
   em_ = EventMgrFactory::Singleton()->GetEventMgr(executor_,
                                                   options.config.gpu_options());
@@ -846,7 +886,41 @@ Status BaseGPUDevice::Sync() {
   // enqueued the operation has completed.  We do use other streams for copies
   // and collectives, but in those cases the (Async)OpKernels themselves block
   // until the queued operation has finished.
-  return stream_->compute->BlockHostUntilDone();
+  for (GPUDeviceContext* context : stream_device_contexts_) {
+    TF_RETURN_IF_ERROR(context->stream()->BlockHostUntilDone());
+  }
+  if (stream_device_contexts_.empty()) {
+    return stream_->compute->BlockHostUntilDone();
+  }
+  return OkStatus();
+}
+
+Status BaseGPUDevice::FillContextMap(const Graph* graph,
+                                     std::vector<DeviceContext*>* device_contexts) {
+  device_contexts->clear();
+  if (stream_device_contexts_.size() <= 1) {
+    // Single-stream device: the executor's default context is sufficient.
+    return OkStatus();
+  }
+  VLOG(2) << "FillContextMap";
+
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  opts.max_streams = static_cast<int32>(stream_device_contexts_.size());
+  TF_RETURN_IF_ERROR(
+      gpu_stream_util::AssignStreams(graph, opts, &node_to_stream_id));
+
+  // Fill in the context map. It is OK for this map to contain ops that are not
+  // the ones that we are interested in. These ops will be mapped to stream 0.
+  device_contexts->resize(graph->num_node_ids(), nullptr);
+  for (Node* n : graph->nodes()) {
+    auto mapped_stream = node_to_stream_id.find(n->id());
+    const int stream_id =
+        mapped_stream == node_to_stream_id.end() ? 0 : mapped_stream->second;
+    VLOG(3) << "Assigned stream " << stream_id << " ==> " << n->DebugString();
+    (*device_contexts)[n->id()] = stream_device_contexts_[stream_id];
+  }
+  return OkStatus();
 }
 
 void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
@@ -1281,11 +1355,15 @@ void BaseGPUDevice::ReinitializeDevice(OpKernelContext* context,
   ConcretePerOpGpuDevice* concrete_device =
       static_cast<ConcretePerOpGpuDevice*>(device);
   DCHECK(concrete_device);
-  DCHECK_EQ(stream_id, 0);
+  DCHECK_GE(stream_id, 0);
+  DCHECK_LT(stream_id, static_cast<int>(stream_device_contexts_.size()));
   const gpuStream_t gpu_stream = reinterpret_cast<gpuStream_t>(
-      stream_->compute->platform_specific_handle().stream);
+      stream_device_contexts_[stream_id]
+          ->stream()
+          ->platform_specific_handle()
+          .stream);
   concrete_device->Reinitialize(context, gpu_stream, tf_device_id_, allocator,
-                                scratch_);
+                                scratch_[stream_id]);
 }
 
 PerOpGpuDevice* BaseGPUDevice::MakeGpuDevice() {
@@ -1302,7 +1380,6 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
     const int stream_id = gpu_dc->stream_id();
     VLOG(1) << "  eigen_gpu_device(" << dc << ") => stream[" << stream_id
             << "]";
-    CHECK_EQ(stream_id, 0);
     ReinitializeDevice(context, device, stream_id, allocator);
   } else {
     ReinitializeDevice(context, device, 0, allocator);
@@ -121,6 +121,13 @@ class BaseGPUDevice : public LocalDevice {
 
   Status Sync() override;
 
+  // When more than one compute stream is enabled (see TF_GPU_MAX_STREAMS in
+  // gpu_device.cc), assigns independent subgraphs of `graph` to distinct
+  // streams by filling per-node DeviceContexts; otherwise leaves the map
+  // empty.
+  Status FillContextMap(const Graph* graph,
+                        std::vector<DeviceContext*>* device_contexts) override;
+
   void ComputeAsync(AsyncOpKernel* op_kernel, OpKernelContext* context,
                     AsyncOpKernel::DoneCallback done) override;
 
@@ -195,8 +202,12 @@ class BaseGPUDevice : public LocalDevice {
   core::RefCountPtr<DeviceContext> pjrt_device_context_;
   StreamGroup* stream_;
   mutex scratch_init_mutex_;
-  char* scratch_ = nullptr;
+  // Per-stream Eigen scratch buffers, indexed by stream id.
+  gtl::InlinedVector<char*, 4> scratch_;
   GPUDeviceContext* device_context_;
+  // One DeviceContext per compute stream; index 0 is `device_context_`.
+  // Entries past index 0 exist only when multiple streams are enabled.
+  gtl::InlinedVector<GPUDeviceContext*, 4> stream_device_contexts_;
   DeviceBase::AcceleratorDeviceInfo* accelerator_device_info_ = nullptr;
   mutex trace_mu_;
   tsl::TfDeviceId tf_device_id_;
@@ -0,0 +1,133 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_graph_cache.h"
+
+#include <optional>
+#include <utility>
+
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/logging.h"
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+#include "xla/stream_executor/gpu/gpu_graph.h"
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+
+namespace tensorflow {
+
+struct GpuGraphCache::Entry {
+  mutex mu;
+  uint64 fingerprint TF_GUARDED_BY(mu) = 0;
+  int64_t stable_runs TF_GUARDED_BY(mu) = 0;
+  // Capture is attempted at most once per fingerprint; a failed capture
+  // disables the entry so the cost is not paid again every step.
+  bool capture_failed TF_GUARDED_BY(mu) = false;
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  std::optional<se::gpu::OwnedGpuGraphExec> exec TF_GUARDED_BY(mu);
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+};
+
+GpuGraphCache::GpuGraphCache(int64_t warmup_runs)
+    : warmup_runs_(warmup_runs) {}
+
+GpuGraphCache::~GpuGraphCache() = default;
+
+GpuGraphCache::Entry* GpuGraphCache::LookupOrCreate(uint64 key) {
+  mutex_lock l(mu_);
+  std::unique_ptr<Entry>& entry = entries_[key];
+  if (entry == nullptr) {
+    entry = std::make_unique<Entry>();
+  }
+  return entry.get();
+}
+
+Status GpuGraphCache::RunOrCapture(uint64 key, uint64 shape_fingerprint,
+                                   se::Stream* stream,
+                                   const std::function<Status()>& launch) {
+  Entry* entry = LookupOrCreate(key);
+  mutex_lock l(entry->mu);
+
+  if (entry->fingerprint != shape_fingerprint) {
+    // The signature is being called with new shapes: any captured graph is
+    // stale and the warmup count starts over.
+    entry->fingerprint = shape_fingerprint;
+    entry->stable_runs = 0;
+    entry->capture_failed = false;
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+    entry->exec.reset();
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  }
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  if (entry->exec.has_value()) {
+    return entry->exec->Launch(stream);
+  }
+
+  if (entry->stable_runs >= warmup_runs_ && !entry->capture_failed) {
+    auto captured =
+        se::gpu::CaptureGpuGraph(stream, [&launch]() { return launch(); });
+    if (!captured.ok()) {
+      // Typically the launch sequence synchronized with the host or touched
+      // another stream. The work was only recorded, not executed, so fall
+      // through to a regular launch.
+      LOG(WARNING) << "Failed to capture GPU graph for signature " << key
+                   << ": " << captured.status()
+                   << "; falling back to regular launches.";
+      entry->capture_failed = true;
+      return launch();
+    }
+    auto exec = se::gpu::InstantiateGpuGraph(std::move(captured).value());
+    if (!exec.ok()) {
+      LOG(WARNING) << "Failed to instantiate GPU graph for signature " << key
+                   << ": " << exec.status()
+                   << "; falling back to regular launches.";
+      entry->capture_failed = true;
+      return launch();
+    }
+    entry->exec = std::move(exec).value();
+    VLOG(1) << "Captured GPU graph for signature " << key << " after "
+            << entry->stable_runs << " warmup runs";
+    // Capture only records the launches; replay the new graph to run the
+    // work of this step.
+    return entry->exec->Launch(stream);
+  }
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+
+  ++entry->stable_runs;
+  return launch();
+}
+
+int64_t GpuGraphCache::num_captured_graphs() const {
+  int64_t count = 0;
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  mutex_lock l(mu_);
+  for (const auto& [key, entry] : entries_) {
+    mutex_lock entry_lock(entry->mu);
+    if (entry->exec.has_value()) ++count;
+  }
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  return count;
+}
+
+uint64 GpuGraphCache::CombineShapeFingerprint(uint64 fingerprint,
+                                              const TensorShape& shape) {
+  fingerprint = Hash64Combine(fingerprint, shape.dims());
+  for (const auto& dim : shape) {
+    fingerprint = Hash64Combine(fingerprint, dim.size);
+  }
+  return fingerprint;
+}
+
+}  // namespace tensorflow
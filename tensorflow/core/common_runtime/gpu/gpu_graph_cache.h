@@ -0,0 +1,91 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_CACHE_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_CACHE_H_
+
+#include <functional>
+#include <memory>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/stream_executor.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Caches instantiated GPU graph executables, keyed by a caller-chosen launch
+// signature and the fingerprint of the shapes it was last called with.
+//
+// Repeatedly launching the same sequence of small kernels pays a few
+// microseconds of launch overhead per kernel. When the sequence and its
+// shapes are stable from step to step, the whole sequence can be captured
+// once into a GPU graph (CUDA graph / HIP graph) and replayed with a single
+// launch. This class implements the bookkeeping: a signature is launched
+// directly for `warmup_runs` shape-stable calls, captured and instantiated
+// on the next call, and replayed from then on. A shape change drops the
+// captured graph and restarts the warmup count for that signature.
+//
+// Callers opt in per call site and must guarantee that `launch` only
+// enqueues work on `stream`: host synchronization, allocation through a
+// non-stream-ordered allocator, or work on other streams cannot be captured.
+// If a capture attempt fails the signature permanently falls back to direct
+// launches, so an occasionally non-capturable sequence degrades gracefully.
+//
+// On builds without GPU support `RunOrCapture` simply runs `launch`.
+//
+// This class is thread-safe.
+class GpuGraphCache {
+ public:
+  // `warmup_runs` is the number of shape-stable calls a signature must see
+  // before its launch sequence is captured.
+  explicit GpuGraphCache(int64_t warmup_runs);
+  ~GpuGraphCache();
+
+  // Runs the work of signature `key`: replays the captured graph when one
+  // exists for `shape_fingerprint`, otherwise runs `launch` directly (or
+  // captures it, once the signature has warmed up).
+  Status RunOrCapture(uint64 key, uint64 shape_fingerprint, se::Stream* stream,
+                      const std::function<Status()>& launch);
+
+  // The number of instantiated graph executables currently held. GPU graphs
+  // hold device memory, so callers may want to bound this.
+  int64_t num_captured_graphs() const;
+
+  // Folds `shape` into a shape fingerprint. Start from an arbitrary seed and
+  // fold in every input shape of the launch sequence.
+  static uint64 CombineShapeFingerprint(uint64 fingerprint,
+                                        const TensorShape& shape);
+
+ private:
+  struct Entry;
+
+  Entry* LookupOrCreate(uint64 key);
+
+  const int64_t warmup_runs_;
+  mutable mutex mu_;
+  absl::flat_hash_map<uint64, std::unique_ptr<Entry>> entries_
+      TF_GUARDED_BY(mu_);
+
+  GpuGraphCache(const GpuGraphCache&) = delete;
+  void operator=(const GpuGraphCache&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_GRAPH_CACHE_H_
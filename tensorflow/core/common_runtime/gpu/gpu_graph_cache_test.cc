@@ -0,0 +1,127 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+
+#include "tensorflow/core/common_runtime/gpu/gpu_graph_cache.h"
+
+#include <memory>
+#include <vector>
+
+#include "xla/stream_executor/gpu/gpu_init.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/test.h"
+#include "tsl/lib/core/status_test_util.h"
+
+namespace tensorflow {
+namespace {
+
+class GpuGraphCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    se::Platform* platform = se::GPUMachineManager();
+    ASSERT_GT(platform->VisibleDeviceCount(), 0);
+    executor_ = platform->ExecutorForDevice(0).value();
+    stream_ = std::make_unique<se::Stream>(executor_);
+    stream_->Init();
+    ASSERT_TRUE(stream_->ok());
+  }
+
+  se::StreamExecutor* executor_ = nullptr;
+  std::unique_ptr<se::Stream> stream_;
+};
+
+TEST_F(GpuGraphCacheTest, CapturesAfterWarmupAndReplays) {
+  constexpr int kNumElems = 16;
+  se::DeviceMemory<int32> src = executor_->AllocateArray<int32>(kNumElems);
+  se::DeviceMemory<int32> dst = executor_->AllocateArray<int32>(kNumElems);
+  std::vector<int32> host(kNumElems, 7);
+  stream_->ThenMemcpy(&src, host.data(), kNumElems * sizeof(int32));
+  TF_ASSERT_OK(stream_->BlockHostUntilDone());
+
+  GpuGraphCache cache(/*warmup_runs=*/2);
+  int launches = 0;
+  auto launch = [&]() -> Status {
+    ++launches;
+    stream_->ThenMemcpyD2D(&dst, src, kNumElems * sizeof(int32));
+    return OkStatus();
+  };
+
+  // Two warmup runs launch directly; the third is captured and replayed.
+  for (int i = 0; i < 2; ++i) {
+    TF_ASSERT_OK(cache.RunOrCapture(/*key=*/1, /*shape_fingerprint=*/42,
+                                    stream_.get(), launch));
+    EXPECT_EQ(0, cache.num_captured_graphs());
+  }
+  EXPECT_EQ(2, launches);
+  TF_ASSERT_OK(cache.RunOrCapture(1, 42, stream_.get(), launch));
+  EXPECT_EQ(1, cache.num_captured_graphs());
+
+  // Replays do not call `launch` again but still run the captured work.
+  const int launches_after_capture = launches;
+  TF_ASSERT_OK(cache.RunOrCapture(1, 42, stream_.get(), launch));
+  EXPECT_EQ(launches_after_capture, launches);
+
+  std::vector<int32> out(kNumElems, 0);
+  stream_->ThenMemcpy(out.data(), dst, kNumElems * sizeof(int32));
+  TF_ASSERT_OK(stream_->BlockHostUntilDone());
+  EXPECT_EQ(host, out);
+
+  executor_->Deallocate(&src);
+  executor_->Deallocate(&dst);
+}
+
+TEST_F(GpuGraphCacheTest, ShapeChangeDropsCapturedGraph) {
+  constexpr int kNumElems = 16;
+  se::DeviceMemory<int32> src = executor_->AllocateArray<int32>(kNumElems);
+  se::DeviceMemory<int32> dst = executor_->AllocateArray<int32>(kNumElems);
+
+  GpuGraphCache cache(/*warmup_runs=*/1);
+  auto launch = [&]() -> Status {
+    stream_->ThenMemcpyD2D(&dst, src, kNumElems * sizeof(int32));
+    return OkStatus();
+  };
+
+  TF_ASSERT_OK(cache.RunOrCapture(1, 42, stream_.get(), launch));
+  TF_ASSERT_OK(cache.RunOrCapture(1, 42, stream_.get(), launch));
+  EXPECT_EQ(1, cache.num_captured_graphs());
+
+  // A new fingerprint invalidates the captured graph and restarts warmup.
+  TF_ASSERT_OK(cache.RunOrCapture(1, 43, stream_.get(), launch));
+  EXPECT_EQ(0, cache.num_captured_graphs());
+  TF_ASSERT_OK(cache.RunOrCapture(1, 43, stream_.get(), launch));
+  EXPECT_EQ(1, cache.num_captured_graphs());
+
+  executor_->Deallocate(&src);
+  executor_->Deallocate(&dst);
+}
+
+TEST(GpuGraphCacheShapeFingerprintTest, DistinguishesShapes) {
+  const uint64 a =
+      GpuGraphCache::CombineShapeFingerprint(0, TensorShape({2, 3}));
+  const uint64 b =
+      GpuGraphCache::CombineShapeFingerprint(0, TensorShape({3, 2}));
+  const uint64 c =
+      GpuGraphCache::CombineShapeFingerprint(0, TensorShape({6}));
+  EXPECT_NE(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(a, GpuGraphCache::CombineShapeFingerprint(0, TensorShape({2, 3})));
+}
+
+}  // namespace
+}  // namespace tensorflow
+
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
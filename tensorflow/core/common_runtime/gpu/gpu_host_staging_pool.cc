@@ -0,0 +1,89 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_host_staging_pool.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/lib/core/bits.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+// static
+GpuHostStagingPool* GpuHostStagingPool::Get(Allocator* allocator) {
+  // One pool per underlying allocator (host allocators are per NUMA node).
+  // Pools are never destroyed, like the ProcessState allocators they front.
+  static mutex* pools_mu = new mutex;
+  static auto* pools =
+      new absl::flat_hash_map<Allocator*, GpuHostStagingPool*>;
+  mutex_lock l(*pools_mu);
+  GpuHostStagingPool*& pool = (*pools)[allocator];
+  if (pool == nullptr) {
+    pool = new GpuHostStagingPool(allocator);
+  }
+  return pool;
+}
+
+GpuHostStagingPool::GpuHostStagingPool(Allocator* allocator)
+    : allocator_(allocator) {}
+
+// static
+size_t GpuHostStagingPool::BucketSize(size_t bytes) {
+  // Serve small requests from a single 4KiB bucket; otherwise round up to
+  // the next power of two so distinct tensor sizes share free lists.
+  constexpr size_t kMinBucketBytes = 4096;
+  if (bytes <= kMinBucketBytes) return kMinBucketBytes;
+  return size_t{1} << Log2Ceiling64(bytes);
+}
+
+void* GpuHostStagingPool::Acquire(size_t bytes) {
+  DCHECK_GT(bytes, 0);
+  if (bytes > kMaxPooledBytes) {
+    return allocator_->AllocateRaw(Allocator::kAllocatorAlignment, bytes);
+  }
+  const size_t bucket = BucketSize(bytes);
+  {
+    mutex_lock l(mu_);
+    auto it = free_lists_.find(bucket);
+    if (it != free_lists_.end() && !it->second.empty()) {
+      void* ptr = it->second.back();
+      it->second.pop_back();
+      cached_bytes_ -= bucket;
+      return ptr;
+    }
+  }
+  return allocator_->AllocateRaw(Allocator::kAllocatorAlignment, bucket);
+}
+
+void GpuHostStagingPool::Release(void* ptr, size_t bytes) {
+  DCHECK(ptr != nullptr);
+  if (bytes <= kMaxPooledBytes) {
+    const size_t bucket = BucketSize(bytes);
+    mutex_lock l(mu_);
+    if (cached_bytes_ + bucket <= kMaxCachedBytes) {
+      free_lists_[bucket].push_back(ptr);
+      cached_bytes_ += bucket;
+      return;
+    }
+  }
+  allocator_->DeallocateRaw(ptr);
+}
+
+size_t GpuHostStagingPool::cached_bytes() const {
+  mutex_lock l(mu_);
+  return cached_bytes_;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,86 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_HOST_STAGING_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_HOST_STAGING_POOL_H_
+
+#include <map>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A size-bucketed free list of host staging buffers in front of a pinned
+// host allocator (ProcessState::GetGpuHostAllocator).
+//
+// Transfers between pageable host memory and the GPU are staged through
+// pinned buffers to run at full PCIe bandwidth. Staging buffers are
+// transient — acquired when the copy is enqueued and released from the
+// EventMgr callback — so going to the underlying BFC allocator for each
+// transfer serializes copies from different streams on the allocator lock.
+// This pool keeps released buffers on per-size free lists (sizes rounded up
+// to a power of two) and hands them back without touching the allocator.
+//
+// Cached memory is bounded: buffers above `kMaxPooledBytes` bypass the free
+// lists, and releases beyond `kMaxCachedBytes` of total cached memory are
+// returned to the allocator instead of being cached.
+//
+// This class is thread-safe.
+class GpuHostStagingPool {
+ public:
+  // Returns the process-wide pool fronting `allocator`. The allocator must
+  // outlive the process (true for ProcessState-owned host allocators).
+  static GpuHostStagingPool* Get(Allocator* allocator);
+
+  // Returns a buffer of at least `bytes` bytes, or nullptr if the underlying
+  // allocator is out of memory. `bytes` must be > 0.
+  void* Acquire(size_t bytes);
+
+  // Returns a buffer obtained from `Acquire` with the same `bytes` value.
+  void Release(void* ptr, size_t bytes);
+
+  // Cached (idle) bytes currently held by the pool, for tests and logging.
+  size_t cached_bytes() const;
+
+  // Buffers larger than this are allocated and freed directly rather than
+  // cached: pooling power-of-two buckets at these sizes wastes too much
+  // pinned memory.
+  static constexpr size_t kMaxPooledBytes = 64 * 1024 * 1024;
+
+  // Upper bound on idle pinned memory retained across all buckets.
+  static constexpr size_t kMaxCachedBytes = 256 * 1024 * 1024;
+
+ private:
+  explicit GpuHostStagingPool(Allocator* allocator);
+
+  // Rounds `bytes` up to the bucket size it is served from.
+  static size_t BucketSize(size_t bytes);
+
+  Allocator* const allocator_;
+  mutable mutex mu_;
+  size_t cached_bytes_ TF_GUARDED_BY(mu_) = 0;
+  std::map<size_t, std::vector<void*>> free_lists_ TF_GUARDED_BY(mu_);
+
+  GpuHostStagingPool(const GpuHostStagingPool&) = delete;
+  void operator=(const GpuHostStagingPool&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_HOST_STAGING_POOL_H_
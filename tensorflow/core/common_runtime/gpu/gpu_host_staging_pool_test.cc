@@ -0,0 +1,68 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_host_staging_pool.h"
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+// The pool only needs an Allocator, so the tests run against the plain CPU
+// allocator; with a real pinned allocator the behavior is identical.
+TEST(GpuHostStagingPoolTest, ReusesReleasedBuffers) {
+  GpuHostStagingPool* pool = GpuHostStagingPool::Get(cpu_allocator());
+  void* a = pool->Acquire(1000);
+  ASSERT_NE(a, nullptr);
+  EXPECT_EQ(0, pool->cached_bytes());
+  pool->Release(a, 1000);
+  EXPECT_GT(pool->cached_bytes(), 0);
+
+  // A request in the same size bucket is served from the free list.
+  void* b = pool->Acquire(2000);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(0, pool->cached_bytes());
+  pool->Release(b, 2000);
+}
+
+TEST(GpuHostStagingPoolTest, DistinctBucketsDoNotAlias) {
+  GpuHostStagingPool* pool = GpuHostStagingPool::Get(cpu_allocator());
+  void* small = pool->Acquire(1 << 12);
+  void* large = pool->Acquire(1 << 20);
+  pool->Release(small, 1 << 12);
+  pool->Release(large, 1 << 20);
+
+  // The small free list cannot serve the large request.
+  void* again = pool->Acquire(1 << 20);
+  EXPECT_EQ(large, again);
+  pool->Release(again, 1 << 20);
+  void* small_again = pool->Acquire(1 << 12);
+  EXPECT_EQ(small, small_again);
+  pool->Release(small_again, 1 << 12);
+}
+
+TEST(GpuHostStagingPoolTest, OversizedBuffersBypassTheCache) {
+  GpuHostStagingPool* pool = GpuHostStagingPool::Get(cpu_allocator());
+  const size_t cached_before = pool->cached_bytes();
+  const size_t bytes = GpuHostStagingPool::kMaxPooledBytes + 1;
+  void* p = pool->Acquire(bytes);
+  ASSERT_NE(p, nullptr);
+  pool->Release(p, bytes);
+  EXPECT_EQ(cached_before, pool->cached_bytes());
+}
+
+}  // namespace
+}  // namespace tensorflow
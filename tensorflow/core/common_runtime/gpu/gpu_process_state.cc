@@ -38,6 +38,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_cudamalloc_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_debug_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_ordered_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_virtual_mem_allocator.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
 #include "tensorflow/core/common_runtime/shared_counter.h"
@@ -198,11 +199,22 @@ Allocator* GPUProcessState::GetGPUAllocator(
                            total_bytes, peer_gpu_ids);
     SubAllocator* sub_allocator_ptr = sub_allocator.get();
 
+    const int64_t small_alloc_cache_threshold =
+        options.experimental()
+            .cuda_malloc_async_small_alloc_cache_threshold_bytes();
+    const bool use_stream_ordered_allocator =
+        (UseCudaMallocAsyncAllocator() ||
+         options.experimental().use_cuda_malloc_async()) &&
+        small_alloc_cache_threshold > 0;
+
     auto gpu_bfc_allocator = std::make_unique<GPUBFCAllocator>(
         std::move(sub_allocator), total_bytes,
         strings::StrCat("GPU_", tf_device_id.value(), "_bfc"), [&] {
           GPUBFCAllocator::Options o;
-          o.allow_growth = options.allow_growth();
+          // In stream-ordered mode the BFC allocator only caches small
+          // allocations, so it must not preallocate the whole device.
+          o.allow_growth =
+              options.allow_growth() || use_stream_ordered_allocator;
           o.allow_retry_on_failure =
               !options.experimental().disallow_retry_on_allocation_failure();
           o.fragmentation_fraction =
@@ -231,6 +243,20 @@ Allocator* GPUProcessState::GetGPUAllocator(
       // **WARNING** probably will not work in a multi-gpu scenario
       gpu_bfc_allocator.reset();
       gpu_allocator = new GPUcudaMallocAllocator(platform_device_id);
+    } else if (use_stream_ordered_allocator) {
+      LOG(INFO) << "Using stream-ordered CUDA malloc async allocator with a "
+                << small_alloc_cache_threshold
+                << "-byte BFC small-allocation cache for GPU: "
+                << platform_device_id;
+      // Large allocations go straight to the stream-ordered cudaMallocAsync
+      // pool, which frees them in stream order instead of retaining them
+      // conservatively across streams; the BFC layer keeps only the
+      // small-allocation cache.
+      gpu_allocator = new GPUStreamOrderedAllocator(
+          std::move(gpu_bfc_allocator),
+          std::make_unique<se::GpuCudaMallocAsyncAllocator>(platform_device_id,
+                                                            total_bytes),
+          small_alloc_cache_threshold);
     } else if (UseCudaMallocAsyncAllocator() ||
                options.experimental().use_cuda_malloc_async()) {
       LOG(INFO) << "Using CUDA malloc Async allocator for GPU: "
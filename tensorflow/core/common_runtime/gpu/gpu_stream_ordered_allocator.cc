@@ -0,0 +1,122 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_ordered_allocator.h"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "tsl/framework/allocator.h"
+#include "tsl/platform/logging.h"
+
+namespace tensorflow {
+
+GPUStreamOrderedAllocator::GPUStreamOrderedAllocator(
+    std::unique_ptr<tsl::Allocator> small_alloc_cache,
+    std::unique_ptr<tsl::Allocator> stream_ordered,
+    size_t small_alloc_threshold)
+    : small_alloc_cache_(std::move(small_alloc_cache)),
+      stream_ordered_(std::move(stream_ordered)),
+      small_alloc_threshold_(small_alloc_threshold) {
+  CHECK(small_alloc_cache_ != nullptr);  // Crash OK
+  CHECK(stream_ordered_ != nullptr);     // Crash OK
+}
+
+GPUStreamOrderedAllocator::~GPUStreamOrderedAllocator() = default;
+
+void* GPUStreamOrderedAllocator::AllocateRaw(size_t alignment,
+                                             size_t num_bytes) {
+  if (num_bytes <= small_alloc_threshold_) {
+    void* ptr = small_alloc_cache_->AllocateRaw(alignment, num_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+    // The cache is full; fall through so the request is still served, just
+    // without the cache's recycling.
+  }
+  void* ptr = stream_ordered_->AllocateRaw(alignment, num_bytes);
+  if (ptr != nullptr) {
+    tsl::mutex_lock l(mu_);
+    stream_ordered_ptrs_.insert(ptr);
+  }
+  return ptr;
+}
+
+void GPUStreamOrderedAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  bool is_stream_ordered;
+  {
+    tsl::mutex_lock l(mu_);
+    is_stream_ordered = stream_ordered_ptrs_.erase(ptr) > 0;
+  }
+  if (is_stream_ordered) {
+    stream_ordered_->DeallocateRaw(ptr);
+  } else {
+    small_alloc_cache_->DeallocateRaw(ptr);
+  }
+}
+
+bool GPUStreamOrderedAllocator::IsStreamOrderedPtr(const void* ptr) const {
+  tsl::mutex_lock l(mu_);
+  return stream_ordered_ptrs_.contains(ptr);
+}
+
+bool GPUStreamOrderedAllocator::TracksAllocationSizes() const {
+  return small_alloc_cache_->TracksAllocationSizes() &&
+         stream_ordered_->TracksAllocationSizes();
+}
+
+size_t GPUStreamOrderedAllocator::RequestedSize(const void* ptr) const {
+  return IsStreamOrderedPtr(ptr) ? stream_ordered_->RequestedSize(ptr)
+                                 : small_alloc_cache_->RequestedSize(ptr);
+}
+
+size_t GPUStreamOrderedAllocator::AllocatedSize(const void* ptr) const {
+  return IsStreamOrderedPtr(ptr) ? stream_ordered_->AllocatedSize(ptr)
+                                 : small_alloc_cache_->AllocatedSize(ptr);
+}
+
+std::optional<tsl::AllocatorStats> GPUStreamOrderedAllocator::GetStats() {
+  std::optional<tsl::AllocatorStats> cache_stats =
+      small_alloc_cache_->GetStats();
+  std::optional<tsl::AllocatorStats> stream_stats = stream_ordered_->GetStats();
+  if (!cache_stats) return stream_stats;
+  if (!stream_stats) return cache_stats;
+  tsl::AllocatorStats stats = *cache_stats;
+  stats.num_allocs += stream_stats->num_allocs;
+  stats.bytes_in_use += stream_stats->bytes_in_use;
+  stats.peak_bytes_in_use += stream_stats->peak_bytes_in_use;
+  stats.largest_alloc_size =
+      std::max(stats.largest_alloc_size, stream_stats->largest_alloc_size);
+  stats.bytes_reserved += stream_stats->bytes_reserved;
+  stats.peak_bytes_reserved += stream_stats->peak_bytes_reserved;
+  return stats;
+}
+
+bool GPUStreamOrderedAllocator::ClearStats() {
+  // Intentionally not short-circuited, so both allocators are cleared.
+  const bool cache_cleared = small_alloc_cache_->ClearStats();
+  const bool stream_cleared = stream_ordered_->ClearStats();
+  return cache_cleared && stream_cleared;
+}
+
+void GPUStreamOrderedAllocator::SetStreamAndPreallocateMemory(void* stream) {
+  small_alloc_cache_->SetStreamAndPreallocateMemory(stream);
+  stream_ordered_->SetStreamAndPreallocateMemory(stream);
+}
+
+}  // namespace tensorflow
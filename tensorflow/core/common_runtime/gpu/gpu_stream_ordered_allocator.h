@@ -0,0 +1,80 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ORDERED_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ORDERED_ALLOCATOR_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/container/flat_hash_set.h"
+#include "tsl/framework/allocator.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
+
+namespace tensorflow {
+
+// An allocator that serves small allocations from a BFC cache and routes
+// everything else to a stream-ordered (cudaMallocAsync) allocator.
+//
+// The stream-ordered backend frees memory in stream order, so large buffers
+// are reclaimed as soon as their last use on the stream completes instead of
+// being conservatively retained across streams by the BFC allocator. The BFC
+// layer is kept only as a cache for allocations of at most
+// `small_alloc_threshold` bytes, where the per-allocation overhead of the
+// driver pool would otherwise dominate; with growth enabled it stays small.
+class GPUStreamOrderedAllocator : public tsl::Allocator {
+ public:
+  // `small_alloc_cache` is a BFC allocator serving allocations of at most
+  // `small_alloc_threshold` bytes; `stream_ordered` serves the rest. Both are
+  // owned by this allocator.
+  GPUStreamOrderedAllocator(std::unique_ptr<tsl::Allocator> small_alloc_cache,
+                            std::unique_ptr<tsl::Allocator> stream_ordered,
+                            size_t small_alloc_threshold);
+  ~GPUStreamOrderedAllocator() override;
+  std::string Name() override { return "gpu_stream_ordered"; }
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+  bool TracksAllocationSizes() const override;
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+  std::optional<tsl::AllocatorStats> GetStats() override;
+  bool ClearStats() override;
+  void SetStreamAndPreallocateMemory(void* stream) override;
+
+  tsl::AllocatorMemoryType GetMemoryType() const override {
+    return tsl::AllocatorMemoryType::kDevice;
+  }
+
+ private:
+  bool IsStreamOrderedPtr(const void* ptr) const;
+
+  std::unique_ptr<tsl::Allocator> small_alloc_cache_;
+  std::unique_ptr<tsl::Allocator> stream_ordered_;
+  const size_t small_alloc_threshold_;
+
+  // Pointers handed out by `stream_ordered_`, so DeallocateRaw and the size
+  // queries can route a bare pointer back to the allocator that owns it.
+  mutable tsl::mutex mu_;
+  absl::flat_hash_set<const void*> stream_ordered_ptrs_ TF_GUARDED_BY(mu_);
+
+  GPUStreamOrderedAllocator(const GPUStreamOrderedAllocator&) = delete;
+  void operator=(const GPUStreamOrderedAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_GPU_STREAM_ORDERED_ALLOCATOR_H_
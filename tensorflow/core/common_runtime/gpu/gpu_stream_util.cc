@@ -0,0 +1,110 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_util.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+namespace gpu_stream_util {
+
+namespace {
+
+// Union-find over node ids with path halving.
+int FindRoot(std::vector<int>* parent, int i) {
+  while ((*parent)[i] != i) {
+    (*parent)[i] = (*parent)[(*parent)[i]];
+    i = (*parent)[i];
+  }
+  return i;
+}
+
+}  // namespace
+
+Status AssignStreams(const Graph* graph, const AssignStreamsOpts& opts,
+                     std::unordered_map<int, int>* node_to_stream_id) {
+  VLOG(1) << "AssignStreams";
+  if (graph == nullptr) {
+    return errors::InvalidArgument("Bad graph argument supplied.");
+  }
+  if (node_to_stream_id == nullptr) {
+    return errors::InvalidArgument("Bad node_to_stream_id argument supplied.");
+  }
+  if (opts.max_streams < 1) {
+    return errors::InvalidArgument("Max streams must be >= 1.");
+  }
+
+  // Union nodes connected by an edge into weakly-connected components,
+  // ignoring edges through the source and sink nodes: their control edges
+  // touch every root and leaf and would collapse all components into one.
+  const int num_node_ids = graph->num_node_ids();
+  std::vector<int> parent(num_node_ids);
+  std::iota(parent.begin(), parent.end(), 0);
+  for (const Edge* edge : graph->edges()) {
+    const Node* src = edge->src();
+    const Node* dst = edge->dst();
+    if (src->IsSource() || dst->IsSink()) {
+      continue;
+    }
+    parent[FindRoot(&parent, src->id())] = FindRoot(&parent, dst->id());
+  }
+
+  // Count the nodes in each component.
+  std::unordered_map<int, int> component_size;
+  for (const Node* node : graph->op_nodes()) {
+    ++component_size[FindRoot(&parent, node->id())];
+  }
+
+  // Spread components over streams, largest component first onto the
+  // least-loaded stream, so a few big branches do not crowd out small ones.
+  std::vector<std::pair<int, int>> components(component_size.begin(),
+                                              component_size.end());
+  std::sort(components.begin(), components.end(),
+            [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+              return a.second != b.second ? a.second > b.second
+                                          : a.first < b.first;
+            });
+  std::vector<int> stream_load(opts.max_streams, 0);
+  std::unordered_map<int, int> component_to_stream;
+  for (const auto& [root, size] : components) {
+    const int stream_id =
+        std::min_element(stream_load.begin(), stream_load.end()) -
+        stream_load.begin();
+    component_to_stream[root] = stream_id;
+    stream_load[stream_id] += size;
+  }
+
+  // Fill out the mapping. The source and sink nodes go to stream 0.
+  for (const Node* node : graph->nodes()) {
+    const int node_id = node->id();
+    if (node->IsSource() || node->IsSink()) {
+      (*node_to_stream_id)[node_id] = 0;
+      continue;
+    }
+    const int stream_id = component_to_stream[FindRoot(&parent, node_id)];
+    (*node_to_stream_id)[node_id] = stream_id;
+    VLOG(3) << "Node " << node_id << " " << node->type_string() << " "
+            << node->name() << " stream " << stream_id;
+  }
+  return OkStatus();
+}
+
+}  // namespace gpu_stream_util
+}  // namespace tensorflow
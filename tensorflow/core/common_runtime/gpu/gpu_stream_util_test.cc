@@ -0,0 +1,143 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/gpu_stream_util.h"
+
+#include <unordered_map>
+
+#include "tensorflow/cc/ops/standard_ops.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class GpuStreamUtilTest : public ::testing::Test {
+ protected:
+  // Appends a Const -> MatMul -> MatMul chain to `scope`, returning the
+  // name of each node through `node_names`.
+  void AddChain(const Scope& scope, const string& prefix,
+                std::vector<string>* node_names) {
+    auto a = ops::Const(scope.WithOpName(prefix + "/a"),
+                        {{1.0f, 2.0f}, {3.0f, 4.0f}});
+    auto b = ops::MatMul(scope.WithOpName(prefix + "/b"), a, a);
+    ops::MatMul(scope.WithOpName(prefix + "/c"), b, b);
+    node_names->push_back(prefix + "/a");
+    node_names->push_back(prefix + "/b");
+    node_names->push_back(prefix + "/c");
+  }
+
+  // Returns the stream assigned to `name`, failing the test if the node is
+  // missing from the graph or the map.
+  int StreamForNode(const Graph& graph,
+                    const std::unordered_map<int, int>& node_to_stream_id,
+                    const string& name) {
+    for (const Node* n : graph.op_nodes()) {
+      if (n->name() == name) {
+        auto it = node_to_stream_id.find(n->id());
+        EXPECT_TRUE(it != node_to_stream_id.end()) << name;
+        return it == node_to_stream_id.end() ? -1 : it->second;
+      }
+    }
+    ADD_FAILURE() << "Node not found: " << name;
+    return -1;
+  }
+};
+
+TEST_F(GpuStreamUtilTest, BadOpts) {
+  Graph g(OpRegistry::Global());
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  EXPECT_FALSE(
+      gpu_stream_util::AssignStreams(nullptr, opts, &node_to_stream_id).ok());
+  EXPECT_FALSE(gpu_stream_util::AssignStreams(&g, opts, nullptr).ok());
+  opts.max_streams = 0;
+  EXPECT_FALSE(
+      gpu_stream_util::AssignStreams(&g, opts, &node_to_stream_id).ok());
+}
+
+TEST_F(GpuStreamUtilTest, EmptyGraph) {
+  Graph g(OpRegistry::Global());
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  TF_ASSERT_OK(gpu_stream_util::AssignStreams(&g, opts, &node_to_stream_id));
+  EXPECT_EQ(2, node_to_stream_id.size());  // _SOURCE and _SINK.
+}
+
+TEST_F(GpuStreamUtilTest, SingleComponentUsesStreamZero) {
+  Scope root = Scope::NewRootScope();
+  std::vector<string> names;
+  AddChain(root, "chain", &names);
+  Graph g(OpRegistry::Global());
+  TF_ASSERT_OK(root.ToGraph(&g));
+
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  opts.max_streams = 4;
+  TF_ASSERT_OK(gpu_stream_util::AssignStreams(&g, opts, &node_to_stream_id));
+  for (const string& name : names) {
+    EXPECT_EQ(0, StreamForNode(g, node_to_stream_id, name));
+  }
+}
+
+TEST_F(GpuStreamUtilTest, IndependentComponentsGetSeparateStreams) {
+  Scope root = Scope::NewRootScope();
+  std::vector<string> left, right;
+  AddChain(root, "left", &left);
+  AddChain(root, "right", &right);
+  Graph g(OpRegistry::Global());
+  TF_ASSERT_OK(root.ToGraph(&g));
+
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  opts.max_streams = 2;
+  TF_ASSERT_OK(gpu_stream_util::AssignStreams(&g, opts, &node_to_stream_id));
+
+  // Every node within a component shares that component's stream, and the
+  // two independent components land on different streams.
+  const int left_stream = StreamForNode(g, node_to_stream_id, left[0]);
+  const int right_stream = StreamForNode(g, node_to_stream_id, right[0]);
+  for (const string& name : left) {
+    EXPECT_EQ(left_stream, StreamForNode(g, node_to_stream_id, name));
+  }
+  for (const string& name : right) {
+    EXPECT_EQ(right_stream, StreamForNode(g, node_to_stream_id, name));
+  }
+  EXPECT_NE(left_stream, right_stream);
+}
+
+TEST_F(GpuStreamUtilTest, MoreComponentsThanStreams) {
+  Scope root = Scope::NewRootScope();
+  std::vector<string> names;
+  for (int i = 0; i < 5; ++i) {
+    AddChain(root, strings::StrCat("chain", i), &names);
+  }
+  Graph g(OpRegistry::Global());
+  TF_ASSERT_OK(root.ToGraph(&g));
+
+  std::unordered_map<int, int> node_to_stream_id;
+  gpu_stream_util::AssignStreamsOpts opts;
+  opts.max_streams = 2;
+  TF_ASSERT_OK(gpu_stream_util::AssignStreams(&g, opts, &node_to_stream_id));
+  for (const auto& [node_id, stream_id] : node_to_stream_id) {
+    EXPECT_GE(stream_id, 0);
+    EXPECT_LT(stream_id, opts.max_streams);
+  }
+}
+
+}  // namespace
+}  // namespace tensorflow
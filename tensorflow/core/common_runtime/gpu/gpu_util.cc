@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device/device_event_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/common_runtime/gpu/gpu_host_staging_pool.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_process_state.h"
 #include "tensorflow/core/common_runtime/gpu_device_context.h"
 #include "tensorflow/core/framework/log_memory.h"
@@ -270,6 +271,12 @@ bool NeedStaging(const Tensor* tensor) {
   return tensor->GetMemoryType() == AllocatorMemoryType::kHostPageable;
 }
 
+// Device->host copies into pageable memory run at reduced PCIe bandwidth, so
+// above this size they are staged through a pinned buffer at the cost of an
+// extra host memcpy. Below it the memcpy overhead outweighs the bandwidth
+// gain.
+constexpr int64_t kD2HStagingThresholdBytes = 64 * 1024;
+
 }  // namespace
 
 // static
@@ -298,20 +305,39 @@ void GPUUtil::CopyGPUTensorToCPU(Device* gpu_device,
   send_device_to_host_stream->ThenWaitFor(send_stream);
 
   const int64_t total_bytes = gpu_tensor->TotalBytes();
+  void* dst_ptr = nullptr;
+  void* staging_buffer = nullptr;
+  Allocator* host_memory_allocator = device_context->host_memory_allocator();
   if (total_bytes > 0) {
     void* src_ptr = GetBase(gpu_tensor);
     DeviceMemoryBase gpu_src_ptr(src_ptr, total_bytes);
-    void* dst_ptr = GetBase(cpu_tensor);
-    send_device_to_host_stream->ThenMemcpy(dst_ptr, gpu_src_ptr, total_bytes);
+    dst_ptr = GetBase(cpu_tensor);
+    // Large copies into pageable memory are staged through a pinned buffer
+    // so the DMA runs at full bandwidth; the data is memcpy'd to its final
+    // destination once the copy completes.
+    if (total_bytes >= kD2HStagingThresholdBytes && NeedStaging(cpu_tensor) &&
+        host_memory_allocator != nullptr) {
+      staging_buffer =
+          GpuHostStagingPool::Get(host_memory_allocator)->Acquire(total_bytes);
+    }
+    send_device_to_host_stream->ThenMemcpy(
+        staging_buffer != nullptr ? staging_buffer : dst_ptr, gpu_src_ptr,
+        total_bytes);
   }
   // Use of the input may outlive stack scope, so keep a ref.
   TensorReference input_ref(*gpu_tensor);
   dev_info->event_mgr->ThenExecute(
       send_device_to_host_stream,
-      [send_device_to_host_stream, done, input_ref]() {
+      [send_device_to_host_stream, done, input_ref, staging_buffer, dst_ptr,
+       total_bytes, host_memory_allocator]() {
         if (!send_device_to_host_stream->ok()) {
           LOG(FATAL) << "GPU->CPU Memcpy failed";
         }
+        if (staging_buffer != nullptr) {
+          std::memcpy(dst_ptr, staging_buffer, total_bytes);
+          GpuHostStagingPool::Get(host_memory_allocator)
+              ->Release(staging_buffer, total_bytes);
+        }
         input_ref.Unref();
         done(OkStatus());
       });
@@ -370,8 +396,8 @@ void GPUUtil::CopyCPUTensorToGPU(const Tensor* cpu_tensor,
     }
 
     if (do_staging) {
-      staging_buffer = host_memory_allocator->AllocateRaw(
-          tensorflow::Allocator::kAllocatorAlignment, total_bytes);
+      staging_buffer =
+          GpuHostStagingPool::Get(host_memory_allocator)->Acquire(total_bytes);
       std::memcpy(staging_buffer, src_ptr, total_bytes);
       input_ref.Unref();
 
@@ -386,9 +412,10 @@ void GPUUtil::CopyCPUTensorToGPU(const Tensor* cpu_tensor,
   dev_info->event_mgr->ThenExecute(
       recv_host_to_device_stream,
       [recv_host_to_device_stream, done, input_ref, do_staging, staging_buffer,
-       host_memory_allocator]() {
+       total_bytes, host_memory_allocator]() {
         if (do_staging) {
-          host_memory_allocator->DeallocateRaw(staging_buffer);
+          GpuHostStagingPool::Get(host_memory_allocator)
+              ->Release(staging_buffer, total_bytes);
         } else {
           input_ref.Unref();
         }
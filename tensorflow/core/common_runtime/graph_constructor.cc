@@ -107,7 +107,8 @@ class GraphConstructor {
           importing(false),
           validate_nodes(in.validate_nodes),
           validate_colocation_constraints(false),
-          add_default_attributes(in.add_default_attributes) {}
+          add_default_attributes(in.add_default_attributes),
+          skip_node_name_validation(in.skip_node_name_validation) {}
     Options(const ImportGraphDefOptions& in)  // NOLINT(runtime/explicit)
         : allow_internal_ops(false),
           expect_device_spec(false),
@@ -161,6 +162,10 @@ class GraphConstructor {
     // value to the Node when they are missing from the NodeDef.
     bool add_default_attributes = true;
 
+    // If true, skips per-node name validation in BuildNodeIndex(). Never set
+    // when `importing` is set; imported graphs are untrusted.
+    bool skip_node_name_validation = false;
+
     string default_device;
   };
 
@@ -675,9 +680,11 @@ Status GraphConstructor::ValidateInputMapAndControlDependencies() {
 
 Status GraphConstructor::BuildNodeIndex() {
   // Validate the node names and add them to gdef_nodes_ and gdef_prefixes_.
+  gdef_nodes_.reserve(node_def_count());
   for (int n = 0; n < node_def_count(); ++n) {
     const NodeDef& node_def = get_node_def(n);
-    if (!IsValidNodeName(node_def.name(), opts_.allow_internal_ops)) {
+    if (!opts_.skip_node_name_validation &&
+        !IsValidNodeName(node_def.name(), opts_.allow_internal_ops)) {
       return errors::InvalidArgument(
           "Node '", node_def.name(),
           "': Node name contains invalid characters");
@@ -1185,6 +1192,14 @@ Status GraphConstructor::Convert() {
         g_->AddFunctionLibrary(*std::move(library), library_traces));
   }
 
+  // Pre-size the graph's node and edge storage so bulk imports of large
+  // GraphDefs do not repeatedly reallocate while nodes are added below.
+  int num_edges = 0;
+  for (int n = 0; n < node_def_count(); ++n) {
+    num_edges += get_node_def(n).input_size();
+  }
+  g_->Reserve(node_def_count(), num_edges);
+
   std::vector<InputInfo> inputs;
   int processed = 0;
 
@@ -52,6 +52,12 @@ struct GraphConstructorOptions {
   // If true, GraphConstructor will add attributes with their default
   // value to the Node when they are missing from the NodeDef.
   bool add_default_attributes = true;
+
+  // If true, skips per-node name validation while building the node index.
+  // Only set this for GraphDefs produced by TensorFlow itself (e.g. graphs
+  // round-tripped through Graph::ToGraphDef), where node names are known to
+  // be valid; importing untrusted graphs must keep validation enabled.
+  bool skip_node_name_validation = false;
 };
 extern Status ConvertGraphDefToGraph(const GraphConstructorOptions& opts,
                                      const GraphDef& gdef, Graph* g);
@@ -245,6 +245,25 @@ TEST_F(GraphConstructorTest, InvalidNodeName) {
   ExpectOK("node { name: '.0123' op: 'ABC' }");
 }
 
+TEST_F(GraphConstructorTest, SkipNodeNameValidation) {
+  // A name that would normally be rejected is accepted when the caller opts
+  // out of name validation.
+  Convert("node { name: '_abc' op: 'ABC' }");
+  GraphConstructorOptions opts;
+  opts.skip_node_name_validation = true;
+  TF_EXPECT_OK(ConvertGraphDefToGraph(opts, gdef_, &graph_));
+  EXPECT_TRUE(HasNode("_abc"));
+
+  // Valid graphs still convert identically with validation disabled.
+  Graph graph2(OpRegistry::Global());
+  Convert(
+      "node { name: 'W1' op: 'TestParams' }"
+      "node { name: 'input' op: 'TestInput' }"
+      "node { name: 't1' op: 'TestMul' input: 'W1' input: 'input:1' }");
+  TF_EXPECT_OK(ConvertGraphDefToGraph(opts, gdef_, &graph2));
+  EXPECT_EQ(graph2.num_op_nodes(), 3);
+}
+
 TEST_F(GraphConstructorTest, InvalidSourceNodeName) {
   ExpectError(
       "node { name: 'W1' op: 'TestParams' }"
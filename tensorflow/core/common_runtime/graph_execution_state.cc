@@ -15,16 +15,20 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/graph_execution_state.h"
 
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_join.h"
+#include "tensorflow/core/common_runtime/constant_folding.h"
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
@@ -37,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/framework/graph_def_util.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/versions.pb.h"
@@ -48,6 +53,8 @@ limitations under the License.
 #include "tensorflow/core/graph/validate.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/stringpiece.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
@@ -69,6 +76,18 @@ bool IsCollectiveV2(const string& op) {
          op == "CollectiveBcastRecvV2" || op == "CollectiveBcastSendV2" ||
          op == "ColectiveReduceScatterV2" || op == "ColectiveAllToAllV2";
 }
+
+// Ops that are pure reformattings of a weight tensor. Given constant inputs
+// they produce the same output on every session creation, so their results can
+// be folded into the graph once at load time. The quantize ops are included so
+// that int8 weights are materialized instead of being requantized from fp32 on
+// every first inference.
+bool IsWeightTransformationOp(const string& op) {
+  return op == "Cast" || op == "Transpose" || op == "Reshape" ||
+         op == "ExpandDims" || op == "Squeeze" || op == "QuantizeV2" ||
+         op == "Dequantize" || op == "QuantizeAndDequantizeV2" ||
+         op == "QuantizeAndDequantizeV3" || op == "QuantizeAndDequantizeV4";
+}
 }  // namespace
 
 GraphExecutionState::GraphExecutionState(
@@ -568,16 +587,23 @@ Status GraphExecutionState::PruneGraph(
     }
   }
 
+  // Resolve all tensor connections with a single pass over the graph rather
+  // than one linear scan per connection.
+  std::unordered_map<StringPiece, Node*, StringPieceHasher> name_to_node;
+  if (options.callable_options.tensor_connection_size() > 0) {
+    name_to_node.reserve(graph->num_nodes());
+    for (Node* n : graph->nodes()) {
+      name_to_node[n->name()] = n;
+    }
+  }
   for (const TensorConnection& tensor_connection :
        options.callable_options.tensor_connection()) {
     Node* from_node = nullptr;
     TensorId from_id(ParseTensorName(tensor_connection.from_tensor()));
 
-    for (Node* n : graph->nodes()) {
-      if (n->name() == from_id.first) {
-        from_node = n;
-        break;
-      }
+    auto iter = name_to_node.find(from_id.first);
+    if (iter != name_to_node.end()) {
+      from_node = iter->second;
     }
     if (from_node == nullptr) {
       return errors::InvalidArgument(
@@ -688,6 +714,16 @@ Status GraphExecutionState::OptimizeGraph(
       item.fetch.push_back(tensor_connection.from_tensor());
     }
 
+    // Feeds with a stable observed value are baked into the graph as
+    // constants below, so they must not be treated as unknown inputs.
+    std::unordered_map<string, const Tensor*> stable_feeds;
+    for (const auto& stable_feed : options.stable_feed_values) {
+      SafeTensorId id(ParseTensorName(stable_feed.first));
+      if (id.index() == 0) {
+        stable_feeds.emplace(id.node(), &stable_feed.second);
+      }
+    }
+
     // Add feeds to the GrapplerItem if we know them.
     absl::flat_hash_set<absl::string_view> node_names;
     if (!(options.callable_options.feed().empty() &&
@@ -695,7 +731,11 @@ Status GraphExecutionState::OptimizeGraph(
       std::vector<SafeTensorId> feeds;
 
       for (const string& feed : options.callable_options.feed()) {
-        feeds.emplace_back(ParseTensorName(feed));
+        SafeTensorId id(ParseTensorName(feed));
+        if (id.index() == 0 && stable_feeds.count(id.node()) > 0) {
+          continue;
+        }
+        feeds.push_back(std::move(id));
       }
       for (const TensorConnection& tensor_connection :
            options.callable_options.tensor_connection()) {
@@ -795,6 +835,35 @@ Status GraphExecutionState::OptimizeGraph(
 
     // Convert Graph to GraphDef and add it to the GrapplerItem.
     graph.ToGraphDef(&item.graph);
+
+    // Bake stable feed values into the graph as constants, so that Grappler
+    // can propagate them and eliminate branches that are dead under the
+    // observed value. The node is added to `keep_ops` so the feed rewrite in
+    // the subsequent graph pruning still finds it.
+    for (NodeDef& node : *item.graph.mutable_node()) {
+      auto it = stable_feeds.find(node.name());
+      if (it == stable_feeds.end()) continue;
+      const AttrValue* dtype_attr = AttrSlice(node).Find("dtype");
+      if (dtype_attr != nullptr && dtype_attr->type() != it->second->dtype()) {
+        // The fed value does not match the node's declared type; leave the
+        // feed to the normal run-time handling, which will surface the error.
+        continue;
+      }
+      NodeDef const_node;
+      const_node.set_name(node.name());
+      const_node.set_op("Const");
+      const_node.set_device(node.device());
+      for (const string& input : node.input()) {
+        // Only control inputs can be preserved on a constant.
+        if (absl::StartsWith(input, "^")) const_node.add_input(input);
+      }
+      AddNodeAttr("dtype", it->second->dtype(), &const_node);
+      TensorProto value;
+      it->second->AsProtoTensorContent(&value);
+      AddNodeAttr("value", value, &const_node);
+      node = std::move(const_node);
+      item.keep_ops.push_back(node.name());
+    }
     // TODO(b/114748242): Add a unit test to test this bug fix.
     if (flib_def) {
       *item.graph.mutable_library() = flib_def->ToProto();
@@ -849,6 +918,32 @@ Status GraphExecutionState::OptimizeGraph(
     for (Node* node : optimized_graph->get()->nodes()) {
       node->set_assigned_device_name(node->requested_device());
     }
+
+    // Fold weight-transformation chains once at load time. Published models
+    // often carry fp32 weights plus Cast/Transpose/Reshape/quantize chains
+    // that are pure functions of constants. Grappler's constant folding skips
+    // results above its size limit, so large transformed weights would
+    // otherwise be recomputed on every session creation. Folding them here
+    // lets the graph reference the transformed buffers directly, and the
+    // original fp32 constants become dead and are removed by the later graph
+    // pruning, reducing both first-inference latency and steady-state memory.
+    if (cpu_device != nullptr) {
+      ConstantFoldingOptions cf_opts;
+      cf_opts.consider = [](const Node* n) {
+        return IsWeightTransformationOp(n->type_string());
+      };
+      // Weights are routinely larger than the default folding limit; the
+      // folded constant replaces the chain rather than duplicating it.
+      cf_opts.max_constant_size_in_bytes = std::numeric_limits<int64_t>::max();
+      bool was_mutated;
+      ConstantFold(cf_opts, /*function_library=*/nullptr,
+                   session_options_->env, cpu_device, optimized_graph->get(),
+                   &was_mutated)
+          .IgnoreError();
+      if (was_mutated) {
+        VLOG(2) << "Folded weight transformations at graph load time";
+      }
+    }
     return OkStatus();
   } else {
     return errors::InvalidArgument("Meta Optimizer disabled");
@@ -0,0 +1,471 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_ring_reducer.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/collective_rma_local.h"
+#include "tensorflow/core/common_runtime/collective_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/dma_helper.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+
+namespace tensorflow {
+
+namespace {
+// Key to be used for BufRendezvous by HierarchicalRingReducer.  `phase` is
+// "lr" (local reduce), "rs" (reduce-scatter), "ag" (allgather) or "bc"
+// (local broadcast); `src_rank` and `dst_rank` are group ranks.
+string HierRingBufKey(const string& exec_key, const char* phase, int step,
+                      int src_rank, int dst_rank) {
+  // TODO(b/78352018): Try a denser format, e.g. a 64 or 128 bit hash.
+  return strings::StrCat(exec_key, ":", phase, ":", step, ":", src_rank, ":",
+                         dst_rank);
+}
+
+// Counts the devices in each task.  Precondition: group members must be
+// sorted so that all devices in the same task are adjacent.
+std::vector<int> DevPerTask(const CollGroupParams& group) {
+  std::vector<int> dev_per_task;
+  const string* prior_task_name = &group.members[0].task;
+  int dev_count = 1;
+  for (int di = 1; di < group.group_size; ++di) {
+    if (group.members[di].task != *prior_task_name) {
+      dev_per_task.push_back(dev_count);
+      dev_count = 1;
+      prior_task_name = &group.members[di].task;
+    } else {
+      ++dev_count;
+    }
+  }
+  dev_per_task.push_back(dev_count);
+  return dev_per_task;
+}
+}  // namespace
+
+HierarchicalRingReducer::HierarchicalRingReducer()
+    : col_ctx_(nullptr),
+      col_params_(nullptr),
+      done_(nullptr),
+      group_size_(-1),
+      num_tasks_(-1),
+      my_task_(-1),
+      local_rank_(-1) {}
+
+Status HierarchicalRingReducer::InitializeCollectiveParams(
+    CollectiveParams* col_params) {
+  // TODO(b/113171733): change CHECKs to return errors.
+  CHECK_EQ(col_params->instance.type, REDUCTION_COLLECTIVE);
+  CHECK_EQ(col_params->instance.impl_details.collective_name,
+           "HierarchicalRingReduce");
+  if (col_params->group.device_type != DEVICE_CPU) {
+    return errors::InvalidArgument(
+        "HierarchicalRingReduce is only supported for CPU device groups but "
+        "group device type is ",
+        col_params->group.device_type.type_string());
+  }
+  // Run() identifies task leaders by position, which requires members to be
+  // sorted so that all devices in the same task are adjacent.
+  std::vector<int> dev_per_task = DevPerTask(col_params->group);
+  CHECK_EQ(col_params->group.num_tasks, dev_per_task.size());
+  return OkStatus();
+}
+
+Status HierarchicalRingReducer::InitializeCollectiveContext(
+    std::shared_ptr<CollectiveContext> col_ctx) {
+  CHECK(col_ctx->dev_mgr);
+  col_ctx_ = col_ctx;
+  col_params_ = col_ctx->col_params.get();
+  return collective_util::InitializeDeviceAndLocality(
+      col_ctx->dev_mgr, col_ctx->device_name, &col_ctx->device,
+      &col_ctx->device_locality);
+}
+
+int HierarchicalRingReducer::TaskLeaderRank(int task) const {
+  int rank = 0;
+  for (int ti = 0; ti < task; ++ti) rank += dev_per_task_[ti];
+  return rank;
+}
+
+void HierarchicalRingReducer::Run(StatusCallback done) {
+  CHECK(col_ctx_);
+  CHECK(col_params_);
+  // Since `HierarchicalRingReducer` doesn't require non-overlapping
+  // collectives, unblock any collective that is blocked on this instance.
+  col_ctx_->col_exec->UnblockDependencies(*col_params_);
+
+  done_ = std::move(done);
+  group_size_ = col_params_->group.group_size;
+  num_tasks_ = col_params_->group.num_tasks;
+  dev_per_task_ = DevPerTask(col_params_->group);
+
+  int task_lo = 0;
+  my_task_ = -1;
+  for (int ti = 0; ti < num_tasks_; ++ti) {
+    if (col_params_->default_rank < task_lo + dev_per_task_[ti]) {
+      my_task_ = ti;
+      break;
+    }
+    task_lo += dev_per_task_[ti];
+  }
+  CHECK_GE(my_task_, 0) << "Unexpected device rank "
+                        << col_params_->default_rank << " for " << group_size_
+                        << " devices";
+  local_rank_ = col_params_->default_rank - task_lo;
+
+  VLOG(1) << "HierarchicalRingReducer::Run for device "
+          << col_ctx_->device_name << " default_rank "
+          << col_params_->default_rank << " task " << my_task_
+          << " local_rank " << local_rank_;
+
+  // Start by copying input to output if they're not already the same, i.e. if
+  // we're not computing in-place on the input tensor.
+  if ((col_ctx_->input != col_ctx_->output) &&
+      (DMAHelper::base(col_ctx_->input) != DMAHelper::base(col_ctx_->output))) {
+    // We are running in a blockable thread and the callback can't block so
+    // just wait here on the copy.
+    Notification note;
+    Status status;
+    profiler::TraceMe activity("MemCpyAsync", profiler::TraceMeLevel::kInfo);
+    CollectiveRemoteAccessLocal::MemCpyAsync(
+        col_ctx_->op_ctx->op_device_context(),
+        col_ctx_->op_ctx->op_device_context(), col_ctx_->device,
+        col_ctx_->device, col_ctx_->op_ctx->input_alloc_attr(0),
+        col_ctx_->op_ctx->output_alloc_attr(0), col_ctx_->input,
+        col_ctx_->output, 0 /*dev_to_dev_stream_index*/,
+        [&note, &status](const Status& s) {
+          status.Update(s);
+          note.Notify();
+        });
+    note.WaitForNotification();
+    if (!status.ok()) {
+      done_(status);
+      return;
+    }
+  }
+
+  ReduceToTaskLeader();
+  if (local_rank_ == 0) RunLeaderRing();
+  BroadcastFromTaskLeader();
+
+  Status s;
+  {
+    mutex_lock l(status_mu_);
+    s = status_;
+  }
+  VLOG(2) << "device=" << col_ctx_->device_name << " return status " << s;
+  done_(s);
+}
+
+// Note that this function is blocking and must not run in any thread
+// which cannot be blocked.
+void HierarchicalRingReducer::ReduceToTaskLeader() {
+  const int local_size = dev_per_task_[my_task_];
+  if (local_size == 1) return;
+  profiler::TraceMe activity("ReduceToTaskLeader",
+                             profiler::TraceMeLevel::kInfo);
+  const int leader_rank = TaskLeaderRank(my_task_);
+  if (local_rank_ != 0) {
+    // Send this device's contribution to the task leader.  Wait until the
+    // leader has consumed the buffer since it is reused to receive the final
+    // value in BroadcastFromTaskLeader.
+    Notification note;
+    Status send_status;
+    DispatchSend(HierRingBufKey(col_ctx_->exec_key, "lr", 0,
+                                col_params_->default_rank, leader_rank),
+                 leader_rank, col_ctx_->output,
+                 [&note, &send_status](const Status& s) {
+                   send_status = s;
+                   note.Notify();
+                 });
+    note.WaitForNotification();
+    if (!send_status.ok()) StartAbort(send_status);
+    return;
+  }
+  // Leader: receive the contribution of every other local device
+  // concurrently, then merge them into the output in rank order so the
+  // result is deterministic.
+  AllocatorAttributes attr = col_ctx_->op_ctx->output_alloc_attr(0);
+  std::vector<Tensor> tmp;
+  tmp.reserve(local_size - 1);
+  for (int li = 1; li < local_size; ++li) {
+    tmp.push_back(Tensor(col_ctx_->device->GetAllocator(attr),
+                         col_ctx_->output->dtype(),
+                         col_ctx_->output->shape()));
+  }
+  mutex mu;
+  condition_variable all_done;
+  int pending = local_size - 1;  // TF_GUARDED_BY(mu)
+  Status recv_status;            // TF_GUARDED_BY(mu)
+  for (int li = 1; li < local_size; ++li) {
+    DispatchRecv(HierRingBufKey(col_ctx_->exec_key, "lr", 0, leader_rank + li,
+                                leader_rank),
+                 leader_rank + li, &tmp[li - 1],
+                 [&mu, &all_done, &pending, &recv_status](const Status& s) {
+                   mutex_lock l(mu);
+                   recv_status.Update(s);
+                   if (--pending == 0) all_done.notify_all();
+                 });
+  }
+  {
+    mutex_lock l(mu);
+    while (pending > 0) all_done.wait(l);
+    if (!recv_status.ok()) {
+      StartAbort(recv_status);
+      return;
+    }
+  }
+  for (int li = 1; li < local_size; ++li) {
+    Status s = collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->merge_op, col_ctx_->output, &tmp[li - 1]);
+    if (!s.ok()) {
+      StartAbort(s);
+      return;
+    }
+  }
+}
+
+// Note that this function is blocking and must not run in any thread
+// which cannot be blocked.
+void HierarchicalRingReducer::RunLeaderRing() {
+  {
+    mutex_lock l(status_mu_);
+    if (!status_.ok()) return;
+  }
+  profiler::TraceMe activity("LeaderRing", profiler::TraceMeLevel::kInfo);
+  AllocatorAttributes attr = col_ctx_->op_ctx->output_alloc_attr(0);
+  ca_.reset(MakeCollectiveAdapter(col_ctx_->output, num_tasks_,
+                                  col_ctx_->device->GetAllocator(attr)));
+  const int send_to = TaskLeaderRank((my_task_ + 1) % num_tasks_);
+  const int recv_from =
+      TaskLeaderRank((my_task_ + num_tasks_ - 1) % num_tasks_);
+  bool ok = true;
+
+  // Runs one ring step: concurrently send `send_t` to the next leader and
+  // receive from the previous leader into `recv_t`, then wait for both.
+  // Returns false after starting an abort if either transfer failed.
+  auto ring_step = [this, send_to, recv_from](const char* phase, int step,
+                                              Tensor* send_t, Tensor* recv_t) {
+    Notification send_note;
+    Notification recv_note;
+    Status send_status;
+    Status recv_status;
+    DispatchSend(HierRingBufKey(col_ctx_->exec_key, phase, step,
+                                col_params_->default_rank, send_to),
+                 send_to, send_t, [&send_note, &send_status](const Status& s) {
+                   send_status = s;
+                   send_note.Notify();
+                 });
+    DispatchRecv(HierRingBufKey(col_ctx_->exec_key, phase, step, recv_from,
+                                col_params_->default_rank),
+                 recv_from, recv_t,
+                 [&recv_note, &recv_status](const Status& s) {
+                   recv_status = s;
+                   recv_note.Notify();
+                 });
+    send_note.WaitForNotification();
+    recv_note.WaitForNotification();
+    if (!send_status.ok()) {
+      StartAbort(send_status);
+      return false;
+    }
+    if (!recv_status.ok()) {
+      StartAbort(recv_status);
+      return false;
+    }
+    return true;
+  };
+
+  // Reduce-scatter: at step s each leader passes chunk (my_task_ - s) mod
+  // num_tasks_ around the ring and merges the incoming chunk, so after
+  // num_tasks_ - 1 steps chunk (my_task_ + 1) mod num_tasks_ holds the fully
+  // reduced value on this leader.
+  for (int s = 0; ok && s < num_tasks_ - 1; ++s) {
+    const int send_chunk = (my_task_ - s + num_tasks_) % num_tasks_;
+    const int recv_chunk = (my_task_ - s - 1 + num_tasks_) % num_tasks_;
+    Tensor send_t = ca_->ChunkAlias(send_chunk);
+    Tensor recv_t = ca_->TempChunk(recv_chunk);
+    ok = ring_step("rs", s, &send_t, &recv_t);
+    if (!ok) break;
+    Tensor dst = ca_->ChunkAlias(recv_chunk);
+    Status status = collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->merge_op, &dst, &recv_t);
+    if (!status.ok()) {
+      StartAbort(status);
+      ok = false;
+    }
+  }
+
+  // Each element must pass through final_op exactly once, so apply it here
+  // to the one chunk this leader has fully reduced; the allgather below then
+  // distributes finalized values only.
+  if (ok && col_params_->final_op) {
+    Tensor group_size_val = ca_->Scalar(group_size_);
+    Tensor dst = ca_->ChunkAlias((my_task_ + 1) % num_tasks_);
+    Status status = collective_util::ComputeBinOp(
+        col_ctx_->op_ctx, col_ctx_->op_params, col_ctx_->device,
+        col_params_->final_op, &dst, &group_size_val);
+    if (!status.ok()) {
+      StartAbort(status);
+      ok = false;
+    }
+  }
+
+  // Allgather: circulate each fully reduced chunk around the ring, receiving
+  // directly into the output alias since no merge is needed.
+  for (int s = 0; ok && s < num_tasks_ - 1; ++s) {
+    const int send_chunk = (my_task_ + 1 - s + num_tasks_) % num_tasks_;
+    const int recv_chunk = (my_task_ - s + num_tasks_) % num_tasks_;
+    Tensor send_t = ca_->ChunkAlias(send_chunk);
+    Tensor recv_t = ca_->ChunkAlias(recv_chunk);
+    ok = ring_step("ag", s, &send_t, &recv_t);
+  }
+
+  if (ok) {
+    // Recover the output from the adaptor.
+    ca_->ConsumeFinalValue(col_ctx_->output);
+  }
+  ca_.reset();
+}
+
+// Note that this function is blocking and must not run in any thread
+// which cannot be blocked.
+void HierarchicalRingReducer::BroadcastFromTaskLeader() {
+  {
+    mutex_lock l(status_mu_);
+    if (!status_.ok()) return;
+  }
+  const int local_size = dev_per_task_[my_task_];
+  if (local_size == 1) return;
+  profiler::TraceMe activity("BroadcastFromTaskLeader",
+                             profiler::TraceMeLevel::kInfo);
+  const int leader_rank = TaskLeaderRank(my_task_);
+  if (local_rank_ == 0) {
+    mutex mu;
+    condition_variable all_done;
+    int pending = local_size - 1;  // TF_GUARDED_BY(mu)
+    Status send_status;            // TF_GUARDED_BY(mu)
+    for (int li = 1; li < local_size; ++li) {
+      DispatchSend(HierRingBufKey(col_ctx_->exec_key, "bc", 0, leader_rank,
+                                  leader_rank + li),
+                   leader_rank + li, col_ctx_->output,
+                   [&mu, &all_done, &pending, &send_status](const Status& s) {
+                     mutex_lock l(mu);
+                     send_status.Update(s);
+                     if (--pending == 0) all_done.notify_all();
+                   });
+    }
+    mutex_lock l(mu);
+    while (pending > 0) all_done.wait(l);
+    if (!send_status.ok()) StartAbort(send_status);
+  } else {
+    Notification note;
+    Status recv_status;
+    DispatchRecv(HierRingBufKey(col_ctx_->exec_key, "bc", 0, leader_rank,
+                                col_params_->default_rank),
+                 leader_rank, col_ctx_->output,
+                 [&note, &recv_status](const Status& s) {
+                   recv_status = s;
+                   note.Notify();
+                 });
+    note.WaitForNotification();
+    if (!recv_status.ok()) StartAbort(recv_status);
+  }
+}
+
+void HierarchicalRingReducer::DispatchSend(const string& key, int dst_rank,
+                                           const Tensor* src_tensor,
+                                           const StatusCallback& done) {
+  profiler::ScopedMemoryDebugAnnotation op_annotation(
+      col_params_->name.data(), col_ctx_->step_id, "dynamic",
+      src_tensor->dtype(),
+      [src_tensor]() { return src_tensor->shape().DebugString(); });
+  VLOG(3) << "DispatchSend " << key << " from_device " << col_ctx_->device_name
+          << " to_device "
+          << col_params_->group.members[dst_rank].device.name();
+  col_ctx_->col_exec->remote_access()->PostToPeer(
+      col_params_->group.members[dst_rank].device.name(),
+      col_params_->group.members[dst_rank].task, key, col_ctx_->device,
+      col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), src_tensor,
+      col_ctx_->device_locality, col_ctx_->op_ctx->cancellation_manager(),
+      done);
+}
+
+void HierarchicalRingReducer::DispatchRecv(const string& key, int src_rank,
+                                           Tensor* dst_tensor,
+                                           const StatusCallback& done) {
+  VLOG(3) << "DispatchRecv " << key << " from_device "
+          << col_params_->group.members[src_rank].device.name()
+          << " to_device " << col_ctx_->device_name;
+  col_ctx_->col_exec->remote_access()->RecvFromPeer(
+      col_params_->group.members[src_rank].device.name(),
+      col_params_->group.members[src_rank].task,
+      col_params_->group.members[src_rank].is_local, key, col_ctx_->device,
+      col_ctx_->op_ctx->op_device_context(),
+      col_ctx_->op_ctx->output_alloc_attr(0), dst_tensor,
+      col_ctx_->device_locality, 0 /*dev_to_dev_stream_index*/,
+      col_ctx_->op_ctx->cancellation_manager(), done);
+}
+
+void HierarchicalRingReducer::StartAbort(const Status& s) {
+  // In abort mode we stop issuing additional data movement, but we need to
+  // wait for all of the outstanding callbacks to be invoked before quitting.
+  bool abort_started = false;
+  {
+    mutex_lock l(status_mu_);
+    if (status_.ok()) {
+      LOG(ERROR) << "Aborting HierarchicalRingReduce with " << s;
+      abort_started = true;
+      status_.Update(s);
+    }
+  }
+  // If this is the initial entry to abort mode and it's not a cancellation,
+  // then invoke StartAbort on the CollectiveExecutor that invoked us.  That
+  // should start cancellation on all of the outstanding CollectiveRemoteAccess
+  // actions. If it's cancellation all pending send/recv should be cancelled as
+  // well and there's then no need to abort.
+  if (abort_started) {
+    if (col_ctx_->op_ctx->cancellation_manager() == nullptr ||
+        (!col_ctx_->op_ctx->cancellation_manager()->IsCancelled() &&
+         !col_ctx_->op_ctx->cancellation_manager()->IsCancelling())) {
+      col_ctx_->col_exec->StartAbort(s);
+    }
+  }
+}
+
+namespace {
+REGISTER_COLLECTIVE(HierarchicalRingReduce, HierarchicalRingReducer);
+}  // namespace
+
+}  // namespace tensorflow
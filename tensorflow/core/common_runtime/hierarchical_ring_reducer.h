@@ -0,0 +1,109 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_RING_REDUCER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_RING_REDUCER_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/base_collective_executor.h"
+#include "tensorflow/core/framework/collective.h"
+
+namespace tensorflow {
+
+// Hierarchical, topology-aware implementation of collective reduction for
+// CPU devices.  Unlike RingReduce, which runs a single flat ring over all
+// group members, this implementation exploits the fact that devices on the
+// same task exchange data through local memory while cross-task hops go over
+// the network.  It reduces in three phases:
+//
+//  1. Intra-task: every device on a task merges its value into the task
+//     leader (the lowest-ranked device on the task) via local copies.
+//  2. Inter-task: the task leaders run a chunked ring over the network,
+//     i.e. a reduce-scatter of num_tasks chunks followed by an allgather,
+//     so each leader sends each byte of the tensor at most twice regardless
+//     of group size.  The send and recv of each ring step are issued
+//     concurrently to pipeline both directions of the link.
+//  3. Intra-task: each leader copies the final value back to the other
+//     devices on its task.
+//
+// Selected by setting communication_hint to "hierarchical_ring" on a
+// multi-task CPU group.
+class HierarchicalRingReducer : public CollectiveImplementationInterface {
+ public:
+  HierarchicalRingReducer();
+  ~HierarchicalRingReducer() override = default;
+
+  // Validates that the param resolver has produced a group this
+  // implementation can handle: a REDUCTION_COLLECTIVE on CPU devices with
+  // group members sorted so that all devices of a task are adjacent.
+  Status InitializeCollectiveParams(CollectiveParams* col_params) override;
+
+  // Initializes members of CollectiveContext not yet initialized, i.e. device
+  // and device_locality.  Also saves the CollectiveContext in this object.
+  Status InitializeCollectiveContext(
+      std::shared_ptr<CollectiveContext> col_ctx) override;
+
+  // Begins async execution of the hierarchical ring reduce.
+  // Must be called in a blockable thread.
+  void Run(StatusCallback done) override;
+
+ private:
+  // Called when a bad status is received that implies we should terminate
+  // execution and return a bad status.
+  void StartAbort(const Status& s);
+
+  // Returns the group rank of the leader (lowest-ranked device) of `task`.
+  int TaskLeaderRank(int task) const;
+
+  // Phase 1: non-leaders send their value to the task leader; the leader
+  // merges each received value into the output tensor.  Blocking.
+  void ReduceToTaskLeader();
+
+  // Phase 2, leaders only: chunked ring reduce-scatter + allgather across
+  // task leaders, with final_op applied to each fully reduced chunk exactly
+  // once.  Blocking.
+  void RunLeaderRing();
+
+  // Phase 3: the leader sends the final value to the other devices on its
+  // task.  Blocking.
+  void BroadcastFromTaskLeader();
+
+  // Sends `src_tensor` asynchronously from this device to the device at
+  // group rank `dst_rank`.  Calls `done` upon completion.
+  void DispatchSend(const string& key, int dst_rank, const Tensor* src_tensor,
+                    const StatusCallback& done);
+
+  // Receives a tensor into the memory buffer owned by `dst_tensor` at this
+  // device from the device at group rank `src_rank`.  Calls `done` upon
+  // completion.
+  void DispatchRecv(const string& key, int src_rank, Tensor* dst_tensor,
+                    const StatusCallback& done);
+
+  std::shared_ptr<CollectiveContext> col_ctx_;
+  const CollectiveParams* col_params_;  // Not owned
+  StatusCallback done_;
+  std::unique_ptr<CollectiveAdapter> ca_;
+  std::vector<int> dev_per_task_;
+  int group_size_;
+  int num_tasks_;
+  int my_task_;
+  int local_rank_;  // rank of this device within its task
+  mutex status_mu_;
+  Status status_ TF_GUARDED_BY(status_mu_);
+};
+
+}  // namespace tensorflow
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_HIERARCHICAL_RING_REDUCER_H_
@@ -0,0 +1,229 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/hierarchical_ring_reducer.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "tensorflow/core/common_runtime/collective_test_util.h"
+#include "tensorflow/core/common_runtime/device.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/process_util.h"
+#include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+std::unique_ptr<OpKernel> GetKernel(const NodeDef& node,
+                                    const DeviceType& device_type,
+                                    DeviceBase* device) {
+  Status status;
+  std::unique_ptr<OpKernel> k = CreateOpKernel(
+      device_type, device, device->GetAllocator(AllocatorAttributes()), node,
+      TF_GRAPH_DEF_VERSION, &status);
+  if (!status.ok()) {
+    LOG(FATAL) << status;
+  }
+  return k;
+}
+
+std::unique_ptr<OpKernel> GetAdd(DataType dtype, const DeviceType& device_type,
+                                 DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder("add_node", "Add");
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  return GetKernel(node_def, device_type, device);
+}
+
+std::unique_ptr<OpKernel> GetDiv(DataType dtype, const DeviceType& device_type,
+                                 DeviceBase* device) {
+  NodeDef node_def;
+  NodeDefBuilder builder("div_node", "Div");
+  TF_CHECK_OK(builder.Attr("T", dtype)
+                  .Input(FakeInput(dtype))
+                  .Input(FakeInput(dtype))
+                  .Finalize(&node_def));
+  return GetKernel(node_def, device_type, device);
+}
+
+class HierarchicalRingReducerTest : public ::testing::Test {
+ protected:
+  void Init(int num_workers, int num_devices, DataType dtype,
+            const TensorShape& shape, int fail_after) {
+    test_env_ = CreateCollectiveTestEnv(num_workers, num_devices, DEVICE_CPU);
+    test_env_->remote_access->set_fail_after(fail_after);
+    for (int wi = 0; wi < num_workers; ++wi) {
+      for (int di = 0; di < num_devices; ++di) {
+        int rank = wi * num_devices + di;
+        instances_.push_back(std::make_unique<DeviceInstance>(
+            rank, dtype, shape, test_env_.get()));
+      }
+    }
+  }
+
+  void Reduce(int fail_after) {
+    std::atomic<int> done(0);
+    for (auto& di : instances_) {
+      SchedClosure([&di, &done] {
+        di->DoReduce();
+        ++done;
+      });
+      if (fail_after > 0) {
+        // Stagger the op execution starts.
+        Env::Default()->SleepForMicroseconds(100);
+      }
+    }
+    while (done < static_cast<int>(instances_.size())) {
+      Env::Default()->SleepForMicroseconds(1000);
+    }
+  }
+
+  template <typename T>
+  void RunTest(DataType dtype, int num_workers, int num_devices,
+               int tensor_len, int fail_after) {
+    Init(num_workers, num_devices, dtype, TensorShape({tensor_len}),
+         fail_after);
+    std::vector<T> expected(tensor_len);
+    for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+      instances_[di]->InitTensor([&expected, dtype, di](Tensor* t) {
+        for (size_t i = 0; i < t->NumElements(); ++i) {
+          // The cast is necessary to prevent clang-tidy from insisting
+          // that a faster non-open source function be substituted.
+          float value = pow(10, static_cast<double>(di)) * i;
+          if (dtype == DT_INT32 || dtype == DT_INT64) {
+            value = di * 10 + i;
+          }
+          t->flat<T>()(i) = static_cast<T>(value);
+          expected[i] += static_cast<T>(value);
+        }
+      });
+    }
+    Reduce(fail_after);
+    if (fail_after > 0) {
+      // Confirm that every device terminated with the expected error status.
+      for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+        EXPECT_NE(instances_[di]->status_.message().find("Deliberate failure"),
+                  string::npos);
+      }
+    } else {
+      // Confirm that every device computed the same correct reduction value.
+      for (int i = 0; i < tensor_len; ++i) {
+        expected[i] /= static_cast<T>(num_workers * num_devices);
+      }
+      for (int di = 0; di < static_cast<int>(instances_.size()); ++di) {
+        TF_EXPECT_OK(instances_[di]->status_);
+        test::ExpectTensorEqual<T>(test::AsTensor<T>(expected),
+                                   instances_[di]->tensor());
+      }
+    }
+  }
+
+  class DeviceInstance {
+   public:
+    DeviceInstance(int rank, DataType dtype, const TensorShape& shape,
+                   CollectiveTestEnv* test_env)
+        : test_env_(test_env), tensor_(dtype, shape) {
+      col_params_ =
+          CreateCollectiveParams(*test_env_, rank, "HierarchicalRingReduce",
+                                 REDUCTION_COLLECTIVE, dtype, shape);
+      string dev_name = col_params_->group.members[rank].device.name();
+      TF_CHECK_OK(test_env_->device_mgr->LookupDevice(dev_name, &device_))
+          << "Couldn't find device " << dev_name
+          << " existing devices: " << test_env_->device_mgr->DebugString();
+      merge_op_ = GetAdd(col_params_->instance.data_type,
+                         test_env_->device_type, device_);
+      final_op_ = GetDiv(col_params_->instance.data_type,
+                         test_env_->device_type, device_);
+      col_params_->merge_op = merge_op_.get();
+      col_params_->final_op = final_op_.get();
+    }
+
+    void InitTensor(const std::function<void(Tensor*)>& init_f) {
+      init_f(&tensor_);
+    }
+
+    void DoReduce() {
+      status_ = RunCollective(test_env_, col_params_.get(), device_, &tensor_,
+                              &tensor_);
+    }
+
+    const Tensor& tensor() { return tensor_; }
+
+    CollectiveTestEnv* test_env_;
+    Tensor tensor_;
+    Device* device_;
+    core::RefCountPtr<CollectiveParams> col_params_;
+    std::unique_ptr<OpKernel> merge_op_;
+    std::unique_ptr<OpKernel> final_op_;
+    Status status_;
+  };
+
+  std::unique_ptr<CollectiveTestEnv> test_env_;
+  std::vector<std::unique_ptr<DeviceInstance>> instances_;
+};
+
+// TODO(b/113171733): change to use TEST_P.
+#define DEF_TEST(B, W, D, L, A)                                    \
+  TEST_F(HierarchicalRingReducerTest,                              \
+         DaTy##B##_Wkr##W##_Dev##D##_Len##L##_Abrt##A) {           \
+    DataType dtype = DT_##B;                                       \
+    switch (dtype) {                                               \
+      case DT_FLOAT: {                                             \
+        RunTest<float>(dtype, W, D, L, A);                         \
+      } break;                                                     \
+      case DT_DOUBLE: {                                            \
+        RunTest<double>(dtype, W, D, L, A);                        \
+      } break;                                                     \
+      case DT_INT32: {                                             \
+        RunTest<int32>(dtype, W, D, L, A);                         \
+      } break;                                                     \
+      case DT_INT64: {                                             \
+        RunTest<int64_t>(dtype, W, D, L, A);                       \
+      } break;                                                     \
+      default:                                                     \
+        LOG(FATAL) << "Unimplemented";                             \
+    }                                                              \
+  }
+
+// Success tests
+DEF_TEST(FLOAT, 1, 2, 1, 0)
+DEF_TEST(FLOAT, 1, 2, 1001, 0)
+DEF_TEST(FLOAT, 2, 1, 128, 0)
+DEF_TEST(FLOAT, 2, 4, 128, 0)
+DEF_TEST(FLOAT, 2, 8, 4095, 0)
+DEF_TEST(FLOAT, 4, 1, 1, 0)  // tensor shorter than the leader ring
+DEF_TEST(FLOAT, 4, 4, 1045991, 0)
+DEF_TEST(DOUBLE, 2, 4, 1001, 0)
+DEF_TEST(INT32, 2, 4, 1001, 0)
+DEF_TEST(INT64, 2, 4, 1001, 0)
+
+// Failure tests
+DEF_TEST(FLOAT, 2, 8, 9408, 1)
+DEF_TEST(FLOAT, 2, 8, 9408, 7)
+
+}  // namespace
+}  // namespace tensorflow
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/immutable_executor_state.h"
 
 #include "absl/memory/memory.h"
+#include "tensorflow/core/framework/device.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def_util.h"
@@ -84,6 +85,11 @@ ImmutableExecutorState::FrameInfo* ImmutableExecutorState::EnsureFrameInfo(
 Status ImmutableExecutorState::Initialize(const Graph& graph) {
   TF_RETURN_IF_ERROR(gview_.Initialize(&graph));
 
+  // Let multi-stream devices assign per-node DeviceContexts; stays empty for
+  // devices that run every node with the same context.
+  TF_RETURN_IF_ERROR(
+      params_.device->FillContextMap(&graph, &device_context_map_));
+
   // Build the information about frames in this subgraph.
   ControlFlowInfo cf_info;
   TF_RETURN_IF_ERROR(BuildControlFlowInfo(&graph, &cf_info));
@@ -33,6 +33,7 @@ limitations under the License.
 
 namespace tensorflow {
 
+class DeviceContext;
 class Graph;
 
 // Represents the state of an executor (graph and control flow information)
@@ -101,6 +102,13 @@ class ImmutableExecutorState {
 
   bool requires_control_flow_support() const { return requires_control_flow_; }
 
+  // Per-node DeviceContexts from `Device::FillContextMap`, indexed by node id.
+  // Empty unless the device assigns different contexts (e.g. GPU streams) to
+  // different nodes. The contexts are owned by the device.
+  const std::vector<DeviceContext*>& device_context_map() const {
+    return device_context_map_;
+  }
+
   // Copies the pending counts for nodes in this graph to the given array.
   //
   // This method provides a more efficient way of initializing
@@ -155,6 +163,9 @@ class ImmutableExecutorState {
   // Shallow copies of the constant tensors used in the graph.
   std::vector<Tensor> const_tensors_;
 
+  // See device_context_map().
+  std::vector<DeviceContext*> device_context_map_;
+
   ImmutableExecutorState(const ImmutableExecutorState&) = delete;
   void operator=(const ImmutableExecutorState&) = delete;
 };
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/lower_functional_ops.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <string>
 
 #include "absl/container/flat_hash_set.h"
@@ -25,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/lower_function_call_op.h"
 #include "tensorflow/core/common_runtime/lower_if_op.h"
 #include "tensorflow/core/common_runtime/lower_while_op.h"
+#include "tensorflow/core/common_runtime/while_loop_invariant_hoisting.h"
 #include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/graph_node_util.h"
@@ -90,6 +93,16 @@ const absl::flat_hash_set<std::string>& DevicePropagationOpList() {
   return *op_list;
 }
 
+// Hoisting loop-invariant computations out of lowered while loops is opt-in:
+// hoisted nodes execute even when the loop runs zero iterations.
+bool WhileLoopInvariantHoistingIsEnabled() {
+  static const bool enabled = [] {
+    const char* env = getenv("TF_WHILE_LOOP_INVARIANT_HOISTING");
+    return env != nullptr && strcmp(env, "1") == 0;
+  }();
+  return enabled;
+}
+
 bool IsPropagatableDevice(StringPiece device_string) {
   DeviceNameUtils::ParsedName device;
   return DeviceNameUtils::ParseFullName(device_string, &device) &&
@@ -199,6 +212,13 @@ Status LowerFunctionalOpsPass::Run(
     }
   }
 
+  // At this point lowered While bodies have been inlined, so their frames are
+  // fully materialized and loop-invariant computations can be moved in front
+  // of the loops.
+  if (!functional_control_flow && WhileLoopInvariantHoistingIsEnabled()) {
+    TF_RETURN_IF_ERROR(HoistWhileLoopInvariants(g));
+  }
+
   // Propagates device assignments inside a function call to control flow ops
   // after function call is lowered, bcause If/Case/While node lowering happen
   // before function call lowering,
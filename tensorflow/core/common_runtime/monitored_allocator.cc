@@ -0,0 +1,254 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/monitored_allocator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tensorflow/core/platform/env_time.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+
+namespace tensorflow {
+namespace {
+
+auto* bytes_in_use_gauge = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/allocator/bytes_in_use",
+    "Bytes currently in use, per allocator.", "allocator");
+
+auto* peak_bytes_in_use_gauge = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/allocator/peak_bytes_in_use",
+    "High watermark of bytes in use, per allocator.", "allocator");
+
+auto* fragmentation_permille_gauge = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/allocator/fragmentation_permille",
+    "Free-memory fragmentation (0-1000): the fraction of free memory that is "
+    "not in the largest free block, per allocator.",
+    "allocator");
+
+auto* allocation_failures_counter = monitoring::Counter<1>::New(
+    "/tensorflow/core/allocator/allocation_failures",
+    "Allocation attempts that returned no memory, per allocator.",
+    "allocator");
+
+auto* near_limit_events_counter = monitoring::Counter<1>::New(
+    "/tensorflow/core/allocator/near_limit_events",
+    "Times the waterline crossed the warning fraction of the allocator's "
+    "byte limit, per allocator.",
+    "allocator");
+
+}  // namespace
+
+MonitoredAllocator::MonitoredAllocator(Allocator* wrapped,
+                                       const Options& options)
+    : wrapped_(wrapped),
+      options_(options),
+      bytes_limit_([wrapped]() -> std::optional<int64_t> {
+        std::optional<AllocatorStats> stats = wrapped->GetStats();
+        if (stats) return stats->bytes_limit;
+        return std::nullopt;
+      }()),
+      bytes_in_use_cell_(bytes_in_use_gauge->GetCell(wrapped->Name())),
+      peak_bytes_in_use_cell_(
+          peak_bytes_in_use_gauge->GetCell(wrapped->Name())),
+      fragmentation_permille_cell_(
+          fragmentation_permille_gauge->GetCell(wrapped->Name())),
+      allocation_failures_cell_(
+          allocation_failures_counter->GetCell(wrapped->Name())),
+      near_limit_events_cell_(
+          near_limit_events_counter->GetCell(wrapped->Name())) {
+  if (options_.trace_ring_capacity > 0) {
+    mutex_lock l(mu_);
+    ring_.resize(options_.trace_ring_capacity);
+  }
+}
+
+void* MonitoredAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  void* ptr = wrapped_->AllocateRaw(alignment, num_bytes);
+  if (ptr == nullptr) {
+    RecordEvent(/*is_allocation=*/true, /*failed=*/true, num_bytes);
+    return nullptr;
+  }
+  size_t size = num_bytes;
+  if (wrapped_->TracksAllocationSizes()) {
+    size = wrapped_->AllocatedSize(ptr);
+  } else {
+    mutex_lock l(mu_);
+    sizes_[ptr] = num_bytes;
+  }
+  RecordEvent(/*is_allocation=*/true, /*failed=*/false, size);
+  return ptr;
+}
+
+void* MonitoredAllocator::AllocateRaw(
+    size_t alignment, size_t num_bytes,
+    const AllocationAttributes& allocation_attr) {
+  void* ptr = wrapped_->AllocateRaw(alignment, num_bytes, allocation_attr);
+  if (ptr == nullptr) {
+    RecordEvent(/*is_allocation=*/true, /*failed=*/true, num_bytes);
+    return nullptr;
+  }
+  size_t size = num_bytes;
+  if (wrapped_->TracksAllocationSizes()) {
+    size = wrapped_->AllocatedSize(ptr);
+  } else {
+    mutex_lock l(mu_);
+    sizes_[ptr] = num_bytes;
+  }
+  RecordEvent(/*is_allocation=*/true, /*failed=*/false, size);
+  return ptr;
+}
+
+void MonitoredAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) {
+    wrapped_->DeallocateRaw(ptr);
+    return;
+  }
+  size_t size = 0;
+  if (wrapped_->TracksAllocationSizes()) {
+    // Must be read before the memory is returned.
+    size = wrapped_->AllocatedSize(ptr);
+  } else {
+    mutex_lock l(mu_);
+    auto it = sizes_.find(ptr);
+    if (it != sizes_.end()) {
+      size = it->second;
+      sizes_.erase(it);
+    }
+  }
+  wrapped_->DeallocateRaw(ptr);
+  RecordEvent(/*is_allocation=*/false, /*failed=*/false, size);
+}
+
+void MonitoredAllocator::RecordEvent(bool is_allocation, bool failed,
+                                     size_t size) {
+  mutex_lock l(mu_);
+  if (failed) {
+    ++allocation_failures_;
+    allocation_failures_cell_->IncrementBy(1);
+    const char* op_name =
+        profiler::ScopedMemoryDebugAnnotation::CurrentAnnotation()
+            .pending_op_name;
+    LOG(WARNING) << "Allocator " << wrapped_->Name() << " failed to allocate "
+                 << size << " bytes"
+                 << (op_name != nullptr
+                         ? strings::StrCat(" for op ", op_name)
+                         : string(""))
+                 << " with " << bytes_in_use_ << " bytes in use.";
+  } else if (is_allocation) {
+    bytes_in_use_ += size;
+    if (bytes_in_use_ > peak_bytes_in_use_) {
+      peak_bytes_in_use_ = bytes_in_use_;
+      peak_bytes_in_use_cell_->Set(peak_bytes_in_use_);
+    }
+    bytes_in_use_cell_->Set(bytes_in_use_);
+  } else {
+    bytes_in_use_ -= size;
+    bytes_in_use_cell_->Set(bytes_in_use_);
+  }
+
+  // Near-limit pre-warning: one event per upward crossing of the waterline.
+  if (bytes_limit_ && *bytes_limit_ > 0) {
+    const bool above =
+        bytes_in_use_ >
+        static_cast<int64_t>(options_.warning_waterline * *bytes_limit_);
+    if (above && !above_waterline_) {
+      near_limit_events_cell_->IncrementBy(1);
+      LOG(WARNING) << "Allocator " << wrapped_->Name() << " is above "
+                   << 100 * options_.warning_waterline
+                   << "% of its limit: " << bytes_in_use_ << " of "
+                   << *bytes_limit_ << " bytes in use.";
+    }
+    above_waterline_ = above;
+  }
+
+  AppendTraceEvent(is_allocation, failed, size);
+  MaybeRefreshFragmentation();
+}
+
+void MonitoredAllocator::AppendTraceEvent(bool is_allocation, bool failed,
+                                          size_t num_bytes) {
+  if (ring_.empty()) return;
+  AllocationTraceEvent& event = ring_[num_trace_events_ % ring_.size()];
+  ++num_trace_events_;
+  event.timestamp_us = EnvTime::NowMicros();
+  event.num_bytes = num_bytes;
+  event.is_allocation = is_allocation && !failed;
+  event.failed = failed;
+  event.step_id = 0;
+  event.op_name.clear();
+  const auto& annotation =
+      profiler::ScopedMemoryDebugAnnotation::CurrentAnnotation();
+  if (annotation.pending_op_name != nullptr) {
+    event.op_name = annotation.pending_op_name;
+    event.step_id = annotation.pending_step_id;
+  }
+}
+
+void MonitoredAllocator::MaybeRefreshFragmentation() {
+  if (options_.fragmentation_refresh_interval <= 0) return;
+  if (++events_since_refresh_ < options_.fragmentation_refresh_interval) {
+    return;
+  }
+  events_since_refresh_ = 0;
+  std::optional<AllocatorStats> stats = wrapped_->GetStats();
+  if (!stats) return;
+  int64_t capacity = 0;
+  if (stats->pool_bytes) {
+    capacity = *stats->pool_bytes;
+  } else if (stats->bytes_limit) {
+    capacity = *stats->bytes_limit;
+  }
+  const int64_t free_bytes = capacity - stats->bytes_in_use;
+  if (free_bytes <= 0) return;
+  const double fragmentation =
+      1.0 - static_cast<double>(stats->largest_free_block_bytes) / free_bytes;
+  fragmentation_permille_cell_->Set(
+      std::lround(std::clamp(fragmentation, 0.0, 1.0) * 1000));
+}
+
+std::vector<AllocationTraceEvent> MonitoredAllocator::GetAllocationTrace()
+    const {
+  mutex_lock l(mu_);
+  std::vector<AllocationTraceEvent> trace;
+  if (ring_.empty()) return trace;
+  const int64_t size = static_cast<int64_t>(ring_.size());
+  const int64_t num_retained = std::min(num_trace_events_, size);
+  trace.reserve(num_retained);
+  for (int64_t i = num_trace_events_ - num_retained; i < num_trace_events_;
+       ++i) {
+    trace.push_back(ring_[i % size]);
+  }
+  return trace;
+}
+
+int64_t MonitoredAllocator::bytes_in_use() const {
+  mutex_lock l(mu_);
+  return bytes_in_use_;
+}
+
+int64_t MonitoredAllocator::peak_bytes_in_use() const {
+  mutex_lock l(mu_);
+  return peak_bytes_in_use_;
+}
+
+int64_t MonitoredAllocator::num_allocation_failures() const {
+  mutex_lock l(mu_);
+  return allocation_failures_;
+}
+
+}  // namespace tensorflow
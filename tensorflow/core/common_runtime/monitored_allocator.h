@@ -0,0 +1,154 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_MONITORED_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_MONITORED_ALLOCATOR_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// One entry of the optional allocation trace ring kept by
+// MonitoredAllocator. Op attribution comes from the thread's
+// ScopedMemoryDebugAnnotation when one is active, so OOMs can be traced back
+// to ops without a debug build.
+struct AllocationTraceEvent {
+  int64_t timestamp_us = 0;
+  size_t num_bytes = 0;
+  // False for deallocations and failed allocations.
+  bool is_allocation = false;
+  // True for an allocation attempt that returned nullptr.
+  bool failed = false;
+  string op_name;
+  int64_t step_id = 0;
+};
+
+// Wraps another Allocator (typically a BFCAllocator) and streams its
+// waterline into tensorflow/core/lib/monitoring gauges as allocation events
+// happen, instead of requiring clients to poll GetStats() with the allocator
+// lock held. Exported metrics, labeled with the wrapped allocator's name:
+//
+//   /tensorflow/core/allocator/bytes_in_use         current waterline
+//   /tensorflow/core/allocator/peak_bytes_in_use    high watermark
+//   /tensorflow/core/allocator/fragmentation_permille
+//   /tensorflow/core/allocator/allocation_failures  nullptr returns
+//   /tensorflow/core/allocator/near_limit_events    waterline crossings
+//
+// The failure counter and the near-limit counter (which fires when the
+// waterline crosses `warning_waterline` of the wrapped allocator's byte
+// limit) act as allocation-failure pre-warnings. Fragmentation is the only
+// metric that needs the wrapped allocator's stats lock, so it is recomputed
+// every `fragmentation_refresh_interval` events rather than on each one.
+//
+// Thread-safe, like the wrapped allocator; each event takes one short
+// internal lock.
+class MonitoredAllocator : public Allocator {
+ public:
+  struct Options {
+    // Fraction of the wrapped allocator's byte limit at which near-limit
+    // pre-warnings fire. Ignored if the wrapped allocator has no limit.
+    double warning_waterline = 0.9;
+    // Recompute the fragmentation gauge from GetStats() every this many
+    // allocation events. 0 disables the fragmentation gauge.
+    int64_t fragmentation_refresh_interval = 256;
+    // Capacity of the allocation trace ring. 0 disables tracing.
+    int64_t trace_ring_capacity = 0;
+  };
+
+  // Does not take ownership of `wrapped`, which must outlive this object.
+  MonitoredAllocator(Allocator* wrapped, const Options& options);
+  ~MonitoredAllocator() override = default;
+
+  string Name() override { return wrapped_->Name(); }
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void* AllocateRaw(size_t alignment, size_t num_bytes,
+                    const AllocationAttributes& allocation_attr) override;
+  void DeallocateRaw(void* ptr) override;
+  bool TracksAllocationSizes() const override {
+    return wrapped_->TracksAllocationSizes();
+  }
+  size_t RequestedSize(const void* ptr) const override {
+    return wrapped_->RequestedSize(ptr);
+  }
+  size_t AllocatedSize(const void* ptr) const override {
+    return wrapped_->AllocatedSize(ptr);
+  }
+  int64_t AllocationId(const void* ptr) const override {
+    return wrapped_->AllocationId(ptr);
+  }
+  std::optional<AllocatorStats> GetStats() override {
+    return wrapped_->GetStats();
+  }
+  bool ClearStats() override { return wrapped_->ClearStats(); }
+  AllocatorMemoryType GetMemoryType() const override {
+    return wrapped_->GetMemoryType();
+  }
+
+  // Returns the retained trace events, oldest first. Empty if the trace
+  // ring is disabled.
+  std::vector<AllocationTraceEvent> GetAllocationTrace() const;
+
+  int64_t bytes_in_use() const;
+  int64_t peak_bytes_in_use() const;
+  int64_t num_allocation_failures() const;
+
+ private:
+  // Accounts for one allocation (`ptr` may be null on failure) or
+  // deallocation of `size` bytes and updates the exported metrics.
+  void RecordEvent(bool is_allocation, bool failed, size_t size);
+  void AppendTraceEvent(bool is_allocation, bool failed, size_t num_bytes)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void MaybeRefreshFragmentation() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  Allocator* const wrapped_;
+  const Options options_;
+  // The wrapped allocator's byte limit, read once at construction.
+  const std::optional<int64_t> bytes_limit_;
+
+  // Metric cells for this allocator's name, resolved once at construction.
+  monitoring::GaugeCell<int64_t>* const bytes_in_use_cell_;
+  monitoring::GaugeCell<int64_t>* const peak_bytes_in_use_cell_;
+  monitoring::GaugeCell<int64_t>* const fragmentation_permille_cell_;
+  monitoring::CounterCell* const allocation_failures_cell_;
+  monitoring::CounterCell* const near_limit_events_cell_;
+
+  mutable mutex mu_;
+  int64_t bytes_in_use_ TF_GUARDED_BY(mu_) = 0;
+  int64_t peak_bytes_in_use_ TF_GUARDED_BY(mu_) = 0;
+  int64_t allocation_failures_ TF_GUARDED_BY(mu_) = 0;
+  bool above_waterline_ TF_GUARDED_BY(mu_) = false;
+  int64_t events_since_refresh_ TF_GUARDED_BY(mu_) = 0;
+  // Sizes of live allocations, kept only when the wrapped allocator does not
+  // track allocation sizes itself.
+  std::unordered_map<const void*, size_t> sizes_ TF_GUARDED_BY(mu_);
+  // Circular allocation trace: ring_[i % capacity] holds event number i.
+  std::vector<AllocationTraceEvent> ring_ TF_GUARDED_BY(mu_);
+  int64_t num_trace_events_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_MONITORED_ALLOCATOR_H_
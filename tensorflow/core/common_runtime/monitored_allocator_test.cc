@@ -0,0 +1,83 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/monitored_allocator.h"
+
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(MonitoredAllocatorTest, TracksWaterlineAndPeak) {
+  MonitoredAllocator allocator(cpu_allocator(), MonitoredAllocator::Options());
+  void* p1 = allocator.AllocateRaw(64, 1024);
+  ASSERT_NE(p1, nullptr);
+  void* p2 = allocator.AllocateRaw(64, 2048);
+  ASSERT_NE(p2, nullptr);
+  EXPECT_EQ(3072, allocator.bytes_in_use());
+  EXPECT_EQ(3072, allocator.peak_bytes_in_use());
+
+  allocator.DeallocateRaw(p1);
+  EXPECT_EQ(2048, allocator.bytes_in_use());
+  // The high watermark survives deallocations.
+  EXPECT_EQ(3072, allocator.peak_bytes_in_use());
+
+  allocator.DeallocateRaw(p2);
+  EXPECT_EQ(0, allocator.bytes_in_use());
+  EXPECT_EQ(0, allocator.num_allocation_failures());
+}
+
+TEST(MonitoredAllocatorTest, TraceRingKeepsMostRecentEvents) {
+  MonitoredAllocator::Options options;
+  options.trace_ring_capacity = 4;
+  MonitoredAllocator allocator(cpu_allocator(), options);
+
+  profiler::ScopedMemoryDebugAnnotation annotation("TestOp", /*step_id=*/7);
+  for (int i = 0; i < 3; ++i) {
+    void* ptr = allocator.AllocateRaw(64, 256);
+    ASSERT_NE(ptr, nullptr);
+    allocator.DeallocateRaw(ptr);
+  }
+
+  // Six events were recorded; the ring retains the most recent four, oldest
+  // first, with the op annotation attached.
+  std::vector<AllocationTraceEvent> trace = allocator.GetAllocationTrace();
+  ASSERT_EQ(4, trace.size());
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(i % 2 == 0, trace[i].is_allocation) << "event " << i;
+    EXPECT_FALSE(trace[i].failed);
+    EXPECT_EQ(256, trace[i].num_bytes);
+    EXPECT_EQ("TestOp", trace[i].op_name);
+    EXPECT_EQ(7, trace[i].step_id);
+    if (i > 0) {
+      EXPECT_LE(trace[i - 1].timestamp_us, trace[i].timestamp_us);
+    }
+  }
+}
+
+TEST(MonitoredAllocatorTest, DisabledTraceRingStaysEmpty) {
+  MonitoredAllocator allocator(cpu_allocator(), MonitoredAllocator::Options());
+  void* ptr = allocator.AllocateRaw(64, 256);
+  ASSERT_NE(ptr, nullptr);
+  allocator.DeallocateRaw(ptr);
+  EXPECT_TRUE(allocator.GetAllocationTrace().empty());
+}
+
+}  // namespace
+}  // namespace tensorflow
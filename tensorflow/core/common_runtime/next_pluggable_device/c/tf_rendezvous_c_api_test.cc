@@ -112,6 +112,7 @@ class FakeDeviceManager : public DeviceMgr {
   void ClearContainers(gtl::ArraySlice<string> containers) const override {}
   int NumDeviceType(const string& type) const override { return 0; }
   int NumDevices() const override { return 0; }
+  int64_t DeviceSetVersion() const override { return 1; }
   Device* HostCPU() const override { return nullptr; }
 
  private:
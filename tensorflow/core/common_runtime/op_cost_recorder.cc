@@ -0,0 +1,118 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/op_cost_recorder.h"
+
+#include <cmath>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/profile_utils/cpu_utils.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace {
+
+auto* op_count_counter = monitoring::Counter<1>::New(
+    "/tensorflow/core/executor/op_cost/op_count",
+    "Number of completed kernel invocations, per op type.", "op_type");
+
+auto* wall_nanos_counter = monitoring::Counter<1>::New(
+    "/tensorflow/core/executor/op_cost/wall_nanos",
+    "Cumulative kernel compute wall time in nanoseconds, per op type.",
+    "op_type");
+
+// Pending accumulation for one op type on one thread. The metric cells are
+// resolved on first touch so a flush is just two IncrementBy calls per entry.
+struct PendingCost {
+  monitoring::CounterCell* count_cell = nullptr;
+  monitoring::CounterCell* nanos_cell = nullptr;
+  uint64 pending_cycles = 0;
+  int64_t pending_count = 0;
+};
+
+struct ThreadBuffer {
+  absl::flat_hash_map<std::string, PendingCost> costs;
+  int64_t events_since_flush = 0;
+
+  void Flush() {
+    // Cycle counts are converted to nanoseconds only here, off the hot path.
+    static const double nanos_per_cycle =
+        profile_utils::CpuUtils::GetMicroSecPerClock() * 1000.0;
+    for (auto& entry : costs) {
+      PendingCost& cost = entry.second;
+      if (cost.pending_count == 0) continue;
+      cost.count_cell->IncrementBy(cost.pending_count);
+      cost.nanos_cell->IncrementBy(static_cast<int64_t>(
+          std::llround(cost.pending_cycles * nanos_per_cycle)));
+      cost.pending_cycles = 0;
+      cost.pending_count = 0;
+    }
+    events_since_flush = 0;
+  }
+
+  ~ThreadBuffer() { Flush(); }
+};
+
+ThreadBuffer* GetThreadBuffer() {
+  static thread_local ThreadBuffer buffer;
+  return &buffer;
+}
+
+}  // namespace
+
+OpCostRecorder* OpCostRecorder::Global() {
+  static OpCostRecorder* recorder = []() -> OpCostRecorder* {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_EXECUTOR_OP_COST_RECORDING",
+                                  /*default_val=*/false, &enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << s.message();
+    }
+    return enabled ? new OpCostRecorder() : nullptr;
+  }();
+  return recorder;
+}
+
+void OpCostRecorder::RecordOpCost(absl::string_view op_type, uint64 cycles) {
+  ThreadBuffer* buffer = GetThreadBuffer();
+  auto it = buffer->costs.find(op_type);
+  if (it == buffer->costs.end()) {
+    const std::string key(op_type);
+    PendingCost cost;
+    cost.count_cell = op_count_counter->GetCell(key);
+    cost.nanos_cell = wall_nanos_counter->GetCell(key);
+    it = buffer->costs.emplace(key, cost).first;
+  }
+  it->second.pending_cycles += cycles;
+  ++it->second.pending_count;
+  if (++buffer->events_since_flush >= kFlushIntervalEvents) {
+    buffer->Flush();
+  }
+}
+
+void OpCostRecorder::Flush() { GetThreadBuffer()->Flush(); }
+
+int64_t OpCostRecorder::TotalOpCount(const std::string& op_type) {
+  return op_count_counter->GetCell(op_type)->value();
+}
+
+int64_t OpCostRecorder::TotalWallNanos(const std::string& op_type) {
+  return wall_nanos_counter->GetCell(op_type)->value();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,73 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_OP_COST_RECORDER_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_OP_COST_RECORDER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Aggregates per-op-type compute cost measured by the executor and exports it
+// through tensorflow/core/lib/monitoring, so op-level cost can be compared
+// between model revisions in production without collecting a profiler trace.
+// Exported metrics, labeled with the op type:
+//
+//   /tensorflow/core/executor/op_cost/op_count    completed invocations
+//   /tensorflow/core/executor/op_cost/wall_nanos  cumulative compute time
+//
+// RecordOpCost only bumps an entry in a thread-local table; the table is
+// folded into the exported counters every kFlushIntervalEvents events and when
+// the thread exits, so the per-node overhead stays well under a microsecond
+// and no lock is taken on the hot path.
+//
+// Recording is opt-in: Global() returns nullptr unless the
+// TF_EXECUTOR_OP_COST_RECORDING environment variable is set to true, and the
+// executor skips the cycle counter reads entirely in that case.
+class OpCostRecorder {
+ public:
+  // Number of recorded events after which a thread's pending accumulation is
+  // folded into the exported counters.
+  static constexpr int64_t kFlushIntervalEvents = 256;
+
+  // Returns the process-wide recorder, or nullptr when recording is disabled.
+  static OpCostRecorder* Global();
+
+  // Visible so tests do not have to set the environment variable. All
+  // instances feed the same exported metric streams.
+  OpCostRecorder() = default;
+
+  // Credits `cycles` CPU cycles (as returned by CpuUtils::GetCurrentClockCycle)
+  // of compute time to `op_type`. Thread-safe.
+  void RecordOpCost(absl::string_view op_type, uint64 cycles);
+
+  // Folds the calling thread's pending accumulation into the exported
+  // counters. Called automatically every kFlushIntervalEvents events and on
+  // thread exit; exposed for tests and for flushing at shutdown.
+  void Flush();
+
+  // Cumulative exported values for `op_type`, across all threads and
+  // recorder instances.
+  static int64_t TotalOpCount(const std::string& op_type);
+  static int64_t TotalWallNanos(const std::string& op_type);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_OP_COST_RECORDER_H_
@@ -0,0 +1,67 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/op_cost_recorder.h"
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+TEST(OpCostRecorderTest, FlushFoldsPendingCostsIntoCounters) {
+  OpCostRecorder recorder;
+  const std::string op_type = "FlushTestOp";
+  const int64_t count_before = OpCostRecorder::TotalOpCount(op_type);
+  const int64_t nanos_before = OpCostRecorder::TotalWallNanos(op_type);
+
+  for (int i = 0; i < 3; ++i) {
+    recorder.RecordOpCost(op_type, /*cycles=*/100000);
+  }
+  // Pending costs are thread-local until flushed.
+  EXPECT_EQ(count_before, OpCostRecorder::TotalOpCount(op_type));
+
+  recorder.Flush();
+  EXPECT_EQ(count_before + 3, OpCostRecorder::TotalOpCount(op_type));
+  EXPECT_GT(OpCostRecorder::TotalWallNanos(op_type), nanos_before);
+}
+
+TEST(OpCostRecorderTest, AutoFlushesAfterIntervalEvents) {
+  OpCostRecorder recorder;
+  const std::string op_type = "AutoFlushTestOp";
+  const int64_t count_before = OpCostRecorder::TotalOpCount(op_type);
+
+  for (int64_t i = 0; i < OpCostRecorder::kFlushIntervalEvents; ++i) {
+    recorder.RecordOpCost(op_type, /*cycles=*/1000);
+  }
+  EXPECT_EQ(count_before + OpCostRecorder::kFlushIntervalEvents,
+            OpCostRecorder::TotalOpCount(op_type));
+}
+
+TEST(OpCostRecorderTest, AggregatesPerOpType) {
+  OpCostRecorder recorder;
+  const int64_t a_before = OpCostRecorder::TotalOpCount("PerTypeTestOpA");
+  const int64_t b_before = OpCostRecorder::TotalOpCount("PerTypeTestOpB");
+
+  recorder.RecordOpCost("PerTypeTestOpA", /*cycles=*/1000);
+  recorder.RecordOpCost("PerTypeTestOpA", /*cycles=*/1000);
+  recorder.RecordOpCost("PerTypeTestOpB", /*cycles=*/1000);
+  recorder.Flush();
+
+  EXPECT_EQ(a_before + 2, OpCostRecorder::TotalOpCount("PerTypeTestOpA"));
+  EXPECT_EQ(b_before + 1, OpCostRecorder::TotalOpCount("PerTypeTestOpB"));
+}
+
+}  // namespace
+}  // namespace tensorflow
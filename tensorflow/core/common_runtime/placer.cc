@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/placer.h"
 
+#include <algorithm>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/colocation_graph.h"
@@ -29,8 +32,11 @@ limitations under the License.
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/graph/graph_node_util.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/port.h"
 
 namespace tensorflow {
@@ -150,6 +156,114 @@ Status AssignAndLog(int assigned_device, Node* node,
   return OkStatus();
 }
 
+// Memoized placement decisions, keyed by a fingerprint of every
+// placement-relevant input to the Placer.  Opt-in via TF_PLACER_CACHE=true,
+// aimed at services that repeatedly place structurally-identical graphs; on
+// a hit the cached per-node assignments are applied without rebuilding the
+// colocation graph or re-solving constraints.
+class PlacementCache {
+ public:
+  static PlacementCache* Global() {
+    static PlacementCache* cache = new PlacementCache;
+    return cache;
+  }
+
+  static bool Enabled() {
+    static const bool enabled = [] {
+      bool enabled = false;
+      Status status = ReadBoolFromEnvVar("TF_PLACER_CACHE", false, &enabled);
+      if (!status.ok()) {
+        LOG(ERROR) << "Placer: " << status.message();
+      }
+      return enabled;
+    }();
+    return enabled;
+  }
+
+  // On a hit, fills `device_names`, indexed by node id.
+  bool Lookup(uint64 fingerprint, std::vector<string>* device_names) {
+    mutex_lock l(mu_);
+    auto it = entries_.find(fingerprint);
+    if (it == entries_.end()) return false;
+    *device_names = it->second;
+    return true;
+  }
+
+  void Insert(uint64 fingerprint, std::vector<string> device_names) {
+    mutex_lock l(mu_);
+    // Bound memory by starting over when full; that only costs one re-solve
+    // per distinct graph.
+    if (entries_.size() >= kMaxEntries) entries_.clear();
+    entries_.emplace(fingerprint, std::move(device_names));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 1024;
+
+  mutex mu_;
+  std::unordered_map<uint64, std::vector<string>> entries_ TF_GUARDED_BY(mu_);
+};
+
+// Fingerprints everything the placement algorithm reads: per-node op, attrs,
+// requested and pre-assigned devices, the (deterministically ordered) edge
+// structure, the device set and the placement flags.  Function bodies are
+// folded in by name only, so a client that redefines a function under an
+// existing name should not enable the cache.
+uint64 PlacementFingerprint(const Graph& graph, const string& function_name,
+                            const FunctionLibraryDefinition* flib_def,
+                            const DeviceSet* devices,
+                            const Device* default_local_device,
+                            bool allow_soft_placement) {
+  uint64 h = Hash64(function_name);
+  h = Hash64Combine(h, allow_soft_placement ? 1 : 0);
+  if (default_local_device != nullptr) {
+    h = Hash64Combine(h, Hash64(default_local_device->name()));
+  }
+  for (const Device* device : devices->devices()) {
+    h = Hash64Combine(h, Hash64(device->name()));
+  }
+  if (flib_def != nullptr) {
+    std::vector<string> function_names = flib_def->ListFunctionNames();
+    std::sort(function_names.begin(), function_names.end());
+    for (const string& name : function_names) {
+      h = Hash64Combine(h, Hash64(name));
+    }
+  }
+  for (const Node* node : graph.op_nodes()) {
+    uint64 node_hash = Hash64Combine(Hash64(node->type_string()),
+                                     Hash64(node->requested_device()));
+    if (node->has_assigned_device_name()) {
+      node_hash =
+          Hash64Combine(node_hash, Hash64(node->assigned_device_name()));
+    }
+    // Attr maps iterate in nondeterministic order, so hash sorted names.
+    std::vector<string> attr_names;
+    for (const auto& attr : node->attrs()) {
+      attr_names.push_back(attr.first);
+    }
+    std::sort(attr_names.begin(), attr_names.end());
+    for (const string& name : attr_names) {
+      node_hash = Hash64Combine(node_hash, Hash64(name));
+      node_hash =
+          Hash64Combine(node_hash, AttrValueHash(*node->attrs().Find(name)));
+    }
+    // Likewise for the input edges.
+    std::vector<std::tuple<int, int, int>> in_edges;
+    for (const Edge* edge : node->in_edges()) {
+      in_edges.emplace_back(edge->dst_input(), edge->src()->id(),
+                            edge->src_output());
+    }
+    std::sort(in_edges.begin(), in_edges.end());
+    for (const auto& [dst_input, src_id, src_output] : in_edges) {
+      node_hash = Hash64Combine(
+          node_hash, Hash64Combine(dst_input,
+                                   Hash64Combine(src_id, src_output)));
+    }
+    h = Hash64Combine(h, Hash64Combine(node->id(), node_hash));
+  }
+  return h;
+}
+
 }  // namespace
 
 Placer::Placer(Graph* graph, const string& function_name,
@@ -201,6 +315,27 @@ Status Placer::Run(const GraphOptimizationPassOptions& options) {
     }
   }
 
+  uint64 fingerprint = 0;
+  if (PlacementCache::Enabled()) {
+    fingerprint =
+        PlacementFingerprint(*graph_, function_name_, flib_def_, devices_,
+                             default_local_device_, allow_soft_placement_);
+    std::vector<string> device_names;
+    if (PlacementCache::Global()->Lookup(fingerprint, &device_names) &&
+        device_names.size() == static_cast<size_t>(graph_->num_node_ids())) {
+      VLOG(1) << "Placer: reusing cached placement decisions, fingerprint "
+              << fingerprint;
+      for (Node* node : graph_->op_nodes()) {
+        if (!node->has_assigned_device_name()) {
+          node->set_assigned_device_name_index(
+              graph_->InternDeviceName(device_names[node->id()]));
+        }
+        LogDeviceAssignment(node, log_device_placement_);
+      }
+      return OkStatus();
+    }
+  }
+
   FunctionStack stack(function_name_);
   ColocationGraph colocation_graph(graph_, stack, flib_def_, devices_,
                                    default_local_device_, allow_soft_placement_,
@@ -327,6 +462,14 @@ Status Placer::Run(const GraphOptimizationPassOptions& options) {
         strings::StrCat(options.debug_filename_prefix, "colocation_graph"),
         colocation_graph);
   }
+
+  if (PlacementCache::Enabled()) {
+    std::vector<string> device_names(graph_->num_node_ids());
+    for (const Node* node : graph_->op_nodes()) {
+      device_names[node->id()] = node->assigned_device_name();
+    }
+    PlacementCache::Global()->Insert(fingerprint, std::move(device_names));
+  }
   return OkStatus();
 }
 
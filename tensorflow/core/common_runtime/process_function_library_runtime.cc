@@ -638,6 +638,21 @@ Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
     }
   }
 
+  // A function partitioned into a single subgraph with no Send or Recv ops
+  // never uses the per-step rendezvous: its args and rets move directly
+  // between the caller and the component function. Record that so Run() can
+  // skip creating a rendezvous for such intra-device calls.
+  if (num_subgraphs == 1) {
+    data->requires_rendezvous = false;
+    for (const Node* node : subgraphs->begin()->second->nodes()) {
+      if (node->IsSend() || node->IsHostSend() || node->IsRecv() ||
+          node->IsHostRecv()) {
+        data->requires_rendezvous = true;
+        break;
+      }
+    }
+  }
+
   // Instantiate each component function (subgraph).
   for (const auto& pair : *subgraphs) {
     Status* status = &instantiate_status[i];
@@ -1265,6 +1280,13 @@ Status ProcessFunctionLibraryRuntime::CreateRendezvous(
   return s;
 }
 
+bool ProcessFunctionLibraryRuntime::RunsWithoutRendezvous(
+    FunctionLibraryRuntime::Handle handle) const {
+  const MultiDeviceFunctionData* data = IsMultiDevice(handle);
+  return data != nullptr && !data->requires_rendezvous &&
+         !data->is_cross_process_;
+}
+
 Status ProcessFunctionLibraryRuntime::GetComponentArgs(
     const gtl::ArraySlice<Tensor> args,
     const ProcessFunctionLibraryRuntime::ComponentFunctionData& comp_data,
@@ -1327,10 +1349,16 @@ void ProcessFunctionLibraryRuntime::Run(
   FunctionLibraryRuntime::Options new_opts = opts;
   tsl::core::RefCountPtr<Rendezvous> created_rendezvous = nullptr;
   if (!opts.rendezvous) {
-    Status s = CreateRendezvous(new_opts, &created_rendezvous);
-    if (!s.ok()) {
-      done(s);
-      return;
+    if (RunsWithoutRendezvous(handle)) {
+      // Intra-device fast path: a single local component takes its args and
+      // produces its rets directly, so the rendezvous would never be used.
+      new_opts.create_rendezvous = false;
+    } else {
+      Status s = CreateRendezvous(new_opts, &created_rendezvous);
+      if (!s.ok()) {
+        done(s);
+        return;
+      }
     }
   }
 
@@ -1514,7 +1542,11 @@ Status ProcessFunctionLibraryRuntime::RunSync(
     FunctionLibraryRuntime::Options new_opts = orig_opts;
     tsl::core::RefCountPtr<Rendezvous> created_rendezvous = nullptr;
     if (!new_opts.rendezvous) {
-      TF_RETURN_IF_ERROR(CreateRendezvous(new_opts, &created_rendezvous));
+      if (RunsWithoutRendezvous(handle)) {
+        new_opts.create_rendezvous = false;
+      } else {
+        TF_RETURN_IF_ERROR(CreateRendezvous(new_opts, &created_rendezvous));
+      }
     }
 
     std::vector<FunctionRet> function_rets;
@@ -312,6 +312,12 @@ class ProcessFunctionLibraryRuntime {
     bool is_cross_process_;
     // Indicates whether this function has remote outputs.
     bool has_remote_outputs;
+    // Indicates whether running this function needs a per-step rendezvous.
+    // False only when the function was partitioned into a single local
+    // subgraph with no Send or Recv ops; args and rets then move directly
+    // between the caller and the component function, so Run() can skip
+    // creating a rendezvous entirely.
+    bool requires_rendezvous = true;
 
     //  Indicates if running this function synchronously is both allowed + safe.
     bool enable_sync_execution;
@@ -400,6 +406,12 @@ class ProcessFunctionLibraryRuntime {
       FunctionLibraryRuntime::Options& opts,
       tsl::core::RefCountPtr<Rendezvous>* created_rendezvous) const;
 
+  // Returns true if running `handle` never touches a per-step rendezvous,
+  // i.e. it is a local multi-device function with a single component whose
+  // args and rets are passed directly. Run() uses this to skip creating a
+  // rendezvous for intra-device calls.
+  bool RunsWithoutRendezvous(FunctionLibraryRuntime::Handle handle) const;
+
   FunctionLibraryRuntime::DoneCallback ApplyCleanUpToDoneCallback(
       std::vector<std::unique_ptr<CleanUpItem>>* items,
       FunctionLibraryRuntime::DoneCallback done,
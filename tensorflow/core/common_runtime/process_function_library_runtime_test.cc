@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/process_function_library_runtime.h"
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -154,6 +155,7 @@ class ProcessFunctionLibraryRuntimeTest : public ::testing::Test {
         Rendezvous::Factory{[this](const int64_t step_id,
                                    const DeviceMgr* device_mgr,
                                    tsl::core::RefCountPtr<Rendezvous>* r) {
+          ++rendezvous_creation_count_;
           *r = this->rendezvous_cache_->FindOrCreate(step_id, [device_mgr]() {
             return tsl::core::RefCountPtr<IntraProcessRendezvous>(
                 new IntraProcessRendezvous(device_mgr));
@@ -324,6 +326,9 @@ class ProcessFunctionLibraryRuntimeTest : public ::testing::Test {
   // To ensure that we are cleaning up the rendezvous properly.
   tsl::core::RefCountPtr<RendezvousCache<IntraProcessRendezvous>>
       rendezvous_cache_;
+  // Number of times the rendezvous factory was invoked. Single-component
+  // local functions are expected to run without creating a rendezvous.
+  std::atomic<int64_t> rendezvous_creation_count_{0};
 };
 
 TEST_F(ProcessFunctionLibraryRuntimeTest, GetFLRNull) {
@@ -746,6 +751,34 @@ TEST_F(ProcessFunctionLibraryRuntimeTest, MultiDevice_InferredOutputDevice) {
   TestTwoDeviceMult(this, MakeOptions("CPU:0", {"CPU:0"}, {}));
 }
 
+TEST_F(ProcessFunctionLibraryRuntimeTest, MultiDevice_SingleDeviceNoRendezvous) {
+  Init({test::function::XTimesTwo()});
+  auto x = test::AsTensor<float>({1, 2, 3});
+  Tensor y;
+  TF_CHECK_OK(Run("XTimesTwo", {}, {{"T", DT_FLOAT}},
+                  MakeOptions("CPU:0", {"CPU:0"}, {"CPU:0"}), {x}, {&y}));
+  test::ExpectTensorEqual<float>(y, test::AsTensor<float>({2, 4, 6}));
+  // A function with a single local component never touches the per-step
+  // rendezvous, so none should have been created.
+  EXPECT_EQ(rendezvous_creation_count_, 0);
+}
+
+TEST_F(ProcessFunctionLibraryRuntimeTest, MultiDevice_CrossDeviceRendezvous) {
+  Init({test::function::TwoDeviceInputOutput()});
+  auto x1 = test::AsTensor<float>({1, 2});
+  auto x2 = test::AsTensor<float>({10, 20});
+  Tensor y1;
+  Tensor y2;
+  TF_CHECK_OK(Run("TwoDeviceInputOutput", {}, {{"T", DT_FLOAT}},
+                  MakeOptions("CPU:0", {"CPU:0", "CPU:1"}, {"CPU:0", "CPU:1"}),
+                  {x1, x2}, {&y1, &y2}));
+  test::ExpectTensorEqual<float>(y1, test::AsTensor<float>({2, 4}));
+  test::ExpectTensorEqual<float>(y2, test::AsTensor<float>({30, 60}));
+  // The function partitions across two devices, so its Send/Recv pairs need
+  // a rendezvous.
+  EXPECT_GT(rendezvous_creation_count_, 0);
+}
+
 TEST_F(ProcessFunctionLibraryRuntimeTest, MultiDevice_ErrorWhenNoInputDevices) {
   if (gpu_device_ == nullptr) {
     GTEST_SKIP() << "No GPUs available";
@@ -22,12 +22,15 @@ limitations under the License.
 #include "absl/base/call_once.h"
 #include "tensorflow/core/common_runtime/bfc_allocator.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/common_runtime/size_class_allocator.h"
+#include "tensorflow/core/common_runtime/spill_allocator.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/log_memory.h"
 #include "tensorflow/core/framework/tracking_allocator.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/env_var.h"
 
@@ -109,6 +112,19 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
 
       VLOG(2) << "Using BFCAllocator with memory limit of "
               << cpu_mem_limit_in_mb << " MB for ProcessState CPU allocator";
+
+      // Optionally layer a per-thread size-class cache in front of BFC so
+      // that small tensor alloc/free pairs do not contend on the BFC lock.
+      bool use_small_alloc_cache = false;
+      status = ReadBoolFromEnvVar("TF_CPU_BFC_SMALL_ALLOC_CACHE", false,
+                                  &use_small_alloc_cache);
+      if (!status.ok()) {
+        LOG(ERROR) << "GetCPUAllocator: " << status.message();
+      }
+      if (use_small_alloc_cache) {
+        allocator = new SizeClassAllocator(absl::WrapUnique(allocator));
+        VLOG(2) << "Layering SizeClassAllocator in front of BFCAllocator";
+      }
     } else if (sub_allocator) {
       DCHECK(sub_allocator);
       allocator =
@@ -121,6 +137,29 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
       DCHECK(!sub_allocator);
       allocator = cpu_allocator_base();
     }
+    // Optionally layer a file-backed spill region in front of the allocator
+    // so that oversized tensors degrade to NVMe/disk paging instead of a
+    // hard OOM. Off unless a spill directory is configured.
+    string spill_dir;
+    status = ReadStringFromEnvVar("TF_CPU_SPILL_DIR", "", &spill_dir);
+    if (!status.ok()) {
+      LOG(ERROR) << "GetCPUAllocator: " << status.message();
+    }
+    if (!spill_dir.empty()) {
+      int64_t spill_threshold_mb = 256;
+      status = ReadInt64FromEnvVar("TF_CPU_SPILL_THRESHOLD_MB",
+                                   spill_threshold_mb, &spill_threshold_mb);
+      if (!status.ok()) {
+        LOG(ERROR) << "GetCPUAllocator: " << status.message();
+      }
+      SpillAllocator::Options spill_options;
+      spill_options.spill_dir = spill_dir;
+      spill_options.spill_threshold_bytes =
+          static_cast<size_t>(spill_threshold_mb) * (1LL << 20);
+      allocator = new SpillAllocator(allocator, spill_options);
+      VLOG(2) << "Layering SpillAllocator with spill dir " << spill_dir
+              << " and threshold " << spill_threshold_mb << " MB";
+    }
     if (LogMemory::IsEnabled() && !allocator->TracksAllocationSizes()) {
       // Wrap the allocator to track allocation ids for better logging
       // at the cost of performance.
@@ -138,6 +177,14 @@ Allocator* ProcessState::GetCPUAllocator(int numa_node) {
   return cpu_allocators_[numa_node];
 }
 
+Allocator* ProcessState::GetCPUAllocatorForCurrentThread() {
+  if (!numa_enabled_) return GetCPUAllocator(0);
+  // The node a thread is bound to does not change after the thread pools pin
+  // their workers, so cache the (syscall-backed) lookup per thread.
+  static thread_local int numa_node = port::NUMAGetThreadNodeAffinity();
+  return GetCPUAllocator(numa_node);
+}
+
 void ProcessState::AddCPUAllocVisitor(SubAllocator::Visitor visitor) {
   VLOG(1) << "AddCPUAllocVisitor";
   mutex_lock lock(mu_);
@@ -66,6 +66,12 @@ class ProcessState : public ProcessStateInterface {
   // Treats numa_node == kNUMANoAffinity as numa_node == 0.
   Allocator* GetCPUAllocator(int numa_node) override;
 
+  // Returns the CPUAllocator for the NUMA node the calling thread is bound
+  // to, so that kernels allocate from a socket-local arena. Falls back to
+  // GetCPUAllocator(0) when NUMA is disabled or the thread has no node
+  // affinity. The node lookup is cached per thread.
+  Allocator* GetCPUAllocatorForCurrentThread();
+
   // Registers alloc visitor for the CPU allocator(s).
   // REQUIRES: must be called before GetCPUAllocator.
   void AddCPUAllocVisitor(SubAllocator::Visitor v);
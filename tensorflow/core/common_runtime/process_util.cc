@@ -22,12 +22,18 @@ limitations under the License.
 #endif  // defined(ENABLE_MKL) && defined(ENABLE_ONEDNN_OPENMP)
 #include <string.h>
 
+#include <atomic>
+#include <memory>
+
 #include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/tracing.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
@@ -183,4 +189,103 @@ void SchedNonBlockingClosureAfter(int64_t micros,
   Env::Default()->SchedClosureAfter(micros, std::move(closure));
 }
 
+namespace {
+
+auto* sched_closure_depth = monitoring::Gauge<int64_t, 1>::New(
+    "/tensorflow/core/sched_closure/queue_depth",
+    "Number of closures scheduled to a tagged SchedClosure pool that have "
+    "not yet finished running.",
+    "pool");
+
+// A small named pool for one class of background work. Pending depth is
+// bounded: closures beyond kMaxPendingClosures overflow to the default
+// SchedClosure path, so a backlog in one class degrades to extra threads
+// rather than unbounded queueing behind it (and blocking closures in the
+// same class cannot deadlock each other).
+class TaggedClosurePool {
+ public:
+  // Caps the number of closures scheduled but not yet finished.
+  static constexpr int64_t kMaxPendingClosures = 512;
+
+  TaggedClosurePool(const string& name, const char* num_threads_env_var,
+                    int64_t default_num_threads)
+      : depth_cell_(sched_closure_depth->GetCell(name)),
+        pool_(Env::Default(), ThreadOptions(),
+              strings::StrCat("sched_", name),
+              NumThreads(num_threads_env_var, default_num_threads),
+              /*low_latency_hint=*/false, /*allocator=*/nullptr) {}
+
+  void Schedule(absl::AnyInvocable<void()> closure) {
+    int64_t depth = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    depth_cell_->Set(depth);
+    if (depth > kMaxPendingClosures) {
+      Done();
+      SchedClosure(std::move(closure));
+      return;
+    }
+    // ThreadPool::Schedule takes a copyable std::function, so the move-only
+    // closure travels in a shared_ptr.
+    auto shared =
+        std::make_shared<absl::AnyInvocable<void()>>(std::move(closure));
+    pool_.Schedule([this, shared]() {
+      (*shared)();
+      Done();
+    });
+  }
+
+ private:
+  static int64_t NumThreads(const char* env_var, int64_t default_value) {
+    int64_t num_threads = default_value;
+    Status status = ReadInt64FromEnvVar(env_var, default_value, &num_threads);
+    if (!status.ok()) {
+      LOG(ERROR) << "SchedClosure: " << status.message();
+    }
+    return num_threads > 0 ? num_threads : default_value;
+  }
+
+  void Done() {
+    depth_cell_->Set(depth_.fetch_sub(1, std::memory_order_relaxed) - 1);
+  }
+
+  std::atomic<int64_t> depth_{0};
+  monitoring::GaugeCell<int64_t>* const depth_cell_;
+  thread::ThreadPool pool_;
+};
+
+TaggedClosurePool* PoolForKind(SchedClosureKind kind) {
+  // Pools are created on first use and intentionally never destroyed, like
+  // the other process-wide pools in this file.
+  switch (kind) {
+    case SchedClosureKind::kRendezvous: {
+      static TaggedClosurePool* pool = new TaggedClosurePool(
+          "rendezvous", "TF_SCHED_RENDEZVOUS_THREADS", 4);
+      return pool;
+    }
+    case SchedClosureKind::kCheckpoint: {
+      static TaggedClosurePool* pool =
+          new TaggedClosurePool("checkpoint", "TF_SCHED_CHECKPOINT_THREADS", 2);
+      return pool;
+    }
+    case SchedClosureKind::kGarbageCollection: {
+      static TaggedClosurePool* pool =
+          new TaggedClosurePool("gc", "TF_SCHED_GC_THREADS", 1);
+      return pool;
+    }
+    case SchedClosureKind::kDefault:
+      return nullptr;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+void SchedClosure(SchedClosureKind kind, absl::AnyInvocable<void()> closure) {
+  TaggedClosurePool* pool = PoolForKind(kind);
+  if (pool == nullptr) {
+    SchedClosure(std::move(closure));
+    return;
+  }
+  pool->Schedule(std::move(closure));
+}
+
 }  // namespace tensorflow
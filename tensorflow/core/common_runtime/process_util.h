@@ -54,6 +54,26 @@ thread::ThreadPool* NewThreadPoolFromSessionOptions(
 // Schedule "closure" in the default thread queue.
 void SchedClosure(absl::AnyInvocable<void()> closure);
 
+// Classes of background work scheduled through SchedClosure. Each class
+// other than kDefault runs in its own small named pool, so heavyweight
+// background work (checkpoint I/O, session garbage collection) cannot starve
+// latency-sensitive completion callbacks sharing the default path.
+enum class SchedClosureKind {
+  kDefault,            // Historical Env::SchedClosure behavior.
+  kRendezvous,         // Rendezvous / data-transfer completion callbacks.
+  kCheckpoint,         // Checkpoint and other bulk file I/O.
+  kGarbageCollection,  // Session and resource cleanup.
+};
+
+// Schedules "closure" in the pool for the given class of work. Pool sizes
+// default to a few threads each and can be overridden with the
+// TF_SCHED_RENDEZVOUS_THREADS, TF_SCHED_CHECKPOINT_THREADS and
+// TF_SCHED_GC_THREADS environment variables. Each pool bounds its pending
+// depth; closures beyond the bound overflow to the default path rather than
+// queueing behind a backlog. Current per-pool depth is exported under
+// /tensorflow/core/sched_closure/queue_depth.
+void SchedClosure(SchedClosureKind kind, absl::AnyInvocable<void()> closure);
+
 // Schedule "closure" after the given number of microseconds in the
 // fixed-size ThreadPool used for non-blocking compute tasks.
 void SchedNonBlockingClosureAfter(int64_t micros,
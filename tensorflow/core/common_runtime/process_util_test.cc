@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/common_runtime/process_util.h"
 
+#include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/platform/test.h"
 
 namespace tensorflow {
@@ -34,5 +35,18 @@ TEST(ProcessUtilTest, ThreadPool) {
   delete pool;
 }
 
+TEST(ProcessUtilTest, TaggedSchedClosureRuns) {
+  Notification done;
+  SchedClosure(SchedClosureKind::kGarbageCollection,
+               [&done]() { done.Notify(); });
+  done.WaitForNotification();
+}
+
+TEST(ProcessUtilTest, DefaultKindSchedClosureRuns) {
+  Notification done;
+  SchedClosure(SchedClosureKind::kDefault, [&done]() { done.Notify(); });
+  done.WaitForNotification();
+}
+
 }  // anonymous namespace
 }  // namespace tensorflow
@@ -20,10 +20,29 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/propagator_debug_utils.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/platform/hash.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 
 namespace tensorflow {
+namespace {
+
+// While-loop pipelining instrumentation. An iteration is "pipelined" if it
+// starts while at least one earlier iteration of the same frame is still
+// outstanding; a NextIteration value is "deferred" if its dispatch had to
+// wait because parallel_iterations iterations were already outstanding.
+// Together these show how much cross-iteration overlap a loop achieves and
+// whether parallel_iterations is what caps it.
+auto* pipelined_loop_iterations = monitoring::Counter<0>::New(
+    "/tensorflow/core/executor/pipelined_loop_iterations",
+    "The number of while-loop iterations that started while an earlier "
+    "iteration of the same frame was still outstanding.");
+auto* deferred_loop_iterations = monitoring::Counter<0>::New(
+    "/tensorflow/core/executor/deferred_loop_iterations",
+    "The number of while-loop NextIteration values whose dispatch was "
+    "deferred because parallel_iterations was reached.");
+
+}  // namespace
 
 PropagatorState::PropagatorState(const ImmutableExecutorState& immutable_state,
                                  int64_t step_id, bool vlog)
@@ -147,6 +166,8 @@ void PropagatorState::PropagateOutputs(const TaggedNode& tagged_node,
             output_frame = nullptr;
             mutex_lock l(input_frame->iter_mu);
             input_frame->next_iter_roots.push_back({item, (*outputs)[0]});
+            input_frame->num_deferred_next_iterations++;
+            deferred_loop_iterations->GetCell()->IncrementBy(1);
           } else {
             // Need to create iteration state after acquiring mutex lock.
             need_create_iter = true;
@@ -380,7 +401,19 @@ void PropagatorState::DeleteFrame(FrameState* frame, TaggedNodeSeq* ready) {
   }
 
   // Delete the frame.
-  if (vlog_) VLOG(2) << "Delete frame " << frame->frame_id;
+  if (vlog_) {
+    VLOG(2) << "Delete frame " << frame->frame_id;
+    mutex_lock frame_lock(frame->mu);
+    if (frame->iteration_count > 0) {
+      mutex_lock iter_lock(frame->iter_mu);
+      VLOG(1) << "Frame " << frame->frame_id << " ran "
+              << frame->iteration_count + 1 << " iterations with peak overlap "
+              << frame->max_observed_parallel_iterations << " (limit "
+              << frame->max_parallel_iterations << "); "
+              << frame->num_deferred_next_iterations
+              << " NextIteration values were deferred at the limit";
+    }
+  }
   {
     mutex_lock executor_lock(mu_);
     outstanding_frames_.erase(frame->frame_id);
@@ -757,6 +790,14 @@ PropagatorState::FrameState::IncrementIteration(TaggedNodeSeq* ready) {
       new IterationState(iteration_count, pending_counts, total_input_tensors);
   SetIteration(iteration_count, next_iter);
   num_outstanding_iterations++;
+  if (num_outstanding_iterations > 1) {
+    // This iteration starts while an earlier one is still outstanding, so
+    // the loop is executing iterations in a pipelined fashion.
+    pipelined_loop_iterations->GetCell()->IncrementBy(1);
+    if (num_outstanding_iterations > max_observed_parallel_iterations) {
+      max_observed_parallel_iterations = num_outstanding_iterations;
+    }
+  }
   {
     mutex_lock l(iter_mu);
     dead_exits.clear();
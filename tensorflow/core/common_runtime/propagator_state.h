@@ -281,6 +281,15 @@ class PropagatorState {
     // The number of outstanding iterations.
     int num_outstanding_iterations TF_GUARDED_BY(mu) = 1;
 
+    // The highest number of concurrently outstanding iterations observed in
+    // this frame, i.e. the peak cross-iteration pipelining the loop achieved.
+    // Reported when the frame is deleted and vlog is enabled.
+    int max_observed_parallel_iterations TF_GUARDED_BY(mu) = 1;
+
+    // The number of NextIteration values whose dispatch was deferred because
+    // `max_parallel_iterations` iterations were already outstanding.
+    int64_t num_deferred_next_iterations TF_GUARDED_BY(iter_mu) = 0;
+
    private:
     // The active iteration states of this frame.
     gtl::InlinedVector<IterationState*, 12> iterations;
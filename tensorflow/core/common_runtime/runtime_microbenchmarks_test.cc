@@ -0,0 +1,249 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Microbenchmarks for the runtime primitives the executor is built on:
+// ready-queue throughput, output propagation fan-out, rendezvous send/recv
+// under thread contention, and Entry move costs. These complement the
+// whole-graph benchmarks in executor_test.cc by isolating the individual
+// costs, so a scheduler or rendezvous regression shows up here as a step
+// change in one benchmark instead of a diffuse slowdown in p99 latencies.
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/entry.h"
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/framework/rendezvous.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session_options.h"
+
+namespace tensorflow {
+namespace {
+
+// Ready-queue throughput: a diamond of `width` independent no-ops between a
+// source and a sink, repeated `depth` times. Every level floods the ready
+// queue with `width` entries at once, so iterations/sec tracks how fast the
+// scheduler can drain and refill the queue; the no-op kernels contribute
+// almost nothing.
+void BM_ReadyQueueThroughput(::testing::benchmark::State& state) {
+  const int width = state.range(0);
+  const int depth = state.range(1);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Node* join = test::graph::NoOp(g, {});
+  for (int d = 0; d < depth; ++d) {
+    std::vector<Node*> level;
+    level.reserve(width);
+    for (int w = 0; w < width; ++w) {
+      level.push_back(test::graph::NoOp(g, {join}));
+    }
+    join = test::graph::NoOp(g, level);
+  }
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * width *
+                          depth);
+}
+
+BENCHMARK(BM_ReadyQueueThroughput)
+    ->UseRealTime()
+    ->ArgPair(16, 64)
+    ->ArgPair(64, 64)
+    ->ArgPair(256, 64)
+    ->ArgPair(1024, 16);
+
+// Output propagation fan-out: a single producer whose output feeds `width`
+// Identity consumers. PropagateOutputs has to deliver the same tensor to
+// every consumer and enqueue all of them, so this isolates the per-out-edge
+// cost as the fan-out grows.
+void BM_PropagateFanOut(::testing::benchmark::State& state) {
+  const int width = state.range(0);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Tensor value(DT_FLOAT, TensorShape({1}));
+  value.flat<float>().setZero();
+  Node* producer = test::graph::Constant(g, value);
+  std::vector<Node*> consumers;
+  consumers.reserve(width);
+  for (int w = 0; w < width; ++w) {
+    consumers.push_back(test::graph::Identity(g, producer));
+  }
+  // Join so the benchmark measures a single completed step.
+  test::graph::NoOp(g, consumers);
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * width);
+}
+
+BENCHMARK(BM_PropagateFanOut)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
+
+// Scheduler behavior under varying op cost: `width` independent `dim` x `dim`
+// matmuls with `threads` inter-op threads. Small dims stress dispatch
+// overhead, large dims stress how well the pool keeps cores busy.
+void BM_ExecutorOpCost(::testing::benchmark::State& state) {
+  const int threads = state.range(0);
+  const int width = state.range(1);
+  const int dim = state.range(2);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Tensor lhs(DT_FLOAT, TensorShape({dim, dim}));
+  lhs.flat<float>().setRandom();
+  Tensor rhs(DT_FLOAT, TensorShape({dim, dim}));
+  rhs.flat<float>().setRandom();
+  Node* lhs_node = test::graph::Constant(g, lhs);
+  Node* rhs_node = test::graph::Constant(g, rhs);
+  for (int w = 0; w < width; ++w) {
+    test::graph::Matmul(g, lhs_node, rhs_node, false, false);
+  }
+  FixupSourceAndSinkEdges(g);
+
+  SessionOptions options;
+  options.config.set_inter_op_parallelism_threads(threads);
+  options.config.set_intra_op_parallelism_threads(1);
+  test::Benchmark("cpu", g, &options, nullptr, nullptr, "",
+                  /*old_benchmark_api=*/false)
+      .Run(state);
+  state.SetLabel(strings::StrCat("threads = ", threads, " width = ", width,
+                                 " dim = ", dim));
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * width);
+}
+
+BENCHMARK(BM_ExecutorOpCost)
+    ->UseRealTime()
+    ->Args({1, 64, 8})
+    ->Args({4, 64, 8})
+    ->Args({16, 64, 8})
+    ->Args({4, 64, 64})
+    ->Args({16, 64, 64})
+    ->Args({16, 256, 64})
+    ->Args({16, 64, 256});
+
+// Rendezvous send/recv with `threads` concurrent producers, every message on
+// its own key. The consumer side runs on the benchmark thread, so this
+// measures table insert/lookup and wakeup under contention rather than
+// payload copies.
+void BM_RendezvousContention(::testing::benchmark::State& state) {
+  const int threads = state.range(0);
+
+  Rendezvous* rendez = NewLocalRendezvous();
+  thread::ThreadPool pool(Env::Default(), "rendezvous_bench", threads);
+  Tensor payload(DT_FLOAT, TensorShape({1}));
+  payload.flat<float>().setZero();
+
+  std::vector<Rendezvous::ParsedKey> keys(threads);
+  for (int t = 0; t < threads; ++t) {
+    TF_CHECK_OK(Rendezvous::ParseKey(
+        Rendezvous::CreateKey("/job:mnist/replica:1/task:2/cpu:0", 7890,
+                              "/job:mnist/replica:1/task:2/gpu:0",
+                              strings::StrCat("key_", t), FrameAndIter(0, 0)),
+        &keys[t]));
+  }
+
+  const Rendezvous::Args args;
+  for (auto s : state) {
+    BlockingCounter sent(threads);
+    for (int t = 0; t < threads; ++t) {
+      pool.Schedule([&, t]() {
+        TF_CHECK_OK(rendez->Send(keys[t], args, payload, false));
+        sent.DecrementCount();
+      });
+    }
+    Tensor received;
+    bool is_dead = false;
+    for (int t = 0; t < threads; ++t) {
+      TF_CHECK_OK(rendez->Recv(keys[t], args, &received, &is_dead));
+    }
+    sent.Wait();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * threads);
+  rendez->Unref();
+}
+
+BENCHMARK(BM_RendezvousContention)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(64);
+
+// Cost of moving input Entries, as done for every kernel input on every node
+// activation. Moving a HAS_VALUE entry moves the contained Tensor, which is a
+// buffer-pointer handoff independent of payload size; this benchmark guards
+// that property.
+void BM_EntryMove(::testing::benchmark::State& state) {
+  const int num_elements = state.range(0);
+
+  Tensor value(DT_FLOAT, TensorShape({num_elements}));
+  value.flat<float>().setZero();
+  Entry src;
+  src.state = Entry::State::HAS_VALUE;
+  src.val.Init(value);
+  Entry dst;
+
+  for (auto s : state) {
+    dst = std::move(src);
+    src = std::move(dst);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 2);
+  src.ClearVal();
+  dst.ClearVal();
+}
+
+BENCHMARK(BM_EntryMove)->Arg(1)->Arg(1024)->Arg(1 << 20);
+
+// Same, but for an EntryVector of `size` entries, matching how the executor
+// materializes all inputs of a node before invoking its kernel.
+void BM_EntryVectorMove(::testing::benchmark::State& state) {
+  const int size = state.range(0);
+
+  Tensor value(DT_FLOAT, TensorShape({1}));
+  value.flat<float>().setZero();
+  EntryVector src(size);
+  for (Entry& entry : src) {
+    entry.state = Entry::State::HAS_VALUE;
+    entry.val.Init(value);
+  }
+  EntryVector dst;
+
+  for (auto s : state) {
+    dst = std::move(src);
+    src = std::move(dst);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 2 * size);
+  for (Entry& entry : src) entry.ClearVal();
+  for (Entry& entry : dst) entry.ClearVal();
+}
+
+BENCHMARK(BM_EntryVectorMove)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+}  // namespace
+}  // namespace tensorflow
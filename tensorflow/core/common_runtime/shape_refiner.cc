@@ -412,6 +412,62 @@ Status ShapeRefiner::UpdateNode(const Node* node, bool relax, bool* refined) {
   return RunShapeFn(node, op_reg_data, node_ext_context);
 }
 
+Status ShapeRefiner::UpdateNodeIncremental(const Node* node, bool relax,
+                                           bool* refined) {
+  *refined = false;
+
+  // Worklist over the dirty frontier. A node is in the worklist at most once
+  // at a time; it is re-enqueued if another of its inputs changes later.
+  std::deque<const Node*> worklist;
+  absl::flat_hash_set<const Node*> in_worklist;
+  worklist.push_back(node);
+  in_worklist.insert(node);
+
+  while (!worklist.empty()) {
+    const Node* n = worklist.front();
+    worklist.pop_front();
+    in_worklist.erase(n);
+
+    // Snapshot the current output shapes so that consumers of unchanged
+    // outputs can be skipped below.
+    InferenceContext* node_context = GetContext(n);
+    const bool had_context = node_context != nullptr;
+    std::vector<ShapeHandle> old_outputs;
+    if (had_context) {
+      old_outputs.reserve(node_context->num_outputs());
+      for (int i = 0; i < node_context->num_outputs(); ++i) {
+        old_outputs.push_back(node_context->output(i));
+      }
+    }
+
+    bool node_refined = false;
+    TF_RETURN_IF_ERROR(UpdateNode(n, relax, &node_refined));
+    if (!node_refined) continue;
+    *refined = true;
+
+    node_context = GetContext(n);
+    if (node_context == nullptr) continue;
+    for (const Edge* e : n->out_edges()) {
+      if (e->IsControlEdge()) continue;
+      // Skip consumers of outputs whose inferred shape did not change.
+      // Resource edges also carry handle shapes and types, so propagate
+      // those conservatively.
+      const int src_output = e->src_output();
+      if (had_context && n->output_type(src_output) != DT_RESOURCE &&
+          SameDefinedShape(node_context, old_outputs[src_output],
+                           node_context->output(src_output))) {
+        continue;
+      }
+      const Node* dst = e->dst();
+      // Only nodes already known to this refiner are re-inferred.
+      if (node_to_context_.find(dst) == node_to_context_.end()) continue;
+      if (in_worklist.insert(dst).second) worklist.push_back(dst);
+    }
+  }
+
+  return OkStatus();
+}
+
 Status ShapeRefiner::EvaluateConstantTensorForEdge(
     const Node* node, int dst_idx, bool* evaluated, Tensor* result,
     InferenceContext* outer_context) {
@@ -113,6 +113,15 @@ class ShapeRefiner {
   // if <*refined> is set to false.
   Status UpdateNode(const Node* node, bool relax, bool* refined);
 
+  // Like UpdateNode, but additionally propagates refined shapes to the
+  // transitive out-neighbors of 'node' with a worklist over the dirty
+  // frontier: a consumer is only re-inferred if the inferred shape of one of
+  // the outputs feeding it actually changed. After a local graph edit this
+  // re-infers only the affected downstream slice instead of requiring a full
+  // re-inference pass over the graph. Nodes never added to this refiner are
+  // left untouched. Sets 'refined' to true if any node's shapes changed.
+  Status UpdateNodeIncremental(const Node* node, bool relax, bool* refined);
+
   // Returns the InferenceContext for 'node', if present.
   shape_inference::InferenceContext* GetContext(const Node* node) const {
     auto it = node_to_context_.find(node);
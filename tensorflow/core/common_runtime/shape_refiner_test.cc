@@ -200,6 +200,39 @@ TEST_F(ShapeRefinerTest, SetShape) {
   ASSERT_FALSE(m.SetShape(a.node(), 0, h).ok());
 }
 
+TEST_F(ShapeRefinerTest, UpdateNodeIncremental) {
+  ShapeRefiner m(TF_GRAPH_DEF_VERSION, OpRegistry::Global());
+
+  Scope root = Scope::NewRootScope();
+  auto a = ops::Placeholder(root, DT_FLOAT);
+  auto b = ops::Const(root, {{1.0f, 2.0f}, {3.0f, 4.0f}});
+  auto mm = ops::MatMul(root, a, b);
+  auto id = ops::Identity(root, mm);
+
+  TF_ASSERT_OK(m.AddNode(a.node()));
+  TF_ASSERT_OK(m.AddNode(b.node()));
+  TF_ASSERT_OK(m.AddNode(mm.node()));
+  TF_ASSERT_OK(m.AddNode(id.node()));
+
+  EXPECT_SHAPE("[?,2]", m, mm, 0);
+  EXPECT_SHAPE("[?,2]", m, id, 0);
+
+  // Refine the placeholder, then propagate incrementally from the matmul:
+  // the whole downstream chain picks up the new shape.
+  auto ic = m.GetContext(a.node());
+  TF_ASSERT_OK(m.SetShape(a.node(), 0, ic->MakeShape({4, 2})));
+  bool refined = false;
+  TF_ASSERT_OK(m.UpdateNodeIncremental(mm.node(), /*relax=*/false, &refined));
+  EXPECT_TRUE(refined);
+  EXPECT_SHAPE("[4,2]", m, mm, 0);
+  EXPECT_SHAPE("[4,2]", m, id, 0);
+
+  // With no further changes a second call is a no-op.
+  refined = true;
+  TF_ASSERT_OK(m.UpdateNodeIncremental(mm.node(), /*relax=*/false, &refined));
+  EXPECT_FALSE(refined);
+}
+
 namespace {
 
 // An op with no shape function.
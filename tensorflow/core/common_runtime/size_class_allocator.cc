@@ -0,0 +1,169 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/size_class_allocator.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+namespace {
+
+// Every block handed out is preceded by a header of kAllocatorAlignment
+// bytes, so the user pointer keeps the alignment guarantee of the underlying
+// allocator.
+constexpr size_t kHeaderBytes = Allocator::kAllocatorAlignment;
+
+// Size classes are 64 << i for i in [0, kNumSizeClasses).
+constexpr int kNumSizeClasses = 7;
+constexpr size_t kMinClassBytes = 64;
+
+// Maximum number of cached blocks per size class per thread. With 4KB max
+// blocks this bounds the per-thread cache at ~2MB.
+constexpr size_t kMagazineCapacity = 64;
+
+struct BlockHeader {
+  void* base_ptr;   // Pointer originally returned by the underlying allocator.
+  int32 size_class;  // Size class index, or -1 for pass-through blocks.
+};
+
+static_assert(sizeof(BlockHeader) <= kHeaderBytes,
+              "BlockHeader must fit in the per-block header");
+
+inline BlockHeader* HeaderOf(void* user_ptr) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(user_ptr) -
+                                        kHeaderBytes);
+}
+
+inline int SizeClassFor(size_t num_bytes) {
+  size_t class_bytes = kMinClassBytes;
+  int size_class = 0;
+  while (class_bytes < num_bytes) {
+    class_bytes <<= 1;
+    ++size_class;
+  }
+  return size_class;
+}
+
+}  // namespace
+
+// Per-thread magazines of freed blocks, one stack per size class. Blocks
+// still cached when the thread exits are returned to the underlying
+// allocator, so the SizeClassAllocator must outlive every thread that
+// allocates from it. In practice these allocators live for the process.
+struct SizeClassAllocator::ThreadCache {
+  explicit ThreadCache(Allocator* base) : base(base) {}
+  ~ThreadCache() {
+    for (auto& magazine : magazines) {
+      for (void* user_ptr : magazine) {
+        base->DeallocateRaw(HeaderOf(user_ptr)->base_ptr);
+      }
+    }
+  }
+
+  Allocator* const base;
+  std::vector<void*> magazines[kNumSizeClasses];
+};
+
+SizeClassAllocator::SizeClassAllocator(std::unique_ptr<Allocator> base)
+    : base_(std::move(base)) {}
+
+SizeClassAllocator::~SizeClassAllocator() = default;
+
+string SizeClassAllocator::Name() {
+  return strings::StrCat("size_class_", base_->Name());
+}
+
+SizeClassAllocator::ThreadCache* SizeClassAllocator::GetThreadCache() {
+  // Keyed by allocator so that multiple instances (e.g. one per NUMA node)
+  // keep separate magazines.
+  static thread_local std::unordered_map<const SizeClassAllocator*,
+                                         std::unique_ptr<ThreadCache>>
+      caches;
+  std::unique_ptr<ThreadCache>& cache = caches[this];
+  if (cache == nullptr) {
+    cache = std::make_unique<ThreadCache>(base_.get());
+  }
+  return cache.get();
+}
+
+void* SizeClassAllocator::AllocateFromBase(int size_class) {
+  const size_t class_bytes = kMinClassBytes << size_class;
+  void* base_ptr = base_->AllocateRaw(Allocator::kAllocatorAlignment,
+                                      class_bytes + kHeaderBytes);
+  if (base_ptr == nullptr) return nullptr;
+  void* user_ptr = static_cast<char*>(base_ptr) + kHeaderBytes;
+  BlockHeader* header = HeaderOf(user_ptr);
+  header->base_ptr = base_ptr;
+  header->size_class = size_class;
+  return user_ptr;
+}
+
+void* SizeClassAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes > 0 && num_bytes <= kMaxCachedBytes &&
+      alignment <= Allocator::kAllocatorAlignment) {
+    const int size_class = SizeClassFor(num_bytes);
+    std::vector<void*>& magazine = GetThreadCache()->magazines[size_class];
+    if (!magazine.empty()) {
+      void* user_ptr = magazine.back();
+      magazine.pop_back();
+      return user_ptr;
+    }
+    return AllocateFromBase(size_class);
+  }
+
+  // Pass-through path for large or over-aligned requests. The block still
+  // carries a header so that DeallocateRaw can recover the base pointer; the
+  // padding is a multiple of the requested alignment to preserve it.
+  const size_t pad =
+      (kHeaderBytes + alignment - 1) / alignment * alignment;
+  void* base_ptr =
+      base_->AllocateRaw(std::max(alignment, Allocator::kAllocatorAlignment),
+                         num_bytes + pad);
+  if (base_ptr == nullptr) return nullptr;
+  void* user_ptr = static_cast<char*>(base_ptr) + pad;
+  BlockHeader* header = HeaderOf(user_ptr);
+  header->base_ptr = base_ptr;
+  header->size_class = -1;
+  return user_ptr;
+}
+
+void SizeClassAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  BlockHeader* header = HeaderOf(ptr);
+  const int size_class = header->size_class;
+  if (size_class >= 0) {
+    std::vector<void*>& magazine = GetThreadCache()->magazines[size_class];
+    if (magazine.size() < kMagazineCapacity) {
+      magazine.push_back(ptr);
+      return;
+    }
+  }
+  base_->DeallocateRaw(header->base_ptr);
+}
+
+absl::optional<AllocatorStats> SizeClassAllocator::GetStats() {
+  return base_->GetStats();
+}
+
+AllocatorMemoryType SizeClassAllocator::GetMemoryType() const {
+  return base_->GetMemoryType();
+}
+
+}  // namespace tensorflow
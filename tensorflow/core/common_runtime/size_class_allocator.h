@@ -0,0 +1,74 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_SIZE_CLASS_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_SIZE_CLASS_ALLOCATOR_H_
+
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// A thread-caching size-class front end for a slower thread-safe allocator
+// (typically a BFCAllocator). Requests up to kMaxCachedBytes are rounded up
+// to a power-of-two size class and served from a per-thread magazine of
+// previously freed blocks, so steady-state small alloc/free pairs never take
+// the underlying allocator's lock. Larger or over-aligned requests pass
+// through to the underlying allocator.
+//
+// Every block handed out carries a small header written by this allocator,
+// so pointers allocated here must be freed here (as is already the case for
+// any Allocator).
+class SizeClassAllocator : public Allocator {
+ public:
+  // Largest request size served from the per-thread magazines.
+  static constexpr size_t kMaxCachedBytes = 4096;
+
+  // Takes ownership of 'base'.
+  explicit SizeClassAllocator(std::unique_ptr<Allocator> base);
+  ~SizeClassAllocator() override;
+
+  string Name() override;
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  absl::optional<AllocatorStats> GetStats() override;
+
+  AllocatorMemoryType GetMemoryType() const override;
+
+ private:
+  struct ThreadCache;
+
+  // Returns this thread's cache for this allocator, creating it on first use.
+  ThreadCache* GetThreadCache();
+
+  // Allocates a block of the given size class from the underlying allocator
+  // and writes its header.
+  void* AllocateFromBase(int size_class);
+
+  const std::unique_ptr<Allocator> base_;
+
+  SizeClassAllocator(const SizeClassAllocator&) = delete;
+  void operator=(const SizeClassAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_SIZE_CLASS_ALLOCATOR_H_
@@ -0,0 +1,96 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/size_class_allocator.h"
+
+#include <memory>
+
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+// A base allocator that counts calls, so tests can observe whether a request
+// was served from the per-thread magazine or fell through to the base.
+class CountingAllocator : public Allocator {
+ public:
+  string Name() override { return "counting"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    ++num_allocates_;
+    return port::AlignedMalloc(num_bytes, alignment);
+  }
+
+  void DeallocateRaw(void* ptr) override {
+    ++num_deallocates_;
+    port::AlignedFree(ptr);
+  }
+
+  int num_allocates_ = 0;
+  int num_deallocates_ = 0;
+};
+
+TEST(SizeClassAllocatorTest, SmallBlocksAreCached) {
+  auto base = std::make_unique<CountingAllocator>();
+  CountingAllocator* base_ptr = base.get();
+  SizeClassAllocator allocator(std::move(base));
+
+  void* p = allocator.AllocateRaw(Allocator::kAllocatorAlignment, 100);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(base_ptr->num_allocates_, 1);
+
+  // Freeing parks the block in the thread magazine rather than returning it
+  // to the base allocator.
+  allocator.DeallocateRaw(p);
+  EXPECT_EQ(base_ptr->num_deallocates_, 0);
+
+  // A same-class request is served from the magazine without touching the
+  // base allocator.
+  void* q = allocator.AllocateRaw(Allocator::kAllocatorAlignment, 128);
+  EXPECT_EQ(q, p);
+  EXPECT_EQ(base_ptr->num_allocates_, 1);
+  allocator.DeallocateRaw(q);
+}
+
+TEST(SizeClassAllocatorTest, LargeBlocksPassThrough) {
+  auto base = std::make_unique<CountingAllocator>();
+  CountingAllocator* base_ptr = base.get();
+  SizeClassAllocator allocator(std::move(base));
+
+  void* p = allocator.AllocateRaw(Allocator::kAllocatorAlignment,
+                                  SizeClassAllocator::kMaxCachedBytes + 1);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % Allocator::kAllocatorAlignment,
+            0);
+  EXPECT_EQ(base_ptr->num_allocates_, 1);
+
+  allocator.DeallocateRaw(p);
+  EXPECT_EQ(base_ptr->num_deallocates_, 1);
+}
+
+TEST(SizeClassAllocatorTest, OverAlignedRequestsAreAligned) {
+  auto base = std::make_unique<CountingAllocator>();
+  SizeClassAllocator allocator(std::move(base));
+
+  constexpr size_t kAlignment = 256;
+  void* p = allocator.AllocateRaw(kAlignment, 64);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % kAlignment, 0);
+  allocator.DeallocateRaw(p);
+}
+
+}  // namespace
+}  // namespace tensorflow
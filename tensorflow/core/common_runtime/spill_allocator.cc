@@ -0,0 +1,160 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/spill_allocator.h"
+
+#include "tensorflow/core/platform/platform.h"
+
+#if !defined(PLATFORM_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+#include <vector>
+
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+SpillAllocator::SpillAllocator(Allocator* base, const Options& options)
+    : base_(base), options_(options) {}
+
+SpillAllocator::~SpillAllocator() {
+#if !defined(PLATFORM_WINDOWS)
+  mutex_lock l(mu_);
+  for (const auto& entry : spilled_) {
+    munmap(const_cast<void*>(entry.first), entry.second);
+  }
+#endif
+}
+
+string SpillAllocator::Name() {
+  return strings::StrCat("spill_", base_->Name());
+}
+
+void* SpillAllocator::AllocateFileBacked(size_t num_bytes) {
+#if !defined(PLATFORM_WINDOWS)
+  // mmap returns page-aligned memory, which satisfies any alignment the
+  // callers of this path can request (checked in AllocateRaw).
+  string path_template =
+      strings::StrCat(options_.spill_dir, "/tf_spill_XXXXXX");
+  std::vector<char> path(path_template.begin(), path_template.end());
+  path.push_back('\0');
+  const int fd = mkstemp(path.data());
+  if (fd < 0) return nullptr;
+  // Unlink immediately: the mapping keeps the inode alive, and the file
+  // disappears automatically if the process dies.
+  unlink(path.data());
+  if (ftruncate(fd, static_cast<off_t>(num_bytes)) != 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* ptr = mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                   /*offset=*/0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+  if (ptr == MAP_FAILED) return nullptr;
+  {
+    mutex_lock l(mu_);
+    spilled_.emplace(ptr, num_bytes);
+  }
+  VLOG(1) << "SpillAllocator: backed " << num_bytes << " bytes with a file in "
+          << options_.spill_dir;
+  return ptr;
+#else
+  return nullptr;
+#endif
+}
+
+void* SpillAllocator::AllocateRaw(size_t alignment, size_t num_bytes) {
+  if (num_bytes >= options_.spill_threshold_bytes &&
+      alignment <= Allocator::kAllocatorAlignment) {
+    void* ptr = AllocateFileBacked(num_bytes);
+    if (ptr != nullptr) return ptr;
+    {
+      mutex_lock l(mu_);
+      if (!spill_failed_logged_) {
+        spill_failed_logged_ = true;
+        LOG(WARNING) << "SpillAllocator: could not create a file-backed "
+                     << "mapping in '" << options_.spill_dir
+                     << "'; large allocations will use RAM.";
+      }
+    }
+  }
+  return base_->AllocateRaw(alignment, num_bytes);
+}
+
+void SpillAllocator::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+#if !defined(PLATFORM_WINDOWS)
+  size_t num_bytes = 0;
+  {
+    mutex_lock l(mu_);
+    auto iter = spilled_.find(ptr);
+    if (iter != spilled_.end()) {
+      num_bytes = iter->second;
+      spilled_.erase(iter);
+    }
+  }
+  if (num_bytes > 0) {
+    munmap(ptr, num_bytes);
+    return;
+  }
+#endif
+  base_->DeallocateRaw(ptr);
+}
+
+bool SpillAllocator::TracksAllocationSizes() const {
+  return base_->TracksAllocationSizes();
+}
+
+size_t SpillAllocator::RequestedSize(const void* ptr) const {
+  {
+    mutex_lock l(mu_);
+    auto iter = spilled_.find(ptr);
+    if (iter != spilled_.end()) return iter->second;
+  }
+  return base_->RequestedSize(ptr);
+}
+
+size_t SpillAllocator::AllocatedSize(const void* ptr) const {
+  {
+    mutex_lock l(mu_);
+    auto iter = spilled_.find(ptr);
+    if (iter != spilled_.end()) return iter->second;
+  }
+  return base_->AllocatedSize(ptr);
+}
+
+int64_t SpillAllocator::AllocationId(const void* ptr) const {
+  {
+    mutex_lock l(mu_);
+    if (spilled_.count(ptr) > 0) return 0;
+  }
+  return base_->AllocationId(ptr);
+}
+
+absl::optional<AllocatorStats> SpillAllocator::GetStats() {
+  return base_->GetStats();
+}
+
+AllocatorMemoryType SpillAllocator::GetMemoryType() const {
+  return base_->GetMemoryType();
+}
+
+}  // namespace tensorflow
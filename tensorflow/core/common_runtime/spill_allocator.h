@@ -0,0 +1,91 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_SPILL_ALLOCATOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_SPILL_ALLOCATOR_H_
+
+#include <string>
+#include <unordered_map>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// An allocator layer that backs very large requests with a file mapping in a
+// caller-provided spill directory (typically on NVMe), so that oversized
+// tensors degrade to kernel-managed paging instead of triggering a hard OOM.
+//
+// Requests of at least Options::spill_threshold_bytes are served from an
+// anonymous (unlinked) file in Options::spill_dir mapped MAP_SHARED; under
+// memory pressure the kernel writes their cold pages back to the file and
+// drops them, and faults them back in on next touch. Smaller requests, and
+// any request the spill path cannot satisfy, pass through to the wrapped
+// allocator unchanged.
+//
+// Spilling is only implemented on POSIX platforms; elsewhere every request
+// passes through. The wrapped allocator is not owned and must outlive this
+// object.
+class SpillAllocator : public Allocator {
+ public:
+  struct Options {
+    // Directory in which spill files are created. Must already exist.
+    std::string spill_dir;
+    // Smallest request routed to a file-backed mapping.
+    size_t spill_threshold_bytes = 256 << 20;  // 256MB
+  };
+
+  SpillAllocator(Allocator* base, const Options& options);
+  ~SpillAllocator() override;
+
+  string Name() override;
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  bool TracksAllocationSizes() const override;
+  size_t RequestedSize(const void* ptr) const override;
+  size_t AllocatedSize(const void* ptr) const override;
+  int64_t AllocationId(const void* ptr) const override;
+
+  absl::optional<AllocatorStats> GetStats() override;
+
+  AllocatorMemoryType GetMemoryType() const override;
+
+ private:
+  // Maps a fresh unlinked file of at least 'num_bytes' from spill_dir.
+  // Returns nullptr if the platform or the directory cannot support it, in
+  // which case the caller falls back to the wrapped allocator.
+  void* AllocateFileBacked(size_t num_bytes);
+
+  Allocator* const base_;  // not owned
+  const Options options_;
+
+  mutable mutex mu_;
+  // Sizes of live file-backed mappings, keyed by their start address.
+  std::unordered_map<const void*, size_t> spilled_ TF_GUARDED_BY(mu_);
+  // Set once a spill attempt has failed, so the warning is logged only once.
+  bool spill_failed_logged_ TF_GUARDED_BY(mu_) = false;
+
+  SpillAllocator(const SpillAllocator&) = delete;
+  void operator=(const SpillAllocator&) = delete;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_SPILL_ALLOCATOR_H_
@@ -0,0 +1,103 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/spill_allocator.h"
+
+#include <cstring>
+
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/platform.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+// A base allocator that counts calls, so tests can observe whether a request
+// was spilled to a file or fell through to the base.
+class CountingAllocator : public Allocator {
+ public:
+  string Name() override { return "counting"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    ++num_allocates_;
+    return port::AlignedMalloc(num_bytes, alignment);
+  }
+
+  void DeallocateRaw(void* ptr) override {
+    ++num_deallocates_;
+    port::AlignedFree(ptr);
+  }
+
+  int num_allocates_ = 0;
+  int num_deallocates_ = 0;
+};
+
+SpillAllocator::Options TestOptions() {
+  SpillAllocator::Options options;
+  options.spill_dir = testing::TmpDir();
+  options.spill_threshold_bytes = 1 << 20;  // 1MB, to keep the test cheap.
+  return options;
+}
+
+TEST(SpillAllocatorTest, SmallAllocationsPassThrough) {
+  CountingAllocator base;
+  SpillAllocator allocator(&base, TestOptions());
+
+  void* p = allocator.AllocateRaw(Allocator::kAllocatorAlignment, 1024);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(base.num_allocates_, 1);
+
+  allocator.DeallocateRaw(p);
+  EXPECT_EQ(base.num_deallocates_, 1);
+}
+
+#if !defined(PLATFORM_WINDOWS)
+TEST(SpillAllocatorTest, LargeAllocationsAreFileBacked) {
+  CountingAllocator base;
+  SpillAllocator allocator(&base, TestOptions());
+
+  const size_t kBytes = 2 << 20;
+  void* p = allocator.AllocateRaw(Allocator::kAllocatorAlignment, kBytes);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(base.num_allocates_, 0);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % Allocator::kAllocatorAlignment,
+            0);
+  EXPECT_EQ(allocator.RequestedSize(p), kBytes);
+
+  // The mapping is ordinary writable memory.
+  memset(p, 0xab, kBytes);
+  EXPECT_EQ(static_cast<unsigned char*>(p)[kBytes - 1], 0xab);
+
+  allocator.DeallocateRaw(p);
+  EXPECT_EQ(base.num_deallocates_, 0);
+}
+#endif
+
+TEST(SpillAllocatorTest, FallsBackWhenSpillDirIsInvalid) {
+  CountingAllocator base;
+  SpillAllocator::Options options = TestOptions();
+  options.spill_dir = "/nonexistent_spill_dir";
+  SpillAllocator allocator(&base, options);
+
+  void* p = allocator.AllocateRaw(Allocator::kAllocatorAlignment, 2 << 20);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(base.num_allocates_, 1);
+
+  allocator.DeallocateRaw(p);
+  EXPECT_EQ(base.num_deallocates_, 1);
+}
+
+}  // namespace
+}  // namespace tensorflow
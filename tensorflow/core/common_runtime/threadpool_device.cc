@@ -26,9 +26,14 @@ info. It does not have any negative impact on performance. */
 #endif
 #endif  // ENABLE_ONEDNN_OPENMP && ENABLE_MKL &&_OPENMP
 
+#include <cstdlib>
+#include <cstring>
+
 #include "absl/base/call_once.h"
 #include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/common_runtime/local_device.h"
+#include "tensorflow/core/common_runtime/pool_allocator.h"
+#include "tensorflow/core/common_runtime/process_state.h"
 #include "tensorflow/core/common_runtime/scoped_allocator.h"
 #include "tensorflow/core/common_runtime/scoped_allocator_mgr.h"
 #include "tensorflow/core/common_runtime/threadpool_device.h"
@@ -41,9 +46,11 @@ info. It does not have any negative impact on performance. */
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/graph/types.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/tracing.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 
 #ifdef INTEL_MKL
@@ -104,6 +111,22 @@ ThreadPoolDevice::ThreadPoolDevice(const SessionOptions& options,
 ThreadPoolDevice::~ThreadPoolDevice() {}
 
 Allocator* ThreadPoolDevice::GetAllocator(AllocatorAttributes attr) {
+  // In NUMA-partitioned mode, kernels allocate from the arena local to the
+  // NUMA node of the executing thread instead of the device's default
+  // allocator, which avoids cross-socket traffic on multi-socket hosts.
+  // Requires ProcessState NUMA allocators (see ProcessState::EnableNUMA).
+  static const bool numa_partitioned = [] {
+    bool enabled = false;
+    Status s = ReadBoolFromEnvVar("TF_CPU_NUMA_PARTITIONED_ALLOCATOR", false,
+                                  &enabled);
+    if (!s.ok()) {
+      LOG(ERROR) << "GetAllocator: " << s.message();
+    }
+    return enabled;
+  }();
+  if (numa_partitioned) {
+    return ProcessState::singleton()->GetCPUAllocatorForCurrentThread();
+  }
   return allocator_;
 }
 
@@ -250,6 +273,44 @@ void ThreadPoolDevice::LogOutputs(OpKernel* op_kernel,
   LOG(INFO) << "";
 }
 
+namespace {
+
+// Set TF_CPU_ACTIVATION_POOL=1 to serve CPU tensor allocations from an
+// auto-resizing LRU pool instead of going to malloc every time. For
+// shape-stable inference graphs the pool converges on the working set after
+// a few steps, after which every activation allocation is a pool hit and the
+// underlying allocator is not touched at all during a step. This captures
+// most of the benefit of a statically planned activation arena without
+// requiring tensor lifetime analysis, and it remains correct for graphs
+// whose shapes do change (those simply fall through to real allocations).
+bool CpuActivationPoolEnabled() {
+  const char* enabled = getenv("TF_CPU_ACTIVATION_POOL");
+  return enabled != nullptr && strcmp(enabled, "1") == 0;
+}
+
+class ActivationPoolAllocatorFactory : public AllocatorFactory {
+ public:
+  bool NumaEnabled() override { return false; }
+
+  Allocator* CreateAllocator() override {
+    return new PoolAllocator(
+        /*pool_size_limit=*/100, /*auto_resize=*/true,
+        new BasicCPUAllocator(port::kNUMANoAffinity, {}, {}), new NoopRounder,
+        "cpu_activation_pool");
+  }
+
+  SubAllocator* CreateSubAllocator(int numa_node) override {
+    return new BasicCPUAllocator(numa_node, {}, {});
+  }
+};
+
+// Above the default CPUAllocator (100) when enabled, below it otherwise.
+REGISTER_MEM_ALLOCATOR("ActivationPoolAllocator",
+                       (CpuActivationPoolEnabled() ? 150 : 60),
+                       ActivationPoolAllocatorFactory);
+
+}  // namespace
+
 #ifdef INTEL_MKL
 namespace {
 class MklCPUAllocatorFactory : public AllocatorFactory {
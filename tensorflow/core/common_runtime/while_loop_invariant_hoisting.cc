@@ -0,0 +1,305 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/while_loop_invariant_hoisting.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/control_flow.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+namespace {
+
+// A loop variable that cycles through its frame unchanged. `switch_node`
+// output 1 is the value the loop body sees; `outer_value` is the equivalent
+// value in the enclosing frame (the input of the variable's Enter node).
+struct InvariantVariable {
+  string frame_name;
+  NodeOut outer_value;
+};
+
+// Per-frame attributes needed to build new Enter nodes.
+struct FrameInfo {
+  int64_t parallel_iterations = 10;
+};
+
+// Finds loop variables whose NextIteration input traces back, through
+// Identity nodes, to output 1 of the variable's own Switch: the body passes
+// the value through unmodified, so inside the frame it always equals the
+// value that entered the loop.
+Status FindInvariantVariables(
+    const Graph* graph, const std::vector<ControlFlowInfo>& cf_info,
+    absl::flat_hash_map<const Node*, InvariantVariable>* invariant_switches,
+    absl::flat_hash_map<string, FrameInfo>* frames) {
+  for (Node* merge : graph->nodes()) {
+    if (!merge->IsMerge()) continue;
+    const Edge* enter_edge = nullptr;
+    const Edge* next_iteration_edge = nullptr;
+    for (const Edge* e : merge->in_edges()) {
+      if (e->IsControlEdge()) continue;
+      if (e->src()->IsEnter()) enter_edge = e;
+      if (e->src()->IsNextIteration()) next_iteration_edge = e;
+    }
+    if (enter_edge == nullptr || next_iteration_edge == nullptr) continue;
+    if (IsRefType(merge->output_type(0))) continue;
+    // The variable's Switch consumes the Merge on its data input.
+    Node* switch_node = nullptr;
+    for (const Edge* e : merge->out_edges()) {
+      if (!e->IsControlEdge() && e->src_output() == 0 && e->dst()->IsSwitch() &&
+          e->dst_input() == 0) {
+        switch_node = e->dst();
+        break;
+      }
+    }
+    if (switch_node == nullptr) continue;
+    // Trace the NextIteration input back through Identity nodes.
+    const Edge* e;
+    TF_RETURN_IF_ERROR(next_iteration_edge->src()->input_edge(0, &e));
+    const Node* cur = e->src();
+    int cur_port = e->src_output();
+    while (cur->IsIdentity()) {
+      TF_RETURN_IF_ERROR(cur->input_edge(0, &e));
+      cur = e->src();
+      cur_port = e->src_output();
+    }
+    if (cur != switch_node || cur_port != 1) continue;
+
+    const Edge* outer_edge;
+    TF_RETURN_IF_ERROR(enter_edge->src()->input_edge(0, &outer_edge));
+    const string& frame_name = cf_info[switch_node->id()].frame_name;
+    (*invariant_switches)[switch_node] = InvariantVariable{
+        frame_name, NodeOut(outer_edge->src(), outer_edge->src_output())};
+    FrameInfo& frame = (*frames)[frame_name];
+    TryGetNodeAttr(enter_edge->src()->attrs(), "parallel_iterations",
+                   &frame.parallel_iterations);
+  }
+  return OkStatus();
+}
+
+// Returns true if `node` is of a kind that may be moved out of a loop frame:
+// stateless, not itself control flow, and free of ref- or resource-typed
+// inputs and outputs.
+bool IsHoistableKind(const Node* node) {
+  if (!node->IsOp() || node->IsControlFlow() || node->IsSend() ||
+      node->IsRecv() || node->IsArg() || node->IsRetval()) {
+    return false;
+  }
+  if (node->op_def().is_stateful()) return false;
+  for (DataType dt : node->input_types()) {
+    if (IsRefType(dt) || dt == DT_RESOURCE) return false;
+  }
+  for (DataType dt : node->output_types()) {
+    if (IsRefType(dt) || dt == DT_RESOURCE) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+Status HoistWhileLoopInvariants(Graph* graph) {
+  bool has_merge = false;
+  for (const Node* n : graph->nodes()) {
+    if (n->IsMerge()) {
+      has_merge = true;
+      break;
+    }
+  }
+  if (!has_merge) return OkStatus();
+
+  std::vector<ControlFlowInfo> cf_info;
+  std::vector<string> unreachable_nodes;
+  TF_RETURN_IF_ERROR(BuildControlFlowInfo(graph, &cf_info, &unreachable_nodes));
+
+  absl::flat_hash_map<const Node*, InvariantVariable> invariant_switches;
+  absl::flat_hash_map<string, FrameInfo> frames;
+  TF_RETURN_IF_ERROR(FindInvariantVariables(graph, cf_info, &invariant_switches,
+                                            &frames));
+  if (invariant_switches.empty()) return OkStatus();
+
+  // Grow the hoistable set to a fixed point: a node is hoistable if all of
+  // its data inputs are invariant loop variables or other hoistable nodes in
+  // the same frame, and its control inputs come from hoistable nodes (or are
+  // frame-pinning edges on Const nodes, which hoisting makes redundant).
+  std::vector<char> hoistable(graph->num_node_ids(), 0);
+  auto invariant_input = [&](const Edge* e, const string& frame_name) {
+    auto it = invariant_switches.find(e->src());
+    return it != invariant_switches.end() && e->src_output() == 1 &&
+           it->second.frame_name == frame_name;
+  };
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (Node* n : graph->nodes()) {
+      if (hoistable[n->id()] || !IsHoistableKind(n)) continue;
+      const string& frame_name = cf_info[n->id()].frame_name;
+      if (frame_name.empty() || !frames.contains(frame_name)) continue;
+      bool ok = true;
+      for (const Edge* e : n->in_edges()) {
+        if (e->IsControlEdge()) {
+          if (!hoistable[e->src()->id()] && !n->IsConstant()) ok = false;
+        } else if (!hoistable[e->src()->id()] &&
+                   !invariant_input(e, frame_name)) {
+          ok = false;
+        }
+        if (!ok) break;
+      }
+      if (ok) {
+        hoistable[n->id()] = 1;
+        changed = true;
+      }
+    }
+  }
+
+  // Shrink the set back to a fixed point: a node with a control-dependent
+  // consumer that stays in the loop cannot be moved (the dependency cannot
+  // cross the frame boundary), and removing it invalidates anything that
+  // consumed it.
+  changed = true;
+  while (changed) {
+    changed = false;
+    for (Node* n : graph->nodes()) {
+      if (!hoistable[n->id()]) continue;
+      const string& frame_name = cf_info[n->id()].frame_name;
+      bool ok = true;
+      for (const Edge* e : n->out_edges()) {
+        if (e->IsControlEdge() && !hoistable[e->dst()->id()]) {
+          ok = false;
+          break;
+        }
+      }
+      if (ok) {
+        for (const Edge* e : n->in_edges()) {
+          if (e->IsControlEdge()) {
+            if (!hoistable[e->src()->id()] && !n->IsConstant()) ok = false;
+          } else if (!hoistable[e->src()->id()] &&
+                     !invariant_input(e, frame_name)) {
+            ok = false;
+          }
+          if (!ok) break;
+        }
+      }
+      if (!ok) {
+        hoistable[n->id()] = 0;
+        changed = true;
+      }
+    }
+  }
+
+  // Group the hoistable nodes per frame in topological order, and drop frames
+  // where hoisting would only move constants around.
+  std::vector<Node*> order;
+  GetReversePostOrder(*graph, &order);
+  absl::flat_hash_map<string, std::vector<Node*>> per_frame;
+  for (Node* n : order) {
+    if (hoistable[n->id()]) {
+      per_frame[cf_info[n->id()].frame_name].push_back(n);
+    }
+  }
+
+  for (auto& entry : per_frame) {
+    const string& frame_name = entry.first;
+    std::vector<Node*>& nodes = entry.second;
+    bool all_constants = true;
+    for (const Node* n : nodes) {
+      if (!n->IsConstant()) {
+        all_constants = false;
+        break;
+      }
+    }
+    if (all_constants) continue;
+    const FrameInfo& frame = frames[frame_name];
+
+    // Copy the nodes into the enclosing frame, reading invariant loop
+    // variables from their pre-loop values.
+    absl::flat_hash_map<const Node*, Node*> copies;
+    for (Node* n : nodes) {
+      NodeDef ndef = n->def();
+      ndef.clear_input();
+      ndef.set_name(graph->NewName(n->name()));
+      // Colocation constraints may name nodes that stay inside the loop.
+      ndef.mutable_attr()->erase("_class");
+      Status status;
+      Node* copy = graph->AddNode(ndef, &status);
+      TF_RETURN_IF_ERROR(status);
+      copies[n] = copy;
+      for (const Edge* e : n->in_edges()) {
+        if (e->IsControlEdge()) {
+          if (hoistable[e->src()->id()]) {
+            graph->AddControlEdge(copies[e->src()], copy);
+          }
+          // Frame-pinning control edges on constants are dropped.
+        } else if (hoistable[e->src()->id()]) {
+          graph->AddEdge(copies[e->src()], e->src_output(), copy,
+                         e->dst_input());
+        } else {
+          const NodeOut& outer = invariant_switches[e->src()].outer_value;
+          graph->AddEdge(outer.node, outer.index, copy, e->dst_input());
+        }
+      }
+    }
+
+    // Feed each value still needed inside the loop back in through a
+    // constant Enter, making it available in every iteration.
+    absl::flat_hash_map<std::pair<const Node*, int>, Node*> enters;
+    for (Node* n : nodes) {
+      const std::vector<const Edge*> out_edges(n->out_edges().begin(),
+                                               n->out_edges().end());
+      for (const Edge* e : out_edges) {
+        if (hoistable[e->dst()->id()]) continue;
+        Node*& enter = enters[{n, e->src_output()}];
+        if (enter == nullptr) {
+          TF_RETURN_IF_ERROR(
+              NodeBuilder(graph->NewName(strings::StrCat(n->name(), "/enter")),
+                          "Enter")
+                  .Input(NodeOut(copies[n], e->src_output()))
+                  .Attr("frame_name", frame_name)
+                  .Attr("is_constant", true)
+                  .Attr("parallel_iterations", frame.parallel_iterations)
+                  .Device(n->requested_device())
+                  .Finalize(graph, &enter));
+        }
+        Node* dst = e->dst();
+        const int dst_input = e->dst_input();
+        graph->RemoveEdge(e);
+        graph->AddEdge(enter, 0, dst, dst_input);
+      }
+    }
+
+    std::vector<string> hoisted_names;
+    hoisted_names.reserve(nodes.size());
+    for (Node* n : nodes) {
+      hoisted_names.push_back(n->name());
+      graph->RemoveNode(n);
+    }
+    LOG(INFO) << "Hoisted " << hoisted_names.size()
+              << " loop-invariant node(s) out of frame '" << frame_name
+              << "': " << absl::StrJoin(hoisted_names, ", ");
+  }
+  return OkStatus();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,46 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_WHILE_LOOP_INVARIANT_HOISTING_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_WHILE_LOOP_INVARIANT_HOISTING_H_
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+
+// Hoists loop-invariant computations out of lowered while loops.
+//
+// After `While` ops have been lowered to Enter/Merge/Switch/NextIteration
+// frames and their body functions inlined, a loop variable whose body output
+// is its own unmodified input cycles through the frame unchanged. Any
+// stateless computation that depends only on such variables (and on constants)
+// produces the same value in every iteration, but is re-executed per
+// iteration by the executor. This pass moves those computations in front of
+// the loop and feeds their results back into the frame through constant
+// `Enter` nodes, so they run exactly once per loop execution.
+//
+// Only stateless nodes without ref- or resource-typed inputs or outputs are
+// moved, and a node is never moved if a node remaining in the loop has a
+// control dependency on it. Note that hoisted nodes run even if the loop body
+// ends up executing zero iterations, which is why this rewrite is opt-in (see
+// TF_WHILE_LOOP_INVARIANT_HOISTING in lower_functional_ops.cc).
+//
+// Logs a per-loop report of the hoisted nodes.
+Status HoistWhileLoopInvariants(Graph* graph);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_WHILE_LOOP_INVARIANT_HOISTING_H_
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/data/compression_utils.h"
 
+#include <cstring>
 #include <limits>
 #include <string>
 #include <vector>
@@ -34,7 +35,12 @@ namespace {
 // Increment this when making changes to the `CompressedElement` proto. The
 // `UncompressElement` function will determine what to read according to the
 // version.
-constexpr int kCompressedElementVersion = 0;
+constexpr int kCompressedElementVersion = 1;
+
+// Skip compression for elements smaller than this threshold: for tiny
+// elements, the CPU cost of compression outweighs the bytes it saves, and the
+// compressed output can even be larger than the input.
+constexpr size_t kCompressionThresholdBytes = 128;
 
 }  // namespace
 
@@ -125,19 +131,32 @@ Status CompressElement(const std::vector<Tensor>& element,
                               iov.NumBytes(),
                               ", exceeding the 4GB Snappy limit.");
   }
-  if (!port::Snappy_CompressFromIOVec(iov.Data(), iov.NumBytes(),
-                                      out->mutable_data())) {
+  if (iov.NumBytes() < kCompressionThresholdBytes) {
+    // The element is too small for compression to pay off; store the raw
+    // bytes instead.
+    out->set_is_uncompressed(true);
+    std::string* data = out->mutable_data();
+    data->resize(iov.NumBytes());
+    char* data_pos = data->data();
+    for (size_t i = 0; i < iov.NumPieces(); ++i) {
+      memcpy(data_pos, iov.Data()[i].iov_base, iov.Data()[i].iov_len);
+      data_pos += iov.Data()[i].iov_len;
+    }
+  } else if (!port::Snappy_CompressFromIOVec(iov.Data(), iov.NumBytes(),
+                                             out->mutable_data())) {
     return errors::Internal("Failed to compress using snappy.");
   }
   out->set_version(kCompressedElementVersion);
   VLOG(3) << "Compressed element from " << iov.NumBytes() << " bytes to "
-          << out->data().size() << " bytes";
+          << out->data().size() << " bytes"
+          << (out->is_uncompressed() ? " (stored uncompressed)" : "");
   return OkStatus();
 }
 
 Status UncompressElement(const CompressedElement& compressed,
                          std::vector<Tensor>* out) {
-  if (compressed.version() != kCompressedElementVersion) {
+  if (compressed.version() < 0 ||
+      compressed.version() > kCompressedElementVersion) {
     return errors::Internal("Unsupported compressed element version: ",
                             compressed.version());
   }
@@ -191,22 +210,39 @@ Status UncompressElement(const CompressedElement& compressed,
 
   // Step 2: Uncompress into the iovec.
   const std::string& compressed_data = compressed.data();
-  size_t uncompressed_size;
-  if (!port::Snappy_GetUncompressedLength(
-          compressed_data.data(), compressed_data.size(), &uncompressed_size)) {
-    return errors::Internal(
-        "Could not get snappy uncompressed length. Compressed data size: ",
-        compressed_data.size());
-  }
-  if (uncompressed_size != static_cast<size_t>(iov.NumBytes())) {
-    return errors::Internal(
-        "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
-        " whereas the tensor metadata suggests ", iov.NumBytes());
-  }
-  if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
-                                      compressed_data.size(), iov.Data(),
-                                      iov.NumPieces())) {
-    return errors::Internal("Failed to perform snappy decompression.");
+  if (compressed.is_uncompressed()) {
+    // The element was small enough that compression was skipped; copy the raw
+    // bytes directly.
+    if (compressed_data.size() != static_cast<size_t>(iov.NumBytes())) {
+      return errors::Internal(
+          "Uncompressed size mismatch. The data holds ",
+          compressed_data.size(), " bytes whereas the tensor metadata suggests ",
+          iov.NumBytes());
+    }
+    const char* data_pos = compressed_data.data();
+    for (size_t i = 0; i < iov.NumPieces(); ++i) {
+      memcpy(iov.Data()[i].iov_base, data_pos, iov.Data()[i].iov_len);
+      data_pos += iov.Data()[i].iov_len;
+    }
+  } else {
+    size_t uncompressed_size;
+    if (!port::Snappy_GetUncompressedLength(compressed_data.data(),
+                                            compressed_data.size(),
+                                            &uncompressed_size)) {
+      return errors::Internal(
+          "Could not get snappy uncompressed length. Compressed data size: ",
+          compressed_data.size());
+    }
+    if (uncompressed_size != static_cast<size_t>(iov.NumBytes())) {
+      return errors::Internal(
+          "Uncompressed size mismatch. Snappy expects ", uncompressed_size,
+          " whereas the tensor metadata suggests ", iov.NumBytes());
+    }
+    if (!port::Snappy_UncompressToIOVec(compressed_data.data(),
+                                        compressed_data.size(), iov.Data(),
+                                        iov.NumPieces())) {
+      return errors::Internal("Failed to perform snappy decompression.");
+    }
   }
 
   // Third pass: deserialize nonstring, non`memcpy`able tensors.
@@ -29,6 +29,9 @@ namespace data {
 // In addition to writing the actual compressed bytes, `Compress` fills
 // out the per-component metadata for the `CompressedElement`.
 //
+// Elements too small for compression to pay off are stored uncompressed, with
+// `is_uncompressed` set in the resulting proto.
+//
 // Returns an error if the uncompressed size of the element exceeds 4GB.
 Status CompressElement(const std::vector<Tensor>& element,
                        CompressedElement* out);
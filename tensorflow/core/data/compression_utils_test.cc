@@ -30,6 +30,21 @@ namespace {
 using ::testing::HasSubstr;
 using ::tsl::testing::StatusIs;
 
+TEST(CompressionUtilsTest, TinyElementsAreStoredUncompressed) {
+  std::vector<Tensor> element =
+      CreateTensors<int64_t>(TensorShape{1}, {{1}, {2}});
+  CompressedElement compressed;
+  TF_ASSERT_OK(CompressElement(element, &compressed));
+  EXPECT_TRUE(compressed.is_uncompressed());
+}
+
+TEST(CompressionUtilsTest, LargeElementsAreCompressed) {
+  std::vector<Tensor> element = {CreateTensor<int64_t>(TensorShape{128, 128})};
+  CompressedElement compressed;
+  TF_ASSERT_OK(CompressElement(element, &compressed));
+  EXPECT_FALSE(compressed.is_uncompressed());
+}
+
 TEST(CompressionUtilsTest, Exceeds4GB) {
   std::vector<Tensor> element = {
       CreateTensor<int64_t>(TensorShape{1024, 1024, 513})};  // Just over 4GB.
@@ -90,7 +105,7 @@ TEST_P(ParameterizedCompressionUtilsTest, CompressedElementVersion) {
   std::vector<Tensor> element = GetParam();
   CompressedElement compressed;
   TF_ASSERT_OK(CompressElement(element, &compressed));
-  EXPECT_EQ(0, compressed.version());
+  EXPECT_EQ(1, compressed.version());
 }
 
 TEST_P(ParameterizedCompressionUtilsTest, VersionMismatch) {
@@ -98,7 +113,7 @@ TEST_P(ParameterizedCompressionUtilsTest, VersionMismatch) {
   CompressedElement compressed;
   TF_ASSERT_OK(CompressElement(element, &compressed));
 
-  compressed.set_version(1);
+  compressed.set_version(2);
   std::vector<Tensor> round_trip_element;
   EXPECT_THAT(UncompressElement(compressed, &round_trip_element),
               StatusIs(error::INTERNAL));
@@ -58,8 +58,12 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
 #include "tensorflow/core/grappler/optimizers/meta_optimizer.h"
 #include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/tstring.h"
@@ -67,6 +71,8 @@ limitations under the License.
 #include "tensorflow/core/protobuf/device_properties.pb.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
+#include "tensorflow/core/public/version.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -76,6 +82,124 @@ constexpr char kOptimizerName[] = "tf_data_meta_optimizer";
 constexpr char kOptimizers[] = "optimizers";
 constexpr char kOptimizerConfigs[] = "optimizer_configs";
 
+// Marker node added to cached graphs to record which node represents the
+// rewritten dataset, mirroring the symbolic `_Retval` convention used by
+// `AsGraphDef`. It is stripped when the cached graph is loaded.
+constexpr char kRewriteCacheRetvalName[] = "_tf_data_rewrite_cache_retval";
+
+// When TF_DATA_REWRITE_CACHE_DIR is set to a directory, optimized dataset
+// graphs are cached there keyed by a fingerprint of the pre-rewrite graph and
+// the rewriter configuration, and reused by subsequent processes so that
+// identical pipelines skip the grappler rewrite pass entirely. The fingerprint
+// incorporates the TensorFlow version since graph hashes are not guaranteed to
+// be stable across builds.
+const string& RewriteCacheDirectory() {
+  static const string* const directory = []() {
+    string value;
+    Status s = ReadStringFromEnvVar("TF_DATA_REWRITE_CACHE_DIR", "", &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_REWRITE_CACHE_DIR: " << s;
+    }
+    return new string(value);
+  }();
+  return *directory;
+}
+
+// In-memory view of the rewrite cache, so that repeated rewrites within a
+// process do not re-read the persisted files.
+mutex* RewriteCacheMu() {
+  static mutex* const mu = new mutex;
+  return mu;
+}
+
+std::unordered_map<uint64, std::pair<GraphDef, string>>* RewriteCache() {
+  static auto* const cache =
+      new std::unordered_map<uint64, std::pair<GraphDef, string>>();
+  return cache;
+}
+
+Status RewriteCacheKey(const GraphDef& graph_def,
+                       const RewriterConfig& rewriter_config, uint64* key) {
+  uint64 graph_hash = 0;
+  TF_RETURN_IF_ERROR(HashGraph(graph_def, &graph_hash));
+  *key = Hash64Combine(
+      Hash64(TF_VERSION_STRING),
+      Hash64Combine(graph_hash, DeterministicProtoHash64(rewriter_config)));
+  return OkStatus();
+}
+
+string RewriteCachePath(uint64 key) {
+  return io::JoinPath(
+      RewriteCacheDirectory(),
+      strings::StrCat("tf_data_rewrite_", strings::Hex(key, strings::kZeroPad16),
+                      ".pb"));
+}
+
+// Returns true and populates `graph_def` and `dataset_node` if an optimized
+// graph for `key` is available in memory or on disk.
+bool LookupRewriteCache(uint64 key, GraphDef* graph_def, string* dataset_node) {
+  {
+    mutex_lock l(*RewriteCacheMu());
+    auto it = RewriteCache()->find(key);
+    if (it != RewriteCache()->end()) {
+      *graph_def = it->second.first;
+      *dataset_node = it->second.second;
+      return true;
+    }
+  }
+  GraphDef cached;
+  if (!ReadBinaryProto(Env::Default(), RewriteCachePath(key), &cached).ok()) {
+    return false;
+  }
+  string output_node;
+  for (int i = 0; i < cached.node_size(); ++i) {
+    if (cached.node(i).name() == kRewriteCacheRetvalName) {
+      output_node = cached.node(i).input(0);
+      cached.mutable_node()->DeleteSubrange(i, 1);
+      break;
+    }
+  }
+  if (output_node.empty()) {
+    LOG(WARNING) << "Ignoring malformed tf.data rewrite cache entry: "
+                 << RewriteCachePath(key);
+    return false;
+  }
+  mutex_lock l(*RewriteCacheMu());
+  RewriteCache()->emplace(key, std::make_pair(cached, output_node));
+  *graph_def = std::move(cached);
+  *dataset_node = std::move(output_node);
+  return true;
+}
+
+void StoreRewriteCache(uint64 key, const GraphDef& graph_def,
+                       const string& dataset_node) {
+  {
+    mutex_lock l(*RewriteCacheMu());
+    RewriteCache()->emplace(key, std::make_pair(graph_def, dataset_node));
+  }
+  GraphDef to_store = graph_def;
+  NodeDef* retval = to_store.add_node();
+  retval->set_name(kRewriteCacheRetvalName);
+  retval->set_op("_Retval");
+  retval->add_input(dataset_node);
+  (*retval->mutable_attr())["T"].set_type(DT_VARIANT);
+  (*retval->mutable_attr())["index"].set_i(0);
+  // Write through a temporary file and rename so that concurrent processes
+  // never observe a partially written entry.
+  const string path = RewriteCachePath(key);
+  const string tmp_path =
+      strings::StrCat(path, ".tmp-", random::New64());
+  Status s = WriteBinaryProto(Env::Default(), tmp_path, to_store);
+  if (s.ok()) {
+    s = Env::Default()->RenameFile(tmp_path, path);
+  }
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to persist tf.data rewrite cache entry " << path
+                 << ": " << s;
+    Env::Default()->DeleteFile(tmp_path).IgnoreError();
+  }
+}
+
 void AddFakeSinks(FunctionDef* function_def) {
   int counter = 0;
   for (const auto& output : function_def->signature().output_arg()) {
@@ -112,6 +236,23 @@ void RemoveFakeSinks(FunctionDef* function_def) {
 Status ApplyRewrites(OpKernelContext* ctx,
                      const std::function<RewriterConfig(void)> config_factory,
                      GraphDef* graph_def, string* dataset_node) {
+  RewriterConfig rewriter_config = config_factory();
+  bool use_cache = !RewriteCacheDirectory().empty();
+  uint64 cache_key = 0;
+  if (use_cache) {
+    Status s = RewriteCacheKey(*graph_def, rewriter_config, &cache_key);
+    if (s.ok()) {
+      if (LookupRewriteCache(cache_key, graph_def, dataset_node)) {
+        VLOG(2) << "Reusing cached tf.data rewrite for fingerprint "
+                << strings::Hex(cache_key, strings::kZeroPad16);
+        return OkStatus();
+      }
+    } else {
+      LOG(WARNING) << "Failed to compute tf.data rewrite cache key: " << s;
+      use_cache = false;
+    }
+  }
+
   std::unique_ptr<tensorflow::grappler::GrapplerItem> grappler_item =
       GetGrapplerItem(graph_def, dataset_node, /*add_fake_sinks=*/true);
   std::unordered_map<std::string, tensorflow::DeviceProperties> device_map;
@@ -119,7 +260,8 @@ Status ApplyRewrites(OpKernelContext* ctx,
 
   // Run data optimizer using grappler's meta optimizer.
   tensorflow::ConfigProto config;
-  *config.mutable_graph_options()->mutable_rewrite_options() = config_factory();
+  *config.mutable_graph_options()->mutable_rewrite_options() =
+      std::move(rewriter_config);
   TF_RETURN_IF_ERROR(tensorflow::grappler::RunMetaOptimizer(
       std::move(*grappler_item), config, ctx->device(), &cluster, graph_def));
 
@@ -131,6 +273,10 @@ Status ApplyRewrites(OpKernelContext* ctx,
     RemoveFakeSinks(&function_def);
   }
 
+  if (use_cache) {
+    StoreRewriteCache(cache_key, *graph_def, *dataset_node);
+  }
+
   return OkStatus();
 }
 }  // anonymous namespace
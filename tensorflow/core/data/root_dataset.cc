@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/rewrite_utils.h"
+#include "tensorflow/core/data/shared_thread_pool.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/dataset_options.pb.h"
 #include "tensorflow/core/framework/model.h"
@@ -320,6 +321,15 @@ class RootDataset::Iterator : public DatasetIterator<RootDataset> {
         pool->Schedule(std::move(c));
       };
       params.runner_threadpool_size = threadpool_size_;
+    } else if (thread::ThreadPool* shared_pool = GetSharedThreadPool()) {
+      // Without an explicit private thread pool, run the input pipeline on
+      // the process-wide shared tf.data worker pool (when configured) so the
+      // total input-pipeline parallelism stays capped no matter how many
+      // iterators are live.
+      params.runner = [shared_pool](std::function<void()> c) {
+        shared_pool->Schedule(std::move(c));
+      };
+      params.runner_threadpool_size = shared_pool->NumThreads();
     }
     if (dataset()->params_.max_intra_op_parallelism >= 0) {
       params.runner =
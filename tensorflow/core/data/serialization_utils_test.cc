@@ -82,6 +82,51 @@ TEST(SerializationUtilsTest, CheckpointElementsRoundTrip) {
   }
 }
 
+TEST(SerializationUtilsTest, CheckpointElementsDeltaRoundTrip) {
+  std::vector<std::vector<Tensor>> elements;
+  elements.push_back(CreateTensors<int32>(TensorShape({3}), {{1, 2, 3}}));
+  elements.push_back(CreateTensors<int32>(TensorShape({2}), {{4, 5}}));
+  elements.push_back(CreateTensors<int32>(TensorShape({1}), {{6}}));
+  tstring test_prefix = full_name("test_prefix");
+
+  // Write a full base checkpoint.
+  VariantTensorDataWriter base_writer;
+  TF_ASSERT_OK(WriteElementsToCheckpoint(&base_writer, test_prefix, elements));
+  std::vector<const VariantTensorData*> base_data;
+  base_writer.GetData(&base_data);
+
+  // Mutate one element and write a delta containing only that element.
+  elements[1] = CreateTensors<int32>(TensorShape({2}), {{7, 8}});
+  VariantTensorDataWriter delta_writer;
+  TF_ASSERT_OK(UpdateCheckpointElements(&delta_writer, test_prefix, elements,
+                                        /*checkpoint_indices=*/{1}));
+  std::vector<const VariantTensorData*> delta_data;
+  delta_writer.GetData(&delta_data);
+
+  // Layer the delta on top of the base checkpoint: later entries replace
+  // earlier entries with the same name.
+  std::vector<const VariantTensorData*> data = base_data;
+  data.insert(data.end(), delta_data.begin(), delta_data.end());
+
+  VariantTensorDataReader reader(data);
+  std::vector<std::vector<Tensor>> read_elements;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<TestContext> ctx,
+                          TestContext::Create());
+  TF_ASSERT_OK(ReadElementsFromCheckpoint(ctx->iter_ctx(), &reader, test_prefix,
+                                          &read_elements));
+  ASSERT_EQ(elements.size(), read_elements.size());
+  for (int i = 0; i < elements.size(); ++i) {
+    std::vector<Tensor>& original = elements[i];
+    std::vector<Tensor>& read = read_elements[i];
+
+    ASSERT_EQ(original.size(), read.size());
+    for (int j = 0; j < original.size(); ++j) {
+      EXPECT_EQ(original[j].NumElements(), read[j].NumElements());
+      EXPECT_EQ(original[j].flat<int32>()(0), read[j].flat<int32>()(0));
+    }
+  }
+}
+
 TEST(SerializationUtilsTest, VariantTensorDataRoundtrip) {
   VariantTensorDataWriter writer;
   TF_ASSERT_OK(writer.WriteScalar(full_name("Int64"), 24));
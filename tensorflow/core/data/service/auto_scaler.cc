@@ -130,6 +130,19 @@ std::optional<int64_t> AutoScaler::GetOptimalNumberOfWorkers() const
   return std::max(int64_t{1}, optimal_number_of_workers);
 }
 
+bool AutoScaler::IsStragglerWorker(const std::string& worker_address,
+                                   double straggler_ratio) const
+    TF_LOCKS_EXCLUDED(mu_) {
+  tsl::mutex_lock l(mu_);
+  if (worker_throughputs_.size() < 2) return false;
+  auto worker_throughput = worker_throughputs_.find(worker_address);
+  if (worker_throughput == worker_throughputs_.end()) return false;
+
+  double average_worker_throughput = GetMean(worker_throughputs_);
+  return worker_throughput->second <
+         straggler_ratio * average_worker_throughput;
+}
+
 tsl::Status AutoScaler::ReportProcessingTime(const std::string& worker_address,
                                              absl::Duration processing_time)
     TF_LOCKS_EXCLUDED(mu_) {
@@ -263,6 +276,16 @@ std::optional<int64_t> MultipleIterationsAutoScaler::GetOptimalNumberOfWorkers()
     return optimal_number_of_workers;
 }
 
+bool MultipleIterationsAutoScaler::IsStragglerWorker(
+    int64_t iteration_id, const std::string& worker_address,
+    double straggler_ratio) const TF_LOCKS_EXCLUDED(mu_) {
+  tsl::tf_shared_lock l(mu_);
+  auto auto_scaler = auto_scalers_.find(iteration_id);
+  if (auto_scaler == auto_scalers_.end()) return false;
+  return auto_scaler->second->IsStragglerWorker(worker_address,
+                                                straggler_ratio);
+}
+
 tsl::Status MultipleIterationsAutoScaler::ReportProcessingTime(
     int64_t iteration_id, const std::string& worker_address,
     absl::Duration processing_time) TF_LOCKS_EXCLUDED(mu_) {
@@ -73,6 +73,12 @@ class AutoScaler {
   // target processing times, returns nullopt.
   std::optional<int64_t> GetOptimalNumberOfWorkers() const
       TF_LOCKS_EXCLUDED(mu_);
+  // Returns true if the worker with `worker_address` is currently a straggler,
+  // i.e. its reported throughput is less than `straggler_ratio` times the
+  // average throughput of all workers. Returns false if fewer than two workers
+  // have reported processing times, or if the specified worker has not.
+  bool IsStragglerWorker(const std::string& worker_address,
+                         double straggler_ratio) const TF_LOCKS_EXCLUDED(mu_);
   // Reports the latest observed processing time from the worker with
   // `worker_address`. Returns an error if `processing_time` is ZeroDuration or
   // negative.
@@ -131,6 +137,15 @@ class MultipleIterationsAutoScaler {
   // target processing times for at least one iteration, returns nullopt.
   std::optional<int64_t> GetOptimalNumberOfWorkers() const
       TF_LOCKS_EXCLUDED(mu_);
+  // Returns true if the worker with `worker_address` is currently a straggler
+  // for iteration with `iteration_id`, i.e. its reported throughput is less
+  // than `straggler_ratio` times the average throughput of the iteration's
+  // workers. Returns false if the iteration is not registered, if fewer than
+  // two of its workers have reported processing times, or if the specified
+  // worker has not.
+  bool IsStragglerWorker(int64_t iteration_id,
+                         const std::string& worker_address,
+                         double straggler_ratio) const TF_LOCKS_EXCLUDED(mu_);
   // Reports the latest observed processing time from the worker with
   // `worker_address` for iteration with `iteration_id`. Returns an error if
   // `processing_time` is ZeroDuration or negative.
@@ -214,6 +214,52 @@ TEST(AutoScalerTest, ReportProcessingTimeNegativeDuration) {
   EXPECT_THAT(result, StatusIs(absl::StatusCode::kInvalidArgument));
 }
 
+TEST(AutoScalerTest, IsStragglerWorkerNoRegisteredWorkers) {
+  AutoScaler auto_scaler;
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/0:20000", 0.5));
+}
+
+TEST(AutoScalerTest, IsStragglerWorkerSingleWorker) {
+  AutoScaler auto_scaler;
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/0:20000",
+                                                absl::Microseconds(100)));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/0:20000", 0.5));
+}
+
+TEST(AutoScalerTest, IsStragglerWorkerUnknownWorker) {
+  AutoScaler auto_scaler;
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/0:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/1:20000",
+                                                absl::Microseconds(10)));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/2:20000", 0.5));
+}
+
+TEST(AutoScalerTest, IsStragglerWorkerFlagsSlowWorker) {
+  AutoScaler auto_scaler;
+  // Throughputs: 0.1, 0.1 and 0.01 elements per us. The mean is 0.07, so only
+  // the last worker is below half the mean.
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/0:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/1:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/2:20000",
+                                                absl::Microseconds(100)));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/0:20000", 0.5));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/1:20000", 0.5));
+  EXPECT_TRUE(auto_scaler.IsStragglerWorker("/worker/task/2:20000", 0.5));
+}
+
+TEST(AutoScalerTest, IsStragglerWorkerSimilarWorkers) {
+  AutoScaler auto_scaler;
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/0:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime("/worker/task/1:20000",
+                                                absl::Microseconds(12)));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/0:20000", 0.5));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker("/worker/task/1:20000", 0.5));
+}
+
 TEST(AutoScalerTest, ReportTargetProcessingTimeNewConsumer) {
   AutoScaler auto_scaler;
   TF_ASSERT_OK(
@@ -600,6 +646,40 @@ TEST(MultipleIterationsAutoScalerTest, ReportProcessingTimeNegativeDuration) {
   EXPECT_THAT(result, StatusIs(absl::StatusCode::kInvalidArgument));
 }
 
+TEST(MultipleIterationsAutoScalerTest, IsStragglerWorkerUnregisteredIteration) {
+  MultipleIterationsAutoScaler auto_scaler;
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker(0, "/worker/task/0:20000", 0.5));
+}
+
+TEST(MultipleIterationsAutoScalerTest, IsStragglerWorkerFlagsSlowWorker) {
+  MultipleIterationsAutoScaler auto_scaler;
+
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/0:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/1:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/2:20000",
+                                                absl::Microseconds(100)));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker(0, "/worker/task/0:20000", 0.5));
+  EXPECT_TRUE(auto_scaler.IsStragglerWorker(0, "/worker/task/2:20000", 0.5));
+}
+
+TEST(MultipleIterationsAutoScalerTest, IsStragglerWorkerPerIteration) {
+  MultipleIterationsAutoScaler auto_scaler;
+
+  // The same worker can be a straggler for one iteration but not another.
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/0:20000",
+                                                absl::Microseconds(10)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(0, "/worker/task/1:20000",
+                                                absl::Microseconds(100)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(1, "/worker/task/0:20000",
+                                                absl::Microseconds(100)));
+  TF_ASSERT_OK(auto_scaler.ReportProcessingTime(1, "/worker/task/1:20000",
+                                                absl::Microseconds(100)));
+  EXPECT_TRUE(auto_scaler.IsStragglerWorker(0, "/worker/task/1:20000", 0.5));
+  EXPECT_FALSE(auto_scaler.IsStragglerWorker(1, "/worker/task/1:20000", 0.5));
+}
+
 TEST(MultipleIterationsAutoScalerTest, ReportTargetProcessingTimeNewIteration) {
   MultipleIterationsAutoScaler auto_scaler;
   TF_ASSERT_OK(
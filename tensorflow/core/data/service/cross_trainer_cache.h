@@ -16,9 +16,9 @@ limitations under the License.
 #define TENSORFLOW_CORE_DATA_SERVICE_CROSS_TRAINER_CACHE_H_
 
 #include <cstddef>
-#include <deque>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -46,6 +46,14 @@ namespace data {
 // collected when the cache becomes full. Consequently, trainers read from a
 // sliding window through the dataset and may not read the full dataset.
 //
+// Eviction is popularity-aware: elements read by multiple trainers are
+// promoted to a protected segment and survive eviction longer than elements
+// read by a single trainer, so slow trainers are more likely to find the data
+// they need without the cache holding the entire window in memory. Optionally,
+// per-trainer read positions can be bounded to lag at most
+// `max_trainer_skew_elements` behind the newest cached element; trainers that
+// fall further behind are skipped ahead.
+//
 // The `CrossTrainerCache` class is thread-safe.
 //
 // Example usage:
@@ -98,9 +106,14 @@ class CrossTrainerCache {
   // Creates a `CrossTrainerCache` with `max_cache_size_bytes` of memory budget.
   // The cache should be able to hold at least one element, i.e.:
   // REQUIRES: `max_cache_size_bytes >= max(GetElementSizeBytes(*))`
+  // `max_trainer_skew_elements` bounds how many elements a trainer may lag
+  // behind the newest cached element before it is skipped ahead. The default
+  // does not bound the skew, in which case trainers are only skipped ahead
+  // when the elements they need have been evicted.
   explicit CrossTrainerCache(
       size_t max_cache_size_bytes,
-      std::unique_ptr<CachableSequence<ElementType>> cachable_sequence);
+      std::unique_ptr<CachableSequence<ElementType>> cachable_sequence,
+      size_t max_trainer_skew_elements = std::numeric_limits<size_t>::max());
   virtual ~CrossTrainerCache() = default;
   CrossTrainerCache(const CrossTrainerCache&) = delete;
   CrossTrainerCache& operator=(const CrossTrainerCache&) = delete;
@@ -126,6 +139,22 @@ class CrossTrainerCache {
     bool cache_hit;
   };
 
+  // A cached element and its eviction metadata. Elements start in the
+  // probationary segment; once `hit_count` reaches `kProtectedHitCount`, the
+  // element is promoted to the protected segment and is only evicted when no
+  // probationary element remains.
+  struct CachedElement {
+    std::shared_ptr<const ElementType> element;
+    size_t size_bytes = 0;
+    size_t hit_count = 0;
+    bool is_protected = false;
+  };
+
+  // Number of reads after which an element is promoted to the protected
+  // segment. Since a trainer never re-reads an element, the hit count
+  // approximates the number of distinct trainers that have read it.
+  static constexpr size_t kProtectedHitCount = 2;
+
   // Returns the next element and metrics about this query.
   StatusOr<CacheQueryResult> GetCacheQueryResult(const std::string& trainer_id);
 
@@ -147,14 +176,27 @@ class CrossTrainerCache {
 
   // Frees old elements to keep the cache size below `max_cache_size_bytes_`.
   // `new_element_size_bytes` is the size of the new element being inserted.
+  // Probationary elements are evicted before protected ones; within each
+  // segment, the oldest element is evicted first.
   void FreeSpace(size_t new_element_size_bytes);
 
+  // Demotes the oldest protected elements while the protected segment exceeds
+  // `max_protected_size_bytes_`, so popular elements cannot crowd out new data.
+  void DemoteProtectedElements();
+
   // Records the cache hit rate and cache size.
   void RecordMetrics(const CacheQueryResult& result);
 
   // Maximum cache size in bytes.
   const size_t max_cache_size_bytes_;
 
+  // Maximum size of the protected segment in bytes.
+  const size_t max_protected_size_bytes_;
+
+  // Maximum number of elements a trainer may lag behind the newest cached
+  // element before it is skipped ahead.
+  const size_t max_trainer_skew_elements_;
+
   // The element sequence over which the sliding window cache operates.
   std::unique_ptr<CachableSequence<ElementType>> cachable_sequence_;
 
@@ -165,17 +207,22 @@ class CrossTrainerCache {
   // return this status.
   Status status_ TF_GUARDED_BY(mu_) = OkStatus();
 
-  // `cache_` stores the cached elements.
-  std::deque<std::shared_ptr<const ElementType>> cache_ TF_GUARDED_BY(mu_);
+  // `cache_` stores the cached elements, keyed by their absolute indices
+  // within the dataset. Eviction may leave holes in the index range, so the
+  // keys are not necessarily contiguous.
+  std::map<size_t, CachedElement> cache_ TF_GUARDED_BY(mu_);
   size_t cache_size_bytes_ TF_GUARDED_BY(mu_) = 0;
-  size_t cache_start_index_ TF_GUARDED_BY(mu_) = 0;
+  size_t protected_size_bytes_ TF_GUARDED_BY(mu_) = 0;
+
+  // Absolute index of the next element to be produced by the sequence.
+  size_t next_element_index_ TF_GUARDED_BY(mu_) = 0;
 
   // True if one thread is extending the cache.
   bool extending_cache_ TF_GUARDED_BY(mu_) = false;
 
   // Maps trainer IDs to element indices. The indices are absolute indices
-  // within the dataset. The actual index to use with `cache_` would be
-  // `trainer_to_element_index_map_[trainer_id] - cache_start_index_`.
+  // within the dataset. A trainer reads the first cached element at or after
+  // its index.
   absl::flat_hash_map<std::string, size_t> trainer_to_element_index_map_
       TF_GUARDED_BY(mu_);
 };
@@ -183,8 +230,13 @@ class CrossTrainerCache {
 template <class ElementType>
 CrossTrainerCache<ElementType>::CrossTrainerCache(
     size_t max_cache_size_bytes,
-    std::unique_ptr<CachableSequence<ElementType>> cachable_sequence)
+    std::unique_ptr<CachableSequence<ElementType>> cachable_sequence,
+    size_t max_trainer_skew_elements)
     : max_cache_size_bytes_(max_cache_size_bytes),
+      // The protected segment takes at most 80% of the memory budget, so new
+      // elements always have probationary space to land in.
+      max_protected_size_bytes_(max_cache_size_bytes / 5 * 4),
+      max_trainer_skew_elements_(max_trainer_skew_elements),
       cachable_sequence_(std::move(cachable_sequence)) {
   DCHECK_GT(max_cache_size_bytes, 0)
       << "CrossTrainerCache size must be greater than 0.";
@@ -247,7 +299,7 @@ CrossTrainerCache<ElementType>::GetCacheQueryResult(
 template <class ElementType>
 bool CrossTrainerCache<ElementType>::IsElementReady(
     const std::string& trainer_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-  return GetElementIndex(trainer_id) < cache_start_index_ + cache_.size();
+  return cache_.lower_bound(GetElementIndex(trainer_id)) != cache_.end();
 }
 
 template <class ElementType>
@@ -261,18 +313,35 @@ CrossTrainerCache<ElementType>::GetElement(const std::string& trainer_id)
         element_index);
   }
 
-  std::shared_ptr<const ElementType> result =
-      cache_[element_index - cache_start_index_];
-  trainer_to_element_index_map_[trainer_id] = element_index + 1;
-  return result;
+  // The exact element may have been evicted; the trainer reads the first
+  // cached element at or after its index.
+  auto iterator = cache_.lower_bound(element_index);
+  DCHECK(iterator != cache_.end());
+  CachedElement& cached_element = iterator->second;
+  ++cached_element.hit_count;
+  if (!cached_element.is_protected &&
+      cached_element.hit_count >= kProtectedHitCount) {
+    cached_element.is_protected = true;
+    protected_size_bytes_ += cached_element.size_bytes;
+    DemoteProtectedElements();
+  }
+  trainer_to_element_index_map_[trainer_id] = iterator->first + 1;
+  return cached_element.element;
 }
 
 template <class ElementType>
 size_t CrossTrainerCache<ElementType>::GetElementIndex(
     const std::string& trainer_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   size_t element_index = trainer_to_element_index_map_[trainer_id];
-  if (element_index < cache_start_index_) {
-    element_index = cache_start_index_;
+  // Skips a trainer ahead when it has fallen more than
+  // `max_trainer_skew_elements_` behind the newest cached element, so slow
+  // trainers do not pin old elements in memory.
+  if (next_element_index_ > max_trainer_skew_elements_ &&
+      element_index < next_element_index_ - max_trainer_skew_elements_) {
+    element_index = next_element_index_ - max_trainer_skew_elements_;
+  }
+  if (!cache_.empty() && element_index < cache_.begin()->first) {
+    element_index = cache_.begin()->first;
   }
   return element_index;
 }
@@ -292,7 +361,9 @@ Status CrossTrainerCache<ElementType>::ExtendCache() TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
   TF_RETURN_IF_ERROR(status_);
   FreeSpace(new_element_size_bytes);
-  cache_.push_back(std::make_shared<ElementType>(std::move(element)));
+  CachedElement& cached_element = cache_[next_element_index_++];
+  cached_element.element = std::make_shared<ElementType>(std::move(element));
+  cached_element.size_bytes = new_element_size_bytes;
   cache_size_bytes_ += new_element_size_bytes;
   return OkStatus();
 }
@@ -303,11 +374,18 @@ void CrossTrainerCache<ElementType>::FreeSpace(size_t new_element_size_bytes)
   size_t num_elements_discarded = 0;
   while (!cache_.empty() &&
          cache_size_bytes_ + new_element_size_bytes > max_cache_size_bytes_) {
-    size_t free_bytes =
-        cachable_sequence_->GetElementSizeBytes(*cache_.front());
-    cache_.pop_front();
-    cache_size_bytes_ -= free_bytes;
-    ++cache_start_index_;
+    // Evicts the oldest probationary element. Elements promoted to the
+    // protected segment are only evicted when no probationary element remains.
+    auto iterator = cache_.begin();
+    while (iterator != cache_.end() && iterator->second.is_protected) {
+      ++iterator;
+    }
+    if (iterator == cache_.end()) {
+      iterator = cache_.begin();
+      protected_size_bytes_ -= iterator->second.size_bytes;
+    }
+    cache_size_bytes_ -= iterator->second.size_bytes;
+    cache_.erase(iterator);
     ++num_elements_discarded;
   }
 
@@ -316,6 +394,21 @@ void CrossTrainerCache<ElementType>::FreeSpace(size_t new_element_size_bytes)
           << FormatBytes(cache_size_bytes_) << ".";
 }
 
+template <class ElementType>
+void CrossTrainerCache<ElementType>::DemoteProtectedElements()
+    TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+  auto iterator = cache_.begin();
+  while (protected_size_bytes_ > max_protected_size_bytes_ &&
+         iterator != cache_.end()) {
+    if (iterator->second.is_protected) {
+      iterator->second.is_protected = false;
+      iterator->second.hit_count = 0;
+      protected_size_bytes_ -= iterator->second.size_bytes;
+    }
+    ++iterator;
+  }
+}
+
 template <class ElementType>
 void CrossTrainerCache<ElementType>::Cancel(Status status)
     TF_LOCKS_EXCLUDED(mu_) {
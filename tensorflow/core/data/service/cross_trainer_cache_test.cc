@@ -190,6 +190,53 @@ TEST(CrossTrainerCacheTest, SlowTrainersSkipData) {
   EXPECT_THAT(cache.Get("Slow trainer 2"), IsOkAndHolds(Pointee(Gt(94))));
 }
 
+TEST(CrossTrainerCacheTest, PopularElementsSurviveEviction) {
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/4 * sizeof(int64_t),
+      std::make_unique<InfiniteRange>());
+  EXPECT_THAT(cache.Get("Trainer 1"), IsOkAndHolds(Pointee(0)));
+  // Element 0 is read by a second trainer and becomes protected.
+  EXPECT_THAT(cache.Get("Trainer 2"), IsOkAndHolds(Pointee(0)));
+
+  for (int i = 1; i < 5; ++i) {
+    EXPECT_THAT(cache.Get("Trainer 1"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // Caching 4 evicts the oldest probationary element, which is 1; the
+  // protected element 0 survives and is served to a late trainer.
+  EXPECT_THAT(cache.Get("Trainer 3"), IsOkAndHolds(Pointee(0)));
+  // Trainer 2 skips the evicted element 1 and reads 2.
+  EXPECT_THAT(cache.Get("Trainer 2"), IsOkAndHolds(Pointee(2)));
+}
+
+TEST(CrossTrainerCacheTest, BoundedSkewSkipsSlowTrainerAhead) {
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/1024, std::make_unique<InfiniteRange>(),
+      /*max_trainer_skew_elements=*/4);
+  for (int i = 0; i < 20; ++i) {
+    EXPECT_THAT(cache.Get("Fast trainer"), IsOkAndHolds(Pointee(i)));
+  }
+
+  // The slow trainer may lag at most 4 elements behind the newest cached
+  // element, even though older elements are still in the cache.
+  EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(16)));
+  for (int i = 17; i < 25; ++i) {
+    EXPECT_THAT(cache.Get("Slow trainer"), IsOkAndHolds(Pointee(i)));
+  }
+}
+
+TEST(CrossTrainerCacheTest, ProtectedSegmentDoesNotBlockProgress) {
+  // Two trainers in lockstep promote every element to the protected segment.
+  // The protected segment is bounded, so the cache keeps making progress.
+  CrossTrainerCache<int64_t> cache(
+      /*max_cache_size_bytes=*/2 * sizeof(int64_t),
+      std::make_unique<InfiniteRange>());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_THAT(cache.Get("Trainer 1"), IsOkAndHolds(Pointee(i)));
+    EXPECT_THAT(cache.Get("Trainer 2"), IsOkAndHolds(Pointee(i)));
+  }
+}
+
 TEST(CrossTrainerCacheTest, NewTrainersStartLate) {
   CrossTrainerCache<int64_t> cache(
       /*max_cache_size_bytes=*/5 * sizeof(int64_t),
@@ -62,9 +62,10 @@ class DataServiceDispatcherClient : public DataServiceClientBase {
   Status GetDatasetDef(const std::string& dataset_id, DatasetDef& dataset_def);
 
   // Gets the next split for the specified iteration id, repetition, and split
-  // provider index.
+  // provider index, on behalf of the worker with `worker_address`.
   Status GetSplit(int64_t iteration_id, int64_t repetition,
-                  int64_t split_provider_index, Tensor& split,
+                  int64_t split_provider_index,
+                  const std::string& worker_address, Tensor& split,
                   bool& end_of_splits);
 
   // Gets the next split for the specified source of a stream of the snapshot in
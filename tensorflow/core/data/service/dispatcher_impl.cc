@@ -94,6 +94,13 @@ constexpr char kDatasetsDir[] = "datasets";
 // between completing a stream and getting assigned a new one.
 constexpr int kDefaultWorkerMaxConcurrentSnapshots = 3;
 
+// A worker is considered a straggler for an iteration if its reported
+// processing rate is below this fraction of the mean rate of the workers
+// processing the iteration. When `straggler_split_deferral_ms` is set,
+// stragglers have their split requests briefly deferred so that faster
+// workers claim the remaining splits.
+constexpr double kStragglerThroughputRatio = 0.5;
+
 constexpr absl::Duration kDefaultIterationGcCheckInterval = absl::Minutes(10);
 constexpr absl::Duration kDefaultIterationGcTimeout = absl::Minutes(5);
 constexpr absl::Duration kDefaultClientTimeout = absl::Minutes(5);
@@ -513,6 +520,15 @@ Status DataServiceDispatcherImpl::GetSplit(const GetSplitRequest* request,
   VLOG(3) << "Received GetSplit request for iteration " << iteration_id
           << ", repetition " << repetition << ", split provider index "
           << provider_index;
+  if (config_.straggler_split_deferral_ms() > 0 &&
+      !request->worker_address().empty() &&
+      auto_scaler_.IsStragglerWorker(iteration_id, request->worker_address(),
+                                     kStragglerThroughputRatio)) {
+    VLOG(3) << "Deferring GetSplit request from straggler worker "
+            << request->worker_address() << " for iteration " << iteration_id
+            << " by " << config_.straggler_split_deferral_ms() << "ms";
+    env_->SleepForMicroseconds(config_.straggler_split_deferral_ms() * 1000);
+  }
   mutex_lock l(get_split_mu_);
   int64_t current_repetition = 0;
   SplitProvider* split_provider = nullptr;
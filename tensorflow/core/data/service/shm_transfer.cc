@@ -0,0 +1,586 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#include "tensorflow/core/platform/platform.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/metrics.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/variant.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+// Maximum number of concurrently connected clients per worker segment.
+constexpr int kNumRings = 16;
+
+// Buffer sizes of one ring. Requests are small; responses larger than the
+// buffer are streamed through it in chunks.
+constexpr size_t kRequestBufferBytes = size_t{4} << 10;    // 4KB
+constexpr size_t kResponseBufferBytes = size_t{256} << 10;  // 256KB
+
+// Written to the segment header once the server has initialized the segment.
+constexpr uint64_t kSegmentMagic = 0x7466646174615348ULL;  // "tfdataSH"
+
+// How long readers and writers sleep when a ring is empty or full.
+constexpr int64_t kDataPollMicros = 50;
+
+// How often the server scans the segment for newly connected clients.
+constexpr int64_t kAcceptPollMicros = 1000;
+
+// Lifecycle of a ring. Clients claim a free ring with a compare-and-swap; the
+// server returns a ring to the free state after the client disconnects.
+enum RingState : uint32_t {
+  kRingFree = 0,
+  kRingActive = 1,
+  kRingClientClosed = 2,
+};
+
+// Control block of one ring. The request direction is written by the client
+// and read by the server; the response direction is the reverse. Each
+// direction is a single-producer, single-consumer byte queue: the producer
+// owns the `written` counter and the consumer owns the `read` counter, so no
+// locks are required across the process boundary. The counters increase
+// monotonically; buffer positions are taken modulo the buffer size.
+struct RingHeader {
+  std::atomic<uint32_t> state;
+  std::atomic<uint32_t> server_closed;
+  alignas(64) std::atomic<uint64_t> request_written;
+  alignas(64) std::atomic<uint64_t> request_read;
+  alignas(64) std::atomic<uint64_t> response_written;
+  alignas(64) std::atomic<uint64_t> response_read;
+};
+
+struct Ring {
+  RingHeader header;
+  char request_buffer[kRequestBufferBytes];
+  char response_buffer[kResponseBufferBytes];
+};
+
+struct Segment {
+  std::atomic<uint64_t> magic;
+  std::atomic<uint32_t> server_shutdown;
+  Ring rings[kNumRings];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "The shared memory transfer requires lock-free 64-bit atomics.");
+
+std::string SegmentName(int token) {
+  return absl::StrCat("/tf_data_shm_", token);
+}
+
+// An open, mmap'ed shared memory segment. The creating side owns the name and
+// unlinks it on destruction.
+class MappedSegment {
+ public:
+  static Status Create(const std::string& name,
+                       std::unique_ptr<MappedSegment>& out) {
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      return errors::Internal("Failed to create shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    if (ftruncate(fd, sizeof(Segment)) != 0) {
+      Status status =
+          errors::Internal("Failed to size shared memory segment ", name, ": ",
+                           strerror(errno));
+      close(fd);
+      shm_unlink(name.c_str());
+      return status;
+    }
+    return Map(name, fd, /*owns_name=*/true, out);
+  }
+
+  static Status Open(const std::string& name,
+                     std::unique_ptr<MappedSegment>& out) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+      return errors::NotFound("Failed to open shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    return Map(name, fd, /*owns_name=*/false, out);
+  }
+
+  ~MappedSegment() {
+    munmap(segment_, sizeof(Segment));
+    if (owns_name_) {
+      shm_unlink(name_.c_str());
+    }
+  }
+  MappedSegment(const MappedSegment&) = delete;
+  MappedSegment& operator=(const MappedSegment&) = delete;
+
+  Segment* get() const { return segment_; }
+
+ private:
+  MappedSegment(std::string name, bool owns_name, Segment* segment)
+      : name_(std::move(name)), owns_name_(owns_name), segment_(segment) {}
+
+  static Status Map(const std::string& name, int fd, bool owns_name,
+                    std::unique_ptr<MappedSegment>& out) {
+    void* addr = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+      if (owns_name) {
+        shm_unlink(name.c_str());
+      }
+      return errors::Internal("Failed to map shared memory segment ", name,
+                              ": ", strerror(errno));
+    }
+    out = absl::WrapUnique(
+        new MappedSegment(name, owns_name, static_cast<Segment*>(addr)));
+    return OkStatus();
+  }
+
+  const std::string name_;
+  const bool owns_name_;
+  Segment* const segment_;
+};
+
+// One direction of a ring. `Write` and `Read` copy through the buffer in
+// chunks, sleeping while the buffer is full (respectively empty) and polling
+// `stop` so a cancelled or disconnected peer does not block forever.
+class SpscBytePipe {
+ public:
+  SpscBytePipe(std::atomic<uint64_t>* written, std::atomic<uint64_t>* read,
+               char* buffer, size_t capacity)
+      : written_(written), read_(read), buffer_(buffer), capacity_(capacity) {}
+
+  Status Write(const char* data, size_t size,
+               const std::function<Status()>& stop) {
+    size_t offset = 0;
+    while (offset < size) {
+      uint64_t written = written_->load(std::memory_order_relaxed);
+      uint64_t read = read_->load(std::memory_order_acquire);
+      size_t free_bytes = capacity_ - static_cast<size_t>(written - read);
+      if (free_bytes == 0) {
+        TF_RETURN_IF_ERROR(stop());
+        Env::Default()->SleepForMicroseconds(kDataPollMicros);
+        continue;
+      }
+      size_t begin = static_cast<size_t>(written % capacity_);
+      size_t chunk = std::min({size - offset, free_bytes, capacity_ - begin});
+      memcpy(buffer_ + begin, data + offset, chunk);
+      offset += chunk;
+      written_->store(written + chunk, std::memory_order_release);
+    }
+    return OkStatus();
+  }
+
+  Status Read(char* data, size_t size, const std::function<Status()>& stop) {
+    size_t offset = 0;
+    while (offset < size) {
+      uint64_t read = read_->load(std::memory_order_relaxed);
+      uint64_t written = written_->load(std::memory_order_acquire);
+      size_t available = static_cast<size_t>(written - read);
+      if (available == 0) {
+        TF_RETURN_IF_ERROR(stop());
+        Env::Default()->SleepForMicroseconds(kDataPollMicros);
+        continue;
+      }
+      size_t begin = static_cast<size_t>(read % capacity_);
+      size_t chunk = std::min({size - offset, available, capacity_ - begin});
+      memcpy(data + offset, buffer_ + begin, chunk);
+      offset += chunk;
+      read_->store(read + chunk, std::memory_order_release);
+    }
+    return OkStatus();
+  }
+
+ private:
+  std::atomic<uint64_t>* const written_;
+  std::atomic<uint64_t>* const read_;
+  char* const buffer_;
+  const size_t capacity_;
+};
+
+// Messages are framed with a fixed 64-bit length prefix.
+Status WriteMessage(SpscBytePipe& pipe, const std::string& data,
+                    const std::function<Status()>& stop) {
+  uint64_t size = data.size();
+  TF_RETURN_IF_ERROR(
+      pipe.Write(reinterpret_cast<const char*>(&size), sizeof(size), stop));
+  return pipe.Write(data.data(), data.size(), stop);
+}
+
+Status ReadMessage(SpscBytePipe& pipe, std::string& data,
+                   const std::function<Status()>& stop) {
+  uint64_t size = 0;
+  TF_RETURN_IF_ERROR(
+      pipe.Read(reinterpret_cast<char*>(&size), sizeof(size), stop));
+  data.resize(size);
+  return pipe.Read(&data[0], size, stop);
+}
+
+// Moves the element into the response. If the tensor contains a single
+// CompressedElement variant, the move will be zero-copy. Otherwise, the tensor
+// data will be serialized as TensorProtos.
+Status MoveElementToResponse(std::vector<Tensor>&& element,
+                             GetElementResponse& resp) {
+  if (element.size() != 1 || element[0].dtype() != DT_VARIANT ||
+      !TensorShapeUtils::IsScalar(element[0].shape())) {
+    for (const auto& component : element) {
+      UncompressedElement* uncompressed = resp.mutable_uncompressed();
+      component.AsProtoTensorContent(uncompressed->add_components());
+    }
+    return OkStatus();
+  }
+  Variant& variant = element[0].scalar<Variant>()();
+  CompressedElement* compressed = variant.get<CompressedElement>();
+  if (compressed == nullptr) {
+    return errors::FailedPrecondition(
+        "Expected dataset to produce a CompressedElement variant tensor, but "
+        "it produced ",
+        variant.TypeName());
+  }
+  *resp.mutable_compressed() = *compressed;
+  return OkStatus();
+}
+
+class ShmDataTransferServer : public DataTransferServer {
+ public:
+  explicit ShmDataTransferServer(GetElementT get_element)
+      : get_element_(std::move(get_element)) {}
+
+  ~ShmDataTransferServer() override {
+    cancelled_ = true;
+    if (segment_ != nullptr) {
+      segment_->get()->server_shutdown.store(1, std::memory_order_release);
+      for (Ring& ring : segment_->get()->rings) {
+        ring.header.server_closed.store(1, std::memory_order_release);
+      }
+    }
+    accept_thread_.reset();
+    ring_threads_.clear();
+  }
+
+  Status Start() override {
+    token_ = 1 + static_cast<int>(random::New64() % ((uint64_t{1} << 30) - 1));
+    TF_RETURN_IF_ERROR(
+        MappedSegment::Create(SegmentName(token_), segment_));
+    segment_->get()->magic.store(kSegmentMagic, std::memory_order_release);
+    ring_threads_.resize(kNumRings);
+    accept_thread_ = absl::WrapUnique(Env::Default()->StartThread(
+        /*thread_options=*/{}, "tf_data_shm_accept", [this]() { AcceptLoop(); }));
+    VLOG(2) << "Started shared memory data transfer server with segment "
+            << SegmentName(token_) << ".";
+    return OkStatus();
+  }
+
+  // The rendezvous token naming the segment, advertised in place of a port.
+  int Port() const override { return token_; }
+
+ private:
+  // Scans the segment for rings newly claimed by clients and starts a handler
+  // thread for each. Handler slots are reused after their client disconnects.
+  void AcceptLoop() {
+    while (!cancelled_) {
+      for (int i = 0; i < kNumRings; ++i) {
+        Ring* ring = &segment_->get()->rings[i];
+        if (!serving_[i] &&
+            ring->header.state.load(std::memory_order_acquire) == kRingActive) {
+          ring_threads_[i].reset();  // Joins the previous handler, if any.
+          serving_[i] = true;
+          ring_threads_[i] = absl::WrapUnique(Env::Default()->StartThread(
+              /*thread_options=*/{}, absl::StrCat("tf_data_shm_ring_", i),
+              [this, i, ring]() { Serve(i, ring); }));
+        }
+      }
+      Env::Default()->SleepForMicroseconds(kAcceptPollMicros);
+    }
+  }
+
+  // Serves requests from one ring until the client disconnects or the server
+  // shuts down. Responses are framed as a fixed 64-bit status code followed by
+  // a message holding either the serialized `GetElementResponse` (on success)
+  // or the error message (on failure).
+  void Serve(int ring_index, Ring* ring) {
+    RingHeader& header = ring->header;
+    SpscBytePipe request_pipe(&header.request_written, &header.request_read,
+                              ring->request_buffer, kRequestBufferBytes);
+    SpscBytePipe response_pipe(&header.response_written, &header.response_read,
+                               ring->response_buffer, kResponseBufferBytes);
+    auto stop = [this, &header]() -> Status {
+      if (cancelled_) {
+        return errors::Cancelled("Server was shut down.");
+      }
+      if (header.state.load(std::memory_order_acquire) == kRingClientClosed) {
+        return errors::Cancelled("Client disconnected.");
+      }
+      return OkStatus();
+    };
+
+    while (true) {
+      std::string request_bytes;
+      if (!ReadMessage(request_pipe, request_bytes, stop).ok()) {
+        break;
+      }
+      GetElementRequest req;
+      uint64_t code;
+      std::string payload;
+      if (!req.ParseFromString(request_bytes)) {
+        Status status =
+            errors::Internal("Failed to parse GetElementRequest.");
+        code = static_cast<uint64_t>(status.code());
+        payload = std::string(status.message());
+      } else {
+        GetElementResult result;
+        Status status = get_element_(&req, &result);
+        if (status.ok()) {
+          GetElementResponse resp;
+          resp.set_element_index(result.element_index);
+          resp.set_end_of_sequence(result.end_of_sequence);
+          resp.set_skip_task(result.skip);
+          if (!result.end_of_sequence && !result.skip) {
+            status = MoveElementToResponse(std::move(result.components), resp);
+          }
+          if (status.ok()) {
+            payload = resp.SerializeAsString();
+          }
+        }
+        code = static_cast<uint64_t>(status.code());
+        if (!status.ok()) {
+          payload = std::string(status.message());
+        }
+      }
+      if (!response_pipe
+               .Write(reinterpret_cast<const char*>(&code), sizeof(code), stop)
+               .ok() ||
+          !WriteMessage(response_pipe, payload, stop).ok()) {
+        break;
+      }
+    }
+
+    // Returns the ring to the free list once the client has disconnected. On
+    // server shutdown, the segment is unlinked instead.
+    if (header.state.load(std::memory_order_acquire) == kRingClientClosed) {
+      header.request_written.store(0, std::memory_order_relaxed);
+      header.request_read.store(0, std::memory_order_relaxed);
+      header.response_written.store(0, std::memory_order_relaxed);
+      header.response_read.store(0, std::memory_order_relaxed);
+      header.state.store(kRingFree, std::memory_order_release);
+    }
+    serving_[ring_index] = false;
+  }
+
+  const GetElementT get_element_;
+
+  int token_ = 0;
+  std::unique_ptr<MappedSegment> segment_;
+  std::atomic<bool> cancelled_{false};
+  std::atomic<bool> serving_[kNumRings] = {};
+  std::vector<std::unique_ptr<Thread>> ring_threads_;
+  std::unique_ptr<Thread> accept_thread_;
+};
+
+class ShmDataTransferClient : public DataTransferClient {
+ public:
+  static Status Create(const std::string& address,
+                       std::unique_ptr<DataTransferClient>* out) {
+    size_t colon = address.rfind(':');
+    int token = 0;
+    if (colon == std::string::npos ||
+        !absl::SimpleAtoi(address.substr(colon + 1), &token)) {
+      return errors::InvalidArgument(
+          "Invalid shared memory transfer server address: ", address);
+    }
+    std::unique_ptr<MappedSegment> segment;
+    TF_RETURN_IF_ERROR(MappedSegment::Open(SegmentName(token), segment));
+    if (segment->get()->magic.load(std::memory_order_acquire) !=
+        kSegmentMagic) {
+      return errors::FailedPrecondition(
+          "Shared memory segment ", SegmentName(token),
+          " has not been initialized by a transfer server.");
+    }
+    // Claims a free ring. The compare-and-swap makes this client the single
+    // producer of the ring's request direction.
+    Ring* ring = nullptr;
+    for (int i = 0; i < kNumRings; ++i) {
+      uint32_t expected = kRingFree;
+      if (segment->get()->rings[i].header.state.compare_exchange_strong(
+              expected, kRingActive, std::memory_order_acq_rel)) {
+        ring = &segment->get()->rings[i];
+        break;
+      }
+    }
+    if (ring == nullptr) {
+      return errors::ResourceExhausted(
+          "All ", kNumRings,
+          " rings of shared memory transfer server at address ", address,
+          " are in use.");
+    }
+    VLOG(2) << "Create ShmDataTransferClient for worker " << address << ".";
+    *out = absl::WrapUnique(
+        new ShmDataTransferClient(std::move(segment), ring));
+    return OkStatus();
+  }
+
+  ~ShmDataTransferClient() override {
+    mutex_lock l(mu_);
+    ring_->header.state.store(kRingClientClosed, std::memory_order_release);
+  }
+
+  Status GetElement(const GetElementRequest& req,
+                    GetElementResult& result) override {
+    VLOG(3) << "GetElement for task " << req.task_id()
+            << " over shared memory.";
+    // Serializes calls so this client stays the single producer of the ring.
+    mutex_lock l(mu_);
+    auto stop = [this]() -> Status {
+      if (cancelled_) {
+        return errors::Cancelled("Client was cancelled.");
+      }
+      if (segment_->get()->server_shutdown.load(std::memory_order_acquire) ||
+          ring_->header.server_closed.load(std::memory_order_acquire)) {
+        return errors::Unavailable(
+            "Shared memory transfer server was shut down.");
+      }
+      return OkStatus();
+    };
+    TF_RETURN_IF_ERROR(stop());
+
+    int64_t start_time_us = env_->NowMicros();
+    TF_RETURN_IF_ERROR(
+        WriteMessage(request_pipe_, req.SerializeAsString(), stop));
+    uint64_t code = 0;
+    TF_RETURN_IF_ERROR(response_pipe_.Read(reinterpret_cast<char*>(&code),
+                                           sizeof(code), stop));
+    std::string payload;
+    TF_RETURN_IF_ERROR(ReadMessage(response_pipe_, payload, stop));
+    int64_t end_time_us = env_->NowMicros();
+    if (code != 0) {
+      return Status(static_cast<absl::StatusCode>(code), payload);
+    }
+    GetElementResponse resp;
+    if (!resp.ParseFromString(payload)) {
+      return errors::Internal("Failed to parse GetElementResponse.");
+    }
+    metrics::RecordTFDataServiceGetElementDuration(kShmTransferProtocol,
+                                                   end_time_us - start_time_us);
+    result.element_index = resp.element_index();
+    result.end_of_sequence = resp.end_of_sequence();
+    result.skip = resp.skip_task();
+    switch (resp.element_case()) {
+      case GetElementResponse::kCompressed: {
+        Tensor tensor(DT_VARIANT, TensorShape{});
+        tensor.scalar<Variant>()() = std::move(resp.compressed());
+        result.components.push_back(tensor);
+        break;
+      }
+      case GetElementResponse::kUncompressed:
+        for (const auto& component : resp.uncompressed().components()) {
+          result.components.emplace_back();
+          if (!result.components.back().FromProto(component)) {
+            return errors::Internal("Failed to parse tensor.");
+          }
+        }
+        break;
+      case GetElementResponse::ELEMENT_NOT_SET:
+        break;
+    }
+    return OkStatus();
+  }
+
+  void TryCancel() override {
+    VLOG(2) << "Cancel ShmDataTransferClient.";
+    cancelled_ = true;
+  }
+
+ private:
+  ShmDataTransferClient(std::unique_ptr<MappedSegment> segment, Ring* ring)
+      : segment_(std::move(segment)),
+        ring_(ring),
+        request_pipe_(&ring->header.request_written,
+                      &ring->header.request_read, ring->request_buffer,
+                      kRequestBufferBytes),
+        response_pipe_(&ring->header.response_written,
+                       &ring->header.response_read, ring->response_buffer,
+                       kResponseBufferBytes) {}
+
+  std::unique_ptr<MappedSegment> segment_;
+  Ring* const ring_;
+  SpscBytePipe request_pipe_;
+  SpscBytePipe response_pipe_;
+  std::atomic<bool> cancelled_{false};
+
+  mutex mu_;
+};
+
+class ShmTransferServerRegistrar {
+ public:
+  ShmTransferServerRegistrar() {
+    DataTransferServer::Register(
+        kShmTransferProtocol,
+        [](DataTransferServer::GetElementT get_element,
+           std::shared_ptr<DataTransferServer>* out) {
+          *out = std::make_shared<ShmDataTransferServer>(std::move(get_element));
+          return OkStatus();
+        });
+  }
+};
+static ShmTransferServerRegistrar shm_server_registrar;
+
+class ShmTransferClientRegistrar {
+ public:
+  ShmTransferClientRegistrar() {
+    DataTransferClient::Register(
+        kShmTransferProtocol, [](DataTransferClient::Config config,
+                                 std::unique_ptr<DataTransferClient>* out) {
+          return ShmDataTransferClient::Create(config.address, out);
+        });
+  }
+};
+static ShmTransferClientRegistrar shm_client_registrar;
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !defined(PLATFORM_WINDOWS)
@@ -0,0 +1,38 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+#define TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
+
+namespace tensorflow {
+namespace data {
+
+// Data transfer protocol that moves elements between a tf.data service worker
+// and a trainer on the same host through a POSIX shared memory segment,
+// avoiding the gRPC round trip. Each client claims a single-producer,
+// single-consumer ring in the worker's segment and exchanges length-prefixed
+// request and response messages with the worker through it.
+//
+// The protocol is registered under this name on POSIX platforms. To use it,
+// set `data_transfer_protocol` in the worker config and in the tf.data
+// service client parameters. The worker advertises the segment through the
+// standard transfer server mechanism: the rendezvous token that names the
+// segment is exposed as the transfer server's "port".
+constexpr const char kShmTransferProtocol[] = "shared_memory";
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SERVICE_SHM_TRANSFER_H_
@@ -0,0 +1,210 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/service/shm_transfer.h"
+
+#include "tensorflow/core/platform/platform.h"
+
+#if !defined(PLATFORM_WINDOWS)
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/service/data_transfer.h"
+#include "tensorflow/core/data/service/worker.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/status_matchers.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/protobuf/error_codes.pb.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+using ::tensorflow::testing::StatusIs;
+using ::testing::HasSubstr;
+
+// Produces string scalars "element 0", "element 1", ... and reaches end of
+// sequence after `num_elements`.
+class TestElementProducer {
+ public:
+  explicit TestElementProducer(int64_t num_elements,
+                               int64_t element_size_bytes = 0)
+      : num_elements_(num_elements), element_size_bytes_(element_size_bytes) {}
+
+  Status GetElement(const GetElementRequest* req, GetElementResult* result) {
+    mutex_lock l(mu_);
+    if (next_ >= num_elements_) {
+      result->end_of_sequence = true;
+      return OkStatus();
+    }
+    std::string value = absl::StrCat("element ", next_);
+    if (element_size_bytes_ > value.size()) {
+      value.resize(element_size_bytes_, 'x');
+    }
+    result->components.push_back(Tensor(value));
+    result->element_index = next_++;
+    result->end_of_sequence = false;
+    return OkStatus();
+  }
+
+ private:
+  const int64_t num_elements_;
+  const int64_t element_size_bytes_;
+  mutex mu_;
+  int64_t next_ TF_GUARDED_BY(mu_) = 0;
+};
+
+Status CreateServerAndClient(DataTransferServer::GetElementT get_element,
+                             std::shared_ptr<DataTransferServer>& server,
+                             std::unique_ptr<DataTransferClient>& client) {
+  TF_RETURN_IF_ERROR(
+      DataTransferServer::Build(kShmTransferProtocol, get_element, &server));
+  TF_RETURN_IF_ERROR(server->Start());
+  return DataTransferClient::Build(
+      kShmTransferProtocol,
+      {/*protocol=*/"grpc",
+       /*address=*/absl::StrCat("localhost:", server->Port())},
+      &client);
+}
+
+TEST(ShmTransferTest, RoundTrip) {
+  TestElementProducer producer(/*num_elements=*/10);
+  std::shared_ptr<DataTransferServer> server;
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(CreateServerAndClient(
+      [&producer](const GetElementRequest* req, GetElementResult* result) {
+        return producer.GetElement(req, result);
+      },
+      server, client));
+
+  for (int i = 0; i < 10; ++i) {
+    GetElementRequest req;
+    GetElementResult result;
+    TF_ASSERT_OK(client->GetElement(req, result));
+    EXPECT_FALSE(result.end_of_sequence);
+    EXPECT_EQ(result.element_index, i);
+    ASSERT_EQ(result.components.size(), 1);
+    test::ExpectEqual(result.components[0],
+                      Tensor(absl::StrCat("element ", i)));
+  }
+  GetElementRequest req;
+  GetElementResult result;
+  TF_ASSERT_OK(client->GetElement(req, result));
+  EXPECT_TRUE(result.end_of_sequence);
+}
+
+TEST(ShmTransferTest, ElementsLargerThanRingBuffer) {
+  // Larger than the ring's response buffer, so the response is streamed
+  // through the ring in multiple chunks.
+  constexpr int64_t kElementSizeBytes = 1 << 20;  // 1MB
+  TestElementProducer producer(/*num_elements=*/3, kElementSizeBytes);
+  std::shared_ptr<DataTransferServer> server;
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(CreateServerAndClient(
+      [&producer](const GetElementRequest* req, GetElementResult* result) {
+        return producer.GetElement(req, result);
+      },
+      server, client));
+
+  for (int i = 0; i < 3; ++i) {
+    GetElementRequest req;
+    GetElementResult result;
+    TF_ASSERT_OK(client->GetElement(req, result));
+    ASSERT_EQ(result.components.size(), 1);
+    EXPECT_EQ(result.components[0].scalar<tstring>()().size(),
+              kElementSizeBytes);
+  }
+}
+
+TEST(ShmTransferTest, MultipleClients) {
+  constexpr int kNumClients = 4;
+  TestElementProducer producer(/*num_elements=*/100);
+  std::shared_ptr<DataTransferServer> server;
+  std::vector<std::unique_ptr<DataTransferClient>> clients(kNumClients);
+  TF_ASSERT_OK(CreateServerAndClient(
+      [&producer](const GetElementRequest* req, GetElementResult* result) {
+        return producer.GetElement(req, result);
+      },
+      server, clients[0]));
+  for (int i = 1; i < kNumClients; ++i) {
+    TF_ASSERT_OK(DataTransferClient::Build(
+        kShmTransferProtocol,
+        {/*protocol=*/"grpc",
+         /*address=*/absl::StrCat("localhost:", server->Port())},
+        &clients[i]));
+  }
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int i = 0; i < kNumClients; ++i) {
+    threads.push_back(absl::WrapUnique(Env::Default()->StartThread(
+        /*thread_options=*/{}, absl::StrCat("client_", i), [&clients, i]() {
+          for (int j = 0; j < 25; ++j) {
+            GetElementRequest req;
+            GetElementResult result;
+            TF_ASSERT_OK(clients[i]->GetElement(req, result));
+            EXPECT_FALSE(result.end_of_sequence);
+            EXPECT_EQ(result.components.size(), 1);
+          }
+        })));
+  }
+  threads.clear();
+}
+
+TEST(ShmTransferTest, PropagatesError) {
+  std::shared_ptr<DataTransferServer> server;
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(CreateServerAndClient(
+      [](const GetElementRequest* req, GetElementResult* result) {
+        return errors::InvalidArgument("Invalid task.");
+      },
+      server, client));
+
+  GetElementRequest req;
+  GetElementResult result;
+  EXPECT_THAT(client->GetElement(req, result),
+              StatusIs(error::INVALID_ARGUMENT, HasSubstr("Invalid task.")));
+}
+
+TEST(ShmTransferTest, GetElementAfterCancelFails) {
+  TestElementProducer producer(/*num_elements=*/10);
+  std::shared_ptr<DataTransferServer> server;
+  std::unique_ptr<DataTransferClient> client;
+  TF_ASSERT_OK(CreateServerAndClient(
+      [&producer](const GetElementRequest* req, GetElementResult* result) {
+        return producer.GetElement(req, result);
+      },
+      server, client));
+
+  client->TryCancel();
+  GetElementRequest req;
+  GetElementResult result;
+  EXPECT_THAT(client->GetElement(req, result), StatusIs(error::CANCELLED));
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // !defined(PLATFORM_WINDOWS)
@@ -43,6 +43,7 @@ constexpr const char kSplitsDirectoryName[] = "splits";
 constexpr const char kCheckpointsDirectoryName[] = "checkpoints";
 constexpr const char kCommittedChunksDirectoryName[] = "chunks";
 constexpr const char kUncommittedChunksDirectoryName[] = "uncommitted_chunks";
+constexpr const char kChunkIndexDirectoryName[] = "indexes";
 constexpr int64_t kUnknownNumElements = -1;
 
 }  // namespace
@@ -233,5 +234,9 @@ std::string UncommittedChunksDirectory(absl::string_view snapshot_path,
   return tsl::io::JoinPath(StreamDirectory(snapshot_path, stream_index),
                            kUncommittedChunksDirectoryName);
 }
+
+std::string ChunkIndexDirectory(absl::string_view snapshot_path) {
+  return tsl::io::JoinPath(snapshot_path, kChunkIndexDirectoryName);
+}
 }  // namespace data
 }  // namespace tensorflow
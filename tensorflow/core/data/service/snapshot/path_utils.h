@@ -128,6 +128,11 @@ std::string CommittedChunksDirectory(absl::string_view snapshot_path);
 std::string UncommittedChunksDirectory(absl::string_view snapshot_path,
                                        int64_t stream_index);
 
+// Returns the directory path for index files of aggregated chunks. Index files
+// record the element ordinal and byte offset at which each merged source chunk
+// begins within an aggregated chunk file.
+std::string ChunkIndexDirectory(absl::string_view snapshot_path);
+
 }  // namespace data
 }  // namespace tensorflow
 
@@ -20,14 +20,18 @@ limitations under the License.
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/data/service/common.h"
 #include "tensorflow/core/data/service/snapshot/file_utils.h"
@@ -40,9 +44,13 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/io/record_reader.h"
+#include "tensorflow/core/lib/io/record_writer.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/mutex.h"
 #include "tsl/platform/path.h"
+#include "tsl/platform/random.h"
+#include "tsl/platform/tstring.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace tensorflow {
@@ -66,6 +74,33 @@ absl::StatusOr<int64_t> GetUncommittedChunkIndex(const std::string& filename) {
   return chunk_index;
 }
 
+// Aggregated chunks are staged in the uncommitted chunks directory under the
+// name aggregate_<first_chunk_index>_<last_chunk_index>_<num_elements>. The
+// name encodes which source chunks the file covers so that a restarted worker
+// can finish committing the aggregate and discard the source chunks.
+constexpr char kAggregateFilePrefix[] = "aggregate";
+
+bool IsAggregateFilename(const std::string& filename) {
+  return absl::StartsWith(filename, absl::StrCat(kAggregateFilePrefix, "_"));
+}
+
+absl::StatusOr<std::tuple<int64_t, int64_t, int64_t>> ParseAggregateFilename(
+    const std::string& filename) {
+  std::vector<std::string> tokens = absl::StrSplit(filename, '_');
+  int64_t first_chunk_index = 0, last_chunk_index = 0, num_elements = 0;
+  if (tokens.size() != 4 || tokens[0] != kAggregateFilePrefix ||
+      !absl::SimpleAtoi(tokens[1], &first_chunk_index) ||
+      !absl::SimpleAtoi(tokens[2], &last_chunk_index) ||
+      !absl::SimpleAtoi(tokens[3], &num_elements) || first_chunk_index < 0 ||
+      last_chunk_index < first_chunk_index || num_elements < 0) {
+    return absl::InternalError(absl::StrCat(
+        "Invalid aggregate file name: ", filename,
+        ". Expected aggregate_<first_chunk_index>_<last_chunk_index>_"
+        "<num_elements>."));
+  }
+  return std::make_tuple(first_chunk_index, last_chunk_index, num_elements);
+}
+
 }  // namespace
 
 SnapshotStreamWriter::SnapshotStreamWriter(
@@ -130,6 +165,10 @@ absl::Status SnapshotStreamWriter::InitializeDirectories() {
       params_.env->RecursivelyCreateDir(params_.UncommittedChunksDirectory()));
   TF_RETURN_IF_ERROR(
       params_.env->RecursivelyCreateDir(params_.CheckpointsDirectory()));
+  if (params_.aggregate_chunk_size_bytes > 0) {
+    TF_RETURN_IF_ERROR(
+        params_.env->RecursivelyCreateDir(params_.ChunkIndexDirectory()));
+  }
   return absl::OkStatus();
 }
 
@@ -191,19 +230,20 @@ absl::Status SnapshotStreamWriter::Commit() {
         uncommitted_chunks.size(), "."));
   }
   // Commits all chunks since the last commit.
-  for (int64_t i = 0; i < uncommitted_chunks.size(); ++i) {
-    const std::string& uncommitted_chunk = uncommitted_chunks[i];
+  std::vector<std::pair<int64_t, std::string>> chunks;
+  for (const std::string& uncommitted_chunk : uncommitted_chunks) {
     TF_ASSIGN_OR_RETURN(int64_t chunk_index,
                         GetUncommittedChunkIndex(uncommitted_chunk));
     if (chunk_index <= chunk_index_) {
-      std::string uncommitted_chunk_path = tsl::io::JoinPath(
-          params_.UncommittedChunksDirectory(), uncommitted_chunk);
-      std::string committed_chunk_path = tsl::io::JoinPath(
-          params_.CommittedChunksDirectory(),
-          absl::StrCat("chunk_", params_.stream_index, "_", chunk_index, "_",
-                       chunk_file_to_num_elements_[uncommitted_chunk]));
-      TF_RETURN_IF_ERROR(params_.env->RenameFile(uncommitted_chunk_path,
-                                                 committed_chunk_path));
+      chunks.emplace_back(chunk_index, uncommitted_chunk);
+    }
+  }
+  std::sort(chunks.begin(), chunks.end());
+  if (params_.aggregate_chunk_size_bytes > 0) {
+    TF_RETURN_IF_ERROR(CommitAggregated(chunks));
+  } else {
+    for (const auto& [chunk_index, chunk] : chunks) {
+      TF_RETURN_IF_ERROR(CommitChunk(chunk_index, chunk));
     }
   }
   last_committed_chunk_ = chunk_index_;
@@ -212,6 +252,135 @@ absl::Status SnapshotStreamWriter::Commit() {
   return absl::OkStatus();
 }
 
+absl::Status SnapshotStreamWriter::CommitChunk(int64_t chunk_index,
+                                               const std::string& chunk) {
+  std::string uncommitted_chunk_path =
+      tsl::io::JoinPath(params_.UncommittedChunksDirectory(), chunk);
+  std::string committed_chunk_path =
+      tsl::io::JoinPath(params_.CommittedChunksDirectory(),
+                        absl::StrCat("chunk_", params_.stream_index, "_",
+                                     chunk_index, "_",
+                                     chunk_file_to_num_elements_[chunk]));
+  return params_.env->RenameFile(uncommitted_chunk_path, committed_chunk_path);
+}
+
+absl::Status SnapshotStreamWriter::CommitAggregated(
+    const std::vector<std::pair<int64_t, std::string>>& chunks) {
+  std::vector<std::pair<int64_t, std::string>> bin;
+  uint64 bin_size_bytes = 0;
+  auto commit_bin = [this, &bin, &bin_size_bytes]() -> absl::Status {
+    if (bin.size() == 1) {
+      TF_RETURN_IF_ERROR(CommitChunk(bin.front().first, bin.front().second));
+    } else if (!bin.empty()) {
+      TF_RETURN_IF_ERROR(MergeChunks(bin));
+    }
+    bin.clear();
+    bin_size_bytes = 0;
+    return absl::OkStatus();
+  };
+  for (const auto& [chunk_index, chunk] : chunks) {
+    uint64 chunk_size_bytes = 0;
+    TF_RETURN_IF_ERROR(params_.env->GetFileSize(
+        tsl::io::JoinPath(params_.UncommittedChunksDirectory(), chunk),
+        &chunk_size_bytes));
+    if (!bin.empty() &&
+        bin_size_bytes + chunk_size_bytes >
+            static_cast<uint64>(params_.aggregate_chunk_size_bytes)) {
+      TF_RETURN_IF_ERROR(commit_bin());
+    }
+    bin.emplace_back(chunk_index, chunk);
+    bin_size_bytes += chunk_size_bytes;
+    if (bin_size_bytes >=
+        static_cast<uint64>(params_.aggregate_chunk_size_bytes)) {
+      TF_RETURN_IF_ERROR(commit_bin());
+    }
+  }
+  return commit_bin();
+}
+
+absl::Status SnapshotStreamWriter::MergeChunks(
+    const std::vector<std::pair<int64_t, std::string>>& chunks) {
+  int64_t num_elements = 0;
+  for (const auto& [chunk_index, chunk] : chunks) {
+    num_elements += chunk_file_to_num_elements_[chunk];
+  }
+  const int64_t first_chunk_index = chunks.front().first;
+  const int64_t last_chunk_index = chunks.back().first;
+  std::string aggregate_filename =
+      absl::StrCat(kAggregateFilePrefix, "_", first_chunk_index, "_",
+                   last_chunk_index, "_", num_elements);
+  std::string aggregate_path = tsl::io::JoinPath(
+      params_.UncommittedChunksDirectory(), aggregate_filename);
+  // Temporary files are invisible to `GetChildren`, so a partially written
+  // aggregate is never committed. Once the file is complete, it is renamed to
+  // its final name; the rename makes it durable.
+  std::string temp_path =
+      absl::StrCat(aggregate_path, "__", tsl::random::New64(), ".tmp");
+
+  std::unique_ptr<WritableFile> dest;
+  TF_RETURN_IF_ERROR(
+      params_.env->NewWritableFile(TranslateFileName(temp_path), &dest));
+  io::RecordWriter record_writer(
+      dest.get(),
+      io::RecordWriterOptions::CreateRecordWriterOptions(params_.compression));
+  std::string index;
+  int64_t element_offset = 0;
+  for (const auto& [chunk_index, chunk] : chunks) {
+    TF_RETURN_IF_ERROR(record_writer.Flush());
+    TF_RETURN_IF_ERROR(dest->Flush());
+    int64_t byte_offset = 0;
+    TF_RETURN_IF_ERROR(dest->Tell(&byte_offset));
+    absl::StrAppend(&index, element_offset, " ", byte_offset, "\n");
+    std::string chunk_path =
+        tsl::io::JoinPath(params_.UncommittedChunksDirectory(), chunk);
+    std::unique_ptr<RandomAccessFile> src;
+    TF_RETURN_IF_ERROR(
+        params_.env->NewRandomAccessFile(TranslateFileName(chunk_path), &src));
+    io::SequentialRecordReader record_reader(
+        src.get(), io::RecordReaderOptions::CreateRecordReaderOptions(
+                       params_.compression));
+    while (true) {
+      tstring record;
+      absl::Status status = record_reader.ReadRecord(&record);
+      if (absl::IsOutOfRange(status)) {
+        break;
+      }
+      TF_RETURN_IF_ERROR(status);
+      TF_RETURN_IF_ERROR(record_writer.WriteRecord(record));
+    }
+    element_offset += chunk_file_to_num_elements_[chunk];
+  }
+  TF_RETURN_IF_ERROR(record_writer.Close());
+  TF_RETURN_IF_ERROR(dest->Close());
+  TF_RETURN_IF_ERROR(params_.env->RenameFile(temp_path, aggregate_path));
+  // From this point on, a restarted worker can finish the commit from the
+  // aggregate file alone, so the source chunks can be deleted first.
+  for (const auto& [chunk_index, chunk] : chunks) {
+    TF_RETURN_IF_ERROR(params_.env->DeleteFile(
+        tsl::io::JoinPath(params_.UncommittedChunksDirectory(), chunk)));
+  }
+  TF_RETURN_IF_ERROR(CommitAggregateFile(aggregate_filename));
+  std::string index_path = tsl::io::JoinPath(
+      params_.ChunkIndexDirectory(),
+      absl::StrCat("chunk_", params_.stream_index, "_", first_chunk_index, "_",
+                   num_elements, ".index"));
+  return AtomicallyWriteStringToFile(index_path, index, params_.env);
+}
+
+absl::Status SnapshotStreamWriter::CommitAggregateFile(
+    const std::string& aggregate_filename) {
+  TF_ASSIGN_OR_RETURN(auto aggregate_tokens,
+                      ParseAggregateFilename(aggregate_filename));
+  auto [first_chunk_index, last_chunk_index, num_elements] = aggregate_tokens;
+  std::string aggregate_path = tsl::io::JoinPath(
+      params_.UncommittedChunksDirectory(), aggregate_filename);
+  std::string committed_chunk_path = tsl::io::JoinPath(
+      params_.CommittedChunksDirectory(),
+      absl::StrCat("chunk_", params_.stream_index, "_", first_chunk_index, "_",
+                   num_elements));
+  return params_.env->RenameFile(aggregate_path, committed_chunk_path);
+}
+
 bool SnapshotStreamWriter::ShouldWriteRecord() const TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
   return chunk_size_bytes_ < params_.max_chunk_size_bytes &&
@@ -400,15 +569,60 @@ absl::Status SnapshotStreamWriter::SyncCheckpointWithChunks(
   // a chunk file, this will synchronize the checkpoint with the chunks. It will
   // commit uncommitted chunk files written before the checkpoint and delete
   // chunk files written after the checkpoint.
+  // Deletes partially written aggregate files left behind by a failure.
+  if (!params_.test_only_keep_temp_files) {
+    std::vector<std::string> filenames;
+    TF_RETURN_IF_ERROR(params_.env->GetChildren(
+        params_.UncommittedChunksDirectory(), &filenames));
+    for (const std::string& filename : filenames) {
+      if (IsTemporaryFile(filename)) {
+        TF_RETURN_IF_ERROR(params_.env->DeleteFile(
+            tsl::io::JoinPath(params_.UncommittedChunksDirectory(), filename)));
+      }
+    }
+  }
+
   TF_ASSIGN_OR_RETURN(
       std::vector<std::string> uncommitted_chunks,
       GetChildren(params_.UncommittedChunksDirectory(), params_.env));
 
+  // Finishes the commit of any completed aggregate files first. An aggregate
+  // file is only renamed to its final name once it is fully written, and its
+  // name records which source chunks it covers, so those source chunks are
+  // dropped below regardless of when the worker failed.
+  absl::flat_hash_set<int64_t> aggregated_chunk_indices;
   for (const std::string& uncommitted_chunk : uncommitted_chunks) {
+    if (!IsAggregateFilename(uncommitted_chunk)) {
+      continue;
+    }
+    TF_ASSIGN_OR_RETURN(auto aggregate_tokens,
+                        ParseAggregateFilename(uncommitted_chunk));
+    auto [first_chunk_index, last_chunk_index, num_elements] = aggregate_tokens;
+    for (int64_t i = first_chunk_index; i <= last_chunk_index; ++i) {
+      aggregated_chunk_indices.insert(i);
+    }
+    if (checkpoint_index.has_value() &&
+        first_chunk_index <= *checkpoint_index) {
+      TF_RETURN_IF_ERROR(CommitAggregateFile(uncommitted_chunk));
+    } else {
+      TF_RETURN_IF_ERROR(params_.env->DeleteFile(tsl::io::JoinPath(
+          params_.UncommittedChunksDirectory(), uncommitted_chunk)));
+    }
+  }
+
+  for (const std::string& uncommitted_chunk : uncommitted_chunks) {
+    if (IsAggregateFilename(uncommitted_chunk)) {
+      continue;
+    }
     std::string uncommitted_chunk_filename = tsl::io::JoinPath(
         params_.UncommittedChunksDirectory(), uncommitted_chunk);
     TF_ASSIGN_OR_RETURN(int64_t chunk_index,
                         GetUncommittedChunkIndex(uncommitted_chunk));
+    if (aggregated_chunk_indices.contains(chunk_index)) {
+      // The chunk's contents are covered by an aggregate file.
+      TF_RETURN_IF_ERROR(params_.env->DeleteFile(uncommitted_chunk_filename));
+      continue;
+    }
     if (checkpoint_index.has_value() && chunk_index <= *checkpoint_index) {
       int64_t chunk_num_elements = chunk_index == *checkpoint_index
                                        ? checkpoint_num_elements
@@ -69,6 +69,12 @@ struct SnapshotWriterParams {
   // snapshot. Used only for unit testing.
   bool test_only_keep_temp_files = false;
 
+  // When nonzero, chunk files smaller than this target are merged into larger
+  // aggregated chunks at commit time, and an index file mapping element
+  // ordinals to byte offsets is written for each aggregated chunk. A value of
+  // 0 disables aggregation.
+  int64_t aggregate_chunk_size_bytes = 0;
+
   std::string StreamDirectory() const {
     return tensorflow::data::StreamDirectory(snapshot_path, stream_index);
   }
@@ -86,6 +92,10 @@ struct SnapshotWriterParams {
     return tensorflow::data::CheckpointsDirectory(snapshot_path, stream_index);
   }
 
+  std::string ChunkIndexDirectory() const {
+    return tensorflow::data::ChunkIndexDirectory(snapshot_path);
+  }
+
   std::string DebugString() const {
     return absl::Substitute(
         "SnapshotWriterParams { base_path: $0, stream: $1, compression: $2 }",
@@ -167,6 +177,25 @@ class SnapshotStreamWriter {
   // Commits the chunks since the last commit.
   absl::Status Commit();
 
+  // Commits `chunks` (pairs of chunk index and uncommitted file name, sorted
+  // by index), merging consecutive chunks smaller than
+  // `params_.aggregate_chunk_size_bytes` into aggregated files.
+  absl::Status CommitAggregated(
+      const std::vector<std::pair<int64_t, std::string>>& chunks);
+
+  // Commits a single uncommitted chunk by renaming it into the committed
+  // chunks directory.
+  absl::Status CommitChunk(int64_t chunk_index, const std::string& chunk);
+
+  // Merges the given chunks into one aggregated file, commits it, deletes the
+  // source chunks, and writes an index file recording where each source chunk
+  // begins in the aggregated file.
+  absl::Status MergeChunks(
+      const std::vector<std::pair<int64_t, std::string>>& chunks);
+
+  // Commits a completed aggregate file from the uncommitted chunks directory.
+  absl::Status CommitAggregateFile(const std::string& aggregate_filename);
+
   // Returns the path of the current chunk.
   std::string GetChunkFilePath() const;
   std::string GetCommittedChunkFilePath() const;
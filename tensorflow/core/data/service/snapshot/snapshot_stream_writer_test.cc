@@ -232,6 +232,31 @@ TEST_P(SnapshotStreamWriterParameterizedTest, WriteSnapshotChunks) {
   }
 }
 
+TEST_P(SnapshotStreamWriterParameterizedTest, WriteAggregatedSnapshotChunks) {
+  int64_t range = 10;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<StandaloneTaskIterator> iterator,
+                          TestIterator(testing::RangeDataset(range)));
+
+  std::string compression = GetParam();
+  TF_ASSERT_OK_AND_ASSIGN(std::string snapshot_path, CreateSnapshotDirectory());
+  SnapshotWriterParams writer_params{snapshot_path, /*stream_index=*/0,
+                                     compression, Env::Default(),
+                                     /*max_chunk_size_bytes=*/1};
+  writer_params.aggregate_chunk_size_bytes = 10 * (1 << 20);
+  SnapshotStreamWriter snapshot_writer(writer_params, std::move(iterator));
+  EXPECT_THAT(snapshot_writer.Wait(), IsOkAndHolds(true));
+
+  // The single-element chunks are merged into one aggregated chunk, with an
+  // index file recording where each source chunk begins.
+  EXPECT_THAT(ReadSnapshot<int64_t>(
+                  tsl::io::JoinPath(writer_params.CommittedChunksDirectory(),
+                                    "chunk_0_0_10"),
+                  compression, range),
+              IsOkAndHolds(ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9)));
+  TF_EXPECT_OK(Env::Default()->FileExists(tsl::io::JoinPath(
+      writer_params.ChunkIndexDirectory(), "chunk_0_0_10.index")));
+}
+
 TEST_P(SnapshotStreamWriterParameterizedTest, WriteDoneFile) {
   int64_t range = 10;
   TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<StandaloneTaskIterator> iterator,
@@ -44,8 +44,8 @@ Status DataServiceSplitProvider::GetNext(Tensor* split, bool* end_of_splits)
   TF_RETURN_IF_ERROR(grpc_util::Retry(
       [this, split, end_of_splits]() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
         return dispatcher_->GetSplit(iteration_id_, repetition_,
-                                     split_provider_index_, *split,
-                                     *end_of_splits);
+                                     split_provider_index_, worker_address_,
+                                     *split, *end_of_splits);
       },
       "get next split",
       /*deadline_micros=*/Env::Default()->NowMicros() +
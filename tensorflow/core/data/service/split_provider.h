@@ -36,10 +36,13 @@ namespace data {
 class DataServiceSplitProvider : public SplitProvider {
  public:
   DataServiceSplitProvider(const std::string& address,
-                           const std::string& protocol, int64_t iteration_id,
-                           int64_t split_provider_index, int64_t timeout_ms)
+                           const std::string& protocol,
+                           const std::string& worker_address,
+                           int64_t iteration_id, int64_t split_provider_index,
+                           int64_t timeout_ms)
       : address_(address),
         protocol_(protocol),
+        worker_address_(worker_address),
         iteration_id_(iteration_id),
         split_provider_index_(split_provider_index),
         timeout_ms_(timeout_ms) {}
@@ -54,6 +57,7 @@ class DataServiceSplitProvider : public SplitProvider {
  private:
   const std::string address_;
   const std::string protocol_;
+  const std::string worker_address_;
   const int64_t iteration_id_;
   const int64_t split_provider_index_;
   const int64_t timeout_ms_;
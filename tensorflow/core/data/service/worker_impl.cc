@@ -447,7 +447,7 @@ DataServiceWorkerImpl::MakeDatasetIterator(standalone::Dataset& dataset,
     split_providers.reserve(task_def.num_split_providers());
     for (int i = 0; i < task_def.num_split_providers(); ++i) {
       split_providers.push_back(std::make_unique<DataServiceSplitProvider>(
-          config_.dispatcher_address(), config_.protocol(),
+          config_.dispatcher_address(), config_.protocol(), worker_address_,
           task_def.iteration_id(), i, config_.dispatcher_timeout_ms()));
     }
     TF_RETURN_IF_ERROR(
@@ -737,15 +737,17 @@ Status DataServiceWorkerImpl::UpdateSnapshotWriters(
         &dataset_def));
     TF_ASSIGN_OR_RETURN(std::unique_ptr<StandaloneTaskIterator> iterator,
                         MakeSnapshotTaskIterator(snapshot_task, dataset_def));
+    SnapshotWriterParams writer_params{
+        snapshot_task.base_path(), snapshot_task.stream_index(),
+        snapshot_task.metadata().compression(), Env::Default(),
+        config_.snapshot_max_chunk_size_bytes()};
+    writer_params.aggregate_chunk_size_bytes =
+        config_.snapshot_aggregate_chunk_size_bytes();
     mutex_lock l(mu_);
     snapshot_writers_.emplace(
         snapshot_task_key,
-        std::make_unique<SnapshotStreamWriter>(
-            SnapshotWriterParams{
-                snapshot_task.base_path(), snapshot_task.stream_index(),
-                snapshot_task.metadata().compression(), Env::Default(),
-                config_.snapshot_max_chunk_size_bytes()},
-            std::move(iterator)));
+        std::make_unique<SnapshotStreamWriter>(writer_params,
+                                               std::move(iterator)));
   }
 
   // Cancel writers for snapshots that are no longer assigned by the dispatcher.
@@ -0,0 +1,110 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/shared_thread_pool.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/notification.h"
+#include "tensorflow/core/platform/numa.h"
+#include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+constexpr char kSharedThreadPoolSizeEnv[] = "TF_DATA_SHARED_THREADPOOL_SIZE";
+constexpr char kSharedThreadPoolNumaNodeEnv[] =
+    "TF_DATA_SHARED_THREADPOOL_NUMA_NODE";
+
+// Pins every worker thread of `pool` to the CPUs of `numa_node`. Occupies
+// all `num_threads` workers with a barrier so that each of them runs the
+// pinning closure exactly once.
+void PinThreadPoolToNumaNode(thread::ThreadPool* pool, int num_threads,
+                             int numa_node) {
+  BlockingCounter all_pinned(num_threads);
+  Notification release;
+  for (int i = 0; i < num_threads; ++i) {
+    pool->Schedule([numa_node, &all_pinned, &release]() {
+      port::NUMASetThreadNodeAffinity(numa_node);
+      all_pinned.DecrementCount();
+      release.WaitForNotification();
+    });
+  }
+  all_pinned.Wait();
+  release.Notify();
+}
+
+}  // namespace
+
+std::unique_ptr<thread::ThreadPool> CreateSharedThreadPool(int num_threads,
+                                                           int numa_node) {
+  auto pool = std::make_unique<thread::ThreadPool>(
+      Env::Default(), ThreadOptions{}, "data_shared_threadpool", num_threads);
+  if (numa_node >= 0) {
+    if (port::NUMAEnabled() && numa_node < port::NUMANumNodes()) {
+      PinThreadPoolToNumaNode(pool.get(), num_threads, numa_node);
+    } else {
+      LOG(WARNING) << "Ignoring request to pin the tf.data shared thread pool "
+                      "to NUMA node "
+                   << numa_node << ": the host reports "
+                   << port::NUMANumNodes() << " NUMA node(s).";
+    }
+  }
+  return pool;
+}
+
+thread::ThreadPool* GetSharedThreadPool() {
+  static thread::ThreadPool* const pool = []() -> thread::ThreadPool* {
+    int64_t num_threads;
+    Status s = ReadInt64FromEnvVar(kSharedThreadPoolSizeEnv,
+                                   /*default_val=*/0, &num_threads);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to read " << kSharedThreadPoolSizeEnv << ": "
+                   << s;
+      return nullptr;
+    }
+    if (num_threads <= 0) {
+      return nullptr;
+    }
+    num_threads = std::min(num_threads,
+                           static_cast<int64_t>(port::MaxParallelism()));
+    int64_t numa_node;
+    s = ReadInt64FromEnvVar(kSharedThreadPoolNumaNodeEnv,
+                            /*default_val=*/-1, &numa_node);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to read " << kSharedThreadPoolNumaNodeEnv << ": "
+                   << s;
+      numa_node = -1;
+    }
+    VLOG(1) << "Creating the shared tf.data worker thread pool with "
+            << num_threads << " threads"
+            << (numa_node >= 0
+                    ? strings::StrCat(", pinned to NUMA node ", numa_node)
+                    : "");
+    return CreateSharedThreadPool(static_cast<int>(num_threads),
+                                  static_cast<int>(numa_node))
+        .release();
+  }();
+  return pool;
+}
+
+}  // namespace data
+}  // namespace tensorflow
@@ -0,0 +1,48 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_DATA_SHARED_THREAD_POOL_H_
+#define TENSORFLOW_CORE_DATA_SHARED_THREAD_POOL_H_
+
+#include <memory>
+
+#include "tensorflow/core/lib/core/threadpool.h"
+
+namespace tensorflow {
+namespace data {
+
+// Creates a thread pool for running tf.data runner closures. If `numa_node`
+// is non-negative, every worker thread pins itself to the CPUs of that NUMA
+// node before accepting work, so input-pipeline threads stop migrating onto
+// (and stealing cycles from) the cores running intra-op compute.
+std::unique_ptr<thread::ThreadPool> CreateSharedThreadPool(int num_threads,
+                                                           int numa_node);
+
+// Returns the process-wide shared tf.data worker thread pool, or `nullptr` if
+// it is disabled. The pool caps the total CPU parallelism of all input
+// pipelines in the process: iterators without an explicit private thread pool
+// schedule their runner closures here instead of the (per-iterator) inter-op
+// pool, so the number of active input-pipeline threads no longer scales with
+// the number of parallel datasets.
+//
+// The pool is configured with the `TF_DATA_SHARED_THREADPOOL_SIZE` environment
+// variable (unset or <= 0 disables it) and optionally pinned with
+// `TF_DATA_SHARED_THREADPOOL_NUMA_NODE`. The pool is created on first use and
+// lives for the lifetime of the process.
+thread::ThreadPool* GetSharedThreadPool();
+
+}  // namespace data
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DATA_SHARED_THREAD_POOL_H_
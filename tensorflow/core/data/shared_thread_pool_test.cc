@@ -0,0 +1,65 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/data/shared_thread_pool.h"
+
+#include <atomic>
+#include <memory>
+
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+TEST(SharedThreadPoolTest, DisabledByDefault) {
+  // `TF_DATA_SHARED_THREADPOOL_SIZE` is not set in the test environment, so
+  // the process-wide pool must be disabled.
+  EXPECT_EQ(GetSharedThreadPool(), nullptr);
+}
+
+TEST(SharedThreadPoolTest, RunsScheduledWork) {
+  constexpr int kNumThreads = 2;
+  constexpr int kNumTasks = 100;
+  std::unique_ptr<thread::ThreadPool> pool =
+      CreateSharedThreadPool(kNumThreads, /*numa_node=*/-1);
+  ASSERT_EQ(pool->NumThreads(), kNumThreads);
+
+  std::atomic<int> num_completed(0);
+  BlockingCounter counter(kNumTasks);
+  for (int i = 0; i < kNumTasks; ++i) {
+    pool->Schedule([&num_completed, &counter]() {
+      ++num_completed;
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  EXPECT_EQ(num_completed.load(), kNumTasks);
+}
+
+TEST(SharedThreadPoolTest, IgnoresInvalidNumaNode) {
+  // A NUMA node beyond what the host reports must not prevent pool creation.
+  std::unique_ptr<thread::ThreadPool> pool =
+      CreateSharedThreadPool(/*num_threads=*/1, /*numa_node=*/1 << 20);
+  ASSERT_NE(pool, nullptr);
+
+  BlockingCounter counter(1);
+  pool->Schedule([&counter]() { counter.DecrementCount(); });
+  counter.Wait();
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/snapshot.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/lib/io/snappy/snappy_inputbuffer.h"
 #include "tsl/lib/io/snappy/snappy_outputbuffer.h"
 #include "tsl/platform/errors.h"
@@ -128,6 +129,10 @@ Status Writer::Create(Env* env, const std::string& filename,
       *out_writer =
           std::make_unique<TFRecordWriter>(filename, compression_type);
       break;
+    case 3:
+      *out_writer =
+          std::make_unique<ColumnarWriter>(filename, compression_type, dtypes);
+      break;
     default:
       return errors::InvalidArgument("Snapshot writer version: ", version,
                                      " is not supported.");
@@ -207,6 +212,121 @@ TFRecordWriter::~TFRecordWriter() {
   }
 }
 
+ColumnarWriter::ColumnarWriter(const std::string& filename,
+                               const std::string& compression_type,
+                               const DataTypeVector& dtypes)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes) {}
+
+Status ColumnarWriter::Initialize(tensorflow::Env* env) {
+  if (compression_type_ != io::compression::kNone &&
+      compression_type_ != io::compression::kSnappy) {
+    return errors::InvalidArgument(
+        "Columnar snapshots support no compression or snappy compression, "
+        "received: ",
+        compression_type_);
+  }
+  TF_RETURN_IF_ERROR(env->NewWritableFile(filename_, &dest_));
+  column_buffers_.resize(dtypes_.size());
+  return OkStatus();
+}
+
+Status ColumnarWriter::WriteTensors(const std::vector<Tensor>& tensors) {
+  if (tensors.size() != dtypes_.size()) {
+    return errors::InvalidArgument("Expected an element with ", dtypes_.size(),
+                                   " components but got ", tensors.size(),
+                                   ".");
+  }
+  for (int i = 0, end = tensors.size(); i < end; ++i) {
+    TensorProto proto;
+    tensors[i].AsProtoTensorContent(&proto);
+    std::string proto_serialized;
+    if (!proto.SerializeToString(&proto_serialized)) {
+      return errors::DataLoss(ProtoSerializationErrorMessage(proto, filename_));
+    }
+    char header[sizeof(uint64)];
+    core::EncodeFixed64(header, proto_serialized.size());
+    column_buffers_[i].append(header, sizeof(header));
+    column_buffers_[i].append(proto_serialized);
+    buffered_bytes_ += sizeof(header) + proto_serialized.size();
+  }
+  ++buffered_rows_;
+  if (buffered_rows_ >= kRowsPerChunk || buffered_bytes_ >= kChunkBufferBytes) {
+    return FlushChunk();
+  }
+  return OkStatus();
+}
+
+Status ColumnarWriter::FlushChunk() {
+  if (buffered_rows_ == 0) {
+    return OkStatus();
+  }
+  ChunkMetadata chunk;
+  chunk.num_rows = buffered_rows_;
+  chunk.offsets.reserve(column_buffers_.size());
+  chunk.lengths.reserve(column_buffers_.size());
+  for (std::string& column : column_buffers_) {
+    StringPiece block = column;
+    std::string compressed;
+    if (compression_type_ == io::compression::kSnappy) {
+      if (!tsl::port::Snappy_Compress(column.data(), column.size(),
+                                      &compressed)) {
+        return errors::Internal("Failed to compress using snappy.");
+      }
+      block = compressed;
+    }
+    chunk.offsets.push_back(bytes_written_);
+    chunk.lengths.push_back(block.size());
+    TF_RETURN_IF_ERROR(dest_->Append(block));
+    bytes_written_ += block.size();
+    column.clear();
+  }
+  chunks_.push_back(std::move(chunk));
+  buffered_rows_ = 0;
+  buffered_bytes_ = 0;
+  return OkStatus();
+}
+
+Status ColumnarWriter::Sync() {
+  TF_RETURN_IF_ERROR(FlushChunk());
+  return dest_->Flush();
+}
+
+Status ColumnarWriter::Close() {
+  if (dest_ == nullptr) {
+    return OkStatus();
+  }
+  TF_RETURN_IF_ERROR(FlushChunk());
+  std::string footer;
+  char scratch[sizeof(uint64)];
+  auto append_fixed64 = [&footer, &scratch](uint64 value) {
+    core::EncodeFixed64(scratch, value);
+    footer.append(scratch, sizeof(scratch));
+  };
+  for (const ChunkMetadata& chunk : chunks_) {
+    append_fixed64(chunk.num_rows);
+    for (int i = 0, end = chunk.offsets.size(); i < end; ++i) {
+      append_fixed64(chunk.offsets[i]);
+      append_fixed64(chunk.lengths[i]);
+    }
+  }
+  append_fixed64(chunks_.size());
+  append_fixed64(dtypes_.size());
+  append_fixed64(kFooterMagic);
+  TF_RETURN_IF_ERROR(dest_->Append(footer));
+  TF_RETURN_IF_ERROR(dest_->Close());
+  dest_ = nullptr;
+  return OkStatus();
+}
+
+ColumnarWriter::~ColumnarWriter() {
+  Status s = Close();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to close snapshot file " << filename_ << ": " << s;
+  }
+}
+
 CustomWriter::CustomWriter(const std::string& filename,
                            const std::string& compression_type,
                            const DataTypeVector& dtypes)
@@ -385,6 +505,10 @@ Status Reader::Create(Env* env, const std::string& filename,
       *out_reader =
           std::make_unique<TFRecordReader>(filename, compression_type, dtypes);
       break;
+    case 3:
+      *out_reader =
+          std::make_unique<ColumnarReader>(filename, compression_type, dtypes);
+      break;
     default:
       return errors::InvalidArgument("Snapshot reader version: ", version,
                                      " is not supported.");
@@ -815,6 +939,175 @@ Status TFRecordReader::ReadTensors(std::vector<Tensor>* read_tensors) {
   return OkStatus();
 }
 
+ColumnarReader::ColumnarReader(const std::string& filename,
+                               const string& compression_type,
+                               const DataTypeVector& dtypes,
+                               std::vector<int64_t> projection)
+    : filename_(filename),
+      compression_type_(compression_type),
+      dtypes_(dtypes),
+      projection_(std::move(projection)) {}
+
+Status ColumnarReader::Initialize(Env* env) {
+  if (compression_type_ != io::compression::kNone &&
+      compression_type_ != io::compression::kSnappy) {
+    return errors::InvalidArgument(
+        "Columnar snapshots support no compression or snappy compression, "
+        "received: ",
+        compression_type_);
+  }
+  if (projection_.empty()) {
+    for (int64_t i = 0, end = dtypes_.size(); i < end; ++i) {
+      projection_.push_back(i);
+    }
+  } else {
+    for (int64_t column : projection_) {
+      if (column < 0 || column >= static_cast<int64_t>(dtypes_.size())) {
+        return errors::InvalidArgument("Invalid projection column ", column,
+                                       " for a snapshot with ", dtypes_.size(),
+                                       " components.");
+      }
+    }
+  }
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename_, &file_));
+  return ReadFooter(env);
+}
+
+Status ColumnarReader::ReadFooter(Env* env) {
+  uint64 file_size;
+  TF_RETURN_IF_ERROR(env->GetFileSize(filename_, &file_size));
+  constexpr uint64 kTrailerSize = 3 * sizeof(uint64);
+  if (file_size < kTrailerSize) {
+    return errors::DataLoss("Columnar snapshot file too small: ", filename_);
+  }
+  char scratch[kTrailerSize];
+  StringPiece result;
+  TF_RETURN_IF_ERROR(
+      file_->Read(file_size - kTrailerSize, kTrailerSize, &result, scratch));
+  const char* trailer = result.data();
+  const uint64 num_chunks = core::DecodeFixed64(trailer);
+  const uint64 num_columns = core::DecodeFixed64(trailer + sizeof(uint64));
+  const uint64 magic = core::DecodeFixed64(trailer + 2 * sizeof(uint64));
+  if (magic != ColumnarWriter::kFooterMagic) {
+    return errors::DataLoss("Bad columnar snapshot footer in ", filename_);
+  }
+  if (num_columns != dtypes_.size()) {
+    return errors::InvalidArgument("Columnar snapshot ", filename_, " has ",
+                                   num_columns, " components but ",
+                                   dtypes_.size(), " were expected.");
+  }
+  const uint64 footer_size =
+      num_chunks * (1 + 2 * num_columns) * sizeof(uint64);
+  if (file_size < kTrailerSize + footer_size) {
+    return errors::DataLoss("Truncated columnar snapshot footer in ",
+                            filename_);
+  }
+  std::string footer(footer_size, '\0');
+  TF_RETURN_IF_ERROR(file_->Read(file_size - kTrailerSize - footer_size,
+                                 footer_size, &result, &footer[0]));
+  const char* p = result.data();
+  chunks_.reserve(num_chunks);
+  for (uint64 i = 0; i < num_chunks; ++i) {
+    ChunkMetadata chunk;
+    chunk.num_rows = core::DecodeFixed64(p);
+    p += sizeof(uint64);
+    chunk.offsets.reserve(num_columns);
+    chunk.lengths.reserve(num_columns);
+    for (uint64 c = 0; c < num_columns; ++c) {
+      chunk.offsets.push_back(core::DecodeFixed64(p));
+      p += sizeof(uint64);
+      chunk.lengths.push_back(core::DecodeFixed64(p));
+      p += sizeof(uint64);
+    }
+    chunks_.push_back(std::move(chunk));
+  }
+  return OkStatus();
+}
+
+Status ColumnarReader::ReadColumnBlock(uint64 offset, uint64 length,
+                                       std::string* block) {
+  std::string raw(length, '\0');
+  StringPiece result;
+  TF_RETURN_IF_ERROR(file_->Read(offset, length, &result, &raw[0]));
+  if (result.size() != length) {
+    return errors::DataLoss("Truncated column chunk in ", filename_);
+  }
+  if (compression_type_ == io::compression::kSnappy) {
+    size_t uncompressed_size;
+    if (!tsl::port::Snappy_GetUncompressedLength(result.data(), result.size(),
+                                                 &uncompressed_size)) {
+      return errors::Internal("Failed to get snappy uncompressed length.");
+    }
+    block->resize(uncompressed_size);
+    if (!tsl::port::Snappy_Uncompress(result.data(), result.size(),
+                                      &(*block)[0])) {
+      return errors::Internal("Failed to uncompress using snappy.");
+    }
+  } else if (result.data() == raw.data()) {
+    *block = std::move(raw);
+  } else {
+    block->assign(result.data(), result.size());
+  }
+  return OkStatus();
+}
+
+Status ColumnarReader::ReadChunk() {
+  const ChunkMetadata& chunk = chunks_[next_chunk_];
+  chunk_columns_.clear();
+  chunk_columns_.resize(projection_.size());
+  for (int i = 0, end = projection_.size(); i < end; ++i) {
+    const int64_t column = projection_[i];
+    std::string block;
+    TF_RETURN_IF_ERROR(
+        ReadColumnBlock(chunk.offsets[column], chunk.lengths[column], &block));
+    chunk_columns_[i].reserve(chunk.num_rows);
+    const char* p = block.data();
+    const char* limit = block.data() + block.size();
+    for (int64_t row = 0; row < chunk.num_rows; ++row) {
+      if (static_cast<size_t>(limit - p) < sizeof(uint64)) {
+        return errors::DataLoss("Truncated column chunk in ", filename_);
+      }
+      const uint64 length = core::DecodeFixed64(p);
+      p += sizeof(uint64);
+      if (static_cast<uint64>(limit - p) < length) {
+        return errors::DataLoss("Truncated column chunk in ", filename_);
+      }
+      TensorProto proto;
+      if (!proto.ParseFromArray(p, length)) {
+        return errors::DataLoss("Unable to parse tensor from stored proto in ",
+                                filename_, ".");
+      }
+      p += length;
+      Tensor tensor;
+      if (!tensor.FromProto(proto)) {
+        return errors::DataLoss("Unable to parse tensor from stored proto in ",
+                                filename_, ".");
+      }
+      chunk_columns_[i].push_back(std::move(tensor));
+    }
+  }
+  rows_in_chunk_ = chunk.num_rows;
+  row_in_chunk_ = 0;
+  ++next_chunk_;
+  return OkStatus();
+}
+
+Status ColumnarReader::ReadTensors(std::vector<Tensor>* read_tensors) {
+  while (row_in_chunk_ >= rows_in_chunk_) {
+    if (next_chunk_ >= chunks_.size()) {
+      return errors::OutOfRange("eof");
+    }
+    TF_RETURN_IF_ERROR(ReadChunk());
+  }
+  read_tensors->clear();
+  read_tensors->reserve(projection_.size());
+  for (int i = 0, end = projection_.size(); i < end; ++i) {
+    read_tensors->push_back(std::move(chunk_columns_[i][row_in_chunk_]));
+  }
+  ++row_in_chunk_;
+  return OkStatus();
+}
+
 CustomReader::CustomReader(const std::string& filename,
                            const string& compression_type, const int version,
                            const DataTypeVector& dtypes)
@@ -1076,6 +1369,18 @@ Status DumpDatasetGraph(Env* env, const std::string& path, uint64 hash,
   return WriteTextProto(env, graph_file, *graph);
 }
 
+int64_t WriterFileFormatVersion(int64_t default_version) {
+  int64_t version;
+  Status s = ReadInt64FromEnvVar("TF_DATA_SNAPSHOT_FILE_FORMAT_VERSION",
+                                 default_version, &version);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to read TF_DATA_SNAPSHOT_FILE_FORMAT_VERSION: "
+                 << s;
+    return default_version;
+  }
+  return version;
+}
+
 Status DetermineOpState(const std::string& mode_string, bool file_exists,
                         const experimental::SnapshotMetadataRecord* metadata,
                         const uint64 pending_snapshot_expiry_seconds,
@@ -131,6 +131,71 @@ class TFRecordWriter : public Writer {
   std::unique_ptr<io::RecordWriter> record_writer_;
 };
 
+// Writes snapshots with a columnar chunk layout. Elements are buffered and
+// flushed in chunks; within a chunk, the serialized tensors of each component
+// ("column") are stored contiguously, and the byte range of every column
+// chunk is recorded in a footer at the end of the file. This allows readers
+// that only need a subset of the components to read proportionally less data
+// from disk (see `ColumnarReader`).
+//
+// The on-disk layout is:
+//
+//   [column chunk]*                  // `num_chunks * num_columns` blocks
+//   [footer]                         // per-chunk rows and column byte ranges
+//   [num_chunks : fixed64]
+//   [num_columns : fixed64]
+//   [magic : fixed64]
+//
+// where each column chunk holds `num_rows` length-prefixed serialized
+// `TensorProto`s, optionally Snappy-compressed as a block.
+class ColumnarWriter : public Writer {
+ public:
+  // A chunk is flushed once it holds `kRowsPerChunk` elements or buffers more
+  // than `kChunkBufferBytes`, whichever comes first.
+  static constexpr int64_t kRowsPerChunk = 4096;
+  static constexpr int64_t kChunkBufferBytes = 16 << 20;  // 16 MiB
+
+  static constexpr uint64 kFooterMagic = 0x636f6c736e617073ull;
+
+  ColumnarWriter(const std::string& filename,
+                 const std::string& compression_type,
+                 const DataTypeVector& dtypes);
+
+  Status WriteTensors(const std::vector<Tensor>& tensors) override;
+
+  Status Sync() override;
+
+  Status Close() override;
+
+  ~ColumnarWriter() override;
+
+ protected:
+  Status Initialize(tensorflow::Env* env) override;
+
+ private:
+  struct ChunkMetadata {
+    int64_t num_rows = 0;
+    // Byte ranges of this chunk's column blocks, indexed by component.
+    std::vector<uint64> offsets;
+    std::vector<uint64> lengths;
+  };
+
+  // Writes the buffered rows as one column chunk per component.
+  Status FlushChunk();
+
+  const std::string filename_;
+  const std::string compression_type_;
+  const DataTypeVector dtypes_;
+
+  std::unique_ptr<WritableFile> dest_;
+  // Per-component buffers of length-prefixed serialized tensors.
+  std::vector<std::string> column_buffers_;
+  int64_t buffered_rows_ = 0;
+  int64_t buffered_bytes_ = 0;
+  uint64 bytes_written_ = 0;
+  std::vector<ChunkMetadata> chunks_;
+};
+
 // Writes snapshot with a custom (legacy) file format.
 class CustomWriter : public Writer {
  public:
@@ -311,6 +376,58 @@ class TFRecordReader : public Reader {
   const DataTypeVector dtypes_;
 };
 
+// Reads snapshots previously written with `ColumnarWriter`.
+//
+// A projection — a list of component indices — restricts reading to those
+// columns: `ReadTensors` then returns only the projected components, in the
+// projection's order, and only the corresponding column byte ranges are read
+// from disk. An empty projection reads all components.
+class ColumnarReader : public Reader {
+ public:
+  ColumnarReader(const std::string& filename, const string& compression_type,
+                 const DataTypeVector& dtypes,
+                 std::vector<int64_t> projection = {});
+
+  // Initializes the reader. Callers must initialize the reader before calling
+  // `ReadTensors`.
+  Status Initialize(Env* env) override;
+
+  Status ReadTensors(std::vector<Tensor>* read_tensors) override;
+
+  ~ColumnarReader() override = default;
+
+ private:
+  struct ChunkMetadata {
+    int64_t num_rows = 0;
+    std::vector<uint64> offsets;
+    std::vector<uint64> lengths;
+  };
+
+  // Reads the footer and populates `chunks_`.
+  Status ReadFooter(Env* env);
+
+  // Reads and decodes the next chunk's projected columns.
+  Status ReadChunk();
+
+  // Reads the byte range of a column block and decompresses it if needed.
+  Status ReadColumnBlock(uint64 offset, uint64 length, std::string* block);
+
+  const std::string filename_;
+  const string compression_type_;
+  const DataTypeVector dtypes_;
+  // Component indices to read; never empty after `Initialize`.
+  std::vector<int64_t> projection_;
+
+  std::unique_ptr<RandomAccessFile> file_;
+  std::vector<ChunkMetadata> chunks_;
+  size_t next_chunk_ = 0;
+
+  // Decoded tensors of the current chunk, indexed by [projected column][row].
+  std::vector<std::vector<Tensor>> chunk_columns_;
+  int64_t row_in_chunk_ = 0;
+  int64_t rows_in_chunk_ = 0;
+};
+
 // Reads snapshots previously written with `CustomWriter`.
 class CustomReader : public Reader {
  public:
@@ -393,6 +510,13 @@ Status ReadMetadataFile(Env* env, const string& dir,
 Status DumpDatasetGraph(Env* env, const std::string& path, uint64 hash,
                         const GraphDef* graph);
 
+// Returns the file format version that snapshot writers should use:
+// `default_version`, unless overridden with the
+// `TF_DATA_SNAPSHOT_FILE_FORMAT_VERSION` environment variable (e.g. to opt
+// into the columnar format, version 3). Readers are unaffected; they use the
+// version recorded in the snapshot metadata.
+int64_t WriterFileFormatVersion(int64_t default_version);
+
 Status DetermineOpState(const std::string& mode_string, bool file_exists,
                         const experimental::SnapshotMetadataRecord* metadata,
                         uint64 pending_snapshot_expiry_seconds, Mode* mode);
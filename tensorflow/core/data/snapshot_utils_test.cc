@@ -17,14 +17,17 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "tensorflow/core/data/service/test_util.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/lib/io/compression.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/strcat.h"
 #include "tensorflow/core/platform/test.h"
 #include "tensorflow/core/platform/test_benchmark.h"
 
@@ -99,6 +102,57 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kSnappy, 2);
 }
 
+TEST(SnapshotUtilTest, ColumnarRoundTripTest) {
+  SnapshotRoundTrip(io::compression::kNone, 3);
+  SnapshotRoundTrip(io::compression::kSnappy, 3);
+}
+
+TEST(SnapshotUtilTest, ColumnarProjectionReadsSelectedColumns) {
+  constexpr int kNumColumns = 4;
+  constexpr int kNumElements = 50;
+  std::vector<Tensor> tensors;
+  tensorflow::DataTypeVector dtypes;
+  for (int i = 0; i < kNumColumns; ++i) {
+    Tensor t(DT_STRING, TensorShape({}));
+    t.scalar<tstring>()() = strings::StrCat("column-", i);
+    dtypes.push_back(t.dtype());
+    tensors.push_back(std::move(t));
+  }
+
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(Env::Default(), filename, io::compression::kNone,
+                              /*version=*/3, dtypes, &writer));
+  for (int i = 0; i < kNumElements; ++i) {
+    TF_ASSERT_OK(writer->WriteTensors(tensors));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  ColumnarReader reader(filename, io::compression::kNone, dtypes,
+                        /*projection=*/{2, 0});
+  TF_ASSERT_OK(reader.Initialize(Env::Default()));
+  for (int i = 0; i < kNumElements; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader.ReadTensors(&read_tensors));
+    ASSERT_EQ(read_tensors.size(), 2);
+    EXPECT_EQ(read_tensors[0].scalar<tstring>()(), "column-2");
+    EXPECT_EQ(read_tensors[1].scalar<tstring>()(), "column-0");
+  }
+  std::vector<Tensor> read_tensors;
+  EXPECT_TRUE(absl::IsOutOfRange(reader.ReadTensors(&read_tensors)));
+
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+}
+
+TEST(SnapshotUtilTest, ColumnarProjectionRejectsInvalidColumn) {
+  tensorflow::DataTypeVector dtypes = {DT_STRING};
+  ColumnarReader reader("unused_filename", io::compression::kNone, dtypes,
+                        /*projection=*/{1});
+  EXPECT_TRUE(absl::IsInvalidArgument(reader.Initialize(Env::Default())));
+}
+
 TEST(SnapshotUtilTest, MetadataFileRoundTrip) {
   experimental::DistributedSnapshotMetadata metadata_in;
   metadata_in.set_compression(io::compression::kGzip);
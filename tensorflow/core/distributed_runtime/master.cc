@@ -108,7 +108,7 @@ void Master::GC() {
       if (static_cast<int64_t>(env->NowMicros()) - lat > num_micros) {
         handles.push_back(entry.first);
         auto* sess = entry.second;
-        SchedClosure([this, sess]() {
+        SchedClosure(SchedClosureKind::kGarbageCollection, [this, sess]() {
           LOG(WARNING) << "GC session " << sess->handle() << " after "
                        << session_gc_seconds_ << " seconds.  "
                        << "Note that if you are starting multiple replicas "
@@ -672,7 +672,8 @@ void Master::Reset(const ResetRequest* req, ResetResponse* resp,
 
   CleanupWorkers(*req);
 
-  SchedClosure([sessions_to_close, done]() {
+  SchedClosure(SchedClosureKind::kGarbageCollection, [sessions_to_close,
+                                                      done]() {
     Status s;
     for (MasterSession* session : sessions_to_close) {
       s.Update(session->Close());
@@ -37,9 +37,11 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/master.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_master_service_impl.h"
 #include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/tracing.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/protobuf/master.pb.h"
 #include "tsl/distributed_runtime/rpc/async_service_interface.h"
@@ -54,6 +56,17 @@ class GrpcMasterService : public tsl::AsyncServiceInterface {
       : master_impl_(master),
         is_shutdown_(false),
         default_session_config_(default_session_config) {
+    // Session-less ListDevices calls fan out to every worker in the cluster.
+    // Orchestrators that poll them can opt into a cached response with a
+    // bounded staleness instead of re-enumerating the cluster on every call.
+    int64_t cache_ms;
+    Status s = ReadInt64FromEnvVar("TF_MASTER_LIST_DEVICES_CACHE_MS",
+                                   /*default_val=*/0, &cache_ms);
+    if (!s.ok()) {
+      LOG(WARNING) << "Invalid TF_MASTER_LIST_DEVICES_CACHE_MS: " << s;
+      cache_ms = 0;
+    }
+    list_devices_cache_micros_ = cache_ms * 1000;
     builder->RegisterService(&master_service_);
     cq_ = builder->AddCompletionQueue();
   }
@@ -144,6 +157,14 @@ class GrpcMasterService : public tsl::AsyncServiceInterface {
   const ConfigProto default_session_config_;
   ::grpc::Alarm* shutdown_alarm_ = nullptr;
 
+  // Cached response for session-less ListDevices calls, valid until the
+  // expiry time. Disabled (never populated) when the configured lifetime is
+  // zero.
+  int64_t list_devices_cache_micros_ = 0;
+  mutex list_devices_mu_;
+  ListDevicesResponse list_devices_cache_ TF_GUARDED_BY(list_devices_mu_);
+  uint64 list_devices_cache_expiry_micros_ TF_GUARDED_BY(list_devices_mu_) = 0;
+
   template <class RequestMessage, class ResponseMessage>
   using MasterCall =
       tsl::Call<GrpcMasterService, grpc::MasterService::AsyncService,
@@ -183,28 +204,35 @@ class GrpcMasterService : public tsl::AsyncServiceInterface {
     ENQUEUE_REQUEST(PartialRunSetup, false);
   }
 
+  // Per-call state for RunStep that outlives the handler frame. Bundled into
+  // one struct so the hot path pays a single allocation rather than one per
+  // member.
+  struct RunStepCallState {
+    explicit RunStepCallState(
+        MasterCall<RunStepRequest, RunStepResponse>* call)
+        : wrapped_request(&call->request),
+          wrapped_response(&call->response) {}
+    CallOptions call_opts;
+    ProtoRunStepRequest wrapped_request;
+    NonOwnedProtoRunStepResponse wrapped_response;
+  };
+
   // RPC handler for running one step in a session.
   void RunStepHandler(MasterCall<RunStepRequest, RunStepResponse>* call) {
     auto* trace = TraceRpc("RunStep/Server", call->client_metadata());
-    CallOptions* call_opts = new CallOptions;
+    RunStepCallState* state = new RunStepCallState(call);
+    CallOptions* call_opts = &state->call_opts;
     if (call->request.options().timeout_in_ms() > 0) {
       call_opts->SetTimeout(call->request.options().timeout_in_ms());
     } else {
       call_opts->SetTimeout(default_session_config_.operation_timeout_in_ms());
     }
-    RunStepRequestWrapper* wrapped_request =
-        new ProtoRunStepRequest(&call->request);
-    MutableRunStepResponseWrapper* wrapped_response =
-        new NonOwnedProtoRunStepResponse(&call->response);
     call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
     master_impl_->RunStep(
-        call_opts, wrapped_request, wrapped_response,
-        [call, call_opts, wrapped_request, wrapped_response,
-         trace](const Status& status) {
+        call_opts, &state->wrapped_request, &state->wrapped_response,
+        [call, state, trace](const Status& status) {
           call->ClearCancelCallback();
-          delete call_opts;
-          delete wrapped_request;
-          delete wrapped_response;
+          delete state;
           delete trace;
           if (call->request.store_errors_in_response_body() && !status.ok()) {
             call->response.set_status_code(
@@ -232,10 +260,31 @@ class GrpcMasterService : public tsl::AsyncServiceInterface {
   // RPC handler for listing devices.
   void ListDevicesHandler(
       MasterCall<ListDevicesRequest, ListDevicesResponse>* call) {
-    master_impl_->ListDevices(&call->request, &call->response,
-                              [call](const Status& status) {
-                                call->SendResponse(ToGrpcStatus(status));
-                              });
+    // The session-less form of the query enumerates the whole cluster and its
+    // result only changes when workers come or go, so serve it from the cache
+    // when one is enabled and fresh. Per-session queries are cheap and depend
+    // on session state; they always go to the master.
+    if (list_devices_cache_micros_ > 0 &&
+        call->request.session_handle().empty()) {
+      mutex_lock l(list_devices_mu_);
+      if (list_devices_cache_expiry_micros_ > Env::Default()->NowMicros()) {
+        call->response = list_devices_cache_;
+        call->SendResponse(ToGrpcStatus(OkStatus()));
+        ENQUEUE_REQUEST(ListDevices, false);
+        return;
+      }
+    }
+    master_impl_->ListDevices(
+        &call->request, &call->response, [this, call](const Status& status) {
+          if (status.ok() && list_devices_cache_micros_ > 0 &&
+              call->request.session_handle().empty()) {
+            mutex_lock l(list_devices_mu_);
+            list_devices_cache_ = call->response;
+            list_devices_cache_expiry_micros_ =
+                Env::Default()->NowMicros() + list_devices_cache_micros_;
+          }
+          call->SendResponse(ToGrpcStatus(status));
+        });
     ENQUEUE_REQUEST(ListDevices, false);
   }
 
@@ -59,6 +59,7 @@ class GrpcRemoteWorker : public WorkerInterface {
         cleanupgraph_(Method(GrpcWorkerMethod::kCleanupGraph)),
         cleanupall_(Method(GrpcWorkerMethod::kCleanupAll)),
         recvtensor_(Method(GrpcWorkerMethod::kRecvTensor)),
+        multirecvtensor_(Method(GrpcWorkerMethod::kMultiRecvTensor)),
         recvbuf_(Method(GrpcWorkerMethod::kRecvBuf)),
         logging_(Method(GrpcWorkerMethod::kLogging)),
         tracing_(Method(GrpcWorkerMethod::kTracing)),
@@ -258,6 +259,15 @@ class GrpcRemoteWorker : public WorkerInterface {
     IssueRequest(request, response, recvtensor_, callback, call_opts);
   }
 
+  void MultiRecvTensorAsync(CallOptions* call_opts,
+                            const MultiRecvTensorRequest* request,
+                            MultiRecvTensorResponse* response,
+                            StatusCallback done) override {
+    VLOG(1) << "MultiRecvTensorAsync req: " << request->DebugString();
+    IssueRequest(request, response, multirecvtensor_, std::move(done),
+                 call_opts);
+  }
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override {
     IssueRequest(request, response, logging_, done);
@@ -326,6 +336,7 @@ class GrpcRemoteWorker : public WorkerInterface {
   const ::grpc::string cleanupgraph_;
   const ::grpc::string cleanupall_;
   const ::grpc::string recvtensor_;
+  const ::grpc::string multirecvtensor_;
   const ::grpc::string recvbuf_;
   const ::grpc::string logging_;
   const ::grpc::string tracing_;
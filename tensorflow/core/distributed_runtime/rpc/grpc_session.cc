@@ -27,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/framework/attr_value.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/platform/mutex.h"
@@ -454,9 +455,12 @@ Status GrpcSession::RunCallable(CallableHandle handle,
   CallOptions call_options;
   call_options.SetTimeout(options_.config.operation_timeout_in_ms());
   TF_RETURN_IF_ERROR(master_->RunCallable(&call_options, &req, &resp));
-  for (const TensorProto& fetch : resp.fetch()) {
+  // The response is owned, so the fetched protos can be consumed: for large
+  // fetches this adopts the payload instead of copying it when possible, and
+  // otherwise releases each proto's payload as soon as it has been copied.
+  for (TensorProto& fetch : *resp.mutable_fetch()) {
     Tensor fetch_tensor;
-    if (!fetch_tensor.FromProto(cpu_allocator(), fetch)) {
+    if (!tensor::MakeTensorFromProto(std::move(fetch), &fetch_tensor).ok()) {
       return errors::Internal(
           "Could not parse fetched tensor data in response from master.");
     }
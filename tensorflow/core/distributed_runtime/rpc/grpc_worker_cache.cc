@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/worker_cache_logger.h"
 #include "tensorflow/core/distributed_runtime/worker_cache_partial.h"
 #include "tensorflow/core/distributed_runtime/worker_interface.h"
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/env_var.h"
@@ -40,7 +41,25 @@ class GrpcWorkerCache : public WorkerCachePartial {
         local_worker_(local_worker),
         channel_cache_(channel_cache),
         worker_env_(worker_env),
-        next_round_robin_assignment_(0) {}
+        next_round_robin_assignment_(0) {
+    // An alternative transport (e.g. RDMA verbs) may be linked in as a plugin
+    // and selected by name; gRPC remains the fallback for targets the
+    // transport cannot reach.
+    string transport_name;
+    Status status = ReadStringFromEnvVar("TF_WORKER_TRANSPORT",
+                                         /*default_val=*/"", &transport_name);
+    if (!status.ok()) {
+      LOG(ERROR) << "Error parsing TF_WORKER_TRANSPORT: " << status;
+    } else if (!transport_name.empty()) {
+      status = WorkerTransport::Build(transport_name, &transport_);
+      if (!status.ok()) {
+        LOG(ERROR) << "Failed to build worker transport \"" << transport_name
+                   << "\", falling back to gRPC: " << status;
+      } else {
+        LOG(INFO) << "Using worker transport \"" << transport_name << "\"";
+      }
+    }
+  }
 
   void ListWorkers(std::vector<string>* workers) const override {
     channel_cache_->ListWorkers(workers);
@@ -55,6 +74,12 @@ class GrpcWorkerCache : public WorkerCachePartial {
     if (target == local_target_) {
       return local_worker_;
     } else {
+      if (transport_ != nullptr) {
+        WorkerInterface* worker = transport_->GetOrCreateWorker(target);
+        if (worker != nullptr) {
+          return worker;
+        }
+      }
       SharedGrpcChannelPtr channel = channel_cache_->FindWorkerChannel(target);
       if (!channel) {
         return nullptr;
@@ -117,6 +142,7 @@ class GrpcWorkerCache : public WorkerCachePartial {
   std::shared_ptr<GrpcChannelCache> channel_cache_;
   WorkerCacheLogger logger_;
   GrpcWorkerEnv* worker_env_;  // Not owned
+  std::unique_ptr<WorkerTransport> transport_;
 
   mutex assignment_mu_;
   std::unordered_map<std::string, size_t> target_assignments_
@@ -48,6 +48,9 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/map_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/lib/strings/stringprintf.h"
+#include "tensorflow/core/lib/random/random.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/tracing.h"
@@ -148,6 +151,7 @@ class GrpcWorkerServiceThread {
     SETUP_FOR_REQUEST(RunGraph, 100, true);
     SETUP_FOR_REQUEST(CleanupGraph, 100, false);
     SETUP_FOR_REQUEST(MarkRecvFinished, 10, false);
+    SETUP_FOR_REQUEST(MultiRecvTensor, 100, true);
 
     // TODO(ncteisen): Determine a better policy for enqueuing the
     // appropriate number of each request type.
@@ -284,6 +288,25 @@ class GrpcWorkerServiceThread {
     EnqueueRecvTensorRequestRaw();
   }
 
+  void MultiRecvTensorHandler(
+      WorkerCall<MultiRecvTensorRequest, MultiRecvTensorResponse>* call) {
+    Schedule([this, call]() {
+      CallOptions* call_opts = new CallOptions;
+      call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
+      worker_->MultiRecvTensorAsync(
+          call_opts, &call->request, &call->response,
+          [call, call_opts](const Status& s) {
+            call->ClearCancelCallback();
+            delete call_opts;
+            if (!s.ok()) {
+              VLOG(3) << "Bad response from MultiRecvTensor:" << s;
+            }
+            call->SendResponse(ToGrpcStatus(s));
+          });
+    });
+    ENQUEUE_REQUEST(MultiRecvTensor, true);
+  }
+
   void RecvBufHandler(WorkerCall<RecvBufRequest, RecvBufResponse>* call) {
     Schedule([this, call]() {
       CallOptions* call_opts = new CallOptions;
@@ -434,6 +457,66 @@ void GrpcWorker::EnableResponseCache() {
   response_cache_ = std::make_unique<RpcResponseCache>();
 }
 
+namespace {
+
+// Minimum tensor content size routed through a shared-memory file when the
+// requester advertises one; smaller tensors fit comfortably in the RPC body.
+constexpr int64_t kShmTransferMinBytes = 64 << 10;
+
+// Returns true, and fills in `option`, if the requester advertised a
+// same-host shared-memory directory and `tensor` qualifies for the
+// shared-memory path. The hostname check keeps the path off unless the
+// requester demonstrably runs on this machine; everything else falls back
+// to the wire format transparently.
+bool ShmTransferRequested(const RecvTensorRequest& request,
+                          const Tensor& tensor, ShmTransferOption* option) {
+  if (!request.has_transport_options() ||
+      !request.transport_options().Is<ShmTransferOption>() ||
+      !request.transport_options().UnpackTo(option)) {
+    return false;
+  }
+  if (option->host() != port::Hostname()) return false;
+  return DataTypeCanUseMemcpy(tensor.dtype()) &&
+         static_cast<int64_t>(tensor.TotalBytes()) >= kShmTransferMinBytes;
+}
+
+// Writes the tensor's content to a uniquely named file in the requester's
+// shared-memory directory and describes it in `record`. The requester
+// removes the file once it has read it, so the inode is reclaimed as soon as
+// both sides are done with it; if the response is lost in transit the file
+// survives until the directory is cleaned up.
+Status WriteShmTensor(const ShmTransferOption& option, const Tensor& tensor,
+                      ShmTransferRecord* record) {
+  string path =
+      strings::StrCat(option.directory(), "/tf_shm_", random::New64());
+  std::unique_ptr<WritableFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewWritableFile(path, &file));
+  Status s = file->Append(tensor.tensor_data());
+  if (s.ok()) s = file->Close();
+  if (!s.ok()) {
+    Env::Default()->DeleteFile(path).IgnoreError();
+    return s;
+  }
+  record->set_path(path);
+  record->set_byte_size(tensor.TotalBytes());
+  return OkStatus();
+}
+
+// Serializes a RecvTensorResponse that carries the tensor's dtype and shape
+// plus a ShmTransferRecord in transport_options, in place of the content.
+bool EncodeShmResponseToByteBuffer(const Tensor& tensor, bool require_ack,
+                                   const ShmTransferRecord& record,
+                                   ::grpc::ByteBuffer* response) {
+  RecvTensorResponse proto;
+  proto.mutable_tensor()->set_dtype(tensor.dtype());
+  tensor.shape().AsProto(proto.mutable_tensor()->mutable_tensor_shape());
+  proto.set_require_ack(require_ack);
+  proto.mutable_transport_options()->PackFrom(record);
+  return tsl::GrpcMaybeUnparseProto(proto, response).ok();
+}
+
+}  // namespace
+
 // GrpcRecvTensorAsync: unlike the other Worker methods, which use protocol
 // buffers for a response object, to avoid extra protocol buffer serialization
 // overhead we generate our response directly into a ::grpc::ByteBuffer object
@@ -447,10 +530,27 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
 
   bool cache_enabled = (response_cache_ != nullptr && request_id != 0);
 
-  auto do_response = [response, done, cache_enabled](const Tensor& tensor,
-                                                     bool is_dead,
-                                                     const Status& status) {
+  auto do_response = [response, done, cache_enabled, request](
+                         const Tensor& tensor, bool is_dead,
+                         const Status& status) {
     if (status.ok()) {
+      ShmTransferOption shm_option;
+      if (!is_dead && ShmTransferRequested(*request, tensor, &shm_option)) {
+        ShmTransferRecord record;
+        Status shm_status = WriteShmTensor(shm_option, tensor, &record);
+        if (shm_status.ok()) {
+          if (EncodeShmResponseToByteBuffer(tensor, cache_enabled, record,
+                                            response)) {
+            done(status);
+            return;
+          }
+          Env::Default()->DeleteFile(record.path()).IgnoreError();
+        } else {
+          LOG_EVERY_N_SEC(WARNING, 60)
+              << "Shared-memory tensor transfer to '" << shm_option.directory()
+              << "' failed, falling back to the wire: " << shm_status;
+        }
+      }
       grpc::EncodeTensorToByteBuffer(is_dead, tensor, cache_enabled, response);
     }
     done(status);
@@ -554,6 +654,140 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
       });
 }
 
+namespace {
+// Tracks completion of the per-key receives of a MultiRecvTensor request, and
+// invokes `done` with the first error (or OK) once all of them have finished.
+struct MultiRecvTensorCallState {
+  MultiRecvTensorCallState(int num_pending, StatusCallback done)
+      : pending(num_pending), done(std::move(done)) {}
+
+  void ItemDone(const Status& s) {
+    Status aggregate_status;
+    {
+      mutex_lock l(mu);
+      status.Update(s);
+      if (--pending > 0) return;
+      aggregate_status = status;
+    }
+    StatusCallback captured_done = std::move(done);
+    delete this;
+    captured_done(aggregate_status);
+  }
+
+  mutex mu;
+  int pending TF_GUARDED_BY(mu);
+  Status status TF_GUARDED_BY(mu);
+  StatusCallback done;
+};
+}  // namespace
+
+// MultiRecvTensorAsync: receives one tensor per rendezvous key in the request
+// and packs them into a single response, amortizing the per-RPC overhead of
+// issuing an individual RecvTensor for every key. Unlike GrpcRecvTensorAsync,
+// the tensors are returned as protos, since the zero-copy ByteBuffer encoding
+// supports only a single tensor payload; this method targets batches of small
+// tensors, where the RPC overhead rather than the payload encoding dominates.
+void GrpcWorker::MultiRecvTensorAsync(CallOptions* opts,
+                                      const MultiRecvTensorRequest* request,
+                                      MultiRecvTensorResponse* response,
+                                      StatusCallback done) {
+  VLOG(3) << "MultiRecvTensorAsync req: " << request->DebugString();
+  const int64_t step_id = request->step_id();
+
+  Status s = recent_request_ids_.TrackUnique(
+      request->request_id(), "MultiRecvTensor (GrpcWorker)", *request);
+  if (!s.ok()) {
+    done(s);
+    return;
+  }
+  const int num_tensors = request->rendezvous_key_size();
+  if (num_tensors == 0) {
+    done(OkStatus());
+    return;
+  }
+
+  // Pre-size the response so that each pending receive fills in its own entry
+  // without resizing the repeated field concurrently.
+  response->mutable_tensor()->Reserve(num_tensors);
+  for (int i = 0; i < num_tensors; ++i) {
+    response->add_tensor();
+  }
+
+  opts->SetCancelCallback([this, step_id]() {
+    LOG(WARNING) << "MultiRecvTensor cancelled for " << step_id;
+    AbortStep(step_id);
+  });
+  auto* state = new MultiRecvTensorCallState(
+      num_tensors, [opts, done = std::move(done)](const Status& s) {
+        opts->ClearCancelCallback();
+        done(s);
+      });
+
+  for (int i = 0; i < num_tensors; ++i) {
+    const string& key = request->rendezvous_key(i);
+    TRACEPRINTF("MultiRecvTensor: %lld %s", step_id, key.c_str());
+    RecvTensorResponse* item = response->mutable_tensor(i);
+    Rendezvous::ParsedKey parsed;
+    Status s = Rendezvous::ParseKey(key, &parsed);
+    Device* src_dev = nullptr;
+    if (s.ok()) {
+      s = PrepareRecvTensor(parsed, &src_dev);
+    }
+    if (!s.ok()) {
+      state->ItemDone(s);
+      continue;
+    }
+
+    auto item_done = [this, item, state](const Tensor& tensor, bool is_dead,
+                                         const Status& status) {
+      if (status.ok()) {
+        tensor.AsProtoTensorContent(item->mutable_tensor());
+        item->set_is_dead(is_dead);
+        item->set_send_start_micros(env_->env->NowMicros());
+      }
+      state->ItemDone(status);
+    };
+
+    env_->rendezvous_mgr->RecvLocalAsync(
+        step_id, parsed,
+        [item_done, src_dev](const Status& status,
+                             const Rendezvous::Args& send_args,
+                             const Rendezvous::Args& recv_args,
+                             const Tensor& val, const bool is_dead) {
+          if (!status.ok()) {
+            return item_done(val, is_dead, status);
+          }
+
+          const bool on_host = send_args.alloc_attrs.on_host();
+          if (!src_dev->tensorflow_accelerator_device_info() || on_host) {
+            return item_done(val, is_dead, status);
+          }
+
+          // The tensor lives on an accelerator: copy it to host memory before
+          // encoding it into the response.
+          DeviceContext* send_dev_context = send_args.device_context;
+          AllocatorAttributes alloc_attrs;
+          alloc_attrs.set_gpu_compatible(true);
+          alloc_attrs.set_on_host(true);
+          Allocator* alloc = src_dev->GetAllocator(alloc_attrs);
+          Tensor* copy = new Tensor(alloc, val.dtype(), val.shape());
+          CHECK(send_dev_context)
+              << "send dev name: " << src_dev->name() << " gpu_info: "
+              << src_dev->tensorflow_accelerator_device_info();
+
+          StatusCallback copy_ready = [item_done, copy,
+                                       is_dead](const Status& s) {
+            // The value is now ready to be returned on the wire.
+            item_done(*copy, is_dead, s);
+            delete copy;
+          };
+
+          CopyDeviceToHost(&val, alloc, alloc, "MultiRecvTensor", src_dev,
+                           copy, send_dev_context, copy_ready);
+        });
+  }
+}
+
 namespace {
 // If RecvBufRespExtra.tensor_content is a single large string, then gRPC
 // can stall on the recv side when the string buffer needs to be enlarged,
@@ -51,6 +51,13 @@ class GrpcWorker : public Worker {
                                    ::grpc::ByteBuffer* response,
                                    StatusCallback done);
 
+  // Receives all tensors named by `request->rendezvous_key()` in one RPC,
+  // amortizing per-RPC overhead across the batch.
+  void MultiRecvTensorAsync(CallOptions* opts,
+                            const MultiRecvTensorRequest* request,
+                            MultiRecvTensorResponse* response,
+                            StatusCallback done) override;
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override;
 
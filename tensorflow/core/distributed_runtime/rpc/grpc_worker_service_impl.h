@@ -86,10 +86,11 @@ enum class GrpcWorkerMethod {
   kCompleteInstance,
   kGetStepSequence,
   kMarkRecvFinished,
+  kMultiRecvTensor,
 };
 
 static const int kGrpcNumWorkerMethods =
-    static_cast<int>(GrpcWorkerMethod::kMarkRecvFinished) + 1;
+    static_cast<int>(GrpcWorkerMethod::kMultiRecvTensor) + 1;
 
 const char* GrpcWorkerMethodName(GrpcWorkerMethod id);
 
@@ -27,15 +27,35 @@ limitations under the License.
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/protobuf/transport_options.pb.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
 namespace {
 
+// Directory on a shared-memory filesystem (e.g. /dev/shm) that same-host
+// workers may use to hand over large tensors out-of-band instead of
+// serializing them into the RecvTensor response. Empty (the default) disables
+// the shared-memory path.
+const string& ShmTransferDirectory() {
+  static const string* const dir = []() {
+    string* result = new string;
+    Status s = ReadStringFromEnvVar("TF_GRPC_SHM_DIR", "", result);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_GRPC_SHM_DIR: " << s;
+    }
+    return result;
+  }();
+  return *dir;
+}
+
 class RpcRemoteRendezvous : public BaseRemoteRendezvous {
  public:
   RpcRemoteRendezvous(const WorkerEnv* env, int64_t step_id)
@@ -69,6 +89,18 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
     req_.set_step_id(step_id);
     req_.set_rendezvous_key(key.data(), key.size());
     req_.set_request_id(GetUniqueRequestId());
+    // Advertise the shared-memory handover directory when the tensor will
+    // land in host memory; the responder falls back to the wire if it is not
+    // actually on the same host or the tensor does not qualify.
+    const string& shm_dir = ShmTransferDirectory();
+    if (!shm_dir.empty() &&
+        (dst_device->tensorflow_accelerator_device_info() == nullptr ||
+         alloc_attrs.on_host())) {
+      ShmTransferOption option;
+      option.set_directory(shm_dir);
+      option.set_host(port::Hostname());
+      req_.mutable_transport_options()->PackFrom(option);
+    }
   }
 
   void Reset() {
@@ -133,6 +165,43 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
  private:
   friend class RpcRemoteRendezvous;
 
+  // If the responder wrote the tensor's content to a shared-memory file
+  // instead of serializing it, read the file into the (already allocated)
+  // response tensor and remove the file. No-op for ordinary responses.
+  Status MaybeReadShmTensor() {
+    if (!resp_.metadata().has_transport_options() ||
+        !resp_.metadata().transport_options().Is<ShmTransferRecord>()) {
+      return OkStatus();
+    }
+    ShmTransferRecord record;
+    if (!resp_.metadata().transport_options().UnpackTo(&record)) {
+      return errors::Internal("Malformed ShmTransferRecord in RecvTensor ",
+                              "response.");
+    }
+    const Tensor& tensor = resp_.tensor();
+    if (static_cast<int64_t>(tensor.tensor_data().size()) !=
+        record.byte_size()) {
+      return errors::Internal(
+          "Shared-memory tensor file ", record.path(), " records ",
+          record.byte_size(), " bytes but the response tensor holds ",
+          tensor.tensor_data().size(), " bytes.");
+    }
+    std::unique_ptr<RandomAccessFile> file;
+    TF_RETURN_IF_ERROR(
+        Env::Default()->NewRandomAccessFile(record.path(), &file));
+    char* data = const_cast<char*>(tensor.tensor_data().data());
+    StringPiece piece;
+    Status s = file->Read(0, record.byte_size(), &piece, data);
+    if (s.ok() && piece.data() != data) {
+      memcpy(data, piece.data(), piece.size());
+    }
+    file.reset();
+    // The file was created solely for this transfer; unlinking it releases
+    // the shared-memory pages once both sides have closed it.
+    Env::Default()->DeleteFile(record.path()).IgnoreError();
+    return s;
+  }
+
   // Start the main RecvTensor call, checking for an async abort.
   void StartRTCall(std::function<void()> recv_done) {
     resp_.InitAlloc(dst_device_, alloc_attrs_);
@@ -142,9 +211,13 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
       // Make sure the Rendezvous abort checking is finished before running the
       // callback, which might destroy the current call object.
       abort_checked->WaitForNotification();
-      if (!s.ok()) {
+      Status status = s;
+      if (status.ok()) {
+        status = MaybeReadShmTensor();
+      }
+      if (!status.ok()) {
         mutex_lock l(mu_);
-        status_.Update(s);
+        status_.Update(status);
       }
       recv_done();
     };
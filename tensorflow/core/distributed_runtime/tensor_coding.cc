@@ -30,6 +30,7 @@ void TensorResponse::Clear() {
   device_ = nullptr;
   alloc_attrs_ = AllocatorAttributes();
   allocator_ = nullptr;
+  host_allocator_ = nullptr;
   already_used_ = false;
   ClearTensor();
 }
@@ -48,6 +49,18 @@ void TensorResponse::InitAlloc(DeviceBase* d, const AllocatorAttributes& aa) {
     on_host_ = true;
   }
   allocator_ = device_->GetAllocator(alloc_attrs_);
+  if (!on_host_ && da.device_type() == "GPU" &&
+      device_->tensorflow_accelerator_device_info() != nullptr &&
+      device_->tensorflow_accelerator_device_info()->default_context !=
+          nullptr) {
+    // The fast parsing path can decode tensor contents directly into pinned
+    // host memory and copy them onto the device from there, avoiding the
+    // intermediate TensorProto that the general path materializes.
+    AllocatorAttributes host_alloc_attrs;
+    host_alloc_attrs.set_gpu_compatible(true);
+    host_alloc_attrs.set_on_host(true);
+    host_allocator_ = device_->GetAllocator(host_alloc_attrs);
+  }
 }
 
 Status TensorResponse::InitFrom(RecvTensorResponse* response) {
@@ -80,7 +93,20 @@ void TensorResponse::InitPartial(const RecvTensorResponse& response,
 }
 
 Status TensorResponse::ParseFrom(Source* source) {
+  if (already_used_) {
+    ClearTensor();
+  }
+  already_used_ = true;
   if (!on_host_) {
+    // Fast path for devices: scatter the tensor contents from the wire
+    // directly into a pre-allocated staging tensor in pinned host memory,
+    // then issue a single copy onto the device. Tensors that the fast path
+    // cannot handle (e.g. non-memcpyable dtypes) fall through to the
+    // general proto parse below.
+    if (host_allocator_ != nullptr && ParseFast(source, host_allocator_)) {
+      return CopyStagedTensorToDevice();
+    }
+    ClearTensor();
     protobuf::io::CodedInputStream input(source->contents());
 
     // Pre-parse into local storage, then delegate to device.
@@ -97,16 +123,31 @@ Status TensorResponse::ParseFrom(Source* source) {
     meta_.clear_tensor();
     return s;
   }
-  if (already_used_) {
-    ClearTensor();
-  }
-  already_used_ = true;
-  if (ParseFast(source)) return OkStatus();
+  if (ParseFast(source, allocator_)) return OkStatus();
   meta_.Clear();
   if (ParseSlow(source)) return OkStatus();
   return errors::InvalidArgument("Cannot parse tensor from response");
 }
 
+Status TensorResponse::CopyStagedTensorToDevice() {
+  Tensor staged = std::move(tensor_);
+  Tensor on_device(allocator_, staged.dtype(), staged.shape());
+  if (staged.NumElements() > 0) {
+    // If the tensor is not initialized, we likely ran out of memory.
+    if (!on_device.IsInitialized()) {
+      return errors::ResourceExhausted(
+          "Out of memory while trying to allocate ",
+          staged.shape().DebugString(), " on ", device_->name());
+    }
+    DeviceContext* device_context =
+        device_->tensorflow_accelerator_device_info()->default_context;
+    TF_RETURN_IF_ERROR(device_context->CopyCPUTensorToDeviceSync(
+        &staged, static_cast<Device*>(device_), &on_device));
+  }
+  tensor_ = std::move(on_device);
+  return OkStatus();
+}
+
 // Define some helper routines for decoding protocol buffer wire format data
 namespace {
 // We only need some of the wiretype values for this code
@@ -144,7 +185,8 @@ bool ReadNestedMessage(protobuf::io::CodedInputStream* input,
 }  // namespace
 
 bool TensorResponse::ParseTensorSubmessage(
-    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta) {
+    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta,
+    Allocator* allocator) {
   bool seen_tensor_content = false;
   while (true) {
     auto p = input->ReadTagWithCutoff(127);
@@ -155,7 +197,7 @@ bool TensorResponse::ParseTensorSubmessage(
       if (ok && !seen_tensor_content) {
         // No tensor content: could be because it's a zero-length tensor
         TensorShape shape(tensor_meta->tensor_shape());
-        Tensor t(allocator_, tensor_meta->dtype(), shape);
+        Tensor t(allocator, tensor_meta->dtype(), shape);
         tensor_ = std::move(t);
       }
       return ok;
@@ -195,7 +237,7 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
-        Tensor t(allocator_, tensor_meta->dtype(), shape);
+        Tensor t(allocator, tensor_meta->dtype(), shape);
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
         // TODO(jeff,sanjay): Figure out a way to avoid this copy if
@@ -215,7 +257,7 @@ bool TensorResponse::ParseTensorSubmessage(
   }
 }
 
-bool TensorResponse::ParseFast(Source* source) {
+bool TensorResponse::ParseFast(Source* source, Allocator* allocator) {
   protobuf::io::CodedInputStream input(source->contents());
   while (true) {
     auto p = input.ReadTagWithCutoff(127);
@@ -233,7 +275,7 @@ bool TensorResponse::ParseFast(Source* source) {
         std::pair<protobuf::io::CodedInputStream::Limit, int> p =
             input.IncrementRecursionDepthAndPushLimit(length);
         if (p.second < 0 ||
-            !ParseTensorSubmessage(&input, meta_.mutable_tensor())) {
+            !ParseTensorSubmessage(&input, meta_.mutable_tensor(), allocator)) {
           return false;
         }
         if (!input.DecrementRecursionDepthAndPopLimit(p.first)) {
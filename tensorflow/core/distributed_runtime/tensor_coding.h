@@ -92,14 +92,20 @@ class TensorResponse {
 
  private:
   bool ParseTensorSubmessage(protobuf::io::CodedInputStream* input,
-                             TensorProto* tensor_meta);
-  bool ParseFast(Source* source);
+                             TensorProto* tensor_meta, Allocator* allocator);
+  bool ParseFast(Source* source, Allocator* allocator);
   bool ParseSlow(Source* source);
+  // Moves tensor_, which holds a host-staged copy of the tensor contents,
+  // into a tensor freshly allocated from allocator_ on device_.
+  Status CopyStagedTensorToDevice();
 
   bool on_host_ = false;
   DeviceBase* device_ = nullptr;
   AllocatorAttributes alloc_attrs_;
   Allocator* allocator_ = nullptr;
+  // Non-null iff tensors for device_ can be staged in (pinned) host memory
+  // by the fast parsing path and then copied onto the device.
+  Allocator* host_allocator_ = nullptr;
   bool already_used_ = false;
   Tensor tensor_;
   RecvTensorResponse meta_;
@@ -15,10 +15,14 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include <cstring>
+
+#include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
 #include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
@@ -156,6 +160,77 @@ TEST_F(TensorResponseTest, Simple) {
 
 TEST_F(TensorResponseTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+// A DeviceContext whose "device" memory is plain host memory, so that the
+// host-staging receive path can be exercised without a real accelerator.
+class HostMemoryDeviceContext : public DeviceContext {
+ public:
+  void CopyCPUTensorToDevice(const Tensor* cpu_tensor, Device* device,
+                             Tensor* device_tensor, StatusCallback done,
+                             bool sync_dst_compute) const override {
+    CHECK_EQ(cpu_tensor->TotalBytes(), device_tensor->TotalBytes());
+    std::memcpy(const_cast<char*>(device_tensor->tensor_data().data()),
+                cpu_tensor->tensor_data().data(), cpu_tensor->TotalBytes());
+    done(OkStatus());
+  }
+};
+
+class FakeGpuDevice : public Device {
+ public:
+  FakeGpuDevice(Env* env, DeviceContext* ctx) : Device(env, Attrs()) {
+    accelerator_device_info_.default_context = ctx;
+    set_tensorflow_accelerator_device_info(&accelerator_device_info_);
+  }
+
+  Status Sync() override { return OkStatus(); }
+
+  Allocator* GetAllocator(AllocatorAttributes attr) override {
+    return cpu_allocator();
+  }
+
+ private:
+  static DeviceAttributes Attrs() {
+    DeviceAttributes attr;
+    attr.set_name("/job:localhost/replica:0/task:0/device:GPU:0");
+    attr.set_device_type("GPU");
+    return attr;
+  }
+
+  AcceleratorDeviceInfo accelerator_device_info_;
+};
+
+TEST_F(TensorResponseTest, StagesTensorsForAcceleratorDevices) {
+  Tensor src(DT_FLOAT, TensorShape({2, 3}));
+  test::FillValues<float>(&src, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+
+  RecvTensorResponse proto;
+  proto.set_is_dead(false);
+  proto.set_send_start_micros(123456);
+  src.AsProtoTensorContent(proto.mutable_tensor());
+  string encoded;
+  proto.AppendToString(&encoded);
+
+  StringSource source(&encoded, 1024);
+
+  HostMemoryDeviceContext* ctx = new HostMemoryDeviceContext;
+  core::ScopedUnref unref_ctx(ctx);
+  FakeGpuDevice gpu_device(Env::Default(), ctx);
+  TensorResponse response;
+  response.InitAlloc(&gpu_device, AllocatorAttributes());
+  for (int i = 0; i < 2; i++) {  // Twice so we exercise reuse of "response"
+    Status s = response.ParseFrom(&source);
+    EXPECT_TRUE(s.ok());
+
+    const RecvTensorResponse& meta = response.metadata();
+    EXPECT_EQ(meta.is_dead(), false);
+    EXPECT_EQ(meta.send_start_micros(), 123456);
+
+    const Tensor& result = response.tensor();
+    EXPECT_EQ(result.dtype(), src.dtype());
+    EXPECT_EQ(result.shape().DebugString(), src.shape().DebugString());
+    EXPECT_EQ(result.DebugString(), src.DebugString());
+  }
+}
+
 string MakeFloatTensorTestCase(int num_elems) {
   std::vector<int8> v(num_elems);
   for (int i = 0; i < num_elems; i++) {
@@ -47,6 +47,17 @@ void Worker::GetStatusAsync(CallOptions* opts, const GetStatusRequest* request,
                             GetStatusResponse* response, bool fail_fast,
                             StatusCallback done) {
   const DeviceMgr* dm = env_->device_mgr;
+  // Read the version before enumerating so that a concurrent device set
+  // change at worst makes the next poll refetch, never lets a client cache a
+  // stale device list under a current version.
+  const int64_t device_set_version = dm->DeviceSetVersion();
+  response->set_device_set_version(device_set_version);
+  if (request->known_device_set_version() != 0 &&
+      request->known_device_set_version() == device_set_version) {
+    // The caller already has an up-to-date device list.
+    done(OkStatus());
+    return;
+  }
   std::vector<DeviceAttributes> devices;
   dm->ListDeviceAttributes(&devices);
   response->mutable_device_attributes()->Reserve(devices.size());
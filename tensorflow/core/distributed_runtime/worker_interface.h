@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/call_options.h"
 #include "tensorflow/core/distributed_runtime/message_wrappers.h"
+#include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/types.h"
@@ -106,6 +107,17 @@ class WorkerInterface {
                                TensorResponse* response,
                                StatusCallback done) = 0;
 
+  // Receives multiple tensors in a single RPC, amortizing per-RPC overhead
+  // when many small tensors are fetched from the same worker. Not all worker
+  // implementations support this method.
+  virtual void MultiRecvTensorAsync(CallOptions* opts,
+                                    const MultiRecvTensorRequest* request,
+                                    MultiRecvTensorResponse* response,
+                                    StatusCallback done) {
+    done(errors::Unimplemented(
+        "MultiRecvTensorAsync is not supported by this worker."));
+  }
+
   virtual void LoggingAsync(const LoggingRequest* request,
                             LoggingResponse* response, StatusCallback done) = 0;
 
@@ -0,0 +1,76 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/strings/str_join.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/mutex.h"
+
+namespace tensorflow {
+
+namespace {
+mutex* get_lock() {
+  static mutex lock(LINKER_INITIALIZED);
+  return &lock;
+}
+
+using WorkerTransportFactories =
+    std::unordered_map<std::string, WorkerTransport::FactoryT>;
+WorkerTransportFactories& transport_factories() {
+  static auto& factories = *new WorkerTransportFactories();
+  return factories;
+}
+}  // namespace
+
+void WorkerTransport::Register(const std::string& name, FactoryT factory) {
+  mutex_lock l(*get_lock());
+  if (!transport_factories().insert({name, factory}).second) {
+    LOG(ERROR) << "Two worker transport factories are being registered with "
+                  "name "
+               << name << ". Which one gets used is undefined.";
+  }
+}
+
+Status WorkerTransport::Build(const std::string& name,
+                              std::unique_ptr<WorkerTransport>* out) {
+  mutex_lock l(*get_lock());
+  auto it = transport_factories().find(name);
+  if (it != transport_factories().end()) {
+    return it->second(out);
+  }
+
+  std::vector<std::string> available_names;
+  for (const auto& factory : transport_factories()) {
+    available_names.push_back(factory.first);
+  }
+
+  return errors::NotFound(
+      "No worker transport factory has been registered for name ", name,
+      ". The available names are: [ ", absl::StrJoin(available_names, ", "),
+      " ]");
+}
+
+bool WorkerTransport::IsRegistered(const std::string& name) {
+  mutex_lock l(*get_lock());
+  return transport_factories().find(name) != transport_factories().end();
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,59 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
+#define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/distributed_runtime/worker_interface.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+
+// A WorkerTransport creates WorkerInterface clients that reach remote tasks
+// over an alternative fabric (e.g. RDMA verbs) instead of the default gRPC
+// channel. Transports are linked in as plugins and register a factory under a
+// name; a worker cache activates one transport by name and falls back to its
+// default channel for targets the transport cannot reach.
+class WorkerTransport {
+ public:
+  using FactoryT = std::function<Status(std::unique_ptr<WorkerTransport>*)>;
+
+  virtual ~WorkerTransport() = default;
+
+  // Returns a WorkerInterface connected to `target` over this transport, or
+  // nullptr if this transport cannot reach `target` (in which case the worker
+  // cache uses its default channel). The returned worker must be destroyed by
+  // calling WorkerCacheInterface::ReleaseWorker(target, worker) on the cache
+  // that handed it out.
+  virtual WorkerInterface* GetOrCreateWorker(const std::string& target) = 0;
+
+  // Registers a WorkerTransport factory under `name`.
+  static void Register(const std::string& name, FactoryT factory);
+
+  // Builds the WorkerTransport from the factory registered under `name`.
+  static Status Build(const std::string& name,
+                      std::unique_ptr<WorkerTransport>* out);
+
+  // Returns true if a transport factory has been registered under `name`.
+  static bool IsRegistered(const std::string& name);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_TRANSPORT_H_
@@ -0,0 +1,59 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/distributed_runtime/worker_transport.h"
+
+#include <memory>
+#include <string>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+class TestWorkerTransport : public WorkerTransport {
+ public:
+  WorkerInterface* GetOrCreateWorker(const std::string& target) override {
+    return nullptr;
+  }
+};
+
+TEST(WorkerTransportTest, BuildRegisteredTransport) {
+  WorkerTransport::Register(
+      "test_transport", [](std::unique_ptr<WorkerTransport>* out) {
+        *out = std::make_unique<TestWorkerTransport>();
+        return OkStatus();
+      });
+  EXPECT_TRUE(WorkerTransport::IsRegistered("test_transport"));
+
+  std::unique_ptr<WorkerTransport> transport;
+  TF_ASSERT_OK(WorkerTransport::Build("test_transport", &transport));
+  ASSERT_NE(transport, nullptr);
+  EXPECT_EQ(transport->GetOrCreateWorker("/job:worker/replica:0/task:1"),
+            nullptr);
+}
+
+TEST(WorkerTransportTest, BuildUnregisteredTransportFails) {
+  EXPECT_FALSE(WorkerTransport::IsRegistered("unregistered_transport"));
+
+  std::unique_ptr<WorkerTransport> transport;
+  Status s = WorkerTransport::Build("unregistered_transport", &transport);
+  EXPECT_TRUE(errors::IsNotFound(s));
+}
+
+}  // namespace
+}  // namespace tensorflow
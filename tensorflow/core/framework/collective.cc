@@ -88,6 +88,8 @@ CollInstanceParams& CollInstanceParams::operator=(
         other.impl_details.subdiv_source_rank.begin(),
         other.impl_details.subdiv_source_rank.end());
     impl_details.dependencies = other.impl_details.dependencies;
+    buf_rendezvous_slot_base = other.buf_rendezvous_slot_base;
+    num_buf_rendezvous_slots = other.num_buf_rendezvous_slots;
     devices.assign(other.devices.begin(), other.devices.end());
     permutation.assign(other.permutation.begin(), other.permutation.end());
   }
@@ -120,6 +122,11 @@ string CollInstanceParams::ToString() const {
     }
     strings::StrAppend(&v, "}");
   }  // all subdivs
+  if (buf_rendezvous_slot_base >= 0) {
+    strings::StrAppend(&v, ", buf_rendezvous_slots=[", buf_rendezvous_slot_base,
+                       ",", buf_rendezvous_slot_base + num_buf_rendezvous_slots,
+                       ")");
+  }
   if (type == PERMUTE_COLLECTIVE) {
     strings::StrAppend(&v, "}, permute_devices {");
     for (const auto& d : devices) {
@@ -129,6 +129,14 @@ struct CollInstanceParams {
   DataType data_type = DT_FLOAT;
   TensorShape shape = {0};
   CollImplDetails impl_details;
+  // A contiguous range of BufRendezvous slot ids reserved for this instance
+  // by the param resolver, stable across steps for a given instance_key.
+  // Collective implementations that map each (pass, section, rank) hop of a
+  // step onto a dense index below num_buf_rendezvous_slots may use the
+  // slot-keyed BufRendezvous calls instead of composing string keys.  A base
+  // of -1 means no range was reserved and string keys must be used.
+  int64_t buf_rendezvous_slot_base = -1;
+  int64_t num_buf_rendezvous_slots = 0;
   string ToString() const;
   CollInstanceParams& operator=(const struct CollInstanceParams& other);
   std::vector<string> devices;  // permuter only
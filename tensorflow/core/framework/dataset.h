@@ -605,6 +605,14 @@ class SerializationContext {
     // symbolically, using cursors into source iterators, or explicitly, by
     // storing internal state of each iterator.
     bool symbolic_checkpoint = false;
+
+    // Indicates that the save is incremental: iterators that support it may
+    // write only the state that changed since their previous save, instead of
+    // their full state. The resulting checkpoint is a delta and is only valid
+    // when restored on top of the checkpoint it was taken against, by
+    // concatenating the serialized state of both. Iterators that do not
+    // support incremental saves write their full state, which is always safe.
+    bool save_delta = false;
   };
 
   explicit SerializationContext(Params params) : params_(params) {}
@@ -625,6 +633,8 @@ class SerializationContext {
 
   bool symbolic_checkpoint() const { return params_.symbolic_checkpoint; }
 
+  bool save_delta() const { return params_.save_delta; }
+
  private:
   Params params_;
 
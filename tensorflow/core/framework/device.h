@@ -31,6 +31,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/control_flow.h"
@@ -156,6 +157,20 @@ class Device : public DeviceBase {
     return OkStatus();
   }
 
+  // Fills `device_contexts` with one entry per node id of `graph`, giving the
+  // DeviceContext the node's kernel should run with, or leaves it empty if
+  // every node should use the context from `TryGetDeviceContext`. Devices that
+  // execute on multiple streams override this to spread independent parts of
+  // the graph over their streams.
+  //
+  // Unlike `TryGetDeviceContext`, the filled-in contexts are owned by the
+  // device and stay valid for its lifetime; the caller must not Unref() them.
+  virtual Status FillContextMap(const Graph* graph,
+                                std::vector<DeviceContext*>* device_contexts) {
+    device_contexts->clear();
+    return OkStatus();
+  }
+
   // Returns the op segment of this device.  The caller can reuse op
   // kernels registered for the same session running on this device.
   OpSegment* op_segment() { return &op_seg_; }
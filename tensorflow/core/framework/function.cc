@@ -1072,7 +1072,7 @@ string Canonicalize(const string& funcname, AttrSlice attrs,
                     const FunctionLibraryRuntime::InstantiateOptions& options) {
   absl::InlinedVector<AttrKeyAndValue, 8> entries;
   entries.reserve(attrs.size() + static_cast<int>(!options.target.empty()) +
-                  options.input_devices.size());
+                  options.input_devices.size() + options.input_shapes.size());
   for (const auto& p : attrs) {
     if (p.first != kExecutorAttr) {
       entries.push_back(AttrKeyAndValue(
@@ -1092,6 +1092,11 @@ string Canonicalize(const string& funcname, AttrSlice attrs,
                                       options.output_devices[i],
                                       AttrKeyAndValue::kCEscape));
   }
+  for (int i = 0; i < options.input_shapes.size(); ++i) {
+    entries.push_back(AttrKeyAndValue("_input_shape", i,
+                                      options.input_shapes[i].DebugString(),
+                                      AttrKeyAndValue::kCEscape));
+  }
   for (const auto& iter : options.input_resource_dtypes_and_shapes) {
     entries.push_back(AttrKeyAndValue("_input_resource_dtype", iter.first,
                                       DataTypeString(iter.second.dtype)));
@@ -1267,15 +1272,45 @@ const OpRegistrationData& FunctionRecord::op_registration_data() const {
 
 const bool FunctionRecord::finalized() const { return finalized_; }
 
+// static
+std::shared_ptr<FunctionLibraryDefinition::FunctionRecordMap>
+FunctionLibraryDefinition::MakeRecordMap(size_t num_reserved) {
+  return std::shared_ptr<FunctionRecordMap>(
+      new FunctionRecordMap(num_reserved), DestroyRecordMap);
+}
+
+// static
+void FunctionLibraryDefinition::DestroyRecordMap(FunctionRecordMap* records) {
+  // Drop Ref Count for each FunctionRecord.
+  for (const auto& [function_name, record] : *records) {
+    DCHECK(record->finalized());
+    record->Unref();
+  }
+  delete records;
+}
+
+FunctionLibraryDefinition::FunctionRecordMap*
+FunctionLibraryDefinition::mutable_records() {
+  if (records_.use_count() > 1) {
+    // The map is shared with another library; clone it so that the mutation
+    // is not observed there. Each record gains a reference from the clone.
+    std::shared_ptr<FunctionRecordMap> cloned = MakeRecordMap(records_->size());
+    for (const auto& [function_name, record] : *records_) {
+      record->Ref();
+      cloned->insert({function_name, record});
+    }
+    records_ = std::move(cloned);
+  }
+  return records_.get();
+}
+
 FunctionLibraryDefinition::FunctionLibraryDefinition(
     const FunctionLibraryDefinition& other)
     : default_registry_(other.default_registry_) {
   tf_shared_lock l(other.mu_);
+  // Share the record map with `other`; it is cloned lazily if either library
+  // is subsequently mutated.
   records_ = other.records_;
-  // Increment the Refs.
-  for (const auto& key_value_pair : records_) {
-    key_value_pair.second->Ref();
-  }
   func_grad_ = other.func_grad_;
   optimized_function_graph_map_ = other.optimized_function_graph_map_;
 }
@@ -1284,26 +1319,21 @@ FunctionLibraryDefinition::FunctionLibraryDefinition(
     const OpRegistryInterface* default_registry,
     const FunctionDefLibrary& lib_def,
     const FunctionDefLibraryStackTraces& library_traces)
-    : default_registry_(default_registry), records_(lib_def.function_size()) {
+    : default_registry_(default_registry),
+      records_(MakeRecordMap(lib_def.function_size())) {
   Initialize(lib_def, library_traces);
 }
 
 FunctionLibraryDefinition::FunctionLibraryDefinition(
     const OpRegistryInterface* default_registry, const GraphDef& graph_def)
-    : default_registry_(default_registry) {
+    : default_registry_(default_registry), records_(MakeRecordMap(0)) {
   const FunctionDefLibrary& library = graph_def.library();
   FunctionDefLibraryStackTraces library_traces =
       CreateStackTracesForFunctionDefLibrary(library, graph_def.debug_info());
   Initialize(library, library_traces);
 }
 
-FunctionLibraryDefinition::~FunctionLibraryDefinition() {
-  // Drop Ref Count for each FunctionRecord.
-  for (const auto& [function_name, record] : records_) {
-    DCHECK(record->finalized());
-    record->Unref();
-  }
-}
+FunctionLibraryDefinition::~FunctionLibraryDefinition() = default;
 
 FunctionLibraryDefinition& FunctionLibraryDefinition::operator=(
     FunctionLibraryDefinition&& other) {
@@ -1311,6 +1341,7 @@ FunctionLibraryDefinition& FunctionLibraryDefinition::operator=(
   mutex_lock this_l(mu_);
   default_registry_ = std::move(other.default_registry_);
   records_ = std::move(other.records_);
+  other.records_ = MakeRecordMap(0);
   func_grad_ = std::move(other.func_grad_);
   optimized_function_graph_map_ =
       std::move(other.optimized_function_graph_map_);
@@ -1345,13 +1376,13 @@ void FunctionLibraryDefinition::Initialize(
   tf_shared_lock lock(mu_);
   for (const auto& fdef : library.function()) {
     // The latter function definition wins.
-    auto iter = records_.find(fdef.signature().name());
-    if (iter != records_.end()) {
+    auto iter = records_->find(fdef.signature().name());
+    if (iter != records_->end()) {
       iter->second->Unref();
-      records_.erase(iter);
+      records_->erase(iter);
     }
     const auto& it = library_traces.find(fdef.signature().name());
-    records_.insert(
+    records_->insert(
         {fdef.signature().name(),
          new FunctionRecord(
              fdef, it != library_traces.end() ? it->second : StackTracesMap(),
@@ -1364,7 +1395,7 @@ void FunctionLibraryDefinition::Initialize(
 
 bool FunctionLibraryDefinition::Contains(const string& func) const {
   tf_shared_lock l(mu_);
-  return records_.find(func) != records_.end();
+  return records_->find(func) != records_->end();
 }
 
 const FunctionDef* FunctionLibraryDefinition::Find(const string& func) const {
@@ -1385,8 +1416,8 @@ core::RefCountPtr<FunctionRecord> FunctionLibraryDefinition::FindRecord(
 
 core::RefCountPtr<FunctionRecord> FunctionLibraryDefinition::FindHelper(
     const string& func) const {
-  auto iter = records_.find(func);
-  if (iter == records_.end()) {
+  auto iter = records_->find(func);
+  if (iter == records_->end()) {
     return nullptr;
   } else {
     DCHECK(iter->second->finalized());
@@ -1429,8 +1460,8 @@ Status FunctionLibraryDefinition::AddFunctionDefHelper(
 Status FunctionLibraryDefinition::AddHelper(FunctionRecord* registration,
                                             bool* added) {
   *added = false;
-  auto iter = records_.find(registration->fdef().signature().name());
-  if (iter != records_.end()) {
+  auto iter = records_->find(registration->fdef().signature().name());
+  if (iter != records_->end()) {
     if (!FunctionDefsEqual(iter->second->fdef(), registration->fdef())) {
       return errors::InvalidArgument(
           "Cannot add function '", registration->fdef().signature().name(),
@@ -1450,7 +1481,8 @@ Status FunctionLibraryDefinition::AddHelper(FunctionRecord* registration,
   }
   registration->Ref();
   registration->finalize();
-  records_.insert({registration->fdef().signature().name(), registration});
+  mutable_records()->insert(
+      {registration->fdef().signature().name(), registration});
   *added = true;
   return OkStatus();
 }
@@ -1530,7 +1562,7 @@ Status FunctionLibraryDefinition::AddLibrary(
   std::vector<string> funcs_with_grads;
   Status s;
   bool added;
-  for (const auto& [name, record] : other.records_) {
+  for (const auto& [name, record] : *other.records_) {
     s = AddHelper(record, &added);
     if (!s.ok()) {
       Status remove_status = Remove(funcs, funcs_with_grads);
@@ -1646,23 +1678,22 @@ Status FunctionLibraryDefinition::RemoveFunction(const string& func) {
 }
 
 Status FunctionLibraryDefinition::RemoveFunctionHelper(const string& func) {
-  auto iter = records_.find(func);
-  if (iter == records_.end()) {
+  if (!records_->count(func)) {
     return errors::InvalidArgument("Tried to remove non-existent function '",
                                    func, "'.");
   }
+  FunctionRecordMap* records = mutable_records();
+  auto iter = records->find(func);
   iter->second->Unref();
-  records_.erase(iter);
+  records->erase(iter);
   return OkStatus();
 }
 
 void FunctionLibraryDefinition::Clear() {
   mutex_lock l(mu_);
-  // Drop Ref Count for each FunctionRecord.
-  for (const auto& [name, record] : records_) {
-    record->Unref();
-  }
-  records_.clear();
+  // Replace the (possibly shared) record map rather than clearing it in
+  // place; libraries sharing the old map keep their records.
+  records_ = MakeRecordMap(0);
   func_grad_.clear();
 }
 
@@ -1707,8 +1738,8 @@ string FunctionLibraryDefinition::FindGradientHelper(const string& func) const {
 Status FunctionLibraryDefinition::LookUp(
     const string& op, const OpRegistrationData** op_reg_data) const {
   tf_shared_lock l(mu_);
-  auto iter = records_.find(op);
-  if (iter != records_.end()) {
+  auto iter = records_->find(op);
+  if (iter != records_->end()) {
     *op_reg_data = &iter->second->op_registration_data();
     return OkStatus();
   }
@@ -1719,7 +1750,7 @@ string FunctionLibraryDefinition::UniqueFunctionName(StringPiece prefix) const {
   tf_shared_lock l(mu_);
   int index = 0;
   string name = strings::StrCat(prefix, index);
-  while (records_.find(name) != records_.end()) {
+  while (records_->find(name) != records_->end()) {
     ++index;
     name = strings::StrCat(prefix, index);
   }
@@ -1762,8 +1793,8 @@ const FunctionDef* FunctionLibraryDefinition::GetAttrImpl(
 std::vector<string> FunctionLibraryDefinition::ListFunctionNames() const {
   std::vector<string> function_names;
   tf_shared_lock l(mu_);
-  function_names.reserve(records_.size());
-  for (const auto& it : records_) {
+  function_names.reserve(records_->size());
+  for (const auto& it : *records_) {
     function_names.emplace_back(it.first);
   }
   return function_names;
@@ -1772,7 +1803,7 @@ std::vector<string> FunctionLibraryDefinition::ListFunctionNames() const {
 FunctionDefLibrary FunctionLibraryDefinition::ToProto() const {
   FunctionDefLibrary lib;
   tf_shared_lock l(mu_);
-  for (const auto& f : records_) {
+  for (const auto& f : *records_) {
     *lib.add_function() = f.second->fdef();
   }
   for (const auto& g : func_grad_) {
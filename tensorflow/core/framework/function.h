@@ -548,7 +548,7 @@ class FunctionLibraryDefinition : public OpRegistryInterface {
 
   size_t num_functions() const TF_LOCKS_EXCLUDED(mu_) {
     tf_shared_lock l(mu_);
-    return records_.size();
+    return records_->size();
   }
 
   // Returns all the function names in the FunctionLibraryDefinition.
@@ -613,6 +613,21 @@ class FunctionLibraryDefinition : public OpRegistryInterface {
       const FunctionDefLibrary& library, const GraphDebugInfo& debug_info);
 
  private:
+  // Map from function name to FunctionRecord. Each map owns one reference to
+  // every record it points to; the references are dropped by DestroyRecordMap
+  // when the last library sharing the map releases it.
+  typedef gtl::FlatMap<string, FunctionRecord*> FunctionRecordMap;
+
+  // Creates an empty record map sized for `num_reserved` entries, owned by a
+  // shared_ptr whose deleter unrefs the contained records.
+  static std::shared_ptr<FunctionRecordMap> MakeRecordMap(size_t num_reserved);
+  static void DestroyRecordMap(FunctionRecordMap* records);
+
+  // Returns the record map for mutation. The map is shared with other
+  // libraries after a copy; the first mutation clones it (taking a new
+  // reference on each record) so that copies remain independent.
+  FunctionRecordMap* mutable_records() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   void Initialize(const FunctionDefLibrary& library,
                   const FunctionDefLibraryStackTraces& library_traces);
 
@@ -655,7 +670,9 @@ class FunctionLibraryDefinition : public OpRegistryInterface {
 
   mutable mutex mu_;
   const OpRegistryInterface* default_registry_;
-  gtl::FlatMap<string, FunctionRecord*> records_ TF_GUARDED_BY(mu_);
+  // Shared between copies of a library and cloned lazily on the first
+  // mutation, so copying a library is O(1) in the number of functions.
+  std::shared_ptr<FunctionRecordMap> records_ TF_GUARDED_BY(mu_);
   gtl::FlatMap<string, string> func_grad_ TF_GUARDED_BY(mu_);
   // Maps from function name to optimized function graph.
   gtl::FlatMap<string, OptimizedFunctionGraph> optimized_function_graph_map_
@@ -755,6 +772,18 @@ class FunctionLibraryRuntime : public core::WeakRefCounted {
     std::unordered_map<int, DtypeAndPartialTensorShape>
         input_resource_dtypes_and_shapes;
 
+    // This interface is EXPERIMENTAL and subject to change.
+    //
+    // If non-empty, requests an instantiation specialized to these input
+    // shapes: the shapes are folded into the instantiation key and recorded
+    // on the function body's `_Arg` nodes, so that shape-dependent graph
+    // optimizations can fire for them. The runtime bounds the number of
+    // shape-specialized instantiations per function; once that bound is
+    // reached, additional shape signatures share the shape-generic
+    // instantiation instead.
+    // REQUIRES: empty, or one entry per function input.
+    std::vector<PartialTensorShape> input_shapes;
+
     // This interface is EXPERIMENTAL and subject to change.
     //
     // If non-null, the runtime will use `lib_def` to resolve function(s) named
@@ -1181,6 +1181,24 @@ TEST(FunctionLibraryDefinitionTest, Clear) {
   EXPECT_FALSE(lib_def.Contains("XAddX"));
 }
 
+TEST(FunctionLibraryDefinitionTest, CopyOnWrite) {
+  FunctionLibraryDefinition lib_def(OpRegistry::Global(), FunctionDefLibrary());
+  TF_CHECK_OK(lib_def.AddFunctionDef(test::function::XTimesTwo()));
+
+  // Copies share the underlying function records.
+  FunctionLibraryDefinition copy_lib_def(lib_def);
+  EXPECT_EQ(copy_lib_def.FindRecord("XTimesTwo").get(),
+            lib_def.FindRecord("XTimesTwo").get());
+
+  // Mutating a copy does not affect the original.
+  TF_CHECK_OK(copy_lib_def.AddFunctionDef(test::function::XAddX()));
+  TF_EXPECT_OK(copy_lib_def.RemoveFunction("XTimesTwo"));
+  EXPECT_FALSE(copy_lib_def.Contains("XTimesTwo"));
+  EXPECT_TRUE(copy_lib_def.Contains("XAddX"));
+  EXPECT_TRUE(lib_def.Contains("XTimesTwo"));
+  EXPECT_FALSE(lib_def.Contains("XAddX"));
+}
+
 TEST(FunctionLibraryDefinitionTest, AddLibrary) {
   // Create lib def with single function
   FunctionDefLibrary proto;
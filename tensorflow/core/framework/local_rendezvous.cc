@@ -29,10 +29,12 @@ limitations under the License.
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/refcount.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/refcount.h"
 
@@ -136,12 +138,30 @@ LocalRendezvous::~LocalRendezvous() {
     }
   }
   if (table_not_empty) {
-    DoAbort(absl::CancelledError("LocalRendezvous deleted"));
+    DoAbort(absl::CancelledError("LocalRendezvous deleted"),
+            /*drain_asynchronously=*/false);
   }
 }
 
 namespace {
 uint64 KeyHash(const StringPiece& k) { return Hash64(k.data(), k.size()); }
+
+// When TF_RENDEZVOUS_ASYNC_ABORT=true, StartAbort detaches the pending item
+// tables under the bucket locks and drains them (invoking the waiter
+// callbacks) on a background thread. This keeps cancellation constant-time on
+// the aborting thread even with a large number of pending items, at the cost
+// of the waiter callbacks running after StartAbort has returned.
+bool AsyncAbortEnabled() {
+  static const bool enabled = []() {
+    bool value = false;
+    Status s = ReadBoolFromEnvVar("TF_RENDEZVOUS_ASYNC_ABORT", false, &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_RENDEZVOUS_ASYNC_ABORT: " << s;
+    }
+    return value;
+  }();
+  return enabled;
+}
 }  // namespace
 
 Status LocalRendezvous::Send(const Rendezvous::ParsedKey& key,
@@ -387,7 +407,7 @@ std::vector<tsl::core::RefCountPtr<Rendezvous> >&
         *new std::vector<tsl::core::RefCountPtr<Rendezvous> >();
 
 void LocalRendezvous::StartAbort(const Status& status) {
-  DoAbort(status);
+  DoAbort(status, /*drain_asynchronously=*/AsyncAbortEnabled());
 
   if (rc_owner_) {
     mutex_lock l(aborted_rendezs_mu_);
@@ -395,7 +415,32 @@ void LocalRendezvous::StartAbort(const Status& status) {
   }
 }
 
-void LocalRendezvous::DoAbort(const Status& status) {
+void LocalRendezvous::DrainDetachedTable(const Status& status, Table& table) {
+  // Keeps one Item to make sure the current rendezvous won't be destructed.
+  std::unique_ptr<Item> to_delete;
+  for (auto& p : table) {
+    Item* item = p.second.head;
+    while (item != nullptr) {
+      switch (item->type) {
+        case Item::kRecv:
+          (*item->recv_state.waiter)(status, Rendezvous::Args(),
+                                     Rendezvous::Args(), Tensor(), false);
+          LOG(INFO) << "Local rendezvous recv item cancelled. Key hash: "
+                    << p.first;
+          break;
+        case Item::kSend:
+          LOG(INFO) << "Local rendezvous send item cancelled. Key hash: "
+                    << p.first;
+          break;
+      }
+      to_delete.reset(item);
+      item = item->next;
+    }
+  }
+}
+
+void LocalRendezvous::DoAbort(const Status& status,
+                              bool drain_asynchronously) {
   CHECK(!status.ok());
   {
     mutex_lock l(mu_);
@@ -403,34 +448,39 @@ void LocalRendezvous::DoAbort(const Status& status) {
   }
   LOG(WARNING) << "Local rendezvous is aborting with status: " << status;
 
-  // Keeps one Item to make sure the current rendezvous won't be destructed.
-  std::unique_ptr<Item> to_delete;
   for (int i = 0; i < num_buckets_; ++i) {
     auto& bucket = table_buckets_[i];
-    Table table;
+    auto table = std::make_shared<Table>();
+    bool bucket_empty;
     {
       mutex_lock l(bucket.mu);
-      bucket.table.swap(table);
-    }
-    for (auto& p : table) {
-      Item* item = p.second.head;
-      while (item != nullptr) {
-        switch (item->type) {
-          case Item::kRecv:
-            (*item->recv_state.waiter)(status, Rendezvous::Args(),
-                                       Rendezvous::Args(), Tensor(), false);
-            LOG(INFO) << "Local rendezvous recv item cancelled. Key hash: "
-                      << p.first;
-            break;
-          case Item::kSend:
-            LOG(INFO) << "Local rendezvous send item cancelled. Key hash: "
-                      << p.first;
-            break;
-        }
-        to_delete.reset(item);
-        item = item->next;
+      bucket.table.swap(*table);
+      bucket_empty = table->empty();
+      if (drain_asynchronously && !bucket_empty) {
+        // Counts the off-thread drain as one pending callback so that the
+        // destructor waits for it to finish.
+        bucket.pending_callback_counter++;
       }
     }
+    if (bucket_empty) {
+      continue;
+    }
+    if (!drain_asynchronously) {
+      DrainDetachedTable(status, *table);
+      continue;
+    }
+    // The items keep the rendezvous alive through their `rc_owner` refs (and
+    // `StartAbort` additionally retains aborted refcounted rendezvous), so the
+    // closure may outlive the caller of `StartAbort`. For rendezvous that are
+    // not refcounted, the destructor waits on `pending_callback_counter`.
+    Env::Default()->SchedClosure([&bucket, status, table]() {
+      DrainDetachedTable(status, *table);
+      mutex_lock l(bucket.mu);
+      bucket.pending_callback_counter--;
+      if (bucket.pending_callback_counter == 0) {
+        bucket.pending_callback_cond_var.notify_all();
+      }
+    });
   }
 }
 
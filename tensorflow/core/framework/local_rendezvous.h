@@ -65,7 +65,12 @@ class LocalRendezvous {
   }
 
  private:
-  void DoAbort(const Status& status);
+  // Aborts all pending items with `status`. If `drain_asynchronously` is true,
+  // each bucket's pending items are detached under the bucket lock (O(1)) and
+  // the waiter callbacks are invoked on a background thread, so aborting is
+  // constant-time with respect to the number of pending items. The destructor
+  // always drains synchronously.
+  void DoAbort(const Status& status, bool drain_asynchronously);
 
   tsl::core::RefCountPtr<Rendezvous> GetOwnerRefCountPtr();
 
@@ -84,6 +89,10 @@ class LocalRendezvous {
 
   typedef gtl::FlatMap<uint64, ItemQueue> Table;
 
+  // Invokes the recv waiters with `status` and deletes all items in a table
+  // that has been detached from its bucket.
+  static void DrainDetachedTable(const Status& status, Table& table);
+
   const int num_buckets_;
   // Pointer to the owner class of this LocalRendezvous if it is refcounted,
   // nullptr otherwise.
@@ -96,6 +96,12 @@ auto* tf_data_bytes_fetched_counter = tsl::monitoring::Counter<0>::New(
 auto* tf_data_elements_counter = tsl::monitoring::Counter<1>::New(
     "/tensorflow/data/elements", "tf.data elements", "name");
 
+auto* tf_data_elements_copied_counter = tsl::monitoring::Counter<1>::New(
+    "/tensorflow/data/elements_copied",
+    "The number of tf.data elements that were copied (rather than moved) "
+    "when handed to a downstream stage.",
+    "name");
+
 auto* tf_data_experiment_counter = tsl::monitoring::Counter<1>::New(
     "/tensorflow/data/experiment",
     "The number of times a tf.data experiment was applied.", "name");
@@ -482,6 +488,10 @@ void RecordTFDataBytesFetched(int64_t num_bytes) {
   tf_data_bytes_fetched_counter->GetCell()->IncrementBy(num_bytes);
 }
 
+void RecordTFDataElementsCopied(const string& name, int64_t num_elements) {
+  tf_data_elements_copied_counter->GetCell(name)->IncrementBy(num_elements);
+}
+
 void RecordTFDataExperiment(const string& name) {
   tf_data_experiment_counter->GetCell(name)->IncrementBy(1);
 }
@@ -80,6 +80,11 @@ monitoring::GaugeCell<std::function<std::string()>>* GetTFDataModelGauge(
 // Records the number of bytes fetched from tf.data.Dataset iterator.
 void RecordTFDataBytesFetched(int64_t num_bytes);
 
+// Records the number of elements of the dataset `name` that were copied
+// (rather than moved) when handed to a downstream stage, e.g. because the
+// stage retains the element and cannot give up ownership.
+void RecordTFDataElementsCopied(const string& name, int64_t num_elements);
+
 // Records the number of times a tf.data experiment was applied.
 void RecordTFDataExperiment(const string& name);
 
@@ -164,6 +164,14 @@ const AttrValue* AttrSlice::Find(StringPiece attr_name) const {
   // changes so that it supports efficient lookups using StringPiece instead of
   // const string&, then this code could be changed to use attrs()->find()
   // again.
+  //
+  // For attribute-heavy nodes the scan degenerates into O(n) string
+  // comparisons per lookup, so above a small threshold we pay for the one
+  // temporary string and use the hashed lookup instead.
+  static constexpr size_t kLinearScanAttrLimit = 12;
+  if (attrs()->size() > kLinearScanAttrLimit) {
+    return FindByString(string(attr_name));
+  }
 
   for (const auto& attr : *attrs()) {
     if (attr.first == attr_name) {
@@ -29,9 +29,34 @@ limitations under the License.
 #include "tensorflow/core/platform/host_info.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
+namespace {
+
+// When enabled, ops registered with a known name are finalized and validated
+// on their first lookup instead of all at once when the registry is first
+// used. This reduces startup cost for short-lived processes that touch only a
+// handful of ops. Note that the registry-wide validator (normally run on the
+// first lookup) is deferred until the registry is fully materialized, e.g. by
+// a lookup of an unregistered op or a call to Export().
+bool LazyOpRegistryEnabled() {
+  static const bool enabled = []() {
+    bool enabled = false;
+    Status status =
+        ReadBoolFromEnvVar("TF_LAZY_OP_REGISTRY", /*default_val=*/false,
+                           &enabled);
+    if (!status.ok()) {
+      LOG(ERROR) << status;
+    }
+    return enabled;
+  }();
+  return enabled;
+}
+
+}  // namespace
+
 Status DefaultValidator(const OpRegistryInterface& op_registry) {
   LOG(WARNING) << "No kernel validator registered with OpRegistry.";
   return OkStatus();
@@ -60,6 +85,22 @@ void OpRegistry::Register(const OpRegistrationDataFactory& op_data_factory) {
   }
 }
 
+void OpRegistry::Register(const std::string& op_type_name,
+                          const OpRegistrationDataFactory& op_data_factory) {
+  mutex_lock lock(mu_);
+  if (initialized_) {
+    TF_QCHECK_OK(RegisterAlreadyLocked(op_data_factory));
+  } else if (LazyOpRegistryEnabled() &&
+             deferred_by_name_.try_emplace(op_type_name, op_data_factory)
+                 .second) {
+    // Registered by name; the factory will run when the op is first looked
+    // up. A duplicate name falls through to deferred_ so that the usual
+    // AlreadyExists error surfaces when the registry is materialized.
+  } else {
+    deferred_.push_back(op_data_factory);
+  }
+}
+
 namespace {
 // Helper function that returns Status message for failed LookUp.
 Status OpNotFound(const string& op_type_name) {
@@ -103,6 +144,24 @@ const OpRegistrationData* OpRegistry::LookUpSlow(
   bool first_unregistered = false;
   {  // Scope for lock.
     mutex_lock lock(mu_);
+    if (!deferred_by_name_.empty()) {
+      // Lazy mode: if a factory was registered under this name, run just that
+      // factory. Misses fall through to full materialization below, both to
+      // cover factories registered without a name and to preserve the
+      // "all registered ops" logging for genuinely unregistered ops.
+      res = gtl::FindWithDefault(registry_, op_type_name, nullptr).get();
+      if (res == nullptr) {
+        auto iter = deferred_by_name_.find(op_type_name);
+        if (iter != deferred_by_name_.end()) {
+          TF_QCHECK_OK(RegisterAlreadyLocked(iter->second));
+          deferred_by_name_.erase(iter);
+          res = gtl::FindWithDefault(registry_, op_type_name, nullptr).get();
+        }
+      }
+      if (res != nullptr) {
+        return res;
+      }
+    }
     first_call = MustCallDeferred();
     res = gtl::FindWithDefault(registry_, op_type_name, nullptr).get();
 
@@ -188,6 +247,7 @@ void OpRegistry::DeferRegistrations() {
 void OpRegistry::ClearDeferredRegistrations() {
   mutex_lock lock(mu_);
   deferred_.clear();
+  deferred_by_name_.clear();
 }
 
 Status OpRegistry::ProcessRegistrations() const {
@@ -208,18 +268,24 @@ string OpRegistry::DebugString(bool include_internal) const {
 bool OpRegistry::MustCallDeferred() const {
   if (initialized_) return false;
   initialized_ = true;
-  registry_.reserve(registry_.size() + deferred_.size());
+  registry_.reserve(registry_.size() + deferred_.size() +
+                    deferred_by_name_.size());
   for (const auto& op_data_factory : deferred_) {
     TF_QCHECK_OK(RegisterAlreadyLocked(op_data_factory));
   }
   deferred_.clear();
+  for (const auto& name_and_factory : deferred_by_name_) {
+    TF_QCHECK_OK(RegisterAlreadyLocked(name_and_factory.second));
+  }
+  deferred_by_name_.clear();
   return true;
 }
 
 Status OpRegistry::CallDeferred() const {
   if (initialized_) return OkStatus();
   initialized_ = true;
-  registry_.reserve(registry_.size() + deferred_.size());
+  registry_.reserve(registry_.size() + deferred_.size() +
+                    deferred_by_name_.size());
   for (const auto& op_data_factory : deferred_) {
     Status s = RegisterAlreadyLocked(op_data_factory);
     if (!s.ok()) {
@@ -227,6 +293,13 @@ Status OpRegistry::CallDeferred() const {
     }
   }
   deferred_.clear();
+  for (const auto& name_and_factory : deferred_by_name_) {
+    Status s = RegisterAlreadyLocked(name_and_factory.second);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  deferred_by_name_.clear();
   return OkStatus();
 }
 
@@ -285,9 +358,10 @@ Status OpListOpRegistry::LookUp(const string& op_type_name,
 namespace register_op {
 
 InitOnStartupMarker OpDefBuilderWrapper::operator()() {
+  std::string op_name = builder_.op_name();
   OpRegistry::Global()->Register(
-      [builder =
-           std::move(builder_)](OpRegistrationData* op_reg_data) -> Status {
+      op_name, [builder = std::move(builder_)](
+                   OpRegistrationData* op_reg_data) -> Status {
         return builder.Finalize(op_reg_data);
       });
   return {};
@@ -74,6 +74,14 @@ class OpRegistry : public OpRegistryInterface {
 
   void Register(const OpRegistrationDataFactory& op_data_factory);
 
+  // Like Register() above, but also records the name of the op the factory
+  // produces. When lazy registration is enabled (see TF_LAZY_OP_REGISTRY in
+  // op.cc), named registrations are finalized and validated only when the op
+  // is first looked up, rather than all at once on the first lookup; this
+  // reduces startup cost for short-lived processes that use few ops.
+  void Register(const std::string& op_type_name,
+                const OpRegistrationDataFactory& op_data_factory);
+
   Status LookUp(const std::string& op_type_name,
                 const OpRegistrationData** op_reg_data) const override;
 
@@ -161,6 +169,11 @@ class OpRegistry : public OpRegistryInterface {
   mutable mutex mu_;
   // Functions in deferred_ may only be called with mu_ held.
   mutable std::vector<OpRegistrationDataFactory> deferred_ TF_GUARDED_BY(mu_);
+  // Deferred registrations whose op name is known up front, so that a single
+  // op can be registered on demand without materializing the whole registry.
+  // Only populated when lazy registration is enabled.
+  mutable absl::flat_hash_map<string, OpRegistrationDataFactory>
+      deferred_by_name_ TF_GUARDED_BY(mu_);
   // Values are owned.
   mutable absl::flat_hash_map<string, std::unique_ptr<const OpRegistrationData>>
       registry_ TF_GUARDED_BY(mu_);
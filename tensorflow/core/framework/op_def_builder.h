@@ -146,6 +146,9 @@ class OpDefBuilder {
   // Constructs an OpDef with just the name field set.
   explicit OpDefBuilder(std::string op_name);
 
+  // Returns the name of the op being built.
+  const std::string& op_name() const { return op_reg_data_.op_def.name(); }
+
   // Adds an attr to this OpDefBuilder (and returns *this). The spec has
   // format "<name>:<type>" or "<name>:<type>=<default>"
   // where <name> matches regexp [a-zA-Z][a-zA-Z0-9_]*
@@ -46,7 +46,10 @@ limitations under the License.
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/cpu_info.h"
@@ -781,6 +784,60 @@ Status OpKernelContext::allocate_tensor(
   return OkStatus();
 }
 
+namespace {
+
+// Opt-in aliasing audit: when TF_KERNEL_FORWARDING_AUDIT=1, every
+// allocate_output call is checked against the forwarding eligibility rules,
+// and misses are reported so kernels can be moved to
+// forward_input_or_allocate_output.
+bool KernelForwardingAuditEnabled() {
+  static const bool enabled = [] {
+    const char* audit = getenv("TF_KERNEL_FORWARDING_AUDIT");
+    return audit != nullptr && strcmp(audit, "1") == 0;
+  }();
+  return enabled;
+}
+
+auto* missed_forwarding_counter = monitoring::Counter<2>::New(
+    "/tensorflow/core/framework/missed_forwarding_opportunities",
+    "Number of allocate_output calls that could have forwarded an input "
+    "instead, per op type and output index. Only populated when "
+    "TF_KERNEL_FORWARDING_AUDIT=1.",
+    "op", "output_index");
+
+}  // namespace
+
+void OpKernelContext::maybe_record_missed_forwarding(
+    int output_index, DataType type, const TensorShape& shape,
+    const AllocatorAttributes& attr) {
+  // Mirrors the eligibility checks in forward_input: an input qualifies if
+  // the kernel exclusively owns a tensor of the right type and size in the
+  // right memory, under compatible allocator attributes.
+  for (int i = 0; i < num_inputs(); ++i) {
+    const TensorValue& input = params_->inputs[i];
+    if (input.tensor == nullptr || input.is_ref()) continue;
+    if (input_dtype(i) != type) continue;
+    if (input.tensor->shape().num_elements() != shape.num_elements()) continue;
+    if (input_memory_type(i) != output_memory_type(output_index)) continue;
+    if (!input.tensor->RefCountIsOne()) continue;
+    const auto input_attr = params_->input_alloc_attrs.empty()
+                                ? AllocatorAttributes()
+                                : input_alloc_attr(i);
+    if (!attr.IsEqualOrLessRestrictiveThan(input_attr)) continue;
+    missed_forwarding_counter
+        ->GetCell(params_->op_kernel->type_string(),
+                  strings::StrCat(output_index))
+        ->IncrementBy(1);
+    VLOG(1) << "Missed forwarding opportunity: kernel "
+            << params_->op_kernel->name() << " ("
+            << params_->op_kernel->type_string() << ") allocated output "
+            << output_index << " (" << DataTypeString(type) << ", "
+            << shape.num_elements()
+            << " elements) although input " << i << " was forwardable.";
+    return;
+  }
+}
+
 Status OpKernelContext::allocate_output(int index, const TensorShape& shape,
                                         Tensor** output,
                                         AllocatorAttributes attr) {
@@ -815,6 +872,9 @@ Status OpKernelContext::allocate_output(int index, const TensorShape& shape,
           " more than once.  Try turning off the ScopedAllocator optimizer.");
     }
   }
+  if (TF_PREDICT_FALSE(KernelForwardingAuditEnabled())) {
+    maybe_record_missed_forwarding(index, type, shape, attr);
+  }
   profiler::ScopedMemoryDebugAnnotation op_annotation(
       op_kernel().name_view().data(), step_id(), "output", type,
       [&shape]() { return shape.DebugString(); });
@@ -1465,6 +1525,63 @@ Status FindKernelRegistration(const DeviceType& device_type,
       AttrSlice(&node_def.attr()), reg, was_attr_mismatch);
 }
 
+// Process-wide cache for the pure, per-NodeDef setup work that CreateOpKernel
+// repeats for identical nodes: NodeDef validation against the OpDef and
+// memory-type inference. Multi-session servers instantiate kernels for
+// largely identical NodeDefs once per session; later sessions hit the cache
+// and skip the re-validation. Constructed kernels themselves are not shared,
+// since they capture per-session state (function library runtime, resource
+// manager) at construction time.
+class KernelSetupCache {
+ public:
+  struct Entry {
+    MemoryTypeVector input_memory_types;
+    MemoryTypeVector output_memory_types;
+  };
+
+  static KernelSetupCache* Global() {
+    static KernelSetupCache* cache = new KernelSetupCache;
+    return cache;
+  }
+
+  bool Lookup(uint64 key, Entry* entry) {
+    mutex_lock l(mu_);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) return false;
+    *entry = it->second;
+    return true;
+  }
+
+  void Insert(uint64 key, Entry entry) {
+    mutex_lock l(mu_);
+    if (cache_.size() >= kMaxEntries) return;
+    cache_.emplace(key, std::move(entry));
+  }
+
+ private:
+  // Bounds memory usage for long-running processes that keep loading
+  // distinct graphs. Entries are small; this is a conservative limit.
+  static constexpr int kMaxEntries = 8192;
+
+  mutex mu_;
+  std::unordered_map<uint64, Entry> cache_ TF_GUARDED_BY(mu_);
+};
+
+bool KernelSetupCacheEnabled() {
+  static const bool disabled =
+      std::getenv("TF_DISABLE_KERNEL_SETUP_CACHE") != nullptr;
+  return !disabled;
+}
+
+// The OpDef is hashed in addition to the NodeDef because function library
+// ops from different sessions may share an op name but differ in signature.
+uint64 KernelSetupCacheKey(const DeviceType& device_type,
+                           const NodeDef& node_def, const OpDef& op_def) {
+  uint64 key = Hash64(device_type.type_string());
+  key = Hash64Combine(key, DeterministicProtoHash64(node_def));
+  return Hash64Combine(key, DeterministicProtoHash64(op_def));
+}
+
 }  // namespace
 
 bool KernelDefAvailable(const DeviceType& device_type,
@@ -1694,13 +1811,26 @@ Status CreateOpKernel(DeviceType device_type, DeviceBase* device,
   bool was_attr_mismatch;
   const KernelRegistration* registration = nullptr;
   Status s;
+  const bool use_setup_cache = KernelSetupCacheEnabled();
+  uint64 setup_key = 0;
+  KernelSetupCache::Entry setup;
+  bool setup_cached = false;
   if (props != nullptr) {
     VLOG(1) << "Instantiating kernel for node: " << SummarizeNodeDef(node_def);
 
-    // Validate node_def against OpDef.
-    TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *props->op_def));
+    if (use_setup_cache) {
+      setup_key = KernelSetupCacheKey(device_type, node_def, *props->op_def);
+      setup_cached = KernelSetupCache::Global()->Lookup(setup_key, &setup);
+    }
 
-    // Look up kernel registration.
+    // Validate node_def against OpDef, unless an identical node already
+    // validated successfully.
+    if (!setup_cached) {
+      TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *props->op_def));
+    }
+
+    // Look up kernel registration. This is not cached because kernels may be
+    // registered dynamically after earlier lookups.
     s = FindKernelRegistration(device_type, node_def, &registration,
                                &was_attr_mismatch);
     if (!s.ok()) {
@@ -1726,16 +1856,20 @@ Status CreateOpKernel(DeviceType device_type, DeviceBase* device,
   // We are creating a kernel for an op registered in
   // OpRegistry::Global(), we consult the kernel registry to decide
   // the kernel's input and output memory types.
-  MemoryTypeVector input_memory_types;
-  MemoryTypeVector output_memory_types;
-  TF_RETURN_IF_ERROR(MemoryTypesForNode(OpRegistry::Global(), device_type,
-                                        node_def, &input_memory_types,
-                                        &output_memory_types));
+  if (!setup_cached) {
+    TF_RETURN_IF_ERROR(MemoryTypesForNode(OpRegistry::Global(), device_type,
+                                          node_def, &setup.input_memory_types,
+                                          &setup.output_memory_types));
+    if (use_setup_cache) {
+      KernelSetupCache::Global()->Insert(setup_key, setup);
+    }
+  }
 
   // Everything needed for OpKernel construction.
   OpKernelConstruction context(std::move(device_type), device, allocator, flib,
-                               resource_mgr, props, input_memory_types,
-                               output_memory_types, graph_def_version, &s);
+                               resource_mgr, props, setup.input_memory_types,
+                               setup.output_memory_types, graph_def_version,
+                               &s);
   *kernel = registration->factory->Create(&context);
   if (!s.ok()) {
     delete *kernel;
@@ -239,6 +239,15 @@ class AsyncOpKernel : public OpKernel {
   // error or cancellation), in most cases the AsyncOpKernel should implement
   // cancellation support via `context->cancellation_manager()`.
   //
+  // `done` is a continuation: to wait for an event (a queue element, a
+  // transfer, another computation) without holding a thread, hand `done` (or
+  // a closure that eventually invokes it) to whatever will produce the event,
+  // and return from ComputeAsync().  The executor suspends the node and
+  // releases the calling thread as soon as ComputeAsync() returns; the node
+  // completes whenever `done` runs.  Blocking inside ComputeAsync() on a
+  // Notification or condition variable instead pins a thread per in-flight
+  // op and can deadlock the pool.
+  //
   // WARNING: As soon as the `done` callback starts, `context` and `this` may be
   // deleted. No code depending on these objects should execute after the call
   // to `done`.
@@ -584,6 +593,10 @@ class OpKernelContext {
     // The deadline for the session to complete by. Empty if unspecified.
     absl::optional<absl::Time> deadline;
 
+    // Priority of the enclosing request; larger means more important and 0
+    // means unspecified. Cooperative kernels may use it to order work.
+    int64_t priority = 0;
+
     // The op kernel being computed.
     OpKernel* op_kernel = nullptr;
 
@@ -712,6 +725,11 @@ class OpKernelContext {
   // RunOptions.
   absl::optional<absl::Time> deadline() const { return params_->deadline; }
 
+  // Priority of the enclosing request, from
+  // RunOptions.experimental.run_handler_pool_options. Larger means more
+  // important; 0 if unspecified.
+  int64_t priority() const { return params_->priority; }
+
   const OpKernel& op_kernel() const { return *params_->op_kernel; }
 
   // Stack trace of where the op was defined (if defined in eager mode).
@@ -1275,6 +1293,15 @@ class OpKernelContext {
                          Tensor* out_tensor, AllocatorAttributes allocator_attr,
                          const AllocationAttributes& allocation_attr);
 
+  // When the aliasing audit is enabled (TF_KERNEL_FORWARDING_AUDIT=1),
+  // checks whether an input could have been forwarded into the output being
+  // allocated and, if so, records the missed forwarding opportunity. Used to
+  // find kernels that allocate fresh outputs where
+  // forward_input_or_allocate_output would avoid the copy.
+  void maybe_record_missed_forwarding(int output_index, DataType type,
+                                      const TensorShape& shape,
+                                      const AllocatorAttributes& attr);
+
   // Helpers for `set_output()`.
 
   // Returns `true` if the tensor was copied into an allocated output.
@@ -241,6 +241,15 @@ TEST_F(OpKernelTest, SuccessCpu) {
   ExpectSuccess("Test1", DEVICE_CPU, {DT_FLOAT_REF, DT_INT32}, {DT_UINT8});
 }
 
+TEST_F(OpKernelTest, RepeatedCreationUsesSetupCache) {
+  // Creating kernels for identical NodeDefs repeatedly exercises the
+  // process-wide setup cache; the resulting kernels must be equivalent to
+  // ones built on a cache miss.
+  for (int i = 0; i < 3; ++i) {
+    ExpectSuccess("Test1", DEVICE_CPU, {DT_FLOAT, DT_INT32}, {DT_UINT8});
+  }
+}
+
 TEST_F(OpKernelTest, SuccessStrippedNode) {
   ExpectSuccess("StrippedNode", DEVICE_CPU, {DT_FLOAT}, {DT_FLOAT});
 }
@@ -58,4 +58,33 @@ TEST(OpRegistrationTest, TestDuplicate) {
   EXPECT_TRUE(s.ok());
 }
 
+TEST(OpRegistrationTest, TestLazyNamedRegistration) {
+  setenv("TF_LAZY_OP_REGISTRY", "1", 1);
+  std::unique_ptr<OpRegistry> registry(new OpRegistry);
+  int num_factory_calls = 0;
+  auto factory_for = [&num_factory_calls](const string& op_name) {
+    return [&num_factory_calls,
+            op_name](OpRegistrationData* op_reg_data) -> Status {
+      ++num_factory_calls;
+      op_reg_data->op_def.set_name(op_name);
+      return OkStatus();
+    };
+  };
+  registry->Register("Foo", factory_for("Foo"));
+  registry->Register("Bar", factory_for("Bar"));
+
+  // Looking up an op only runs that op's factory.
+  const OpDef* op_def = nullptr;
+  TF_EXPECT_OK(registry->LookUpOpDef("Foo", &op_def));
+  EXPECT_EQ(op_def->name(), "Foo");
+  EXPECT_EQ(num_factory_calls, 1);
+
+  // Exporting the registry materializes the remaining ops.
+  OpList op_list;
+  registry->Export(true, &op_list);
+  EXPECT_EQ(op_list.op().size(), 2);
+  EXPECT_EQ(num_factory_calls, 2);
+  unsetenv("TF_LAZY_OP_REGISTRY");
+}
+
 }  // namespace tensorflow
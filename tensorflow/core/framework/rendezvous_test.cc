@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_types.h"
 #include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -519,5 +520,67 @@ void BM_PingPong(::testing::benchmark::State& state) {
 }
 BENCHMARK(BM_PingPong)->Arg(100)->Arg(200)->Arg(300);
 
+// Send/recv storm: `state.range(0)` threads split into sender/receiver pairs
+// that exchange tensors through one rendezvous with `state.range(1)` table
+// shards, every message on its own key.  Unlike BM_SendRecv this stresses
+// bucket-level contention across many concurrent keys rather than a single
+// key's item queue.
+void BM_SendRecvStorm(::testing::benchmark::State& state) {
+  const int num_threads = state.range(0);
+  const int num_shards = state.range(1);
+  const int num_pairs = num_threads / 2;
+  static constexpr int kMessagesPerPair = 64;
+  Rendezvous* rendez = NewLocalRendezvous(num_shards);
+  thread::ThreadPool pool(Env::Default(), "storm", num_threads);
+
+  // Pre-parse one key per (pair, message) so the benchmark loop measures
+  // rendezvous traffic rather than key parsing, and so the keys hash across
+  // all of the table shards.
+  std::vector<Rendezvous::ParsedKey> keys;
+  keys.reserve(num_pairs * kMessagesPerPair);
+  for (int p = 0; p < num_pairs; ++p) {
+    for (int m = 0; m < kMessagesPerPair; ++m) {
+      keys.push_back(MakeKey(strings::StrCat("storm_", p, "_", m)));
+    }
+  }
+  Tensor orig = V("val");
+
+  for (auto s : state) {
+    BlockingCounter counter(num_threads);
+    for (int p = 0; p < num_pairs; ++p) {
+      pool.Schedule([rendez, &keys, &orig, &counter, p]() {
+        bool is_dead = false;
+        Rendezvous::Args args;
+        for (int m = 0; m < kMessagesPerPair; ++m) {
+          TF_CHECK_OK(rendez->Send(keys[p * kMessagesPerPair + m], args, orig,
+                                   is_dead));
+        }
+        counter.DecrementCount();
+      });
+      pool.Schedule([rendez, &keys, &counter, p]() {
+        Tensor val(DT_STRING, TensorShape({}));
+        bool is_dead = false;
+        Rendezvous::Args args;
+        for (int m = 0; m < kMessagesPerPair; ++m) {
+          TF_CHECK_OK(rendez->Recv(keys[p * kMessagesPerPair + m], args, &val,
+                                   &is_dead));
+        }
+        CHECK_EQ(V(val), "val");
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(num_pairs) * kMessagesPerPair *
+                          state.iterations());
+  rendez->Unref();
+}
+BENCHMARK(BM_SendRecvStorm)
+    ->ArgPair(8, 1)
+    ->ArgPair(8, 16)
+    ->ArgPair(64, 1)
+    ->ArgPair(64, 16)
+    ->ArgPair(64, 64);
+
 }  // namespace
 }  // namespace tensorflow
@@ -23,6 +23,7 @@ limitations under the License.
 #include <unordered_map>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/types/variant.h"
 #include "tensorflow/core/framework/common_shape_fns.h"
 #include "tensorflow/core/framework/device_attributes.pb.h"
@@ -194,9 +195,9 @@ class ResourceMgr {
   Status Lookup(const ResourceHandle& handle,
                 ResourceBase** resource) const TF_MUST_USE_RESULT;
 
-  // Similar to Lookup, but looks up multiple resources at once, with only a
-  // single lock acquisition.  If containers_and_names[i] is uninitialized
-  // then this function does not modify resources[i].
+  // Similar to Lookup, but looks up multiple resources at once, with one
+  // lock acquisition per resource.  If containers_and_names[i] is
+  // uninitialized then this function does not modify resources[i].
   template <typename T, bool use_dynamic_cast = false>
   Status LookupMany(absl::Span<std::pair<const string*, const string*> const>
                         containers_and_names,
@@ -272,31 +273,54 @@ class ResourceMgr {
   typedef absl::flat_hash_map<Key, ResourceAndName, KeyHash, KeyEqual>
       Container;
 
+  // The resource maps are sharded by a hash of the container and resource
+  // names, so concurrent lookups of different resources in one hot container
+  // contend on different mutexes. A logical container spans all shards;
+  // container-wide operations (Cleanup, Clear, DebugString) visit every
+  // shard.
+  struct Shard {
+    mutable mutex mu;
+    absl::flat_hash_map<string, Container*> containers TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumShards = 16;
+
   const std::string default_container_;
-  mutable mutex mu_;
-  absl::flat_hash_map<string, Container*> containers_ TF_GUARDED_BY(mu_);
+  mutable Shard shards_[kNumShards];
+
+  Shard& shard(const std::string& container, const std::string& name) const {
+    const uint64 h = Hash64(name.data(), name.size(),
+                            Hash64(container.data(), container.size()));
+    return shards_[h % kNumShards];
+  }
+
+  // Names of all containers that currently exist in any shard. Lookups can no
+  // longer tell a missing container from a missing resource by inspecting a
+  // single shard, so the error path consults this registry instead.
+  mutable mutex all_containers_mu_;
+  absl::flat_hash_set<std::string> all_containers_
+      TF_GUARDED_BY(all_containers_mu_);
+
+  bool ContainerExists(const std::string& container) const;
 
   template <typename T, bool use_dynamic_cast = false>
-  Status LookupInternal(const std::string& container, const std::string& name,
-                        T** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
-  Status LookupInternal(const std::string& container, uint64 type_hash_code,
-                        const std::string& name, ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
-
-  Status DoCreate(const std::string& container, TypeIndex type,
+  Status LookupInternal(const Shard& shard, const std::string& container,
+                        const std::string& name, T** resource) const
+      TF_SHARED_LOCKS_REQUIRED(shard.mu) TF_MUST_USE_RESULT;
+
+  Status DoCreate(Shard& shard, const std::string& container, TypeIndex type,
                   const std::string& name, ResourceBase* resource,
                   bool owns_resource)
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+      TF_EXCLUSIVE_LOCKS_REQUIRED(shard.mu) TF_MUST_USE_RESULT;
 
-  Status DoLookup(const std::string& container, TypeIndex type,
-                  const std::string& name, ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
-  Status DoLookup(const std::string& container, uint64 type_hash_code,
-                  const std::string& type_name,
+  Status DoLookup(const Shard& shard, const std::string& container,
+                  TypeIndex type, const std::string& name,
+                  ResourceBase** resource) const
+      TF_SHARED_LOCKS_REQUIRED(shard.mu) TF_MUST_USE_RESULT;
+  Status DoLookup(const Shard& shard, const std::string& container,
+                  uint64 type_hash_code, const std::string& type_name,
                   const std::string& resource_name,
                   ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+      TF_SHARED_LOCKS_REQUIRED(shard.mu) TF_MUST_USE_RESULT;
 
   Status DoDelete(const std::string& container, uint64 type_hash_code,
                   const std::string& resource_name,
@@ -312,16 +336,16 @@ class ResourceMgr {
       ResourceAndName& resource_and_name) TF_MUST_USE_RESULT;
   // Inserts the type name for 'hash_code' into the hash_code to type name map.
   Status InsertDebugTypeName(uint64 hash_code, const std::string& type_name)
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+      TF_MUST_USE_RESULT;
 
   // Returns the type name for the 'hash_code'.
   // Returns "<unknown>" if a resource with such a type was never inserted into
   // the container.
-  const char* DebugTypeName(uint64 hash_code) const
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  const char* DebugTypeName(uint64 hash_code) const;
 
   // Map from type hash_code to type name.
-  std::unordered_map<uint64, string> debug_type_names_ TF_GUARDED_BY(mu_);
+  mutable mutex debug_mu_;
+  std::unordered_map<uint64, string> debug_type_names_ TF_GUARDED_BY(debug_mu_);
 
   ResourceMgr(const ResourceMgr&) = delete;
   void operator=(const ResourceMgr&) = delete;
@@ -640,8 +664,9 @@ Status ResourceMgr::Create(const std::string& container,
                            const std::string& name, T* resource) {
   CheckDeriveFromResourceBase<T>();
   CHECK(resource != nullptr);
-  mutex_lock l(mu_);
-  return DoCreate(container, TypeIndex::Make<T>(), name, resource,
+  Shard& s = shard(container, name);
+  mutex_lock l(s.mu);
+  return DoCreate(s, container, TypeIndex::Make<T>(), name, resource,
                   /* owns_resource */ true);
 }
 
@@ -649,8 +674,9 @@ template <typename T>
 Status ResourceMgr::CreateUnowned(const std::string& container,
                                   const std::string& name, T* resource) {
   CheckDeriveFromResourceBase<T>();
-  mutex_lock l(mu_);
-  return DoCreate(container, TypeIndex::Make<T>(), name, resource,
+  Shard& s = shard(container, name);
+  mutex_lock l(s.mu);
+  return DoCreate(s, container, TypeIndex::Make<T>(), name, resource,
                   /* owns_resource */ false);
 }
 
@@ -658,8 +684,9 @@ template <typename T, bool use_dynamic_cast>
 Status ResourceMgr::Lookup(const std::string& container,
                            const std::string& name, T** resource) const {
   CheckDeriveFromResourceBase<T>();
-  tf_shared_lock l(mu_);
-  return LookupInternal<T, use_dynamic_cast>(container, name, resource);
+  const Shard& s = shard(container, name);
+  tf_shared_lock l(s.mu);
+  return LookupInternal<T, use_dynamic_cast>(s, container, name, resource);
 }
 
 template <typename T, bool use_dynamic_cast>
@@ -668,14 +695,16 @@ Status ResourceMgr::LookupMany(
         containers_and_names,
     std::vector<core::RefCountPtr<T>>* resources) const {
   CheckDeriveFromResourceBase<T>();
-  tf_shared_lock l(mu_);
   resources->resize(containers_and_names.size());
   for (size_t i = 0; i < containers_and_names.size(); ++i) {
     T* resource;
-    Status s = LookupInternal<T, use_dynamic_cast>(
-        *containers_and_names[i].first, *containers_and_names[i].second,
+    const Shard& s = shard(*containers_and_names[i].first,
+                           *containers_and_names[i].second);
+    tf_shared_lock l(s.mu);
+    Status status = LookupInternal<T, use_dynamic_cast>(
+        s, *containers_and_names[i].first, *containers_and_names[i].second,
         &resource);
-    if (s.ok()) {
+    if (status.ok()) {
       (*resources)[i].reset(resource);
     }
   }
@@ -694,11 +723,12 @@ struct TypeCastFunctor<T, true> {
 };
 
 template <typename T, bool use_dynamic_cast>
-Status ResourceMgr::LookupInternal(const std::string& container,
+Status ResourceMgr::LookupInternal(const Shard& shard,
+                                   const std::string& container,
                                    const std::string& name,
                                    T** resource) const {
   ResourceBase* found = nullptr;
-  Status s = DoLookup(container, TypeIndex::Make<T>(), name, &found);
+  Status s = DoLookup(shard, container, TypeIndex::Make<T>(), name, &found);
   if (s.ok()) {
     // It's safe to down cast 'found' to T* since
     // typeid(T).hash_code() is part of the map key.
@@ -714,16 +744,17 @@ Status ResourceMgr::LookupOrCreate(const std::string& container,
   CheckDeriveFromResourceBase<T>();
   *resource = nullptr;
   Status s;
+  Shard& sh = shard(container, name);
   {
-    tf_shared_lock l(mu_);
-    s = LookupInternal<T, use_dynamic_cast>(container, name, resource);
+    tf_shared_lock l(sh.mu);
+    s = LookupInternal<T, use_dynamic_cast>(sh, container, name, resource);
     if (s.ok()) return s;
   }
-  mutex_lock l(mu_);
-  s = LookupInternal<T, use_dynamic_cast>(container, name, resource);
+  mutex_lock l(sh.mu);
+  s = LookupInternal<T, use_dynamic_cast>(sh, container, name, resource);
   if (s.ok()) return s;
   TF_RETURN_IF_ERROR(creator(resource));
-  s = DoCreate(container, TypeIndex::Make<T>(), name, *resource,
+  s = DoCreate(sh, container, TypeIndex::Make<T>(), name, *resource,
                /* owns_resource */ true);
   if (!s.ok()) {
     return errors::Internal("LookupOrCreate failed unexpectedly");
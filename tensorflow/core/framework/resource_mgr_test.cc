@@ -226,6 +226,34 @@ TEST(ResourceMgrTest, CreateOrLookup) {
            "Resource foo/bar");
 }
 
+TEST(ResourceMgrTest, ManyResourcesInOneContainer) {
+  // Resources in a single container are spread over internal shards; make
+  // sure creation, lookup, cleanup and the error messages all behave as if
+  // the container were a single map.
+  ResourceMgr rm;
+  constexpr int kNumResources = 100;
+  for (int i = 0; i < kNumResources; ++i) {
+    TF_CHECK_OK(rm.Create("foo", strings::StrCat("r", i),
+                          new Resource(strings::StrCat("v", i))));
+  }
+  {
+    thread::ThreadPool threads(Env::Default(), "concurrent_lookups", 8);
+    for (int i = 0; i < kNumResources; ++i) {
+      threads.Schedule([&rm, i] {
+        EXPECT_EQ(strings::StrCat("R/v", i),
+                  Find<Resource>(rm, "foo", strings::StrCat("r", i)));
+      });
+    }
+  }
+  HasError(FindErr<Resource>(rm, "foo", "no-such-resource"), error::NOT_FOUND,
+           "Resource foo/no-such-resource");
+  TF_CHECK_OK(rm.Cleanup("foo"));
+  for (int i = 0; i < kNumResources; ++i) {
+    HasError(FindErr<Resource>(rm, "foo", strings::StrCat("r", i)),
+             error::NOT_FOUND, "Container foo");
+  }
+}
+
 TEST(ResourceMgrTest, CreateOrLookupRaceCondition) {
   ResourceMgr rm;
   std::atomic<int> atomic_int(0);
@@ -15,8 +15,16 @@ limitations under the License.
 
 #include "tensorflow/core/framework/resource_var.h"
 
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/framework/resource_handle.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/graph/graph_def_builder.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/snappy.h"
 
 namespace tensorflow {
 
@@ -45,4 +53,93 @@ std::string Var::MakeRefCountingHandleName(int64_t resource_id) const {
   std::string handle_name = absl::StrFormat("%s%d", debug_name_, resource_id);
   return handle_name;
 }
+
+Status Var::Compress() {
+  mutex_lock l(mu_);
+  mutex_lock cl(compression_mu_);
+  if (compressed_.load(std::memory_order_acquire)) return OkStatus();
+  if (!is_initialized || !tensor_.IsInitialized()) {
+    return errors::FailedPrecondition(
+        "Cannot compress an uninitialized variable.");
+  }
+  if (frozen.load(std::memory_order_acquire)) {
+    return errors::FailedPrecondition(
+        "Cannot compress a frozen variable: its buffer may be aliased by "
+        "readers that do not hold the variable's mutex.");
+  }
+  if (!DataTypeCanUseMemcpy(tensor_.dtype())) {
+    return errors::Unimplemented("Cannot compress a variable of type ",
+                                 DataTypeString(tensor_.dtype()));
+  }
+  if (!tensor_.RefCountIsOne()) {
+    return errors::FailedPrecondition(
+        "Cannot compress a variable whose buffer is aliased by an "
+        "outstanding read.");
+  }
+  const StringPiece data = tensor_.tensor_data();
+  std::vector<std::string> chunks;
+  chunks.reserve(data.size() / kCompressionChunkBytes + 1);
+  for (size_t offset = 0; offset < data.size();
+       offset += kCompressionChunkBytes) {
+    const size_t chunk_size =
+        std::min(kCompressionChunkBytes, data.size() - offset);
+    std::string chunk;
+    if (!port::Snappy_Compress(data.data() + offset, chunk_size, &chunk)) {
+      return errors::Unimplemented(
+          "Snappy compression is not supported in this build.");
+    }
+    chunks.push_back(std::move(chunk));
+  }
+  compressed_dtype_ = tensor_.dtype();
+  compressed_shape_ = tensor_.shape();
+  compressed_chunks_ = std::move(chunks);
+  // Frees the uncompressed buffer; tensor_ is restored on first touch.
+  tensor_ = Tensor();
+  compressed_.store(true, std::memory_order_release);
+  return OkStatus();
+}
+
+Status Var::Decompress() {
+  mutex_lock cl(compression_mu_);
+  if (!compressed_.load(std::memory_order_acquire)) return OkStatus();
+  return DecompressLocked();
+}
+
+void Var::DecompressOnTouch() {
+  mutex_lock cl(compression_mu_);
+  if (!compressed_.load(std::memory_order_acquire)) return;
+  Status s = DecompressLocked();
+  if (!s.ok()) {
+    LOG(ERROR) << "Failed to decompress variable " << debug_name_ << ": " << s;
+  }
+}
+
+Status Var::DecompressLocked() {
+  Tensor restored(compressed_dtype_, compressed_shape_);
+  char* output = static_cast<char*>(restored.data());
+  const size_t total_bytes = restored.tensor_data().size();
+  size_t offset = 0;
+  for (const std::string& chunk : compressed_chunks_) {
+    size_t chunk_size;
+    if (!port::Snappy_GetUncompressedLength(chunk.data(), chunk.size(),
+                                            &chunk_size) ||
+        offset + chunk_size > total_bytes ||
+        !port::Snappy_Uncompress(chunk.data(), chunk.size(),
+                                 output + offset)) {
+      return errors::DataLoss("Malformed compressed chunk in variable ",
+                              debug_name_);
+    }
+    offset += chunk_size;
+  }
+  if (offset != total_bytes) {
+    return errors::DataLoss("Compressed variable ", debug_name_,
+                            " restored to ", offset, " bytes, expected ",
+                            total_bytes);
+  }
+  tensor_ = std::move(restored);
+  compressed_chunks_.clear();
+  compressed_chunks_.shrink_to_fit();
+  compressed_.store(false, std::memory_order_release);
+  return OkStatus();
+}
 }  //  end namespace tensorflow
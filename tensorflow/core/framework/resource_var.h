@@ -17,10 +17,12 @@ limitations under the License.
 #define TENSORFLOW_CORE_FRAMEWORK_RESOURCE_VAR_H_
 
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/resource_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/macros.h"
 
 // Forward declarations to avoid introducing a dependency on headers in
 // "tensorflow/core/graph/...".
@@ -76,7 +78,35 @@ class Var : public ResourceBase {
   // increasing mu() address.
   // TODO(ebrevdo): Use LockSet instead of exposing mu.
   mutex* mu() { return &mu_; }
-  Tensor* tensor() { return &tensor_; }
+  Tensor* tensor() {
+    if (TF_PREDICT_FALSE(compressed_.load(std::memory_order_acquire))) {
+      DecompressOnTouch();
+    }
+    return &tensor_;
+  }
+
+  // Moves the variable's value to a compressed in-memory representation and
+  // frees the tensor's buffer, trading first-touch latency for resident
+  // memory. Intended to be called on cold variables by a memory-pressure
+  // policy; the value is restored transparently the first time `tensor()` is
+  // touched again. The buffer is compressed with snappy in independent 1MB
+  // chunks so compression scratch stays bounded. Only variables whose tensor
+  // lives in host memory and uses a memcpy-able dtype can be compressed;
+  // frozen variables are rejected since their buffer may be aliased by
+  // readers that do not hold mu_. Acquires mu_, so the caller must not hold
+  // it.
+  Status Compress();
+
+  // Restores the variable's value from the compressed representation.
+  // Invoked implicitly on first touch; exposed so a policy can also warm a
+  // variable back in ahead of expected use. A no-op if the variable is not
+  // compressed.
+  Status Decompress();
+
+  // Returns true if the variable's value is currently held compressed.
+  bool IsCompressed() const {
+    return compressed_.load(std::memory_order_acquire);
+  }
 
   // Uninitializes the variable, by reverting the state of the tensor to
   // the state when the variable is first created.
@@ -89,6 +119,10 @@ class Var : public ResourceBase {
   Status AsGraphDef(GraphDefBuilder* builder, Node** out) const override;
 
   std::string DebugString() const override {
+    if (compressed_.load(std::memory_order_acquire)) {
+      return strings::StrCat(DataTypeString(compressed_dtype_), "/",
+                             compressed_shape_.DebugString(), " (compressed)");
+    }
     return strings::StrCat(DataTypeString(tensor_.dtype()), "/",
                            tensor_.shape().DebugString());
   }
@@ -110,11 +144,37 @@ class Var : public ResourceBase {
   // so desired.
   std::atomic<bool> copy_on_read_mode{false};
 
+  // Set (under an exclusive lock on mu_) by the _FreezeVariable op once a
+  // serving process has finished writing the variable. While true the tensor
+  // is immutable: dense reads may alias the buffer without acquiring mu_, and
+  // ops that would modify the variable fail with FailedPrecondition.
+  // Freezing is one-way and is rejected in copy-on-read mode.
+  std::atomic<bool> frozen{false};
+
  private:
+  // The size of the independently compressed chunks of the tensor's buffer.
+  static constexpr size_t kCompressionChunkBytes = 1 << 20;
+
+  // Restores the tensor on first touch. Decompression failures are logged and
+  // leave the variable behaving as uninitialized.
+  void DecompressOnTouch();
+  Status DecompressLocked() TF_EXCLUSIVE_LOCKS_REQUIRED(compression_mu_);
+
   mutex mu_;
   Tensor tensor_;
   std::string debug_name_;
 
+  // True while the variable's value is held in compressed_chunks_ instead of
+  // tensor_.
+  std::atomic<bool> compressed_{false};
+  // Serializes compression state changes; acquired after mu_ when both are
+  // held. First-touch decompression runs with only the caller's shared lock
+  // on mu_, so it is serialized on this mutex instead.
+  mutex compression_mu_;
+  std::vector<std::string> compressed_chunks_ TF_GUARDED_BY(compression_mu_);
+  DataType compressed_dtype_ = DT_INVALID;
+  TensorShape compressed_shape_;
+
   ~Var() override {}
   Var(const Var&) = delete;
   void operator=(const Var&) = delete;
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/framework/resource_var.h"
 
+#include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/test.h"
 
@@ -34,5 +35,32 @@ TEST(ResourceVarTest, Uninitialize) {
   EXPECT_FALSE(var->is_initialized);
   EXPECT_TRUE(var->tensor()->data() == nullptr);
 }
+
+TEST(ResourceVarTest, CompressDecompress) {
+  RefCountPtr<Var> var{new Var(DT_FLOAT)};
+  *(var->tensor()) = Tensor(DT_FLOAT, TensorShape({64}));
+  auto flat = var->tensor()->flat<float>();
+  for (int i = 0; i < 64; ++i) flat(i) = i;
+  var->is_initialized = true;
+
+  TF_EXPECT_OK(var->Compress());
+  EXPECT_TRUE(var->IsCompressed());
+  // Compressing an already compressed variable is a no-op.
+  TF_EXPECT_OK(var->Compress());
+
+  // The first touch transparently restores the value.
+  Tensor* tensor = var->tensor();
+  EXPECT_FALSE(var->IsCompressed());
+  ASSERT_EQ(tensor->NumElements(), 64);
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_EQ(tensor->flat<float>()(i), static_cast<float>(i));
+  }
+}
+
+TEST(ResourceVarTest, CompressRequiresInitializedVariable) {
+  RefCountPtr<Var> var{new Var(DT_INT32)};
+  EXPECT_FALSE(var->Compress().ok());
+  EXPECT_FALSE(var->IsCompressed());
+}
 }  // namespace core
 }  // namespace tensorflow
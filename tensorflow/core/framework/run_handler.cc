@@ -25,6 +25,8 @@ limitations under the License.
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/run_handler_util.h"
 #include "tensorflow/core/lib/core/threadpool_interface.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/context.h"
 #include "tensorflow/core/platform/denormal.h"
@@ -43,6 +45,25 @@ static constexpr int32_t kMaxConcurrentHandlers = 128;
 typedef typename internal::RunHandlerEnvironment::Task Task;
 typedef Eigen::RunQueue<Task, 1024> Queue;
 
+auto* run_handler_queue_time_usecs = monitoring::Sampler<1>::New(
+    {"/tensorflow/core/run_handler/task_queue_time_usecs",
+     "The time a task spent queued in a run handler before a pool thread "
+     "picked it up, in microseconds.",
+     "task_type"},
+    // Power of 2 with bucket count 20 (~1 second).
+    {monitoring::Buckets::Exponential(1, 2, 20)});
+
+auto* run_handler_steal_count = monitoring::Counter<1>::New(
+    "/tensorflow/core/run_handler/task_steal_count",
+    "The number of tasks a pool thread executed on behalf of a request other "
+    "than the one it searches first.",
+    "task_type");
+
+auto* run_handler_quota_exhausted_count = monitoring::Counter<0>::New(
+    "/tensorflow/core/run_handler/cpu_quota_exhausted_count",
+    "The number of requests whose processing time exceeded the per-request "
+    "CPU quota, causing their remaining tasks to be deprioritized.");
+
 }  // namespace
 
 namespace internal {
@@ -76,6 +97,7 @@ RunHandlerEnvironment::Task RunHandlerEnvironment::CreateTask(
           std::move(f),
           Context(ContextKind::kThread),
           id,
+          env_->NowMicros(),
       }),
   };
 }
@@ -129,6 +151,9 @@ ThreadWorkSource::ThreadWorkSource()
       non_blocking_work_queues_(non_blocking_work_sharding_factor_),
       blocking_inflight_(0),
       non_blocking_inflight_(0),
+      processing_time_micros_(0),
+      cpu_quota_micros_(0),
+      quota_exhaustion_recorded_(false),
       traceme_id_(0),
       version_(0),
       sub_thread_pool_waiter_(nullptr) {
@@ -301,12 +326,43 @@ unsigned ThreadWorkSource::NonBlockingWorkShardingFactor() {
   return non_blocking_work_sharding_factor_;
 }
 
+void ThreadWorkSource::SetCpuQuota(int64_t quota_micros) {
+  cpu_quota_micros_.store(quota_micros, std::memory_order_relaxed);
+  processing_time_micros_.store(0, std::memory_order_relaxed);
+  quota_exhaustion_recorded_.store(false, std::memory_order_relaxed);
+}
+
+void ThreadWorkSource::AccumulateProcessingTime(int64_t micros) {
+  const int64_t total =
+      processing_time_micros_.fetch_add(micros, std::memory_order_relaxed) +
+      micros;
+  const int64_t quota = cpu_quota_micros_.load(std::memory_order_relaxed);
+  if (quota > 0 && total > quota &&
+      !quota_exhaustion_recorded_.exchange(true, std::memory_order_relaxed)) {
+    run_handler_quota_exhausted_count->GetCell()->IncrementBy(1);
+    VLOG(2) << "Request " << GetTracemeId() << " exhausted its CPU quota of "
+            << quota << " us.";
+  }
+}
+
+int64_t ThreadWorkSource::GetProcessingTimeMicros() {
+  return processing_time_micros_.load(std::memory_order_relaxed);
+}
+
+bool ThreadWorkSource::IsCpuQuotaExhausted() {
+  const int64_t quota = cpu_quota_micros_.load(std::memory_order_relaxed);
+  return quota > 0 &&
+         processing_time_micros_.load(std::memory_order_relaxed) > quota;
+}
+
 std::string ThreadWorkSource::ToString() {
   return strings::StrCat("traceme_id = ", GetTracemeId(),
                          ", inter queue size = ", TaskQueueSize(true),
                          ", inter inflight = ", GetInflightTaskCount(true),
                          ", intra queue size = ", TaskQueueSize(false),
-                         ", intra inflight = ", GetInflightTaskCount(false));
+                         ", intra inflight = ", GetInflightTaskCount(false),
+                         ", processing time (us) = ",
+                         GetProcessingTimeMicros());
 }
 
 RunHandlerThreadPool::RunHandlerThreadPool(
@@ -488,7 +544,7 @@ RunHandlerThreadPool::ThreadData::ThreadData()
 Task RunHandlerThreadPool::FindTask(
     int searching_range_start, int searching_range_end, int thread_id,
     int sub_thread_pool_id, int max_blocking_inflight,
-    bool may_steal_blocking_work,
+    bool may_steal_blocking_work, bool skip_throttled,
     const Eigen::MaxSizeVector<ThreadWorkSource*>& thread_work_sources,
     bool* task_from_blocking_queue, ThreadWorkSource** tws) {
   Task t;
@@ -503,6 +559,12 @@ Task RunHandlerThreadPool::FindTask(
     *tws = thread_work_sources[current_index];
     ++current_index;
 
+    // Defer requests that have used up their CPU quota; they are picked up
+    // by a later search pass if nothing else is runnable.
+    if (skip_throttled && (*tws)->IsCpuQuotaExhausted()) {
+      continue;
+    }
+
     // For blocking thread, search for blocking tasks first.
     if (may_steal_blocking_work &&
         (*tws)->GetInflightTaskCount(true) < max_blocking_inflight) {
@@ -535,6 +597,7 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
     Task t;
     ThreadWorkSource* tws = nullptr;
     bool task_from_blocking_queue = true;
+    bool task_stolen = false;
     int sub_thread_pool_id;
     // Get the current thread work sources.
     {
@@ -567,14 +630,25 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
 
         t = FindTask(search_range_start, search_range_end, thread_id,
                      sub_thread_pool_id, kMaxBlockingInflight,
-                     /*may_steal_blocking_work=*/true, *thread_work_sources,
-                     &task_from_blocking_queue, &tws);
+                     /*may_steal_blocking_work=*/true, /*skip_throttled=*/true,
+                     *thread_work_sources, &task_from_blocking_queue, &tws);
         if (!t.f) {
           // Search from all requests if the thread cannot find tasks from
           // requests that belong to its own sub thread pool.
           t = FindTask(0, active_requests, thread_id, sub_thread_pool_id,
                        kMaxBlockingInflight,
-                       /*may_steal_blocking_work=*/true, *thread_work_sources,
+                       /*may_steal_blocking_work=*/true,
+                       /*skip_throttled=*/true, *thread_work_sources,
+                       &task_from_blocking_queue, &tws);
+          task_stolen = t.f != nullptr;
+        }
+        if (!t.f) {
+          // Run throttled requests only when nothing else is runnable, so
+          // CPU quotas never leave threads idle while work exists.
+          t = FindTask(0, active_requests, thread_id, sub_thread_pool_id,
+                       kMaxBlockingInflight,
+                       /*may_steal_blocking_work=*/true,
+                       /*skip_throttled=*/false, *thread_work_sources,
                        &task_from_blocking_queue, &tws);
         }
       } else {
@@ -582,43 +656,61 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
         // requests.
         t = FindTask(0, active_requests, thread_id, sub_thread_pool_id,
                      kMaxBlockingInflight,
-                     /*may_steal_blocking_work=*/false, *thread_work_sources,
-                     &task_from_blocking_queue, &tws);
+                     /*may_steal_blocking_work=*/false, /*skip_throttled=*/true,
+                     *thread_work_sources, &task_from_blocking_queue, &tws);
+        if (!t.f) {
+          t = FindTask(0, active_requests, thread_id, sub_thread_pool_id,
+                       kMaxBlockingInflight,
+                       /*may_steal_blocking_work=*/false,
+                       /*skip_throttled=*/false, *thread_work_sources,
+                       &task_from_blocking_queue, &tws);
+        }
       }
     } else {
       // TODO(chaox): Refactor the following code to share the logic with
-      // FindTask.
-      for (int i = 0; i < thread_work_sources->size(); ++i) {
-        tws = (*thread_work_sources)[i];
-        // We want a smallish numbers of inter threads since
-        // otherwise there will be contention in PropagateOutputs.
-        // This is best effort policy.
-        if (may_steal_blocking_work &&
-            tws->GetInflightTaskCount(true) < kMaxBlockingInflight) {
-          t = tws->PopBlockingTask();
-          if (t.f) {
-            break;
-          }
-        }
-        if (i == 0) {
-          // Always look for any work from the "primary" work source.
-          // This way when we wake up a thread for a new closure we are
-          // guaranteed it can be worked on.
-          t = tws->PopNonBlockingTask(thread_id, true);
-          if (t.f) {
-            task_from_blocking_queue = false;
-            break;
+      // FindTask. Requests whose CPU quota is exhausted are skipped in the
+      // first pass and only considered when no other request has work.
+      for (const bool skip_throttled : {true, false}) {
+        for (int i = 0; i < thread_work_sources->size(); ++i) {
+          tws = (*thread_work_sources)[i];
+          if (skip_throttled && tws->IsCpuQuotaExhausted()) {
+            continue;
           }
-          if (t.f) {
-            break;
+          // We want a smallish numbers of inter threads since
+          // otherwise there will be contention in PropagateOutputs.
+          // This is best effort policy.
+          if (may_steal_blocking_work &&
+              tws->GetInflightTaskCount(true) < kMaxBlockingInflight) {
+            t = tws->PopBlockingTask();
+            if (t.f) {
+              task_stolen = i > 0;
+              break;
+            }
           }
-        } else {
-          t = tws->PopNonBlockingTask(thread_id, false);
-          if (t.f) {
-            task_from_blocking_queue = false;
-            break;
+          if (i == 0) {
+            // Always look for any work from the "primary" work source.
+            // This way when we wake up a thread for a new closure we are
+            // guaranteed it can be worked on.
+            t = tws->PopNonBlockingTask(thread_id, true);
+            if (t.f) {
+              task_from_blocking_queue = false;
+              break;
+            }
+            if (t.f) {
+              break;
+            }
+          } else {
+            t = tws->PopNonBlockingTask(thread_id, false);
+            if (t.f) {
+              task_from_blocking_queue = false;
+              task_stolen = true;
+              break;
+            }
           }
         }
+        if (t.f) {
+          break;
+        }
       }
     }
     if (t.f) {
@@ -631,9 +723,18 @@ void RunHandlerThreadPool::WorkerLoop(int thread_id,
           profiler::TraceMeLevel::kInfo);
       VLOG(2) << "Running " << (task_from_blocking_queue ? "inter" : "intra")
               << " work from " << tws->GetTracemeId();
+      const char* task_type = task_from_blocking_queue ? "inter" : "intra";
+      const uint64 execute_start_us = Env::Default()->NowMicros();
+      run_handler_queue_time_usecs->GetCell(task_type)->Add(
+          execute_start_us - t.f->enqueue_time_us);
+      if (task_stolen) {
+        run_handler_steal_count->GetCell(task_type)->IncrementBy(1);
+      }
       tws->IncrementInflightTaskCount(task_from_blocking_queue);
       env_.ExecuteTask(t);
       tws->DecrementInflightTaskCount(task_from_blocking_queue);
+      tws->AccumulateProcessingTime(
+          static_cast<int64_t>(Env::Default()->NowMicros() - execute_start_us));
     } else {
       profiler::TraceMe activity(
           [=] {
@@ -1081,6 +1182,11 @@ void RunHandler::Impl::Reset(
   step_id_ = step_id;
   options_ = options;
   tws_.SetTracemeId(step_id);
+  // Handlers are pooled and reused across requests; setting the quota also
+  // resets the processing-time accounting for the new request.
+  static const int64_t cpu_quota_micros = static_cast<int64_t>(
+      ParamFromEnvWithDefault("TF_RUN_HANDLER_REQUEST_CPU_QUOTA_MICROS", 0));
+  tws_.SetCpuQuota(cpu_quota_micros);
 }
 
 RunHandlerPool::RunHandlerPool(int num_inter_op_threads)
@@ -116,6 +116,9 @@ class RunHandlerEnvironment {
     std::function<void()> f;
     Context context;
     uint64 trace_id;
+    // Time (in microseconds since unix epoch) when the task was created,
+    // used to report queueing time once a pool thread picks the task up.
+    uint64 enqueue_time_us;
   };
   Env* const env_;
   const ThreadOptions thread_options_;
@@ -184,6 +187,22 @@ class ThreadWorkSource {
 
   unsigned NonBlockingWorkShardingFactor();
 
+  // Per-request processing-time accounting, used for cooperative CPU quotas.
+  // Processing time is the time pool threads spend executing this source's
+  // tasks; it approximates CPU time since an executing task occupies its
+  // thread. Setting a quota resets the accumulated time; a quota of 0 (the
+  // default) disables throttling. A source whose quota is exhausted is
+  // deprioritized by worker threads at task boundaries: its tasks only run
+  // when no unthrottled source has work.
+  void SetCpuQuota(int64_t quota_micros);
+
+  void AccumulateProcessingTime(int64_t micros);
+
+  int64_t GetProcessingTimeMicros();
+
+  // True iff a quota is set and accumulated processing time exceeds it.
+  bool IsCpuQuotaExhausted();
+
   std::string ToString();
 
  private:
@@ -199,6 +218,10 @@ class ThreadWorkSource {
   std::atomic<int64_t> blocking_inflight_;
   std::atomic<int64_t> non_blocking_inflight_;
 
+  std::atomic<int64_t> processing_time_micros_;
+  std::atomic<int64_t> cpu_quota_micros_;
+  std::atomic<bool> quota_exhaustion_recorded_;
+
   Queue blocking_work_queue_;
   mutex blocking_queue_op_mu_;
   char pad_[128];
@@ -257,10 +280,13 @@ class RunHandlerThreadPool {
   // Search tasks from Requets range searching_range_start to
   // searching_range_end. If there is no tasks in the search range and
   // may_steal_blocking_work is true, then search from all requests.
+  // If skip_throttled is true, requests whose CPU quota is exhausted are
+  // passed over; callers should retry without it when nothing else is
+  // runnable so that throttling stays work conserving.
   Task FindTask(
       int searching_range_start, int searching_range_end, int thread_id,
       int sub_thread_pool_id, int max_blocking_inflight,
-      bool may_steal_blocking_work,
+      bool may_steal_blocking_work, bool skip_throttled,
       const Eigen::MaxSizeVector<ThreadWorkSource*>& thread_work_sources,
       bool* task_from_blocking_queue, ThreadWorkSource** tws);
 
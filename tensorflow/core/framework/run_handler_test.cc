@@ -185,7 +185,8 @@ TEST(RunHandlerThreadPool, FindTask) {
               /*searching_range_start=*/0, /*searching_range_end=*/5,
               /*thread_id=*/0,
               /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-              /*may_steal_blocking_work=*/true, thread_work_sources,
+              /*may_steal_blocking_work=*/true, /*skip_throttled=*/false,
+              thread_work_sources,
               task_from_blocking_queue, &tws);
         };
     bool task_from_blocking_queue;
@@ -226,7 +227,8 @@ TEST(RunHandlerThreadPool, FindTask) {
               range_start, range_end,
               /*thread_id=*/0,
               /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-              /*may_steal_blocking_work=*/true, thread_work_sources,
+              /*may_steal_blocking_work=*/true, /*skip_throttled=*/false,
+              thread_work_sources,
               task_from_blocking_queue, &tws);
         };
 
@@ -258,7 +260,8 @@ TEST(RunHandlerThreadPool, FindTask) {
               range_start, range_end,
               /*thread_id=*/0,
               /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-              /*may_steal_blocking_work=*/true, thread_work_sources,
+              /*may_steal_blocking_work=*/true, /*skip_throttled=*/false,
+              thread_work_sources,
               task_from_blocking_queue, &tws);
         };
     bool task_from_blocking_queue;
@@ -290,7 +293,8 @@ TEST(RunHandlerThreadPool, FindTask) {
               range_start, range_end,
               /*thread_id=*/0,
               /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-              /*may_steal_blocking_work=*/true, thread_work_sources,
+              /*may_steal_blocking_work=*/true, /*skip_throttled=*/false,
+              thread_work_sources,
               task_from_blocking_queue, &tws);
         };
     bool task_from_blocking_queue;
@@ -336,7 +340,8 @@ TEST(RunHandlerThreadPool, FindTask) {
               /*searching_range_start=*/0, /*searching_range_end=*/5,
               /*thread_id=*/0,
               /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-              /*may_steal_blocking_work=*/true, thread_work_sources,
+              /*may_steal_blocking_work=*/true, /*skip_throttled=*/false,
+              thread_work_sources,
               task_from_blocking_queue, &tws);
         };
     bool task_from_blocking_queue;
@@ -370,8 +375,8 @@ TEST(RunHandlerThreadPool, FindTask) {
           /*searching_range_start=*/0, /*searching_range_end=*/5,
           /*thread_id=*/0,
           /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-          is_blocking_thread, thread_work_sources, task_from_blocking_queue,
-          &tws);
+          is_blocking_thread, /*skip_throttled=*/false, thread_work_sources,
+          task_from_blocking_queue, &tws);
     };
     bool task_from_blocking_queue;
     internal::Task t;
@@ -405,8 +410,8 @@ TEST(RunHandlerThreadPool, FindTask) {
           /*searching_range_start=*/0, /*searching_range_end=*/5,
           /*thread_id=*/0,
           /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
-          is_blocking_thread, thread_work_sources, task_from_blocking_queue,
-          &tws);
+          is_blocking_thread, /*skip_throttled=*/false, thread_work_sources,
+          task_from_blocking_queue, &tws);
     };
 
     bool task_from_blocking_queue;
@@ -426,6 +431,72 @@ TEST(RunHandlerThreadPool, FindTask) {
   }
 }
 
+TEST(RunHandlerThreadPool, CpuQuotaThrottling) {
+  Eigen::MaxSizeVector<mutex> waiters_mu(2);
+  waiters_mu.resize(2);
+  Eigen::MaxSizeVector<internal::Waiter> waiters(2);
+  waiters.resize(2);
+  internal::RunHandlerThreadPool run_handler_thread_pool(
+      /*num_blocking_threads=*/1, /*num_non_blocking_threads=*/0,
+      Env::Default(), ThreadOptions(), "tf_run_handler_pool", &waiters_mu,
+      &waiters);
+
+  Eigen::MaxSizeVector<internal::ThreadWorkSource*> thread_work_sources(2);
+  thread_work_sources.resize(2);
+  for (int i = 0; i < 2; ++i) {
+    thread_work_sources[i] = new internal::ThreadWorkSource();
+  }
+
+  // Exhaust the first request's quota.
+  thread_work_sources[0]->SetCpuQuota(100);
+  thread_work_sources[0]->AccumulateProcessingTime(200);
+  EXPECT_EQ(thread_work_sources[0]->GetProcessingTimeMicros(), 200);
+  EXPECT_TRUE(thread_work_sources[0]->IsCpuQuotaExhausted());
+  EXPECT_FALSE(thread_work_sources[1]->IsCpuQuotaExhausted());
+
+  int result = -1;
+  run_handler_thread_pool.AddWorkToQueue(thread_work_sources[0],
+                                         /*is_blocking=*/true,
+                                         [&result] { result = 0; });
+  run_handler_thread_pool.AddWorkToQueue(thread_work_sources[1],
+                                         /*is_blocking=*/true,
+                                         [&result] { result = 1; });
+
+  const auto find_blocking_task = [&](bool skip_throttled,
+                                      bool* task_from_blocking_queue,
+                                      internal::Task* t) {
+    internal::ThreadWorkSource* tws;
+    *t = run_handler_thread_pool.FindTask(
+        /*searching_range_start=*/0, /*searching_range_end=*/2,
+        /*thread_id=*/0,
+        /*sub_thread_pool_id=*/0, /*max_blocking_inflight=*/10,
+        /*may_steal_blocking_work=*/true, skip_throttled, thread_work_sources,
+        task_from_blocking_queue, &tws);
+  };
+  bool task_from_blocking_queue;
+  internal::Task t;
+  // The throttled request is passed over; the unthrottled one runs first.
+  find_blocking_task(/*skip_throttled=*/true, &task_from_blocking_queue, &t);
+  t.f->f();
+  EXPECT_EQ(result, 1);
+  find_blocking_task(/*skip_throttled=*/true, &task_from_blocking_queue, &t);
+  EXPECT_EQ(t.f, nullptr);
+  // With nothing else runnable the throttled request still makes progress.
+  find_blocking_task(/*skip_throttled=*/false, &task_from_blocking_queue, &t);
+  t.f->f();
+  EXPECT_EQ(result, 0);
+
+  // Setting a quota resets the accounting for the next request reusing the
+  // handler.
+  thread_work_sources[0]->SetCpuQuota(100);
+  EXPECT_EQ(thread_work_sources[0]->GetProcessingTimeMicros(), 0);
+  EXPECT_FALSE(thread_work_sources[0]->IsCpuQuotaExhausted());
+
+  for (int i = 0; i < 2; ++i) {
+    delete thread_work_sources[i];
+  }
+}
+
 TEST(RunHandlerThreadPool, RoundRobinExecution) {
   // Set up environment for 1 sub thread pool.
   setenv("TF_RUN_HANDLER_USE_SUB_THREAD_POOL", "true", true);
@@ -36,6 +36,7 @@ limitations under the License.
 #include <ostream>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/escaping.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
@@ -62,6 +63,7 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/platform/types.h"
@@ -159,6 +161,97 @@ class Buffer : public BufferBase {
   void operator=(const Buffer&) = delete;
 };
 
+// InlineBuffer stores tensors of up to kMaxInlineBytes payload in the same
+// heap object as the buffer itself, so a small tensor costs one fixed-size
+// allocation instead of a buffer object plus a data allocation. The blocks
+// are recycled through a per-thread free list, so steady-state small-tensor
+// churn performs no global-heap allocations at all.
+constexpr size_t kMaxInlineBytes = 16;
+
+// Every InlineBuffer<T> instantiation fits in a block of this size; see the
+// static_assert below. The block is over-aligned so the inline payload meets
+// the usual tensor buffer alignment.
+constexpr size_t kInlineBlockBytes = 128;
+constexpr size_t kInlineFreeListCapacity = 512;
+
+struct InlineBlockFreeList {
+  ~InlineBlockFreeList() {
+    for (void* block : blocks) port::AlignedFree(block);
+  }
+  std::vector<void*> blocks;
+};
+
+InlineBlockFreeList* GetInlineBlockFreeList() {
+  static thread_local InlineBlockFreeList free_list;
+  return &free_list;
+}
+
+void* AllocateInlineBlock() {
+  InlineBlockFreeList* free_list = GetInlineBlockFreeList();
+  if (!free_list->blocks.empty()) {
+    void* block = free_list->blocks.back();
+    free_list->blocks.pop_back();
+    return block;
+  }
+  return port::AlignedMalloc(kInlineBlockBytes,
+                             Allocator::kAllocatorAlignment);
+}
+
+void DeallocateInlineBlock(void* block) {
+  InlineBlockFreeList* free_list = GetInlineBlockFreeList();
+  if (free_list->blocks.size() < kInlineFreeListCapacity) {
+    free_list->blocks.push_back(block);
+  } else {
+    port::AlignedFree(block);
+  }
+}
+
+template <typename T>
+class InlineBuffer : public TensorBuffer {
+ public:
+  explicit InlineBuffer(int64_t n) : TensorBuffer(storage_), elem_(n) {}
+
+  size_t size() const override { return sizeof(T) * elem_; }
+  TensorBuffer* root_buffer() override { return this; }
+
+  bool GetAllocatedBytes(size_t* out_bytes) const override {
+    *out_bytes = kInlineBlockBytes;
+    return true;
+  }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size()));
+    proto->set_allocator_name("inline");
+  }
+
+  static void* operator new(size_t size) { return AllocateInlineBlock(); }
+  static void operator delete(void* ptr) { DeallocateInlineBlock(ptr); }
+
+ private:
+  ~InlineBuffer() override = default;
+
+  int64_t elem_;
+  alignas(Allocator::kAllocatorAlignment) char storage_[kMaxInlineBytes];
+
+  InlineBuffer(const InlineBuffer&) = delete;
+  void operator=(const InlineBuffer&) = delete;
+};
+
+// Returns an InlineBuffer holding `n` elements of T if the payload qualifies
+// for inline storage, or nullptr to fall back to a regular Buffer<T>.
+template <typename T>
+TensorBuffer* MaybeMakeInlineBuffer(int64_t n) {
+  if constexpr (std::is_trivially_copyable<T>::value &&
+                std::is_trivially_destructible<T>::value) {
+    static_assert(sizeof(InlineBuffer<T>) <= kInlineBlockBytes,
+                  "InlineBuffer must fit in a recycled block");
+    if (n > 0 && static_cast<uint64>(n) * sizeof(T) <= kMaxInlineBytes) {
+      return new InlineBuffer<T>(n);
+    }
+  }
+  return nullptr;
+}
+
 void LogUnexpectedSize(int64_t actual, int64_t expected) {
   LOG(ERROR) << "Input size was " << actual << " and expected " << expected;
 }
@@ -964,12 +1057,23 @@ int Tensor::RefCount() const {
   CASES_WITH_DEFAULT(TYPE_ENUM, STMTS, LOG(FATAL) << "Type not set"; \
                      , LOG(FATAL) << "Unexpected type: " << TYPE_ENUM;)
 
+static Allocator* get_default_cpu_allocator();
+
 Tensor::Tensor(Allocator* a, DataType type, const TensorShape& shape)
     : shape_(shape), buf_(nullptr) {
   set_dtype(type);
   CHECK_NOTNULL(a);
   if (shape_.num_elements() > 0 || a->AllocatesOpaqueHandle()) {
-    CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    // Small tensors allocated from the default CPU allocator get inline
+    // storage, saving a heap allocation. Allocators that track sizes or log
+    // memory are left on the regular path so their accounting stays exact.
+    if (a == get_default_cpu_allocator() && !a->TracksAllocationSizes() &&
+        !MemoryLoggingEnabled()) {
+      CASES(type, buf_ = MaybeMakeInlineBuffer<T>(shape.num_elements()));
+    }
+    if (buf_ == nullptr) {
+      CASES(type, buf_ = new Buffer<T>(a, shape.num_elements()));
+    }
   }
   if (MemoryLoggingEnabled() && buf_ != nullptr && buf_->data() != nullptr) {
     LogMemory::RecordTensorAllocation("Unknown", LogMemory::UNKNOWN_STEP_ID,
@@ -1401,6 +1401,30 @@ TEST(Tensor, SharesBufferWith) {
   EXPECT_TRUE(a.SharesBufferWith(copy));
 }
 
+TEST(Tensor, SmallTensorInlineStorage) {
+  // Tensors with <= 16 bytes of payload use inline buffer storage; they must
+  // behave exactly like regular tensors: aligned, shareable, deep-copyable.
+  Tensor small(DT_INT32, TensorShape({4}));
+  EXPECT_TRUE(small.IsAligned());
+  auto flat = small.flat<int32>();
+  for (int i = 0; i < 4; ++i) flat(i) = i + 1;
+
+  Tensor copy(small);
+  EXPECT_TRUE(small.SharesBufferWith(copy));
+  EXPECT_EQ(copy.flat<int32>()(3), 4);
+
+  Tensor deep = tensor::DeepCopy(small);
+  EXPECT_FALSE(small.SharesBufferWith(deep));
+  EXPECT_EQ(deep.flat<int32>()(0), 1);
+
+  // Round-trips through TensorProto like any other tensor.
+  TensorProto proto;
+  small.AsProtoTensorContent(&proto);
+  Tensor roundtrip;
+  ASSERT_TRUE(roundtrip.FromProto(proto));
+  test::ExpectTensorEqual<int32>(small, roundtrip);
+}
+
 TEST(TensorFromProto, CompressedTensorProto) {
   int size = 100;
   TensorShape shape({size});
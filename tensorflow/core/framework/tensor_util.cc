@@ -16,8 +16,17 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_util.h"
 
 #include <cmath>
+#include <functional>
+#include <utility>
 #include <vector>
 
+#include "absl/memory/memory.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/byte_order.h"
+
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/type_traits.h"
@@ -56,6 +65,119 @@ void DeepCopy(const Tensor& input, Tensor* output) {
   }
 }
 
+namespace {
+
+// A TensorBuffer over caller-owned memory. Destruction invokes the caller's
+// completion callback instead of freeing the memory.
+class UserTensorBuffer : public TensorBuffer {
+ public:
+  UserTensorBuffer(void* data, size_t len, std::function<void()> done)
+      : TensorBuffer(data), len_(len), done_(std::move(done)) {}
+
+  ~UserTensorBuffer() override {
+    if (done_) done_();
+  }
+
+  size_t size() const override { return len_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size()));
+    proto->set_allocator_name("user_buffer");
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t len_;
+  const std::function<void()> done_;
+};
+
+// A TensorBuffer that owns the string released from a TensorProto's
+// tensor_content field, so the decoded tensor aliases the proto's backing
+// buffer instead of copying it.
+class StringBackedTensorBuffer : public TensorBuffer {
+ public:
+  explicit StringBackedTensorBuffer(std::unique_ptr<std::string> content)
+      : TensorBuffer(const_cast<char*>(content->data())),
+        content_(std::move(content)) {}
+
+  size_t size() const override { return content_->size(); }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(static_cast<int64_t>(size()));
+    proto->set_allocator_name("proto_content");
+  }
+  bool OwnsMemory() const override { return true; }
+
+ private:
+  const std::unique_ptr<std::string> content_;
+};
+
+}  // namespace
+
+Status MakeTensorFromProto(TensorProto&& proto, Tensor* result) {
+  const DataType dtype = proto.dtype();
+  TensorShape shape;
+  TF_RETURN_IF_ERROR(TensorShape::BuildTensorShape(proto.tensor_shape(),
+                                                   &shape));
+  // The zero-copy path requires a memcpy-able payload in host byte order
+  // whose backing buffer meets the tensor alignment contract. The alignment
+  // check is best-effort: heap-allocated std::string buffers are typically
+  // aligned to 16 bytes, not Allocator::kAllocatorAlignment (64), so this
+  // branch mostly fires for arena-backed or Cord-flattened protos; everything
+  // else takes the copying fallback below.
+  if (port::kLittleEndian && DataTypeCanUseMemcpy(dtype) &&
+      !proto.tensor_content().empty() &&
+      proto.tensor_content().size() ==
+          shape.num_elements() * DataTypeSize(BaseType(dtype)) &&
+      reinterpret_cast<uintptr_t>(proto.tensor_content().data()) %
+              Allocator::kAllocatorAlignment ==
+          0) {
+    auto content = absl::WrapUnique(proto.release_tensor_content());
+    core::RefCountPtr<StringBackedTensorBuffer> buf(
+        new StringBackedTensorBuffer(std::move(content)));
+    *result = Tensor(dtype, shape, buf.get());
+    return OkStatus();
+  }
+  if (!result->FromProto(proto)) {
+    return errors::InvalidArgument("Cannot parse tensor from proto: ",
+                                   proto.ShortDebugString());
+  }
+  // The proto is consumed either way: releasing the payload right after the
+  // copy keeps only one tensor's worth of duplicated bytes live at a time
+  // when a caller decodes a response holding many tensors.
+  proto.Clear();
+  return OkStatus();
+}
+
+Status MakeTensorFromUserBuffer(DataType dtype, const TensorShape& shape,
+                                void* data, size_t len,
+                                std::function<void()> done, Tensor* result) {
+  if (!DataTypeCanUseMemcpy(dtype)) {
+    return errors::InvalidArgument(
+        "Cannot alias a user buffer for non-memcpy-able dtype ",
+        DataTypeString(dtype));
+  }
+  const size_t expected_len =
+      shape.num_elements() * DataTypeSize(BaseType(dtype));
+  if (len != expected_len) {
+    return errors::InvalidArgument("User buffer of ", len,
+                                   " bytes does not match shape ",
+                                   shape.DebugString(), " which requires ",
+                                   expected_len, " bytes");
+  }
+  if (reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment !=
+      0) {
+    return errors::InvalidArgument(
+        "User buffer must be aligned to Allocator::kAllocatorAlignment (",
+        Allocator::kAllocatorAlignment, " bytes)");
+  }
+  // The tensor takes a reference on the buffer; the final Unref runs 'done'.
+  core::RefCountPtr<UserTensorBuffer> buf(
+      new UserTensorBuffer(data, len, std::move(done)));
+  *result = Tensor(dtype, shape, buf.get());
+  return OkStatus();
+}
+
 Status Concat(const gtl::ArraySlice<Tensor>& tensors, Tensor* result) {
   if (tensors.empty()) {
     return errors::InvalidArgument("Cannot concatenate zero tensors");
@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_FRAMEWORK_TENSOR_UTIL_H_
 
 #include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "tensorflow/core/framework/tensor.h"
@@ -52,6 +53,40 @@ void DeepCopy(const Tensor& input, Tensor* output);
 Status Concat(const gtl::ArraySlice<Tensor>& tensors,
               Tensor* result) TF_MUST_USE_RESULT;
 
+// Creates a tensor that aliases the caller-provided buffer 'data' instead of
+// copying it, for zero-copy feeds on CPU devices. 'done' is the lifetime
+// token: it is invoked exactly once when the last tensor referencing the
+// buffer is destroyed, after which the caller may reuse or free the memory.
+// The caller must keep the buffer alive and unchanged until then.
+//
+// When the resulting tensor is fed to a Session running on CPU, the graph
+// reads directly from the user buffer; no copy into the runtime is made. For
+// zero-copy fetches, retrieve outputs with move semantics (e.g.
+// FunctionCallFrame::ConsumeRetvals) and hold the returned tensor, which
+// shares the kernel-produced buffer.
+//
+// REQUIRES: 'data' must be aligned to Allocator::kAllocatorAlignment and hold
+// exactly 'shape.num_elements()' elements of type 'dtype'.
+// REQUIRES: 'dtype' must be a simple (memcpy-able) type.
+Status MakeTensorFromUserBuffer(DataType dtype, const TensorShape& shape,
+                                void* data, size_t len,
+                                std::function<void()> done,
+                                Tensor* result) TF_MUST_USE_RESULT;
+
+// Decodes 'proto' into '*result' without copying the tensor payload when
+// possible: if the proto carries its data in 'tensor_content', the dtype is
+// memcpy-able, and the content's backing buffer happens to be aligned to
+// Allocator::kAllocatorAlignment, the buffer is adopted from the proto and
+// becomes the tensor's storage. The alignment is best-effort (heap
+// std::string buffers usually are not 64-byte aligned), so callers must not
+// rely on the zero-copy branch firing; when it does not, this falls back to
+// a copying Tensor::FromProto and releases the proto's payload right after
+// the copy. Either way 'proto' is consumed. Use this wherever an owned
+// TensorProto is decoded into a Tensor, so large payloads are not kept
+// alive twice.
+Status MakeTensorFromProto(TensorProto&& proto,
+                           Tensor* result) TF_MUST_USE_RESULT;
+
 // Splits 'tensor' into 'sizes.size()' individual tensors, along the 0th
 // dimension. The ith output tensor has 0th-dimension size 'sizes[i]'.
 //
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <vector>
 
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.h"
@@ -736,5 +737,67 @@ TEST(TensorProtoUtil, CompressTensorProtoNegatizeZero) {
   }
 }
 
+TEST(TensorUtil, MakeTensorFromUserBuffer) {
+  alignas(Allocator::kAllocatorAlignment) float data[4] = {1.f, 2.f, 3.f, 4.f};
+  bool done_called = false;
+  Tensor t;
+  TF_ASSERT_OK(tensor::MakeTensorFromUserBuffer(
+      DT_FLOAT, TensorShape({4}), data, sizeof(data),
+      [&done_called]() { done_called = true; }, &t));
+
+  // The tensor aliases the user buffer rather than copying it.
+  EXPECT_EQ(t.flat<float>().data(), data);
+  EXPECT_EQ(t.flat<float>()(2), 3.f);
+
+  // The lifetime token fires only when the last reference goes away.
+  Tensor copy = t;
+  t = Tensor();
+  EXPECT_FALSE(done_called);
+  copy = Tensor();
+  EXPECT_TRUE(done_called);
+}
+
+TEST(TensorUtil, MakeTensorFromProto) {
+  Tensor original(DT_FLOAT, TensorShape({1024}));
+  for (int i = 0; i < 1024; ++i) original.flat<float>()(i) = i * 0.5f;
+  TensorProto proto;
+  original.AsProtoTensorContent(&proto);
+  const void* content_ptr = proto.tensor_content().data();
+  const bool aligned = reinterpret_cast<uintptr_t>(content_ptr) %
+                           Allocator::kAllocatorAlignment ==
+                       0;
+
+  Tensor decoded;
+  TF_ASSERT_OK(tensor::MakeTensorFromProto(std::move(proto), &decoded));
+  test::ExpectTensorEqual<float>(original, decoded);
+  if (aligned) {
+    // The decode adopted the proto's backing buffer instead of copying.
+    EXPECT_EQ(decoded.flat<float>().data(), content_ptr);
+  }
+}
+
+TEST(TensorUtil, MakeTensorFromProtoFallsBackForFieldEncoding) {
+  // Protos carrying data in typed fields rather than tensor_content use the
+  // regular copying decode.
+  Tensor original(DT_FLOAT, TensorShape({3}));
+  original.flat<float>().setConstant(7.f);
+  TensorProto proto;
+  original.AsProtoField(&proto);
+  Tensor decoded;
+  TF_ASSERT_OK(tensor::MakeTensorFromProto(std::move(proto), &decoded));
+  test::ExpectTensorEqual<float>(original, decoded);
+  // The copying fallback still consumes the proto, releasing its payload.
+  EXPECT_EQ(proto.ByteSizeLong(), 0);
+}
+
+TEST(TensorUtil, MakeTensorFromUserBufferValidatesSize) {
+  alignas(Allocator::kAllocatorAlignment) float data[4];
+  Tensor t;
+  EXPECT_FALSE(tensor::MakeTensorFromUserBuffer(DT_FLOAT, TensorShape({8}),
+                                                data, sizeof(data), nullptr,
+                                                &t)
+                   .ok());
+}
+
 }  // namespace
 }  // namespace tensorflow
@@ -501,6 +501,11 @@ void Graph::Clear() {
   }
 }
 
+void Graph::Reserve(int num_nodes, int num_edges) {
+  nodes_.reserve(nodes_.size() + num_nodes);
+  edges_.reserve(edges_.size() + num_edges);
+}
+
 const VersionDef& Graph::versions() const { return *versions_; }
 void Graph::set_versions(const VersionDef& versions) { *versions_ = versions; }
 
@@ -514,23 +519,23 @@ void Graph::Copy(const Graph& src) {
   set_versions(src.versions());
 
   // Copy the nodes.
-  // "Node in src" -> "Node in *dest"
-  gtl::FlatMap<const Node*, Node*> node_map;
-  node_map.reserve(src.num_nodes());
-  node_map[src.source_node()] = source_node();
-  node_map[src.sink_node()] = sink_node();
+  // "Node id in src" -> "Node in *dest". Node ids are dense, so a flat
+  // vector indexed by id is cheaper than a hash map here.
+  std::vector<Node*> node_map(src.num_node_ids(), nullptr);
+  node_map[src.source_node()->id()] = source_node();
+  node_map[src.sink_node()->id()] = sink_node();
   for (Node* n : src.op_nodes()) {
     auto copy = CopyNode(n);
     copy->in_edges_.reserve(n->in_edges().size());
     copy->out_edges_.reserve(n->out_edges().size());
-    node_map[n] = copy;
+    node_map[n->id()] = copy;
   }
 
   // Copy the edges
   edges_.reserve(src.num_edges());
   for (const Edge* e : src.edges()) {
-    Node* src_copy = node_map[e->src()];
-    Node* dst_copy = node_map[e->dst()];
+    Node* src_copy = node_map[e->src()->id()];
+    Node* dst_copy = node_map[e->dst()->id()];
     AddEdge(src_copy, e->src_output(), dst_copy, e->dst_input());
   }
 }
@@ -581,6 +581,12 @@ class Graph {
   // No Node* references to the Graph are valid post.
   void Clear();
 
+  // Reserves storage for `num_nodes` additional nodes and `num_edges`
+  // additional edges. Callers that construct a graph from a GraphDef of known
+  // size can use this to avoid repeated reallocation of the internal node and
+  // edge arrays during bulk construction.
+  void Reserve(int num_nodes, int num_edges);
+
   // Adds an edge that connects the xth output of `source` to the yth input of
   // `dest` and returns it. Does not update dest's NodeDef.
   const Edge* AddEdge(Node* source, int x, Node* dest, int y);
@@ -27,6 +27,8 @@ limitations under the License.
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/memory_types.h"
 #include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/versions.pb.h"
@@ -41,6 +43,7 @@ limitations under the License.
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
@@ -769,6 +772,155 @@ Status AddControlFlow(const PartitionOptions& opts, Graph* g,
   return OkStatus();
 }
 
+// Enables the min-cut boundary refinement for callers that can't plumb
+// PartitionOptions::minimize_cross_device_transfers.
+bool MinCutRefinementEnabled() {
+  static bool enabled = [] {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPH_PARTITION_MIN_CUT",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+// Nominal weight for edges whose transfer size we can't derive: a control
+// edge only carries a dummy scalar, and a data edge with unknown shape is
+// charged a flat estimate so it still participates in the cut.
+constexpr int64_t kControlEdgeBytes = 4;
+constexpr int64_t kUnknownShapeBytes = 4096;
+
+// Estimated number of bytes 'edge' would transfer if it crossed partitions.
+int64_t EstimateEdgeBytes(const Edge* edge) {
+  if (edge->IsControlEdge()) {
+    return kControlEdgeBytes;
+  }
+  int64_t element_size = DataTypeSize(EdgeType(edge));
+  if (element_size <= 0) {
+    element_size = sizeof(float);
+  }
+  // Use the producer's inferred shape when it's fully known.
+  std::vector<PartialTensorShape> shapes;
+  if (TryGetNodeAttr(edge->src()->attrs(), "_output_shapes", &shapes) &&
+      edge->src_output() < static_cast<int>(shapes.size()) &&
+      shapes[edge->src_output()].IsFullyDefined()) {
+    return element_size * shapes[edge->src_output()].num_elements();
+  }
+  return kUnknownShapeBytes;
+}
+
+// Returns true iff 'node' may be relocated to a different partition without
+// changing the meaning of the graph. Stateful ops anchor state to their
+// device; control flow structure nodes and ref tensors pin frames and
+// variables; explicitly colocated nodes follow their group.
+bool IsRelocatable(const Node* node) {
+  if (!node->IsOp() || node->IsArg() || node->IsRetval()) {
+    return false;
+  }
+  if (node->op_def().is_stateful()) {
+    return false;
+  }
+  if (node->IsEnter() || node->IsExit() || node->IsSwitch() ||
+      node->IsMerge() || node->IsNextIteration() || node->IsLoopCond() ||
+      IsControlLoop(node)) {
+    return false;
+  }
+  if (node->attrs().Find(kColocationAttrName) != nullptr) {
+    return false;
+  }
+  for (int i = 0; i < node->num_inputs(); ++i) {
+    if (IsRefType(node->input_type(i))) return false;
+  }
+  for (int i = 0; i < node->num_outputs(); ++i) {
+    if (IsRefType(node->output_type(i))) return false;
+  }
+  return true;
+}
+
+// Greedy min-cut refinement of the device assignments, in the spirit of
+// Kernighan-Lin: for every relocatable node, compare the estimated bytes it
+// exchanges with its own partition against the bytes it exchanges with each
+// neighboring partition, and move it to the best neighbor when that strictly
+// reduces the volume crossing the cut. Moves expose further moves, so we
+// sweep until a sweep makes no progress (bounded by a few passes; the
+// boundary is thin relative to the graph so this converges quickly).
+//
+// This deliberately over-counts fan-out edges that the later Send/Recv
+// deduplication would collapse into one transfer; the estimate is only used
+// to rank candidate placements.
+void RefineBoundaryPlacement(const PartitionOptions& opts, Graph* g) {
+  std::vector<string> loc(g->num_node_ids());
+  for (const Node* node : g->op_nodes()) {
+    loc[node->id()] = opts.node_to_loc(node);
+  }
+
+  int64_t moved_nodes = 0;
+  int64_t saved_bytes = 0;
+  const int kMaxPasses = 3;
+  for (int pass = 0; pass < kMaxPasses; ++pass) {
+    bool changed = false;
+    for (Node* node : g->op_nodes()) {
+      if (!IsRelocatable(node)) continue;
+
+      // Total up traffic per neighboring partition, remembering one
+      // neighbor in each as the representative device to move to.
+      std::unordered_map<string, int64_t> bytes_by_loc;
+      std::unordered_map<string, const Node*> rep_by_loc;
+      for (const Edge* edge : node->in_edges()) {
+        const Node* peer = edge->src();
+        if (!peer->IsOp()) continue;
+        bytes_by_loc[loc[peer->id()]] += EstimateEdgeBytes(edge);
+        rep_by_loc.emplace(loc[peer->id()], peer);
+      }
+      for (const Edge* edge : node->out_edges()) {
+        const Node* peer = edge->dst();
+        if (!peer->IsOp()) continue;
+        bytes_by_loc[loc[peer->id()]] += EstimateEdgeBytes(edge);
+        rep_by_loc.emplace(loc[peer->id()], peer);
+      }
+
+      const string& node_loc = loc[node->id()];
+      const int64_t local_bytes = bytes_by_loc[node_loc];
+      const Node* best_rep = nullptr;
+      int64_t best_bytes = local_bytes;
+      for (const auto& it : bytes_by_loc) {
+        if (it.first == node_loc) continue;
+        // Strict improvement only; ties keep the requested placement.
+        if (it.second > best_bytes) {
+          best_bytes = it.second;
+          best_rep = rep_by_loc[it.first];
+        }
+      }
+      if (best_rep == nullptr) continue;
+
+      // When the move crosses device types, the node must have a kernel
+      // on the target type.
+      DeviceNameUtils::ParsedName src_device, dst_device;
+      if (!DeviceNameUtils::ParseFullName(node->assigned_device_name(),
+                                          &src_device) ||
+          !DeviceNameUtils::ParseFullName(best_rep->assigned_device_name(),
+                                          &dst_device)) {
+        continue;
+      }
+      if (src_device.type != dst_device.type &&
+          !KernelDefAvailable(DeviceType(dst_device.type), node->def())) {
+        continue;
+      }
+
+      node->set_assigned_device_name(best_rep->assigned_device_name());
+      loc[node->id()] = loc[best_rep->id()];
+      ++moved_nodes;
+      saved_bytes += best_bytes - local_bytes;
+      changed = true;
+    }
+    if (!changed) break;
+  }
+
+  VLOG(1) << "Min-cut partition refinement moved " << moved_nodes
+          << " nodes, reducing estimated cross-partition transfers by "
+          << saved_bytes << " bytes";
+}
+
 struct PriorityTopoSortNode {
   PriorityTopoSortNode(const NodeDef* n, int64_t st)
       : node(n), start_time(st) {}
@@ -975,6 +1127,14 @@ Status Partition(const PartitionOptions& opts, Graph* g,
       debug_info_builders;
   partitions->clear();
 
+  // Optionally refine the device assignments to minimize the volume of the
+  // cut before any Send/Recv pairs are materialized. This must happen
+  // before the control flow code is added, since that code is keyed off
+  // the final cross-device edges.
+  if (opts.minimize_cross_device_transfers || MinCutRefinementEnabled()) {
+    RefineBoundaryPlacement(opts, g);
+  }
+
   GraphInfo g_info;
   if (!opts.control_flow_added) {
     // Add the "code" for distributed execution of control flow. Code is
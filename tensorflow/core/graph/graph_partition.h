@@ -80,6 +80,15 @@ struct PartitionOptions {
   // Optional customized function to compute the "tensor_name" attr value of
   // Send/Recv ops inserted during partitioning.
   std::function<string(const Edge*)> get_tensor_name_attr = nullptr;
+
+  // If true, treat the assigned devices as soft constraints and run a
+  // communication-minimizing refinement before inserting Send/Recv pairs:
+  // stateless boundary nodes are relocated to a neighboring partition
+  // whenever that strictly reduces the estimated number of bytes crossing
+  // partitions. Edge weights are derived from inferred shapes where
+  // available. Can also be enabled for all callers with the
+  // TF_GRAPH_PARTITION_MIN_CUT environment variable.
+  bool minimize_cross_device_transfers = false;
 };
 
 // Partition "input" graph into a set of graphs, one per location.
@@ -291,6 +291,43 @@ TEST_F(GraphPartitionTest, CrossDeviceData) {
   ExpectMatchB();
 }
 
+TEST_F(GraphPartitionTest, MinCutRefinementRelocatesBoundaryNode) {
+  // B1 exchanges three tensors with cpu:0 and none with cpu:1, so with the
+  // min-cut refinement enabled it should be relocated to cpu:0, leaving
+  // nothing to send or receive.
+  auto a1 = FloatInput(in_.WithOpName("A1"));
+  auto a2 = FloatInput(in_.WithOpName("A2"));
+  auto b1 = Combine(in_.WithOpName("B1"), a1, a2);
+  Combine(in_.WithOpName("A3"), b1, a1);
+
+  Graph g(OpRegistry::Global());
+  GraphConstructorOptions gopts;
+  TF_CHECK_OK(ConvertGraphDefToGraph(gopts, ToGraphDef(), &g));
+  for (Node* node : g.nodes()) {
+    node->set_assigned_device_name(DeviceName(node));
+  }
+
+  PartitionOptions popts;
+  popts.node_to_loc = SplitByDevice;
+  popts.new_name = [&g](const string& prefix) { return g.NewName(prefix); };
+  popts.get_incarnation = [](const string& name) {
+    return (name[0] - 'A') + 100;
+  };
+  popts.minimize_cross_device_transfers = true;
+  std::unordered_map<string, GraphDef> partitions;
+  TF_EXPECT_OK(Partition(popts, &g, &partitions));
+
+  string a = "/job:a/replica:0/task:0/cpu:0";
+  EXPECT_EQ(1, partitions.size());
+  EXPECT_EQ(4, partitions[a].node_size());
+  for (const auto& kv : partitions) {
+    for (const NodeDef& ndef : kv.second.node()) {
+      EXPECT_NE(ndef.op(), "_Send");
+      EXPECT_NE(ndef.op(), "_Recv");
+    }
+  }
+}
+
 TEST_F(GraphPartitionTest, CrossDeviceControl) {
   auto a1 = FloatInput(in_.WithOpName("A1"));
   auto b1 = FloatInput(in_.WithOpName("B1"));
@@ -54,6 +54,7 @@ limitations under the License.
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
+#include "tensorflow/core/util/bcast.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 #include "tensorflow/core/util/strided_slice_op.h"
@@ -1873,6 +1874,72 @@ class RemoveIdempotentStage : public ArithmeticOptimizerStage {
   }
 };
 
+// Bypass the second SparseReorder in
+//
+//   SparseReorder(SparseReorder(indices, values, shape), shape)
+//
+// The first SparseReorder already emits indices and values in canonical
+// row-major order, so the second is an identity on both of its outputs. This
+// cannot reuse RemoveIdempotentStage because SparseReorder has two outputs
+// that must be forwarded pairwise.
+class RemoveRedundantSparseReorderStage : public ArithmeticOptimizerStage {
+ public:
+  explicit RemoveRedundantSparseReorderStage(
+      const GraphOptimizerContext& ctx,
+      const ArithmeticOptimizerContext& ctx_ext)
+      : ArithmeticOptimizerStage("RemoveRedundantSparseReorder", ctx,
+                                 ctx_ext) {}
+  ~RemoveRedundantSparseReorderStage() override = default;
+
+  bool IsSupported(const NodeDef* node) const override {
+    return node->op() == "SparseReorder" && !IsInPreserveSet(*node) &&
+           !HasControlInputs(*node);
+  }
+
+  Status TrySimplify(NodeDef* node, string* simplified_node_name) override {
+    const TensorId indices_input = ParseTensorName(node->input(0));
+    const TensorId values_input = ParseTensorName(node->input(1));
+    // The producer's outputs must feed this node as a pair; otherwise the
+    // indices and values seen here could have been reordered inconsistently.
+    if (indices_input.index() != 0 || values_input.index() != 1 ||
+        indices_input.node() != values_input.node()) {
+      return OkStatus();
+    }
+    NodeDef* producer;
+    TF_RETURN_IF_ERROR(GetInputNode(node->input(0), &producer));
+    if (producer->op() != node->op() || producer->device() != node->device()) {
+      return OkStatus();
+    }
+
+    // Forward each output of `node` to the corresponding output of the
+    // producer. The bypassed node is pruned later if it becomes dead.
+    const std::vector<NodeDef*> consumers =
+        ctx().node_map->GetOutputsOrderedByNodeName(node->name());
+    for (NodeDef* consumer : consumers) {
+      bool updated = false;
+      for (int i = 0; i < consumer->input_size(); ++i) {
+        const TensorId input_tensor = ParseTensorName(consumer->input(i));
+        if (input_tensor.node() != node->name()) continue;
+        if (input_tensor.index() < 0) {
+          // `node` has no control inputs of its own, so a control dependency
+          // on it reduces to one on the producer.
+          consumer->set_input(i, AsControlDependency(producer->name()));
+        } else if (input_tensor.index() <= 1) {
+          consumer->set_input(i, node->input(input_tensor.index()));
+        } else {
+          continue;
+        }
+        ctx().node_map->UpdateInput(consumer->name(), node->name(),
+                                    consumer->input(i));
+        updated = true;
+      }
+      if (updated) AddToOptimizationQueue(consumer);
+    }
+    *simplified_node_name = node->name();
+    return OkStatus();
+  }
+};
+
 // Performs the conversion:
 // Div(x, Sqrt(y)) => Mul(x, Rsqrt(y))
 // TODO(srjoglekar): Generalize to optimize cases like (x / pow(y, z)).
@@ -2081,6 +2148,82 @@ class RemoveRedundantReshapeOrBroadcastTo : public ArithmeticOptimizerStage {
   }
 };
 
+// Bypass Tile and BroadcastTo nodes feeding element-wise binary ops that
+// support broadcasting:
+//
+//   input -> Tile/BroadcastTo -> Mul    becomes    input -> Mul
+//
+// The binary op broadcasts the small input itself, so the materialized
+// intermediate is never written to memory. The rewrite only fires when all
+// shapes involved are statically known and feeding the un-materialized input
+// provably yields the same output shape, i.e. the Tile/BroadcastTo only
+// expands dimensions of size one.
+class RemoveMaterializedBroadcastStage : public ArithmeticOptimizerStage {
+ public:
+  explicit RemoveMaterializedBroadcastStage(
+      const GraphOptimizerContext& ctx,
+      const ArithmeticOptimizerContext& ctx_ext)
+      : ArithmeticOptimizerStage("RemoveMaterializedBroadcast", ctx, ctx_ext) {}
+  ~RemoveMaterializedBroadcastStage() override = default;
+
+  bool IsSupported(const NodeDef* node) const override {
+    static const auto* broadcasting_ops = new absl::flat_hash_set<string>(
+        {"Add", "AddV2", "Sub", "Mul", "MulNoNan", "Div", "DivNoNan",
+         "RealDiv", "FloorDiv", "FloorMod", "Mod", "Pow", "Maximum", "Minimum",
+         "SquaredDifference", "Equal", "NotEqual", "Less", "LessEqual",
+         "Greater", "GreaterEqual", "LogicalAnd", "LogicalOr"});
+    return broadcasting_ops->contains(node->op());
+  }
+
+  Status TrySimplify(NodeDef* node, string* simplified_node_name) override {
+    if (IsInPreserveSet(*node)) return OkStatus();
+    for (int i = 0; i < 2; ++i) {
+      NodeDef* input;
+      TF_RETURN_IF_ERROR(GetInputNode(node->input(i), &input));
+      if (!IsTile(*input) && !IsBroadcastTo(*input)) continue;
+      if (ModifiesFrameInfo(*input)) continue;
+      if (!BypassIsSafe(*node, *input, i)) continue;
+      ctx().node_map->UpdateInput(node->name(), node->input(i),
+                                  input->input(0));
+      node->set_input(i, input->input(0));
+      ForwardControlDependencies(node, {input});
+      AddToOptimizationQueue(node);
+      *simplified_node_name = node->name();
+      return OkStatus();
+    }
+    return OkStatus();
+  }
+
+ private:
+  // Returns true if feeding `input`'s (un-materialized) input to port `i` of
+  // the binary op `node` yields the same output shape as the materialized
+  // tensor does.
+  bool BypassIsSafe(const NodeDef& node, const NodeDef& input, int i) {
+    BCast::Vec small_shape, materialized_shape, other_shape;
+    if (!GetKnownShape(input.input(0), &small_shape) ||
+        !GetKnownShape(node.input(i), &materialized_shape) ||
+        !GetKnownShape(node.input(1 - i), &other_shape)) {
+      return false;
+    }
+    BCast old_bcast(materialized_shape, other_shape);
+    BCast new_bcast(small_shape, other_shape);
+    return old_bcast.IsValid() && new_bcast.IsValid() &&
+           new_bcast.output_shape() == old_bcast.output_shape();
+  }
+
+  bool GetKnownShape(const string& tensor, BCast::Vec* dims) {
+    const OpInfo::TensorProperties* props;
+    if (!GetTensorProperties(tensor, &props).ok()) return false;
+    const TensorShapeProto& shape = props->shape();
+    if (shape.unknown_rank()) return false;
+    for (const auto& dim : shape.dim()) {
+      if (dim.size() < 0) return false;
+      dims->push_back(dim.size());
+    }
+    return true;
+  }
+};
+
 // Reorder casting and value-preserving ops if beneficial.
 //
 // Original motivation: A common pattern after the layout optimizer is
@@ -4334,6 +4477,10 @@ Status ArithmeticOptimizer::SimplifyArithmeticOps(bool can_use_shapes) {
     pipeline.AddStage<ReduceUpsamplingDims>(ctx, ctx_ext);
   if (options_.remove_redundant_reshape && can_use_shapes)
     pipeline.AddStage<RemoveRedundantReshapeOrBroadcastTo>(ctx, ctx_ext);
+  if (options_.remove_materialized_broadcast && can_use_shapes)
+    pipeline.AddStage<RemoveMaterializedBroadcastStage>(ctx, ctx_ext);
+  if (options_.remove_redundant_sparse_reorder)
+    pipeline.AddStage<RemoveRedundantSparseReorderStage>(ctx, ctx_ext);
   if (options_.remove_negation)
     pipeline.AddStage<RemoveNegationStage>(ctx, ctx_ext);
   if (options_.replace_mul_with_square)
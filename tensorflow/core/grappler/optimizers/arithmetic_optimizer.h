@@ -70,10 +70,12 @@ class ArithmeticOptimizer : public GraphOptimizer {
     bool remove_identity_transpose = true;
     bool remove_involution = true;
     bool remove_logical_not = true;
+    bool remove_materialized_broadcast = true;
     bool remove_negation = true;
     bool remove_redundant_bitcast = true;
     bool remove_redundant_cast = true;
     bool remove_redundant_reshape = true;
+    bool remove_redundant_sparse_reorder = true;
     bool reduce_upsampling_dims = true;
     bool reorder_cast_like_and_value_preserving = true;
     bool replace_mul_with_tile = true;
@@ -217,6 +217,108 @@ TEST_F(ArithmeticOptimizerTest, ReplaceMulWithBroadcastByTileNoBroadcast) {
   test::ExpectTensorNear<float>(result[0], expected[0], 1e-6);
 }
 
+TEST_F(ArithmeticOptimizerTest, RemoveMaterializedBroadcastTile) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                  ops::Placeholder::Shape({1, 4}));
+  Output multiples = ops::Const(s.WithOpName("multiples"), {8, 1}, {2});
+  Output tile = ops::Tile(s.WithOpName("tile"), input, multiples);
+  Output other = ops::Const(s.WithOpName("other"), 2.0f, {8, 4});
+  Output mul = ops::Mul(s.WithOpName("mul"), tile, other);
+  Output output = ops::Identity(s.WithOpName("output"), mul);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  auto tensor = GenerateRandomTensor<DT_FLOAT>(TensorShape({1, 4}));
+  auto expected = EvaluateNodes(item.graph, item.fetch, {{"input", tensor}});
+  ASSERT_EQ(expected.size(), 1);
+
+  GraphDef g;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyRemoveMaterializedBroadcast(&optimizer);
+  OptimizeTwiceAndPrune(&optimizer, &item, &g);
+
+  // The Tile is bypassed and pruned; Mul broadcasts the small input itself.
+  EXPECT_EQ(CountOpNodes(g, "Tile"), 0);
+  NodeMap node_map(&g);
+  const NodeDef* mul_node = node_map.GetNode("mul");
+  ASSERT_NE(mul_node, nullptr);
+  EXPECT_EQ(mul_node->input(0), "input");
+
+  auto result = EvaluateNodes(g, item.fetch, {{"input", tensor}});
+  ASSERT_EQ(result.size(), 1);
+  test::ExpectTensorNear<float>(result[0], expected[0], 1e-6);
+}
+
+TEST_F(ArithmeticOptimizerTest, RemoveMaterializedBroadcastBroadcastTo) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                  ops::Placeholder::Shape({4}));
+  Output shape = ops::Const(s.WithOpName("shape"), {8, 4}, {2});
+  Output bcast = ops::BroadcastTo(s.WithOpName("bcast"), input, shape);
+  Output other = ops::Placeholder(s.WithOpName("other"), DT_FLOAT,
+                                  ops::Placeholder::Shape({8, 4}));
+  Output add = ops::Add(s.WithOpName("add"), other, bcast);
+  Output output = ops::Identity(s.WithOpName("output"), add);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  auto tensor = GenerateRandomTensor<DT_FLOAT>(TensorShape({4}));
+  auto other_tensor = GenerateRandomTensor<DT_FLOAT>(TensorShape({8, 4}));
+  auto expected = EvaluateNodes(item.graph, item.fetch,
+                                {{"input", tensor}, {"other", other_tensor}});
+  ASSERT_EQ(expected.size(), 1);
+
+  GraphDef g;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyRemoveMaterializedBroadcast(&optimizer);
+  OptimizeTwiceAndPrune(&optimizer, &item, &g);
+
+  EXPECT_EQ(CountOpNodes(g, "BroadcastTo"), 0);
+  NodeMap node_map(&g);
+  const NodeDef* add_node = node_map.GetNode("add");
+  ASSERT_NE(add_node, nullptr);
+  EXPECT_EQ(add_node->input(1), "input");
+
+  auto result = EvaluateNodes(g, item.fetch,
+                              {{"input", tensor}, {"other", other_tensor}});
+  ASSERT_EQ(result.size(), 1);
+  test::ExpectTensorNear<float>(result[0], expected[0], 1e-6);
+}
+
+TEST_F(ArithmeticOptimizerTest, RemoveMaterializedBroadcastNotABroadcast) {
+  // Tiling a dimension that is not of size one is not expressible as a
+  // broadcast, so the Tile must stay.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output input = ops::Placeholder(s.WithOpName("input"), DT_FLOAT,
+                                  ops::Placeholder::Shape({2, 4}));
+  Output multiples = ops::Const(s.WithOpName("multiples"), {2, 1}, {2});
+  Output tile = ops::Tile(s.WithOpName("tile"), input, multiples);
+  Output other = ops::Const(s.WithOpName("other"), 2.0f, {4, 4});
+  Output mul = ops::Mul(s.WithOpName("mul"), tile, other);
+  Output output = ops::Identity(s.WithOpName("output"), mul);
+
+  GrapplerItem item;
+  item.fetch = {"output"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  auto tensor = GenerateRandomTensor<DT_FLOAT>(TensorShape({2, 4}));
+  auto expected = EvaluateNodes(item.graph, item.fetch, {{"input", tensor}});
+  ASSERT_EQ(expected.size(), 1);
+
+  GraphDef g;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyRemoveMaterializedBroadcast(&optimizer);
+  OptimizeTwiceAndPrune(&optimizer, &item, &g);
+
+  EXPECT_EQ(CountOpNodes(g, "Tile"), 1);
+
+  auto result = EvaluateNodes(g, item.fetch, {{"input", tensor}});
+  ASSERT_EQ(result.size(), 1);
+  test::ExpectTensorNear<float>(result[0], expected[0], 1e-6);
+}
+
 TEST_F(ArithmeticOptimizerTest, ReplaceMulWithBroadcastByTileNotConst) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   Output input1 = ops::Placeholder(s.WithOpName("input1"), DT_FLOAT,
@@ -3835,6 +3937,87 @@ TEST_F(ArithmeticOptimizerTest, RemoveIdempotent) {
   }
 }
 
+TEST_F(ArithmeticOptimizerTest, RemoveRedundantSparseReorder) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Tensor indices_t(DT_INT64, TensorShape({3, 2}));
+  test::FillValues<int64_t>(&indices_t, {1, 1, 0, 1, 1, 0});
+  Output indices = ops::Const(s.WithOpName("indices"),
+                              Input::Initializer(indices_t));
+  Output values = ops::Const(s.WithOpName("values"), {1.0f, 2.0f, 3.0f}, {3});
+  Tensor shape_t(DT_INT64, TensorShape({2}));
+  test::FillValues<int64_t>(&shape_t, {2, 2});
+  Output shape = ops::Const(s.WithOpName("shape"), Input::Initializer(shape_t));
+  auto reorder1 = ops::SparseReorder(s.WithOpName("reorder1"), indices, values,
+                                     shape);
+  auto reorder2 =
+      ops::SparseReorder(s.WithOpName("reorder2"), reorder1.output_indices,
+                         reorder1.output_values, shape);
+  Output out_indices =
+      ops::Identity(s.WithOpName("out_indices"), reorder2.output_indices);
+  Output out_values =
+      ops::Identity(s.WithOpName("out_values"), reorder2.output_values);
+  GrapplerItem item;
+  item.fetch = {"out_indices", "out_values"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch);
+  ASSERT_EQ(tensors_expected.size(), 2);
+
+  GraphDef output;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyRemoveRedundantSparseReorder(&optimizer);
+  OptimizeAndPrune(&optimizer, &item, &output);
+
+  EXPECT_EQ(CountOpNodes(output, "SparseReorder"), 1);
+  int found = 0;
+  for (const NodeDef& node : output.node()) {
+    if (node.name() == "out_indices") {
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "reorder1");
+      found++;
+    } else if (node.name() == "out_values") {
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "reorder1:1");
+      found++;
+    }
+  }
+  EXPECT_EQ(found, 2);
+
+  auto tensors = EvaluateNodes(output, item.fetch);
+  ASSERT_EQ(tensors.size(), 2);
+  test::ExpectTensorEqual<int64_t>(tensors[0], tensors_expected[0]);
+  test::ExpectTensorEqual<float>(tensors[1], tensors_expected[1]);
+}
+
+TEST_F(ArithmeticOptimizerTest, RemoveRedundantSparseReorderUnpairedInputs) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Tensor indices_t(DT_INT64, TensorShape({3, 2}));
+  test::FillValues<int64_t>(&indices_t, {1, 1, 0, 1, 1, 0});
+  Output indices = ops::Const(s.WithOpName("indices"),
+                              Input::Initializer(indices_t));
+  Output values = ops::Const(s.WithOpName("values"), {1.0f, 2.0f, 3.0f}, {3});
+  Tensor shape_t(DT_INT64, TensorShape({2}));
+  test::FillValues<int64_t>(&shape_t, {2, 2});
+  Output shape = ops::Const(s.WithOpName("shape"), Input::Initializer(shape_t));
+  auto reorder1 = ops::SparseReorder(s.WithOpName("reorder1"), indices, values,
+                                     shape);
+  // The values do not come from reorder1, so reorder2 must be kept.
+  auto reorder2 = ops::SparseReorder(s.WithOpName("reorder2"),
+                                     reorder1.output_indices, values, shape);
+  Output out_values =
+      ops::Identity(s.WithOpName("out_values"), reorder2.output_values);
+  GrapplerItem item;
+  item.fetch = {"out_values"};
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+  GraphDef output;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyRemoveRedundantSparseReorder(&optimizer);
+  OptimizeAndPrune(&optimizer, &item, &output);
+
+  EXPECT_EQ(CountOpNodes(output, "SparseReorder"), 2);
+}
+
 TEST_F(ArithmeticOptimizerTest, RemoveLogicalNot) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   Output a = ops::Const(s.WithOpName("a"), 3.14f, {32});
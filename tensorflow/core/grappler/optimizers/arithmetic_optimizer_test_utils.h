@@ -143,11 +143,21 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     optimizer->options_.reduce_upsampling_dims = true;
   }
 
+  void EnableOnlyRemoveRedundantSparseReorder(ArithmeticOptimizer* optimizer) {
+    DisableAllStages(optimizer);
+    optimizer->options_.remove_redundant_sparse_reorder = true;
+  }
+
   void EnableOnlyRemoveRedundantReshape(ArithmeticOptimizer* optimizer) {
     DisableAllStages(optimizer);
     optimizer->options_.remove_redundant_reshape = true;
   }
 
+  void EnableOnlyRemoveMaterializedBroadcast(ArithmeticOptimizer* optimizer) {
+    DisableAllStages(optimizer);
+    optimizer->options_.remove_materialized_broadcast = true;
+  }
+
   void EnableOnlyRemoveNegation(ArithmeticOptimizer* optimizer) {
     DisableAllStages(optimizer);
     optimizer->options_.remove_negation = true;
@@ -270,6 +280,8 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     options.remove_redundant_bitcast = false;
     options.remove_redundant_cast = false;
     options.remove_redundant_reshape = false;
+    options.remove_redundant_sparse_reorder = false;
+    options.remove_materialized_broadcast = false;
     options.remove_negation = false;
     options.remove_logical_not = false;
     options.reorder_cast_like_and_value_preserving = false;
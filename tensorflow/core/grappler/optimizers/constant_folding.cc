@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/constant_folding.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "absl/status/status.h"
@@ -25,6 +26,7 @@ limitations under the License.
 #include "absl/strings/substitute.h"
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/function.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/node_def_util.h"
@@ -47,15 +49,18 @@ limitations under the License.
 #include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/lib/strings/numbers.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/denormal.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/setround.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/bcast.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/overflow.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 
@@ -1341,6 +1346,74 @@ Status ConstantFolding::EvaluateNode(const NodeDef& node,
                                               resource_mgr_.get(), output);
 }
 
+namespace {
+
+// Process-wide cache of folded node results, keyed by a fingerprint of the
+// node's op, attrs and constant input values.  Pipelines that repeatedly
+// load near-identical graphs re-fold the same constant subgraphs on every
+// load; a cache hit replaces the kernel evaluation in EvaluateOneFoldable
+// with a hash lookup.  Entries hold the folded Const NodeDefs with their
+// name cleared, since the name is the only node-specific part; it is filled
+// back in on every hit.
+class FoldedSubgraphCache {
+ public:
+  static FoldedSubgraphCache* Global() {
+    static FoldedSubgraphCache* cache = new FoldedSubgraphCache;
+    return cache;
+  }
+
+  bool Lookup(uint64 fingerprint, std::vector<NodeDef>* outputs) {
+    mutex_lock l(mu_);
+    auto it = cache_.find(fingerprint);
+    if (it == cache_.end()) return false;
+    *outputs = it->second;
+    return true;
+  }
+
+  void Insert(uint64 fingerprint, std::vector<NodeDef> outputs) {
+    mutex_lock l(mu_);
+    // Bound the number of entries instead of evicting; individual folded
+    // constants are already capped at kMaxConstantSize.
+    if (cache_.size() >= kMaxEntries) return;
+    cache_.emplace(fingerprint, std::move(outputs));
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 4096;
+
+  mutex mu_;
+  absl::flat_hash_map<uint64, std::vector<NodeDef>> cache_ TF_GUARDED_BY(mu_);
+};
+
+bool FoldedSubgraphCacheEnabled() {
+  static bool enabled = [] {
+    bool disabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_GRAPPLER_DISABLE_FOLDED_SUBGRAPH_CACHE",
+                                   /*default_val=*/false, &disabled));
+    return !disabled;
+  }();
+  return enabled;
+}
+
+// Returns a stable fingerprint of the parts of `node` that determine the
+// value it folds to, other than its inputs: the op and all attrs.
+uint64 NodeValueFingerprint(const NodeDef& node) {
+  uint64 h = Hash64(node.op());
+  std::vector<absl::string_view> attr_names;
+  attr_names.reserve(node.attr().size());
+  for (const auto& attr : node.attr()) {
+    attr_names.push_back(attr.first);
+  }
+  std::sort(attr_names.begin(), attr_names.end());
+  for (const auto& attr_name : attr_names) {
+    h = Hash64Combine(h, Hash64(attr_name.data(), attr_name.size()));
+    h = Hash64Combine(h, AttrValueHash(node.attr().at(attr_name)));
+  }
+  return h;
+}
+
+}  // namespace
+
 Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
                                             std::vector<NodeDef>* outputs,
                                             bool* result_too_large) {
@@ -1357,6 +1430,7 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     }
   });
 
+  uint64 fingerprint = NodeValueFingerprint(node);
   size_t total_inputs_size = 0;
   for (const auto& input : node.input()) {
     const TensorId input_tensor = ParseTensorName(input);
@@ -1393,6 +1467,24 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
     }
     inputs.emplace_back(value);
     total_inputs_size += value->TotalBytes();
+    fingerprint = Hash64Combine(
+        fingerprint, AttrValueHash(input_node->attr().at("value")));
+  }
+  fingerprint = Hash64Combine(fingerprint, inputs.size());
+
+  if (FoldedSubgraphCacheEnabled() &&
+      FoldedSubgraphCache::Global()->Lookup(fingerprint, outputs)) {
+    // Restore the node-specific names on the cached results.  Empty NodeDefs
+    // identifying dead outputs are kept as is.
+    for (size_t i = 0; i < outputs->size(); ++i) {
+      if (outputs->at(i).op().empty()) continue;
+      string node_name = OptimizedNodeName(node, "-folded");
+      if (outputs->size() > 1) {
+        node_name = strings::StrCat(node_name, "-", i);
+      }
+      outputs->at(i).set_name(node_name);
+    }
+    return OkStatus();
   }
 
   TF_RETURN_IF_ERROR(EvaluateNode(node, inputs, &output_tensors));
@@ -1420,6 +1512,13 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
       outputs->at(i) = NodeDef();
     }
   }
+  if (FoldedSubgraphCacheEnabled()) {
+    std::vector<NodeDef> cached = *outputs;
+    for (NodeDef& cached_node : cached) {
+      cached_node.clear_name();
+    }
+    FoldedSubgraphCache::Global()->Insert(fingerprint, std::move(cached));
+  }
   return OkStatus();
 }
 
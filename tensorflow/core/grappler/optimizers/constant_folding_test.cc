@@ -313,6 +313,37 @@ TEST_F(ConstantFoldingTest, SimpleFolding) {
   test::ExpectTensorEqual<float>(tensors_expected[0], tensors[0]);
 }
 
+TEST_F(ConstantFoldingTest, FoldedSubgraphCacheReusedAcrossInstances) {
+  // Fold the same constant expression twice under different node names with
+  // separate optimizer instances.  The second run is served from the
+  // process-wide folded-subgraph cache, which must restore the names of the
+  // second graph and preserve the folded values.
+  for (const string& prefix : {"first", "second"}) {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output a = ops::Const(s.WithOpName(prefix + "_a"), 3.0f, {2});
+    Output b = ops::Const(s.WithOpName(prefix + "_b"), 4.0f, {2});
+    Output c = ops::Mul(s.WithOpName(prefix + "_c"), a, b);
+
+    GrapplerItem item;
+    item.fetch.push_back(prefix + "_c");
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+
+    ConstantFolding optimizer(/*cpu_device=*/nullptr);
+    GraphDef output;
+    TF_EXPECT_OK(optimizer.Optimize(/*cluster=*/nullptr, item, &output));
+
+    EXPECT_EQ(1, output.node_size());
+    const NodeDef& folded = output.node(0);
+    EXPECT_EQ(prefix + "_c", folded.name());
+    EXPECT_EQ("Const", folded.op());
+
+    auto tensors = EvaluateNodes(output, item.fetch);
+    ASSERT_EQ(1, tensors.size());
+    test::ExpectTensorEqual<float>(test::AsTensor<float>({12.0f, 12.0f}),
+                                   tensors[0]);
+  }
+}
+
 TEST_F(ConstantFoldingTest, AddTree) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
 
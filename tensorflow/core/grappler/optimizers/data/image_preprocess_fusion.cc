@@ -0,0 +1,265 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/image_preprocess_fusion.h"
+
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kFusedOpName[] = "ImagePreprocess";
+
+// Returns true if `node` produces exactly one value consumed by exactly one
+// node and has no control dependencies in either direction, so it can be
+// folded away without observable effect.
+bool HasSingleConsumerNoControl(const NodeDef& node,
+                                const MutableGraphView& graph) {
+  for (const string& input : node.input()) {
+    if (IsControlInput(input)) return false;
+  }
+  return graph.GetFanouts(node, /*include_controlled_nodes=*/true).size() == 1;
+}
+
+// Reads the value of a Const node into `tensor`. Returns false if the node is
+// not a Const or its value attribute cannot be parsed.
+bool ReadConstTensor(const NodeDef& node, Tensor* tensor) {
+  if (!IsConstant(node)) return false;
+  auto it = node.attr().find("value");
+  if (it == node.attr().end()) return false;
+  return tensor->FromProto(it->second.tensor());
+}
+
+// A float Const suitable as the `mean` or `scale` input: scalar or rank-1.
+bool IsScalarOrVectorFloatConst(const NodeDef& node) {
+  Tensor t;
+  return ReadConstTensor(node, &t) && t.dtype() == DT_FLOAT && t.dims() <= 1;
+}
+
+// Adds a Const node holding `value`; graph_utils only provides scalar const
+// helpers.
+NodeDef* AddTensorConstNode(const Tensor& value, MutableGraphView* graph) {
+  NodeDef node;
+  node.set_op("Const");
+  graph_utils::SetUniqueGraphNodeName("Const", graph->graph(), &node);
+  (*node.mutable_attr())["dtype"].set_type(value.dtype());
+  value.AsProtoTensorContent(
+      (*node.mutable_attr())["value"].mutable_tensor());
+  return graph->AddNode(std::move(node));
+}
+
+// Describes a matched ResizeBilinear -> [Pad] -> Sub -> Mul/RealDiv chain.
+struct MatchedChain {
+  NodeDef* resize_node;
+  NodeDef* pad_node;  // nullptr if the chain has no Pad.
+  NodeDef* sub_node;
+  NodeDef* normalize_node;  // The Mul or RealDiv terminating the chain.
+  NodeDef* mean_node;
+  NodeDef* scale_or_std_node;
+  bool scale_is_divisor;  // True for RealDiv; the constant holds the std.
+};
+
+// Attempts to match the preprocessing chain ending at `node`. The
+// intermediate nodes must have single consumers so the rewrite cannot change
+// any other observable value.
+bool MatchChain(NodeDef* node, MutableGraphView* graph, MatchedChain* chain) {
+  if (node->op() != "Mul" && node->op() != "RealDiv") return false;
+  if (node->attr().count("T") == 0 ||
+      node->attr().at("T").type() != DT_FLOAT) {
+    return false;
+  }
+
+  // Identify the constant operand of the normalization and the Sub feeding
+  // it. For RealDiv only the divisor position is allowed.
+  NodeDef* input0 = graph_utils::GetInputNode(*node, *graph, 0);
+  NodeDef* input1 = graph_utils::GetInputNode(*node, *graph, 1);
+  if (input0 == nullptr || input1 == nullptr) return false;
+  NodeDef* sub_node = nullptr;
+  NodeDef* scale_node = nullptr;
+  if (IsSub(*input0) && IsScalarOrVectorFloatConst(*input1)) {
+    sub_node = input0;
+    scale_node = input1;
+  } else if (node->op() == "Mul" && IsSub(*input1) &&
+             IsScalarOrVectorFloatConst(*input0)) {
+    sub_node = input1;
+    scale_node = input0;
+  } else {
+    return false;
+  }
+  if (!HasSingleConsumerNoControl(*sub_node, *graph)) return false;
+
+  NodeDef* mean_node = graph_utils::GetInputNode(*sub_node, *graph, 1);
+  if (mean_node == nullptr || !IsScalarOrVectorFloatConst(*mean_node)) {
+    return false;
+  }
+
+  NodeDef* inner = graph_utils::GetInputNode(*sub_node, *graph, 0);
+  if (inner == nullptr) return false;
+  NodeDef* pad_node = nullptr;
+  if (inner->op() == "Pad") {
+    // Only a Pad whose paddings constant touches the spatial dimensions of a
+    // 4-D NHWC tensor can be folded into the fused op.
+    if (!HasSingleConsumerNoControl(*inner, *graph)) return false;
+    NodeDef* paddings_node = graph_utils::GetInputNode(*inner, *graph, 1);
+    Tensor paddings;
+    if (paddings_node == nullptr ||
+        !ReadConstTensor(*paddings_node, &paddings) ||
+        paddings.dtype() != DT_INT32 || paddings.dims() != 2 ||
+        paddings.dim_size(0) != 4 || paddings.dim_size(1) != 2) {
+      return false;
+    }
+    auto paddings_mat = paddings.matrix<int32>();
+    if (paddings_mat(0, 0) != 0 || paddings_mat(0, 1) != 0 ||
+        paddings_mat(3, 0) != 0 || paddings_mat(3, 1) != 0) {
+      return false;
+    }
+    pad_node = inner;
+    inner = graph_utils::GetInputNode(*inner, *graph, 0);
+    if (inner == nullptr) return false;
+  }
+
+  if (inner->op() != "ResizeBilinear" ||
+      !HasSingleConsumerNoControl(*inner, *graph)) {
+    return false;
+  }
+  // ImagePreprocess interpolates in float; matching ResizeBilinear's float
+  // output exactly for all input types requires a float compute path either
+  // way, so any input T accepted by ResizeBilinear is fine.
+
+  chain->resize_node = inner;
+  chain->pad_node = pad_node;
+  chain->sub_node = sub_node;
+  chain->normalize_node = node;
+  chain->mean_node = mean_node;
+  chain->scale_or_std_node = scale_node;
+  chain->scale_is_divisor = node->op() == "RealDiv";
+  return true;
+}
+
+}  // namespace
+
+Status ImagePreprocessFusion::OptimizeAndCollectStats(Cluster* cluster,
+                                                      const GrapplerItem& item,
+                                                      GraphDef* output,
+                                                      OptimizationStats* stats) {
+  *output = item.graph;
+  MutableGraphView graph(output);
+  absl::flat_hash_set<string> nodes_to_delete;
+
+  // Collect candidates first: the rewrite adds nodes, which would invalidate
+  // iteration over the node list.
+  std::vector<NodeDef*> candidates;
+  for (NodeDef& node : *output->mutable_node()) {
+    candidates.push_back(&node);
+  }
+
+  for (NodeDef* node : candidates) {
+    if (nodes_to_delete.contains(node->name())) continue;
+    MatchedChain chain;
+    if (!MatchChain(node, &graph, &chain)) continue;
+
+    // The `scale` input multiplies; for a RealDiv chain fold the reciprocal
+    // of the std constant into a new Const.
+    NodeDef* scale_node = chain.scale_or_std_node;
+    if (chain.scale_is_divisor) {
+      Tensor std_tensor;
+      if (!ReadConstTensor(*scale_node, &std_tensor)) continue;
+      Tensor reciprocal(DT_FLOAT, std_tensor.shape());
+      auto std_flat = std_tensor.flat<float>();
+      auto reciprocal_flat = reciprocal.flat<float>();
+      bool valid = true;
+      for (int64_t i = 0; i < std_flat.size(); ++i) {
+        if (std_flat(i) == 0.0f) {
+          valid = false;
+          break;
+        }
+        reciprocal_flat(i) = 1.0f / std_flat(i);
+      }
+      if (!valid) continue;
+      scale_node = AddTensorConstNode(reciprocal, &graph);
+    }
+
+    // ImagePreprocess takes spatial-only [2, 2] paddings; extract the height
+    // and width rows of the matched Pad's [4, 2] constant (or use zeros when
+    // there is no Pad in the chain).
+    Tensor spatial_paddings(DT_INT32, {2, 2});
+    spatial_paddings.flat<int32>().setZero();
+    if (chain.pad_node != nullptr) {
+      Tensor paddings;
+      NodeDef* orig_paddings =
+          graph_utils::GetInputNode(*chain.pad_node, graph, 1);
+      if (!ReadConstTensor(*orig_paddings, &paddings)) continue;
+      auto src = paddings.matrix<int32>();
+      auto dst = spatial_paddings.matrix<int32>();
+      for (int i = 0; i < 2; ++i) {
+        dst(0, i) = src(1, i);
+        dst(1, i) = src(2, i);
+      }
+    }
+    NodeDef* paddings_node = AddTensorConstNode(spatial_paddings, &graph);
+
+    NodeDef fused_node;
+    fused_node.set_op(kFusedOpName);
+    graph_utils::SetUniqueGraphNodeName(kFusedOpName, graph.graph(),
+                                        &fused_node);
+    fused_node.add_input(chain.resize_node->input(0));
+    fused_node.add_input(chain.resize_node->input(1));
+    fused_node.add_input(paddings_node->name());
+    fused_node.add_input(chain.mean_node->name());
+    fused_node.add_input(scale_node->name());
+    graph_utils::CopyAttribute("T", *chain.resize_node, &fused_node);
+    graph_utils::CopyAttribute("align_corners", *chain.resize_node,
+                               &fused_node);
+    graph_utils::CopyAttribute("half_pixel_centers", *chain.resize_node,
+                               &fused_node);
+    // The matched Pad fills with zero (in the pre-normalization domain).
+    (*fused_node.mutable_attr())["pad_value"].set_f(0.0f);
+
+    NodeDef* added_node = graph.AddNode(std::move(fused_node));
+    TF_RETURN_IF_ERROR(graph.UpdateFanouts(chain.normalize_node->name(),
+                                           added_node->name()));
+
+    nodes_to_delete.insert(chain.normalize_node->name());
+    nodes_to_delete.insert(chain.sub_node->name());
+    if (chain.pad_node != nullptr) {
+      nodes_to_delete.insert(chain.pad_node->name());
+    }
+    nodes_to_delete.insert(chain.resize_node->name());
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(ImagePreprocessFusion, "image_preprocess_fusion");
+
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,147 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/image_preprocess_fusion.h"
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+NodeDef *AddConstNode(const Tensor &value, MutableGraphView *graph) {
+  std::vector<std::pair<string, AttrValue>> attrs(2);
+  AttrValue dtype_attr;
+  SetAttrValue(value.dtype(), &dtype_attr);
+  attrs[0] = std::make_pair("dtype", dtype_attr);
+  AttrValue value_attr;
+  SetAttrValue(value, &value_attr);
+  attrs[1] = std::make_pair("value", value_attr);
+  return graph_utils::AddNode("", "Const", {}, attrs, graph);
+}
+
+AttrValue TypeAttr(DataType dtype) {
+  AttrValue attr;
+  SetAttrValue(dtype, &attr);
+  return attr;
+}
+
+AttrValue BoolAttr(bool value) {
+  AttrValue attr;
+  SetAttrValue(value, &attr);
+  return attr;
+}
+
+// Builds images -> ResizeBilinear -> [Pad] -> Sub -> Mul -> Identity and
+// returns the name of the Mul node.
+string BuildPreprocessChain(MutableGraphView *graph, bool with_pad) {
+  NodeDef *images = graph_utils::AddNode(
+      "images", "Placeholder", {}, {{"dtype", TypeAttr(DT_FLOAT)}}, graph);
+  NodeDef *size =
+      AddConstNode(test::AsTensor<int32>({224, 224}, TensorShape({2})), graph);
+  NodeDef *resize = graph_utils::AddNode(
+      "resize", "ResizeBilinear", {images->name(), size->name()},
+      {{"T", TypeAttr(DT_FLOAT)},
+       {"align_corners", BoolAttr(false)},
+       {"half_pixel_centers", BoolAttr(true)}},
+      graph);
+
+  NodeDef *inner = resize;
+  if (with_pad) {
+    NodeDef *paddings = AddConstNode(
+        test::AsTensor<int32>({0, 0, 2, 2, 3, 3, 0, 0}, TensorShape({4, 2})),
+        graph);
+    inner = graph_utils::AddNode(
+        "pad", "Pad", {resize->name(), paddings->name()},
+        {{"T", TypeAttr(DT_FLOAT)}, {"Tpaddings", TypeAttr(DT_INT32)}}, graph);
+  }
+
+  NodeDef *mean = AddConstNode(
+      test::AsTensor<float>({127.5f, 127.5f, 127.5f}, TensorShape({3})), graph);
+  NodeDef *sub =
+      graph_utils::AddNode("sub", "Sub", {inner->name(), mean->name()},
+                           {{"T", TypeAttr(DT_FLOAT)}}, graph);
+  NodeDef *scale = AddConstNode(test::AsScalar<float>(1.0f / 127.5f), graph);
+  NodeDef *mul =
+      graph_utils::AddNode("mul", "Mul", {sub->name(), scale->name()},
+                           {{"T", TypeAttr(DT_FLOAT)}}, graph);
+  graph_utils::AddNode("output", "Identity", {mul->name()},
+                       {{"T", TypeAttr(DT_FLOAT)}}, graph);
+  return mul->name();
+}
+
+TEST(ImagePreprocessFusionTest, FusesResizePadNormalize) {
+  GrapplerItem item;
+  MutableGraphView graph(&item.graph);
+  BuildPreprocessChain(&graph, /*with_pad=*/true);
+  item.fetch.push_back("output");
+
+  ImagePreprocessFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsNodeWithOp("ImagePreprocess", output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("ResizeBilinear", output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("Pad", output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("Sub", output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("Mul", output));
+
+  int index = graph_utils::FindGraphNodeWithOp("ImagePreprocess", output);
+  const NodeDef &fused = output.node(index);
+  ASSERT_EQ(fused.input_size(), 5);
+  EXPECT_EQ(fused.input(0), "images");
+  EXPECT_EQ(fused.attr().at("T").type(), DT_FLOAT);
+  EXPECT_TRUE(fused.attr().at("half_pixel_centers").b());
+}
+
+TEST(ImagePreprocessFusionTest, FusesWithoutPad) {
+  GrapplerItem item;
+  MutableGraphView graph(&item.graph);
+  BuildPreprocessChain(&graph, /*with_pad=*/false);
+  item.fetch.push_back("output");
+
+  ImagePreprocessFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsNodeWithOp("ImagePreprocess", output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("ResizeBilinear", output));
+}
+
+TEST(ImagePreprocessFusionTest, IgnoresMultiConsumerIntermediates) {
+  GrapplerItem item;
+  MutableGraphView graph(&item.graph);
+  BuildPreprocessChain(&graph, /*with_pad=*/true);
+  // A second consumer of the resized image makes the fusion unsafe.
+  graph_utils::AddNode("extra", "Identity", {"resize"},
+                       {{"T", TypeAttr(DT_FLOAT)}}, &graph);
+  item.fetch.push_back("output");
+
+  ImagePreprocessFusion optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp("ImagePreprocess", output));
+  EXPECT_TRUE(graph_utils::ContainsNodeWithOp("ResizeBilinear", output));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
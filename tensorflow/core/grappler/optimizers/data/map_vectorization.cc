@@ -0,0 +1,254 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/map_vectorization.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/match.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/lib/gtl/map_util.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kMapDataset[] = "MapDataset";
+constexpr char kBatchDataset[] = "BatchDataset";
+constexpr char kBatchV2Dataset[] = "BatchDatasetV2";
+constexpr char kFunctionAttr[] = "f";
+constexpr char kOutputShapesAttr[] = "output_shapes";
+constexpr char kOutputTypesAttr[] = "output_types";
+
+// Classification of a value inside the map function body. A value is
+// "element-derived" if it is computed from the function arguments (and hence
+// gains a batch dimension when the input is batched), or "scalar" if it is
+// computed purely from scalar constants (and hence is identical with and
+// without batching).
+enum class ValueKind { kElementDerived, kScalar };
+
+// Unary ops that apply independently to every entry of their input, so
+// prepending a batch dimension does not change the per-entry results.
+const absl::flat_hash_set<string>* UnaryElementWiseOps() {
+  static const auto* const ops = new absl::flat_hash_set<string>{
+      "Abs",      "Acos",  "Asin",    "Atan",       "Cast",     "Ceil",
+      "Cos",      "Cosh",  "Elu",     "Erf",        "Exp",      "Expm1",
+      "Floor",    "Log",   "Log1p",   "Neg",        "Identity", "Reciprocal",
+      "Relu",     "Relu6", "Rint",    "Round",      "Rsqrt",    "Selu",
+      "Sigmoid",  "Sign",  "Sin",     "Sinh",       "Softplus", "Softsign",
+      "Sqrt",     "Square", "Tan",    "Tanh",
+  };
+  return ops;
+}
+
+// Binary ops that broadcast a scalar operand against every entry of the
+// other operand. They remain element-wise after batching as long as the
+// non-element operand stays a scalar.
+const absl::flat_hash_set<string>* BinaryElementWiseOps() {
+  static const auto* const ops = new absl::flat_hash_set<string>{
+      "Add",     "AddV2",   "Atan2",   "Div",      "FloorDiv",
+      "FloorMod", "Maximum", "Minimum", "Mod",     "Mul",
+      "Pow",     "RealDiv", "SquaredDifference",   "Sub",
+      "TruncateDiv",
+  };
+  return ops;
+}
+
+// Returns true if `node` is a `Const` holding a scalar value.
+bool IsScalarConst(const NodeDef& node) {
+  if (node.op() != "Const") return false;
+  const AttrValue* value = gtl::FindOrNull(node.attr(), "value");
+  if (value == nullptr || !value->has_tensor()) return false;
+  const auto& shape = value->tensor().tensor_shape();
+  return !shape.unknown_rank() && shape.dim_size() == 0;
+}
+
+// Strips the output designation ("node:out:0" or "node:0") from a function
+// body input string, leaving the producing node or argument name.
+string InputBaseName(const string& input) {
+  return input.substr(0, input.find(':'));
+}
+
+// Returns true if applying `function` to a batched input computes, for every
+// batch member, the same values the function computes for the corresponding
+// unbatched element. The analysis is a conservative whitelist walk over the
+// function body; anything it cannot prove element-wise disqualifies the
+// function.
+bool IsElementWise(const FunctionDef& function) {
+  if (function.signature().input_arg_size() == 0) return false;
+  // Control outputs indicate side effects that may not be batch-invariant.
+  if (!function.control_ret().empty()) return false;
+
+  absl::flat_hash_map<string, ValueKind> value_kinds;
+  for (const auto& input_arg : function.signature().input_arg()) {
+    value_kinds[input_arg.name()] = ValueKind::kElementDerived;
+  }
+
+  // Function bodies are topologically ordered, so a single forward pass
+  // sees every producer before its consumers; an unknown producer means an
+  // unsupported construct and disqualifies the function.
+  for (const NodeDef& node : function.node_def()) {
+    std::vector<ValueKind> input_kinds;
+    for (const string& input : node.input()) {
+      if (absl::StartsWith(input, "^")) continue;  // Control input.
+      const ValueKind* kind =
+          gtl::FindOrNull(value_kinds, InputBaseName(input));
+      if (kind == nullptr) return false;
+      input_kinds.push_back(*kind);
+    }
+
+    ValueKind node_kind;
+    if (node.op() == "Const") {
+      // Non-scalar constants may interact with batching through
+      // broadcasting, so only scalars qualify.
+      if (!IsScalarConst(node)) return false;
+      node_kind = ValueKind::kScalar;
+    } else if (UnaryElementWiseOps()->contains(node.op())) {
+      if (input_kinds.size() != 1) return false;
+      node_kind = input_kinds[0];
+    } else if (BinaryElementWiseOps()->contains(node.op())) {
+      if (input_kinds.size() != 2) return false;
+      if (input_kinds[0] == ValueKind::kElementDerived &&
+          input_kinds[1] == ValueKind::kElementDerived) {
+        // Two element-derived operands of different ranks broadcast
+        // differently once both gain a batch dimension.
+        return false;
+      }
+      node_kind = (input_kinds[0] == ValueKind::kElementDerived ||
+                   input_kinds[1] == ValueKind::kElementDerived)
+                      ? ValueKind::kElementDerived
+                      : ValueKind::kScalar;
+    } else {
+      return false;
+    }
+    value_kinds[node.name()] = node_kind;
+  }
+
+  // Every function output must depend on the arguments; a constant output
+  // would no longer be replicated per batch element after the rewrite.
+  for (const auto& ret : function.ret()) {
+    const ValueKind* kind =
+        gtl::FindOrNull(value_kinds, InputBaseName(ret.second));
+    if (kind == nullptr || *kind != ValueKind::kElementDerived) return false;
+  }
+  return true;
+}
+
+// Returns the number of nodes consuming one of `node`'s outputs as a data
+// input.
+int NumDataFanouts(const NodeDef& node, const GraphDef& graph) {
+  int num_fanouts = 0;
+  for (const NodeDef& other : graph.node()) {
+    for (const string& input : other.input()) {
+      if (InputBaseName(input) == node.name()) ++num_fanouts;
+    }
+  }
+  return num_fanouts;
+}
+
+}  // namespace
+
+Status MapVectorization::OptimizeAndCollectStats(Cluster* cluster,
+                                                 const GrapplerItem& item,
+                                                 GraphDef* output,
+                                                 OptimizationStats* stats) {
+  *output = item.graph;
+  MutableGraphView graph(output);
+
+  // This optimization is only applied to the main dataset pipeline.
+  if (graph_utils::IsItemDerivedFromFunctionDef(item, graph)) return OkStatus();
+
+  absl::flat_hash_set<string> nodes_to_delete;
+  FunctionLibraryDefinition function_library(OpRegistry::Global(),
+                                             item.graph.library());
+  for (const NodeDef& node : item.graph.node()) {
+    if (node.op() != kBatchDataset && node.op() != kBatchV2Dataset) {
+      continue;
+    }
+
+    const NodeDef& batch_node = node;
+    NodeDef* map_node = graph_utils::GetInputNode(batch_node, graph);
+    // Only plain `MapDataset` qualifies; a `ParallelMapDataset` ahead of the
+    // batch already amortizes the dispatch overhead across threads, and
+    // serializing it behind the batch could hurt.
+    if (map_node->op() != kMapDataset) continue;
+    // Captured arguments do not gain a batch dimension, so functions that
+    // mix them with the batched arguments are not provably element-wise.
+    if (map_node->input_size() != 1) continue;
+    // The map node must feed only this batch; otherwise the rewrite would
+    // change what its other consumers observe.
+    if (NumDataFanouts(*map_node, item.graph) != 1) continue;
+
+    const auto* f_attr = gtl::FindOrNull(map_node->attr(), kFunctionAttr);
+    if (f_attr == nullptr) continue;
+    const FunctionDef* function =
+        function_library.Find(f_attr->func().name());
+    if (function == nullptr || !IsElementWise(*function)) continue;
+
+    NodeDef* map_input_node = graph_utils::GetInputNode(*map_node, graph);
+    const auto* input_types =
+        gtl::FindOrNull(map_input_node->attr(), kOutputTypesAttr);
+    if (input_types == nullptr) continue;
+    if (!gtl::FindOrNull(batch_node.attr(), kOutputShapesAttr) ||
+        !gtl::FindOrNull(batch_node.attr(), kOutputTypesAttr)) {
+      continue;
+    }
+
+    // The new batch consumes the map's input. Its component types are those
+    // of the unmapped input; its shapes match the original batch output
+    // because element-wise functions preserve shapes.
+    NodeDef new_batch_node = batch_node;
+    graph_utils::SetUniqueGraphNodeName(batch_node.op(), graph.graph(),
+                                        &new_batch_node);
+    new_batch_node.set_input(0, map_node->input(0));
+    (*new_batch_node.mutable_attr())[kOutputTypesAttr] = *input_types;
+    NodeDef* new_batch = graph.AddNode(std::move(new_batch_node));
+
+    // The new map applies the same function to the batched tensors and
+    // produces the original batch output types and shapes.
+    NodeDef new_map_node = *map_node;
+    graph_utils::SetUniqueGraphNodeName(map_node->op(), graph.graph(),
+                                        &new_map_node);
+    new_map_node.set_input(0, new_batch->name());
+    graph_utils::CopyShapesAndTypesAttrs(batch_node, &new_map_node);
+    NodeDef* new_map = graph.AddNode(std::move(new_map_node));
+
+    TF_RETURN_IF_ERROR(graph.UpdateFanouts(batch_node.name(), new_map->name()));
+    nodes_to_delete.insert(map_node->name());
+    nodes_to_delete.insert(batch_node.name());
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(MapVectorization, "map_vectorization");
+
+}  // namespace grappler
+}  // namespace tensorflow
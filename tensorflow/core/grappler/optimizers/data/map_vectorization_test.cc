@@ -0,0 +1,142 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/map_vectorization.h"
+
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_test_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using graph_tests_utils::MakeBatchV2Node;
+using graph_tests_utils::MakeMapNode;
+using graph_tests_utils::MakeParallelMapV2Node;
+using test::function::NDef;
+
+GrapplerItem MakeMapBatchItem(const FunctionDef& function,
+                              const string& function_name) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", gtl::ArraySlice<TensorShape>{}},
+             {"output_types", gtl::ArraySlice<DataType>{}}}),
+       NDef("batch_size", "Const", {}, {{"value", 5}, {"dtype", DT_INT64}}),
+       NDef("drop_remainder", "Const", {},
+            {{"value", false}, {"dtype", DT_BOOL}}),
+       MakeMapNode("map", "range", function_name),
+       MakeBatchV2Node("batch", "map", "batch_size", "drop_remainder",
+                       /*parallel_copy=*/false)},
+      // FunctionLib
+      {
+          function,
+      });
+  return item;
+}
+
+TEST(MapVectorizationTest, HoistsElementWiseMapAboveBatch) {
+  GrapplerItem item = MakeMapBatchItem(test::function::XTimesTwo(),
+                                       "XTimesTwo");
+
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("batch", output));
+  ASSERT_TRUE(graph_utils::ContainsNodeWithOp("MapDataset", output));
+  ASSERT_TRUE(graph_utils::ContainsNodeWithOp("BatchDatasetV2", output));
+
+  // The map must now consume the batch, and the batch the map's old input.
+  const NodeDef& new_map = output.node(
+      graph_utils::FindGraphNodeWithOp("MapDataset", output));
+  const NodeDef& new_batch = output.node(
+      graph_utils::FindGraphNodeWithOp("BatchDatasetV2", output));
+  EXPECT_EQ(new_map.input(0), new_batch.name());
+  EXPECT_EQ(new_batch.input(0), "range");
+  EXPECT_EQ(new_batch.input(1), "batch_size");
+  EXPECT_EQ(new_batch.input(2), "drop_remainder");
+  EXPECT_EQ(new_map.attr().at("f").func().name(), "XTimesTwo");
+}
+
+TEST(MapVectorizationTest, IgnoresNonElementWiseFunction) {
+  GrapplerItem item = MakeMapBatchItem(test::function::RandomUniform(),
+                                       "RandomUniformFn");
+
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("batch", output));
+}
+
+TEST(MapVectorizationTest, IgnoresParallelMap) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", gtl::ArraySlice<TensorShape>{}},
+             {"output_types", gtl::ArraySlice<DataType>{}}}),
+       NDef("num_parallel_calls", "Const", {},
+            {{"value", 2}, {"dtype", DT_INT64}}),
+       NDef("batch_size", "Const", {}, {{"value", 5}, {"dtype", DT_INT64}}),
+       NDef("drop_remainder", "Const", {},
+            {{"value", false}, {"dtype", DT_BOOL}}),
+       MakeParallelMapV2Node("map", "range", "num_parallel_calls", "XTimesTwo",
+                             "default"),
+       MakeBatchV2Node("batch", "map", "batch_size", "drop_remainder",
+                       /*parallel_copy=*/false)},
+      // FunctionLib
+      {
+          test::function::XTimesTwo(),
+      });
+
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("batch", output));
+}
+
+TEST(MapVectorizationTest, IgnoresMapWithMultipleFanouts) {
+  GrapplerItem item = MakeMapBatchItem(test::function::XTimesTwo(),
+                                       "XTimesTwo");
+  // Add a second consumer of the map node.
+  *item.graph.add_node() = graph_tests_utils::MakeTakeNode("take", "map",
+                                                           "batch_size");
+
+  MapVectorization optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("map", output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("batch", output));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
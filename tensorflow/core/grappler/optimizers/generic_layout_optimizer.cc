@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/optimizers/generic_layout_optimizer_transposer_factory.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/platform/tensor_float_32_utils.h"
+#include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -456,8 +457,10 @@ Status EraseOutputShapeAttrs(TransposeContext* context) {
 
 // When there is a GPU, the computation graph is converted to NCHW format.
 // When there is only CPU, there will be no conversion by default, unless user
-// chose to convert the graph to a desired format. Currently, NCHW -> NHWC
-// format conversion is available on CPU.
+// chose to convert the graph to a desired format. NCHW -> NHWC conversion is
+// always available on CPU; NHWC -> NCHW conversion is available when oneDNN
+// kernels, which accept NCHW input and use blocked layouts internally, are
+// enabled.
 Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
                                         const GrapplerItem& item,
                                         GraphDef* output) {
@@ -494,12 +497,21 @@ Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
       case RewriterConfig::NCHW_TO_NHWC:
         context.AssignDeviceAndDataFormats(kCPU, kNCHW, kNHWC);
         break;
-      // TODO(intel-tf): Add functionality for NHWC_TO_NCHW layout conversion on
-      // CPU.
       case RewriterConfig::NHWC_TO_NCHW:
-        return errors::Aborted(
-            "Conversion from NHWC to NCHW is currently not  available for "
-            "CPU.");
+        // oneDNN convolution and pooling kernels accept NCHW input and
+        // reorder it to the blocked (NCHWc) layouts their vectorized
+        // implementations use internally. Converting the graph keeps chains
+        // of conv/pool/elementwise ops in the channel-major format oneDNN
+        // prefers, with layout conversions only at graph boundaries; interior
+        // transpose pairs are erased below. The default Eigen CPU kernels
+        // only accept NHWC, so the conversion is rejected without oneDNN.
+        if (!IsMKLEnabled()) {
+          return errors::Aborted(
+              "Conversion from NHWC to NCHW on CPU is only available with "
+              "oneDNN kernels enabled.");
+        }
+        context.AssignDeviceAndDataFormats(kCPU, kNHWC, kNCHW);
+        break;
       default:
         *output = item.graph;
         VLOG(2) << "No layout conversion will take place for CPU.";
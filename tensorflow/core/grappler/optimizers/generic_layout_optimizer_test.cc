@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status_test_util.h"
 #include "tensorflow/core/platform/tensor_float_32_utils.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/util.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -385,6 +386,49 @@ TEST_F(GenericLayoutOptimizerTest, CPUDevice) {
 #endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
 }
 
+TEST_F(GenericLayoutOptimizerTest, CPUDeviceNHWCToNCHW) {
+#if (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  GTEST_SKIP() << "CPU layout conversion is not applied when GPUs exist";
+#endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  TensorShape input_shape({8, 4, 4, 3});
+  Tensor input_data(DT_FLOAT, input_shape);
+  test::FillIota<float>(&input_data, 1.0f);
+  Output input =
+      ops::Const(s.WithOpName("Input"), Input::Initializer(input_data));
+  TensorShape filter_shape({2, 2, 3, 2});
+  Tensor filter_data(DT_FLOAT, filter_shape);
+  test::FillIota<float>(&filter_data, 1.0f);
+  Output filter =
+      ops::Const(s.WithOpName("Filter"), Input::Initializer(filter_data));
+  Output conv = ops::Conv2D(s.WithOpName("Conv2D").WithDevice("/CPU:0"), input,
+                            filter, {1, 1, 1, 1}, "VALID",
+                            ops::Conv2D::Attrs().DataFormat("NHWC"));
+  Output fetch = ops::Identity(s.WithOpName("Fetch"), {conv});
+  GrapplerItem item;
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  GenericLayoutOptimizer optimizer(RewriterConfig::DEFAULT,
+                                   RewriterConfig::NHWC_TO_NCHW);
+  GraphDef output;
+  Status conversion_status =
+      optimizer.Optimize(virtual_cluster_.get(), item, &output);
+  if (!IsMKLEnabled()) {
+    // Without oneDNN the default CPU kernels only accept NHWC, so the
+    // conversion is rejected.
+    EXPECT_TRUE(errors::IsAborted(conversion_status));
+    return;
+  }
+  TF_ASSERT_OK(conversion_status);
+
+  Status status;
+  utils::GraphView graph_view(&output, &status);
+  TF_ASSERT_OK(status);
+  auto* conv_node = graph_view.GetNode("Conv2D");
+  ASSERT_NE(conv_node, nullptr);
+  VerifyDataFormatAttributeMatch(conv_node, "NCHW");
+}
+
 TEST_F(GenericLayoutOptimizerTest, NoOptimizeIntegerConvolution) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   auto conv = SimpleConv2D<int32>(&s, 4, 2, "VALID", "");
@@ -17,10 +17,13 @@ limitations under the License.
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <string>
 #include <type_traits>
 #include <utility>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -60,10 +63,16 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/topological_sort.h"
 #include "tensorflow/core/grappler/utils/tpu.h"
 #include "tensorflow/core/grappler/verifiers/structure_verifier.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 #include "tensorflow/core/util/xla_config_registry.h"
 
@@ -883,7 +892,10 @@ Status MetaOptimizer::OptimizeGraph(
                                    }) != optimization_result.results.end();
 
   // Record graph optimization result.
-  optimization_results_.push_back(optimization_result);
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.push_back(optimization_result);
+  }
 
   if (is_optimized) {
     TF_RETURN_IF_ERROR(TopologicalSort(optimized_graph));
@@ -973,7 +985,8 @@ Status MetaOptimizer::RunOptimizer(
         optimized_graph_function_library.release());
   }
 
-  OptimizerResult optimizer_result{optimizer->name(), message, status};
+  OptimizerResult optimizer_result{optimizer->name(), message, status,
+                                   duration_ms};
   optimization_result->results.push_back(optimizer_result);
 
   if (!status.ok()) {
@@ -1043,6 +1056,25 @@ void PropagateTFDataAttrs(const FunctionLibraryDefinition& flib,
   }
 }
 
+namespace {
+
+// Number of threads used to optimize functions from the library in parallel.
+// Overridable with TF_GRAPPLER_FUNCTION_OPTIMIZATION_THREADS; a value of 1
+// restores the serial behavior.
+int NumFunctionOptimizationThreads() {
+  int64_t num_threads;
+  Status status =
+      ReadInt64FromEnvVar("TF_GRAPPLER_FUNCTION_OPTIMIZATION_THREADS",
+                          port::MaxParallelism(), &num_threads);
+  if (!status.ok()) {
+    LOG(WARNING) << status.message();
+    return 1;
+  }
+  return std::max<int>(1, num_threads);
+}
+
+}  // namespace
+
 Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
                                           GraphDef* optimized_graph) {
   tensorflow::metrics::ScopedCounter<2> timings(
@@ -1050,7 +1082,10 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       {kGrapplerCategory, "*"});
 
   VLOG(1) << "Starting optimization for grappler item: " << item.id;
-  optimization_results_.clear();
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.clear();
+  }
 
   // Constructs a FunctionLibraryDefinition with functions that are reachable
   // from the nodes of the graph.
@@ -1161,13 +1196,20 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
   // Optimize each function only once.
   absl::flat_hash_set<string> optimized_funcs;
+  const int num_function_threads = NumFunctionOptimizationThreads();
+  std::unique_ptr<thread::ThreadPool> function_pool;
+  if (num_function_threads > 1) {
+    function_pool = std::make_unique<thread::ThreadPool>(
+        Env::Default(), "grappler_function_optimization",
+        num_function_threads);
+  }
   while (optimize_function_library) {
     optimize_function_library = false;
 
-    int function_idx = 0;
+    // Collect the functions that this pass will optimize.
+    std::vector<const FunctionDef*> candidates;
+    absl::flat_hash_set<string> candidate_names;
     for (const FunctionDef& func : optimized_graph->library().function()) {
-      GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
-
       const string& func_name = func.signature().name();
 
       // Skip functions that are not reachable from the optimized graph.
@@ -1187,93 +1229,190 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       // and in function instantiation.
       if (data::IsTFDataFunction(func)) continue;
 
-      VLOG(3) << "Optimize function: function=" << func_name << " ["
-              << function_idx++ << " of "
-              << optimized_graph->library().function_size() << "]";
-
-      // Function optimization might specialize nested function calls, so we
-      // have to reset the flag and do at least one more pass over the library.
-      optimize_function_library = true;
+      candidates.push_back(&func);
+      candidate_names.insert(func_name);
       optimized_funcs.insert(func_name);
+    }
+    if (candidates.empty()) break;
+
+    // Function optimization might specialize nested function calls, so we
+    // have to do at least one more pass over the library.
+    optimize_function_library = true;
+
+    // Group the candidates into waves so that callees are optimized before
+    // their callers: when a caller is optimized in a later wave, nested
+    // function calls resolve to already-optimized bodies, just like in the
+    // serial loop with a topologically ordered library.  Functions within a
+    // wave do not call each other and are optimized in parallel against a
+    // read-only `flib`; results are folded back into `flib` between waves.
+    // Members of a call cycle end up in the same wave.
+    absl::flat_hash_map<const FunctionDef*, absl::flat_hash_set<string>>
+        callees;
+    for (const FunctionDef* func : candidates) {
+      absl::flat_hash_set<string>& func_callees = callees[func];
+      for (const NodeDef& node : func->node_def()) {
+        if (candidate_names.contains(node.op())) {
+          func_callees.insert(node.op());
+        }
+        for (const auto& attr : node.attr()) {
+          if (attr.second.has_func() &&
+              candidate_names.contains(attr.second.func().name())) {
+            func_callees.insert(attr.second.func().name());
+          }
+          for (const NameAttrList& func_attr : attr.second.list().func()) {
+            if (candidate_names.contains(func_attr.name())) {
+              func_callees.insert(func_attr.name());
+            }
+          }
+        }
+      }
+      func_callees.erase(func->signature().name());
+    }
 
-      // Make a GrapplerItem from a FunctionDef.
-      GrapplerFunctionItem func_item;
-      TF_RETURN_IF_ERROR(
-          MakeGrapplerFunctionItem(func, flib, producer, &func_item));
-
-      // If we need to compute the gradient of optimized function at runtime, we
-      // can't perform non-differentiable rewrites.
-      func_item.optimization_options().allow_non_differentiable_rewrites =
-          !differentiable_functions.contains(func_name);
-
-      // Device set available to the function is defined only by the runtime,
-      // when we instantiate and execute the function. We can't use all devices
-      // available to the main graph, because after partitioning the function
-      // call node might execute on a remote worker.
-      if (!func_item.devices().empty()) {
-        return errors::Internal("GrapplerFunctionItem devices must be empty.");
+    absl::flat_hash_set<string> processed;
+    std::vector<const FunctionDef*> remaining = std::move(candidates);
+    while (!remaining.empty()) {
+      GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+
+      std::vector<const FunctionDef*> wave;
+      std::vector<const FunctionDef*> deferred;
+      for (const FunctionDef* func : remaining) {
+        const absl::flat_hash_set<string>& func_callees = callees[func];
+        const bool ready =
+            std::all_of(func_callees.begin(), func_callees.end(),
+                        [&processed](const string& callee) {
+                          return processed.contains(callee);
+                        });
+        (ready ? wave : deferred).push_back(func);
+      }
+      if (wave.empty()) {
+        // The remaining functions form call cycles; optimize them together
+        // against each other's unoptimized bodies.
+        wave.swap(deferred);
+      }
+      for (const FunctionDef* func : wave) {
+        processed.insert(func->signature().name());
       }
+      remaining = std::move(deferred);
+
+      struct FunctionOptimization {
+        GrapplerFunctionItem func_item;
+        GraphDef optimized_func_graph;
+        Status status;
+      };
+      std::vector<FunctionOptimization> results(wave.size());
+
+      auto optimize_function_body = [&](const FunctionDef& func,
+                                        FunctionOptimization* result) {
+        const string& func_name = func.signature().name();
+        VLOG(3) << "Optimize function: function=" << func_name;
+
+        // Make a GrapplerItem from a FunctionDef.
+        GrapplerFunctionItem& func_item = result->func_item;
+        result->status =
+            MakeGrapplerFunctionItem(func, flib, producer, &func_item);
+        if (!result->status.ok()) return;
+
+        // If we need to compute the gradient of optimized function at
+        // runtime, we can't perform non-differentiable rewrites.
+        func_item.optimization_options().allow_non_differentiable_rewrites =
+            !differentiable_functions.contains(func_name);
+
+        // Device set available to the function is defined only by the
+        // runtime, when we instantiate and execute the function. We can't use
+        // all devices available to the main graph, because after partitioning
+        // the function call node might execute on a remote worker.
+        if (!func_item.devices().empty()) {
+          result->status =
+              errors::Internal("GrapplerFunctionItem devices must be empty.");
+          return;
+        }
 
-      // We are not allowed to prune certain types of ops from the graph
-      // instantiated by the function definition, because we must guarantee
-      // function execution semantics wrt side effects (see
-      // function_optimizer.cc).
-      func_item.optimization_options().allow_pruning_stateful_and_dataset_ops =
-          false;
-
-      // Optimize function body graph.
-      GraphDef optimized_func_graph;
-      if (is_tpu_graph) {
-        // Skip optimizing functions if this is a TPU graph. Currently, Grappler
-        // passes do not handle TPU functions correctly in a variety of ways
-        // (Note that due to the pre-placement TPU graph rewriting passes, the
-        // TPU-related ops are encapsulated away into functions). For example,
-        // TPU graphs contain TPUReplicateMetadata node that carries relevant
-        // TPU metadata and Grappler passes could prune that away. Grappler
-        // passes could also cause issues around shape inference. Since the
-        // desired and existing behavior is to not optimize TPU functions with
-        // Grappler, this check preserves that. The only exception is
-        // implementation selector what is required to swap in some TPU specific
-        // lowering code and is verified the work correctly on TPUs.
-        ImplementationSelector implementation_selector;
-
-        // Implementation selector needs to have access to valid function
-        // signature and attributes, and it doesn't need actual function body.
-        std::unique_ptr<FunctionDefLibrary> func_item_function_library(
-            func_item.graph.release_library());
-        *func_item.graph.mutable_library() =
-            GetFunctionDefLibraryStub(*func_item_function_library);
-
-        TF_RETURN_IF_ERROR(implementation_selector.Optimize(
-            cluster, func_item, &optimized_func_graph));
+        // We are not allowed to prune certain types of ops from the graph
+        // instantiated by the function definition, because we must guarantee
+        // function execution semantics wrt side effects (see
+        // function_optimizer.cc).
+        func_item.optimization_options()
+            .allow_pruning_stateful_and_dataset_ops = false;
+
+        // Optimize function body graph.
+        if (is_tpu_graph) {
+          // Skip optimizing functions if this is a TPU graph. Currently,
+          // Grappler passes do not handle TPU functions correctly in a
+          // variety of ways (Note that due to the pre-placement TPU graph
+          // rewriting passes, the TPU-related ops are encapsulated away into
+          // functions). For example, TPU graphs contain TPUReplicateMetadata
+          // node that carries relevant TPU metadata and Grappler passes could
+          // prune that away. Grappler passes could also cause issues around
+          // shape inference. Since the desired and existing behavior is to
+          // not optimize TPU functions with Grappler, this check preserves
+          // that. The only exception is implementation selector what is
+          // required to swap in some TPU specific lowering code and is
+          // verified the work correctly on TPUs.
+          ImplementationSelector implementation_selector;
+
+          // Implementation selector needs to have access to valid function
+          // signature and attributes, and it doesn't need actual function
+          // body.
+          std::unique_ptr<FunctionDefLibrary> func_item_function_library(
+              func_item.graph.release_library());
+          *func_item.graph.mutable_library() =
+              GetFunctionDefLibraryStub(*func_item_function_library);
+
+          result->status = implementation_selector.Optimize(
+              cluster, func_item, &result->optimized_func_graph);
+        } else {
+          GrapplerFunctionItem func_item_copy = func_item;
+          result->status = OptimizeGraph(cluster, std::move(func_item_copy),
+                                         &result->optimized_func_graph);
+        }
+      };
+
+      if (function_pool != nullptr && wave.size() > 1) {
+        BlockingCounter barrier(wave.size());
+        for (size_t i = 0; i < wave.size(); ++i) {
+          function_pool->Schedule([&, i]() {
+            optimize_function_body(*wave[i], &results[i]);
+            barrier.DecrementCount();
+          });
+        }
+        barrier.Wait();
       } else {
-        GrapplerFunctionItem func_item_copy = func_item;
-        TF_RETURN_IF_ERROR(OptimizeGraph(cluster, std::move(func_item_copy),
-                                         &optimized_func_graph));
+        for (size_t i = 0; i < wave.size(); ++i) {
+          optimize_function_body(*wave[i], &results[i]);
+        }
       }
 
-      // Function body optimization might have created new specialized
-      // functions for each instantiation context. Add them to the library.
-      for (const FunctionDef& func_def :
-           optimized_func_graph.library().function()) {
-        if (flib.Find(func_def.signature().name()) == nullptr) {
-          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+      // Fold the optimized function bodies back into the library, in wave
+      // order to keep the result deterministic.
+      for (size_t i = 0; i < wave.size(); ++i) {
+        TF_RETURN_IF_ERROR(results[i].status);
+        GrapplerFunctionItem& func_item = results[i].func_item;
+
+        // Function body optimization might have created new specialized
+        // functions for each instantiation context. Add them to the library.
+        for (const FunctionDef& func_def :
+             results[i].optimized_func_graph.library().function()) {
+          if (flib.Find(func_def.signature().name()) == nullptr) {
+            TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+          }
         }
-      }
 
-      // Convert optimized graph back to FunctionDef.
-      FunctionDef optimized_func;
-      func_item.SwapFunctionBody(std::move(optimized_func_graph));
-      TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, flib, &optimized_func));
+        // Convert optimized graph back to FunctionDef.
+        FunctionDef optimized_func;
+        func_item.SwapFunctionBody(std::move(results[i].optimized_func_graph));
+        TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, flib, &optimized_func));
 
-      // Replace optimized function with a new FunctionDef.
-      TF_RETURN_IF_ERROR(flib.ReplaceFunction(func_name, optimized_func));
+        // Replace optimized function with a new FunctionDef.
+        TF_RETURN_IF_ERROR(
+            flib.ReplaceFunction(wave[i]->signature().name(), optimized_func));
+      }
     }
 
-    // If optimized at least one function, update the graph library.
-    if (optimize_function_library) {
-      *optimized_graph->mutable_library() = flib.ToProto();
-    }
+    // Update the graph library with the optimized functions.  This
+    // invalidates the FunctionDef pointers collected above, so candidates are
+    // re-collected from the new library on the next pass.
+    *optimized_graph->mutable_library() = flib.ToProto();
   }
 
   // Run module-level TFG optimizations at the end of the meta-optimizer.
@@ -1303,6 +1442,31 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
   VLOG(1) << "Optimized " << optimized_funcs.size()
           << " functions: " << absl::StrJoin(optimized_funcs, ", ");
+  if (VLOG_IS_ON(1)) {
+    // Report where the optimization time went, aggregated per optimizer over
+    // the main graph and every optimized function.
+    std::map<string, float> optimizer_ms;
+    {
+      mutex_lock l(optimization_results_mu_);
+      for (const GraphOptimizationResult& graph_result :
+           optimization_results_) {
+        for (const OptimizerResult& result : graph_result.results) {
+          optimizer_ms[result.optimizer_name] += result.duration_ms;
+        }
+      }
+    }
+    std::vector<std::pair<string, float>> sorted_ms(optimizer_ms.begin(),
+                                                    optimizer_ms.end());
+    std::sort(sorted_ms.begin(), sorted_ms.end(),
+              [](const std::pair<string, float>& a,
+                 const std::pair<string, float>& b) {
+                return a.second > b.second;
+              });
+    for (const auto& optimizer_time : sorted_ms) {
+      VLOG(1) << "Total time spent in " << optimizer_time.first << ": "
+              << optimizer_time.second << " ms";
+    }
+  }
   VLOG(3) << "Optimized graph =\n" << optimized_graph->DebugString();
   if (VLOG_IS_ON(1)) {
     DumpGraphDefToFile(
@@ -1316,6 +1480,7 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
 string MetaOptimizer::GetResultString() const {
   std::string result_string;
+  mutex_lock l(optimization_results_mu_);
   for (const GraphOptimizationResult& graph_result : optimization_results_) {
     absl::StrAppend(&result_string,
                     "Optimization results for grappler item: ", graph_result.id,
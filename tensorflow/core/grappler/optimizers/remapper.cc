@@ -88,10 +88,15 @@ namespace {
 constexpr char kFusedConv2D[] = "_FusedConv2D";
 constexpr char kFusedConv3D[] = "_FusedConv3D";
 constexpr char kFusedMatMul[] = "_FusedMatMul";
+constexpr char kFusedAttention[] = "_FusedAttention";
+constexpr char kSparse24MatMul[] = "_Sparse24MatMul";
+constexpr char kEmbeddingLookupSparse[] = "_EmbeddingLookupSparse";
 constexpr char kFusedDepthwiseConv2dNative[] = "_FusedDepthwiseConv2dNative";
 constexpr char kFusedBatchNormEx[] = "_FusedBatchNormEx";
 constexpr char kFusedBatchNormGradEx[] = "_FusedBatchNormGradEx";
 constexpr char kTensorToHashBucket[] = "_TensorToHashBucketFast";
+constexpr char kFusedCastTranspose[] = "_FusedCastTranspose";
+constexpr char kFusedApplyAdam[] = "_FusedApplyAdam";
 constexpr char kLeakyRelu[] = "LeakyRelu";
 constexpr char kMklFusedMish[] = "_MklFusedMish";
 constexpr char kRelu[] = "Relu";
@@ -167,6 +172,19 @@ struct TensorToHashBucket {
   int string_to_hash_bucket = kMissingIndex;
 };
 
+// Cast and Transpose pair that can be computed in a single pass over the
+// input by the _FusedCastTranspose kernel. The pair may appear in either
+// order; `root` is the node whose output the rest of the graph consumes.
+struct CastTranspose {
+  CastTranspose() = default;
+  CastTranspose(int cast, int transpose, int root)
+      : cast(cast), transpose(transpose), root(root) {}
+
+  int cast = kMissingIndex;
+  int transpose = kMissingIndex;
+  int root = kMissingIndex;
+};
+
 // Pad followed by Conv3D/FusedConv3D
 struct PadWithConv3D {
   PadWithConv3D() = default;
@@ -298,6 +316,48 @@ struct ContractionWithBiasAndAddActivation {
   int bias_port = 1;
 };
 
+// Attention block for inference:
+//   BatchMatMul(Softmax(scale * BatchMatMul(query, key, adj_y=true)), value)
+// where scale is a scalar constant multiplied into (or, for RealDiv, divided
+// out of) the attention scores, typically 1/sqrt(depth).
+struct FusedAttention {
+  FusedAttention() = default;
+
+  int scores = kMissingIndex;         // query x key^T batched matmul
+  int scale = kMissingIndex;          // Mul or RealDiv with a scalar constant
+  int scale_operand = kMissingIndex;  // the scalar constant
+  int softmax = kMissingIndex;
+  int output = kMissingIndex;  // softmax(scores) x value batched matmul
+  bool scale_is_reciprocal = false;
+};
+
+// MatMul whose constant weight matrix carries 2:4 structured sparsity: at
+// most 2 non-zeros in every group of 4 consecutive elements along the
+// reduction dimension.
+struct Sparse24MatMul {
+  Sparse24MatMul() = default;
+
+  int matmul = kMissingIndex;
+  int weights = kMissingIndex;  // the dense constant weight
+
+  // Packed form of the weight, produced while verifying the 2:4 pattern:
+  // per output column, the two kept values of each group ([n, k/2]) and one
+  // metadata byte per group with the kept in-group offsets ([n, k/4]).
+  Tensor values;
+  Tensor metadata;
+};
+
+// Embedding lookup with pooling, as expanded by
+// tf.nn.embedding_lookup_sparse:
+//   SparseSegment{Sum,Mean,SqrtN}(Gather(params, ids), indices, segment_ids)
+struct EmbeddingLookupSparse {
+  EmbeddingLookupSparse() = default;
+
+  int reduction = kMissingIndex;  // the SparseSegment* node
+  int gather = kMissingIndex;     // Gather/GatherV2 of the embedding rows
+  string combiner;                // "sum", "mean" or "sqrtn"
+};
+
 bool IsInPreserveSet(const RemapperContext& ctx, const NodeDef* node) {
   return ctx.nodes_to_preserve.count(node->name()) > 0;
 }
@@ -804,6 +864,280 @@ bool FindContractionWithBias(const RemapperContext& ctx, int node_index,
   return true;
 }
 
+bool FindFusedAttention(const RemapperContext& ctx, int node_index,
+                        FusedAttention* matched) {
+  const auto* output_node_view = ctx.graph_view.GetNode(node_index);
+  if (HasControlFaninOrFanout(*output_node_view)) return false;
+
+  // Root of the pattern must be the softmax(scores) x value batched matmul.
+  const auto* output_node_def = output_node_view->node();
+  if (!IsAnyBatchMatMul(*output_node_def)) return false;
+  // The fused kernel only supports float on CPU.
+  if (!HasDataType(output_node_def, DT_FLOAT)) return false;
+  if (!NodeIsOnCpu(output_node_def)) return false;
+  bool adj_x = false;
+  bool adj_y = false;
+  if (!TryGetNodeAttr(*output_node_def, "adj_x", &adj_x) || adj_x) return false;
+  if (!TryGetNodeAttr(*output_node_def, "adj_y", &adj_y) || adj_y) return false;
+  if (output_node_view->NumRegularFanins() != 2) return false;
+
+  // Input 0 of the output matmul must be a Softmax over the innermost
+  // dimension, feeding only this node.
+  const auto* softmax_node_view =
+      output_node_view->GetRegularFanin(0).node_view();
+  const auto* softmax_node_def = softmax_node_view->node();
+  if (!IsSoftmax(*softmax_node_def) ||
+      !HaveSameDataType(output_node_def, softmax_node_def) ||
+      HasControlFaninOrFanout(*softmax_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*softmax_node_view) ||
+      IsInPreserveSet(ctx, softmax_node_def))
+    return false;
+  if (softmax_node_view->NumRegularFanins() != 1) return false;
+
+  // The softmax input must be the scaled score matrix: Mul(scores, scale),
+  // Mul(scale, scores) or RealDiv(scores, scale) with a scalar constant.
+  const auto* scale_node_view =
+      softmax_node_view->GetRegularFanin(0).node_view();
+  const auto* scale_node_def = scale_node_view->node();
+  const bool scale_is_reciprocal = IsRealDiv(*scale_node_def);
+  if ((!IsMul(*scale_node_def) && !scale_is_reciprocal) ||
+      !HaveSameDataType(output_node_def, scale_node_def) ||
+      HasControlFaninOrFanout(*scale_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*scale_node_view) ||
+      IsInPreserveSet(ctx, scale_node_def))
+    return false;
+  if (scale_node_view->NumRegularFanins() != 2) return false;
+
+  const auto is_scalar_const = [](const NodeDef& node) -> bool {
+    if (!IsConstant(node)) return false;
+    const auto it = node.attr().find("value");
+    if (it == node.attr().end()) return false;
+    const auto& shape = it->second.tensor().tensor_shape();
+    return !shape.unknown_rank() && shape.dim_size() == 0;
+  };
+
+  const auto* scale_fanin_0 = scale_node_view->GetRegularFanin(0).node_view();
+  const auto* scale_fanin_1 = scale_node_view->GetRegularFanin(1).node_view();
+  int scores_port;
+  if (IsAnyBatchMatMul(*scale_fanin_0->node()) &&
+      is_scalar_const(*scale_fanin_1->node())) {
+    scores_port = 0;
+  } else if (!scale_is_reciprocal &&
+             IsAnyBatchMatMul(*scale_fanin_1->node()) &&
+             is_scalar_const(*scale_fanin_0->node())) {
+    scores_port = 1;  // scale * scores
+  } else {
+    return false;
+  }
+
+  // The score matrix must be a query x key^T batched matmul.
+  const auto* scores_node_view =
+      scale_node_view->GetRegularFanin(scores_port).node_view();
+  const auto* scores_node_def = scores_node_view->node();
+  if (!HaveSameDataType(output_node_def, scores_node_def) ||
+      HasControlFaninOrFanout(*scores_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*scores_node_view) ||
+      IsInPreserveSet(ctx, scores_node_def))
+    return false;
+  if (!TryGetNodeAttr(*scores_node_def, "adj_x", &adj_x) || adj_x) return false;
+  if (!TryGetNodeAttr(*scores_node_def, "adj_y", &adj_y) || !adj_y) return false;
+  if (scores_node_view->NumRegularFanins() != 2) return false;
+
+  // The fused kernel does not broadcast batch dimensions, so query, key and
+  // value must have identical, fully known leading dimensions.
+  const auto& scores_props =
+      ctx.graph_properties.GetInputProperties(scores_node_def->name());
+  const auto& output_props =
+      ctx.graph_properties.GetInputProperties(output_node_def->name());
+  if (scores_props.size() < 2 || output_props.size() < 2) return false;
+  const TensorShapeProto& query_shape = scores_props[0].shape();
+  const TensorShapeProto& key_shape = scores_props[1].shape();
+  const TensorShapeProto& value_shape = output_props[1].shape();
+  if (query_shape.unknown_rank() || key_shape.unknown_rank() ||
+      value_shape.unknown_rank())
+    return false;
+  const int rank = query_shape.dim_size();
+  if (rank < 2 || key_shape.dim_size() != rank ||
+      value_shape.dim_size() != rank)
+    return false;
+  for (int i = 0; i < rank - 2; ++i) {
+    // Symbolic dimensions (size <= -2) compare equal if they carry the same
+    // symbol; fully unknown dimensions (-1) are rejected.
+    const int64_t dim = query_shape.dim(i).size();
+    if (dim == -1 || key_shape.dim(i).size() != dim ||
+        value_shape.dim(i).size() != dim)
+      return false;
+  }
+
+  matched->scores = scores_node_view->node_index();
+  matched->scale = scale_node_view->node_index();
+  matched->scale_operand =
+      scale_node_view->GetRegularFanin(1 - scores_port).node_index();
+  matched->softmax = softmax_node_view->node_index();
+  matched->output = node_index;
+  matched->scale_is_reciprocal = scale_is_reciprocal;
+
+  return true;
+}
+
+// Packs the dense weight "weights" ([k, n], or [n, k] if "transpose_b") into
+// "matched"'s values/metadata tensors.  Returns false if any group of 4
+// consecutive reduction elements holds more than 2 non-zeros, i.e. the
+// weight is not 2:4 structured sparse.
+bool PackSparse24Weights(const Tensor& weights, bool transpose_b,
+                         Sparse24MatMul* matched) {
+  const int64_t k = weights.dim_size(transpose_b ? 1 : 0);
+  const int64_t n = weights.dim_size(transpose_b ? 0 : 1);
+  // Tiny weights are not worth the extra nodes.
+  if (k < 8 || k % 4 != 0 || n == 0) return false;
+  const int64_t groups = k / 4;
+  matched->values = Tensor(DT_FLOAT, TensorShape({n, 2 * groups}));
+  matched->metadata = Tensor(DT_UINT8, TensorShape({n, groups}));
+  const auto w = weights.matrix<float>();
+  auto values = matched->values.matrix<float>();
+  auto metadata = matched->metadata.matrix<uint8>();
+  for (int64_t col = 0; col < n; ++col) {
+    for (int64_t g = 0; g < groups; ++g) {
+      int offsets[2] = {0, 0};
+      float kept[2] = {0.0f, 0.0f};
+      int num_kept = 0;
+      for (int i = 0; i < 4; ++i) {
+        const int64_t row = 4 * g + i;
+        const float v = transpose_b ? w(col, row) : w(row, col);
+        if (v != 0.0f) {
+          if (num_kept == 2) return false;
+          offsets[num_kept] = i;
+          kept[num_kept] = v;
+          ++num_kept;
+        }
+      }
+      // Groups with fewer than 2 non-zeros pad with a duplicated offset and
+      // an explicit zero value.
+      if (num_kept == 1) offsets[1] = offsets[0];
+      values(col, 2 * g) = kept[0];
+      values(col, 2 * g + 1) = kept[1];
+      metadata(col, g) = static_cast<uint8>(offsets[0] | (offsets[1] << 2));
+    }
+  }
+  return true;
+}
+
+bool FindSparse24MatMul(const RemapperContext& ctx, int node_index,
+                        Sparse24MatMul* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  if (HasControlFaninOrFanout(*node_view)) return false;
+
+  // The packed kernel only supports float on CPU, with the reduction
+  // dimension laid out contiguously in "a" (transpose_a == false).
+  const auto* node_def = node_view->node();
+  if (!IsMatMul(*node_def)) return false;
+  if (!HasDataType(node_def, DT_FLOAT)) return false;
+  if (!NodeIsOnCpu(node_def)) return false;
+  if (node_view->NumRegularFanins() != 2) return false;
+  bool transpose_a = false;
+  bool transpose_b = false;
+  if (!TryGetNodeAttr(*node_def, "transpose_a", &transpose_a) || transpose_a)
+    return false;
+  if (!TryGetNodeAttr(*node_def, "transpose_b", &transpose_b)) return false;
+
+  // The weight must be a constant so the 2:4 pattern can be verified and
+  // packed at rewrite time.
+  const auto* weights_node_view = node_view->GetRegularFanin(1).node_view();
+  const auto* weights_node_def = weights_node_view->node();
+  if (!IsConstant(*weights_node_def)) return false;
+  const auto it = weights_node_def->attr().find("value");
+  if (it == weights_node_def->attr().end()) return false;
+  Tensor weights;
+  if (!weights.FromProto(it->second.tensor())) return false;
+  if (weights.dtype() != DT_FLOAT || weights.dims() != 2) return false;
+
+  if (!PackSparse24Weights(weights, transpose_b, matched)) return false;
+
+  matched->matmul = node_index;
+  matched->weights = weights_node_view->node_index();
+  return true;
+}
+
+bool FindEmbeddingLookupSparse(const RemapperContext& ctx, int node_index,
+                               EmbeddingLookupSparse* matched) {
+  const auto* reduction_node_view = ctx.graph_view.GetNode(node_index);
+  if (HasControlFaninOrFanout(*reduction_node_view)) return false;
+
+  // Root of the pattern is the sparse segment reduction; its op selects the
+  // combiner of the fused lookup.
+  const auto* reduction_node_def = reduction_node_view->node();
+  if (reduction_node_def->op() == "SparseSegmentSum") {
+    matched->combiner = "sum";
+  } else if (reduction_node_def->op() == "SparseSegmentMean") {
+    matched->combiner = "mean";
+  } else if (reduction_node_def->op() == "SparseSegmentSqrtN") {
+    matched->combiner = "sqrtn";
+  } else {
+    return false;
+  }
+  // The fused kernel only supports float on CPU.
+  if (!HasDataType(reduction_node_def, DT_FLOAT)) return false;
+  if (!NodeIsOnCpu(reduction_node_def)) return false;
+  if (reduction_node_view->NumRegularFanins() != 3) return false;
+  // With sparse_gradient the reduction's gradient expects the op to survive.
+  bool sparse_gradient = false;
+  if (TryGetNodeAttr(*reduction_node_def, "sparse_gradient",
+                     &sparse_gradient) &&
+      sparse_gradient)
+    return false;
+
+  // The data input must be a Gather of embedding rows along axis 0 feeding
+  // only the reduction, so the fusion removes the materialized
+  // [num_indices, dim] intermediate.
+  const auto* gather_node_view =
+      reduction_node_view->GetRegularFanin(0).node_view();
+  const auto* gather_node_def = gather_node_view->node();
+  if (gather_node_def->op() != "Gather" && gather_node_def->op() != "GatherV2")
+    return false;
+  if (HasControlFaninOrFanout(*gather_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*gather_node_view) ||
+      IsInPreserveSet(ctx, gather_node_def))
+    return false;
+  if (!HasDataType(gather_node_def, DT_FLOAT, "Tparams")) return false;
+  if (gather_node_def->device() != reduction_node_def->device()) return false;
+  if (gather_node_def->op() == "GatherV2") {
+    if (gather_node_view->NumRegularFanins() != 3) return false;
+    int batch_dims = 0;
+    if (TryGetNodeAttr(*gather_node_def, "batch_dims", &batch_dims) &&
+        batch_dims != 0)
+      return false;
+    const auto* axis_node_def =
+        gather_node_view->GetRegularFanin(2).node_view()->node();
+    if (!IsConstant(*axis_node_def)) return false;
+    const auto it = axis_node_def->attr().find("value");
+    if (it == axis_node_def->attr().end()) return false;
+    Tensor axis;
+    if (!axis.FromProto(it->second.tensor())) return false;
+    if (axis.NumElements() != 1) return false;
+    if (axis.dtype() == DT_INT32) {
+      if (axis.scalar<int32>()() != 0) return false;
+    } else if (axis.dtype() == DT_INT64) {
+      if (axis.scalar<int64_t>()() != 0) return false;
+    } else {
+      return false;
+    }
+  } else {
+    if (gather_node_view->NumRegularFanins() != 2) return false;
+  }
+
+  // The fused kernel expects a flat id vector; with higher-rank ids the
+  // reduction would select slices of the gathered result, not single rows.
+  const auto& gather_props =
+      ctx.graph_properties.GetInputProperties(gather_node_def->name());
+  if (gather_props.size() < 2) return false;
+  const TensorShapeProto& ids_shape = gather_props[1].shape();
+  if (ids_shape.unknown_rank() || ids_shape.dim_size() != 1) return false;
+
+  matched->reduction = node_index;
+  matched->gather = gather_node_view->node_index();
+  return true;
+}
+
 // Fuse _FusedConv{2,3}D with elementwise ops that
 // gets fused in the first iteration of remapper
 // Currently supports: LeakyRelu, _MklFusedMish
@@ -1900,6 +2234,112 @@ bool FindSigmoidAndMul(RemapperContext* ctx, int node_index,
   return found_op_type_match;
 }
 
+// Fuse the two reductions of tf.nn.moments into a single-pass _FusedMoments:
+//
+//   mean = Mean(x, axes, keep_dims=k)
+//   variance = Mean(SquaredDifference(x, StopGradient(mean)), axes,
+//                   keep_dims=k)
+//
+// Both Mean nodes must agree on axes and keep_dims, and the axes must select
+// a contiguous leading or trailing dimension range (expressed as {0..k-1} or
+// {-k..-1}, which the fused kernel requires and which can be validated
+// without inferred shapes).
+bool FindFusedMoments(RemapperContext* ctx, int node_index,
+                      std::map<string, int>* matched_nodes_map,
+                      std::set<int>* remove_node_indices) {
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+  // clang-format off
+  utils::OpTypePattern moments_pattern =
+    {"Mean", "variance", NodeStatus::kReplace,
+      {
+        {"SquaredDifference", "squared_diff", NodeStatus::kRemove,
+          {
+            {"*", "input", NodeStatus::kRemain},
+            {"StopGradient", "stop_gradient", NodeStatus::kRemove,
+              {
+                {"Mean", "mean", NodeStatus::kRemain,
+                  {
+                    {"*", "input", NodeStatus::kRemain},
+                    {"Const", "mean_axes", NodeStatus::kRemain}
+                  }
+                }
+              }
+            }
+          }
+        },
+        {"Const", "axes", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  const auto* variance_node_def = ctx->graph_view.GetNode(node_index)->node();
+  if (!HasDataType(variance_node_def, DT_FLOAT) &&
+      !HasDataType(variance_node_def, DT_DOUBLE))
+    return false;
+  if (!NodeIsOnCpu(variance_node_def)) return false;
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  if (!graph_matcher.GetMatchedNodes(moments_pattern, ctx->nodes_to_preserve,
+                                     ctx->graph_view.GetNode(node_index),
+                                     matched_nodes_map, remove_node_indices)) {
+    return false;
+  }
+
+  const auto* mean_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("mean"))->node();
+  if (mean_node_def->device() != variance_node_def->device()) return false;
+  if (GetDataTypeFromAttr(*mean_node_def, "T") !=
+      GetDataTypeFromAttr(*variance_node_def, "T")) {
+    return false;
+  }
+
+  const auto keep_dims = [](const NodeDef& node) {
+    return node.attr().count("keep_dims") > 0 &&
+           node.attr().at("keep_dims").b();
+  };
+  // With different keep_dims the two outputs would have different shapes,
+  // which one fused node cannot express.
+  if (keep_dims(*mean_node_def) != keep_dims(*variance_node_def)) return false;
+
+  const auto load_const_tensor = [&](const char* label, Tensor* tensor) {
+    const auto* node =
+        ctx->graph_view.GetNode(matched_nodes_map->at(label))->node();
+    return node->attr().count("value") > 0 &&
+           tensor->FromProto(node->attr().at("value").tensor());
+  };
+  Tensor mean_axes_t;
+  Tensor axes_t;
+  if (!load_const_tensor("mean_axes", &mean_axes_t) ||
+      !load_const_tensor("axes", &axes_t)) {
+    return false;
+  }
+  if (mean_axes_t.dtype() != axes_t.dtype() ||
+      (axes_t.dtype() != DT_INT32 && axes_t.dtype() != DT_INT64) ||
+      mean_axes_t.NumElements() != axes_t.NumElements() ||
+      axes_t.NumElements() == 0) {
+    return false;
+  }
+
+  std::vector<int64_t> axes(axes_t.NumElements());
+  for (int64_t i = 0; i < axes_t.NumElements(); ++i) {
+    const int64_t mean_axis = axes_t.dtype() == DT_INT32
+                                  ? mean_axes_t.flat<int32>()(i)
+                                  : mean_axes_t.flat<int64_t>()(i);
+    axes[i] = axes_t.dtype() == DT_INT32 ? axes_t.flat<int32>()(i)
+                                         : axes_t.flat<int64_t>()(i);
+    if (mean_axis != axes[i]) return false;
+  }
+  std::sort(axes.begin(), axes.end());
+  for (size_t i = 1; i < axes.size(); ++i) {
+    if (axes[i] != axes[i - 1] + 1) return false;
+  }
+  return axes.front() == 0 || axes.back() == -1;
+}
+
 // Find a group of ops that make up an instance/layer normalization pattern
 // for fusion
 bool IsCommonNormPattern(RemapperContext* ctx, int node_index,
@@ -2671,6 +3111,62 @@ bool FindTensorToHashBucket(const RemapperContext& ctx, int node_index,
   return true;
 }
 
+bool FindCastTranspose(const RemapperContext& ctx, int node_index,
+                       CastTranspose* matched) {
+  const auto* node_view = ctx.graph_view.GetNode(node_index);
+  const auto* node_def = node_view->node();
+
+  // The pair may appear as Transpose(Cast(x)) or Cast(Transpose(x)); both
+  // compute the same values since the cast is element-wise.
+  const bool root_is_transpose = IsTranspose(*node_def);
+  const bool root_is_cast = IsCast(*node_def);
+  if ((!root_is_transpose && !root_is_cast) ||
+      HasControlFaninOrFanout(*node_view)) {
+    return false;
+  }
+  if (node_view->NumRegularFanins() < 1) return false;
+
+  const auto& regular_fanin_0 = node_view->GetRegularFanin(0);
+  const auto* inner_node_view = regular_fanin_0.node_view();
+  const auto* inner_node_def = inner_node_view->node();
+  if (root_is_transpose ? !IsCast(*inner_node_def)
+                        : !IsTranspose(*inner_node_def)) {
+    return false;
+  }
+  if (HasControlFaninOrFanout(*inner_node_view) ||
+      !HasAtMostOneFanoutAtPort0(*inner_node_view) ||
+      IsInPreserveSet(ctx, inner_node_def)) {
+    return false;
+  }
+
+  const NodeDef* cast = root_is_cast ? node_def : inner_node_def;
+  const NodeDef* transpose = root_is_transpose ? node_def : inner_node_def;
+
+  // The fused kernel is CPU only and covers the floating point types for
+  // which halving the memory traffic matters; truncating casts are not
+  // implemented by it.
+  if (!NodeIsOnCpu(transpose)) return false;
+  const std::set<DataType> supported = {DT_HALF, DT_BFLOAT16, DT_FLOAT,
+                                        DT_DOUBLE};
+  DataType src_type = GetDataTypeFromAttr(*cast, "SrcT");
+  DataType dst_type = GetDataTypeFromAttr(*cast, "DstT");
+  if (supported.count(src_type) == 0 || supported.count(dst_type) == 0 ||
+      src_type == dst_type) {
+    return false;
+  }
+  bool truncate = false;
+  if (GetNodeAttr(*cast, "Truncate", &truncate).ok() && truncate) {
+    return false;
+  }
+
+  *matched = CastTranspose{root_is_cast ? node_index
+                                        : inner_node_view->node_index(),
+                           root_is_transpose ? node_index
+                                             : inner_node_view->node_index(),
+                           node_index};
+  return true;
+}
+
 // clang-format off
 // HardSwish pattern
 //                        input     Const (value: 3)
@@ -3224,6 +3720,166 @@ void SetFusedOpAttributes(NodeDef* fused,
   SetAttrValue(epsilon, &(*attr)["epsilon"]);  // required only for BatchNorm
 }
 
+Status AddFusedAttentionNode(RemapperContext* ctx,
+                             const FusedAttention& matched,
+                             std::vector<bool>* invalidated_nodes,
+                             std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& scores = graph->node(matched.scores);
+  const NodeDef& output = graph->node(matched.output);
+  const NodeDef& scale_operand = graph->node(matched.scale_operand);
+  VLOG(2) << "Fuse attention block:"
+          << " scores=" << scores.name()
+          << " softmax=" << graph->node(matched.softmax).name()
+          << " output=" << output.name();
+
+  NodeDef fused_op;
+  fused_op.set_name(output.name());
+  fused_op.set_op(kFusedAttention);
+  fused_op.set_device(output.device());
+  fused_op.add_input(scores.input(0));        // 0: query
+  fused_op.add_input(scores.input(1));        // 1: key
+  fused_op.add_input(output.input(1));        // 2: value
+  fused_op.add_input(scale_operand.name());   // 3: scale
+
+  auto* attr = fused_op.mutable_attr();
+  (*attr)["T"] = output.attr().at("T");
+  SetAttrValue(matched.scale_is_reciprocal,
+               &(*attr)["use_reciprocal_scale"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.output] = true;
+  (*nodes_to_delete)[matched.scores] = true;
+  (*nodes_to_delete)[matched.scale] = true;
+  (*nodes_to_delete)[matched.softmax] = true;
+
+  return OkStatus();
+}
+
+Status AddSparse24MatMulNode(RemapperContext* ctx, Sparse24MatMul* matched,
+                             std::vector<bool>* invalidated_nodes,
+                             std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& matmul = graph->node(matched->matmul);
+  const NodeDef& weights = graph->node(matched->weights);
+  VLOG(2) << "Rewrite MatMul with 2:4 structured-sparse weights: matmul="
+          << matmul.name() << " weights=" << weights.name();
+
+  NodeDef values_op;
+  values_op.set_name(absl::StrCat(matmul.name(), "/sparse24_values"));
+  values_op.set_op("Const");
+  values_op.set_device(matmul.device());
+  (*values_op.mutable_attr())["dtype"].set_type(DT_FLOAT);
+  matched->values.AsProtoTensorContent(
+      (*values_op.mutable_attr())["value"].mutable_tensor());
+
+  NodeDef metadata_op;
+  metadata_op.set_name(absl::StrCat(matmul.name(), "/sparse24_metadata"));
+  metadata_op.set_op("Const");
+  metadata_op.set_device(matmul.device());
+  (*metadata_op.mutable_attr())["dtype"].set_type(DT_UINT8);
+  matched->metadata.AsProtoTensorContent(
+      (*metadata_op.mutable_attr())["value"].mutable_tensor());
+
+  NodeDef fused_op;
+  fused_op.set_name(matmul.name());
+  fused_op.set_op(kSparse24MatMul);
+  fused_op.set_device(matmul.device());
+  fused_op.add_input(matmul.input(0));        // 0: a
+  fused_op.add_input(values_op.name());       // 1: packed values
+  fused_op.add_input(metadata_op.name());     // 2: packed metadata
+  (*fused_op.mutable_attr())["T"] = matmul.attr().at("T");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(values_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(metadata_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched->matmul] = true;
+  // The dense weight constant is intentionally left in place: it may feed
+  // other consumers, and if the matmul was its only fanout it is removed by
+  // the regular graph pruning.
+
+  return OkStatus();
+}
+
+Status AddEmbeddingLookupSparseNode(RemapperContext* ctx,
+                                    const EmbeddingLookupSparse& matched,
+                                    std::vector<bool>* invalidated_nodes,
+                                    std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& reduction = graph->node(matched.reduction);
+  const NodeDef& gather = graph->node(matched.gather);
+  VLOG(2) << "Fuse " << gather.op() << " with " << reduction.op()
+          << " into _EmbeddingLookupSparse: gather=" << gather.name()
+          << " reduction=" << reduction.name();
+
+  const DataType ids_dtype = GetDataTypeFromAttr(gather, "Tindices");
+
+  // The reduction indexes the gathered intermediate, so the fused lookup
+  // needs the composed ids ids[indices]. Gathering the flat id vector is
+  // negligible next to the embedding-row gather being removed.
+  NodeDef axis_op;
+  axis_op.set_name(absl::StrCat(reduction.name(), "/embedding_ids/axis"));
+  axis_op.set_op("Const");
+  axis_op.set_device(reduction.device());
+  (*axis_op.mutable_attr())["dtype"].set_type(DT_INT32);
+  Tensor axis(DT_INT32, TensorShape({}));
+  axis.scalar<int32>()() = 0;
+  axis.AsProtoTensorContent(
+      (*axis_op.mutable_attr())["value"].mutable_tensor());
+
+  NodeDef ids_op;
+  ids_op.set_name(absl::StrCat(reduction.name(), "/embedding_ids"));
+  ids_op.set_op("GatherV2");
+  ids_op.set_device(reduction.device());
+  ids_op.add_input(gather.input(1));     // 0: the gathered id vector
+  ids_op.add_input(reduction.input(1));  // 1: indices into the id vector
+  ids_op.add_input(axis_op.name());      // 2: axis
+  (*ids_op.mutable_attr())["Tparams"].set_type(ids_dtype);
+  (*ids_op.mutable_attr())["Tindices"] = reduction.attr().at("Tidx");
+  (*ids_op.mutable_attr())["Taxis"].set_type(DT_INT32);
+  (*ids_op.mutable_attr())["batch_dims"].set_i(0);
+
+  NodeDef fused_op;
+  fused_op.set_name(reduction.name());
+  fused_op.set_op(kEmbeddingLookupSparse);
+  fused_op.set_device(reduction.device());
+  fused_op.add_input(gather.input(0));    // 0: the embedding table
+  fused_op.add_input(ids_op.name());      // 1: composed ids
+  fused_op.add_input(reduction.input(2));  // 2: segment ids
+  (*fused_op.mutable_attr())["T"] = reduction.attr().at("T");
+  (*fused_op.mutable_attr())["Tidx"].set_type(ids_dtype);
+  (*fused_op.mutable_attr())["Tsegmentids"] =
+      reduction.attr().at("Tsegmentids");
+  SetAttrValue(matched.combiner, &(*fused_op.mutable_attr())["combiner"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(axis_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(ids_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.reduction] = true;
+  (*nodes_to_delete)[matched.gather] = true;
+
+  return OkStatus();
+}
+
 Status AddFusedContractionNode(RemapperContext* ctx,
                                const ContractionWithBiasAdd& matched,
                                std::vector<bool>* invalidated_nodes,
@@ -3910,6 +4566,66 @@ Status ReplaceSigmoidMulWithSwish(
   return OkStatus();
 }
 
+Status AddFusedMomentsNode(RemapperContext* ctx,
+                           const std::map<string, int>& matched_nodes_map,
+                           const std::set<int>& remove_node_indices,
+                           std::vector<bool>* invalidated_nodes,
+                           std::vector<bool>* nodes_to_delete) {
+  const NodeDef* mean =
+      ctx->graph_view.GetNode(matched_nodes_map.at("mean"))->node();
+  const NodeDef* variance =
+      ctx->graph_view.GetNode(matched_nodes_map.at("variance"))->node();
+
+  VLOG(2) << "Fuse tf.nn.moments reductions into _FusedMoments:"
+          << " mean=" << mean->name() << " variance=" << variance->name();
+
+  // The fused node takes over the mean node's name so that output 0 (mean)
+  // keeps the existing consumer edges valid.
+  NodeDef fused_op;
+  fused_op.set_name(mean->name());
+  fused_op.set_op("_FusedMoments");
+  fused_op.set_device(mean->device());
+  fused_op.add_input(mean->input(0));  // 0: input
+  fused_op.add_input(mean->input(1));  // 1: reduction_indices
+
+  auto* attrs = fused_op.mutable_attr();
+  (*attrs)["T"] = mean->attr().at("T");
+  if (mean->attr().count("Tidx") > 0) {
+    (*attrs)["Tidx"] = mean->attr().at("Tidx");
+  } else {
+    SetAttrValue(DT_INT32, &(*attrs)["Tidx"]);
+  }
+  if (mean->attr().count("keep_dims") > 0) {
+    (*attrs)["keep_dims"] = mean->attr().at("keep_dims");
+  } else {
+    SetAttrValue(false, &(*attrs)["keep_dims"]);
+  }
+
+  // Turn the variance Mean node into an Identity forwarding the fused node's
+  // second output, so its consumers do not need rewiring either.
+  NodeDef identity_op;
+  identity_op.set_op("Identity");
+  identity_op.set_name(variance->name());
+  identity_op.set_device(variance->device());
+  identity_op.add_input(absl::StrCat(mean->name(), ":1"));
+  (*identity_op.mutable_attr())["T"] = variance->attr().at("T");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  mutation->AddNode(std::move(identity_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched_nodes_map.at("mean")] = true;
+  (*invalidated_nodes)[matched_nodes_map.at("variance")] = true;
+  for (const auto& node_index : remove_node_indices) {
+    (*nodes_to_delete)[node_index] = true;
+  }
+  return OkStatus();
+}
+
 Status AddFusedBatchNormExNode(RemapperContext* ctx,
                                const FusedBatchNormEx& matched,
                                std::vector<bool>* invalidated_nodes,
@@ -4285,6 +5001,213 @@ Status AddTensorToHashBucketNode(RemapperContext* ctx,
   return OkStatus();
 }
 
+Status AddCastTransposeNode(RemapperContext* ctx, const CastTranspose& matched,
+                            std::vector<bool>* invalidated_nodes,
+                            std::vector<bool>* nodes_to_delete) {
+  const GraphDef* graph = ctx->graph_view.graph();
+  const NodeDef& cast = graph->node(matched.cast);
+  const NodeDef& transpose = graph->node(matched.transpose);
+  const NodeDef& root = graph->node(matched.root);
+  VLOG(2) << "Fuse Cast with Transpose:"
+          << " cast=" << cast.name() << " transpose=" << transpose.name()
+          << " on device=" << root.device();
+
+  const bool root_is_transpose = matched.root == matched.transpose;
+
+  NodeDef fused_op;
+  fused_op.set_name(root.name());
+  fused_op.set_device(root.device());
+  // 0: x
+  fused_op.add_input(root_is_transpose ? cast.input(0) : transpose.input(0));
+  fused_op.add_input(transpose.input(1));  // 1: perm
+  fused_op.set_op(kFusedCastTranspose);
+
+  auto* attr = fused_op.mutable_attr();
+  (*attr)["SrcT"] = cast.attr().at("SrcT");
+  (*attr)["DstT"] = cast.attr().at("DstT");
+  (*attr)["Tperm"] = transpose.attr().at("Tperm");
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_op), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+
+  (*invalidated_nodes)[matched.root] = true;
+  (*nodes_to_delete)[root_is_transpose ? matched.cast : matched.transpose] =
+      true;
+
+  return OkStatus();
+}
+
+// Returns the value of a bool attr, or false if the attr is not present.
+bool GetBoolAttr(const NodeDef& node, const string& name) {
+  auto it = node.attr().find(name);
+  return it != node.attr().end() && it->second.b();
+}
+
+// Merges groups of independent ResourceApplyAdam nodes that share the same
+// hyperparameter inputs into _FusedApplyAdam nodes, so a training step over
+// many small variables pays one kernel dispatch per group instead of one per
+// variable. Only CPU nodes are grouped since only the CPU kernel is
+// registered. Grouped nodes must have no controlling fanins and their data
+// inputs must not be reachable from any candidate's controlled fanouts;
+// together with ResourceApplyAdam having no data outputs this guarantees the
+// merge cannot introduce a cycle.
+Status GroupResourceApplyAdamNodes(RemapperContext* ctx,
+                                   std::vector<bool>* invalidated_nodes,
+                                   std::vector<bool>* nodes_to_delete) {
+  // Cap on variables merged into one fused node, so the executor can still
+  // run independent groups concurrently.
+  constexpr int kMaxGroupSize = 64;
+
+  utils::MutableGraphView& graph_view = ctx->graph_view;
+  const int num_nodes = graph_view.NumNodes();
+  const int num_tracked_nodes = invalidated_nodes->size();
+
+  std::vector<int> candidates;
+  for (int i = 0; i < num_nodes; ++i) {
+    if (i < num_tracked_nodes &&
+        ((*invalidated_nodes)[i] || (*nodes_to_delete)[i])) {
+      continue;
+    }
+    const auto* node_view = graph_view.GetNode(i);
+    const auto* node_def = node_view->node();
+    if (node_def->op() != "ResourceApplyAdam") continue;
+    if (node_def->input_size() != 10) continue;
+    if (!NodeIsOnCpu(node_def)) continue;
+    if (IsInPreserveSet(*ctx, node_def)) continue;
+    if (node_view->NumControllingFanins() > 0) continue;
+    candidates.push_back(i);
+  }
+  if (candidates.size() < 2) return OkStatus();
+
+  // Forward closure of the candidates' controlled fanouts. A candidate whose
+  // data inputs are produced inside this closure cannot be merged: the fused
+  // node would both precede and depend on those producers.
+  std::vector<bool> reachable(num_nodes, false);
+  std::vector<int> queue;
+  for (int i : candidates) {
+    for (const auto& fanout : graph_view.GetNode(i)->GetControlledFanouts()) {
+      const int fanout_index = fanout.node_view()->node_index();
+      if (!reachable[fanout_index]) {
+        reachable[fanout_index] = true;
+        queue.push_back(fanout_index);
+      }
+    }
+  }
+  while (!queue.empty()) {
+    const auto* node_view = graph_view.GetNode(queue.back());
+    queue.pop_back();
+    for (const auto& port_fanouts : node_view->GetRegularFanouts()) {
+      for (const auto& fanout : port_fanouts) {
+        const int fanout_index = fanout.node_view()->node_index();
+        if (!reachable[fanout_index]) {
+          reachable[fanout_index] = true;
+          queue.push_back(fanout_index);
+        }
+      }
+    }
+    for (const auto& fanout : node_view->GetControlledFanouts()) {
+      const int fanout_index = fanout.node_view()->node_index();
+      if (!reachable[fanout_index]) {
+        reachable[fanout_index] = true;
+        queue.push_back(fanout_index);
+      }
+    }
+  }
+
+  // Group candidates by everything the fused node shares: device, dtype,
+  // locking/nesterov behavior and the six hyperparameter input tensors.
+  // std::map keeps the grouping deterministic.
+  std::map<string, std::vector<int>> groups;
+  for (int i : candidates) {
+    const auto* node_view = graph_view.GetNode(i);
+    const auto* node_def = node_view->node();
+    bool has_reachable_fanin = false;
+    for (const auto& fanin : node_view->GetRegularFanins()) {
+      if (reachable[fanin.node_view()->node_index()]) {
+        has_reachable_fanin = true;
+        break;
+      }
+    }
+    if (has_reachable_fanin) continue;
+    string key =
+        absl::StrCat(node_def->device(), "|",
+                     static_cast<int>(GetDataTypeFromAttr(*node_def, "T")), "|",
+                     GetBoolAttr(*node_def, "use_locking"), "|",
+                     GetBoolAttr(*node_def, "use_nesterov"));
+    for (int j = 3; j <= 8; ++j) {
+      absl::StrAppend(&key, "|", node_def->input(j));
+    }
+    groups[key].push_back(i);
+  }
+
+  utils::Mutation* mutation = graph_view.GetMutationBuilder();
+  bool any_fused = false;
+  for (auto& group : groups) {
+    std::vector<int>& members = group.second;
+    const int num_members = members.size();
+    for (int begin = 0; begin < num_members; begin += kMaxGroupSize) {
+      const int end = std::min(num_members, begin + kMaxGroupSize);
+      const int group_size = end - begin;
+      if (group_size < 2) continue;
+      const NodeDef& first = *graph_view.GetNode(members[begin])->node();
+
+      NodeDef fused_op;
+      fused_op.set_name(first.name());
+      fused_op.set_op(kFusedApplyAdam);
+      fused_op.set_device(first.device());
+      for (int input_index : {0, 1, 2}) {  // var, m, v
+        for (int k = begin; k < end; ++k) {
+          fused_op.add_input(
+              graph_view.GetNode(members[k])->node()->input(input_index));
+        }
+      }
+      for (int j = 3; j <= 8; ++j) {  // shared hyperparameters
+        fused_op.add_input(first.input(j));
+      }
+      for (int k = begin; k < end; ++k) {  // grad
+        fused_op.add_input(graph_view.GetNode(members[k])->node()->input(9));
+      }
+      auto* attr = fused_op.mutable_attr();
+      (*attr)["T"] = first.attr().at("T");
+      (*attr)["N"].set_i(group_size);
+      (*attr)["use_locking"].set_b(GetBoolAttr(first, "use_locking"));
+      (*attr)["use_nesterov"].set_b(GetBoolAttr(first, "use_nesterov"));
+
+      Status status;
+      mutation->AddNode(std::move(fused_op), &status);
+      TF_RETURN_IF_ERROR(status);
+
+      if (members[begin] < num_tracked_nodes) {
+        (*invalidated_nodes)[members[begin]] = true;
+      }
+      for (int k = begin + 1; k < end; ++k) {
+        auto* member_view = graph_view.GetNode(members[k]);
+        // Control fanouts of the merged nodes now hang off the fused node.
+        for (const auto& fanout : member_view->GetControlledFanouts()) {
+          mutation->AddControllingFanin(fanout.node_view(), first.name());
+          mutation->RemoveControllingFanin(fanout.node_view(),
+                                           member_view->GetName());
+        }
+        if (members[k] < num_tracked_nodes) {
+          (*nodes_to_delete)[members[k]] = true;
+        } else {
+          mutation->RemoveNode(member_view);
+        }
+      }
+      any_fused = true;
+      VLOG(2) << "Fused " << group_size << " ResourceApplyAdam updates into "
+              << first.name();
+    }
+  }
+  if (any_fused) {
+    TF_RETURN_IF_ERROR(mutation->Apply());
+  }
+  return OkStatus();
+}
+
 Status AddFusedBatchMatMul(RemapperContext* ctx,
                            const std::map<string, int>& matched_nodes_map,
                            const std::set<int>& remove_node_indices,
@@ -4755,17 +5678,42 @@ bool RequiresInferredShapes(const RemapperContext& ctx, int node_index,
     return true;
   };
 
+  // Candidate for a fused attention block (BatchMatMul + scale + Softmax +
+  // BatchMatMul).
+  const auto is_attention_candidate = [&]() -> bool {
+    if (!IsAnyBatchMatMul(*node_def)) return false;
+    if (GetDataTypeFromAttr(*node_def, "T") != DT_FLOAT) return false;
+    if (node_view->NumRegularFanins() != 2) return false;
+    return IsSoftmax(*node_view->GetRegularFanin(0).node_view()->node());
+  };
+
+  // Candidate for a fused embedding lookup (Gather + SparseSegment*).
+  const auto is_embedding_lookup_candidate = [&]() -> bool {
+    if (node_def->op() != "SparseSegmentSum" &&
+        node_def->op() != "SparseSegmentMean" &&
+        node_def->op() != "SparseSegmentSqrtN")
+      return false;
+    if (GetDataTypeFromAttr(*node_def, "T") != DT_FLOAT) return false;
+    if (node_view->NumRegularFanins() != 3) return false;
+    const auto* data_node_def =
+        node_view->GetRegularFanin(0).node_view()->node();
+    return data_node_def->op() == "Gather" ||
+           data_node_def->op() == "GatherV2";
+  };
+
   if (IsMKLEnabled())
     return is_batch_norm_candidate() || is_batch_norm_fusion_candidate() ||
            IsContractionWithAdd(ctx, node_index) ||
            is_act_biasadd_conv_candidate() || IsBiasAdd(*node_def) ||
-           IsTranspose(*node_def);
+           IsTranspose(*node_def) || is_attention_candidate() ||
+           is_embedding_lookup_candidate();
 
   return is_act_biasadd_conv_candidate() || is_batch_norm_candidate() ||
          is_batch_norm_fusion_candidate() ||
          is_batch_norm_grad_fusion_candidate() ||
          is_matmul_gelu_exact_fusion_candidate() ||
-         is_act_biasadd_matmul_candidate();
+         is_act_biasadd_matmul_candidate() || is_attention_candidate() ||
+         is_embedding_lookup_candidate();
 }
 }  // namespace
 
@@ -5021,6 +5969,52 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap BatchMatMul+Mul+Softmax+BatchMatMul attention blocks into
+    // _FusedAttention, which does not materialize the batched score tensor.
+    FusedAttention fused_attention;
+    if (allow_non_differentiable_rewrites &&
+        FindFusedAttention(ctx, i, &fused_attention)) {
+      TF_RETURN_IF_ERROR(AddFusedAttentionNode(
+          &ctx, fused_attention, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Remap MatMul nodes whose constant weights carry 2:4 structured
+    // sparsity onto _Sparse24MatMul over packed weights, halving the
+    // per-output multiply count and weight bytes touched.
+    Sparse24MatMul sparse24_matmul;
+    if (allow_non_differentiable_rewrites &&
+        FindSparse24MatMul(ctx, i, &sparse24_matmul)) {
+      TF_RETURN_IF_ERROR(AddSparse24MatMulNode(
+          &ctx, &sparse24_matmul, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Remap Gather + SparseSegment{Sum,Mean,SqrtN} (the expansion of
+    // tf.nn.embedding_lookup_sparse) onto _EmbeddingLookupSparse, which
+    // accumulates rows straight into the pooled output instead of
+    // materializing the gathered embeddings.
+    EmbeddingLookupSparse embedding_lookup;
+    if (allow_non_differentiable_rewrites &&
+        FindEmbeddingLookupSparse(ctx, i, &embedding_lookup)) {
+      TF_RETURN_IF_ERROR(AddEmbeddingLookupSparseNode(
+          &ctx, embedding_lookup, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
+    // Remap the Mean+SquaredDifference+Mean subgraph of tf.nn.moments into a
+    // single-pass _FusedMoments.
+    matched_nodes_map.clear();
+    remove_node_indices.clear();
+    if (allow_non_differentiable_rewrites &&
+        FindFusedMoments(&ctx, i, &matched_nodes_map, &remove_node_indices)) {
+      TF_RETURN_IF_ERROR(AddFusedMomentsNode(&ctx, matched_nodes_map,
+                                             remove_node_indices,
+                                             &invalidated_nodes,
+                                             &nodes_to_delete));
+      continue;
+    }
+
     // Remap {Conv2D,DepthwiseConv2D,MatMul}+BiasAdd into the
     // _Fused{Conv2D,DepthwiseConv2dNative,MatMul}
     ContractionWithBiasAdd contract_with_bias;
@@ -5108,6 +6102,16 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap Cast+Transpose (in either order) into the single-pass
+    // _FusedCastTranspose.
+    CastTranspose cast_transpose;
+    if (allow_non_differentiable_rewrites &&
+        FindCastTranspose(ctx, i, &cast_transpose)) {
+      TF_RETURN_IF_ERROR(AddCastTransposeNode(
+          &ctx, cast_transpose, &invalidated_nodes, &nodes_to_delete));
+      continue;
+    }
+
     // During inference, most of the inputs to FusedBatchNorm are constant, and
     // we can therefore replace the op with a much cheaper set of primitives.
     FusedBatchNorm fused_batch_norm;
@@ -5117,6 +6121,14 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
     }
   }
 
+  // Batch independent per-variable Adam updates into _FusedApplyAdam nodes.
+  // Done after the per-node loop since grouping looks at the whole graph
+  // rather than a local pattern.
+  if (allow_non_differentiable_rewrites) {
+    TF_RETURN_IF_ERROR(GroupResourceApplyAdamNodes(&ctx, &invalidated_nodes,
+                                                   &nodes_to_delete));
+  }
+
   // Remove invalidated nodes.
   utils::Mutation* mutation = ctx.graph_view.GetMutationBuilder();
   for (int i = 0; i < num_nodes; ++i) {
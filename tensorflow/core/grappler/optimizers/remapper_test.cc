@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/grappler/optimizers/remapper.h"
 
+#include "absl/strings/str_cat.h"
 #include "tensorflow/cc/ops/nn_ops_internal.h"
+#include "tensorflow/cc/ops/resource_variable_ops.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/types.h"
@@ -1764,6 +1766,616 @@ TEST_F(RemapperTensorToHashBucketTest, I32) { RunTest<DT_INT32>(); }
 
 TEST_F(RemapperTensorToHashBucketTest, I64) { RunTest<DT_INT64>(); }
 
+class RemapperCastTransposeTest : public RemapperTest {
+ public:
+  // Builds Transpose(Cast(x)) when `cast_first` is true, Cast(Transpose(x))
+  // otherwise; both orders are expected to be fused.
+  void RunTest(bool cast_first) {
+    using ::tensorflow::ops::Placeholder;
+
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    auto input_shape = ops::Placeholder::Shape({8, 32, 32, 3});
+    auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+    auto perm = ops::Const(s.WithOpName("perm"), {0, 3, 1, 2}, {4});
+
+    Output result;
+    if (cast_first) {
+      auto cast = ops::Cast(s.WithOpName("cast"), input, DT_BFLOAT16);
+      result = ops::Transpose(s.WithOpName("root"), cast, perm);
+    } else {
+      auto transpose = ops::Transpose(s.WithOpName("transpose"), input, perm);
+      result = ops::Cast(s.WithOpName("root"), transpose, DT_BFLOAT16);
+    }
+    auto fetch = ops::Identity(s.WithOpName("fetch"), result);
+
+    auto input_t = GenerateRandomTensor<DT_FLOAT>({8, 32, 32, 3});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"input", input_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // The fused kernel is CPU only.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+    int found = 0;
+    for (const NodeDef& node : output.node()) {
+      if (node.name() == "root") {
+        EXPECT_EQ(node.op(), "_FusedCastTranspose");
+        ASSERT_GE(node.input_size(), 2);
+        EXPECT_EQ(node.input(0), "input");
+        EXPECT_EQ(node.input(1), "perm");
+        EXPECT_EQ(node.attr().at("SrcT").type(), DT_FLOAT);
+        EXPECT_EQ(node.attr().at("DstT").type(), DT_BFLOAT16);
+        found++;
+      }
+    }
+    EXPECT_EQ(found, 1);
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectTensorEqual<bfloat16>(tensors[0], tensors_expected[0]);
+  }
+};
+
+TEST_F(RemapperCastTransposeTest, CastThenTranspose) { RunTest(true); }
+
+TEST_F(RemapperCastTransposeTest, TransposeThenCast) { RunTest(false); }
+
+// Only the graph structure is verified here: grouping requires the apply
+// nodes to have no controlling fanins, so the graph cannot also sequence the
+// variable initialization needed to evaluate the update numerically.
+TEST_F(RemapperTest, FuseResourceApplyAdam) {
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  const TensorShape shape({2});
+  auto beta1_power = ops::Const(s.WithOpName("beta1_power"), 0.9f, {});
+  auto beta2_power = ops::Const(s.WithOpName("beta2_power"), 0.99f, {});
+  auto lr = ops::Const(s.WithOpName("lr"), 0.001f, {});
+  auto beta1 = ops::Const(s.WithOpName("beta1"), 0.9f, {});
+  auto beta2 = ops::Const(s.WithOpName("beta2"), 0.999f, {});
+  auto epsilon = ops::Const(s.WithOpName("epsilon"), 1e-8f, {});
+
+  std::vector<Operation> applies;
+  for (int i = 0; i < 3; ++i) {
+    auto var = ops::VarHandleOp(s.WithOpName(absl::StrCat("var_", i)),
+                                DT_FLOAT, shape);
+    auto m = ops::VarHandleOp(s.WithOpName(absl::StrCat("m_", i)), DT_FLOAT,
+                              shape);
+    auto v = ops::VarHandleOp(s.WithOpName(absl::StrCat("v_", i)), DT_FLOAT,
+                              shape);
+    auto grad =
+        ops::Const(s.WithOpName(absl::StrCat("grad_", i)), {0.1f, 0.2f});
+    auto apply = ops::ResourceApplyAdam(
+        s.WithOpName(absl::StrCat("apply_", i)), var, m, v, beta1_power,
+        beta2_power, lr, beta1, beta2, epsilon, grad);
+    applies.push_back(apply.operation);
+  }
+  ops::NoOp(s.WithOpName("train").WithControlDependencies(applies));
+
+  GrapplerItem item;
+  item.fetch = {"train"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // The fused kernel is CPU only.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+
+  int found_fused = 0;
+  int found_plain = 0;
+  const NodeDef* train_node = nullptr;
+  for (const NodeDef& node : output.node()) {
+    if (node.op() == "_FusedApplyAdam") {
+      ++found_fused;
+      EXPECT_EQ(node.attr().at("N").i(), 3);
+      ASSERT_EQ(node.input_size(), 18);
+      EXPECT_EQ(node.input(0), "var_0");
+      EXPECT_EQ(node.input(3), "m_0");
+      EXPECT_EQ(node.input(6), "v_0");
+      EXPECT_EQ(node.input(9), "beta1_power");
+      EXPECT_EQ(node.input(15), "grad_0");
+    } else if (node.op() == "ResourceApplyAdam") {
+      ++found_plain;
+    }
+    if (node.name() == "train") train_node = &node;
+  }
+  EXPECT_EQ(found_fused, 1);
+  EXPECT_EQ(found_plain, 0);
+
+  // All three control edges collapse onto the fused node, which takes over
+  // the name of the first grouped update.
+  ASSERT_NE(train_node, nullptr);
+  for (const string& input : train_node->input()) {
+    EXPECT_EQ(input, "^apply_0");
+  }
+}
+
+TEST_F(RemapperTest, FuseAttention) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto query_shape = ops::Placeholder::Shape({2, 4, 8});
+  auto key_shape = ops::Placeholder::Shape({2, 6, 8});
+  auto value_shape = ops::Placeholder::Shape({2, 6, 16});
+
+  auto query = Placeholder(s.WithOpName("query"), DT_FLOAT, query_shape);
+  auto key = Placeholder(s.WithOpName("key"), DT_FLOAT, key_shape);
+  auto value = Placeholder(s.WithOpName("value"), DT_FLOAT, value_shape);
+  auto scale = ops::Const(s.WithOpName("scale"), 0.35355339f, {});
+
+  auto scores = ops::BatchMatMulV2(s.WithOpName("scores"), query, key,
+                                   ops::BatchMatMulV2::AdjY(true));
+  auto scaled = ops::Mul(s.WithOpName("scaled"), scores, scale);
+  auto softmax = ops::Softmax(s.WithOpName("softmax"), scaled);
+  auto output = ops::BatchMatMulV2(s.WithOpName("output"), softmax, value);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+  auto query_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 8});
+  auto key_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 6, 8});
+  auto value_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 6, 16});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  int found = 0;
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "output") {
+      EXPECT_EQ(node.op(), "_FusedAttention");
+      ASSERT_GE(node.input_size(), 4);
+      EXPECT_EQ(node.input(0), "query");
+      EXPECT_EQ(node.input(1), "key");
+      EXPECT_EQ(node.input(2), "value");
+      EXPECT_EQ(node.input(3), "scale");
+      EXPECT_FALSE(node.attr().at("use_reciprocal_scale").b());
+      found++;
+    }
+  }
+  EXPECT_EQ(1, found);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+}
+
+TEST_F(RemapperTest, FuseAttentionWithReciprocalScale) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto query_shape = ops::Placeholder::Shape({2, 4, 8});
+  auto key_shape = ops::Placeholder::Shape({2, 6, 8});
+  auto value_shape = ops::Placeholder::Shape({2, 6, 16});
+
+  auto query = Placeholder(s.WithOpName("query"), DT_FLOAT, query_shape);
+  auto key = Placeholder(s.WithOpName("key"), DT_FLOAT, key_shape);
+  auto value = Placeholder(s.WithOpName("value"), DT_FLOAT, value_shape);
+  auto scale = ops::Const(s.WithOpName("scale"), 2.82842712f, {});
+
+  auto scores = ops::BatchMatMulV2(s.WithOpName("scores"), query, key,
+                                   ops::BatchMatMulV2::AdjY(true));
+  auto scaled = ops::RealDiv(s.WithOpName("scaled"), scores, scale);
+  auto softmax = ops::Softmax(s.WithOpName("softmax"), scaled);
+  auto output = ops::BatchMatMulV2(s.WithOpName("output"), softmax, value);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), output);
+
+  auto query_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 4, 8});
+  auto key_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 6, 8});
+  auto value_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 6, 16});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"query", query_t}, {"key", key_t}, {"value", value_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  int found = 0;
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "output") {
+      EXPECT_EQ(node.op(), "_FusedAttention");
+      ASSERT_GE(node.input_size(), 4);
+      EXPECT_EQ(node.input(3), "scale");
+      EXPECT_TRUE(node.attr().at("use_reciprocal_scale").b());
+      found++;
+    }
+  }
+  EXPECT_EQ(1, found);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+}
+
+TEST_F(RemapperTest, Sparse24MatMul) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  // [8, 6] weight with 2:4 structured sparsity along the reduction
+  // dimension: in every group of 4 consecutive rows of a column, at most 2
+  // entries are non-zero (groups with 2, 1 and 0 non-zeros all occur).
+  Tensor weights_t(DT_FLOAT, TensorShape({8, 6}));
+  weights_t.flat<float>().setZero();
+  auto weights_m = weights_t.matrix<float>();
+  for (int col = 0; col < 6; ++col) {
+    weights_m(col % 4, col) = 1.0f + col;
+    if (col % 3 != 0) weights_m((col + 2) % 4, col) = 2.0f - col;
+    if (col % 2 == 0) weights_m(4 + col % 4, col) = 0.5f * (col + 1);
+  }
+
+  auto input_shape = ops::Placeholder::Shape({4, 8});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto weights = ops::Const(s.WithOpName("weights"), Input::Initializer(weights_t));
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), matmul);
+
+  auto input_t = GenerateTensorWithSetRandom<DT_FLOAT>({4, 8});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"input", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  int found = 0;
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "matmul") {
+      EXPECT_EQ(node.op(), "_Sparse24MatMul");
+      ASSERT_GE(node.input_size(), 3);
+      EXPECT_EQ(node.input(0), "input");
+      EXPECT_EQ(node.input(1), "matmul/sparse24_values");
+      EXPECT_EQ(node.input(2), "matmul/sparse24_metadata");
+      found++;
+    }
+  }
+  EXPECT_EQ(1, found);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+}
+
+TEST_F(RemapperTest, Sparse24MatMulTransposedWeights) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  // Same pattern as above but stored as [n, k], consumed with
+  // transpose_b = true: groups run along the second dimension.
+  Tensor weights_t(DT_FLOAT, TensorShape({6, 8}));
+  weights_t.flat<float>().setZero();
+  auto weights_m = weights_t.matrix<float>();
+  for (int row = 0; row < 6; ++row) {
+    weights_m(row, row % 4) = 1.0f + row;
+    weights_m(row, 4 + (row + 1) % 4) = -1.0f - row;
+  }
+
+  auto input_shape = ops::Placeholder::Shape({4, 8});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto weights = ops::Const(s.WithOpName("weights"), Input::Initializer(weights_t));
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights,
+                            ops::MatMul::TransposeB(true));
+  auto fetch = ops::Identity(s.WithOpName("fetch"), matmul);
+
+  auto input_t = GenerateTensorWithSetRandom<DT_FLOAT>({4, 8});
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  item.feed = {{"input", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  int found = 0;
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "matmul") {
+      EXPECT_EQ(node.op(), "_Sparse24MatMul");
+      found++;
+    }
+  }
+  EXPECT_EQ(1, found);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 1);
+  auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 1);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+}
+
+TEST_F(RemapperTest, Sparse24MatMulDenseWeightsNotRewritten) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  // A dense weight (3 non-zeros in the first group of some column) must be
+  // left untouched.
+  Tensor weights_t(DT_FLOAT, TensorShape({8, 6}));
+  weights_t.flat<float>().setConstant(1.0f);
+
+  auto input_shape = ops::Placeholder::Shape({4, 8});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto weights = ops::Const(s.WithOpName("weights"), Input::Initializer(weights_t));
+  auto matmul = ops::MatMul(s.WithOpName("matmul"), input, weights);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), matmul);
+
+  GrapplerItem item;
+  item.fetch = {"fetch"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "matmul") {
+      EXPECT_EQ(node.op(), "MatMul");
+    }
+  }
+}
+
+TEST_F(RemapperTest, EmbeddingLookupSparse) {
+  using ::tensorflow::ops::Placeholder;
+
+  // The expansion of tf.nn.embedding_lookup_sparse: gather embedding rows,
+  // then pool them per segment. Each combiner maps to the matching
+  // SparseSegment* reduction; segment 2 holds three ids so the mean and
+  // sqrtn scaling and per-segment accumulation are exercised.
+  for (const string& combiner : {"sum", "mean", "sqrtn"}) {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+    auto params_shape = ops::Placeholder::Shape({10, 4});
+    auto params = Placeholder(s.WithOpName("params"), DT_FLOAT, params_shape);
+    auto ids = ops::Const(s.WithOpName("ids"), {7, 3, 0, 9, 5}, {5});
+    auto indices = ops::Const(s.WithOpName("indices"), {0, 1, 2, 3, 4, 2}, {6});
+    auto segment_ids =
+        ops::Const(s.WithOpName("segment_ids"), {0, 0, 1, 2, 2, 2}, {6});
+    auto gather = ops::GatherV2(s.WithOpName("gather"), params, ids, 0);
+
+    Output pool;
+    if (combiner == "sum") {
+      pool = ops::SparseSegmentSum(s.WithOpName("pool"), gather, indices,
+                                   segment_ids);
+    } else if (combiner == "mean") {
+      pool = ops::SparseSegmentMean(s.WithOpName("pool"), gather, indices,
+                                    segment_ids);
+    } else {
+      pool = ops::SparseSegmentSqrtN(s.WithOpName("pool"), gather, indices,
+                                     segment_ids);
+    }
+    auto fetch = ops::Identity(s.WithOpName("fetch"), pool);
+
+    auto params_t = GenerateTensorWithSetRandom<DT_FLOAT>({10, 4});
+
+    GrapplerItem item;
+    item.fetch = {"fetch"};
+    item.feed = {{"params", params_t}};
+    TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+    // Place all nodes on CPU.
+    for (int i = 0; i < item.graph.node_size(); ++i) {
+      item.graph.mutable_node(i)->set_device("/device:CPU:0");
+    }
+
+    Remapper optimizer(RewriterConfig::ON);
+    GraphDef output_graph;
+    TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+    int found = 0;
+    for (const NodeDef& node : output_graph.node()) {
+      if (node.name() == "pool") {
+        EXPECT_EQ(node.op(), "_EmbeddingLookupSparse");
+        ASSERT_GE(node.input_size(), 3);
+        EXPECT_EQ(node.input(0), "params");
+        EXPECT_EQ(node.input(1), "pool/embedding_ids");
+        EXPECT_EQ(node.input(2), "segment_ids");
+        EXPECT_EQ(node.attr().at("combiner").s(), combiner);
+        found++;
+      }
+    }
+    EXPECT_EQ(1, found) << "combiner=" << combiner;
+
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors_expected.size(), 1);
+    auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+  }
+}
+
+TEST_F(RemapperTest, EmbeddingLookupSparseSharedGatherNotRewritten) {
+  using ::tensorflow::ops::Placeholder;
+
+  // If the gathered embeddings have another consumer the intermediate must
+  // be materialized anyway, so the reduction is left untouched.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto params_shape = ops::Placeholder::Shape({10, 4});
+  auto params = Placeholder(s.WithOpName("params"), DT_FLOAT, params_shape);
+  auto ids = ops::Const(s.WithOpName("ids"), {7, 3, 0}, {3});
+  auto indices = ops::Const(s.WithOpName("indices"), {0, 1, 2}, {3});
+  auto segment_ids = ops::Const(s.WithOpName("segment_ids"), {0, 0, 1}, {3});
+  auto gather = ops::GatherV2(s.WithOpName("gather"), params, ids, 0);
+  auto pool = ops::SparseSegmentSum(s.WithOpName("pool"), gather, indices,
+                                    segment_ids);
+  auto fetch = ops::Identity(s.WithOpName("fetch"), pool);
+  auto fetch_rows = ops::Identity(s.WithOpName("fetch_rows"), gather);
+
+  GrapplerItem item;
+  item.fetch = {"fetch", "fetch_rows"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "pool") {
+      EXPECT_EQ(node.op(), "SparseSegmentSum");
+    }
+  }
+}
+
+TEST_F(RemapperTest, FuseMoments) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({2, 3, 4});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  auto axes = ops::Const(s.WithOpName("axes"), {-2, -1}, {2});
+
+  // The subgraph tf.nn.moments emits for mean and variance.
+  auto mean =
+      ops::Mean(s.WithOpName("mean"), input, axes, ops::Mean::KeepDims(true));
+  auto stop_gradient = ops::StopGradient(s.WithOpName("stop_gradient"), mean);
+  auto squared_diff = ops::SquaredDifference(s.WithOpName("squared_diff"),
+                                             input, stop_gradient);
+  auto variance = ops::Mean(s.WithOpName("variance"), squared_diff, axes,
+                            ops::Mean::KeepDims(true));
+  auto fetch_mean = ops::Identity(s.WithOpName("fetch_mean"), mean);
+  auto fetch_variance = ops::Identity(s.WithOpName("fetch_variance"), variance);
+
+  auto input_t = GenerateTensorWithSetRandom<DT_FLOAT>({2, 3, 4});
+
+  GrapplerItem item;
+  item.fetch = {"fetch_mean", "fetch_variance"};
+  item.feed = {{"input", input_t}};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  // Place all nodes on CPU.
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  int found = 0;
+  for (const NodeDef& node : output_graph.node()) {
+    if (node.name() == "mean") {
+      EXPECT_EQ(node.op(), "_FusedMoments");
+      ASSERT_EQ(node.input_size(), 2);
+      EXPECT_EQ(node.input(0), "input");
+      EXPECT_EQ(node.input(1), "axes");
+      EXPECT_TRUE(node.attr().at("keep_dims").b());
+      found++;
+    } else if (node.name() == "variance") {
+      EXPECT_EQ(node.op(), "Identity");
+      ASSERT_EQ(node.input_size(), 1);
+      EXPECT_EQ(node.input(0), "mean:1");
+      found++;
+    }
+  }
+  EXPECT_EQ(2, found);
+
+  auto tensors_expected = EvaluateNodes(item.graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors_expected.size(), 2);
+  auto tensors = EvaluateNodes(output_graph, item.fetch, item.feed);
+  ASSERT_EQ(tensors.size(), 2);
+  test::ExpectClose(tensors[0], tensors_expected[0], 1e-6);
+  test::ExpectClose(tensors[1], tensors_expected[1], 1e-6);
+}
+
+TEST_F(RemapperTest, FuseMomentsNonContiguousAxes) {
+  using ::tensorflow::ops::Placeholder;
+
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+
+  auto input_shape = ops::Placeholder::Shape({2, 3, 4});
+  auto input = Placeholder(s.WithOpName("input"), DT_FLOAT, input_shape);
+  // The fused kernel only handles a contiguous leading or trailing range of
+  // dimensions, so this subgraph must be left alone.
+  auto axes = ops::Const(s.WithOpName("axes"), {0, 2}, {2});
+
+  auto mean =
+      ops::Mean(s.WithOpName("mean"), input, axes, ops::Mean::KeepDims(true));
+  auto stop_gradient = ops::StopGradient(s.WithOpName("stop_gradient"), mean);
+  auto squared_diff = ops::SquaredDifference(s.WithOpName("squared_diff"),
+                                             input, stop_gradient);
+  auto variance = ops::Mean(s.WithOpName("variance"), squared_diff, axes,
+                            ops::Mean::KeepDims(true));
+  auto fetch_mean = ops::Identity(s.WithOpName("fetch_mean"), mean);
+  auto fetch_variance = ops::Identity(s.WithOpName("fetch_variance"), variance);
+
+  GrapplerItem item;
+  item.fetch = {"fetch_mean", "fetch_variance"};
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  for (int i = 0; i < item.graph.node_size(); ++i) {
+    item.graph.mutable_node(i)->set_device("/device:CPU:0");
+  }
+
+  Remapper optimizer(RewriterConfig::ON);
+  GraphDef output_graph;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output_graph));
+
+  for (const NodeDef& node : output_graph.node()) {
+    EXPECT_NE(node.op(), "_FusedMoments");
+  }
+}
+
 class RemapperFuseMatMulWithBiasTest : public RemapperTest {
  public:
   template <DataType DTYPE>
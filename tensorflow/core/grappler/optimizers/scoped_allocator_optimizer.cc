@@ -891,7 +891,7 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
 
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
-    : opt_level_(opt_level) {
+    : opt_level_(opt_level), max_bytes_per_group_(opts.max_bytes_per_group()) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
   Rewriter* r = new UnaryElementwiseRewriter();
   to_delete_.push_back(r);
@@ -1063,6 +1063,56 @@ void PartitionByLoopStructure(const FrameView& frame_view,
   }
 }
 
+// Returns the size in bytes of the single output of `node`, or -1 if the
+// type or shape is not fully known.
+int64_t NodeOutputBytes(const GraphProperties& graph_properties,
+                        const NodeDef& node) {
+  if (!graph_properties.HasOutputProperties(node.name())) return -1;
+  const std::vector<OpInfo::TensorProperties>& prop_list =
+      graph_properties.GetOutputProperties(node.name());
+  if (prop_list.size() != 1) return -1;
+  const OpInfo::TensorProperties& props = prop_list[0];
+  if (!TensorShape::IsValid(props.shape()) || props.shape().unknown_rank()) {
+    return -1;
+  }
+  const int64_t elt_bytes = DataTypeSize(props.dtype());
+  if (elt_bytes <= 0) return -1;
+  return TensorShape(props.shape()).num_elements() * elt_bytes;
+}
+
+// Splits `nodes`, preserving order, into consecutive buckets whose combined
+// output size does not exceed `max_bytes_per_group`. A node whose size is
+// unknown gets a bucket of its own, so it is left unfused instead of making
+// the whole group unfusable; so does a single node larger than the limit.
+void PartitionByByteSize(const GraphProperties& graph_properties,
+                         int64_t max_bytes_per_group,
+                         std::vector<NodeDef*> nodes,
+                         std::vector<std::vector<NodeDef*>>* buckets) {
+  if (max_bytes_per_group <= 0) {
+    buckets->push_back(std::move(nodes));
+    return;
+  }
+  std::vector<NodeDef*> current;
+  int64_t current_bytes = 0;
+  for (NodeDef* nd : nodes) {
+    const int64_t bytes = NodeOutputBytes(graph_properties, *nd);
+    if (bytes < 0) {
+      buckets->push_back({nd});
+      continue;
+    }
+    if (!current.empty() && current_bytes + bytes > max_bytes_per_group) {
+      buckets->push_back(std::move(current));
+      current.clear();
+      current_bytes = 0;
+    }
+    current.push_back(nd);
+    current_bytes += bytes;
+  }
+  if (!current.empty()) {
+    buckets->push_back(std::move(current));
+  }
+}
+
 // Identify outputs that are inputs to multiple sets of nodes.
 void IdentifyRepeatedInputs(const std::vector<NodeDef*>& nodes,
                             absl::flat_hash_set<string>* seen_outputs,
@@ -1124,7 +1174,8 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
         // in the same Tree struct.  Split those groups into subgroups that
         // share identical loop nesting.
         status = ApplyToAll(root.get(), [this, rewriter, graph, &frame_view,
-                                         &op_name, invocation_count](Tree* t) {
+                                         &graph_properties, &op_name,
+                                         invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
           if (t->nodes_.size() > 1) {
@@ -1132,13 +1183,22 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
               if (lg.size() > 1) {
-                bool applied = false;
                 Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
-                VLOG(1) << "Applying Rewriter for " << op_name;
-                s = rewriter->Rewrite(this, invocation_count, graph, op_name,
-                                      lg, &applied);
-                LOG_WARNING_AND_RETURN_IF_ERROR(s);
+                // Optionally bound the bytes fused into one allocation so
+                // each bucket can run as soon as its own inputs are ready.
+                std::vector<std::vector<NodeDef*>> buckets;
+                PartitionByByteSize(graph_properties, max_bytes_per_group_,
+                                    std::move(lg), &buckets);
+                for (auto& bucket : buckets) {
+                  if (bucket.size() > 1) {
+                    bool applied = false;
+                    VLOG(1) << "Applying Rewriter for " << op_name;
+                    s = rewriter->Rewrite(this, invocation_count, graph,
+                                          op_name, bucket, &applied);
+                    LOG_WARNING_AND_RETURN_IF_ERROR(s);
+                  }
+                }
               }
             }
           }
@@ -414,6 +414,33 @@ TEST_F(ScopedAllocatorOptimizerTest, UnaryRewriteOnly) {
   }
 }
 
+TEST_F(ScopedAllocatorOptimizerTest, MaxBytesPerGroup) {
+  // The two 2x2 float Abs ops are 16 bytes each. A 32-byte bucket limit
+  // still fuses them into one scoped allocation; a 16-byte limit puts each
+  // in its own bucket, and single-node buckets are left unfused.
+  for (const auto& [max_bytes, expected_scoped_allocators] :
+       std::vector<std::pair<int64_t, int>>{{32, 1}, {16, 0}}) {
+    GrapplerItem item;
+    BuildAbsGraph(&item.graph, false);
+    SetShapes(&item.graph);
+
+    ScopedAllocatorOptions opts;
+    opts.add_enable_op("Abs");
+    opts.set_max_bytes_per_group(max_bytes);
+    ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+    GraphDef optimized_graph;
+    TF_ASSERT_OK(sao.Optimize(nullptr /*cluster*/, item, &optimized_graph));
+
+    int num_scoped_allocators = 0;
+    for (const NodeDef& node : optimized_graph.node()) {
+      if (node.op() == "_ScopedAllocator") ++num_scoped_allocators;
+    }
+    EXPECT_EQ(expected_scoped_allocators, num_scoped_allocators)
+        << "max_bytes_per_group=" << max_bytes;
+  }
+}
+
 TEST_F(ScopedAllocatorOptimizerTest, UnaryExecute) {
   // Builds the same graph as UnaryRewriteOnly but also executes it and
   // validates the output.
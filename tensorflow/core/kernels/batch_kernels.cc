@@ -162,6 +162,7 @@ class BatchResource : public serving::BatchResourceBase {
                        int32_t max_enqueued_batches,
                        const std::vector<int32>& allowed_batch_sizes,
                        bool enable_large_batch_splitting,
+                       bool enable_ragged_batch,
                        std::unique_ptr<BatchResource>* resource) {
     return Create(has_process_batch_function, num_batch_threads,
                   max_execution_batch_size, batch_timeout_micros,
@@ -170,7 +171,7 @@ class BatchResource : public serving::BatchResourceBase {
                   /*low_priority_batch_timeout_micros=*/0,
                   /*low_priority_max_enqueued_batches=*/0,
                   /*low_priority_allowed_batch_sizes=*/{},
-                  enable_large_batch_splitting, resource);
+                  enable_large_batch_splitting, enable_ragged_batch, resource);
   }
 
   static Status Create(
@@ -182,7 +183,7 @@ class BatchResource : public serving::BatchResourceBase {
       int32_t low_priority_batch_timeout_micros,
       int32_t low_priority_max_enqueued_batches,
       const std::vector<int32>& low_priority_allowed_batch_sizes,
-      bool enable_large_batch_splitting,
+      bool enable_large_batch_splitting, bool enable_ragged_batch,
       std::unique_ptr<BatchResource>* resource) {
     BatcherT::Options batcher_options;
     batcher_options.num_batch_threads = num_batch_threads;
@@ -195,11 +196,12 @@ class BatchResource : public serving::BatchResourceBase {
             num_batch_threads, max_execution_batch_size, batch_timeout_micros,
             max_enqueued_batches, allowed_batch_sizes,
             enable_large_batch_splitting,
-            /*disable_padding=*/false, low_priority_max_batch_size,
-            low_priority_batch_timeout_micros,
+            /*disable_padding=*/enable_ragged_batch,
+            low_priority_max_batch_size, low_priority_batch_timeout_micros,
             low_priority_max_enqueued_batches,
             low_priority_allowed_batch_sizes),
         allowed_batch_sizes));
+    (*resource)->set_emit_task_lengths(enable_ragged_batch);
     return OkStatus();
   }
 
@@ -208,7 +210,7 @@ class BatchResource : public serving::BatchResourceBase {
       AdaptiveBatcherT::Options adaptive_shared_batch_scheduler_options,
       int32_t max_batch_size, int32_t batch_timeout_micros,
       int32_t max_enqueued_batches,
-      const std::vector<int32>& allowed_batch_sizes,
+      const std::vector<int32>& allowed_batch_sizes, bool enable_ragged_batch,
       std::unique_ptr<BatchResource>* resource) {
     std::shared_ptr<AdaptiveBatcherT> batcher;
     TF_RETURN_IF_ERROR(AdaptiveBatcherT::Create(
@@ -219,8 +221,9 @@ class BatchResource : public serving::BatchResourceBase {
         GetAdaptiveBatcherQueueOptions(
             max_batch_size, batch_timeout_micros, max_enqueued_batches,
             /*enable_large_batch_splitting=*/true, allowed_batch_sizes,
-            /*disable_padding=*/false),
+            /*disable_padding=*/enable_ragged_batch),
         allowed_batch_sizes));
+    (*resource)->set_emit_task_lengths(enable_ragged_batch);
     return OkStatus();
   }
 
@@ -304,6 +307,10 @@ BatchFunctionKernel::BatchFunctionKernel(OpKernelConstruction* c)
     has_attribute_enable_large_batch_splitting_ = true;
   }
 
+  if (c->HasAttr("enable_ragged_batch")) {
+    OP_REQUIRES_OK(c, c->GetAttr("enable_ragged_batch", &enable_ragged_batch_));
+  }
+
   // Helper function `SetAdaptiveBatchSchedulerOptions` calls
   // `OP_REQUIRES_OK`, which exits the current function upon error.
   // So validate status of `op-kernel-construction`.
@@ -406,7 +413,7 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
           /*has_process_batch_function=*/true,
           adaptive_shared_batch_scheduler_options, max_batch_size_,
           batch_timeout_micros_, max_enqueued_batches_, allowed_batch_sizes_,
-          &new_resource));
+          enable_ragged_batch_, &new_resource));
       if (session_metadata) {
         new_resource->set_session_metadata(*session_metadata);
       }
@@ -423,7 +430,7 @@ void BatchFunctionKernel::ComputeAsync(OpKernelContext* c, DoneCallback done) {
           allowed_batch_sizes_, low_priority_max_batch_size_,
           low_priority_batch_timeout_micros_,
           low_priority_max_enqueued_batches_, low_priority_allowed_batch_sizes_,
-          enable_large_batch_splitting_, &new_resource));
+          enable_large_batch_splitting_, enable_ragged_batch_, &new_resource));
       if (session_metadata) {
         new_resource->set_session_metadata(*session_metadata);
       }
@@ -492,6 +499,11 @@ Status BatchFunctionKernel::InstantiateFunction(
       opts.input_devices.push_back(cpu_device->name());
     }
   }
+  if (enable_ragged_batch_) {
+    // The per-request lengths vector is built on CPU alongside the
+    // concatenated inputs.
+    opts.input_devices.push_back(cpu_device->name());
+  }
   OpInputList captured_tensors;
   TF_RETURN_IF_ERROR(c->input_list("captured_tensors", &captured_tensors));
   for (const Tensor& t : captured_tensors) {
@@ -508,6 +520,15 @@ Status BatchFunctionKernel::InstantiateFunction(
     opts.output_devices.push_back(cpu_device->name());
   }
   if (opts.input_devices.size() != signature.input_arg_size()) {
+    if (enable_ragged_batch_ &&
+        opts.input_devices.size() == signature.input_arg_size() + 1) {
+      return errors::InvalidArgument(
+          "enable_ragged_batch requires the batch function to accept an "
+          "additional int32 lengths argument after its batched arguments, "
+          "but \"",
+          func_.name(), "\" takes only ", signature.input_arg_size(),
+          " argument(s)");
+    }
     return errors::InvalidArgument(
         "Function takes ", signature.input_arg_size(), " argument(s) but ",
         opts.input_devices.size(), " argument(s) were passed");
@@ -665,7 +686,8 @@ class BatchKernel : public AsyncOpKernel {
       TF_RETURN_IF_ERROR(BatchResource::Create(
           /*has_process_batch_function=*/false, num_batch_threads_,
           max_batch_size_, batch_timeout_micros_, max_enqueued_batches_,
-          allowed_batch_sizes_, false, &new_resource));
+          allowed_batch_sizes_, /*enable_large_batch_splitting=*/false,
+          /*enable_ragged_batch=*/false, &new_resource));
       *r = new_resource.release();
       return OkStatus();
     };
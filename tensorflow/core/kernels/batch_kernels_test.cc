@@ -277,5 +277,125 @@ TEST_P(BatchFunctionKernelParallelWarmupTest, ParallelWarmupAutoBatch) {
 INSTANTIATE_TEST_SUITE_P(BatchFunctionKernelParallelWarmupTestSuite,
                          BatchFunctionKernelParallelWarmupTest,
                          ::testing::Bool());
+
+class BatchFunctionKernelRaggedBatchTestState : public OpsTestBase {
+ public:
+  // Init test fixture with a batch kernel instance. `with_lengths_arg`
+  // controls whether the batch function declares the extra int32 lengths
+  // argument that `enable_ragged_batch` feeds.
+  Status Init(bool with_lengths_arg) {
+    static auto *const cpu_device = []() {
+      auto device =
+          DeviceFactory::NewDevice("CPU", {}, "/job:a/replica:0/task:0");
+      return device.release();
+    }();
+
+    // Override the per-test/per-op device with a global device so that it can
+    // be shared between ops.
+    device_ = cpu_device;
+
+    NameAttrList f;
+    f.set_name("BatchFunctionKernelRaggedBatchTestStateFunc");
+    FunctionDef func;
+    if (with_lengths_arg) {
+      // `EnsureShape` fails if the batch was padded to the next allowed batch
+      // size (4); the lengths argument is broadcast-added so its value shows
+      // up in the output.
+      func = FunctionDefHelper::Create(
+          // function_name
+          f.name(),
+          // in_def
+          {"x:int64", "lengths:int32"},
+          // out_def
+          {"o:int64"},
+          // attr_def
+          {},
+          // node_def
+          {{{"unpadded"},
+            "EnsureShape",
+            {"x"},
+            {{"T", DataType::DT_INT64}, {"shape", TensorShape({3})}}},
+           {{"lengths_int64"},
+            "Cast",
+            {"lengths"},
+            {{"SrcT", DataType::DT_INT32}, {"DstT", DataType::DT_INT64}}},
+           {{"o"},
+            "AddV2",
+            {"unpadded:output:0", "lengths_int64:y:0"},
+            {{"T", DataType::DT_INT64}}}},
+          // ret_def
+          {{"o", "o:z:0"}});
+    } else {
+      func = FunctionDefHelper::Create(
+          // function_name
+          f.name(),
+          // in_def
+          {"x:int64"},
+          // out_def
+          {"o:int64"},
+          // attr_def
+          {},
+          // node_def
+          {{{"o"}, "Identity", {"x"}, {{"T", DataType::DT_INT64}}}},
+          // ret_def
+          {{"o", "o:output"}});
+    }
+    TF_RETURN_IF_ERROR(flib_def_->AddFunctionDef(func));
+
+    pflr_ = std::make_unique<ProcessFunctionLibraryRuntime>(
+        device_mgr_.get(), Env::Default(), /*config=*/nullptr,
+        TF_GRAPH_DEF_VERSION, flib_def_.get(), OptimizerOptions(),
+        /*thread_pool=*/nullptr, /*parent=*/nullptr,
+        /*session_metadata=*/nullptr,
+        Rendezvous::Factory{[](const int64_t, const DeviceMgr *device_mgr,
+                               tsl::core::RefCountPtr<Rendezvous> *r) {
+          *r = tsl::core::RefCountPtr<Rendezvous>(
+              new IntraProcessRendezvous(device_mgr));
+          return OkStatus();
+        }});
+
+    std::vector<NodeDefBuilder::NodeOut> inputs(
+        {NodeDefBuilder::NodeOut({"n1", 0, DataType::DT_INT64})});
+    TF_CHECK_OK(NodeDefBuilder("RaggedBatchInput", "BatchFunction")
+                    .Attr("max_batch_size", 8)
+                    .Attr("num_batch_threads", 8)
+                    .Attr("allowed_batch_sizes", {2, 4, 8})
+                    .Attr("batch_timeout_micros", 100000)
+                    .Attr("max_enqueued_batches", 10)
+                    .Attr("enable_ragged_batch", true)
+                    .Attr("Tin", {DataType::DT_INT64})
+                    .Input(inputs)
+                    .Attr("Tcaptured", std::vector<DataType>{})
+                    .Input(std::vector<NodeDefBuilder::NodeOut>{})
+                    .Attr("Tout", std::vector<DataType>{DT_INT64})
+                    .Attr("f", f)
+                    .Finalize(node_def()));
+    return InitOp();
+  }
+
+  void TestBody() override {}
+};
+
+TEST(BatchFunctionKernelRaggedBatchTest, ExecutesUnpaddedBatch) {
+  BatchFunctionKernelRaggedBatchTestState test;
+  TF_CHECK_OK(test.Init(/*with_lengths_arg=*/true));
+  test.AddInputFromList<int64_t>(TensorShape({3}), {1, 2, 3});
+  TF_CHECK_OK(test.RunOpKernel());
+
+  // The batch of size 3 runs unpadded, and the lengths argument holds the
+  // single task's size (3), which the function adds to every element.
+  test::ExpectTensorEqual<int64_t>(*test.GetOutput(0),
+                                   test::AsTensor<int64_t>({4, 5, 6}));
+}
+
+TEST(BatchFunctionKernelRaggedBatchTest, RequiresLengthsArgument) {
+  BatchFunctionKernelRaggedBatchTestState test;
+  TF_CHECK_OK(test.Init(/*with_lengths_arg=*/false));
+  test.AddInputFromList<int64_t>(TensorShape({3}), {1, 2, 3});
+  auto status = test.RunOpKernel();
+  ASSERT_FALSE(status.ok());
+  EXPECT_TRUE(absl::StrContains(status.message(),
+                                "additional int32 lengths argument"));
+}
 }  // namespace
 }  // namespace tensorflow
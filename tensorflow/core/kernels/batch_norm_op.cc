@@ -64,9 +64,11 @@ class BatchNormOp : public OpKernel {
                 errors::InvalidArgument("gamma must be 1-dimensional",
                                         gamma.shape().DebugString()));
 
+    // The normalization is coefficient-wise in the input, so the input buffer
+    // can be reused for the output when the kernel owns it exclusively.
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, input.shape(), &output));
 
     functor::BatchNorm<Device, T>()(
         context->eigen_device<Device>(), input.tensor<T, 4>(), mean.vec<T>(),
@@ -19,6 +19,7 @@ limitations under the License.
 #include <algorithm>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <random>
 #include <unordered_map>
@@ -171,6 +172,19 @@ class AdaptiveSharedBatchScheduler
 
     // If true, the padding will not be appended.
     bool disable_padding = false;
+
+    // Priority of the lane this queue belongs to. A schedulable batch from a
+    // higher-priority lane is scheduled before batches from lower-priority
+    // lanes regardless of age; the age-based selection above applies within a
+    // lane. Has no effect under `fifo_scheduling`.
+    int priority = 0;
+    // If set, target queueing delay for this lane, in microseconds: the time
+    // between a batch's creation and the start of its processing. A batch
+    // which has not filled up by this deadline is closed early and becomes
+    // schedulable; if a batch thread is idle it is processed immediately,
+    // ahead of queued batches from lanes without a pending deadline, even
+    // when in_flight_batches_limit_ has been reached.
+    absl::optional<int64_t> latency_slo_micros = absl::nullopt;
   };
 
   using BatchProcessor = std::function<void(std::unique_ptr<Batch<TaskType>>)>;
@@ -185,6 +199,27 @@ class AdaptiveSharedBatchScheduler
     return in_flight_batches_limit_;
   }
 
+  // Snapshot of the state learned by the in-flight batches limit controller.
+  // Can be exported from a warmed-up scheduler and restored into a fresh one
+  // (e.g. across a process restart), so batching starts at steady state
+  // instead of re-learning under live traffic.
+  struct SchedulerState {
+    // Learned limit on concurrently processed batches.
+    double in_flight_batches_limit = 0;
+    // Current adjustment size (as a fraction of in_flight_batches_limit).
+    double step_size_multiplier = 0;
+    // Current direction (+-) of in_flight_batches_limit adjustments.
+    int step_direction = 1;
+    // Average batch latency under the previous limit, in milliseconds.
+    double last_avg_latency_ms = 0;
+  };
+
+  SchedulerState GetSchedulerState();
+
+  // Restores state captured by `GetSchedulerState`. Values are clamped to
+  // this scheduler's valid range, and the latency averaging window is reset.
+  void RestoreSchedulerState(const SchedulerState& state);
+
  private:
   // access to AddBatch, MaybeScheduleClosedBatches, RemoveQueue, GetEnv.
   friend class internal::ASBSQueue<TaskType>;
@@ -345,11 +380,19 @@ class ASBSQueue : public BatchScheduler<TaskType> {
 template <typename TaskType>
 class ASBSBatch : public Batch<TaskType> {
  public:
+  // deadline_micros value for batches whose queue has no latency SLO.
+  static constexpr int64_t kNoDeadline = std::numeric_limits<int64_t>::max();
+
   ASBSBatch(ASBSQueue<TaskType>* queue, int64_t creation_time_micros,
-            int64_t batch_timeout_micros, uint64 traceme_context_id)
+            int64_t batch_timeout_micros, int priority,
+            int64_t deadline_micros, uint64 traceme_context_id)
       : queue_(queue),
         creation_time_micros_(creation_time_micros),
-        schedulable_time_micros_(creation_time_micros + batch_timeout_micros),
+        // A batch never waits out its timeout past the lane's SLO deadline.
+        schedulable_time_micros_(std::min(
+            creation_time_micros + batch_timeout_micros, deadline_micros)),
+        priority_(priority),
+        deadline_micros_(deadline_micros),
         traceme_context_id_(traceme_context_id) {}
 
   ~ASBSBatch() override {}
@@ -360,12 +403,18 @@ class ASBSBatch : public Batch<TaskType> {
 
   int64_t schedulable_time_micros() const { return schedulable_time_micros_; }
 
+  int priority() const { return priority_; }
+
+  int64_t deadline_micros() const { return deadline_micros_; }
+
   uint64 traceme_context_id() const { return traceme_context_id_; }
 
  private:
   ASBSQueue<TaskType>* queue_;
   const int64_t creation_time_micros_;
   const int64_t schedulable_time_micros_;
+  const int priority_;
+  const int64_t deadline_micros_;
   const uint64 traceme_context_id_;
   ASBSBatch(const ASBSBatch&) = delete;
   void operator=(const ASBSBatch&) = delete;
@@ -467,6 +516,11 @@ Status AdaptiveSharedBatchScheduler<TaskType>::AddQueue(
           options.max_batch_size);
     }
   }
+  if (options.latency_slo_micros.has_value() &&
+      options.latency_slo_micros.value() <= 0) {
+    return errors::InvalidArgument("latency_slo_micros must be positive; was ",
+                                   options.latency_slo_micros.value());
+  }
   internal::ASBSQueue<TaskType>* asbs_queue_raw;
   queue->reset(asbs_queue_raw = new internal::ASBSQueue<TaskType>(
                    this->shared_from_this(), options));
@@ -475,6 +529,35 @@ Status AdaptiveSharedBatchScheduler<TaskType>::AddQueue(
   return OkStatus();
 }
 
+template <typename TaskType>
+typename AdaptiveSharedBatchScheduler<TaskType>::SchedulerState
+AdaptiveSharedBatchScheduler<TaskType>::GetSchedulerState() {
+  mutex_lock l(mu_);
+  SchedulerState state;
+  state.in_flight_batches_limit = in_flight_batches_limit_;
+  state.step_size_multiplier = step_size_multiplier_;
+  state.step_direction = batch_delay_stats_.step_direction;
+  state.last_avg_latency_ms = batch_delay_stats_.last_avg_latency_ms;
+  return state;
+}
+
+template <typename TaskType>
+void AdaptiveSharedBatchScheduler<TaskType>::RestoreSchedulerState(
+    const SchedulerState& state) {
+  mutex_lock l(mu_);
+  in_flight_batches_limit_ =
+      std::max(1.0, std::min(state.in_flight_batches_limit,
+                             static_cast<double>(options_.num_batch_threads)));
+  step_size_multiplier_ =
+      std::max(kMinStepSizeMultiplier,
+               std::min(state.step_size_multiplier, kMaxStepSizeMultiplier));
+  batch_delay_stats_.step_direction = state.step_direction >= 0 ? 1 : -1;
+  batch_delay_stats_.last_avg_latency_ms = state.last_avg_latency_ms;
+  batch_delay_stats_.last_latency_decreased = false;
+  batch_delay_stats_.batch_latency_sum = 0;
+  batch_count_ = 0;
+}
+
 template <typename TaskType>
 void AdaptiveSharedBatchScheduler<TaskType>::AddBatch(
     const internal::ASBSBatch<TaskType>* batch) {
@@ -484,6 +567,19 @@ void AdaptiveSharedBatchScheduler<TaskType>::AddBatch(
   } else {
     batches_.push_back(batch);
   }
+  if (batch->deadline_micros() != internal::ASBSBatch<TaskType>::kNoDeadline) {
+    // Re-examine the batch when its lane's SLO deadline arrives, so it can be
+    // closed early and run on any idle batch thread even if
+    // in_flight_batches_limit_ has been reached.
+    int64_t deadline_delay_micros =
+        std::max<int64_t>(0, batch->deadline_micros() - GetEnv()->NowMicros());
+    GetEnv()->SchedClosureAfter(
+        deadline_delay_micros,
+        [this, lifetime_preserver = this->shared_from_this()] {
+          mutex_lock l(mu_);
+          MaybeScheduleClosedBatchesLocked();
+        });
+  }
   int64_t delay_micros =
       batch->schedulable_time_micros() - GetEnv()->NowMicros();
   if (delay_micros <= 0) {
@@ -531,10 +627,13 @@ void AdaptiveSharedBatchScheduler<
   int available_threads =
       static_cast<int>(options_.num_batch_threads - in_flight_batches_ -
                        in_flight_express_batches_);
+  const int64_t now_micros = GetEnv()->NowMicros();
   for (auto it = fifo_batches_.begin();
        it != fifo_batches_.end() && available_threads > 0;
        it = fifo_batches_.begin()) {
-    if ((*it)->IsClosed()) {
+    // A batch past its lane's SLO deadline is treated as closed; ReleaseBatch
+    // below closes it if it is still open.
+    if ((*it)->IsClosed() || (*it)->deadline_micros() <= now_micros) {
       const internal::ASBSBatch<TaskType>* batch = *it;
       fifo_batches_.pop_front();
       batch->queue()->ReleaseBatch(batch);
@@ -569,15 +668,21 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatch() {
   }
 
   auto best_it = batches_.end();
+  int best_priority = 0;
   double best_score = (std::numeric_limits<double>::max)();
   int64_t now_micros = GetEnv()->NowMicros();
   for (auto it = batches_.begin(); it != batches_.end(); it++) {
     if ((*it)->schedulable_time_micros() > now_micros) continue;
+    const int priority = (*it)->priority();
     const double score =
         (*it)->creation_time_micros() -
         options_.full_batch_scheduling_boost_micros * (*it)->size() /
             static_cast<double>((*it)->queue()->max_task_size());
-    if (best_it == batches_.end() || score < best_score) {
+    // Higher-priority lanes preempt queued batches from lower-priority lanes;
+    // the age/fullness score only breaks ties within a lane.
+    if (best_it == batches_.end() || priority > best_priority ||
+        (priority == best_priority && score < best_score)) {
+      best_priority = priority;
       best_score = score;
       best_it = it;
     }
@@ -611,19 +716,32 @@ void AdaptiveSharedBatchScheduler<
   int available_threads =
       static_cast<int>(options_.num_batch_threads - in_flight_batches_ -
                        in_flight_express_batches_);
-  for (auto it = batches_.begin();
-       it != batches_.end() && available_threads > 0;) {
-    if ((*it)->IsClosed()) {
-      const internal::ASBSBatch<TaskType>* batch = *it;
-      it = batches_.erase(it);
-      batch->queue()->ReleaseBatch(batch);
-      batch_thread_pool_->Schedule(
-          std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper,
-                    this, batch, queues_and_callbacks_[batch->queue()], true));
-      in_flight_express_batches_++;
-      available_threads--;
-    } else {
-      ++it;
+  const int64_t now_micros = GetEnv()->NowMicros();
+  // First pass schedules batches whose lane SLO deadline has arrived (closing
+  // them early if still open), so a latency-critical partial batch is not
+  // stuck behind older closed bulk batches; second pass schedules the
+  // remaining closed batches.
+  for (int pass = 0; pass < 2 && available_threads > 0; ++pass) {
+    const bool deadline_pass = (pass == 0);
+    for (auto it = batches_.begin();
+         it != batches_.end() && available_threads > 0;) {
+      const bool schedulable = deadline_pass
+                                   ? (*it)->deadline_micros() <= now_micros
+                                   : (*it)->IsClosed();
+      if (schedulable) {
+        const internal::ASBSBatch<TaskType>* batch = *it;
+        it = batches_.erase(it);
+        // ReleaseBatch closes the batch if it is still open.
+        batch->queue()->ReleaseBatch(batch);
+        batch_thread_pool_->Schedule(
+            std::bind(&AdaptiveSharedBatchScheduler<TaskType>::CallbackWrapper,
+                      this, batch, queues_and_callbacks_[batch->queue()],
+                      true));
+        in_flight_express_batches_++;
+        available_threads--;
+      } else {
+        ++it;
+      }
     }
   }
 }
@@ -784,9 +902,15 @@ Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
         // TraceMeConsumer.
         // When multiple calls to "ASBS::Schedule" accumulate to one batch, they
         // are processed in the same batch and should share traceme_context_id.
+        const int64_t creation_time_micros = scheduler_->GetEnv()->NowMicros();
+        const int64_t deadline_micros =
+            options_.latency_slo_micros.has_value()
+                ? creation_time_micros + options_.latency_slo_micros.value()
+                : ASBSBatch<TaskType>::kNoDeadline;
         current_batch_ = new ASBSBatch<TaskType>(
-            this, scheduler_->GetEnv()->NowMicros(),
-            options_.batch_timeout_micros, NewTraceMeContextIdForBatch());
+            this, creation_time_micros, options_.batch_timeout_micros,
+            options_.priority, deadline_micros,
+            NewTraceMeContextIdForBatch());
         new_batches.push_back(current_batch_);
       }
 
@@ -344,6 +344,177 @@ TEST(AdaptiveSharedBatchSchedulerTest, FIFO) {
   stop_teardown.Notify();
 }
 
+TEST(AdaptiveSharedBatchSchedulerTest, PriorityLanes) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+  {
+    AdaptiveSharedBatchScheduler<FakeTask>::Options options;
+    options.env = &env;
+    options.initial_in_flight_batches_limit = 1;
+    options.num_batch_threads = 1;
+    options.batches_to_average_over = 1000;
+    mutex mu;
+    int processed_batches = 0;
+    Notification finish_processing;
+    auto queue_callback = [&mu, &processed_batches, &finish_processing](
+                              std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      finish_processing.WaitForNotification();
+      mutex_lock l(mu);
+      processed_batches++;
+      switch (processed_batches) {
+        case 1:
+          EXPECT_EQ(100, batch->size());
+          break;
+        case 2:
+          // The high-priority batch goes ahead of the older low-priority one.
+          EXPECT_EQ(10, batch->size());
+          break;
+        case 3:
+          EXPECT_EQ(50, batch->size());
+          break;
+        default:
+          EXPECT_TRUE(false) << "Should only have 3 batches";
+      }
+    };
+    std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> scheduler;
+    TF_ASSERT_OK(
+        AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler));
+    AdaptiveSharedBatchScheduler<FakeTask>::QueueOptions queue_options;
+    std::unique_ptr<BatchScheduler<FakeTask>> low_priority_queue;
+    std::unique_ptr<BatchScheduler<FakeTask>> high_priority_queue;
+    queue_options.max_batch_size = 100;
+    queue_options.priority = 0;
+    TF_ASSERT_OK(
+        scheduler->AddQueue(queue_options, queue_callback, &low_priority_queue));
+    queue_options.priority = 1;
+    TF_ASSERT_OK(scheduler->AddQueue(queue_options, queue_callback,
+                                     &high_priority_queue));
+
+    // First batch immediately processed, occupying the only thread.
+    TF_ASSERT_OK(ScheduleTask(100, low_priority_queue.get()));
+    while (low_priority_queue->NumEnqueuedTasks() > 0) {
+    }
+
+    // An older low-priority batch and a younger high-priority batch.
+    TF_ASSERT_OK(ScheduleTask(50, low_priority_queue.get()));
+    env.AdvanceByMicroseconds(10);
+    TF_ASSERT_OK(ScheduleTask(10, high_priority_queue.get()));
+
+    finish_processing.Notify();
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(AdaptiveSharedBatchSchedulerTest, LatencySloClosesBatchEarly) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+  {
+    AdaptiveSharedBatchScheduler<FakeTask>::Options options;
+    options.env = &env;
+    options.initial_in_flight_batches_limit = 1;
+    options.num_batch_threads = 2;
+    options.batches_to_average_over = 1000;
+    mutex mu;
+    int processed_batches = 0;
+    Notification finish_processing;
+    auto queue_callback = [&mu, &processed_batches, &finish_processing](
+                              std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      int batch_num;
+      {
+        mutex_lock l(mu);
+        batch_num = ++processed_batches;
+      }
+      if (batch_num == 1) {
+        EXPECT_EQ(100, batch->size());
+        finish_processing.WaitForNotification();
+      } else if (batch_num == 2) {
+        // The partial SLO-lane batch ran on the spare thread ahead of the
+        // closed bulk batch, despite in_flight_batches_limit_ being reached.
+        EXPECT_EQ(10, batch->size());
+      } else {
+        EXPECT_EQ(100, batch->size());
+      }
+    };
+    std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> scheduler;
+    TF_ASSERT_OK(
+        AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler));
+    AdaptiveSharedBatchScheduler<FakeTask>::QueueOptions queue_options;
+    std::unique_ptr<BatchScheduler<FakeTask>> bulk_queue;
+    std::unique_ptr<BatchScheduler<FakeTask>> slo_queue;
+    queue_options.max_batch_size = 100;
+    TF_ASSERT_OK(scheduler->AddQueue(queue_options, queue_callback,
+                                     &bulk_queue));
+    // Non-full batches would normally wait a long time before becoming
+    // schedulable.
+    queue_options.batch_timeout_micros = 100 * 1000;
+    queue_options.latency_slo_micros = 100;
+    TF_ASSERT_OK(scheduler->AddQueue(queue_options, queue_callback,
+                                     &slo_queue));
+
+    // First batch immediately processed, consuming in_flight_batches_limit_.
+    TF_ASSERT_OK(ScheduleTask(100, bulk_queue.get()));
+    while (bulk_queue->NumEnqueuedTasks() > 0) {
+    }
+
+    // Partial batch in the SLO lane; let its deadline expire.
+    TF_ASSERT_OK(ScheduleTask(10, slo_queue.get()));
+    env.AdvanceByMicroseconds(200);
+
+    // Closing a bulk batch triggers express scheduling, which must take the
+    // expired SLO batch first.
+    TF_ASSERT_OK(ScheduleTask(100, bulk_queue.get()));
+    for (;;) {
+      {
+        mutex_lock l(mu);
+        if (processed_batches >= 2) break;
+      }
+      Env::Default()->SleepForMicroseconds(100);
+    }
+
+    finish_processing.Notify();
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(AdaptiveSharedBatchSchedulerTest, SchedulerStateRoundTrip) {
+  AdaptiveSharedBatchScheduler<FakeTask>::Options options;
+  options.num_batch_threads = 4;
+  options.initial_in_flight_batches_limit = 3;
+  std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> scheduler;
+  TF_ASSERT_OK(
+      AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &scheduler));
+  auto state = scheduler->GetSchedulerState();
+  EXPECT_EQ(3, state.in_flight_batches_limit);
+
+  // Simulate state exported by a warmed-up process.
+  state.in_flight_batches_limit = 2.5;
+  state.step_direction = -1;
+  state.last_avg_latency_ms = 4.2;
+
+  std::shared_ptr<AdaptiveSharedBatchScheduler<FakeTask>> new_scheduler;
+  TF_ASSERT_OK(
+      AdaptiveSharedBatchScheduler<FakeTask>::Create(options, &new_scheduler));
+  new_scheduler->RestoreSchedulerState(state);
+  EXPECT_EQ(2.5, new_scheduler->in_flight_batches_limit());
+  auto restored = new_scheduler->GetSchedulerState();
+  EXPECT_EQ(2.5, restored.in_flight_batches_limit);
+  EXPECT_EQ(-1, restored.step_direction);
+  EXPECT_EQ(4.2, restored.last_avg_latency_ms);
+
+  // Out-of-range values are clamped to this scheduler's configuration.
+  state.in_flight_batches_limit = 100;
+  new_scheduler->RestoreSchedulerState(state);
+  EXPECT_EQ(4, new_scheduler->in_flight_batches_limit());
+}
+
 TEST(AdaptiveSharedBatchSchedulerTest, DeleteQueue) {
   AdaptiveSharedBatchScheduler<FakeTask>::Options options;
   options.initial_in_flight_batches_limit = 1;
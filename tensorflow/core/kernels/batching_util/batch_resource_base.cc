@@ -30,6 +30,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "tensorflow/core/common_runtime/cost_constants.h"
@@ -324,6 +325,12 @@ Status BatchResourceBase::RegisterInput(
     int64_t guid, OpKernelContext* context, const string& batcher_queue_name,
     const CreateBatchTaskFn& create_batch_task_fn,
     AsyncOpKernel::DoneCallback done_callback, int forced_warmup_batch_size) {
+  // A request whose deadline has already passed would be padded into a batch
+  // and computed only to be thrown away; shed it before it is enqueued.
+  if (context->deadline().has_value() && absl::Now() > *context->deadline()) {
+    return errors::DeadlineExceeded(
+        "Batched request expired before it could be enqueued.");
+  }
   TF_ASSIGN_OR_RETURN(std::unique_ptr<BatchTask> batch_components,
                       create_batch_task_fn());
   batch_components->start_time = EnvTime::NowNanos();
@@ -438,6 +445,25 @@ Status BatchResourceBase::RegisterInput(
   return batcher_queue->Schedule(&batch_components);
 }
 
+absl::optional<BatchResourceBase::AdaptiveBatcherT::SchedulerState>
+BatchResourceBase::GetAdaptiveSchedulerState() const {
+  if (adaptive_batcher_ == nullptr) {
+    return absl::nullopt;
+  }
+  return adaptive_batcher_->GetSchedulerState();
+}
+
+Status BatchResourceBase::RestoreAdaptiveSchedulerState(
+    const AdaptiveBatcherT::SchedulerState& state) {
+  if (adaptive_batcher_ == nullptr) {
+    return errors::FailedPrecondition(
+        "Cannot restore adaptive scheduler state: this batch resource does "
+        "not use an adaptive batcher.");
+  }
+  adaptive_batcher_->RestoreSchedulerState(state);
+  return OkStatus();
+}
+
 /*static*/ BatchResourceBase::BatcherT::QueueOptions
 BatchResourceBase::GetBatcherQueueOptions(
     int32_t num_batch_threads, int32_t max_batch_size,
@@ -892,6 +918,24 @@ void BatchResourceBase::ProcessFuncBatch(std::unique_ptr<BatchT> batch) const {
   std::vector<Tensor> combined_outputs;
   std::vector<Tensor> args(concatenated_tensors.begin(),
                            concatenated_tensors.end());
+  if (emit_task_lengths_) {
+    // Functions compiled for ragged batches receive the per-task sizes so
+    // that they can tell the individual requests apart without relying on
+    // padding markers. A forced warmup batch is a single block of padding,
+    // so it is reported as one task of the forced size.
+    const bool just_for_warmup = last_task.forced_warmup_batch_size > 0;
+    const int64_t num_lengths = just_for_warmup ? 1 : batch->num_tasks();
+    Tensor task_lengths(DT_INT32, TensorShape({num_lengths}));
+    auto task_lengths_vec = task_lengths.vec<int32>();
+    if (just_for_warmup) {
+      task_lengths_vec(0) = last_task.forced_warmup_batch_size;
+    } else {
+      for (int i = 0; i < batch->num_tasks(); ++i) {
+        task_lengths_vec(i) = batch->task(i).size();
+      }
+    }
+    args.push_back(std::move(task_lengths));
+  }
   const auto& captured_inputs =
       batch->task(batch->num_tasks() - 1).captured_inputs;
   args.insert(args.end(), captured_inputs.begin(), captured_inputs.end());
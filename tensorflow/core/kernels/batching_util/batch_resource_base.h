@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "absl/strings/str_join.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/types/optional.h"
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -160,6 +161,28 @@ class BatchResourceBase : public ResourceBase {
 
   const SessionMetadata& session_metadata() const { return session_metadata_; }
 
+  // When true, the batch processing function receives an extra int32 vector
+  // argument (after the batched inputs, before the captured inputs) holding
+  // the 0th-dimension size each task contributed to the batch. This is only
+  // meaningful for queues created with `disable_padding`, where the batch
+  // dimension is ragged across tasks.
+  void set_emit_task_lengths(bool emit_task_lengths) {
+    emit_task_lengths_ = emit_task_lengths;
+  }
+
+  bool emit_task_lengths() const { return emit_task_lengths_; }
+
+  // Exports / restores the adaptive batcher's learned scheduler state, so a
+  // replacement process can start at steady-state batching (e.g. during
+  // blue/green deploys) instead of re-learning under live traffic. Only
+  // meaningful when this resource was created with an adaptive batcher;
+  // `GetAdaptiveSchedulerState` returns nullopt otherwise.
+  absl::optional<AdaptiveBatcherT::SchedulerState> GetAdaptiveSchedulerState()
+      const;
+
+  Status RestoreAdaptiveSchedulerState(
+      const AdaptiveBatcherT::SchedulerState& state);
+
   using CreateBatchTaskFn =
       std::function<StatusOr<std::unique_ptr<BatchTask>>()>;
 
@@ -293,6 +316,8 @@ class BatchResourceBase : public ResourceBase {
 
   // True if user specified a batch processing function for this resource.
   const bool has_process_batch_function_;
+  // True if the batch processing function receives a per-task lengths vector.
+  bool emit_task_lengths_ = false;
   // A batch scheduler, and options for creating queues.
   std::shared_ptr<BatcherT> batcher_;
   BatcherT::QueueOptions batcher_queue_options_;
@@ -223,6 +223,21 @@ class SharedBatchScheduler
     // If true, the padding will not be appended.
     bool disable_padding = false;
 
+    // If non-empty, declares this queue a member of a cross-queue batch
+    // packing group. When a batch thread picks up a partial batch from a
+    // queue in the group, it tops the batch up with tasks waiting in the open
+    // batches of the other queues in the same group before processing, and
+    // the combined batch is processed by the picked queue's callback.
+    //
+    // Queues may only be placed in the same group if their process-batch
+    // callbacks are interchangeable: same computation and shape-compatible
+    // inputs (e.g. low-QPS variants of one model architecture). Each task
+    // still receives its own result, since the callback splits the output
+    // among tasks (see `BatchResourceBase::SplitOutputTensors`).
+    //
+    // Must be empty when `enable_lazy_split` is true.
+    string batch_packing_group;
+
     // If true, queue implementation would split high priority and low priority
     // inputs into two sub queues.
     bool enable_priority_queue = false;
@@ -380,6 +395,19 @@ class Queue {
   // Batches are guaranteed to form at task enqueue time.
   std::unique_ptr<Batch<TaskType>> ScheduleBatchWithEagerSplit();
 
+  // Moves whole tasks out of this queue's open batch into `out`, up to
+  // `max_size` in total task size. Called by the scheduler when packing a
+  // batch for another queue in the same `batch_packing_group`. Returns the
+  // total size moved.
+  size_t DrainOpenBatchForPacking(size_t max_size,
+                                  std::vector<std::unique_ptr<TaskType>>* out);
+
+  // The cross-queue batch packing group this queue belongs to; empty if the
+  // queue does not participate in packing.
+  const string& batch_packing_group() const {
+    return options_.batch_packing_group;
+  }
+
   // Processes a batch that has been returned earlier by ScheduleBatch().
   void ProcessBatch(std::unique_ptr<Batch<TaskType>> batch);
 
@@ -649,6 +677,12 @@ Status SharedBatchScheduler<TaskType>::AddQueueAfterRewritingOptions(
         "enable_large_batch_splitting is enabled.");
   }
 
+  if (!options.batch_packing_group.empty() && options.enable_lazy_split) {
+    return errors::InvalidArgument(
+        "batch_packing_group is not supported when enable_lazy_split is "
+        "enabled.");
+  }
+
   if (options.enable_large_batch_splitting &&
       (options.input_batch_size_limit < options.max_execution_batch_size)) {
     return errors::InvalidArgument(
@@ -793,6 +827,46 @@ void SharedBatchScheduler<TaskType>::ThreadLogic() {
         std::move(absl::get<BatchTaskUniqueptr>(batch_to_process));
   }
 
+  // Top up a partial batch with tasks waiting in the open batches of other
+  // queues in the same packing group, so that low-QPS queues which never fill
+  // a batch on their own still execute at a reasonable batch size. The queues
+  // in a group have declared their process-batch callbacks interchangeable,
+  // and each task receives its own result when the callback splits the batch
+  // output among tasks.
+  if (!queue_for_batch->batch_packing_group().empty() &&
+      batch_to_schedule->size() < queue_for_batch->max_execution_batch_size()) {
+    size_t remaining_size =
+        queue_for_batch->max_execution_batch_size() - batch_to_schedule->size();
+    std::vector<std::unique_ptr<TaskType>> packed_tasks;
+    {
+      mutex_lock l(mu_);
+      for (auto& queue : queues_) {
+        if (queue.get() == queue_for_batch ||
+            queue->batch_packing_group() !=
+                queue_for_batch->batch_packing_group()) {
+          continue;
+        }
+        remaining_size -=
+            queue->DrainOpenBatchForPacking(remaining_size, &packed_tasks);
+        if (remaining_size == 0) break;
+      }
+    }
+    if (!packed_tasks.empty()) {
+      // `batch_to_schedule` is already closed, so rebuild it with the packed
+      // tasks appended, preserving its TraceMe context.
+      auto merged_batch = std::make_unique<Batch<TaskType>>(
+          batch_to_schedule->traceme_context_id());
+      for (auto& task : batch_to_schedule->RemoveAllTasks()) {
+        merged_batch->AddTask(std::move(task));
+      }
+      for (auto& task : packed_tasks) {
+        merged_batch->AddTask(std::move(task));
+      }
+      merged_batch->Close();
+      batch_to_schedule = std::move(merged_batch);
+    }
+  }
+
   queue_for_batch->ProcessBatch(std::move(batch_to_schedule));
 }
 
@@ -1126,6 +1200,37 @@ Queue<TaskType>::ScheduleBatch() {
   return std::move(task_handles_to_schedule);
 }
 
+template <typename TaskType>
+size_t Queue<TaskType>::DrainOpenBatchForPacking(
+    size_t max_size, std::vector<std::unique_ptr<TaskType>>* out) {
+  size_t moved_size = 0;
+  mutex_lock l(mu_);
+  if (options_.enable_lazy_split) {
+    // Queue creation forbids a packing group with lazy split.
+    return 0;
+  }
+  // Only the open batch at the back is drained; closed batches are already
+  // scheduled in their own right. Tasks are moved whole.
+  Batch<TaskType>* open_batch = GetBatches().back().get();
+  while (!open_batch->empty()) {
+    // RemoveTask() pops from the back; put the task back if it doesn't fit.
+    std::unique_ptr<TaskType> task = open_batch->RemoveTask();
+    if (task->size() > max_size - moved_size) {
+      open_batch->AddTask(std::move(task));
+      break;
+    }
+    moved_size += task->size();
+    out->push_back(std::move(task));
+  }
+  if (moved_size > 0 && empty_notification_ != nullptr && IsEmptyInternal()) {
+    // The queue was closed and packing just removed its last tasks; they will
+    // be processed as part of another queue's batch.
+    empty_notification_->Notify();
+    empty_notification_ = nullptr;
+  }
+  return moved_size;
+}
+
 template <typename TaskType>
 void Queue<TaskType>::ProcessBatch(std::unique_ptr<Batch<TaskType>> batch) {
   profiler::TraceMeConsumer trace_me(
@@ -794,6 +794,86 @@ TEST_P(SharedBatchSchedulerTest, ZeroQueueRewrittenToOneQueue) {
   }
 }
 
+TEST(SharedBatchSchedulerPackingTest, PacksTasksAcrossGroupQueues) {
+  test_util::FakeClockEnv env(Env::Default());
+  Notification start_teardown, stop_teardown;
+  std::unique_ptr<Thread> teardown_thread =
+      CreateFakeClockAdvancerThread(&env, &start_teardown, &stop_teardown);
+  {
+    mutex mu;
+    std::vector<size_t> batch_sizes;
+    Notification first_batch_processed;
+    auto callback = [&mu, &batch_sizes, &first_batch_processed](
+                        std::unique_ptr<Batch<FakeTask>> batch) {
+      ASSERT_TRUE(batch->IsClosed());
+      {
+        mutex_lock l(mu);
+        batch_sizes.push_back(batch->size());
+      }
+      if (!first_batch_processed.HasBeenNotified()) {
+        first_batch_processed.Notify();
+      }
+    };
+
+    auto scheduler = CreateSharedBatchScheduler(1, &env);
+
+    QueueOptions queue_options = tensorflow::serving::CreateQueueOptions(
+        10 /* max_execution_batch_size */, 10 /* input_batch_size_limit */,
+        100 /* batch_timeout_micros */, 2 /* max_enqueued_batches */,
+        false /* enable_large_batch_splitting */, false /* enable_lazy_split */,
+        nullptr /* split_func */);
+    queue_options.batch_packing_group = "model_variants";
+    auto queue_a = CreateQueue(scheduler, queue_options, callback);
+    auto queue_b = CreateQueue(scheduler, queue_options, callback);
+
+    // Neither queue can fill a batch on its own.
+    TF_ASSERT_OK(ScheduleTask(3, queue_a.get()));
+    TF_ASSERT_OK(ScheduleTask(2, queue_b.get()));
+
+    // Once a timeout expires, whichever queue's partial batch is picked up is
+    // topped up with the other queue's waiting task and processed as one
+    // physical batch.
+    env.AdvanceByMicroseconds(100);
+    first_batch_processed.WaitForNotification();
+
+    {
+      mutex_lock l(mu);
+      ASSERT_EQ(1, batch_sizes.size());
+      EXPECT_EQ(5, batch_sizes[0]);
+    }
+    EXPECT_EQ(0, queue_a->NumEnqueuedTasks());
+    EXPECT_EQ(0, queue_b->NumEnqueuedTasks());
+
+    start_teardown.Notify();
+  }
+  stop_teardown.Notify();
+}
+
+TEST(SharedBatchSchedulerPackingTest, PackingGroupRequiresEagerSplit) {
+  auto callback = [](std::unique_ptr<Batch<FakeTask>> batch) {
+    // do nothing.
+  };
+
+  auto scheduler = CreateSharedBatchScheduler(2);
+
+  QueueOptions queue_options = tensorflow::serving::CreateQueueOptions(
+      10 /* max_execution_batch_size */, 10 /* input_batch_size_limit */,
+      100 /* batch_timeout_micros */, 2 /* max_enqueued_batches */,
+      true /* enable_large_batch_splitting */, true /* enable_lazy_split */,
+      [](std::unique_ptr<FakeTask>* input_task, int open_batch_remaining_slot,
+         int max_batch_size,
+         std::vector<std::unique_ptr<FakeTask>>* output_tasks) -> Status {
+        output_tasks->push_back(std::move(*input_task));
+        return OkStatus();
+      });
+  queue_options.batch_packing_group = "model_variants";
+  std::unique_ptr<Queue> queue;
+  EXPECT_THAT(scheduler->AddQueue(queue_options, callback, &queue),
+              testing::StatusIs(error::INVALID_ARGUMENT,
+                                "batch_packing_group is not supported when "
+                                "enable_lazy_split is enabled."));
+}
+
 // TODO(b/161857471):
 // Add test coverage when input-split and no-split returns differently.
 INSTANTIATE_TEST_SUITE_P(
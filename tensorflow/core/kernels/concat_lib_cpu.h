@@ -48,6 +48,19 @@ void ConcatCPUImpl(
   // cost_per_unit is estimated bytes to copy per output array element (for
   // strings this includes an estimate of the number of bytes of the actual
   // string data, as well).
+  //
+  // Every output row additionally dispatches one copier.Copy call per input,
+  // so for concats of many thin slices (e.g. hundreds of small embedding
+  // columns) the bytes-only estimate badly undershoots the real cost and
+  // leaves the copy single-threaded. Amortize a fixed per-call overhead over
+  // the elements of a row so such cases are costed realistically and shard
+  // across more threads.
+  constexpr int64_t kCopyCallOverhead = 64;
+  if (row_size > 0) {
+    cost_per_unit += (kCopyCallOverhead * static_cast<int64_t>(num_inputs) +
+                      row_size - 1) /
+                     row_size;
+  }
   const int64_t estimated_total_cost = output->size() * cost_per_unit;
 
   auto worker_threads = d->tensorflow_cpu_worker_threads();
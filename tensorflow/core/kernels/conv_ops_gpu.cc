@@ -30,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/autotune_conv_impl.h"
 #include "tensorflow/core/kernels/numeric_options_utils.h"
 #include "tensorflow/core/platform/tensor_float_32_utils.h"
+#include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 #endif  // GOOGLE_CUDA
 
 namespace tensorflow {
@@ -84,6 +85,8 @@ StatusOr<AutotuneEntry<se::dnn::FusedConvOp>> AutotuneFusedConv(
   AutotuneEntry<se::dnn::FusedConvOp> autotune_entry;
   auto* stream = ctx->op_device_context()->stream();
 
+  LoadAutotuneMapsFromCacheFileOnce();
+
   if (!autotune_map->Find(params, &autotune_entry)) {
     profiler::ScopedAnnotation trace("cudnn_autotuning");
 
@@ -171,6 +174,7 @@ StatusOr<AutotuneEntry<se::dnn::FusedConvOp>> AutotuneFusedConv(
     }
 
     autotune_map->Insert(params, autotune_entry);
+    SaveAutotuneMapsToCacheFile();
   }
   return autotune_entry;
 #else
@@ -246,6 +250,8 @@ StatusOr<AutotuneEntry<se::dnn::ConvOp>> AutotuneUnfusedConv(
 
   auto* stream = ctx->op_device_context()->stream();
 
+  LoadAutotuneMapsFromCacheFileOnce();
+
   if (!autotune_map->Find(conv_parameters, &autotune_entry)) {
     profiler::ScopedAnnotation annotation("cudnn_autotuning");
 
@@ -399,6 +405,7 @@ StatusOr<AutotuneEntry<se::dnn::ConvOp>> AutotuneUnfusedConv(
 #endif
 
     autotune_map->Insert(conv_parameters, autotune_entry);
+    SaveAutotuneMapsToCacheFile();
   }
 
   return autotune_entry;
@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/data/serialization_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/dataset_options.pb.h"
+#include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -948,8 +949,11 @@ class CacheDatasetOp::MemoryDatasetBase : public DatasetBase {
         mutex_lock l(mu_);
         if (index_ < cache_->size()) {
           const std::vector<Tensor>& cache_tensors = cache_->at(index_);
+          // The cache retains its elements for future epochs, so they have to
+          // be copied (not moved) into the output.
           out_tensors->insert(out_tensors->begin(), cache_tensors.begin(),
                               cache_tensors.end());
+          metrics::RecordTFDataElementsCopied(kDatasetType, 1);
           index_++;
           *end_of_sequence = false;
           return OkStatus();
@@ -17,6 +17,7 @@ limitations under the License.
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -27,6 +28,37 @@ inline int64_t CeilDiv(int64_t dividend, int64_t divisor) {
   return (dividend - 1 + divisor) / divisor;
 }
 
+// When TF_DATA_REBATCH_ZERO_COPY_SLICES=true, rebatching emits slice views
+// of the parent batch even when the slice does not satisfy the Eigen
+// alignment requirement, instead of materializing an aligned copy. The view
+// keeps the parent buffer alive through the slice's buffer refcount, so
+// changing the batch size never copies tensor data. Unaligned tensors are
+// handled by the copy/serialization paths that move elements between hosts
+// and devices, but consumers that map the buffer with flat()/tensor() must
+// make their own aligned copy, which is why this is opt-in.
+bool ZeroCopyRebatchEnabled() {
+  static const bool enabled = []() {
+    bool value = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_REBATCH_ZERO_COPY_SLICES", false,
+                                  &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_REBATCH_ZERO_COPY_SLICES: " << s;
+    }
+    return value;
+  }();
+  return enabled;
+}
+
+// Emits `slice` into `out_tensors`, copying only when the view lacks the
+// alignment the downstream consumer is entitled to rely on.
+void EmitSlice(Tensor&& slice, std::vector<Tensor>* out_tensors) {
+  if (slice.IsAligned() || ZeroCopyRebatchEnabled()) {
+    out_tensors->push_back(std::move(slice));
+  } else {
+    out_tensors->push_back(tensor::DeepCopy(std::move(slice)));
+  }
+}
+
 constexpr const char* const kDatasetTypeV1 = "Rebatch";
 constexpr const char* const kDatasetTypeV2 = "RebatchV2";
 
@@ -174,12 +206,7 @@ class RebatchDatasetOp : public UnaryDatasetOpKernel {
             // the remaining iterations that correspond to this batch.
             start = end;
           }
-          Tensor slice = input_desc.whole_tensor.Slice(start, end);
-          if (slice.IsAligned()) {
-            out_tensors->push_back(std::move(slice));
-          } else {
-            out_tensors->push_back(tensor::DeepCopy(std::move(slice)));
-          }
+          EmitSlice(input_desc.whole_tensor.Slice(start, end), out_tensors);
         }
         slice_number_ = (slice_number_ + 1) % dataset()->num_replicas_;
         return OkStatus();
@@ -495,8 +522,9 @@ class RebatchDatasetV2Op : public UnaryDatasetOpKernel {
         if (slices_to_concatenate.size() == 1) {
           auto tensors = std::move(slices_to_concatenate[0]);
           for (size_t i = 0; i < num_components; ++i) {
-            // If the slice is aligned, we return it directly.
-            if (!tensors[i].IsAligned()) {
+            // If the slice is aligned (or unaligned views are allowed), we
+            // return it directly.
+            if (!tensors[i].IsAligned() && !ZeroCopyRebatchEnabled()) {
               tensors[i] = tensor::DeepCopy(std::move(tensors[i]));
             }
           }
@@ -416,7 +416,8 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
           auto writer = std::make_unique<snapshot_util::AsyncWriter>(
               ctx->env(), shard_index, snapshot_shard_directory,
               current_checkpoint_id_, dataset()->compression_,
-              kFileFormatVersion, dataset()->output_dtypes(), [this](Status s) {
+              snapshot_util::WriterFileFormatVersion(kFileFormatVersion),
+              dataset()->output_dtypes(), [this](Status s) {
                 if (!s.ok()) {
                   LOG(ERROR) << "AsyncWriter in snapshot writer failed: " << s;
                   mutex_lock l(writer_status_mu_);
@@ -499,7 +500,8 @@ class SnapshotDatasetV2Op::Dataset : public DatasetBase {
       metadata.set_creation_timestamp(EnvTime::NowMicros());
       metadata.set_graph_hash(strings::StrCat(dataset()->hash_));
       metadata.set_run_id(strings::StrCat(run_id_));
-      metadata.set_version(kFileFormatVersion);
+      metadata.set_version(
+          snapshot_util::WriterFileFormatVersion(kFileFormatVersion));
       for (const auto& output_dtype : dataset()->output_dtypes()) {
         metadata.add_dtype(output_dtype);
       }
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/filter_dataset_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,14 +23,18 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/input_colocation_exemption_registry.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
+#include "tensorflow/core/data/serialization_utils.h"
 #include "tensorflow/core/data/stats_utils.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/stats_aggregator.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/blocking_counter.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -48,6 +53,29 @@ namespace data {
 constexpr char kInputImplEmpty[] = "input_impl_empty";
 constexpr char kFilteredElements[] = "filtered_elements";
 constexpr char kDroppedElements[] = "dropped_elements";
+constexpr char kReadyElements[] = "ready_elements";
+
+namespace {
+
+// When TF_DATA_FILTER_BLOCK_SIZE is set to N > 1, the iterator pulls up to N
+// input elements at a time and fans the predicate invocations for the block
+// out over the inter-op threadpool, keeping the survivors in order. This
+// amortizes per-element iterator round trips for high-rejection filters
+// while preserving the serial filter's output order. A checkpoint taken in
+// this mode must also be restored in this mode.
+int64_t FilterBlockSize() {
+  static const int64_t block_size = []() {
+    int64_t value = 0;
+    Status s = ReadInt64FromEnvVar("TF_DATA_FILTER_BLOCK_SIZE", 0, &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_FILTER_BLOCK_SIZE: " << s;
+    }
+    return value;
+  }();
+  return block_size;
+}
+
+}  // namespace
 
 class FilterDatasetOp::Dataset : public DatasetBase {
  public:
@@ -116,7 +144,8 @@ class FilterDatasetOp::Dataset : public DatasetBase {
     explicit Iterator(const Params& params)
         : DatasetIterator<Dataset>(params),
           filtered_elements_(0),
-          dropped_elements_(0) {}
+          dropped_elements_(0),
+          block_size_(FilterBlockSize()) {}
 
     bool SymbolicCheckpointCompatible() const override { return true; }
 
@@ -133,6 +162,9 @@ class FilterDatasetOp::Dataset : public DatasetBase {
     Status GetNextInternal(IteratorContext* ctx,
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
+      if (block_size_ > 1) {
+        return BlockGetNext(ctx, out_tensors, end_of_sequence);
+      }
       auto stats_aggregator = ctx->stats_aggregator();
       bool matched;
       do {
@@ -224,6 +256,13 @@ class FilterDatasetOp::Dataset : public DatasetBase {
           writer->WriteScalar(prefix(), kFilteredElements, filtered_elements_));
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kDroppedElements, dropped_elements_));
+      if (block_size_ > 1) {
+        std::vector<std::vector<Tensor>> remaining(
+            ready_elements_.begin() + next_ready_, ready_elements_.end());
+        TF_RETURN_IF_ERROR(WriteElementsToCheckpoint(
+            writer, strings::StrCat(prefix(), "::", kReadyElements),
+            remaining));
+      }
       return OkStatus();
     }
 
@@ -242,6 +281,13 @@ class FilterDatasetOp::Dataset : public DatasetBase {
           reader->ReadScalar(prefix(), kFilteredElements, &filtered_elements_));
       TF_RETURN_IF_ERROR(
           reader->ReadScalar(prefix(), kDroppedElements, &dropped_elements_));
+      if (block_size_ > 1) {
+        ready_elements_.clear();
+        next_ready_ = 0;
+        TF_RETURN_IF_ERROR(ReadElementsFromCheckpoint(
+            ctx, reader, strings::StrCat(prefix(), "::", kReadyElements),
+            &ready_elements_));
+      }
       return OkStatus();
     }
 
@@ -258,10 +304,124 @@ class FilterDatasetOp::Dataset : public DatasetBase {
     }
 
    private:
+    // Block-evaluation path (TF_DATA_FILTER_BLOCK_SIZE > 1): pulls up to
+    // `block_size_` input elements, evaluates the predicate for the whole
+    // block on the inter-op threadpool, and hands out the survivors in input
+    // order from `ready_elements_`.
+    Status BlockGetNext(IteratorContext* ctx,
+                        std::vector<Tensor>* out_tensors,
+                        bool* end_of_sequence) {
+      mutex_lock l(mu_);
+      while (next_ready_ == ready_elements_.size()) {
+        ready_elements_.clear();
+        next_ready_ = 0;
+        if (!input_impl_) {
+          *end_of_sequence = true;
+          return OkStatus();
+        }
+        std::vector<std::vector<Tensor>> block;
+        block.reserve(block_size_);
+        bool end_of_input = false;
+        while (static_cast<int64_t>(block.size()) < block_size_ &&
+               !end_of_input) {
+          std::vector<Tensor> element;
+          TF_RETURN_IF_ERROR(
+              input_impl_->GetNext(ctx, &element, &end_of_input));
+          if (!end_of_input) {
+            block.push_back(std::move(element));
+          }
+        }
+        if (end_of_input) {
+          input_impl_.reset();
+        }
+        if (!block.empty()) {
+          TF_RETURN_IF_ERROR(EvaluateBlock(ctx, &block));
+        }
+      }
+      *out_tensors = std::move(ready_elements_[next_ready_++]);
+      *end_of_sequence = false;
+      return OkStatus();
+    }
+
+    // Runs the predicate for every element of `block` concurrently and moves
+    // the matching elements, in order, into `ready_elements_`.
+    Status EvaluateBlock(IteratorContext* ctx,
+                         std::vector<std::vector<Tensor>>* block)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      const size_t num_elements = block->size();
+      std::vector<std::vector<Tensor>> results(num_elements);
+      std::vector<Status> statuses(num_elements);
+      const size_t num_threads =
+          std::min(num_elements,
+                   std::max(static_cast<size_t>(1),
+                            static_cast<size_t>(ctx->runner_threadpool_size())));
+      BlockingCounter counter(num_elements);
+      const size_t slice_size = num_elements / num_threads;
+      size_t offset = 0;
+      for (size_t i = 0; i < num_threads; ++i) {
+        size_t length = slice_size;
+        // When the number of threads does not divide the number of elements
+        // evenly, the size of some slices is incremented to guarantee their
+        // sizes add up to the total number of elements.
+        if (i < num_elements % num_threads) ++length;
+        (*ctx->runner())([this, ctx, block, &results, &statuses, &counter,
+                          offset, length]() {
+          for (size_t j = offset; j < offset + length; ++j) {
+            statuses[j] = instantiated_captured_func_->RunWithBorrowedArgs(
+                ctx, (*block)[j], &results[j], model_node());
+            counter.DecrementCount();
+          }
+        });
+        offset += length;
+      }
+      counter.Wait();
+      int64_t num_dropped = 0;
+      for (size_t i = 0; i < num_elements; ++i) {
+        TF_RETURN_IF_ERROR(statuses[i]);
+        if (results[i].size() != 1 || results[i][0].dtype() != DT_BOOL ||
+            results[i][0].NumElements() != 1) {
+          return errors::InvalidArgument(
+              "Filter predicate `f` must return a scalar bool.");
+        }
+        if (results[i][0].scalar<bool>()()) {
+          ready_elements_.push_back(std::move((*block)[i]));
+        } else {
+          num_dropped++;
+        }
+      }
+      filtered_elements_ += ready_elements_.size();
+      dropped_elements_ += num_dropped;
+      auto stats_aggregator = ctx->stats_aggregator();
+      if (stats_aggregator) {
+        stats_aggregator->AddScalar(
+            stats_utils::DroppedElementsScalarName(dataset()->node_name()),
+            static_cast<float>(dropped_elements_), num_elements());
+        stats_aggregator->AddScalar(
+            stats_utils::FilterdElementsScalarName(dataset()->node_name()),
+            static_cast<float>(filtered_elements_), num_elements());
+        if (num_dropped > 0) {
+          stats_aggregator->IncrementCounter(
+              dataset()->node_name(), stats_utils::kDroppedElements,
+              static_cast<float>(num_dropped));
+        }
+        if (!ready_elements_.empty()) {
+          stats_aggregator->IncrementCounter(
+              dataset()->node_name(), stats_utils::kFilteredElements,
+              static_cast<float>(ready_elements_.size()));
+        }
+      }
+      return OkStatus();
+    }
+
     mutable mutex mu_;
     std::unique_ptr<IteratorBase> input_impl_ TF_GUARDED_BY(mu_);
     int64_t filtered_elements_ TF_GUARDED_BY(mu_);
     int64_t dropped_elements_ TF_GUARDED_BY(mu_);
+    const int64_t block_size_;
+    // Elements that passed the predicate but have not been produced yet;
+    // `next_ready_` indexes the next one to hand out.
+    std::vector<std::vector<Tensor>> ready_elements_ TF_GUARDED_BY(mu_);
+    size_t next_ready_ TF_GUARDED_BY(mu_) = 0;
     std::unique_ptr<InstantiatedCapturedFunction> instantiated_captured_func_;
   };
 
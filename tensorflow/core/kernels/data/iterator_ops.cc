@@ -147,7 +147,7 @@ Status IteratorResource::GetNext(OpKernelContext* ctx,
 
 Status IteratorResource::Save(OpKernelContext* ctx,
                               ExternalStatePolicy external_state_policy,
-                              IteratorStateWriter* writer) {
+                              bool save_delta, IteratorStateWriter* writer) {
   std::shared_ptr<State> captured_state;
   {
     tf_shared_lock l(mu_);
@@ -175,6 +175,7 @@ Status IteratorResource::Save(OpKernelContext* ctx,
   SerializationContext::Params params(ctx);
   params.external_state_policy = external_state_policy;
   params.symbolic_checkpoint = SymbolicCheckpointEnabled(dataset->options());
+  params.save_delta = save_delta;
   SerializationContext serialization_ctx(params);
   return iterator->Save(&serialization_ctx, writer);
 }
@@ -327,10 +328,11 @@ class IteratorVariantSerializer {
   // IteratorStateVariant objects.
   Status InitializeFromIterator(OpKernelContext* ctx,
                                 ExternalStatePolicy external_state_policy,
+                                bool save_delta,
                                 IteratorResource* iterator_resource) {
     VariantTensorDataWriter writer;
-    TF_RETURN_IF_ERROR(
-        iterator_resource->Save(ctx, external_state_policy, &writer));
+    TF_RETURN_IF_ERROR(iterator_resource->Save(ctx, external_state_policy,
+                                               save_delta, &writer));
     std::vector<std::unique_ptr<VariantTensorData>> data;
     writer.ReleaseData(&data);
     variants_.clear();
@@ -897,7 +899,7 @@ Status IteratorGetNextOp::DoCompute(OpKernelContext* ctx) {
   TF_RETURN_IF_ERROR(VerifyShapesCompatible(output_shapes_, components));
   RecordElementSize(components, &traceme);
   for (int i = 0; i < components.size(); ++i) {
-    ctx->set_output(i, components[i]);
+    ctx->set_output(i, std::move(components[i]));
   }
   return OkStatus();
 }
@@ -1035,6 +1037,9 @@ SerializeIteratorOp::SerializeIteratorOp(OpKernelConstruction* ctx)
                    ctx->GetAttr(kExternalStatePolicy, &external_state_policy));
     external_state_policy_ = ExternalStatePolicy(external_state_policy);
   }
+  if (ctx->HasAttr(kSaveDelta)) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr(kSaveDelta, &save_delta_));
+  }
 }
 
 void SerializeIteratorOp::Compute(OpKernelContext* ctx) {
@@ -1050,8 +1055,10 @@ void SerializeIteratorOp::Compute(OpKernelContext* ctx) {
       ctx, LookupResource(ctx, HandleFromInput(ctx, 0), &iterator_resource));
   core::ScopedUnref unref_iterator(iterator_resource);
   IteratorVariantSerializer serializer;
-  OP_REQUIRES_OK(ctx, serializer.InitializeFromIterator(
-                          ctx, external_state_policy_, iterator_resource));
+  OP_REQUIRES_OK(ctx,
+                 serializer.InitializeFromIterator(ctx, external_state_policy_,
+                                                   save_delta_,
+                                                   iterator_resource));
   Tensor* serialized_t;
   OP_REQUIRES_OK(ctx,
                  ctx->allocate_output(0, TensorShape({serializer.NumTensors()}),
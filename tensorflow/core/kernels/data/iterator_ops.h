@@ -55,9 +55,12 @@ class IteratorResource : public ResourceBase {
   Status GetNext(OpKernelContext* ctx, std::vector<Tensor>* out_tensors,
                  bool* end_of_sequence);
 
-  // Saves a checkpoint of the state of the iterator through the given `writer`.
+  // Saves a checkpoint of the state of the iterator through the given
+  // `writer`. If `save_delta` is true, iterators that support it save only the
+  // state that changed since their previous save; the resulting checkpoint
+  // must be restored on top of the checkpoint it was taken against.
   Status Save(OpKernelContext* ctx, ExternalStatePolicy external_state_policy,
-              IteratorStateWriter* writer);
+              bool save_delta, IteratorStateWriter* writer);
 
   // Restores the state of the iterator from a checkpoint created by `Save`.
   Status Restore(OpKernelContext* ctx, IteratorStateReader* reader);
@@ -315,6 +318,7 @@ class SerializeIteratorOp : public OpKernel {
  public:
   static constexpr const char* const kExternalStatePolicy =
       "external_state_policy";
+  static constexpr const char* const kSaveDelta = "save_delta";
 
   explicit SerializeIteratorOp(OpKernelConstruction* ctx);
 
@@ -322,6 +326,7 @@ class SerializeIteratorOp : public OpKernel {
 
  private:
   ExternalStatePolicy external_state_policy_ = ExternalStatePolicy::POLICY_WARN;
+  bool save_delta_ = false;
 };
 
 class DeserializeIteratorOp : public OpKernel {
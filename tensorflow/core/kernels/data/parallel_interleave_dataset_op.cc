@@ -20,6 +20,7 @@ limitations under the License.
 #include <atomic>
 #include <cmath>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -49,6 +50,7 @@ limitations under the License.
 #include "tensorflow/core/platform/stringprintf.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -123,6 +125,29 @@ constexpr double kDefaultPerIteratorPrefetchFactor = 2.0L;
 // Period between reporting dataset statistics.
 constexpr int kStatsReportingPeriodMillis = 1000;
 
+// Smoothing factor for the per-source bytes/sec moving average maintained in
+// bandwidth-aware mode. Larger values react faster to rate changes.
+constexpr double kBandwidthEwmaAlpha = 0.3;
+
+// When TF_DATA_BANDWIDTH_AWARE_INTERLEAVE=true and the interleave is allowed
+// to be nondeterministic, source selection is driven by a per-source EWMA of
+// production rate in bytes/sec: consumers prefer buffered results from the
+// fastest sources (bounded by a skew limit that preserves long-run mixing
+// ratios) and idle workers refill the fastest sources first, so slow remote
+// shards no longer gate the whole cycle.
+bool BandwidthAwareInterleaveEnabled() {
+  static const bool enabled = []() {
+    bool value = false;
+    Status s = ReadBoolFromEnvVar("TF_DATA_BANDWIDTH_AWARE_INTERLEAVE", false,
+                                  &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_BANDWIDTH_AWARE_INTERLEAVE: " << s;
+    }
+    return value;
+  }();
+  return enabled;
+}
+
 inline int64_t CeilDiv(int64_t numerator, int64_t denominator) {
   return (numerator + denominator - 1) / denominator;
 }
@@ -583,6 +608,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       int64_t parallelism = -1;
       int64_t results_ready = -1;
       int64_t active_elements = -1;
+      string source_rates;
       // NOTE: We only set the parallelism value if the lock can be acquired
       // right away to avoid introducing tracing overhead.
       if (mu_->try_lock()) {
@@ -595,6 +621,12 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
             if (current_elements_[i]->active) {
               active_elements++;
             }
+            if (BandwidthAwareInterleaveEnabled()) {
+              strings::StrAppend(
+                  &source_rates, source_rates.empty() ? "" : " ", i, ":",
+                  static_cast<int64_t>(
+                      current_elements_[i]->ewma_bytes_per_sec));
+            }
           }
         }
         mu_->unlock();
@@ -618,6 +650,10 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       result.push_back(std::make_pair(
           "interleave_depth",
           strings::Printf("%lld", static_cast<long long>(interleave_depth_))));
+      if (!source_rates.empty()) {
+        result.push_back(
+            std::make_pair("source_bytes_per_sec", std::move(source_rates)));
+      }
       return result;
     }
 
@@ -665,6 +701,14 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       // Whether we tried to initialize the element, but the input iterator
       // was exhausted so we could produce no inputs.
       bool no_input TF_GUARDED_BY(&ParallelInterleaveIterator::mu_) = false;
+      // EWMA of the element's production rate in bytes/sec; 0 until the
+      // first result is produced. Only maintained in bandwidth-aware mode.
+      double ewma_bytes_per_sec
+          TF_GUARDED_BY(&ParallelInterleaveIterator::mu_) = 0;
+      // Number of results consumed from this element, used to bound the
+      // skew that bandwidth-aware selection may introduce.
+      int64_t results_consumed
+          TF_GUARDED_BY(&ParallelInterleaveIterator::mu_) = 0;
       // Condition variable for communicating between current worker threads
       // and GetNext.
       condition_variable cond_var;
@@ -759,6 +803,9 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       if (deterministic_) {
         return ConsumeHelper(ctx, result);
       }
+      if (BandwidthAwareInterleaveEnabled() && ConsumeFastestReady(result)) {
+        return true;
+      }
       // If we are allowed to be nondeterministic (i.e. return results out of
       // order), try to find an element in the cycle that has a result
       // available.
@@ -771,6 +818,57 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
       return false;
     }
 
+    // Bandwidth-aware selection: consumes a buffered result from the current
+    // element with the highest production rate, skipping elements that have
+    // already run more than one output buffer ahead of the slowest element.
+    // The skew bound keeps long-run per-source mixing ratios close to the
+    // round-robin baseline. Returns false if no element qualifies, in which
+    // case the caller falls back to round-robin.
+    bool ConsumeFastestReady(std::shared_ptr<Result>* result)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (last_valid_current_element_ == -1) {
+        return false;
+      }
+      int64_t min_consumed = std::numeric_limits<int64_t>::max();
+      for (int64_t i = 0; i <= last_valid_current_element_; ++i) {
+        if (current_elements_[i]) {
+          min_consumed =
+              std::min(min_consumed, current_elements_[i]->results_consumed);
+        }
+      }
+      const int64_t max_skew = dataset()->buffer_output_elements_;
+      int64_t best = -1;
+      double best_rate = -1;
+      for (int64_t i = 0; i <= last_valid_current_element_; ++i) {
+        const auto& element = current_elements_[i];
+        if (!element || element->results.empty()) {
+          continue;
+        }
+        if (element->results_consumed - min_consumed > max_skew) {
+          continue;
+        }
+        if (best == -1 || element->ewma_bytes_per_sec > best_rate) {
+          best = i;
+          best_rate = element->ewma_bytes_per_sec;
+        }
+      }
+      if (best == -1) {
+        return false;
+      }
+      cycle_index_ = best;
+      block_index_ = 0;
+      std::shared_ptr<Element> element = current_elements_[best];
+      std::swap(*result, element->results.front());
+      element->results.pop_front();
+      element->results_consumed++;
+      if (!element->active) {
+        elements_to_process_.push_back(best);
+        current_workers_cond_var_.notify_one();
+      }
+      AdvanceToNextInCycle();
+      return true;
+    }
+
     // Consumes a result (if available), returning an indication of whether
     // a result is available. If `true` is returned, `result` either
     // points to a valid result or is null if end of input has been reached.
@@ -798,6 +896,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
           // We found a result.
           std::swap(*result, element->results.front());
           element->results.pop_front();
+          element->results_consumed++;
           if (!element->active) {
             elements_to_process_.push_back(cycle_index_);
             current_workers_cond_var_.notify_one();
@@ -963,7 +1062,13 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
           // Look for an element that needs processing.
           element.reset();
           while (!cancelled_) {
-            while (!elements_to_process_.empty() && !wait_for_checkpoint_) {
+            if (BandwidthAwareInterleaveEnabled() && !wait_for_checkpoint_) {
+              // Refill the fastest source first so that its buffer is the
+              // least likely to run dry.
+              SelectFastestElementToProcess(&element_index, &element);
+            }
+            while (!element && !elements_to_process_.empty() &&
+                   !wait_for_checkpoint_) {
               int index = elements_to_process_.front();
               elements_to_process_.pop_front();
               auto& e = current_elements_[index];
@@ -1076,6 +1181,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         iterator = element->iterator.get();
       }
       DCHECK(iterator != nullptr);
+      const bool bandwidth_aware = BandwidthAwareInterleaveEnabled();
       // Process until the results queue is full or we reach end of input.
       while (true) {
         auto result = std::make_shared<Result>(ctx);
@@ -1088,6 +1194,8 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         });
         bool end_of_input = false;
         IteratorContext nested_ctx = MakeNestedIteratorContext(ctx);
+        const uint64 produce_start_us =
+            bandwidth_aware ? ctx->env()->NowMicros() : 0;
         result->status = iterator->GetNext(&nested_ctx, &result->return_values,
                                            &end_of_input);
         result->checkpoint.Merge(nested_ctx.checkpoint());
@@ -1104,6 +1212,20 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         }
         RecordBufferEnqueue(ctx, result->return_values);
         mutex_lock l(*mu_);
+        if (bandwidth_aware && result->status.ok()) {
+          int64_t bytes = 0;
+          for (const Tensor& t : result->return_values) {
+            bytes += t.TotalBytes();
+          }
+          const uint64 elapsed_us =
+              std::max<uint64>(ctx->env()->NowMicros() - produce_start_us, 1);
+          const double rate = bytes * 1e6 / elapsed_us;
+          element->ewma_bytes_per_sec =
+              element->ewma_bytes_per_sec == 0
+                  ? rate
+                  : kBandwidthEwmaAlpha * rate +
+                        (1 - kBandwidthEwmaAlpha) * element->ewma_bytes_per_sec;
+        }
         element->results.push_back(std::move(result));
         NotifyElementUpdate(*element);
         if (element->results.size() == dataset()->buffer_output_elements_) {
@@ -1203,6 +1325,39 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
              element->results.size() < dataset()->buffer_output_elements_;
     }
 
+    // Scans `elements_to_process_` for the processable element with the
+    // highest production rate and claims it, removing its entry from the
+    // queue. Leaves `*element` unset if no entry is processable. Used in
+    // bandwidth-aware mode in place of FIFO selection.
+    void SelectFastestElementToProcess(int* element_index,
+                                       std::shared_ptr<Element>* element)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      int64_t best = -1;
+      double best_rate = -1;
+      // Entries whose element no longer needs processing are dropped, as the
+      // FIFO path would drop them when popped.
+      for (auto it = elements_to_process_.begin();
+           it != elements_to_process_.end();) {
+        auto& e = current_elements_[*it];
+        if (!NeedsProcessing(e) || e->active) {
+          it = elements_to_process_.erase(it);
+          continue;
+        }
+        if (best == -1 || e->ewma_bytes_per_sec > best_rate) {
+          best = *it;
+          best_rate = e->ewma_bytes_per_sec;
+        }
+        ++it;
+      }
+      if (best == -1) {
+        return;
+      }
+      *element_index = best;
+      *element = current_elements_[best];
+      elements_to_process_.erase(std::find(elements_to_process_.begin(),
+                                           elements_to_process_.end(), best));
+    }
+
     inline void IncrementCurrentWorkers() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       num_current_workers_++;
     }
@@ -27,6 +27,7 @@ PrefetchAutotuner::PrefetchAutotuner(
     int64_t initial_buffer_size, int64_t buffer_size_min,
     std::shared_ptr<model::RamBudgetManager> ram_budget_manager)
     : buffer_limit_(initial_buffer_size),
+      buffer_size_min_(buffer_size_min),
       ram_budget_manager_(ram_budget_manager) {
   if (initial_buffer_size == model::kAutotune) {
     mode_ = Mode::kUpswing;
@@ -39,27 +40,56 @@ namespace {
 // limits less than the threshold, an exponential increase is used, while for
 // limits greater than or equal to the threshold, a linear increase is used.
 size_t kBufferLimitThreshold = 2048;
+
+// Weight of the most recent element in the moving average of element sizes.
+// Small enough that occasional outlier elements do not swing the estimate.
+constexpr double kElementSizeEwmaWeight = 0.1;
 }  // namespace
 
-void PrefetchAutotuner::SetElementSize(int64_t element_size_bytes) {
-  // Once we know the element size we can allocate the right number of bytes for
-  // the prefetch autotuner.
-  // We tell the ram budget manager that we are going to allocate
-  // `element_size_bytes` as we assume the buffer size will at least hold
-  // one element
-  if (ram_budget_manager_ && !ram_budget_manager_->RequestLegacyPrefetchBytes(
-                                 element_size_bytes * buffer_limit_)) {
-    LOG(WARNING)
-        << "Prefetch autotuner tried to allocate "
-        << element_size_bytes * buffer_limit_ << " bytes "
-        << "after encountering the first element of size " << element_size_bytes
-        << " bytes."
-        << "This already causes the autotune ram budget to be exceeded. To "
-        << "stay within the ram budget, either increase the ram budget or "
-        << "reduce element size";
+void PrefetchAutotuner::RecordElementSize(int64_t element_size_bytes) {
+  if (!element_size_bytes_.has_value()) {
+    element_size_bytes_ = static_cast<double>(element_size_bytes);
+  } else {
+    *element_size_bytes_ +=
+        (element_size_bytes - *element_size_bytes_) * kElementSizeEwmaWeight;
+  }
+  if (!ram_budget_manager_) {
+    return;
+  }
+  // Reconcile the bytes booked with the ram budget manager with the current
+  // estimate of the buffer's footprint.
+  const int64_t desired_bytes =
+      static_cast<int64_t>(*element_size_bytes_ * buffer_limit_);
+  const int64_t delta_bytes = desired_bytes - allocated_bytes_;
+  if (delta_bytes == 0) {
+    return;
+  }
+  if (ram_budget_manager_->RequestLegacyPrefetchBytes(delta_bytes)) {
+    allocated_bytes_ = desired_bytes;
+    return;
+  }
+  // The budget cannot cover the buffer at its current limit any more. Shrink
+  // the limit to what the bytes already booked can hold at the new element
+  // size estimate; the user-requested minimum is respected even if that
+  // leaves the buffer over budget.
+  if (mode_ == Mode::kDisabled) {
+    // The buffer size is fixed by the user; all we can do is warn.
+    LOG_EVERY_N_SEC(WARNING, 60)
+        << "The prefetch buffer exceeds the autotune ram budget: "
+        << buffer_limit_ << " elements of (estimated) " << *element_size_bytes_
+        << " bytes each. To stay within the ram budget, either increase the "
+        << "ram budget or reduce the buffer size.";
+    return;
+  }
+  const int64_t new_limit = std::max<int64_t>(
+      std::max<int64_t>(int64_t{1}, buffer_size_min_),
+      static_cast<int64_t>(allocated_bytes_ / *element_size_bytes_));
+  if (new_limit < buffer_limit_) {
+    VLOG(2) << "Prefetch autotuner shrinking the buffer limit from "
+            << buffer_limit_ << " to " << new_limit
+            << " to stay within the ram budget.";
+    buffer_limit_ = new_limit;
   }
-
-  element_size_bytes_ = element_size_bytes;
 }
 
 void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
@@ -78,15 +108,14 @@ void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
           // do not optimize the `buffer_limit_` yet.
           return;
         }
-        int64_t element_size_bytes = *element_size_bytes_;
         int64_t attempt_new_buffer_limit;
         if (buffer_limit_ >= static_cast<int64_t>(kBufferLimitThreshold)) {
           attempt_new_buffer_limit = buffer_limit_ + kBufferLimitThreshold;
         } else {
           attempt_new_buffer_limit = buffer_limit_ * 2;
         }
-        int64_t delta_bytes =
-            (attempt_new_buffer_limit - buffer_limit_) * element_size_bytes;
+        int64_t delta_bytes = static_cast<int64_t>(
+            (attempt_new_buffer_limit - buffer_limit_) * *element_size_bytes_);
 
         // When `ram_budget_manager_` is a nullptr, update
         // the buffer size without checking available RAM
@@ -97,6 +126,7 @@ void PrefetchAutotuner::RecordConsumption(size_t current_buffer_size) {
             ram_budget_manager_->RequestLegacyPrefetchBytes(delta_bytes)) {
           // Overwrite the current limit
           buffer_limit_ = attempt_new_buffer_limit;
+          allocated_bytes_ += delta_bytes;
         }
         mode_ = Mode::kUpswing;
       }
@@ -50,11 +50,13 @@ class PrefetchAutotuner {
 
   int64_t buffer_limit() const { return buffer_limit_; }
 
-  // Reports whether the element size has been set.
-  int64_t HasElementSize() const { return element_size_bytes_.has_value(); }
-  // Sets the element size to use for predicting memory usage. Element size must
-  // be set before the autotuner can increase the buffer size.
-  void SetElementSize(int64_t element_size_bytes);
+  // Records the size of an element produced by the prefetch buffer. The sizes
+  // are folded into a moving average used for predicting memory usage, and
+  // the bytes booked against the RAM budget are reconciled with the new
+  // estimate. If the buffer at its current limit no longer fits in the
+  // budget, the limit is shrunk. An element size must be recorded before the
+  // autotuner can increase the buffer size.
+  void RecordElementSize(int64_t element_size_bytes);
   void RecordConsumption(size_t current_buffer_size);
   void RecordEmpty() { RecordConsumption(0); }
 
@@ -74,8 +76,11 @@ class PrefetchAutotuner {
   };
 
   int64_t buffer_limit_;
-  // Estimated per-element size.
-  std::optional<int64_t> element_size_bytes_;
+  const int64_t buffer_size_min_;
+  // Moving average of the per-element size.
+  std::optional<double> element_size_bytes_;
+  // Bytes currently booked with the ram budget manager for this buffer.
+  int64_t allocated_bytes_ = 0;
   Mode mode_ = Mode::kDisabled;
   std::shared_ptr<model::RamBudgetManager> ram_budget_manager_;
 };
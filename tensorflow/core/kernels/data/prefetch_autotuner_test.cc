@@ -27,7 +27,7 @@ namespace {
 TEST(PrefetchAutotuner, Disabled) {
   auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/100);
   PrefetchAutotuner t(2, 0, ram_manager);
-  t.SetElementSize(1);
+  t.RecordElementSize(1);
   EXPECT_EQ(2, t.buffer_limit());
   t.RecordConsumption(0);
   t.RecordConsumption(2);
@@ -39,7 +39,7 @@ TEST(PrefetchAutotuner, Disabled) {
 TEST(PrefetchAutotuner, Enabled) {
   auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/100);
   PrefetchAutotuner t(model::kAutotune, 0, ram_manager);
-  t.SetElementSize(1);
+  t.RecordElementSize(1);
   EXPECT_EQ(1, t.buffer_limit());
   t.RecordConsumption(0);  // Expect buffer limit to stay the same.
   EXPECT_EQ(1, t.buffer_limit());
@@ -66,7 +66,7 @@ TEST(PrefetchAutotuner, Enabled) {
 TEST(PrefetchAutotuner, EnabledSteady) {
   auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/100);
   PrefetchAutotuner t(model::kAutotune, 0, ram_manager);
-  t.SetElementSize(1);
+  t.RecordElementSize(1);
   EXPECT_EQ(1, t.buffer_limit());
   t.RecordConsumption(0);  // Expect buffer limit to stay the same!
   EXPECT_EQ(1, t.buffer_limit());
@@ -91,7 +91,7 @@ TEST(PrefetchAutotuner, EnabledSteady) {
 TEST(PrefetchAutotuner, StartWithMin) {
   auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/100);
   PrefetchAutotuner t(model::kAutotune, 2, ram_manager);
-  t.SetElementSize(1);
+  t.RecordElementSize(1);
   EXPECT_EQ(2, t.buffer_limit());
   t.RecordConsumption(0);  // Expect buffer limit to stay the same!
   EXPECT_EQ(2, t.buffer_limit());
@@ -116,7 +116,7 @@ TEST(PrefetchAutotuner, StartWithMin) {
 TEST(PrefetchAutotuner, RespectRamManager) {
   auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/200);
   PrefetchAutotuner t(model::kAutotune, 2, ram_manager);
-  t.SetElementSize(50);
+  t.RecordElementSize(50);
   EXPECT_EQ(2, t.buffer_limit());
   // Buffer can grow once since 4*50 <= 200.
   t.RecordConsumption(2);
@@ -135,7 +135,7 @@ TEST(PrefetchAutotuner, RespectRamManagerWhenThereIsModelAllocation) {
   // 200 + `model_allocation` - `model_allocation` => 200
   ASSERT_TRUE(ram_manager->RequestModelAllocation(model_allocation));
   PrefetchAutotuner t(model::kAutotune, 2, ram_manager);
-  t.SetElementSize(50);
+  t.RecordElementSize(50);
   EXPECT_EQ(2, t.buffer_limit());
   // Buffer can grow once since 4*50 <= 200.
   t.RecordConsumption(2);
@@ -158,6 +158,45 @@ TEST(PrefetchAutotuner, RespectRamManagerWhenThereIsModelAllocation) {
   EXPECT_EQ(16, t.buffer_limit());
 }
 
+TEST(PrefetchAutotuner, ShrinkWhenElementsGrow) {
+  auto ram_manager = std::make_shared<model::RamBudgetManager>(/*budget=*/200);
+  PrefetchAutotuner t(model::kAutotune, 1, ram_manager);
+  t.RecordElementSize(10);
+  EXPECT_EQ(1, t.buffer_limit());
+  // Grow the buffer to 4 elements; 4 * 10 bytes fits comfortably.
+  t.RecordConsumption(1);
+  t.RecordConsumption(0);
+  EXPECT_EQ(2, t.buffer_limit());
+  t.RecordConsumption(2);
+  t.RecordConsumption(0);
+  EXPECT_EQ(4, t.buffer_limit());
+  // The elements turn out to be much larger than the first one. The moving
+  // average climbs until the buffer no longer fits in the budget, and the
+  // limit is pulled back.
+  for (int i = 0; i < 100; ++i) {
+    t.RecordElementSize(500);
+  }
+  EXPECT_EQ(1, t.buffer_limit());
+}
+
+TEST(PrefetchAutotuner, ElementSizeIsMovingAverage) {
+  auto ram_manager =
+      std::make_shared<model::RamBudgetManager>(/*budget=*/1000);
+  PrefetchAutotuner t(model::kAutotune, 0, ram_manager);
+  // A single outlier among small elements must not block buffer growth the
+  // way a first-seen size of 600 would (2 * 600 > 1000).
+  t.RecordElementSize(600);
+  for (int i = 0; i < 100; ++i) {
+    t.RecordElementSize(10);
+  }
+  t.RecordConsumption(1);
+  t.RecordConsumption(0);
+  EXPECT_EQ(2, t.buffer_limit());
+  t.RecordConsumption(2);
+  t.RecordConsumption(0);
+  EXPECT_EQ(4, t.buffer_limit());
+}
+
 }  // namespace
 }  // namespace data
 }  // namespace tensorflow
@@ -454,13 +454,11 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         *out_tensors = std::move(buffer_.front().value);
         ctx->MergeCheckpoint(&buffer_.front().checkpoint);
         RecordBufferDequeue(ctx, *out_tensors);
-        // Tells the legacy prefetch autotuner the size of an element to enable
-        // memory budget prediction.
-        if (legacy_autotune_ && !auto_tuner_->HasElementSize()) {
-          // TODO(jimlintw): Consider using a moving average to better
-          // estimate the element size instead of relying on the
-          // first-seen element size
-          auto_tuner_->SetElementSize(GetAllocatedBytes(*out_tensors));
+        // Feeds the legacy prefetch autotuner the size of each element so
+        // that its moving-average estimate of the buffer's memory footprint
+        // tracks the data, not just the first-seen element.
+        if (legacy_autotune_) {
+          auto_tuner_->RecordElementSize(GetAllocatedBytes(*out_tensors));
         }
       } else {
         // If status not ok, we still record the dequeue event to make sure each
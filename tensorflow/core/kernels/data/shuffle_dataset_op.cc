@@ -28,17 +28,20 @@ limitations under the License.
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
+#include "tensorflow/core/data/snapshot_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/kernels/data/random_seed_ops.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/random/philox_random.h"
 #include "tensorflow/core/lib/random/random.h"
 #include "tensorflow/core/lib/random/random_distributions.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -81,6 +84,39 @@ constexpr char kShuffleDatasetV3[] = "ShuffleDatasetV3";
 constexpr char kShuffleAndRepeatDatasetV1[] = "ShuffleAndRepeatDataset";
 constexpr char kShuffleAndRepeatDatasetV2[] = "ShuffleAndRepeatDatasetV2";
 
+namespace {
+
+// Number of spilled blocks that an external shuffle keeps open and randomly
+// interleaves at read time. Larger values mix blocks more thoroughly at the
+// cost of more read buffers and less sequential I/O.
+constexpr int64_t kMaxOpenExternalBlocks = 16;
+
+// Version 2 selects the TFRecord-based snapshot format, the same format
+// save/load uses for spilled elements.
+constexpr int kExternalBlockFileFormatVersion = 2;
+
+// When TF_DATA_EXTERNAL_SHUFFLE_DIR names a directory on local storage,
+// shuffle iterators with a bounded buffer switch to a two-level external
+// shuffle: elements are accumulated `buffer_size` at a time, shuffled, and
+// spilled to that directory as sequentially written blocks; at read time,
+// up to kMaxOpenExternalBlocks blocks are interleaved uniformly at random.
+// This approximates a full shuffle of datasets far larger than RAM while
+// bounding memory at one buffer and keeping disk I/O sequential.
+const string& ExternalShuffleDirectory() {
+  static const string* const dir = []() {
+    string* result = new string;
+    Status s =
+        ReadStringFromEnvVar("TF_DATA_EXTERNAL_SHUFFLE_DIR", "", result);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_DATA_EXTERNAL_SHUFFLE_DIR: " << s;
+    }
+    return result;
+  }();
+  return *dir;
+}
+
+}  // namespace
+
 ShuffleDatasetOpBase::ShuffleDatasetOpBase(OpKernelConstruction* ctx)
     : UnaryDatasetOpKernel(ctx) {}
 
@@ -190,8 +226,12 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         : DatasetIterator<ShuffleDatasetBase>(params),
           seed_generator_(seed_generator),
           parent_generator_(seed_generator->seed(), seed_generator->seed2()),
-          generator_(&parent_generator_) {
-      if (params.dataset->buffer_size_ == kUnknownCardinality) {
+          generator_(&parent_generator_),
+          external_shuffle_(
+              params.dataset->buffer_size_ != kUnknownCardinality &&
+              !ExternalShuffleDirectory().empty()) {
+      if (external_shuffle_ ||
+          params.dataset->buffer_size_ == kUnknownCardinality) {
         buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>();
       } else {
         buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>(
@@ -199,17 +239,33 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       }
     }
 
+    ~Iterator() override {
+      if (external_shuffle_ && !external_dir_.empty()) {
+        int64_t undeleted_files = 0;
+        int64_t undeleted_dirs = 0;
+        Env::Default()
+            ->DeleteRecursively(external_dir_, &undeleted_files,
+                                &undeleted_dirs)
+            .IgnoreError();
+      }
+    }
+
     bool SymbolicCheckpointCompatible() const override { return true; }
 
     Status Initialize(IteratorContext* ctx) override {
       mutex_lock l(mu_);
       seed_generator_->GenerateSeeds(&seed_, &seed2_);
       ResetRngs();
-      // Initialize checkpoint_indices_ to the entire buffer.
-      if (ctx->symbolic_checkpoint()) {
-        for (int64_t i = 0; i < buffer_->size(); ++i) {
-          checkpoint_indices_.insert(i);
-        }
+      if (external_shuffle_) {
+        external_dir_ =
+            io::JoinPath(ExternalShuffleDirectory(),
+                         absl::StrCat("tf_data_shuffle_", random::New64()));
+        TF_RETURN_IF_ERROR(ctx->env()->RecursivelyCreateDir(external_dir_));
+      }
+      // Initialize checkpoint_indices_ to the entire buffer, so that the
+      // first symbolic or delta save writes all of it.
+      for (int64_t i = 0; i < buffer_->size(); ++i) {
+        checkpoint_indices_.insert(i);
       }
       return OkStatus();
     }
@@ -218,6 +274,9 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
                            std::vector<Tensor>* out_tensors,
                            bool* end_of_sequence) override {
       mutex_lock l(mu_);
+      if (external_shuffle_) {
+        return ExternalGetNext(ctx, out_tensors, end_of_sequence);
+      }
       TF_RETURN_IF_ERROR(FillBuffer(ctx));
       if (num_elements_ == 0) {
         DCHECK(input_impl_ == nullptr);
@@ -262,6 +321,11 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
     Status SaveInternal(SerializationContext* ctx,
                         IteratorStateWriter* writer) override {
       mutex_lock l(mu_);
+      if (external_shuffle_) {
+        return errors::Unimplemented(
+            "Checkpointing is not supported when TF_DATA_EXTERNAL_SHUFFLE_DIR "
+            "is set; the shuffle state lives in spilled block files.");
+      }
       // Save state needed to restore the random number generators.
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kEpochNumRandomSamples,
@@ -284,11 +348,13 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       TF_RETURN_IF_ERROR(
           writer->WriteScalar(prefix(), kNumElements, num_elements_));
       const std::string key_prefix = absl::StrCat(prefix(), kColon, "buffer");
-      if (ctx->symbolic_checkpoint()) {
+      if (ctx->symbolic_checkpoint() || ctx->save_delta()) {
         // When symbolic checkpointing is turned on, `writer`
         // already contains checkpoint of the shuffle buffer created by the
         // previous invocation of this instance and the indices that need to be
-        // updated are stored in `checkpoint_indices`.
+        // updated are stored in `checkpoint_indices`. For delta saves, the
+        // buffer elements not written here are recovered from the previous
+        // checkpoint when the delta is restored on top of it.
         TF_RETURN_IF_ERROR(UpdateCheckpointElements(
             writer, key_prefix, *buffer_, checkpoint_indices_));
         checkpoint_indices_.clear();
@@ -322,6 +388,11 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
     Status RestoreInternal(IteratorContext* ctx,
                            IteratorStateReader* reader) override {
       mutex_lock l(mu_);
+      if (external_shuffle_) {
+        return errors::Unimplemented(
+            "Checkpointing is not supported when TF_DATA_EXTERNAL_SHUFFLE_DIR "
+            "is set; the shuffle state lives in spilled block files.");
+      }
       // Restore the random number generators.
       int64_t num_random_samples;
       TF_RETURN_IF_ERROR(reader->ReadScalar(prefix(), kEpochNumRandomSamples,
@@ -361,11 +432,9 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       TF_RETURN_IF_ERROR(ReadElementsFromCheckpoint(
           ctx, reader, absl::StrCat(prefix(), kColon, "buffer"),
           buffer_.get()));
-      if (ctx->symbolic_checkpoint()) {
-        DCHECK(checkpoint_indices_.empty());
-        for (size_t i = 0; i < buffer_->size(); ++i) {
-          checkpoint_indices_.insert(i);
-        }
+      checkpoint_indices_.clear();
+      for (size_t i = 0; i < buffer_->size(); ++i) {
+        checkpoint_indices_.insert(i);
       }
       for (const auto& element : *buffer_) {
         RecordBufferEnqueue(ctx, element);
@@ -556,6 +625,161 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       return absl::StrCat(dataset()->buffer_size_);
     }
 
+    // A spilled block that is currently being consumed. `remaining` counts
+    // the elements left in the file; blocks are written and read strictly
+    // sequentially.
+    struct ExternalBlock {
+      string filename;
+      int64_t remaining = 0;
+      std::unique_ptr<snapshot_util::Reader> reader;
+    };
+
+    // Produces the next element in external shuffle mode: spill the current
+    // epoch to blocks if that has not happened yet, then draw uniformly at
+    // random from the open blocks.
+    Status ExternalGetNext(IteratorContext* ctx,
+                           std::vector<Tensor>* out_tensors,
+                           bool* end_of_sequence)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      while (true) {
+        if (!external_spilled_) {
+          TF_RETURN_IF_ERROR(ExternalSpillEpoch(ctx));
+          external_spilled_ = true;
+        }
+        if (!open_blocks_.empty()) {
+          int64_t index = Random() % open_blocks_.size();
+          ExternalBlock& block = open_blocks_[index];
+          TF_RETURN_IF_ERROR(block.reader->ReadTensors(out_tensors));
+          if (--block.remaining == 0) {
+            TF_RETURN_IF_ERROR(RetireExternalBlock(ctx, index));
+          }
+          data_produced_ = true;
+          *end_of_sequence = false;
+          return OkStatus();
+        }
+        // The current pass over the input is exhausted.
+        epoch_++;
+        if (dataset()->count_ != -1 && epoch_ >= dataset()->count_) {
+          *end_of_sequence = true;
+          return OkStatus();
+        }
+        if (!data_produced_) {
+          // An empty input would otherwise make us respill forever.
+          *end_of_sequence = true;
+          return OkStatus();
+        }
+        external_spilled_ = false;
+      }
+    }
+
+    // Consumes one full pass over the input, spilling shuffled blocks of up
+    // to `buffer_size` elements, then opens the first set of blocks in a
+    // fresh random order.
+    Status ExternalSpillEpoch(IteratorContext* ctx)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      if (epoch_ > 0) {
+        for (const auto& provider : ctx->split_providers()) {
+          TF_RETURN_IF_ERROR(provider->Reset());
+        }
+      }
+      TF_RETURN_IF_ERROR(this->dataset()->input_->MakeIterator(
+          ctx, this, this->prefix(), &input_impl_));
+      pending_blocks_.clear();
+      open_blocks_.clear();
+      std::vector<std::vector<Tensor>> block;
+      block.reserve(dataset()->buffer_size_);
+      int64_t start_micros = EnvTime::NowMicros();
+      int64_t num_log_entries = 0;
+      while (true) {
+        if (EnvTime::NowMicros() >
+            ((num_log_entries + 1) * kLogIntervalMicros) + start_micros) {
+          num_log_entries++;
+          LOG_EVERY_N_SEC(INFO, 10)
+              << dataset()->metadata().name() << ": "
+              << "Spilling shuffled blocks (this may take a while): "
+              << pending_blocks_.size() << " blocks written";
+        }
+        std::vector<Tensor> element;
+        bool end_of_input = false;
+        TF_RETURN_IF_ERROR(
+            input_impl_->GetNext(ctx, &element, &end_of_input));
+        if (end_of_input) {
+          break;
+        }
+        block.push_back(std::move(element));
+        if (static_cast<int64_t>(block.size()) >= dataset()->buffer_size_) {
+          TF_RETURN_IF_ERROR(WriteExternalBlock(ctx, &block));
+        }
+      }
+      input_impl_.reset();
+      if (!block.empty()) {
+        TF_RETURN_IF_ERROR(WriteExternalBlock(ctx, &block));
+      }
+      if (num_log_entries > 0) {
+        LOG(INFO) << "Shuffled blocks spilled.";
+      }
+      // Visit the blocks in a fresh random order each pass.
+      for (int64_t i = pending_blocks_.size() - 1; i > 0; --i) {
+        std::swap(pending_blocks_[i], pending_blocks_[Random() % (i + 1)]);
+      }
+      while (open_blocks_.size() < kMaxOpenExternalBlocks &&
+             !pending_blocks_.empty()) {
+        TF_RETURN_IF_ERROR(OpenExternalBlock(ctx));
+      }
+      return OkStatus();
+    }
+
+    // Shuffles `block` in place and writes it out sequentially as one file.
+    Status WriteExternalBlock(IteratorContext* ctx,
+                              std::vector<std::vector<Tensor>>* block)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      for (int64_t i = block->size() - 1; i > 0; --i) {
+        std::swap((*block)[i], (*block)[Random() % (i + 1)]);
+      }
+      const string filename = io::JoinPath(
+          external_dir_, absl::StrCat("block_", next_block_index_++));
+      std::unique_ptr<snapshot_util::Writer> writer;
+      TF_RETURN_IF_ERROR(snapshot_util::Writer::Create(
+          ctx->env(), filename, /*compression_type=*/"",
+          kExternalBlockFileFormatVersion, dataset()->output_dtypes(),
+          &writer));
+      for (const auto& element : *block) {
+        TF_RETURN_IF_ERROR(writer->WriteTensors(element));
+      }
+      TF_RETURN_IF_ERROR(writer->Close());
+      pending_blocks_.emplace_back(filename,
+                                   static_cast<int64_t>(block->size()));
+      block->clear();
+      return OkStatus();
+    }
+
+    Status OpenExternalBlock(IteratorContext* ctx)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      ExternalBlock block;
+      block.filename = pending_blocks_.back().first;
+      block.remaining = pending_blocks_.back().second;
+      pending_blocks_.pop_back();
+      TF_RETURN_IF_ERROR(snapshot_util::Reader::Create(
+          ctx->env(), block.filename, /*compression_type=*/"",
+          kExternalBlockFileFormatVersion, dataset()->output_dtypes(),
+          &block.reader));
+      open_blocks_.push_back(std::move(block));
+      return OkStatus();
+    }
+
+    // Deletes the exhausted block at `index` and replaces it with the next
+    // pending one, if any.
+    Status RetireExternalBlock(IteratorContext* ctx, int64_t index)
+        TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      ctx->env()->DeleteFile(open_blocks_[index].filename).IgnoreError();
+      std::swap(open_blocks_[index], open_blocks_.back());
+      open_blocks_.pop_back();
+      if (!pending_blocks_.empty()) {
+        return OpenExternalBlock(ctx);
+      }
+      return OkStatus();
+    }
+
     mutex mu_;
     SeedGenerator* const seed_generator_ TF_GUARDED_BY(mu_);  // Not owned.
     std::unique_ptr<std::vector<std::vector<Tensor>>> buffer_
@@ -579,6 +803,15 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         TF_GUARDED_BY(mu_);
     int64_t num_random_samples_ TF_GUARDED_BY(mu_) = 0;
     bool data_produced_ TF_GUARDED_BY(mu_) = false;
+    // External shuffle state; see ExternalShuffleDirectory().
+    const bool external_shuffle_;
+    string external_dir_ TF_GUARDED_BY(mu_);
+    int64_t next_block_index_ TF_GUARDED_BY(mu_) = 0;
+    bool external_spilled_ TF_GUARDED_BY(mu_) = false;
+    // (filename, element count) of blocks not yet opened for reading.
+    std::vector<std::pair<string, int64_t>> pending_blocks_
+        TF_GUARDED_BY(mu_);
+    std::vector<ExternalBlock> open_blocks_ TF_GUARDED_BY(mu_);
   };
 
   const DatasetBase* const input_;
@@ -25,6 +25,7 @@ limitations under the License.
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/lib/io/zlib_compression_options.h"
 #include "tensorflow/core/lib/io/zlib_inputstream.h"
+#include "tsl/lib/io/file_read_cache.h"
 
 namespace tensorflow {
 namespace data {
@@ -260,9 +261,12 @@ class TFRecordDatasetOp::Dataset : public DatasetBase {
       }
 
       // Actually move on to next file.
-      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(
-          TranslateFileName(dataset()->filenames_[current_file_index_]),
-          &file_));
+      const string filename =
+          TranslateFileName(dataset()->filenames_[current_file_index_]);
+      TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file_));
+      // If the process-wide file read cache is enabled, serve reads from it
+      // so concurrent streams over the same (hot) file share its blocks.
+      TF_RETURN_IF_ERROR(tsl::io::MaybeCacheFileReads(env, filename, &file_));
       reader_ = std::make_unique<io::SequentialRecordReader>(
           file_.get(), dataset()->options_);
       if (!dataset()->byte_offsets_.empty()) {
@@ -15,6 +15,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/data/zip_dataset_op.h"
 
 #include <functional>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -121,8 +122,9 @@ class ZipDatasetOp::Dataset : public DatasetBase {
     for (int i = 0; i < inputs_.size(); ++i) {
       std::vector<Tensor> input_tensors;
       TF_RETURN_IF_ERROR(inputs_[i]->Get(ctx, index, &input_tensors));
-      out_tensors->insert(out_tensors->end(), input_tensors.begin(),
-                          input_tensors.end());
+      out_tensors->insert(out_tensors->end(),
+                          std::make_move_iterator(input_tensors.begin()),
+                          std::make_move_iterator(input_tensors.end()));
     }
     return OkStatus();
   }
@@ -202,8 +204,9 @@ class ZipDatasetOp::Dataset : public DatasetBase {
           }
           break;
         }
-        out_tensors->insert(out_tensors->end(), input_tensors.begin(),
-                            input_tensors.end());
+        out_tensors->insert(out_tensors->end(),
+                            std::make_move_iterator(input_tensors.begin()),
+                            std::make_move_iterator(input_tensors.end()));
       }
       if (*end_of_sequence || !status.ok()) {
         out_tensors->clear();
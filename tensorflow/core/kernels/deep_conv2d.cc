@@ -20,8 +20,14 @@ limitations under the License.
 
 #include <stdlib.h>
 
+#include <list>
+#include <memory>
+#include <unordered_map>
+
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/winograd_transform.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
@@ -931,6 +937,76 @@ struct ComputeConv2D {
   }
 };
 
+// Caches Winograd-transformed, gemm-packed filters across executions so the
+// pack cost is paid once per weight instead of once per inference. Serving
+// weights are immutable, but nothing at the kernel level marks them as such
+// (and in-place variable updates reuse the same buffer), so entries are
+// keyed by a fingerprint of the filter contents together with the geometry
+// that determines the packed layout. The per-call fingerprint is a single
+// pass over the filter bytes, which is far cheaper than re-running the
+// transform and pack. Stale entries -- e.g. filters that change every step
+// during training -- simply miss and age out of the LRU list.
+class PackedFilterCache {
+ public:
+  struct Entry {
+    std::vector<Tensor> packed_filters;
+  };
+  using EntryPtr = std::shared_ptr<Entry>;
+
+  static PackedFilterCache* Global() {
+    static PackedFilterCache* cache = new PackedFilterCache;
+    return cache;
+  }
+
+  EntryPtr Lookup(uint64 key) {
+    mutex_lock l(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+    lru_.erase(it->second.lru_pos);
+    lru_.push_front(key);
+    it->second.lru_pos = lru_.begin();
+    return it->second.entry;
+  }
+
+  void Insert(uint64 key, EntryPtr entry, int64_t bytes) {
+    if (bytes > kMaxBytes) return;
+    mutex_lock l(mu_);
+    if (entries_.find(key) != entries_.end()) return;
+    while (!lru_.empty() && total_bytes_ + bytes > kMaxBytes) {
+      auto last = entries_.find(lru_.back());
+      total_bytes_ -= last->second.bytes;
+      entries_.erase(last);
+      lru_.pop_back();
+    }
+    lru_.push_front(key);
+    entries_[key] = Node{std::move(entry), bytes, lru_.begin()};
+    total_bytes_ += bytes;
+  }
+
+ private:
+  // Large enough for the convolution weights of typical serving models,
+  // small enough that eviction bounds memory when fingerprints keep
+  // changing.
+  static constexpr int64_t kMaxBytes = 256 << 20;
+
+  struct Node {
+    EntryPtr entry;
+    int64_t bytes;
+    std::list<uint64>::iterator lru_pos;
+  };
+
+  mutex mu_;
+  std::list<uint64> lru_ TF_GUARDED_BY(mu_);  // Most recent at the front.
+  std::unordered_map<uint64, Node> entries_ TF_GUARDED_BY(mu_);
+  int64_t total_bytes_ TF_GUARDED_BY(mu_) = 0;
+};
+
+bool PackedFilterCacheEnabled() {
+  static const bool enabled =
+      getenv("TF_DISABLE_PACKED_FILTER_CACHE") == nullptr;
+  return enabled;
+}
+
 namespace functor {
 
 // Conv2D operation specialized for deep convolutions (i.e. large
@@ -975,24 +1051,57 @@ struct DeepConv2D<CPUDevice, T> {
         std::max(int64_t{0}, args.filter_cols - base_filter_rows);
     const int64_t filter_shards_col = 1 + (filter_residual_col + 2 - 1) / 2;
 
-    // Allocate buffer for transformed filters.
-    Tensor filter_transform;
-    OP_REQUIRES_OK(
-        ctx, ctx->allocate_temp(
-                 DataTypeToEnum<T>::value,
-                 TensorShape({tile_rows, tile_cols, out_depth,
-                              filter_shards_row, filter_shards_col, in_depth}),
-                 &filter_transform));
-    T* filter_transform_data = filter_transform.template flat<T>().data();
-
-    // Transform filters.
-    TransformFilters<T>()(ctx, args, transform.get(), filter_shards_row,
-                          filter_shards_col, filter, filter_transform_data);
-
-    // Pack filters.
-    std::vector<Tensor> packed_filters(tile_spatial_size);
-    PackFilters<T>()(ctx, args, tile_spatial_size, filter_shards_row,
-                     filter_shards_col, filter_transform_data, &packed_filters);
+    PackedFilterCache::EntryPtr packed_entry;
+    uint64 cache_key = 0;
+    const bool use_filter_cache = PackedFilterCacheEnabled();
+    if (use_filter_cache) {
+      // The geometry seeds the fingerprint, since it determines both the
+      // transform and the packed layout.
+      uint64 seed = Hash64Combine(DataTypeToEnum<T>::value,
+                                  Hash64Combine(in_depth, out_depth));
+      seed = Hash64Combine(seed,
+                           Hash64Combine(args.filter_rows, args.filter_cols));
+      const int64_t filter_size =
+          args.filter_rows * args.filter_cols * in_depth * out_depth;
+      cache_key = Hash64(reinterpret_cast<const char*>(filter),
+                         filter_size * sizeof(T), seed);
+      packed_entry = PackedFilterCache::Global()->Lookup(cache_key);
+    }
+
+    if (packed_entry == nullptr) {
+      packed_entry = std::make_shared<PackedFilterCache::Entry>();
+      packed_entry->packed_filters.resize(tile_spatial_size);
+
+      // Allocate buffer for transformed filters.
+      Tensor filter_transform;
+      OP_REQUIRES_OK(
+          ctx,
+          ctx->allocate_temp(
+              DataTypeToEnum<T>::value,
+              TensorShape({tile_rows, tile_cols, out_depth, filter_shards_row,
+                           filter_shards_col, in_depth}),
+              &filter_transform));
+      T* filter_transform_data = filter_transform.template flat<T>().data();
+
+      // Transform filters.
+      TransformFilters<T>()(ctx, args, transform.get(), filter_shards_row,
+                            filter_shards_col, filter, filter_transform_data);
+
+      // Pack filters.
+      PackFilters<T>()(ctx, args, tile_spatial_size, filter_shards_row,
+                       filter_shards_col, filter_transform_data,
+                       &packed_entry->packed_filters);
+
+      if (use_filter_cache) {
+        const int64_t packed_bytes = tile_spatial_size * out_depth *
+                                     filter_shards_row * filter_shards_col *
+                                     in_depth *
+                                     static_cast<int64_t>(sizeof(T));
+        PackedFilterCache::Global()->Insert(cache_key, packed_entry,
+                                            packed_bytes);
+      }
+    }
+    const std::vector<Tensor>& packed_filters = packed_entry->packed_filters;
 
     // Allocate buffer for tile transform matrix.
     Tensor tile_transform_matrix_tensor;
@@ -213,9 +213,12 @@ class FakeQuantWithMinMaxVarsOp : public OpKernel {
         context, TensorShapeUtils::IsScalar(max.shape()),
         InvalidArgument("`max` must be rank 0 but is rank ", max.dims()));
 
+    // The quantization is coefficient-wise in the input (the nudged range is
+    // derived from the scalar min/max only), so the input buffer can be
+    // reused for the output.
     Tensor* output;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, input.shape(), &output));
 
     FakeQuantWithMinMaxVarsFunctor<Device> functor;
     functor(context->eigen_device<Device>(), input.flat<float>(),
@@ -371,9 +374,11 @@ class FakeQuantWithMinMaxVarsPerChannelOp : public OpKernel {
                 InvalidArgument("max has incorrect size, expected ", depth,
                                 " was ", max.dim_size(0)));
 
+    // Coefficient-wise in the input, as above; the per-channel ranges live in
+    // separate tensors.
     Tensor* output;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                {0}, 0, input.shape(), &output));
 
     FakeQuantWithMinMaxVarsPerChannelFunctor<Device> functor;
     functor(context->eigen_device<Device>(), input.flat_inner_dims<float, 2>(),
@@ -0,0 +1,220 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/kernels/ops_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/jpeg/jpeg_mem.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+using DecodeAndCropJpegBatchTest = OpsTestBase;
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 64;
+constexpr int kChannels = 3;
+
+// Synthesizes a kHeight x kWidth RGB gradient image and JPEG-encodes it.
+// 'phase' shifts the gradient so different batch elements hold different
+// pixel data.
+tstring MakeTestJpeg(int phase) {
+  std::vector<uint8> pixels(kHeight * kWidth * kChannels);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      for (int c = 0; c < kChannels; ++c) {
+        pixels[(y * kWidth + x) * kChannels + c] =
+            static_cast<uint8>((x * 7 + y * 3 + c * 11 + phase) % 256);
+      }
+    }
+  }
+  jpeg::CompressFlags flags;
+  flags.format = jpeg::FORMAT_RGB;
+  return jpeg::Compress(pixels.data(), kWidth, kHeight, flags);
+}
+
+// Reference decode of a single crop window through jpeg::Uncompress, using
+// the same flags the kernel derives from its default attrs.
+std::unique_ptr<uint8[]> ReferenceDecode(const tstring& encoded, int crop_y,
+                                         int crop_x, int crop_height,
+                                         int crop_width) {
+  jpeg::UncompressFlags flags;
+  flags.components = kChannels;
+  flags.dct_method = JDCT_IFAST;
+  flags.crop = true;
+  flags.crop_y = crop_y;
+  flags.crop_x = crop_x;
+  flags.crop_height = crop_height;
+  flags.crop_width = crop_width;
+  int width;
+  int height;
+  int components;
+  std::unique_ptr<uint8[]> decoded(jpeg::Uncompress(
+      encoded.data(), encoded.size(), flags, &width, &height, &components,
+      nullptr /* nwarn */));
+  EXPECT_NE(decoded, nullptr);
+  EXPECT_EQ(width, crop_width);
+  EXPECT_EQ(height, crop_height);
+  EXPECT_EQ(components, kChannels);
+  return decoded;
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, MatchesSingleImageDecodes) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const tstring jpegs[3] = {MakeTestJpeg(0), MakeTestJpeg(50),
+                            MakeTestJpeg(100)};
+  // All windows share 24x16, at different offsets per image.
+  const int32 windows[3][4] = {{0, 0, 24, 16}, {8, 16, 24, 16},
+                               {40, 48, 24, 16}};
+
+  AddInputFromArray<tstring>(TensorShape({3}), {jpegs[0], jpegs[1], jpegs[2]});
+  AddInputFromArray<int32>(
+      TensorShape({3, 4}),
+      {windows[0][0], windows[0][1], windows[0][2], windows[0][3],
+       windows[1][0], windows[1][1], windows[1][2], windows[1][3],
+       windows[2][0], windows[2][1], windows[2][2], windows[2][3]});
+  TF_ASSERT_OK(RunOpKernel());
+
+  const Tensor& output = *GetOutput(0);
+  EXPECT_EQ(output.shape(), TensorShape({3, 24, 16, kChannels}));
+  const uint8* output_data = output.flat<uint8>().data();
+  const int64_t image_bytes = 24 * 16 * kChannels;
+  for (int i = 0; i < 3; ++i) {
+    std::unique_ptr<uint8[]> expected =
+        ReferenceDecode(jpegs[i], windows[i][0], windows[i][1], windows[i][2],
+                        windows[i][3]);
+    EXPECT_EQ(memcmp(output_data + i * image_bytes, expected.get(),
+                     image_bytes),
+              0)
+        << "batch element " << i;
+  }
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, FailsForMismatchedCropWindowSizes) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const tstring jpeg = MakeTestJpeg(0);
+  AddInputFromArray<tstring>(TensorShape({2}), {jpeg, jpeg});
+  // Window 1 has a different height than window 0.
+  AddInputFromArray<int32>(TensorShape({2, 4}), {0, 0, 24, 16, 0, 0, 32, 16});
+  Status status = RunOpKernel();
+  EXPECT_TRUE(errors::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(),
+                                "All crop windows must share the same height"))
+      << status.message();
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, FailsForOutOfBoundsCropWindow) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const tstring jpeg = MakeTestJpeg(0);
+  AddInputFromArray<tstring>(TensorShape({2}), {jpeg, jpeg});
+  // Window 1 extends past the bottom of the 64x64 image.
+  AddInputFromArray<int32>(TensorShape({2, 4}), {0, 0, 24, 16, 48, 0, 24, 16});
+  Status status = RunOpKernel();
+  EXPECT_TRUE(errors::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "batch element 1"))
+      << status.message();
+  EXPECT_TRUE(
+      absl::StrContains(status.message(), "Invalid JPEG data or crop window"))
+      << status.message();
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, ReportsFailingElementFromShardedDecode) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  // A batch large enough to be split across shards, with a single corrupt
+  // element in the middle; the error from whichever shard hits it must
+  // surface with that element's index.
+  std::vector<tstring> jpegs(8, MakeTestJpeg(0));
+  jpegs[5] = "not a jpeg";
+  std::vector<int32> windows;
+  for (int i = 0; i < 8; ++i) {
+    windows.insert(windows.end(), {0, 0, 24, 16});
+  }
+  AddInputFromArray<tstring>(TensorShape({8}), jpegs);
+  AddInputFromArray<int32>(TensorShape({8, 4}), windows);
+  Status status = RunOpKernel();
+  EXPECT_TRUE(errors::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "batch element 5"))
+      << status.message();
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, FailsForTruncatedInputByDefault) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const tstring jpeg = MakeTestJpeg(0);
+  const tstring truncated(jpeg.data(), jpeg.size() * 6 / 10);
+  AddInputFromArray<tstring>(TensorShape({1}), {truncated});
+  AddInputFromArray<int32>(TensorShape({1, 4}),
+                           {0, 0, kHeight, kWidth});
+  Status status = RunOpKernel();
+  EXPECT_TRUE(errors::IsInvalidArgument(status));
+  EXPECT_TRUE(absl::StrContains(status.message(), "batch element 0"))
+      << status.message();
+}
+
+TEST_F(DecodeAndCropJpegBatchTest, RecoversTruncatedInputWhenAcceptable) {
+  TF_ASSERT_OK(NodeDefBuilder("decode_batch_op", "DecodeAndCropJpegBatch")
+                   .Input(FakeInput(DT_STRING))
+                   .Input(FakeInput(DT_INT32))
+                   .Attr("try_recover_truncated", true)
+                   .Attr("acceptable_fraction", 0.1f)
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+
+  const tstring jpeg = MakeTestJpeg(0);
+  const tstring truncated(jpeg.data(), jpeg.size() * 6 / 10);
+  AddInputFromArray<tstring>(TensorShape({1}), {truncated});
+  AddInputFromArray<int32>(TensorShape({1, 4}),
+                           {0, 0, kHeight, kWidth});
+  TF_ASSERT_OK(RunOpKernel());
+  EXPECT_EQ(GetOutput(0)->shape(),
+            TensorShape({1, kHeight, kWidth, kChannels}));
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -40,8 +40,10 @@ limitations under the License.
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/stringpiece.h"
 #include "tensorflow/core/platform/tstring.h"
+#include "tensorflow/core/util/work_sharder.h"
 #include "tsl/util/byte_swap_array.h"
 
 namespace tensorflow {
@@ -749,5 +751,159 @@ void DecodeImageV2Op::DecodeBMP(const uint8* input, const int row_size,
   }
 }
 
+// Decodes a batch of JPEG images whose crop windows share a common height and
+// width, sharding the per-image decodes over the intra-op thread pool. Because
+// the crop window (applied after any `ratio` downscaling, using libjpeg-turbo's
+// partial decode) fixes the output size, the result is a dense
+// `[batch, crop_height, crop_width, channels]` tensor, which is what input
+// pipelines that crop to a fixed training resolution consume anyway.
+class DecodeAndCropJpegBatchOp : public OpKernel {
+ public:
+  explicit DecodeAndCropJpegBatchOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("channels", &flags_.components));
+    // Unlike the single-image ops, channel autodetection is not supported:
+    // images in a batch could disagree, and the output tensor is dense.
+    OP_REQUIRES(context, flags_.components == 1 || flags_.components == 3,
+                errors::InvalidArgument(
+                    "channels must be 1 or 3 for batched JPEG decoding, got ",
+                    flags_.components));
+    OP_REQUIRES_OK(context, context->GetAttr("ratio", &flags_.ratio));
+    OP_REQUIRES(context,
+                flags_.ratio == 1 || flags_.ratio == 2 || flags_.ratio == 4 ||
+                    flags_.ratio == 8,
+                errors::InvalidArgument("ratio must be 1, 2, 4, or 8, got ",
+                                        flags_.ratio));
+    OP_REQUIRES_OK(context, context->GetAttr("fancy_upscaling",
+                                             &flags_.fancy_upscaling));
+    OP_REQUIRES_OK(context, context->GetAttr("try_recover_truncated",
+                                             &flags_.try_recover_truncated_jpeg));
+    OP_REQUIRES_OK(context, context->GetAttr("acceptable_fraction",
+                                             &flags_.min_acceptable_fraction));
+    string dct_method;
+    OP_REQUIRES_OK(context, context->GetAttr("dct_method", &dct_method));
+    OP_REQUIRES(context,
+                (dct_method.empty() || dct_method == "INTEGER_FAST" ||
+                 dct_method == "INTEGER_ACCURATE"),
+                errors::InvalidArgument("dct_method must be one of "
+                                        "{'', 'INTEGER_FAST', "
+                                        "'INTEGER_ACCURATE'}"));
+    if (dct_method.empty() || dct_method == "INTEGER_FAST") {
+      flags_.dct_method = JDCT_IFAST;
+    } else if (dct_method == "INTEGER_ACCURATE") {
+      flags_.dct_method = JDCT_ISLOW;
+    }
+    flags_.crop = true;
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& contents = context->input(0);
+    OP_REQUIRES(context, TensorShapeUtils::IsVector(contents.shape()),
+                errors::InvalidArgument("contents must be a vector, got shape ",
+                                        contents.shape().DebugString()));
+    const Tensor& crop_windows = context->input(1);
+    OP_REQUIRES(
+        context,
+        TensorShapeUtils::IsMatrix(crop_windows.shape()) &&
+            crop_windows.dim_size(1) == 4,
+        errors::InvalidArgument("crop_windows must have shape [batch, 4], got ",
+                                crop_windows.shape().DebugString()));
+    const int64_t batch_size = contents.dim_size(0);
+    OP_REQUIRES(context, crop_windows.dim_size(0) == batch_size,
+                errors::InvalidArgument(
+                    "contents and crop_windows must have the same batch size, "
+                    "got ",
+                    batch_size, " vs. ", crop_windows.dim_size(0)));
+
+    if (batch_size == 0) {
+      Tensor* output = nullptr;
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(
+                         0, TensorShape({0, 0, 0, flags_.components}), &output));
+      return;
+    }
+
+    const auto crop_windows_mat = crop_windows.matrix<int32>();
+    const int32_t crop_height = crop_windows_mat(0, 2);
+    const int32_t crop_width = crop_windows_mat(0, 3);
+    OP_REQUIRES(context, crop_height > 0 && crop_width > 0,
+                errors::InvalidArgument("Crop height and width must be "
+                                        "positive, got ",
+                                        crop_height, " and ", crop_width));
+    for (int64_t i = 0; i < batch_size; ++i) {
+      OP_REQUIRES(context,
+                  crop_windows_mat(i, 2) == crop_height &&
+                      crop_windows_mat(i, 3) == crop_width,
+                  errors::InvalidArgument(
+                      "All crop windows must share the same height and width; "
+                      "window 0 is ",
+                      crop_height, "x", crop_width, " but window ", i, " is ",
+                      crop_windows_mat(i, 2), "x", crop_windows_mat(i, 3)));
+    }
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(
+        context,
+        context->allocate_output(
+            0, TensorShape({batch_size, crop_height, crop_width,
+                            flags_.components}),
+            &output));
+    uint8* output_base = output->flat<uint8>().data();
+    const int64_t image_bytes =
+        static_cast<int64_t>(crop_height) * crop_width * flags_.components;
+
+    const auto contents_vec = contents.vec<tstring>();
+    mutex mu;
+    Status status;
+    auto decode_range = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        const tstring& input = contents_vec(i);
+        // Use a local copy of flags since the decode runs concurrently.
+        jpeg::UncompressFlags flags = flags_;
+        flags.crop_y = crop_windows_mat(i, 0);
+        flags.crop_x = crop_windows_mat(i, 1);
+        flags.crop_height = crop_height;
+        flags.crop_width = crop_width;
+        uint8* const dst = output_base + i * image_bytes;
+        uint8* buffer = jpeg::Uncompress(
+            input.data(), input.size(), flags, nullptr /* nwarn */,
+            [&](int width, int height, int channels) -> uint8* {
+              if (width != crop_width || height != crop_height ||
+                  channels != flags_.components) {
+                return nullptr;
+              }
+              return dst;
+            });
+        if (buffer == nullptr) {
+          mutex_lock lock(mu);
+          if (status.ok()) {
+            status = errors::InvalidArgument(
+                "jpeg::Uncompress failed for batch element ", i,
+                ". Invalid JPEG data or crop window.");
+          }
+          return;
+        }
+      }
+    };
+
+    // Decoding dominated by the IDCT runs at a few hundred cycles per output
+    // pixel; the exact constant only needs to be large enough that single
+    // images are not split below one image per shard (Shard can't subdivide an
+    // image anyway since the unit here is a whole decode).
+    const int64_t cost_per_image = 200 * image_bytes;
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    Shard(worker_threads->num_threads, worker_threads->workers, batch_size,
+          cost_per_image, decode_range);
+
+    OP_REQUIRES_OK(context, status);
+  }
+
+ private:
+  jpeg::UncompressFlags flags_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("DecodeAndCropJpegBatch").Device(DEVICE_CPU),
+                        DecodeAndCropJpegBatchOp);
+
 }  // namespace
 }  // namespace tensorflow
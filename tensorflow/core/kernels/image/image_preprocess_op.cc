@@ -0,0 +1,274 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// See docs in ../ops/image_ops.cc
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/util/image_resizer_state.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+// Compute the interpolation indices only once; same scheme as
+// resize_bilinear_op.cc.
+struct CachedInterpolation {
+  int64_t lower;  // Lower source index used in the interpolation
+  int64_t upper;  // Upper source index used in the interpolation
+  // 1-D linear interpolation scale (see:
+  // https://en.wikipedia.org/wiki/Bilinear_interpolation)
+  float lerp;
+};
+
+template <typename Scaler>
+void ComputeInterpolationWeights(const Scaler scaler, const int64_t out_size,
+                                 const int64_t in_size, const float scale,
+                                 CachedInterpolation* interpolation) {
+  for (int64_t i = out_size - 1; i >= 0; --i) {
+    const float in = scaler(i, scale);
+    const float in_f = std::floor(in);
+    interpolation[i].lower =
+        std::max(static_cast<int64_t>(in_f), static_cast<int64_t>(0));
+    interpolation[i].upper =
+        std::min(static_cast<int64_t>(std::ceil(in)), in_size - 1);
+    interpolation[i].lerp = in - in_f;
+  }
+}
+
+// Computes the bilinear interpolation from the appropriate 4 float points
+// and the linear interpolation weights.
+inline float ComputeLerp(const float top_left, const float top_right,
+                         const float bottom_left, const float bottom_right,
+                         const float x_lerp, const float y_lerp) {
+  const float top = top_left + (top_right - top_left) * x_lerp;
+  const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
+  return top + (bottom - top) * y_lerp;
+}
+
+// Fused resize-bilinear + spatial pad + mean/scale normalization. Computes
+//   output = (pad(resize_bilinear(images), paddings, pad_value) - mean) * scale
+// in a single pass over the output, so the intermediate resized and padded
+// images are never materialized. `pad_value` is interpreted in the
+// pre-normalization domain, matching a Pad op that runs before the
+// normalization arithmetic.
+template <typename T>
+class ImagePreprocessOp : public OpKernel {
+ public:
+  explicit ImagePreprocessOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("align_corners", &align_corners_));
+    OP_REQUIRES_OK(
+        context, context->GetAttr("half_pixel_centers", &half_pixel_centers_));
+    OP_REQUIRES_OK(context, context->GetAttr("pad_value", &pad_value_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& images = context->input(0);
+    OP_REQUIRES(context, images.dims() == 4,
+                errors::InvalidArgument("images must be 4-D, got shape ",
+                                        images.shape().DebugString()));
+    const int64_t batch_size = images.dim_size(0);
+    const int64_t in_height = images.dim_size(1);
+    const int64_t in_width = images.dim_size(2);
+    const int64_t channels = images.dim_size(3);
+    OP_REQUIRES(context, in_height > 0 && in_width > 0,
+                errors::InvalidArgument("images must be non-empty"));
+
+    const Tensor& size = context->input(1);
+    OP_REQUIRES(
+        context,
+        TensorShapeUtils::IsVector(size.shape()) && size.dim_size(0) == 2,
+        errors::InvalidArgument("size must be a vector with two elements, got ",
+                                size.shape().DebugString()));
+    auto size_vec = size.vec<int32>();
+    const int64_t out_height = size_vec(0);
+    const int64_t out_width = size_vec(1);
+    OP_REQUIRES(context, out_height > 0 && out_width > 0,
+                errors::InvalidArgument("size must be positive, got [",
+                                        out_height, ", ", out_width, "]"));
+
+    const Tensor& paddings = context->input(2);
+    OP_REQUIRES(context,
+                TensorShapeUtils::IsMatrix(paddings.shape()) &&
+                    paddings.dim_size(0) == 2 && paddings.dim_size(1) == 2,
+                errors::InvalidArgument("paddings must have shape [2, 2], got ",
+                                        paddings.shape().DebugString()));
+    auto paddings_mat = paddings.matrix<int32>();
+    const int64_t pad_top = paddings_mat(0, 0);
+    const int64_t pad_bottom = paddings_mat(0, 1);
+    const int64_t pad_left = paddings_mat(1, 0);
+    const int64_t pad_right = paddings_mat(1, 1);
+    OP_REQUIRES(
+        context,
+        pad_top >= 0 && pad_bottom >= 0 && pad_left >= 0 && pad_right >= 0,
+        errors::InvalidArgument("paddings must be non-negative"));
+
+    const Tensor& mean = context->input(3);
+    const Tensor& scale = context->input(4);
+    for (const Tensor* t : {&mean, &scale}) {
+      OP_REQUIRES(
+          context,
+          TensorShapeUtils::IsScalar(t->shape()) ||
+              (TensorShapeUtils::IsVector(t->shape()) &&
+               t->dim_size(0) == channels),
+          errors::InvalidArgument("mean and scale must be scalars or vectors "
+                                  "of length channels (",
+                                  channels, "), got ",
+                                  t->shape().DebugString()));
+    }
+
+    const int64_t final_height = out_height + pad_top + pad_bottom;
+    const int64_t final_width = out_width + pad_left + pad_right;
+    OP_REQUIRES(
+        context,
+        final_height < std::numeric_limits<int32>::max() &&
+            final_width < std::numeric_limits<int32>::max(),
+        errors::InvalidArgument("padded output dimensions must fit in int32"));
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(
+                       0,
+                       TensorShape({batch_size, final_height, final_width,
+                                    channels}),
+                       &output));
+    if (output->NumElements() == 0) return;
+
+    // Broadcast mean/scale to per-channel vectors and precompute the value
+    // the padded region normalizes to.
+    std::vector<float> mean_v(channels), scale_v(channels), pad_v(channels);
+    auto mean_flat = mean.flat<float>();
+    auto scale_flat = scale.flat<float>();
+    for (int64_t c = 0; c < channels; ++c) {
+      mean_v[c] = mean_flat(mean.NumElements() == 1 ? 0 : c);
+      scale_v[c] = scale_flat(scale.NumElements() == 1 ? 0 : c);
+      pad_v[c] = (pad_value_ - mean_v[c]) * scale_v[c];
+    }
+
+    const float height_scale =
+        CalculateResizeScale(in_height, out_height, align_corners_);
+    const float width_scale =
+        CalculateResizeScale(in_width, out_width, align_corners_);
+
+    std::vector<CachedInterpolation> xs(out_width);
+    std::vector<CachedInterpolation> ys(out_height);
+    if (half_pixel_centers_) {
+      ComputeInterpolationWeights(HalfPixelScaler(), out_height, in_height,
+                                  height_scale, ys.data());
+      ComputeInterpolationWeights(HalfPixelScaler(), out_width, in_width,
+                                  width_scale, xs.data());
+    } else {
+      ComputeInterpolationWeights(LegacyScaler(), out_height, in_height,
+                                  height_scale, ys.data());
+      ComputeInterpolationWeights(LegacyScaler(), out_width, in_width,
+                                  width_scale, xs.data());
+    }
+
+    typename TTypes<T, 4>::ConstTensor images_data = images.tensor<T, 4>();
+    float* output_base = output->flat<float>().data();
+    const int64_t out_row_elems = final_width * channels;
+    const int64_t in_row_elems = in_width * channels;
+    const T* input_base = images_data.data();
+    const int64_t in_image_elems = in_height * in_row_elems;
+
+    auto fill_pad_row = [&](float* row) {
+      for (int64_t x = 0; x < final_width; ++x) {
+        for (int64_t c = 0; c < channels; ++c) {
+          row[x * channels + c] = pad_v[c];
+        }
+      }
+    };
+
+    auto process_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t r = begin; r < end; ++r) {
+        const int64_t b = r / final_height;
+        const int64_t y = r % final_height;
+        float* out_row = output_base + r * out_row_elems;
+        if (y < pad_top || y >= pad_top + out_height) {
+          fill_pad_row(out_row);
+          continue;
+        }
+        const CachedInterpolation& y_interp = ys[y - pad_top];
+        const T* input_top =
+            input_base + b * in_image_elems + y_interp.lower * in_row_elems;
+        const T* input_bot =
+            input_base + b * in_image_elems + y_interp.upper * in_row_elems;
+        for (int64_t x = 0; x < pad_left; ++x) {
+          for (int64_t c = 0; c < channels; ++c) {
+            out_row[x * channels + c] = pad_v[c];
+          }
+        }
+        for (int64_t x = 0; x < out_width; ++x) {
+          const CachedInterpolation& x_interp = xs[x];
+          const int64_t xl = x_interp.lower * channels;
+          const int64_t xu = x_interp.upper * channels;
+          float* out_pixel = out_row + (pad_left + x) * channels;
+          for (int64_t c = 0; c < channels; ++c) {
+            const float interp = ComputeLerp(
+                static_cast<float>(input_top[xl + c]),
+                static_cast<float>(input_top[xu + c]),
+                static_cast<float>(input_bot[xl + c]),
+                static_cast<float>(input_bot[xu + c]), x_interp.lerp,
+                y_interp.lerp);
+            out_pixel[c] = (interp - mean_v[c]) * scale_v[c];
+          }
+        }
+        for (int64_t x = pad_left + out_width; x < final_width; ++x) {
+          for (int64_t c = 0; c < channels; ++c) {
+            out_row[x * channels + c] = pad_v[c];
+          }
+        }
+      }
+    };
+
+    // Interpolation plus normalization is on the order of ten flops per
+    // output element.
+    const int64_t cost_per_row = 10 * out_row_elems;
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    Shard(worker_threads->num_threads, worker_threads->workers,
+          batch_size * final_height, cost_per_row, process_rows);
+  }
+
+ private:
+  bool align_corners_;
+  bool half_pixel_centers_;
+  float pad_value_;
+};
+
+}  // namespace
+
+#define REGISTER_KERNEL(T)                            \
+  REGISTER_KERNEL_BUILDER(Name("ImagePreprocess")     \
+                              .Device(DEVICE_CPU)     \
+                              .TypeConstraint<T>("T") \
+                              .HostMemory("size"),    \
+                          ImagePreprocessOp<T>);
+
+TF_CALL_REAL_NUMBER_TYPES(REGISTER_KERNEL);
+
+#undef REGISTER_KERNEL
+
+}  // namespace tensorflow
@@ -16,6 +16,8 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
+#include <array>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -25,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/framework/variant.h"
 #include "tensorflow/core/kernels/initializable_lookup_table.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
+#include "absl/base/prefetch.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/random.h"
 
@@ -520,9 +523,27 @@ class MutableDenseHashTable final : public LookupInterface {
     const auto deleted_key_matrix =
         deleted_key_.template shaped<K, 2>({1, key_size});
     const int64_t bit_mask = num_buckets_ - 1;
+    // Probing is memory-latency bound: each key's home bucket is a random
+    // cache line that is almost never resident for large tables. Hash a
+    // window of keys ahead of the probe loop and prefetch their home buckets
+    // so several lookups have misses in flight at once instead of stalling
+    // on one bucket at a time.
+    constexpr int64_t kPrefetchWindow = 16;
+    std::array<uint64, kPrefetchWindow> window_hashes;
     // TODO(andreasst): parallelize using work_sharder
     for (int64_t i = 0; i < num_elements; ++i) {
-      const uint64 key_hash = HashKey(key_matrix, i);
+      if (i % kPrefetchWindow == 0) {
+        const int64_t window_end =
+            std::min(num_elements, i + kPrefetchWindow);
+        for (int64_t w = i; w < window_end; ++w) {
+          const uint64 hash = HashKey(key_matrix, w);
+          window_hashes[w - i] = hash;
+          absl::PrefetchToLocalCache(
+              key_buckets_matrix.data() +
+              (static_cast<int64_t>(hash) & bit_mask) * key_size);
+        }
+      }
+      const uint64 key_hash = window_hashes[i % kPrefetchWindow];
       if (empty_key_hash_ == key_hash &&
           IsEqualKey(empty_key_matrix, 0, key_matrix, i)) {
         return errors::InvalidArgument(
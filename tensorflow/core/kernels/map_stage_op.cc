@@ -26,14 +26,52 @@ limitations under the License.
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/monitoring/sampler.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace {
 
+// When enabled, a Staging Area with a memory limit may temporarily extend
+// its byte-credit budget (up to twice the configured limit) while consumers
+// are draining it promptly, instead of stalling producers at the hard
+// capacity cliff.
+bool AdaptiveCreditsEnabled() {
+  static bool enabled = [] {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_STAGING_ADAPTIVE_CREDITS",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+// A blocked insert resolved within this window indicates consumers are
+// keeping pace and the Staging Area is merely too shallow.
+constexpr uint64 kHeadroomWaitUsecs = 1000;
+
+// A blocked insert exceeding this window indicates genuine consumer
+// backpressure, which deeper buffers cannot hide.
+constexpr uint64 kBackpressureWaitUsecs = 50 * 1000;
+
+// Records the time a producer spent blocked waiting for byte-credits,
+// by priority lane.
+void RecordCreditWaitTime(bool high_priority, uint64 wait_usecs) {
+  static auto* cell = monitoring::Sampler<1>::New(
+      {"/tensorflow/core/staging_area/credit_wait_usecs",
+       "Time (in microseconds) producers spent blocked waiting for Staging "
+       "Area byte-credits, by priority lane.",
+       "lane"},
+      // 27 buckets with bounds [1, 2, 4, ..., 64 * 1024 * 1024, DBL_MAX].
+      monitoring::Buckets::Exponential(1, 2, 27));
+  cell->GetCell(high_priority ? "high" : "normal")
+      ->Add(static_cast<double>(wait_usecs));
+}
+
 // Partial Ordering Comparator for Tensor keys containing scalar int64's
 struct KeyTensorLess {
   bool operator()(const Tensor& lhs, const Tensor& rhs) const {
@@ -97,7 +135,14 @@ class StagingMap : public ResourceBase {
   DataTypeVector dtypes_ TF_GUARDED_BY(mu_);
   std::size_t capacity_ TF_GUARDED_BY(mu_);
   std::size_t memory_limit_ TF_GUARDED_BY(mu_);
+  // Byte-credit budget producers draw from.  Starts at memory_limit_ and,
+  // with adaptive credits enabled, may deepen up to 2 * memory_limit_ while
+  // consumers keep pace.
+  std::size_t credit_limit_ TF_GUARDED_BY(mu_);
   std::size_t current_bytes_ TF_GUARDED_BY(mu_);
+  // Number of producers currently blocked in the high-priority lane.
+  // Normal-priority producers yield credits to these.
+  std::size_t high_priority_waiters_ TF_GUARDED_BY(mu_);
   tensorflow::mutex mu_;
   tensorflow::condition_variable not_empty_;
   tensorflow::condition_variable full_;
@@ -137,13 +182,72 @@ class StagingMap : public ResourceBase {
 
   bool would_exceed_memory_limit(std::size_t bytes) const
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    return has_memory_limit() && bytes + current_bytes_ > memory_limit_;
+    return has_memory_limit() && bytes + current_bytes_ > credit_limit_;
   }
 
   bool is_capacity_full() const TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     return has_capacity() && map_.size() >= capacity_;
   }
 
+  // Blocks until "bytes" byte-credits are available (and, for complete
+  // inserts, an element slot), then charges them to the caller.  Producers
+  // with priority > 0 are admitted ahead of normal-priority producers.
+  //
+  // Time spent blocked is exported per priority lane.  With adaptive credits
+  // enabled the blocked time also steers the credit budget: a stall a
+  // consumer resolved almost immediately means the area is merely too
+  // shallow, so the budget deepens (up to 2 * memory_limit_); a long stall
+  // means consumers are the bottleneck and deepening would only buy memory,
+  // so the budget decays back towards memory_limit_.
+  void acquire_credits(std::size_t bytes, int priority, bool needs_slot,
+                       tensorflow::mutex_lock* lock)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const bool high_priority = priority > 0;
+    uint64 wait_start = 0;
+
+    if (high_priority) {
+      ++high_priority_waiters_;
+    }
+
+    while (would_exceed_memory_limit(bytes) ||
+           (needs_slot && is_capacity_full()) ||
+           (!high_priority && high_priority_waiters_ > 0)) {
+      if (wait_start == 0) {
+        wait_start = Env::Default()->NowMicros();
+      }
+      full_.wait(*lock);
+    }
+
+    if (high_priority) {
+      --high_priority_waiters_;
+    }
+
+    if (wait_start != 0) {
+      const uint64 wait_usecs = Env::Default()->NowMicros() - wait_start;
+      RecordCreditWaitTime(high_priority, wait_usecs);
+
+      if (AdaptiveCreditsEnabled() && has_memory_limit()) {
+        const std::size_t step = std::max<std::size_t>(memory_limit_ / 8, 1);
+        if (wait_usecs < kHeadroomWaitUsecs) {
+          credit_limit_ = std::min(credit_limit_ + step, 2 * memory_limit_);
+        } else if (wait_usecs > kBackpressureWaitUsecs) {
+          credit_limit_ = std::max(credit_limit_ - std::min(step, credit_limit_),
+                                   memory_limit_);
+        }
+      }
+    }
+
+    // Charge the credits to the caller
+    current_bytes_ += bytes;
+  }
+
+  // Returns byte-credits charged by acquire_credits()
+  // and wakes blocked producers
+  void release_credits(std::size_t bytes) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    current_bytes_ -= bytes;
+    notify_inserters_if_bounded();
+  }
+
   // Get number of bytes in the tuple
   std::size_t get_tuple_bytes(const Tuple& tuple) {
     return std::accumulate(tuple.begin(), tuple.end(),
@@ -255,7 +359,8 @@ class StagingMap : public ResourceBase {
 
   // Insert incomplete data into the Barrier
   Status put_incomplete(const KeyType& key, const Tensor& indices,
-                        OptionalTuple* tuple, tensorflow::mutex_lock* lock)
+                        OptionalTuple* tuple, int priority,
+                        tensorflow::mutex_lock* lock)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
     auto findices = indices.flat<int>();
 
@@ -266,10 +371,9 @@ class StagingMap : public ResourceBase {
     std::size_t tuple_bytes = get_tuple_bytes(*tuple);
     TF_RETURN_IF_ERROR(check_memory_limit(tuple_bytes));
 
-    // Wait until we don't exceed the memory limit
-    while (would_exceed_memory_limit(tuple_bytes)) {
-      full_.wait(*lock);
-    }
+    // Acquire byte-credits for the partial tuple.  Incomplete entries do
+    // not occupy an element slot, so only the byte budget gates them.
+    acquire_credits(tuple_bytes, priority, false /* needs_slot */, lock);
 
     // This key isn't present in the incomplete set
     // Create OptionalTuple and insert
@@ -287,9 +391,6 @@ class StagingMap : public ResourceBase {
 
       // Insert into incomplete map
       incomplete_.insert({key, std::move(empty)});
-
-      // Increment size
-      current_bytes_ += tuple_bytes;
     }
     // Found an entry in the incomplete index
     // Update with given data and insert complete entries
@@ -308,9 +409,6 @@ class StagingMap : public ResourceBase {
         present[index] = std::move((*tuple)[i]);
       }
 
-      // Increment size
-      current_bytes_ += tuple_bytes;
-
       // Do we have values at all tuple elements?
       bool complete =
           std::all_of(present.begin(), present.end(),
@@ -348,9 +446,12 @@ class StagingMap : public ResourceBase {
       : dtypes_(dtypes),
         capacity_(capacity),
         memory_limit_(memory_limit),
-        current_bytes_(0) {}
+        credit_limit_(memory_limit),
+        current_bytes_(0),
+        high_priority_waiters_(0) {}
 
-  Status put(KeyType* key, const Tensor* indices, OptionalTuple* tuple) {
+  Status put(KeyType* key, const Tensor* indices, OptionalTuple* tuple,
+             int priority) {
     tensorflow::mutex_lock lock(mu_);
 
     // Sanity check the indices
@@ -358,24 +459,19 @@ class StagingMap : public ResourceBase {
 
     // Handle incomplete inserts
     if (indices->NumElements() != dtypes_.size()) {
-      return put_incomplete(*key, *indices, tuple, &lock);
+      return put_incomplete(*key, *indices, tuple, priority, &lock);
     }
 
     std::size_t tuple_bytes = get_tuple_bytes(*tuple);
     // Check that tuple_bytes fits within the memory limit
     TF_RETURN_IF_ERROR(check_memory_limit(tuple_bytes));
 
-    // Wait until there's space for insertion.
-    while (would_exceed_memory_limit(tuple_bytes) || is_capacity_full()) {
-      full_.wait(lock);
-    }
+    // Acquire byte-credits and an element slot for the insertion
+    acquire_credits(tuple_bytes, priority, true /* needs_slot */, &lock);
 
     // Do the put operation
     TF_RETURN_IF_ERROR(put_complete(*key, tuple));
 
-    // Update the current size
-    current_bytes_ += tuple_bytes;
-
     return OkStatus();
   }
 
@@ -424,10 +520,8 @@ class StagingMap : public ResourceBase {
       map_.erase(it);
     }
 
-    // Update bytes in the Staging Area
-    current_bytes_ -= get_tuple_bytes(*tuple);
-
-    notify_inserters_if_bounded();
+    // Return the consumed byte-credits to producers
+    release_credits(get_tuple_bytes(*tuple));
 
     return OkStatus();
   }
@@ -459,10 +553,8 @@ class StagingMap : public ResourceBase {
       map_.erase(it);
     }
 
-    // Update bytes in the Staging Area
-    current_bytes_ -= get_tuple_bytes(*tuple);
-
-    notify_inserters_if_bounded();
+    // Return the consumed byte-credits to producers
+    release_credits(get_tuple_bytes(*tuple));
 
     return OkStatus();
   }
@@ -472,6 +564,7 @@ class StagingMap : public ResourceBase {
     map_.clear();
     incomplete_.clear();
     current_bytes_ = 0;
+    credit_limit_ = memory_limit_;
 
     notify_inserters_if_bounded();
 
@@ -518,7 +611,12 @@ Status GetStagingMap(OpKernelContext* ctx, const NodeDef& ndef,
 template <bool Ordered>
 class MapStageOp : public OpKernel {
  public:
-  explicit MapStageOp(OpKernelConstruction* ctx) : OpKernel(ctx) {}
+  explicit MapStageOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    // Graphs serialized before the priority attr existed won't carry it
+    if (!TryGetNodeAttr(ctx->def(), "priority", &priority_)) {
+      priority_ = 0;
+    }
+  }
 
   void Compute(OpKernelContext* ctx) override {
     StagingMap<Ordered>* map = nullptr;
@@ -550,8 +648,13 @@ class MapStageOp : public OpKernel {
     }
 
     // Store the tuple in the map
-    OP_REQUIRES_OK(ctx, map->put(&key, indices_tensor, &tuple));
+    OP_REQUIRES_OK(ctx,
+                   map->put(&key, indices_tensor, &tuple,
+                            static_cast<int>(priority_)));
   }
+
+ private:
+  int64_t priority_;
 };
 
 REGISTER_KERNEL_BUILDER(Name("MapStage").Device(DEVICE_CPU), MapStageOp<false>);
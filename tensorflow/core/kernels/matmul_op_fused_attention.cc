@@ -0,0 +1,159 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Implements the _FusedAttention op created by the Grappler remapper from
+// the inference attention block
+//
+//   BatchMatMul(Softmax(scale * BatchMatMul(query, key, adj_y=true)), value)
+//
+// The attention scores are computed one (query_seq x key_seq) slice at a
+// time, so only a single score matrix per worker thread is materialized
+// instead of the full batched score tensor.
+//
+// Currently supported only on CPU device.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/op_requires.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+template <typename T>
+class FusedAttentionOp : public OpKernel {
+ public:
+  explicit FusedAttentionOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(
+        ctx, ctx->GetAttr("use_reciprocal_scale", &use_reciprocal_scale_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& query = ctx->input(0);
+    const Tensor& key = ctx->input(1);
+    const Tensor& value = ctx->input(2);
+    const Tensor& scale = ctx->input(3);
+
+    const int rank = query.dims();
+    OP_REQUIRES(ctx, rank >= 2,
+                errors::InvalidArgument("query must be at least rank 2, got ",
+                                        query.shape().DebugString()));
+    OP_REQUIRES(ctx, key.dims() == rank && value.dims() == rank,
+                errors::InvalidArgument(
+                    "query, key and value must have the same rank, got ",
+                    query.shape().DebugString(), ", ",
+                    key.shape().DebugString(), " and ",
+                    value.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(scale.shape()),
+                errors::InvalidArgument("scale must be a scalar, got ",
+                                        scale.shape().DebugString()));
+
+    // The fused kernel does not broadcast batch dimensions; the remapper
+    // only creates this op when the leading dimensions are identical.
+    int64_t batch = 1;
+    for (int i = 0; i < rank - 2; ++i) {
+      OP_REQUIRES(ctx,
+                  key.dim_size(i) == query.dim_size(i) &&
+                      value.dim_size(i) == query.dim_size(i),
+                  errors::InvalidArgument(
+                      "query, key and value must have identical batch "
+                      "dimensions, got ",
+                      query.shape().DebugString(), ", ",
+                      key.shape().DebugString(), " and ",
+                      value.shape().DebugString()));
+      batch *= query.dim_size(i);
+    }
+
+    const int64_t q_rows = query.dim_size(rank - 2);
+    const int64_t depth = query.dim_size(rank - 1);
+    const int64_t k_rows = key.dim_size(rank - 2);
+    const int64_t v_cols = value.dim_size(rank - 1);
+    OP_REQUIRES(ctx, key.dim_size(rank - 1) == depth,
+                errors::InvalidArgument(
+                    "query and key must have the same inner dimension, got ",
+                    depth, " and ", key.dim_size(rank - 1)));
+    OP_REQUIRES(ctx, value.dim_size(rank - 2) == k_rows,
+                errors::InvalidArgument(
+                    "value must have one row per key, got ",
+                    value.dim_size(rank - 2), " rows and ", k_rows, " keys"));
+    OP_REQUIRES(ctx, k_rows > 0,
+                errors::InvalidArgument(
+                    "softmax over an empty set of keys is undefined"));
+
+    TensorShape output_shape = query.shape();
+    output_shape.set_dim(rank - 1, v_cols);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+
+    T scale_value = scale.scalar<T>()();
+    if (use_reciprocal_scale_) {
+      OP_REQUIRES(ctx, scale_value != T(0),
+                  errors::InvalidArgument("scale must be non-zero"));
+      scale_value = T(1) / scale_value;
+    }
+
+    const T* q_base = query.flat<T>().data();
+    const T* k_base = key.flat<T>().data();
+    const T* v_base = value.flat<T>().data();
+    T* out_base = output->flat<T>().data();
+
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    const int64_t cost_per_batch =
+        q_rows * k_rows * (depth + v_cols + /*softmax=*/4);
+    Shard(worker_threads.num_threads, worker_threads.workers, batch,
+          cost_per_batch, [&](int64_t begin, int64_t end) {
+            using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic,
+                                         Eigen::RowMajor>;
+            using ConstMatrixMap = Eigen::Map<const Matrix>;
+            using MatrixMap = Eigen::Map<Matrix>;
+            Matrix scores(q_rows, k_rows);
+            for (int64_t b = begin; b < end; ++b) {
+              ConstMatrixMap q(q_base + b * q_rows * depth, q_rows, depth);
+              ConstMatrixMap k(k_base + b * k_rows * depth, k_rows, depth);
+              ConstMatrixMap v(v_base + b * k_rows * v_cols, k_rows, v_cols);
+              MatrixMap out(out_base + b * q_rows * v_cols, q_rows, v_cols);
+
+              scores.noalias() = q * k.transpose();
+              scores *= scale_value;
+              // Numerically stable row-wise softmax.
+              for (int64_t r = 0; r < q_rows; ++r) {
+                auto row = scores.row(r).array();
+                row = (row - row.maxCoeff()).exp();
+                row /= row.sum();
+              }
+              out.noalias() = scores * v;
+            }
+          });
+  }
+
+ private:
+  bool use_reciprocal_scale_ = false;
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("_FusedAttention").Device(DEVICE_CPU).TypeConstraint<float>("T"),
+    FusedAttentionOp<float>);
+
+}  // namespace
+}  // namespace tensorflow
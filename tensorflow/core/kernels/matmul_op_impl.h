@@ -430,6 +430,36 @@ struct LaunchBatchMatMul<CPUDevice, Scalar> {
     // Jan 21, 2020.
     const int64_t kMaxCostOuterParallelism = 128 * 128;  // heuristic.
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+
+    // A batch of small products against a single shared right-hand side --
+    // the common ragged-inference shape, e.g. per-request [4, 256]
+    // activations times one [256, 256] weight matrix -- is just one taller
+    // GEMM on the flattened left-hand side. Folding the batch packs the
+    // shared operand once and hands the cache-blocked kernel a
+    // [batch * m, k] matrix it can block well, instead of batch_size tiny
+    // products that cannot amortize per-call setup. This needs an
+    // untransposed left operand so its rows stay contiguous across the
+    // batch.
+    if (batch_size > 1 && !adj_x && !trans_x && bcast.y_batch_size() == 1 &&
+        bcast.x_batch_size() == batch_size &&
+        cost_per_unit <= kMaxCostOuterParallelism) {
+      Tensor x_flat;
+      Tensor out_flat;
+      if (x_flat.CopyFrom(in_x, TensorShape({1, batch_size * in_x.dim_size(1),
+                                             in_x.dim_size(2)})) &&
+          out_flat.CopyFrom(*out,
+                            TensorShape({1, batch_size * out->dim_size(1),
+                                         out->dim_size(2)}))) {
+        // SingleBatchParallelMatMulKernel only spawns block tasks once the
+        // folded product is large enough to cover its work limit; small
+        // batches run inline on the calling thread with no fork/join.
+        SingleBatchParallelMatMulKernel<Scalar>::Run(
+            context->eigen_cpu_device(), x_flat, in_y, adj_x, adj_y, trans_x,
+            trans_y, &out_flat);
+        return;
+      }
+    }
+
     // TODO(rmlarsen): Reconsider the heuristics now that we have asynchronous
     // evaluation in Eigen Tensor.
     if (small_dim > 1 &&
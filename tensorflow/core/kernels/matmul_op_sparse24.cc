@@ -0,0 +1,129 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Implements the _Sparse24MatMul op created by the Grappler remapper for
+// MatMul nodes whose constant weights carry 2:4 structured sparsity (at most
+// 2 non-zeros in every group of 4 consecutive elements along the reduction
+// dimension).
+//
+// The weight is consumed in packed form: per output column, the kept values
+// of each group ([n, k/2], contiguous per column) plus one metadata byte per
+// group holding the two kept in-group offsets.  Each output element thus
+// costs k/2 multiply-adds and touches half the weight bytes of the dense
+// kernel; the column-major value/metadata layout keeps the inner loop
+// streaming so wider gather-based specializations can slot in later.
+//
+// Currently supported only on CPU device.
+
+#define EIGEN_USE_THREADS
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/op_requires.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+template <typename T>
+class Sparse24MatMulOp : public OpKernel {
+ public:
+  explicit Sparse24MatMulOp(OpKernelConstruction* ctx) : OpKernel(ctx) {}
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& a = ctx->input(0);
+    const Tensor& values = ctx->input(1);
+    const Tensor& metadata = ctx->input(2);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsMatrix(a.shape()),
+                errors::InvalidArgument("a must be rank 2, got ",
+                                        a.shape().DebugString()));
+    OP_REQUIRES(ctx,
+                TensorShapeUtils::IsMatrix(values.shape()) &&
+                    TensorShapeUtils::IsMatrix(metadata.shape()),
+                errors::InvalidArgument(
+                    "values and metadata must be rank 2, got ",
+                    values.shape().DebugString(), " and ",
+                    metadata.shape().DebugString()));
+
+    const int64_t m = a.dim_size(0);
+    const int64_t k = a.dim_size(1);
+    const int64_t n = values.dim_size(0);
+    const int64_t groups = k / 4;
+    OP_REQUIRES(ctx, k % 4 == 0,
+                errors::InvalidArgument(
+                    "the reduction dimension must be a multiple of 4, got ",
+                    k));
+    OP_REQUIRES(ctx, values.dim_size(1) == 2 * groups,
+                errors::InvalidArgument("values must be [", n, ", ",
+                                        2 * groups, "], got ",
+                                        values.shape().DebugString()));
+    OP_REQUIRES(ctx,
+                metadata.dim_size(0) == n && metadata.dim_size(1) == groups,
+                errors::InvalidArgument("metadata must be [", n, ", ", groups,
+                                        "], got ",
+                                        metadata.shape().DebugString()));
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(ctx,
+                   ctx->allocate_output(0, TensorShape({m, n}), &output));
+    if (output->NumElements() == 0) return;
+    if (k == 0) {
+      output->flat<T>().setZero();
+      return;
+    }
+
+    const T* a_base = a.flat<T>().data();
+    const T* values_base = values.flat<T>().data();
+    const uint8* meta_base = metadata.flat<uint8>().data();
+    T* out_base = output->flat<T>().data();
+
+    // Shard over rows of "a"; each worker streams the full packed weight
+    // against rows it owns, so the row of "a" stays cache-resident across
+    // all n output columns.
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    const int64_t cost_per_row = n * (k / 2) * 2;
+    Shard(worker_threads.num_threads, worker_threads.workers, m, cost_per_row,
+          [&](int64_t begin, int64_t end) {
+            for (int64_t row = begin; row < end; ++row) {
+              const T* a_row = a_base + row * k;
+              T* out_row = out_base + row * n;
+              for (int64_t col = 0; col < n; ++col) {
+                const T* v = values_base + col * 2 * groups;
+                const uint8* meta = meta_base + col * groups;
+                T acc0 = T(0);
+                T acc1 = T(0);
+                for (int64_t g = 0; g < groups; ++g) {
+                  const uint8 m_byte = meta[g];
+                  const T* a_group = a_row + 4 * g;
+                  acc0 += a_group[m_byte & 0x3] * v[2 * g];
+                  acc1 += a_group[(m_byte >> 2) & 0x3] * v[2 * g + 1];
+                }
+                out_row[col] = acc0 + acc1;
+              }
+            }
+          });
+  }
+};
+
+REGISTER_KERNEL_BUILDER(
+    Name("_Sparse24MatMul").Device(DEVICE_CPU).TypeConstraint<float>("T"),
+    Sparse24MatMulOp<float>);
+
+}  // namespace
+}  // namespace tensorflow
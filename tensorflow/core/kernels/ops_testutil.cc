@@ -67,6 +67,29 @@ void SetOutputAttrs(OpKernelContext::Params* params,
   params->output_attr_array = attrs->data();
 }
 
+namespace {
+
+int64_t CpuAllocatorNumAllocs() {
+  absl::optional<AllocatorStats> stats = cpu_allocator()->GetStats();
+  return stats.has_value() ? stats->num_allocs : 0;
+}
+
+}  // namespace
+
+CpuAllocationCounter::CpuAllocationCounter()
+    : stats_were_enabled_(CPUAllocatorStatsEnabled()) {
+  if (!stats_were_enabled_) EnableCPUAllocatorStats();
+  start_num_allocs_ = CpuAllocatorNumAllocs();
+}
+
+CpuAllocationCounter::~CpuAllocationCounter() {
+  if (!stats_were_enabled_) DisableCPUAllocatorStats();
+}
+
+int64_t CpuAllocationCounter::num_allocs() const {
+  return CpuAllocatorNumAllocs() - start_num_allocs_;
+}
+
 }  // namespace test
 
 OpsTestBase::OpsTestBase() : device_type_(DEVICE_CPU) {
@@ -195,6 +218,23 @@ Status OpsTestBase::RunOpKernel() {
   return context_->status();
 }
 
+Status OpsTestBase::RunOpKernelWithAllocationCount(int64_t* num_allocations) {
+  CHECK(device_type_ == DEVICE_CPU)
+      << "Allocation counting requires CPU allocator stats";
+  CreateContext();
+  const bool stats_were_enabled = CPUAllocatorStatsEnabled();
+  if (!stats_were_enabled) EnableCPUAllocatorStats();
+  auto num_allocs = [this]() -> int64_t {
+    absl::optional<AllocatorStats> stats = allocator_->GetStats();
+    return stats.has_value() ? stats->num_allocs : 0;
+  };
+  const int64_t start_num_allocs = num_allocs();
+  device_->Compute(kernel_.get(), context_.get());
+  *num_allocations = num_allocs() - start_num_allocs;
+  if (!stats_were_enabled) DisableCPUAllocatorStats();
+  return context_->status();
+}
+
 const Tensor& OpsTestBase::GetInput(int input_index) const {
   CHECK_LT(input_index, context_->num_inputs());
   CHECK(!IsRefType(context_->input_dtype(input_index)));
@@ -62,6 +62,33 @@ namespace test {
 void SetOutputAttrs(OpKernelContext::Params* params,
                     std::vector<AllocatorAttributes>* attrs);
 
+// Counts allocations made through the process CPU allocator while in scope.
+// Enables CPU allocator stats on construction (and restores the previous
+// setting on destruction), so it can be used in benchmarks to enforce an
+// allocation budget on a hot-path kernel:
+//
+//   test::CpuAllocationCounter counter;
+//   for (auto s : state) { ... }
+//   CHECK_LE(counter.num_allocs(), state.iterations() * kMaxAllocsPerIter);
+//
+// Counts cover every allocation made by the process's CPU allocator while
+// the counter is live, so keep the scope tight around the code under test.
+class CpuAllocationCounter {
+ public:
+  CpuAllocationCounter();
+  ~CpuAllocationCounter();
+
+  // Returns the number of CPU allocations since construction.
+  int64_t num_allocs() const;
+
+ private:
+  bool stats_were_enabled_;
+  int64_t start_num_allocs_;
+
+  CpuAllocationCounter(const CpuAllocationCounter&) = delete;
+  void operator=(const CpuAllocationCounter&) = delete;
+};
+
 }  // namespace test
 
 // Helpful functions to test operators.
@@ -135,6 +162,13 @@ class OpsTestBase : public ::testing::Test {
   // Returns the context's status after running the operation.
   Status RunOpKernel();
 
+  // Like RunOpKernel(), but additionally reports in '*num_allocations' how
+  // many allocations the kernel made through this test's device allocator.
+  // Use this to pin down a kernel's allocation budget, so an extra copy or
+  // temp sneaking into a hot path fails its unit test instead of regressing
+  // production silently. Requires allocator stats, so only supported on CPU.
+  Status RunOpKernelWithAllocationCount(int64_t* num_allocations);
+
   // Returns the tensor input for 'input_index'.
   //
   // REQUIRES: 0 <= input_index < context_->num_inputs()
@@ -84,8 +84,12 @@ class QuantizeAndDequantizeV2Op : public OpKernel {
     const int depth = (axis_ == -1) ? 1 : input.dim_size(axis_);
     Tensor input_min_tensor;
     Tensor input_max_tensor;
+    // The range is materialized into separate tensors before the
+    // coefficient-wise transform, so the input buffer can be reused for the
+    // output.
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(ctx, ctx->forward_input_or_allocate_output(
+                            {0}, 0, input.shape(), &output));
     if (range_given_) {
       input_min_tensor = ctx->input(1);
       input_max_tensor = ctx->input(2);
@@ -274,8 +278,11 @@ class QuantizeAndDequantizeV3Op : public OpKernel {
                     "Axis requested is larger than input dimensions. Axis: ",
                     axis_, " Input Dimensions: ", input.dims()));
     const int depth = (axis_ == -1) ? 1 : input.dim_size(axis_);
+    // As in V2 above, the transform is coefficient-wise once the range is
+    // known, so the input buffer can be reused.
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(ctx, ctx->forward_input_or_allocate_output(
+                            {0}, 0, input.shape(), &output));
 
     // Get num_bits and validate.
     const Tensor num_bits_tensor = ctx->input(3);
@@ -377,7 +384,8 @@ class QuantizeAndDequantizeOp : public OpKernel {
     const Tensor& input = ctx->input(0);
 
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, input.shape(), &output));
+    OP_REQUIRES_OK(ctx, ctx->forward_input_or_allocate_output(
+                            {0}, 0, input.shape(), &output));
 
     // One global scale.
     Tensor input_min_tensor(DataTypeToEnum<T>::value, TensorShape());
@@ -47,12 +47,22 @@ class QuantizedReluOp : public OpKernel {
     const float min_input = min_input_tensor.scalar<float>()();
     const float max_input = max_input_tensor.scalar<float>()();
 
+    // The clamp is coefficient-wise, so reuse the input buffer when possible.
+    // The meta path streams through raw pointers, so only forward when it is
+    // not in use.
+    const bool use_meta =
+        meta::IsSupportedAndEnabled() && std::is_same<T, quint8>();
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output(0, input.shape(), &output));
+    if (use_meta) {
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(0, input.shape(), &output));
+    } else {
+      OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                  {0}, 0, input.shape(), &output));
+    }
     const T min_as_quantized = FloatToQuantized<T>(0.0f, min_input, max_input);
 
-    if (meta::IsSupportedAndEnabled() && std::is_same<T, quint8>()) {
+    if (use_meta) {
       auto input_ui8_array = input.flat<quint8>();
       meta::Clamp(context, input_ui8_array.data(), input_ui8_array.size(),
                   min_as_quantized, 255, output->flat<quint8>().data());
@@ -93,13 +103,22 @@ class QuantizedRelu6Op : public OpKernel {
     const float min_input = min_input_tensor.scalar<float>()();
     const float max_input = max_input_tensor.scalar<float>()();
 
+    // As in QuantizedReluOp above: coefficient-wise, so forward the input
+    // unless the meta path is in use.
+    const bool use_meta =
+        meta::IsSupportedAndEnabled() && std::is_same<T, quint8>();
     Tensor* output = nullptr;
-    OP_REQUIRES_OK(context,
-                   context->allocate_output(0, input.shape(), &output));
+    if (use_meta) {
+      OP_REQUIRES_OK(context,
+                     context->allocate_output(0, input.shape(), &output));
+    } else {
+      OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                  {0}, 0, input.shape(), &output));
+    }
     const T min_as_quantized = FloatToQuantized<T>(0.0f, min_input, max_input);
     const T max_as_quantized = FloatToQuantized<T>(6.0f, min_input, max_input);
 
-    if (meta::IsSupportedAndEnabled() && std::is_same<T, quint8>()) {
+    if (use_meta) {
       auto input_ui8_array = input.flat<quint8>();
       meta::Clamp(context, input_ui8_array.data(), input_ui8_array.size(),
                   min_as_quantized, max_as_quantized,
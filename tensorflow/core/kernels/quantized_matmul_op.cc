@@ -18,6 +18,10 @@ limitations under the License.
 #define EIGEN_USE_THREADS
 
 #define GEMMLOWP_ALLOW_SLOW_SCALAR_FALLBACK
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 #include "public/gemmlowp.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/op_requires.h"
@@ -27,7 +31,17 @@ limitations under the License.
 #include "tensorflow/core/kernels/quantization_utils.h"
 #include "tensorflow/core/kernels/reference_gemm.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+// The AVX512-VNNI path below is compiled with a per-function target
+// attribute and selected at runtime from cpuid, so it is available in stock
+// builds that target a generic x86-64 baseline.
+#if defined(__x86_64__) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9))
+#include <immintrin.h>
+#define TF_QUANTIZED_MATMUL_USE_VNNI 1
+#endif
 
 namespace tensorflow {
 
@@ -66,6 +80,133 @@ void GemmlowpMultiply(OpKernelContext* op_context, const quint8* a_data,
   TF_ANNOTATE_MEMORY_IS_INITIALIZED(c_data_as_int32, m * n * sizeof(int32));
 }
 
+#ifdef TF_QUANTIZED_MATMUL_USE_VNNI
+namespace {
+
+// Computes one output row of the VNNI gemm. vpdpbusd accumulates four
+// uint8*int8 products per int32 lane, so `packed_b` holds b regrouped as
+// [k / 4][n][4] with its sign bit flipped (vpdpbusd wants one signed
+// operand); `row_term` carries the +128 * row_sum correction that undoes the
+// bias, together with the quantization offset terms. `tail` holds the
+// scalar-computed contribution of the trailing k % 4 depth values, or is
+// null when k is a multiple of four.
+__attribute__((target("avx512f,avx512vnni"))) void VnniGemmRow(
+    const uint8* a_row, const uint8* packed_b, const int32* col_sums,
+    const int32* tail, int n, int num_groups, int32 row_term, int32 offset_a,
+    int32* c_row) {
+  for (int col = 0; col < n; col += 16) {
+    const __mmask16 mask = (n - col >= 16)
+                               ? static_cast<__mmask16>(0xffff)
+                               : static_cast<__mmask16>((1u << (n - col)) - 1);
+    __m512i acc = _mm512_setzero_si512();
+    const uint8* bp = packed_b + static_cast<size_t>(col) * 4;
+    for (int g = 0; g < num_groups; ++g, bp += static_cast<size_t>(n) * 4) {
+      uint32 a4;
+      memcpy(&a4, a_row + 4 * g, sizeof(a4));
+      acc = _mm512_dpbusd_epi32(acc, _mm512_set1_epi32(static_cast<int>(a4)),
+                                _mm512_maskz_loadu_epi32(mask, bp));
+    }
+    __m512i res = _mm512_add_epi32(acc, _mm512_set1_epi32(row_term));
+    const __m512i col_sum_v = _mm512_maskz_loadu_epi32(mask, col_sums + col);
+    res = _mm512_sub_epi32(
+        res, _mm512_mullo_epi32(col_sum_v, _mm512_set1_epi32(offset_a)));
+    if (tail != nullptr) {
+      res = _mm512_add_epi32(res, _mm512_maskz_loadu_epi32(mask, tail + col));
+    }
+    _mm512_mask_storeu_epi32(c_row + col, mask, res);
+  }
+}
+
+// Multiplies row-major, untransposed uint8 matrices into int32 using the
+// AVX512-VNNI dot-product instruction, computing
+//   c = (a - offset_a) * (b - offset_b)
+// exactly like GemmlowpMultiply below. The offset cross terms are expanded
+// algebraically (a*b - offset_a*col_sum(b) - offset_b*row_sum(a)
+// + k*offset_a*offset_b) so the inner loop is a pure uint8 dot product.
+void VnniGemm(OpKernelContext* op_context, const quint8* a_data,
+              const quint8* b_data, qint32* c_data, int m, int n, int k,
+              int offset_a, int offset_b, int lda, int ldb, int ldc) {
+  const uint8* a = &a_data->value;
+  const uint8* b = &b_data->value;
+  int32* c = &c_data->value;
+
+  const int k4 = k & ~3;
+  const int num_groups = k4 / 4;
+
+  std::vector<int32> col_sums(n);
+  for (int col = 0; col < n; ++col) {
+    int32 sum = 0;
+    for (int kk = 0; kk < k; ++kk) {
+      sum += b[static_cast<size_t>(kk) * ldb + col];
+    }
+    col_sums[col] = sum;
+  }
+  // Repack b as [k / 4][n][4] so each vpdpbusd reads the four depth values
+  // of 16 consecutive columns in a single 64-byte load, and flip the sign
+  // bit to present vpdpbusd with a signed operand.
+  std::vector<uint8> packed(static_cast<size_t>(num_groups) * n * 4);
+  for (int g = 0; g < num_groups; ++g) {
+    uint8* out = packed.data() + static_cast<size_t>(g) * n * 4;
+    for (int col = 0; col < n; ++col) {
+      for (int j = 0; j < 4; ++j) {
+        out[col * 4 + j] = b[static_cast<size_t>(4 * g + j) * ldb + col] ^ 0x80;
+      }
+    }
+  }
+
+  auto& worker_threads =
+      *(op_context->device()->tensorflow_cpu_worker_threads());
+  auto compute_rows = [&](int64_t row_start, int64_t row_limit) {
+    std::vector<int32> tail(k4 < k ? n : 0);
+    for (int64_t i = row_start; i < row_limit; ++i) {
+      const uint8* a_row = a + i * lda;
+      int32 row_sum4 = 0;
+      for (int kk = 0; kk < k4; ++kk) {
+        row_sum4 += a_row[kk];
+      }
+      int32 row_sum = row_sum4;
+      for (int kk = k4; kk < k; ++kk) {
+        row_sum += a_row[kk];
+      }
+      if (k4 < k) {
+        std::fill(tail.begin(), tail.end(), 0);
+        for (int kk = k4; kk < k; ++kk) {
+          const int32 av = a_row[kk];
+          const uint8* b_row = b + static_cast<size_t>(kk) * ldb;
+          for (int col = 0; col < n; ++col) {
+            tail[col] += av * b_row[col];
+          }
+        }
+      }
+      // Computed in 64 bits and truncated so that the wrap-around on
+      // overflow matches a plain int32 accumulation of the exact sum.
+      const int32 row_term = static_cast<int32>(
+          128 * static_cast<int64_t>(row_sum4) -
+          static_cast<int64_t>(offset_b) * row_sum +
+          static_cast<int64_t>(k) * offset_a * offset_b);
+      VnniGemmRow(a_row, packed.data(), col_sums.data(),
+                  k4 < k ? tail.data() : nullptr, n, num_groups, row_term,
+                  offset_a, c + i * ldc);
+    }
+  };
+  const int64_t cost_per_row = static_cast<int64_t>(n) * k;
+  Shard(worker_threads.num_threads, worker_threads.workers, m, cost_per_row,
+        compute_rows);
+}
+
+// The decision is made once at startup: cpuid says whether vpdpbusd exists,
+// and TF_DISABLE_QUANTIZED_VNNI_GEMM provides an escape hatch back to
+// gemmlowp.
+bool UseVnniGemm() {
+  static const bool use_vnni =
+      port::TestCPUFeature(port::AVX512_VNNI) &&
+      std::getenv("TF_DISABLE_QUANTIZED_VNNI_GEMM") == nullptr;
+  return use_vnni;
+}
+
+}  // namespace
+#endif  // TF_QUANTIZED_MATMUL_USE_VNNI
+
 template <class T1, class T2, class Toutput>
 class QuantizedMatMulOp : public OpKernel {
  public:
@@ -161,6 +302,13 @@ class QuantizedMatMulOp : public OpKernel {
       // The gemmlowp optimized library only works for a particular set of data
       // types, so check if we meet those requirements and fall back to a slower
       // reference implementation if not.
+#ifdef TF_QUANTIZED_MATMUL_USE_VNNI
+      if (!transpose_a_ && !transpose_b_ && UseVnniGemm()) {
+        VnniGemm(context, a_data, b_data, c_data, m, n, k, offset_a, offset_b,
+                 lda, ldb, ldc);
+        // Fall through to the range computation below.
+      } else
+#endif  // TF_QUANTIZED_MATMUL_USE_VNNI
       if (transpose_a_) {
         if (transpose_b_) {
           GemmlowpMultiply<true, true, false>(context, a_data, b_data, c_data,
@@ -82,6 +82,63 @@ TEST_F(QuantizedMatMulTest, Small_NoParams) {
   test::ExpectTensorEqual<qint32>(expected, *GetOutput(0));
 }
 
+// Multiplies matrices whose dimensions are deliberately not multiples of the
+// vectorized kernels' block sizes (depth % 4 != 0, columns % 16 != 0), with
+// nonzero quantization offsets, and checks against a reference computed here
+// with plain integer loops.
+TEST_F(QuantizedMatMulTest, Medium_UnalignedDims) {
+  TF_ASSERT_OK(NodeDefBuilder("quantized_mat_mul_op", "QuantizedMatMul")
+                   .Input(FakeInput(DT_QUINT8))
+                   .Input(FakeInput(DT_QUINT8))
+                   .Input(FakeInput(DT_FLOAT))
+                   .Input(FakeInput(DT_FLOAT))
+                   .Input(FakeInput(DT_FLOAT))
+                   .Input(FakeInput(DT_FLOAT))
+                   .Attr("Toutput", DataTypeToEnum<qint32>::v())
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  const int m = 5;
+  const int k = 23;
+  const int n = 37;
+  // These ranges have a step size of 1.0, so the quantized values of zero
+  // (and hence the input offsets) are 12 and 36.
+  const float a_min = -12.0f;
+  const float a_max = 243.0f;
+  const float b_min = -36.0f;
+  const float b_max = 219.0f;
+  const int32_t offset_a = 12;
+  const int32_t offset_b = 36;
+  std::vector<quint8> a_data(m * k);
+  for (int i = 0; i < m * k; ++i) {
+    a_data[i] = static_cast<quint8>((i * 7 + 3) % 255);
+  }
+  std::vector<quint8> b_data(k * n);
+  for (int i = 0; i < k * n; ++i) {
+    b_data[i] = static_cast<quint8>((i * 13 + 5) % 255);
+  }
+  AddInputFromArray<quint8>(TensorShape({m, k}), a_data);
+  AddInputFromArray<quint8>(TensorShape({k, n}), b_data);
+  AddInputFromArray<float>(TensorShape({}), {a_min});
+  AddInputFromArray<float>(TensorShape({}), {a_max});
+  AddInputFromArray<float>(TensorShape({}), {b_min});
+  AddInputFromArray<float>(TensorShape({}), {b_max});
+
+  TF_ASSERT_OK(RunOpKernel());
+  Tensor expected(allocator(), DT_QINT32, TensorShape({m, n}));
+  auto expected_mat = expected.matrix<qint32>();
+  for (int row = 0; row < m; ++row) {
+    for (int col = 0; col < n; ++col) {
+      int32_t sum = 0;
+      for (int kk = 0; kk < k; ++kk) {
+        sum += (static_cast<int32_t>(a_data[row * k + kk]) - offset_a) *
+               (static_cast<int32_t>(b_data[kk * n + col]) - offset_b);
+      }
+      expected_mat(row, col) = sum;
+    }
+  }
+  test::ExpectTensorEqual<qint32>(expected, *GetOutput(0));
+}
+
 // This test multiplies two 1x1 8bit matrices, and compares the
 // results with hand-calculated expectations.
 TEST_F(QuantizedMatMulTest, VerySmall_WithParams) {
@@ -84,13 +84,33 @@ struct FillPhiloxRandomTask<Distribution, false> {
   static void Run(random::PhiloxRandom gen, T* data, int64_t size,
                   int64_t start_group, int64_t limit_group, Distribution dist) {
     const int kGroupSize = Distribution::kResultElementCount;
+    // Number of groups generated per iteration of the unrolled loop below.
+    // Each group gets its own generator positioned at its counter, so the ten
+    // Philox rounds form independent dependency chains; superscalar cores
+    // overlap them and with AVX2/AVX-512 the compiler vectorizes the 32-bit
+    // multiplies across the blocks. The output is identical to the scalar
+    // loop since group i always consumes counter start_group + i.
+    constexpr int kUnrolledGroups = 8;
 
     gen.Skip(start_group);
     int64_t offset = start_group * kGroupSize;
 
     // First fill all the full-size groups
     int64_t limit_group_full = std::min(limit_group, size / kGroupSize);
-    for (int64_t index = start_group; index < limit_group_full; ++index) {
+    int64_t index = start_group;
+    for (; index + kUnrolledGroups <= limit_group_full;
+         index += kUnrolledGroups) {
+      for (int i = 0; i < kUnrolledGroups; ++i) {
+        PhiloxRandom block_gen = gen;
+        block_gen.Skip(i);
+        auto samples = dist(&block_gen);
+        std::copy(&samples[0], &samples[0] + kGroupSize,
+                  data + offset + i * kGroupSize);
+      }
+      gen.Skip(kUnrolledGroups);
+      offset += kUnrolledGroups * kGroupSize;
+    }
+    for (; index < limit_group_full; ++index) {
       auto samples = dist(&gen);
       std::copy(&samples[0], &samples[0] + kGroupSize, data + offset);
       offset += kGroupSize;
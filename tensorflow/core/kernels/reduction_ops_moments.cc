@@ -0,0 +1,198 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Implements the _FusedMoments op created by the Grappler remapper from the
+// tf.nn.moments subgraph
+//
+//   mean = Mean(x, axes)
+//   variance = Mean(SquaredDifference(x, StopGradient(mean)), axes)
+//
+// Both statistics are computed with Welford's online algorithm in a single
+// traversal of the input, instead of reading the activations once per
+// reduction.
+//
+// Currently supported only on CPU device.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/op_requires.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+template <typename T, typename Tidx>
+class FusedMomentsOp : public OpKernel {
+ public:
+  explicit FusedMomentsOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("keep_dims", &keep_dims_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const Tensor& input = ctx->input(0);
+    const Tensor& axes_tensor = ctx->input(1);
+    OP_REQUIRES(ctx,
+                TensorShapeUtils::IsScalar(axes_tensor.shape()) ||
+                    TensorShapeUtils::IsVector(axes_tensor.shape()),
+                errors::InvalidArgument(
+                    "reduction_indices must be a scalar or vector, got shape ",
+                    axes_tensor.shape().DebugString()));
+
+    const int rank = input.dims();
+    std::vector<bool> reduced(rank, false);
+    int num_reduced_dims = 0;
+    const auto axes_flat = axes_tensor.flat<Tidx>();
+    for (int64_t i = 0; i < axes_flat.size(); ++i) {
+      int64_t axis = static_cast<int64_t>(axes_flat(i));
+      if (axis < 0) axis += rank;
+      OP_REQUIRES(ctx, axis >= 0 && axis < rank,
+                  errors::InvalidArgument("Invalid reduction dimension ",
+                                          static_cast<int64_t>(axes_flat(i)),
+                                          " for input with ", rank,
+                                          " dimensions"));
+      if (!reduced[axis]) {
+        reduced[axis] = true;
+        ++num_reduced_dims;
+      }
+    }
+
+    // The remapper only emits this op for reductions over a contiguous
+    // leading or trailing range of dimensions, which lets the input be viewed
+    // as a 2-D [reduce, keep] or [keep, reduce] matrix.
+    int first_reduced = rank;
+    int last_reduced = -1;
+    for (int d = 0; d < rank; ++d) {
+      if (reduced[d]) {
+        first_reduced = std::min(first_reduced, d);
+        last_reduced = std::max(last_reduced, d);
+      }
+    }
+    OP_REQUIRES(
+        ctx,
+        num_reduced_dims == 0 ||
+            (last_reduced - first_reduced + 1 == num_reduced_dims &&
+             (first_reduced == 0 || last_reduced == rank - 1)),
+        errors::Unimplemented("_FusedMoments requires reduction_indices to "
+                              "select a contiguous leading or trailing range "
+                              "of dimensions"));
+
+    TensorShape output_shape;
+    int64_t reduce_size = 1;
+    int64_t keep_size = 1;
+    for (int d = 0; d < rank; ++d) {
+      if (reduced[d]) {
+        reduce_size *= input.dim_size(d);
+        if (keep_dims_) output_shape.AddDim(1);
+      } else {
+        keep_size *= input.dim_size(d);
+        output_shape.AddDim(input.dim_size(d));
+      }
+    }
+
+    Tensor* mean_out = nullptr;
+    Tensor* variance_out = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, output_shape, &mean_out));
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(1, output_shape, &variance_out));
+    if (keep_size == 0) return;
+    if (reduce_size == 0) {
+      // Matches Mean over an empty reduction range.
+      mean_out->flat<T>().setConstant(std::numeric_limits<T>::quiet_NaN());
+      variance_out->flat<T>().setConstant(std::numeric_limits<T>::quiet_NaN());
+      return;
+    }
+
+    const T* in = input.flat<T>().data();
+    T* mean_data = mean_out->flat<T>().data();
+    T* variance_data = variance_out->flat<T>().data();
+
+    auto* worker_threads = ctx->device()->tensorflow_cpu_worker_threads();
+    // Welford's update is roughly a division, two multiplies and three adds
+    // per element.
+    const int64_t cost_per_unit = 8 * reduce_size;
+
+    if (num_reduced_dims > 0 && reduced[0]) {
+      // Leading reduction: the input is a [reduce_size, keep_size] matrix and
+      // each output is a column. Every row updates all running statistics of
+      // a column block, so the inner loop is over contiguous memory and
+      // vectorizes.
+      Shard(worker_threads->num_threads, worker_threads->workers, keep_size,
+            cost_per_unit, [&](int64_t col_begin, int64_t col_end) {
+              for (int64_t c = col_begin; c < col_end; ++c) {
+                mean_data[c] = T(0);
+                variance_data[c] = T(0);  // Running M2 until the final divide.
+              }
+              for (int64_t r = 0; r < reduce_size; ++r) {
+                const T* row = in + r * keep_size;
+                const T inv_n = T(1) / static_cast<T>(r + 1);
+                for (int64_t c = col_begin; c < col_end; ++c) {
+                  const T delta = row[c] - mean_data[c];
+                  mean_data[c] += delta * inv_n;
+                  variance_data[c] += delta * (row[c] - mean_data[c]);
+                }
+              }
+              const T inv_count = T(1) / static_cast<T>(reduce_size);
+              for (int64_t c = col_begin; c < col_end; ++c) {
+                variance_data[c] *= inv_count;
+              }
+            });
+    } else {
+      // Trailing (or empty) reduction: each output is a contiguous run of
+      // reduce_size elements.
+      Shard(worker_threads->num_threads, worker_threads->workers, keep_size,
+            cost_per_unit, [&](int64_t row_begin, int64_t row_end) {
+              for (int64_t r = row_begin; r < row_end; ++r) {
+                const T* run = in + r * reduce_size;
+                T mean = T(0);
+                T m2 = T(0);
+                for (int64_t i = 0; i < reduce_size; ++i) {
+                  const T delta = run[i] - mean;
+                  mean += delta / static_cast<T>(i + 1);
+                  m2 += delta * (run[i] - mean);
+                }
+                mean_data[r] = mean;
+                variance_data[r] = m2 / static_cast<T>(reduce_size);
+              }
+            });
+    }
+  }
+
+ private:
+  bool keep_dims_;
+};
+
+#define REGISTER_FUSED_MOMENTS(T, Tidx)                      \
+  REGISTER_KERNEL_BUILDER(Name("_FusedMoments")              \
+                              .Device(DEVICE_CPU)            \
+                              .TypeConstraint<T>("T")        \
+                              .TypeConstraint<Tidx>("Tidx"), \
+                          FusedMomentsOp<T, Tidx>)
+
+REGISTER_FUSED_MOMENTS(float, int32);
+REGISTER_FUSED_MOMENTS(float, int64_t);
+REGISTER_FUSED_MOMENTS(double, int32);
+REGISTER_FUSED_MOMENTS(double, int64_t);
+#undef REGISTER_FUSED_MOMENTS
+
+}  // namespace
+}  // namespace tensorflow
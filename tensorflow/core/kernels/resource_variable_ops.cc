@@ -58,6 +58,7 @@ limitations under the License.
 #endif
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -155,6 +156,19 @@ void ReadVariableOp::Compute(OpKernelContext* ctx) {
                   "Debug info: container=", handle.container(),
                   ", status error message=", status.message()));
 
+  if (variable->frozen.load(std::memory_order_acquire)) {
+    // Frozen variables are immutable, so the buffer can be aliased without
+    // taking the lock: no write can race with this read.
+    const Tensor* t = variable->tensor();
+    OP_REQUIRES(
+        ctx, dtype_ == t->dtype(),
+        errors::InvalidArgument(
+            "Trying to read variable with wrong dtype. Expected ",
+            DataTypeString(dtype_), " got ", DataTypeString(t->dtype())));
+    ctx->set_output(0, *t);
+    return;
+  }
+
   tf_shared_lock ml(*variable->mu());
   // We're acquiring a reference to the underlying buffer while
   // holding a shared lock to guarantee ordering of reads and
@@ -205,10 +219,15 @@ void ReadVariablesOp::Compute(OpKernelContext* ctx) {
                   absl::StrJoin(uninitialized_vars, ", ")));
 
   for (size_t i = 0; i < dtypes_.size(); ++i) {
-    // We're acquiring a reference to the underlying buffer while
-    // holding a shared lock to guarantee ordering of reads and
-    // writes.
-    tf_shared_lock ml(*variables[i]->mu());
+    // Frozen variables are immutable, so their buffers can be aliased
+    // without taking the lock: no write can race with this read.
+    std::optional<tf_shared_lock> ml;
+    if (!variables[i]->frozen.load(std::memory_order_acquire)) {
+      // We're acquiring a reference to the underlying buffer while
+      // holding a shared lock to guarantee ordering of reads and
+      // writes.
+      ml.emplace(*variables[i]->mu());
+    }
     OP_REQUIRES(ctx, dtypes_[i] == variables[i]->tensor()->dtype(),
                 errors::InvalidArgument(
                     "Trying to read variable ", handles[i]->name(),
@@ -395,6 +414,35 @@ REGISTER_KERNEL_BUILDER(
     Name("DisableCopyOnRead").Device(DEVICE_DEFAULT).HostMemory("resource"),
     DisableCopyOnReadOp);
 
+void FreezeVariableOp::Compute(OpKernelContext* ctx) {
+  core::RefCountPtr<Var> variable;
+  const ResourceHandle& handle = HandleFromInput(ctx, 0);
+  const auto status = LookupResource(ctx, handle, &variable);
+  OP_REQUIRES(ctx, status.ok(),
+              errors::FailedPrecondition(
+                  "Could not find variable ", handle.name(), ". ",
+                  "This could mean that the variable has been deleted. ",
+                  "In TF1, it can also mean the variable is uninitialized. ",
+                  "Debug info: container=", handle.container(),
+                  ", status error message=", status.message()));
+  mutex_lock ml(*variable->mu());
+  OP_REQUIRES(ctx, variable->is_initialized,
+              errors::FailedPrecondition("Cannot freeze uninitialized variable ",
+                                         handle.name()));
+  OP_REQUIRES(ctx, !variable->copy_on_read_mode.load(),
+              errors::FailedPrecondition(
+                  "Cannot freeze variable ", handle.name(),
+                  " while it is in copy-on-read mode. Run DisableCopyOnRead "
+                  "on it first."));
+  variable->frozen.store(true, std::memory_order_release);
+}
+
+REGISTER_KERNEL_BUILDER(Name("_FreezeVariable").Device(DEVICE_CPU),
+                        FreezeVariableOp);
+REGISTER_KERNEL_BUILDER(
+    Name("_FreezeVariable").Device(DEVICE_DEFAULT).HostMemory("resource"),
+    FreezeVariableOp);
+
 template <typename Device, typename T>
 class AssignVariableOp : public OpKernel {
  public:
@@ -435,6 +483,9 @@ class AssignVariableOp : public OpKernel {
                                   return OkStatus();
                                 }));
     mutex_lock ml(*variable->mu());
+    OP_REQUIRES(context, !variable->frozen.load(),
+                errors::FailedPrecondition("Trying to assign frozen variable ",
+                                           HandleFromInput(context, 0).name()));
     // (variable->tensor()->dtype() == DT_INVALID && !variable->is_initialized)
     // check below is to allow an XLA specific situation wherein update can
     // happen first by the AssignVariableOp,
@@ -523,6 +574,9 @@ class AssignVariableOp<Device, Variant> : public OpKernel {
         attr);
 
     mutex_lock ml(*variable->mu());
+    OP_REQUIRES(context, !variable->frozen.load(),
+                errors::FailedPrecondition("Trying to assign frozen variable ",
+                                           HandleFromInput(context, 0).name()));
     OP_REQUIRES(context, variable->tensor()->dtype() == DT_VARIANT,
                 errors::InvalidArgument(
                     "Trying to assign variable with wrong dtype. Expected ",
@@ -615,6 +669,9 @@ class AssignUpdateVariableOp : public OpKernel {
     // PrepareToUpdateVariable() for commutative operations like Op ==
     // ADD if value's refcount was 1.
     mutex_lock ml(*variable->mu());
+    OP_REQUIRES(context, !variable->frozen.load(),
+                errors::FailedPrecondition("Trying to update frozen variable ",
+                                           HandleFromInput(context, 0).name()));
     Tensor* var_tensor = variable->tensor();
     OP_REQUIRES_OK(context, ValidateAssignUpdateVariableOpShapes(
                                 var_tensor->shape(), value.shape()));
@@ -74,6 +74,12 @@ class DisableCopyOnReadOp : public OpKernel {
   void Compute(OpKernelContext* ctx) override;
 };
 
+class FreezeVariableOp : public OpKernel {
+ public:
+  explicit FreezeVariableOp(OpKernelConstruction* c) : OpKernel(c) {}
+  void Compute(OpKernelContext* ctx) override;
+};
+
 template <typename T>
 class VariableShapeOp : public OpKernel {
  public:
@@ -250,6 +250,10 @@ namespace {
 // Tensors larger than this threshold will be restored from a thread-pool.
 const int64_t kLargeShapeThreshold = 16 << 20;  // 16M
 
+// Maximum number of data-shard reads that a batched restore issues in
+// parallel.
+const int kMaxRestoreParallelism = 8;
+
 // A restore operation for a single tensor.  Small tensors may be restored
 // directly from the op thread to improve read locality.  Large tensors can be
 // restored from a thread pool: this requires creating a separate BundleReader
@@ -402,13 +406,37 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     return errors::InvalidArgument(error_msg);
   }
 
+  // Full (non-sliced) restores are issued as one batch: allocate every output
+  // up front, then let the reader order the entries by file offset and read
+  // the data shards in parallel.  Sliced restores keep the per-op path, which
+  // goes through the reader's slice machinery.
+  std::vector<string> batched_keys;
+  std::vector<Tensor*> batched_tensors;
+  std::vector<RestoreOp*> sliced_restore_ops;
+  for (RestoreOp& restore_op : restore_ops) {
+    if (!restore_op.shape_and_slice.empty()) {
+      sliced_restore_ops.push_back(&restore_op);
+      continue;
+    }
+    TensorShape restored_full_shape;
+    TF_RETURN_IF_ERROR(default_reader.LookupTensorShape(
+        restore_op.tensor_name, &restored_full_shape));
+    Tensor* restored_tensor = nullptr;
+    TF_RETURN_IF_ERROR(context->allocate_output(
+        restore_op.idx, restored_full_shape, &restored_tensor));
+    batched_keys.push_back(restore_op.tensor_name);
+    batched_tensors.push_back(restored_tensor);
+  }
+  TF_RETURN_IF_ERROR(default_reader.RestoreAll(batched_keys, batched_tensors,
+                                               kMaxRestoreParallelism));
+
   std::vector<RestoreOp*> pool_restore_ops;
   std::vector<RestoreOp*> direct_restore_ops;
-  for (RestoreOp& restore_op : restore_ops) {
-    if (restore_op.should_run_in_pool(&default_reader)) {
-      pool_restore_ops.push_back(&restore_op);
+  for (RestoreOp* restore_op : sliced_restore_ops) {
+    if (restore_op->should_run_in_pool(&default_reader)) {
+      pool_restore_ops.push_back(restore_op);
     } else {
-      direct_restore_ops.push_back(&restore_op);
+      direct_restore_ops.push_back(restore_op);
     }
   }
 
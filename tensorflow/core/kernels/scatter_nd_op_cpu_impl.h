@@ -20,7 +20,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
@@ -127,6 +129,9 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
           batch_strides[dim + 1] * output_shape_prefix[dim + 1];
     }
 
+    // Precompute the flattened destination row of every update, validating
+    // bounds up front so the parallel appliers below can assume clean input.
+    std::vector<Index> dest_rows(batch_size);
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
@@ -138,7 +143,22 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
       if (TF_PREDICT_FALSE(out_of_bounds)) {
         error_loc = loc;
         break;
-      } else {
+      }
+      dest_rows[loc] = i;
+    }
+
+    // Like the historical serial loop, updates preceding an out-of-bounds
+    // index are still applied.
+    const Eigen::DenseIndex valid_batch =
+        error_loc < 0 ? batch_size : static_cast<Eigen::DenseIndex>(error_loc);
+
+    // Applies the updates in [0, valid_batch) whose destination row falls in
+    // [row_lo, row_hi). Updates to a given row are applied in index order, so
+    // the result is identical to the serial loop regardless of partitioning.
+    auto apply_to_rows = [&](Index row_lo, Index row_hi) {
+      for (Eigen::DenseIndex loc = 0; loc < valid_batch; ++loc) {
+        const Index i = dest_rows[loc];
+        if (i < row_lo || i >= row_hi) continue;
         auto input_chip = Toutput.template chip<0>(i);
         auto output_chip = input_chip;
         auto update_chip = Tupdates.template chip<0>(loc);
@@ -147,6 +167,41 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
             decltype(output_chip), OP>::Execute(d, input_chip, update_chip,
                                                 output_chip);
       }
+    };
+
+    const Index num_dest_rows = Toutput.dimension(0);
+    const Eigen::DenseIndex total_work =
+        valid_batch * static_cast<Eigen::DenseIndex>(slice_size);
+    // Partition the destination row space so that each row has exactly one
+    // writer and no synchronization is needed. Every partition rescans the
+    // (cheap, contiguous) row index list, so only spread the work when each
+    // partition gets enough slice data to amortize that scan.
+    constexpr Eigen::DenseIndex kMinPartitionWork = 64 << 10;
+    const Eigen::DenseIndex num_partitions = std::min<Eigen::DenseIndex>(
+        {static_cast<Eigen::DenseIndex>(d.numThreads()),
+         total_work / kMinPartitionWork,
+         static_cast<Eigen::DenseIndex>(num_dest_rows)});
+
+    if (num_partitions <= 1) {
+      apply_to_rows(0, num_dest_rows);
+    } else {
+      const Index rows_per_partition = static_cast<Index>(
+          (num_dest_rows + num_partitions - 1) / num_partitions);
+      const Eigen::DenseIndex cycles_per_partition =
+          valid_batch + total_work / num_partitions;
+      const Eigen::TensorOpCost cost(
+          sizeof(T) * total_work / num_partitions /* bytes loaded */,
+          sizeof(T) * total_work / num_partitions /* bytes stored */,
+          cycles_per_partition);
+      d.parallelFor(num_partitions, cost,
+                    [&](Eigen::DenseIndex pbegin, Eigen::DenseIndex pend) {
+                      const Index row_lo =
+                          static_cast<Index>(pbegin) * rows_per_partition;
+                      const Index row_hi = std::min<Index>(
+                          num_dest_rows,
+                          static_cast<Index>(pend) * rows_per_partition);
+                      apply_to_rows(row_lo, row_hi);
+                    });
     }
 
     return error_loc;
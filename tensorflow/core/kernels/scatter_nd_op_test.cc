@@ -174,6 +174,32 @@ TEST_F(ScatterNdUpdateOpTest, HigherRank) {
   test::ExpectTensorEqual<float>(expected, params_tensor);
 }
 
+TEST_F(ScatterNdUpdateOpTest, ParallelUpdate) {
+  // Large enough that the functor partitions the destination rows across
+  // threads. Later updates to a row must still win, as in the serial path.
+  MakeOp(DT_FLOAT_REF, DT_INT32);
+
+  constexpr int kNumRows = 128;
+  constexpr int kSliceSize = 1024;
+  constexpr int kNumUpdates = 2 * kNumRows;
+  AddInput<float>(TensorShape({kNumRows, kSliceSize}),
+                  [](int i) { return 0.0f; });
+  AddInput<int32>(TensorShape({kNumUpdates, 1}),
+                  [](int i) { return i % kNumRows; });
+  // Every row is written twice; the second write carries i >= kNumRows.
+  AddInput<float>(TensorShape({kNumUpdates, kSliceSize}),
+                  [](int i) { return static_cast<float>(i / kSliceSize); });
+  TF_ASSERT_OK(RunOpKernel());
+
+  Tensor params_tensor = *mutable_input(0).tensor;
+  auto result = params_tensor.flat<float>();
+  for (int row = 0; row < kNumRows; ++row) {
+    EXPECT_EQ(static_cast<float>(row + kNumRows),
+              result(row * kSliceSize))
+        << "row " << row;
+  }
+}
+
 TEST_F(ScatterNdUpdateOpTest, Error_IndexOutOfRange) {
   MakeOp(DT_FLOAT_REF, DT_INT32);
 
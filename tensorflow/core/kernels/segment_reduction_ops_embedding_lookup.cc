@@ -0,0 +1,172 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// CPU kernel for the _EmbeddingLookupSparse op: a fused Gather + sparse
+// segment reduction. Looked-up rows are accumulated directly into the output
+// so the gathered intermediate (which dwarfs the cache for large tables) is
+// never materialized. Row accumulation is expressed with Eigen maps, which
+// vectorize for the target instruction set; segments are sharded across
+// threads so each output row has exactly one writer.
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <cmath>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+namespace {
+
+enum class EmbeddingCombiner { kSum, kMean, kSqrtN };
+
+template <typename T, typename Tindex, typename Tsegment>
+class EmbeddingLookupSparseOp : public OpKernel {
+ public:
+  explicit EmbeddingLookupSparseOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    string combiner;
+    OP_REQUIRES_OK(context, context->GetAttr("combiner", &combiner));
+    if (combiner == "sum") {
+      combiner_ = EmbeddingCombiner::kSum;
+    } else if (combiner == "mean") {
+      combiner_ = EmbeddingCombiner::kMean;
+    } else {
+      OP_REQUIRES(context, combiner == "sqrtn",
+                  errors::InvalidArgument("Unknown combiner: ", combiner));
+      combiner_ = EmbeddingCombiner::kSqrtN;
+    }
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& data = context->input(0);
+    const Tensor& indices = context->input(1);
+    const Tensor& segment_ids = context->input(2);
+
+    OP_REQUIRES(context, TensorShapeUtils::IsVectorOrHigher(data.shape()),
+                errors::InvalidArgument("data must be at least rank 1"));
+    OP_REQUIRES(context, TensorShapeUtils::IsVector(indices.shape()),
+                errors::InvalidArgument("indices should be a vector."));
+    OP_REQUIRES(context, TensorShapeUtils::IsVector(segment_ids.shape()),
+                errors::InvalidArgument("segment_ids should be a vector."));
+
+    const int64_t num_indices = indices.NumElements();
+    OP_REQUIRES(context, num_indices == segment_ids.NumElements(),
+                errors::InvalidArgument(
+                    "segment_ids and indices should have same size."));
+
+    const int64_t num_rows = data.dim_size(0);
+    const int64_t dim = num_rows > 0 ? data.NumElements() / num_rows : 0;
+
+    const auto indices_vec = indices.vec<Tindex>();
+    const auto segment_vec = segment_ids.vec<Tsegment>();
+
+    // Validate up front so the sharded accumulation below can assume sorted
+    // segment ids and in-range indices.
+    for (int64_t i = 0; i < num_indices; ++i) {
+      const Tindex index = indices_vec(i);
+      OP_REQUIRES(context, index >= 0 && index < num_rows,
+                  errors::InvalidArgument("Index ", index, " out of range [0, ",
+                                          num_rows, ")."));
+      const Tsegment segment = segment_vec(i);
+      OP_REQUIRES(
+          context, segment >= 0,
+          errors::InvalidArgument("segment ids must be >= 0"));
+      OP_REQUIRES(
+          context, i == 0 || segment_vec(i - 1) <= segment,
+          errors::InvalidArgument("segment ids are not increasing"));
+    }
+
+    const int64_t num_segments =
+        num_indices > 0 ? static_cast<int64_t>(segment_vec(num_indices - 1)) + 1
+                        : 0;
+    TensorShape output_shape = data.shape();
+    output_shape.set_dim(0, num_segments);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+
+    const T* data_base = data.flat<T>().data();
+    T* out_base = output->flat<T>().data();
+    const Tsegment* seg_begin = segment_vec.data();
+    const Tsegment* seg_end = seg_begin + num_indices;
+    const EmbeddingCombiner combiner = combiner_;
+
+    auto reduce_segments = [&](int64_t start_seg, int64_t end_seg) {
+      typedef Eigen::Map<Eigen::Array<T, Eigen::Dynamic, 1>> Row;
+      typedef Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>> ConstRow;
+      // Segment ids are sorted, so this worker's slice of the index list
+      // starts at the first occurrence of its first segment.
+      int64_t i = std::lower_bound(seg_begin, seg_end,
+                                   static_cast<Tsegment>(start_seg)) -
+                  seg_begin;
+      for (int64_t seg = start_seg; seg < end_seg; ++seg) {
+        Row out_row(out_base + seg * dim, dim);
+        out_row.setZero();
+        int64_t count = 0;
+        while (i < num_indices &&
+               static_cast<int64_t>(seg_begin[i]) == seg) {
+          out_row += ConstRow(data_base + indices_vec(i) * dim, dim);
+          ++i;
+          ++count;
+        }
+        if (count > 1) {
+          if (combiner == EmbeddingCombiner::kMean) {
+            out_row /= static_cast<T>(count);
+          } else if (combiner == EmbeddingCombiner::kSqrtN) {
+            out_row /= static_cast<T>(std::sqrt(static_cast<double>(count)));
+          }
+        }
+      }
+    };
+
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    // Per-segment cost: one row load and accumulate per looked-up id, plus
+    // the combiner scaling pass.
+    const int64_t avg_indices_per_segment =
+        (num_indices + num_segments - 1) / num_segments;
+    const int64_t cost_per_segment = dim * (avg_indices_per_segment + 1);
+    Shard(worker_threads->num_threads, worker_threads->workers, num_segments,
+          cost_per_segment, reduce_segments);
+  }
+
+ private:
+  EmbeddingCombiner combiner_;
+};
+
+#define REGISTER_CPU_KERNEL(index_type, segment_type)            \
+  REGISTER_KERNEL_BUILDER(                                       \
+      Name("_EmbeddingLookupSparse")                             \
+          .Device(DEVICE_CPU)                                    \
+          .TypeConstraint<float>("T")                            \
+          .TypeConstraint<index_type>("Tidx")                    \
+          .TypeConstraint<segment_type>("Tsegmentids"),          \
+      EmbeddingLookupSparseOp<float, index_type, segment_type>);
+
+REGISTER_CPU_KERNEL(int32, int32);
+REGISTER_CPU_KERNEL(int32, int64_t);
+REGISTER_CPU_KERNEL(int64_t, int32);
+REGISTER_CPU_KERNEL(int64_t, int64_t);
+#undef REGISTER_CPU_KERNEL
+
+}  // namespace
+}  // namespace tensorflow
@@ -18,6 +18,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_SEGMENT_REDUCTION_OPS_IMPL_H_
 #define TENSORFLOW_CORE_KERNELS_SEGMENT_REDUCTION_OPS_IMPL_H_
 
+#include <algorithm>
 #include <cstdint>
 
 #include "tensorflow/core/framework/op_requires.h"
@@ -41,8 +42,10 @@ limitations under the License.
 #include "tensorflow/core/kernels/segment_reduction_ops.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -597,6 +600,20 @@ class SparseSegmentReductionOpBase : public OpKernel {
     }
     auto temp_flat = temp.flat_outer_dims<float>();
 
+    // For large inputs, partition the segments across threads. Segments write
+    // disjoint output rows, so once the segment ids are known to be sorted
+    // each thread can find its segment range with a binary search and reduce
+    // independently.
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    if (worker_threads->num_threads > 1 &&
+        num_indices * num_col >= kMinElementsForParallelReduction) {
+      OP_REQUIRES_OK(
+          context, ComputeParallel(worker_threads, input_flat, indices_vec,
+                                   segment_vec, output_flat, temp_flat,
+                                   num_indices, output_rows));
+      return;
+    }
+
     int64_t start = 0, end = 1;
     // Index from which the output is not initialized.
     SegmentId uninitialized_index = 0;
@@ -846,6 +863,126 @@ class SparseSegmentReductionOpBase : public OpKernel {
 #undef INDEX
   }
 
+  // Below this many input elements the sequential implementation is used;
+  // sharding overhead would dominate.
+  static constexpr int64_t kMinElementsForParallelReduction = 1 << 15;
+
+  // Parallel implementation of the reduction loop in Compute(). Each shard
+  // owns the segments that start within its range of indices, so shards write
+  // disjoint rows of the output. The segment ids are validated to be sorted
+  // up front, both because the binary-search partitioning relies on it and
+  // because it guarantees the shards cannot race on an output row.
+  Status ComputeParallel(const DeviceBase::CpuWorkerThreads* worker_threads,
+                         const typename TTypes<T>::ConstMatrix& input_flat,
+                         const typename TTypes<Index>::ConstVec& indices_vec,
+                         const typename TTypes<SegmentId>::ConstVec& segment_vec,
+                         typename TTypes<T>::Matrix output_flat,
+                         typename TTypes<float>::Matrix temp_flat,
+                         int64_t num_indices, Index output_rows) {
+    const int64_t num_col = input_flat.dimension(1);
+    mutex mu;
+    Status result;
+    auto record_error = [&](Status s) {
+      mutex_lock l(mu);
+      result.Update(s);
+    };
+
+    if (internal::SubtleMustCopy(segment_vec(0)) < 0) {
+      return errors::InvalidArgument("segment ids must be >= 0");
+    }
+    auto validate = [&](int64_t start, int64_t end) {
+      for (int64_t i = std::max<int64_t>(start, 1); i < end; ++i) {
+        if (segment_vec(i - 1) > segment_vec(i)) {
+          record_error(
+              errors::InvalidArgument("segment ids are not increasing"));
+          return;
+        }
+      }
+    };
+    Shard(worker_threads->num_threads, worker_threads->workers, num_indices,
+          /*cost_per_unit=*/2, validate);
+    {
+      mutex_lock l(mu);
+      TF_RETURN_IF_ERROR(result);
+    }
+
+    // Returns the first index whose segment id is greater than `id`.
+    auto upper_bound = [&](SegmentId id) {
+      int64_t lo = 0, hi = num_indices;
+      while (lo < hi) {
+        const int64_t mid = lo + (hi - lo) / 2;
+        if (internal::SubtleMustCopy(segment_vec(mid)) <= id) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      return lo;
+    };
+
+    auto reduce = [&](int64_t shard_start, int64_t shard_end) {
+      const int64_t lo =
+          shard_start == 0
+              ? 0
+              : upper_bound(internal::SubtleMustCopy(segment_vec(shard_start - 1)));
+      const int64_t hi =
+          shard_end >= num_indices
+              ? num_indices
+              : upper_bound(internal::SubtleMustCopy(segment_vec(shard_end - 1)));
+      if (lo >= hi) return;
+      SegmentId uninitialized_index =
+          lo == 0 ? 0 : internal::SubtleMustCopy(segment_vec(lo - 1)) + 1;
+      int64_t start = lo;
+      while (start < hi) {
+        const SegmentId out_index = internal::SubtleMustCopy(segment_vec(start));
+        int64_t end = start + 1;
+        while (end < hi && segment_vec(end) == out_index) ++end;
+        if (!FastBoundsCheck(out_index, output_rows)) {
+          record_error(errors::InvalidArgument("Segment id ", out_index,
+                                               " out of range [0, ",
+                                               output_rows, ")"));
+          return;
+        }
+        // Rows between the previous segment (possibly owned by another
+        // shard) and this one get the default value.
+        if (out_index > uninitialized_index) {
+          Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
+              out_index - uninitialized_index, num_col);
+          Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>,
+                           Eigen::Unaligned>
+              gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
+          gap_slice.setConstant(default_value_);
+        }
+        auto out = output_flat.template chip<0>(out_index);
+        auto temp = temp_flat.template chip<0>(out_index);
+        const int bad_offset = Reduce<T, Index>(input_flat, indices_vec, start,
+                                                end - start, out, temp);
+        if (bad_offset >= 0) {
+          record_error(errors::InvalidArgument(
+              "Bad: indices[", start + bad_offset,
+              "] == ", indices_vec(start + bad_offset), " out of range [0, ",
+              input_flat.dimension(0), ")"));
+          return;
+        }
+        uninitialized_index = out_index + 1;
+        start = end;
+      }
+      // The shard owning the last segment fills the trailing gap.
+      if (hi == num_indices && uninitialized_index < output_rows) {
+        Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
+            output_rows - uninitialized_index, num_col);
+        Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>, Eigen::Unaligned>
+            gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
+        gap_slice.setConstant(default_value_);
+      }
+    };
+    Shard(worker_threads->num_threads, worker_threads->workers, num_indices,
+          /*cost_per_unit=*/num_col * sizeof(T), reduce);
+
+    mutex_lock l(mu);
+    return result;
+  }
+
   const bool is_mean_;
   const bool is_sqrtn_;
   const bool has_num_segments_;
@@ -181,6 +181,51 @@ BM_Reduce_Arg(64, 32, 2);
 BM_Reduce_Arg(4096, 32, 2);
 BM_Reduce_Arg(4096, 128, 2);
 
+template <typename Index>
+static void SparseSegmentSumHelper(::testing::benchmark::State& state,
+                                   int num_indices, int num_rows, int num_cols,
+                                   int segment_size) {
+  Graph* g = new Graph(OpRegistry::Global());
+
+  Tensor input(DT_FLOAT, TensorShape({num_rows, num_cols}));
+  input.flat<float>().setRandom();
+
+  Tensor indices(DataTypeToEnum<Index>::v(), TensorShape({num_indices}));
+  test::FillFn<Index>(&indices, [num_rows](Index i) -> Index {
+    return (i * 31) % num_rows;
+  });
+  // Sorted segment ids, `segment_size` indices per segment.
+  Tensor segments(DT_INT32, TensorShape({num_indices}));
+  test::FillFn<int32>(&segments, [segment_size](int32_t i) -> int32 {
+    return i / segment_size;
+  });
+
+  Node* node;
+  TF_CHECK_OK(NodeBuilder(g->NewName("n"), "SparseSegmentSum")
+                  .Input(test::graph::Constant(g, input))
+                  .Input(test::graph::Constant(g, indices))
+                  .Input(test::graph::Constant(g, segments))
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(g, &node));
+
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_indices * num_cols * sizeof(float));
+}
+
+#define BM_SparseReduce(N, R, C, S)                            \
+  static void BM_SparseSegmentSum_##N##_##R##_##C##_##S##_int32( \
+      ::testing::benchmark::State& state) {                    \
+    SparseSegmentSumHelper<int32>(state, N, R, C, S);          \
+  }                                                            \
+  BENCHMARK(BM_SparseSegmentSum_##N##_##R##_##C##_##S##_int32);
+
+// Small problem: stays on the sequential path.
+BM_SparseReduce(4096, 1024, 64, 2);
+// Large problems: exercise the sharded path.
+BM_SparseReduce(1048576, 65536, 64, 4);
+BM_SparseReduce(1048576, 65536, 64, 256);
+
 template <DataType T>
 static void SparseSegmentMeanGradHelper(::testing::benchmark::State& state,
                                         float uniqueness, int size) {
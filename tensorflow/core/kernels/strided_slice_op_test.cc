@@ -18,6 +18,8 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
 #include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/framework/fake_input.h"
+#include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
@@ -35,6 +37,32 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 
+class StridedSliceOpTest : public OpsTestBase {};
+
+// Pins down how many allocations a strided slice performs, so an extra copy
+// or temp sneaking into the kernel fails here instead of regressing silently.
+TEST_F(StridedSliceOpTest, AllocationBudget) {
+  TF_ASSERT_OK(NodeDefBuilder("strided_slice", "StridedSlice")
+                   .Input(FakeInput(DT_FLOAT))
+                   .Input(FakeInput(DT_INT32))
+                   .Input(FakeInput(DT_INT32))
+                   .Input(FakeInput(DT_INT32))
+                   .Attr("T", DT_FLOAT)
+                   .Attr("Index", DT_INT32)
+                   .Finalize(node_def()));
+  TF_ASSERT_OK(InitOp());
+  AddInput<float>(TensorShape({10, 10}),
+                  [](int i) { return static_cast<float>(i); });
+  AddInputFromList<int32>(TensorShape({2}), {1, 1});
+  AddInputFromList<int32>(TensorShape({2}), {9, 9});
+  AddInputFromList<int32>(TensorShape({2}), {1, 1});
+
+  int64_t num_allocations = 0;
+  TF_ASSERT_OK(RunOpKernelWithAllocationCount(&num_allocations));
+  // One allocation for the output; the second tolerates an internal temp.
+  EXPECT_LE(num_allocations, 2);
+}
+
 // For the benchmark, we set up two 2-dimensional tensors, each kDim1 x 'dim'
 // in size, and concat them together along "concat_dimension"
 template <typename T>
@@ -70,7 +98,17 @@ static void SliceHelper(::testing::benchmark::State& state) {
                   .Attr("T", dt)
                   .Finalize(g, &node));
 
+  // Enforce an allocation budget alongside the timing: per iteration the
+  // slice should allocate its output and little else. The constant slack
+  // absorbs one-time setup (executor construction, constant tensors), which
+  // is amortized over the iterations. A kernel change that doubles
+  // allocations per slice trips this long before it shows up in wall time.
+  constexpr int64_t kMaxAllocsPerIteration = 8;
+  constexpr int64_t kSetupAllocSlack = 1024;
+  test::CpuAllocationCounter counter;
   test::Benchmark("cpu", g, /*old_benchmark_api*/ false).Run(state);
+  CHECK_LE(counter.num_allocs(),
+           state.iterations() * kMaxAllocsPerIteration + kSetupAllocSlack);
   state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * kDim *
                           size * sizeof(T));
 }
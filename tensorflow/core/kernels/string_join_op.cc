@@ -67,7 +67,24 @@ class StringJoinOp : public OpKernel {
       for (int j = 0; j < input_list.size(); ++j) {
         strings[j] = (is_scalar[j]) ? inputs[j](0) : inputs[j](i);
       }
-      output_flat(i) = absl::StrJoin(strings, separator_);
+      // Append directly into the output tstring with the exact size reserved
+      // up front, rather than materializing a std::string per element and
+      // copying it into the output.
+      size_t total_size = 0;
+      for (const StringPiece& s : strings) {
+        total_size += s.size();
+      }
+      if (!strings.empty()) {
+        total_size += separator_.size() * (strings.size() - 1);
+      }
+      tstring* out = &output_flat(i);
+      out->reserve(total_size);
+      for (int j = 0; j < input_list.size(); ++j) {
+        if (j > 0) {
+          out->append(separator_.data(), separator_.size());
+        }
+        out->append(strings[j].data(), strings[j].size());
+      }
     }
   }
 
@@ -16,7 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_STRING_TO_HASH_BUCKET_FAST_OP_H_
 #define TENSORFLOW_CORE_KERNELS_STRING_TO_HASH_BUCKET_FAST_OP_H_
 
+#include <cstring>
 #include <string>
+#include <vector>
 
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -45,7 +47,39 @@ class StringToHashBucketOp : public OpKernel {
     auto output_flat = output_tensor->flat<int64_t>();
 
     typedef decltype(input_flat.size()) Index;
-    for (Index i = 0; i < input_flat.size(); ++i) {
+    const Index num_elements = input_flat.size();
+
+    // Categorical inputs tend to repeat the same few thousand hot strings
+    // over and over; for large batches a direct-mapped memoization cache
+    // skips rehashing repeated values. Entries key on the full string (a
+    // view into the input tensor, which outlives the call and is not
+    // modified by it), so a slot collision only costs a recompute, never a
+    // wrong bucket. The cache lives on this stack frame and is discarded at
+    // the end of the call, which keeps it free of synchronization.
+    if (num_elements >= kMinElementsForCache) {
+      std::vector<CacheEntry> cache(kCacheSize);
+      for (Index i = 0; i < num_elements; ++i) {
+        const tstring& input = input_flat(i);
+        CacheEntry& entry = cache[CacheSlot(input) & (kCacheSize - 1)];
+        if (entry.data != nullptr && entry.size == input.size() &&
+            memcmp(entry.data, input.data(), input.size()) == 0) {
+          output_flat(i) = entry.bucket_id;
+          continue;
+        }
+        const uint64 input_hash = hash(input);
+        const uint64 bucket_id = input_hash % num_buckets_;
+        // The number of buckets is always in the positive range of int64 so
+        // is the resulting bucket_id. Casting the bucket_id from uint64 to
+        // int64 is safe.
+        entry.data = input.data();
+        entry.size = input.size();
+        entry.bucket_id = static_cast<int64_t>(bucket_id);
+        output_flat(i) = entry.bucket_id;
+      }
+      return;
+    }
+
+    for (Index i = 0; i < num_elements; ++i) {
       const uint64 input_hash = hash(input_flat(i));
       const uint64 bucket_id = input_hash % num_buckets_;
       // The number of buckets is always in the positive range of int64 so is
@@ -56,6 +90,34 @@ class StringToHashBucketOp : public OpKernel {
   }
 
  private:
+  // Must be a power of two so the slot index can mask instead of mod.
+  static constexpr int64_t kCacheSize = 4096;
+  // Below this size the cache cannot amortize its initialization.
+  static constexpr int64_t kMinElementsForCache = 2 * kCacheSize;
+
+  struct CacheEntry {
+    const char* data = nullptr;  // nullptr marks an unused slot.
+    size_t size = 0;
+    int64_t bucket_id = 0;
+  };
+
+  // Cheap slot index mixed from the length and up to the first and last four
+  // bytes. Unlike the full hash this never walks the whole string, which is
+  // where the memoization saving comes from.
+  static uint64 CacheSlot(const tstring& input) {
+    uint64 h = input.size();
+    uint32 head = 0;
+    uint32 tail = 0;
+    if (input.size() >= 4) {
+      memcpy(&head, input.data(), 4);
+      memcpy(&tail, input.data() + input.size() - 4, 4);
+    } else if (!input.empty()) {
+      memcpy(&head, input.data(), input.size());
+    }
+    h = (h ^ head ^ (static_cast<uint64>(tail) << 20)) * 0x9E3779B97F4A7C15ull;
+    return h >> 32;
+  }
+
   int64_t num_buckets_;
 
   StringToHashBucketOp(const StringToHashBucketOp&) = delete;
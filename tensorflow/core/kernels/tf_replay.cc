@@ -0,0 +1,365 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A C++ binary that replays individual operators from a production execution
+// trace against the current build, with synthetic input data shaped like the
+// recorded inputs.
+//
+// The trace is an ordinary RunMetadata proto captured by running a model with
+//
+//   RunOptions::trace_level = FULL
+//   RunOptions::output_partition_graphs = true
+//
+// and serializing the resulting RunMetadata to a file. The partition graphs
+// supply each node's NodeDef (op and attrs), and the step stats supply each
+// node's recorded output shapes, dtypes and wall time. For every sufficiently
+// expensive node, this tool rebuilds a single-op graph (the node fed by
+// placeholders), runs it repeatedly in a fresh session with zero-filled
+// tensors of the recorded input shapes, and reports the replayed time next to
+// the recorded one. Running the same trace against two builds bisects
+// kernel-level regressions using the shape distribution production actually
+// saw, without re-running the full model.
+//
+// Example usage:
+//   bazel run -c opt tensorflow/core/kernels:tf_replay -- \
+//     --trace=/tmp/run_metadata.pb --min_micros=100 --num_runs=50
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/op_def.pb.h"
+#include "tensorflow/core/framework/step_stats.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_description.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/strings/numbers.h"
+#include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/init_main.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/public/session.h"
+#include "tensorflow/core/util/command_line_flags.h"
+
+namespace tensorflow {
+namespace {
+
+// What the trace recorded about one executed node.
+struct RecordedNode {
+  const NodeDef* node_def = nullptr;
+  // Output tensor descriptions, indexed by output slot.
+  std::vector<TensorDescription> outputs;
+  // Wall time the kernel's Compute took in the recorded run.
+  int64_t op_micros = 0;
+};
+
+// Parses "name", "name:2" or "^name" into a (producer, slot) pair. Control
+// inputs are reported as slot -1.
+std::pair<string, int> ParseTensorName(const string& input_name) {
+  if (!input_name.empty() && input_name[0] == '^') {
+    return {input_name.substr(1), -1};
+  }
+  const size_t colon = input_name.rfind(':');
+  if (colon == string::npos) {
+    return {input_name, 0};
+  }
+  int slot = 0;
+  if (!strings::safe_strto32(input_name.substr(colon + 1), &slot)) {
+    return {input_name, 0};
+  }
+  return {input_name.substr(0, colon), slot};
+}
+
+// Builds a zero-filled tensor of the given dtype and shape. Returns an error
+// for dtypes we cannot synthesize (resources, variants, refs).
+Status MakeSyntheticTensor(DataType dtype, const TensorShape& shape,
+                           Tensor* out) {
+  Tensor tensor(dtype, shape);
+  switch (dtype) {
+    case DT_FLOAT:
+      tensor.flat<float>().setZero();
+      break;
+    case DT_DOUBLE:
+      tensor.flat<double>().setZero();
+      break;
+    case DT_HALF:
+      tensor.flat<Eigen::half>().setZero();
+      break;
+    case DT_BFLOAT16:
+      tensor.flat<bfloat16>().setZero();
+      break;
+    case DT_INT32:
+      tensor.flat<int32>().setZero();
+      break;
+    case DT_INT64:
+      tensor.flat<int64_t>().setZero();
+      break;
+    case DT_UINT8:
+      tensor.flat<uint8>().setZero();
+      break;
+    case DT_INT8:
+      tensor.flat<int8>().setZero();
+      break;
+    case DT_UINT16:
+      tensor.flat<uint16>().setZero();
+      break;
+    case DT_INT16:
+      tensor.flat<int16>().setZero();
+      break;
+    case DT_BOOL:
+      tensor.flat<bool>().setConstant(false);
+      break;
+    case DT_COMPLEX64:
+      tensor.flat<complex64>().setZero();
+      break;
+    case DT_COMPLEX128:
+      tensor.flat<complex128>().setZero();
+      break;
+    case DT_STRING:
+      tensor.flat<tstring>().setConstant("");
+      break;
+    default:
+      return errors::Unimplemented("Cannot synthesize input of type ",
+                                   DataTypeString(dtype));
+  }
+  *out = std::move(tensor);
+  return OkStatus();
+}
+
+// Builds a graph containing just `node`, with every data input replaced by a
+// placeholder, and synthetic feed tensors matching the recorded input shapes.
+Status BuildReplayGraph(
+    const RecordedNode& recorded,
+    const std::map<string, RecordedNode>& nodes, GraphDef* graph_def,
+    std::vector<std::pair<string, Tensor>>* feeds) {
+  NodeDef* replayed = graph_def->add_node();
+  *replayed = *recorded.node_def;
+  replayed->clear_input();
+  replayed->clear_device();
+  int placeholder_index = 0;
+  for (const string& input_name : recorded.node_def->input()) {
+    const std::pair<string, int> parsed = ParseTensorName(input_name);
+    if (parsed.second < 0) {
+      // Control inputs only constrain ordering; the single-op replay graph
+      // does not need them.
+      continue;
+    }
+    const auto producer = nodes.find(parsed.first);
+    if (producer == nodes.end() ||
+        parsed.second >=
+            static_cast<int>(producer->second.outputs.size())) {
+      return errors::NotFound("No recorded shape for input ", input_name);
+    }
+    const TensorDescription& description =
+        producer->second.outputs[parsed.second];
+    TensorShape shape;
+    TF_RETURN_IF_ERROR(TensorShape::BuildTensorShape(description.shape(),
+                                                     &shape));
+    Tensor feed_tensor;
+    TF_RETURN_IF_ERROR(
+        MakeSyntheticTensor(description.dtype(), shape, &feed_tensor));
+    const string placeholder_name =
+        strings::StrCat("replay_input_", placeholder_index++);
+    NodeDef* placeholder = graph_def->add_node();
+    placeholder->set_name(placeholder_name);
+    placeholder->set_op("Placeholder");
+    AddNodeAttr("dtype", description.dtype(), placeholder);
+    replayed->add_input(placeholder_name);
+    feeds->push_back({placeholder_name, std::move(feed_tensor)});
+  }
+  return OkStatus();
+}
+
+// Runs the single-op graph `num_runs` times and returns the mean wall time of
+// the timed runs in microseconds.
+Status ReplayNode(const RecordedNode& recorded,
+                  const std::map<string, RecordedNode>& nodes, int warmup_runs,
+                  int num_runs, int64_t* mean_micros) {
+  GraphDef graph_def;
+  std::vector<std::pair<string, Tensor>> feeds;
+  TF_RETURN_IF_ERROR(BuildReplayGraph(recorded, nodes, &graph_def, &feeds));
+
+  SessionOptions session_options;
+  std::unique_ptr<Session> session(NewSession(session_options));
+  TF_RETURN_IF_ERROR(session->Create(graph_def));
+
+  // Running the node as a target (with no fetches) executes the kernel
+  // without copying its outputs out of the runtime.
+  const std::vector<string> targets = {recorded.node_def->name()};
+  for (int i = 0; i < warmup_runs; ++i) {
+    TF_RETURN_IF_ERROR(session->Run(feeds, {}, targets, nullptr));
+  }
+  const int64_t start_micros = Env::Default()->NowMicros();
+  for (int i = 0; i < num_runs; ++i) {
+    TF_RETURN_IF_ERROR(session->Run(feeds, {}, targets, nullptr));
+  }
+  const int64_t end_micros = Env::Default()->NowMicros();
+  *mean_micros = (end_micros - start_micros) / std::max(num_runs, 1);
+  return OkStatus();
+}
+
+// Ops whose recorded executions are not meaningful to replay in isolation:
+// graph plumbing and data movement inserted by the runtime.
+bool IsReplayableOp(const NodeDef& node_def) {
+  static const auto* const kSkippedOps = new std::vector<string>(
+      {"Const", "Placeholder", "PlaceholderV2", "Identity", "IdentityN",
+       "NoOp", "_Arg", "_Retval", "_Send", "_Recv", "_HostSend", "_HostRecv"});
+  if (std::find(kSkippedOps->begin(), kSkippedOps->end(), node_def.op()) !=
+      kSkippedOps->end()) {
+    return false;
+  }
+  const OpDef* op_def = nullptr;
+  if (!OpRegistry::Global()->LookUpOpDef(node_def.op(), &op_def).ok()) {
+    return false;
+  }
+  // Stateful ops generally depend on resources the replay graph cannot
+  // reconstruct from shapes alone.
+  return !op_def->is_stateful();
+}
+
+int Main(int argc, char** argv) {
+  string trace_file;
+  string op_filter;
+  int64_t min_micros = 10;
+  int max_ops = 50;
+  int warmup_runs = 2;
+  int num_runs = 20;
+  std::vector<Flag> flag_list = {
+      Flag("trace", &trace_file,
+           "serialized RunMetadata proto recorded with trace_level=FULL and "
+           "output_partition_graphs=true"),
+      Flag("op_filter", &op_filter,
+           "if non-empty, only replay nodes whose op type contains this "
+           "substring"),
+      Flag("min_micros", &min_micros,
+           "only replay nodes whose recorded time is at least this many "
+           "microseconds"),
+      Flag("max_ops", &max_ops,
+           "replay at most this many nodes, most expensive first"),
+      Flag("warmup_runs", &warmup_runs, "untimed runs before measuring"),
+      Flag("num_runs", &num_runs, "timed runs per node"),
+  };
+  const string usage = Flags::Usage(argv[0], flag_list);
+  if (!Flags::Parse(&argc, argv, flag_list) || trace_file.empty()) {
+    LOG(ERROR) << usage;
+    return -1;
+  }
+  port::InitMain(argv[0], &argc, &argv);
+
+  RunMetadata run_metadata;
+  Status s = ReadBinaryProto(Env::Default(), trace_file, &run_metadata);
+  if (!s.ok()) {
+    LOG(ERROR) << "Could not read trace file " << trace_file << ": " << s;
+    return -1;
+  }
+  if (run_metadata.partition_graphs_size() == 0) {
+    LOG(ERROR) << "Trace has no partition graphs; record it with "
+                  "RunOptions::output_partition_graphs = true";
+    return -1;
+  }
+
+  // Join the partition graphs (node defs) with the step stats (shapes and
+  // timings) by node name. Node names are unique across partitions.
+  std::map<string, RecordedNode> nodes;
+  for (const GraphDef& partition : run_metadata.partition_graphs()) {
+    for (const NodeDef& node_def : partition.node()) {
+      nodes[node_def.name()].node_def = &node_def;
+    }
+  }
+  for (const DeviceStepStats& dev_stats :
+       run_metadata.step_stats().dev_stats()) {
+    for (const NodeExecStats& node_stats : dev_stats.node_stats()) {
+      auto it = nodes.find(node_stats.node_name());
+      if (it == nodes.end()) continue;
+      RecordedNode& recorded = it->second;
+      recorded.op_micros = std::max(
+          recorded.op_micros,
+          node_stats.op_end_rel_micros() - node_stats.op_start_rel_micros());
+      for (const NodeOutput& output : node_stats.output()) {
+        if (output.slot() >= static_cast<int>(recorded.outputs.size())) {
+          recorded.outputs.resize(output.slot() + 1);
+        }
+        recorded.outputs[output.slot()] = output.tensor_description();
+      }
+    }
+  }
+
+  // Most expensive nodes first.
+  std::vector<const RecordedNode*> candidates;
+  for (const auto& entry : nodes) {
+    const RecordedNode& recorded = entry.second;
+    if (recorded.node_def == nullptr) continue;
+    if (recorded.op_micros < min_micros) continue;
+    if (!op_filter.empty() &&
+        !absl::StrContains(recorded.node_def->op(), op_filter)) {
+      continue;
+    }
+    if (!IsReplayableOp(*recorded.node_def)) continue;
+    candidates.push_back(&recorded);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const RecordedNode* a, const RecordedNode* b) {
+              return a->op_micros > b->op_micros;
+            });
+  if (candidates.size() > static_cast<size_t>(max_ops)) {
+    candidates.resize(max_ops);
+  }
+  LOG(INFO) << "Replaying " << candidates.size() << " of " << nodes.size()
+            << " recorded nodes";
+
+  printf("%-24s %-48s %12s %12s %8s\n", "op", "node", "recorded_us",
+         "replayed_us", "ratio");
+  int replayed_count = 0;
+  for (const RecordedNode* recorded : candidates) {
+    int64_t mean_micros = 0;
+    s = ReplayNode(*recorded, nodes, warmup_runs, num_runs, &mean_micros);
+    if (!s.ok()) {
+      LOG(WARNING) << "Skipping " << recorded->node_def->name() << " ("
+                   << recorded->node_def->op() << "): " << s.message();
+      continue;
+    }
+    const double ratio =
+        recorded->op_micros > 0
+            ? static_cast<double>(mean_micros) / recorded->op_micros
+            : 0.0;
+    printf("%-24s %-48s %12lld %12lld %8.2f\n",
+           recorded->node_def->op().c_str(),
+           recorded->node_def->name().c_str(),
+           static_cast<long long>(recorded->op_micros),
+           static_cast<long long>(mean_micros), ratio);
+    ++replayed_count;
+  }
+  LOG(INFO) << "Replayed " << replayed_count << " nodes";
+  return 0;
+}
+
+}  // namespace
+}  // namespace tensorflow
+
+int main(int argc, char** argv) { return tensorflow::Main(argc, argv); }
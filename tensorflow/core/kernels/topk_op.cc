@@ -29,7 +29,6 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/types.h"
-#include "tensorflow/core/lib/gtl/top_n.h"
 #include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
@@ -128,6 +127,73 @@ class TopK : public OpKernel {
 };
 
 namespace functor {
+namespace {
+
+// Orders column indices by decreasing value, breaking ties by increasing
+// index. This is the ordering TopK has always produced for its sorted
+// output.
+template <typename T, typename Tidx>
+struct ColumnCompare {
+  explicit ColumnCompare(const T* data) : data(data) {}
+  bool operator()(const Tidx a, const Tidx b) const {
+    if (data[b] < data[a]) {
+      return true;
+    } else if (data[b] > data[a]) {
+      return false;
+    } else {
+      return a < b;
+    }
+  }
+  const T* data;
+};
+
+// Appends to `candidates` the indices of the top `k` elements of columns
+// [col_begin, col_end) of `input_data`, in unspecified order (fewer if the
+// range has fewer than k columns). Instead of pushing every column through a
+// bounded heap, a running threshold -- the k-th best value seen so far --
+// rejects whole blocks with a single vectorized max-reduction, so for
+// typical inputs only a small fraction of columns ever reaches the
+// selection step. Equal values rank by ascending index and the scan visits
+// indices in increasing order, so discarding values that do not strictly
+// beat the threshold never drops an element the heap would have kept.
+template <typename T, typename Tidx>
+void FilterTopK(const T* input_data, Tidx col_begin, Tidx col_end, int k,
+                std::vector<Tidx>* candidates) {
+  const ColumnCompare<T, Tidx> comp(input_data);
+  T threshold = T();  // Only meaningful once `have_threshold` is set.
+  bool have_threshold = false;
+  // Re-selecting once the pool reaches a small multiple of k amortizes the
+  // nth_element cost without letting the pool outgrow the cache.
+  const size_t prune_size = 2 * static_cast<size_t>(k) + 64;
+  auto prune = [&]() {
+    std::nth_element(candidates->begin(), candidates->begin() + (k - 1),
+                     candidates->end(), comp);
+    candidates->resize(k);
+    threshold = input_data[(*candidates)[k - 1]];
+    have_threshold = true;
+  };
+  // The block loop runs in int64 so that the stride cannot overflow narrow
+  // index types (Tidx may be int16).
+  constexpr int64_t kBlockSize = 256;
+  for (int64_t block_begin = col_begin; block_begin < col_end;
+       block_begin += kBlockSize) {
+    const Tidx block_end = static_cast<Tidx>(
+        std::min<int64_t>(col_end, block_begin + kBlockSize));
+    if (have_threshold) {
+      Eigen::Map<const Eigen::Array<T, Eigen::Dynamic, 1>> block(
+          input_data + block_begin, block_end - block_begin);
+      if (!(block.maxCoeff() > threshold)) continue;
+    }
+    for (Tidx c = static_cast<Tidx>(block_begin); c < block_end; ++c) {
+      if (have_threshold && !(input_data[c] > threshold)) continue;
+      candidates->push_back(c);
+      if (candidates->size() >= prune_size) prune();
+    }
+  }
+  if (candidates->size() > static_cast<size_t>(k)) prune();
+}
+
+}  // namespace
 
 template <typename T, typename Tidx>
 struct TopKFunctor<CPUDevice, T, Tidx> {
@@ -162,26 +228,12 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
     }
 
     auto SortIndices = [&](int64_t start_batch, int64_t limit_batch) {
+      std::vector<Tidx> candidates;
       for (int32_t b = start_batch; b < limit_batch; ++b) {
         const T* input_data = &input(b, 0);
-        const auto stable_comp = [input_data](const int32_t a,
-                                              const int32_t b) {
-          if (input_data[b] < input_data[a]) {
-            return true;
-          } else if (input_data[b] > input_data[a]) {
-            return false;
-          } else {
-            return a < b;
-          }
-        };
         const auto comp = [input_data](const int32_t a, const int32_t b) {
           return input_data[b] < input_data[a];
         };
-        // TODO(ebrevdo): For large k < num_cols, instead of using
-        // TopN, it may be faster to create a temporary vector of
-        // values 0..num_cols - 1 and then use std::partial_sort_copy
-        // of this into indices. Choosing the appropriate minimum k or
-        // ratio of k/num_cols will require some experimentation.
         if (k == num_cols) {
           auto* begin = &indices(b, 0);
           auto* end = &indices(b, k);
@@ -205,26 +257,14 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
             run_begin = run_end;
           }
         } else {
-          // Use the TopN heap object to sort.
-          gtl::TopN<Tidx, decltype(stable_comp)> filter(k, stable_comp);
-          filter.reserve(num_cols);
-          for (Tidx c = 0; c < num_cols; ++c) {
-            filter.push(c);
-          }
-
-          int32_t i = 0;
+          candidates.clear();
+          FilterTopK<T, Tidx>(input_data, Tidx(0), static_cast<Tidx>(num_cols),
+                              k, &candidates);
           if (sorted) {
-            std::unique_ptr<std::vector<Tidx>> top_k(filter.Extract());
-            for (auto top_k_it = top_k->begin(); top_k_it != top_k->end();
-                 ++top_k_it, ++i) {
-              indices(b, i) = *top_k_it;
-            }
-          } else {
-            for (auto top_k_it = filter.unsorted_begin();
-                 top_k_it != filter.unsorted_end(); ++top_k_it, ++i) {
-              indices(b, i) = *top_k_it;
-            }
+            std::sort(candidates.begin(), candidates.end(),
+                      ColumnCompare<T, Tidx>(input_data));
           }
+          std::copy(candidates.begin(), candidates.end(), &indices(b, 0));
         }
         // Now that the indices are sorted, copy the values over in
         // sorted order.
@@ -234,7 +274,9 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
     };
 
     // Guesstimate of cost; 4*N*log(K) where N == num_cols.
-    // If K == N, assume the cost is N*log(K + 1).
+    // If K == N, assume the cost is N*log(K + 1). The filtered path usually
+    // does far less work than this, but keeping the historical estimate
+    // preserves the sharding granularity.
     const double cmp_cost = 3 * Eigen::TensorOpCost::AddCost<Tidx>() +
                             Eigen::TensorOpCost::AddCost<T>();
     const double base_cost =
@@ -248,6 +290,56 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
                                    ? kint64max
                                    : static_cast<int64_t>(total_cost);
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+
+    // With only a handful of very wide rows (e.g. retrieval models taking the
+    // top thousand of millions of candidates per query), sharding by row
+    // leaves most threads idle. Split each such row into column chunks,
+    // filter every chunk down to its local top k in parallel, and then select
+    // the global top k from the merged candidate pools. Each pool is a
+    // superset of the row's top k restricted to its chunk, so the merged pool
+    // contains the row's top k.
+    constexpr int64_t kMinChunkCols = 16 << 10;
+    if (k != num_cols && num_rows < worker_threads.num_threads &&
+        num_cols >= 2 * kMinChunkCols) {
+      const int64_t num_chunks = std::min<int64_t>(
+          worker_threads.num_threads, num_cols / kMinChunkCols);
+      const int64_t chunk_cols = (num_cols + num_chunks - 1) / num_chunks;
+      std::vector<std::vector<Tidx>> pools(num_chunks);
+      std::vector<Tidx> merged;
+      for (int64_t b = 0; b < num_rows; ++b) {
+        const T* input_data = &input(b, 0);
+        auto FilterChunks = [&](int64_t start_chunk, int64_t limit_chunk) {
+          for (int64_t chunk = start_chunk; chunk < limit_chunk; ++chunk) {
+            pools[chunk].clear();
+            const Tidx col_begin = static_cast<Tidx>(chunk * chunk_cols);
+            const Tidx col_end = static_cast<Tidx>(
+                std::min<int64_t>(num_cols, (chunk + 1) * chunk_cols));
+            FilterTopK<T, Tidx>(input_data, col_begin, col_end, k,
+                                &pools[chunk]);
+          }
+        };
+        Shard(worker_threads.num_threads, worker_threads.workers, num_chunks,
+              static_cast<int64_t>(cmp_cost * chunk_cols), FilterChunks);
+        merged.clear();
+        for (const auto& pool : pools) {
+          merged.insert(merged.end(), pool.begin(), pool.end());
+        }
+        const ColumnCompare<T, Tidx> stable_comp(input_data);
+        if (merged.size() > static_cast<size_t>(k)) {
+          std::nth_element(merged.begin(), merged.begin() + (k - 1),
+                           merged.end(), stable_comp);
+          merged.resize(k);
+        }
+        if (sorted) {
+          std::sort(merged.begin(), merged.end(), stable_comp);
+        }
+        std::copy(merged.begin(), merged.end(), &indices(b, 0));
+        std::transform(&indices(b, 0), &indices(b, k), &values(b, 0),
+                       [b, &input](const Tidx loc) { return input(b, loc); });
+      }
+      return OkStatus();
+    }
+
     Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
           final_cost, SortIndices);
 
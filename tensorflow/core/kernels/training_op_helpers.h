@@ -44,6 +44,10 @@ namespace tensorflow {
 template <typename Device, typename T>
 Status EnsureSparseVariableAccess(OpKernelContext* ctx, Var* var,
                                   bool lock_held = false) {
+  if (var->frozen.load()) {
+    return errors::FailedPrecondition(
+        "Trying to modify a frozen variable: ", var->DebugString());
+  }
   if (var->copy_on_read_mode.load()) {
     return OkStatus();
   }
@@ -266,6 +270,10 @@ Status GetInputTensorFromVariable(OpKernelContext* ctx, int input,
   if (ctx->input_dtype(input) == DT_RESOURCE) {
     core::RefCountPtr<Var> var;
     TF_RETURN_IF_ERROR(LookupResource(ctx, HandleFromInput(ctx, input), &var));
+    if (var->frozen.load()) {
+      return errors::FailedPrecondition(
+          "Trying to modify a frozen variable: ", var->DebugString());
+    }
     if (sparse) {
       TF_RETURN_IF_ERROR(EnsureSparseVariableAccess<Device, T>(ctx, var.get()));
       *out = *var->tensor();
@@ -3654,6 +3654,121 @@ REGISTER_KERNELS(GPU, complex128);
 #undef REGISTER_CPU_KERNELS
 #undef REGISTER_KERNELS
 
+// Applies the Adam update to N variables in one kernel invocation. The
+// grappler remapper creates this op from groups of independent
+// ResourceApplyAdam nodes that share the same hyperparameter inputs, so a
+// step over many small variables pays one kernel dispatch per group instead
+// of one per variable. Each group still goes through the regular ApplyAdam
+// functor, which decides per variable whether the update is worth sharding.
+template <typename Device, typename T>
+class FusedApplyAdamOp : public OpKernel {
+ public:
+  explicit FusedApplyAdamOp(OpKernelConstruction* ctx) : OpKernel(ctx) {
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("N", &num_vars_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_locking", &use_exclusive_lock_));
+    OP_REQUIRES_OK(ctx, ctx->GetAttr("use_nesterov", &use_nesterov_));
+  }
+
+  void Compute(OpKernelContext* ctx) override {
+    const bool sparse = false;
+    std::vector<int> state_inputs;
+    state_inputs.reserve(3 * num_vars_);
+    for (int i = 0; i < 3 * num_vars_; ++i) {
+      state_inputs.push_back(i);
+    }
+    auto locks = MaybeLockVariableInputMutexesInOrder<Device, T>(
+        ctx, use_exclusive_lock_, sparse, state_inputs);
+
+    const Tensor& beta1_power = ctx->input(3 * num_vars_);
+    const Tensor& beta2_power = ctx->input(3 * num_vars_ + 1);
+    const Tensor& lr = ctx->input(3 * num_vars_ + 2);
+    const Tensor& beta1 = ctx->input(3 * num_vars_ + 3);
+    const Tensor& beta2 = ctx->input(3 * num_vars_ + 4);
+    const Tensor& epsilon = ctx->input(3 * num_vars_ + 5);
+
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1_power.shape()),
+                errors::InvalidArgument("beta1_power is not a scalar: ",
+                                        beta1_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2_power.shape()),
+                errors::InvalidArgument("beta2_power is not a scalar: ",
+                                        beta2_power.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(lr.shape()),
+                errors::InvalidArgument("lr is not a scalar : ",
+                                        lr.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta1.shape()),
+                errors::InvalidArgument("beta1 is not a scalar: ",
+                                        beta1.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(beta2.shape()),
+                errors::InvalidArgument("beta2 is not a scalar: ",
+                                        beta2.shape().DebugString()));
+    OP_REQUIRES(ctx, TensorShapeUtils::IsScalar(epsilon.shape()),
+                errors::InvalidArgument("epsilon is not a scalar: ",
+                                        epsilon.shape().DebugString()));
+
+    const Device& device = ctx->template eigen_device<Device>();
+    for (int i = 0; i < num_vars_; ++i) {
+      Tensor var;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, i, use_exclusive_lock_, sparse, &var));
+      Tensor m;
+      OP_REQUIRES_OK(ctx,
+                     GetInputTensorFromVariable<Device, T>(
+                         ctx, num_vars_ + i, use_exclusive_lock_, sparse, &m));
+      Tensor v;
+      OP_REQUIRES_OK(ctx, GetInputTensorFromVariable<Device, T>(
+                              ctx, 2 * num_vars_ + i, use_exclusive_lock_,
+                              sparse, &v));
+      OP_REQUIRES(ctx, var.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(i)));
+      OP_REQUIRES(ctx, m.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(num_vars_ + i)));
+      OP_REQUIRES(ctx, v.IsInitialized(),
+                  errors::FailedPrecondition(
+                      "Attempting to use uninitialized variables: ",
+                      requested_input(2 * num_vars_ + i)));
+
+      const Tensor& grad = ctx->input(3 * num_vars_ + 6 + i);
+      OP_REQUIRES(ctx, var.shape().IsSameSize(m.shape()),
+                  errors::InvalidArgument(
+                      "var and m do not have the same shape",
+                      var.shape().DebugString(), " ", m.shape().DebugString()));
+      OP_REQUIRES(ctx, var.shape().IsSameSize(v.shape()),
+                  errors::InvalidArgument(
+                      "var and v do not have the same shape",
+                      var.shape().DebugString(), " ", v.shape().DebugString()));
+      OP_REQUIRES(
+          ctx, var.shape().IsSameSize(grad.shape()),
+          errors::InvalidArgument("var and grad do not have the same shape",
+                                  var.shape().DebugString(), " ",
+                                  grad.shape().DebugString()));
+
+      functor::ApplyAdam<Device, T>()(
+          device, var.flat<T>(), m.flat<T>(), v.flat<T>(),
+          beta1_power.scalar<T>(), beta2_power.scalar<T>(), lr.scalar<T>(),
+          beta1.scalar<T>(), beta2.scalar<T>(), epsilon.scalar<T>(),
+          grad.flat<T>(), use_nesterov_);
+    }
+  }
+
+ private:
+  int num_vars_;
+  bool use_exclusive_lock_;
+  bool use_nesterov_;
+};
+
+#define REGISTER_KERNELS(T)                            \
+  REGISTER_KERNEL_BUILDER(Name("_FusedApplyAdam")      \
+                              .Device(DEVICE_CPU)      \
+                              .TypeConstraint<T>("T"), \
+                          FusedApplyAdamOp<CPUDevice, T>);
+
+TF_CALL_FLOAT_TYPES(REGISTER_KERNELS);
+#undef REGISTER_KERNELS
+
 template <typename Device, typename T>
 class ApplyAdamWithAmsgradOp : public OpKernel {
  public:
@@ -203,6 +203,129 @@ Status ConjugateTransposeCpuOp::DoTranspose(OpKernelContext* ctx,
                                             perm, out);
 }
 
+// y = _FusedCastTranspose(SrcT x, perm) computes Transpose(Cast(x)) in a
+// single pass over the input, so the cast intermediate is never written to
+// memory. Nodes of this type are created by the grappler remapper when a
+// Cast/Transpose pair is found; see FindCastTranspose in
+// grappler/optimizers/remapper.cc.
+template <typename SrcT, typename DstT>
+class FusedCastTransposeOp : public OpKernel {
+ public:
+  explicit FusedCastTransposeOp(OpKernelConstruction* context)
+      : OpKernel(context) {}
+
+  void Compute(OpKernelContext* ctx) override {
+    typedef Eigen::ThreadPoolDevice CPUDevice;
+    const Tensor& input = ctx->input(0);
+    const Tensor& perm = ctx->input(1);
+    OP_REQUIRES(ctx, TensorShapeUtils::IsVector(perm.shape()),
+                errors::InvalidArgument("perm must be rank 1, got shape ",
+                                        perm.shape().DebugString()));
+    std::vector<int32> permutation;
+    const int dims = input.dims();
+    if (perm.dtype() == DT_INT32) {
+      OP_REQUIRES_OK(ctx, PermutationHelper<int32>(perm, dims, &permutation));
+    } else {
+      OP_REQUIRES_OK(ctx,
+                     PermutationHelper<int64_t>(perm, dims, &permutation));
+    }
+
+    // Check whether permutation is a permutation of integers of [0 .. dims).
+    TensorShape shape;
+    gtl::InlinedVector<bool, 8> bits(dims);
+    bool is_identity = true;
+    for (int i = 0; i < dims; ++i) {
+      int32_t d = permutation[i];
+      if (d < 0) d += dims;
+      OP_REQUIRES(
+          ctx, 0 <= d && d < dims,
+          errors::InvalidArgument(d, " is out of range [0 .. ", dims, ")"));
+      permutation[i] = d;
+      bits[d] = true;
+      OP_REQUIRES_OK(ctx, shape.AddDimWithStatus(input.dim_size(d)));
+      if (d != i) {
+        is_identity = false;
+      }
+    }
+    for (int i = 0; i < dims; ++i) {
+      OP_REQUIRES(ctx, bits[i],
+                  errors::InvalidArgument(i, " is missing from {",
+                                          absl::StrJoin(permutation, ","),
+                                          "}."));
+    }
+
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(ctx, ctx->allocate_output(0, shape, &output));
+    if (shape.num_elements() == 0) return;
+    const CPUDevice& d = ctx->eigen_device<CPUDevice>();
+
+    // 0-D, 1-D and identity permutations degenerate to a plain cast.
+    if (dims <= 1 || is_identity) {
+      output->flat<DstT>().device(d) = input.flat<SrcT>().template cast<DstT>();
+      return;
+    }
+    switch (dims) {
+      case 2:
+        TransposeAndCast<2>(d, input, permutation, output);
+        break;
+      case 3:
+        TransposeAndCast<3>(d, input, permutation, output);
+        break;
+      case 4:
+        TransposeAndCast<4>(d, input, permutation, output);
+        break;
+      case 5:
+        TransposeAndCast<5>(d, input, permutation, output);
+        break;
+      case 6:
+        TransposeAndCast<6>(d, input, permutation, output);
+        break;
+      default: {
+        // Rare high-rank case: cast into a temporary, then transpose.
+        Tensor temp;
+        OP_REQUIRES_OK(ctx, ctx->allocate_temp(DataTypeToEnum<DstT>::value,
+                                               input.shape(), &temp));
+        temp.flat<DstT>().device(d) = input.flat<SrcT>().template cast<DstT>();
+        OP_REQUIRES_OK(ctx,
+                       ::tensorflow::DoTranspose(d, temp, permutation, output));
+      }
+    }
+  }
+
+ private:
+  template <int NDIMS>
+  static void TransposeAndCast(const Eigen::ThreadPoolDevice& d,
+                               const Tensor& in,
+                               const std::vector<int32>& perm, Tensor* out) {
+    Eigen::array<int, NDIMS> p;
+    for (int i = 0; i < NDIMS; ++i) p[i] = perm[i];
+    out->tensor<DstT, NDIMS>().device(d) =
+        in.tensor<SrcT, NDIMS>().shuffle(p).template cast<DstT>();
+  }
+};
+
+#define REGISTER_FUSED_CAST_TRANSPOSE(SrcT, DstT)          \
+  REGISTER_KERNEL_BUILDER(Name("_FusedCastTranspose")      \
+                              .Device(DEVICE_CPU)          \
+                              .TypeConstraint<SrcT>("SrcT") \
+                              .TypeConstraint<DstT>("DstT") \
+                              .HostMemory("perm"),         \
+                          FusedCastTransposeOp<SrcT, DstT>);
+
+REGISTER_FUSED_CAST_TRANSPOSE(float, Eigen::half)
+REGISTER_FUSED_CAST_TRANSPOSE(float, bfloat16)
+REGISTER_FUSED_CAST_TRANSPOSE(float, double)
+REGISTER_FUSED_CAST_TRANSPOSE(Eigen::half, float)
+REGISTER_FUSED_CAST_TRANSPOSE(Eigen::half, bfloat16)
+REGISTER_FUSED_CAST_TRANSPOSE(Eigen::half, double)
+REGISTER_FUSED_CAST_TRANSPOSE(bfloat16, float)
+REGISTER_FUSED_CAST_TRANSPOSE(bfloat16, Eigen::half)
+REGISTER_FUSED_CAST_TRANSPOSE(bfloat16, double)
+REGISTER_FUSED_CAST_TRANSPOSE(double, float)
+REGISTER_FUSED_CAST_TRANSPOSE(double, Eigen::half)
+REGISTER_FUSED_CAST_TRANSPOSE(double, bfloat16)
+#undef REGISTER_FUSED_CAST_TRANSPOSE
+
 #define REGISTER(T)                                   \
   REGISTER_KERNEL_BUILDER(Name("Transpose")           \
                               .Device(DEVICE_CPU)     \
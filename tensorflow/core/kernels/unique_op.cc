@@ -13,9 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -26,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 namespace {
@@ -150,26 +153,32 @@ class UniqueOp : public OpKernel {
       auto Tin = input.flat<T>();
       const int64_t N = static_cast<int64_t>(Tin.size());
 
-      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+      if (worker_threads->num_threads > 1 && N >= kMinElementsForParallel) {
+        uniq_size = ComputeParallel(context, axis, Tin, idx_vec);
+        if (!context->status().ok()) return;
+      } else {
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
         }
-      }
 
-      uniq_size = static_cast<int64_t>(uniq.size());
-      TensorShape output_shape(input.shape());
-      output_shape.set_dim(axis, uniq_size);
-      Tensor* output = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(0, output_shape, &output));
-      auto Tout = output->flat<T>();
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
 
-      for (const auto& it : uniq) {
-        Tout(it.second) = it.first;
+        for (const auto& it : uniq) {
+          Tout(it.second) = it.first;
+        }
       }
     } else {
       // General implementation when unique is run over multiple elements.
@@ -237,6 +246,112 @@ class UniqueOp : public OpKernel {
       }
     }
   }
+
+ private:
+  // Parallel implementation for large 1-D inputs. Each shard uniquifies its
+  // own contiguous block of the input into a private map, recording
+  // shard-local ids in `idx_vec`; a serial merge of the per-shard first
+  // occurrences then assigns final ids, and a second parallel pass rewrites
+  // the shard-local ids through a per-shard remapping table. No map is
+  // touched by more than one thread, and the rewriting pass performs no hash
+  // lookups. Because the merge visits shards in input order and values that
+  // first occur in a shard are visited in their local discovery order, the
+  // output lists unique elements in order of first occurrence, exactly as the
+  // serial implementation does. Returns the number of unique elements; on
+  // allocation failure the error is recorded in `context`.
+  int64_t ComputeParallel(OpKernelContext* context, int64_t axis,
+                          typename TTypes<T>::ConstFlat Tin,
+                          typename TTypes<TIndex>::Vec idx_vec) {
+    const int64_t N = static_cast<int64_t>(Tin.size());
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    const int64_t num_shards = std::min<int64_t>(
+        worker_threads->num_threads, N / kMinElementsPerShard);
+    const int64_t block = (N + num_shards - 1) / num_shards;
+
+    std::vector<typename UniqueOpHashMap<T, TIndex>::map_type> local_maps(
+        num_shards);
+    // Per shard, the input index of the first occurrence of each shard-local
+    // unique value, in order of local discovery.
+    std::vector<std::vector<int64_t>> local_first(num_shards);
+
+    auto build_local_maps = [&](int64_t shard_begin, int64_t shard_end) {
+      for (int64_t s = shard_begin; s < shard_end; ++s) {
+        const int64_t begin = s * block;
+        const int64_t end = std::min(N, begin + block);
+        auto& uniq = local_maps[s];
+        auto& first = local_first[s];
+        uniq.reserve(2 * (end - begin));
+        TIndex j = 0;
+        for (int64_t i = begin; i < end; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            first.push_back(i);
+            ++j;
+          }
+        }
+      }
+    };
+    // The cost estimate is deliberately high so that the sharder hands every
+    // shard to its own worker.
+    Shard(num_shards, worker_threads->workers, num_shards, block * 25,
+          build_local_maps);
+
+    int64_t total_local_uniques = 0;
+    for (int64_t s = 0; s < num_shards; ++s) {
+      total_local_uniques += local_first[s].size();
+    }
+    typename UniqueOpHashMap<T, TIndex>::map_type merged;
+    merged.reserve(2 * total_local_uniques);
+    // Per shard, the final id of each shard-local unique value.
+    std::vector<std::vector<TIndex>> global_id(num_shards);
+    std::vector<int64_t> first_occurrence;
+    first_occurrence.reserve(total_local_uniques);
+    TIndex next_id = 0;
+    for (int64_t s = 0; s < num_shards; ++s) {
+      global_id[s].reserve(local_first[s].size());
+      for (int64_t i : local_first[s]) {
+        auto it = merged.emplace(Tin(i), next_id);
+        global_id[s].push_back(it.first->second);
+        if (it.second) {
+          first_occurrence.push_back(i);
+          ++next_id;
+        }
+      }
+    }
+
+    auto relabel = [&](int64_t shard_begin, int64_t shard_end) {
+      for (int64_t s = shard_begin; s < shard_end; ++s) {
+        const int64_t begin = s * block;
+        const int64_t end = std::min(N, begin + block);
+        const std::vector<TIndex>& ids = global_id[s];
+        for (int64_t i = begin; i < end; ++i) {
+          idx_vec(i) = ids[idx_vec(i)];
+        }
+      }
+    };
+    Shard(num_shards, worker_threads->workers, num_shards, block * 5, relabel);
+
+    const int64_t uniq_size = static_cast<int64_t>(merged.size());
+    TensorShape output_shape(context->input(0).shape());
+    output_shape.set_dim(axis, uniq_size);
+    Tensor* output = nullptr;
+    Status status = context->allocate_output(0, output_shape, &output);
+    if (!status.ok()) {
+      context->SetStatus(status);
+      return uniq_size;
+    }
+    auto Tout = output->flat<T>();
+    for (int64_t id = 0; id < uniq_size; ++id) {
+      Tout(id) = Tin(first_occurrence[id]);
+    }
+    return uniq_size;
+  }
+
+  // Below these sizes the serial implementation wins: the parallel path pays
+  // for a second pass over `idx_vec` and a merge of the per-shard maps.
+  static constexpr int64_t kMinElementsForParallel = 1 << 16;
+  static constexpr int64_t kMinElementsPerShard = 1 << 14;
 };
 
 #define REGISTER_UNIQUE(type)                                      \
@@ -26,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/split_lib.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -95,25 +96,50 @@ class UnpackOp : public OpKernel {
     const Eigen::DenseIndex axis_dim = input_shape.dim_size(axis);
 
     // Except for shape, unpack is a special case of split, so we reuse the
-    // same computational kernels.
+    // same computational kernels, including SplitOpCPUImpl's heuristic for
+    // choosing between parallelism across outputs and within each output.
     auto input_reshaped =
         input.shaped<T, 2>({before_dim, axis_dim * after_dim});
 
-    for (int i = 0; i < num; ++i) {
-      if (!context->output_required(i)) continue;
-
-      Tensor* output;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(i, output_shape, &output));
-
-      if (output_shape.num_elements() > 0) {
-        auto output_shaped = output->shaped<T, 2>({before_dim, after_dim});
-        Eigen::DSizes<Eigen::DenseIndex, 2> indices{0, i * after_dim};
-        Eigen::DSizes<Eigen::DenseIndex, 2> sizes{before_dim, after_dim};
-        functor::Split<Device, T, 2>()(context->eigen_device<Device>(),
-                                       output_shaped, input_reshaped, indices,
-                                       sizes);
+    const auto num_threads =
+        context->device()->tensorflow_cpu_worker_threads()->num_threads;
+    const auto input_element_count = input_shape.num_elements();
+    const bool use_parallelism_between_outputs =
+        (std::is_same<Device, CPUDevice>::value && num >= 4 &&
+         input_element_count >= std::max(num_threads, num) * 4096 &&
+         input_element_count < num * 180 * 1024);
+
+    auto range_output_func = [&](int64_t start, int64_t limit) {
+      for (int64_t i = start; i < limit; ++i) {
+        if (!context->output_required(i)) continue;
+
+        Tensor* output;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(i, output_shape, &output));
+
+        if (output_shape.num_elements() > 0) {
+          auto output_shaped = output->shaped<T, 2>({before_dim, after_dim});
+          Eigen::DSizes<Eigen::DenseIndex, 2> indices{0, i * after_dim};
+          Eigen::DSizes<Eigen::DenseIndex, 2> sizes{before_dim, after_dim};
+          if (use_parallelism_between_outputs) {
+            // Use sequential implementation for single output.
+            output_shaped = input_reshaped.slice(indices, sizes);
+          } else {
+            // This implementation may be parallel internally.
+            functor::Split<Device, T, 2>()(context->eigen_device<Device>(),
+                                           output_shaped, input_reshaped,
+                                           indices, sizes);
+          }
+        }
       }
+    };
+    if (use_parallelism_between_outputs) {
+      // Run in parallel, disabling parallelism in functor.
+      context->device()->tensorflow_cpu_worker_threads()->workers->ParallelFor(
+          num, input_element_count / num, range_output_func);
+    } else {
+      // Run sequentially, but allow internal parallelism in functor.
+      range_output_func(0, num);
     }
   }
 
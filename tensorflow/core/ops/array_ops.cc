@@ -1455,6 +1455,22 @@ REGISTER_OP("Transpose")
     .Attr("Tperm: {int32, int64} = DT_INT32")
     .SetShapeFn(TransposeShapeFn);
 
+REGISTER_OP("_FusedCastTranspose")
+    .Input("x: SrcT")
+    .Input("perm: Tperm")
+    .Output("y: DstT")
+    .Attr("SrcT: {half, bfloat16, float, double}")
+    .Attr("DstT: {half, bfloat16, float, double}")
+    .Attr("Tperm: {int32, int64} = DT_INT32")
+    .SetShapeFn(TransposeShapeFn)
+    .Doc(R"doc(
+Internal operation which is a composition of a Cast and a Transpose, computed
+in a single pass over the input: reserved for internal use.
+
+Do not invoke this operator directly in Python. A fusion optimization is
+expected to create these operators.
+)doc");
+
 #ifdef INTEL_MKL
 REGISTER_OP("_MklTranspose")
     .Input("x: T")
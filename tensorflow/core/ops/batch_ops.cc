@@ -60,6 +60,13 @@ REGISTER_OP("BatchFunction")
     // NOTE: Support for `enable_large_batch_splitting == true` is still
     // developed in progress.
     .Attr("enable_large_batch_splitting: bool = false")
+    // If 'enable_ragged_batch' is true, batches are executed at their actual
+    // size instead of being padded up to the next entry in
+    // 'allowed_batch_sizes', and 'f' receives one extra int32 vector argument
+    // (after the batched arguments, before the captured ones) holding the
+    // 0th-dimension size each request contributed to the batch. 'f' must
+    // declare this argument and must accept a dynamic batch dimension.
+    .Attr("enable_ragged_batch: bool = false")
     // TODO(apassos): Fix this shape inference function. It requires shape
     // inference of function calls.
     .SetShapeFn(shape_inference::UnknownShape)
@@ -1298,6 +1298,7 @@ REGISTER_OP("MapStage")
     .Input("values: fake_dtypes")
     .Attr("capacity: int >= 0 = 0")
     .Attr("memory_limit: int >= 0 = 0")
+    .Attr("priority: int = 0")
     .Attr("dtypes: list(type)")
     .Attr("fake_dtypes: list(type)")
     .Attr("container: string = ''")
@@ -1377,6 +1378,7 @@ REGISTER_OP("OrderedMapStage")
     .Input("values: fake_dtypes")
     .Attr("capacity: int >= 0 = 0")
     .Attr("memory_limit: int >= 0 = 0")
+    .Attr("priority: int = 0")
     .Attr("dtypes: list(type)")
     .Attr("fake_dtypes: list(type)")
     .Attr("container: string = ''")
@@ -320,6 +320,48 @@ REGISTER_OP("ResizeBilinear")
     .Attr("half_pixel_centers: bool = false")
     .SetShapeFn(ResizeShapeFn);
 
+// --------------------------------------------------------------------------
+REGISTER_OP("ImagePreprocess")
+    .Input("images: T")
+    .Input("size: int32")
+    .Input("paddings: int32")
+    .Input("mean: float")
+    .Input("scale: float")
+    .Output("output: float")
+    .Attr(
+        "T: {int8, uint8, int16, uint16, int32, int64, bfloat16, half, "
+        "float, double}")
+    .Attr("align_corners: bool = false")
+    .Attr("half_pixel_centers: bool = false")
+    .Attr("pad_value: float = 0.0")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle input;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 4, &input));
+      ShapeHandle unused;
+      DimensionHandle unused_dim;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 1, &unused));
+      TF_RETURN_IF_ERROR(c->WithValue(c->Dim(unused, 0), 2, &unused_dim));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(2), 2, &unused));
+      TF_RETURN_IF_ERROR(c->WithValue(c->Dim(unused, 0), 2, &unused_dim));
+      TF_RETURN_IF_ERROR(c->WithValue(c->Dim(unused, 1), 2, &unused_dim));
+
+      DimensionHandle height = c->UnknownDim();
+      DimensionHandle width = c->UnknownDim();
+      const Tensor* size = c->input_tensor(1);
+      const Tensor* paddings = c->input_tensor(2);
+      if (size != nullptr && paddings != nullptr) {
+        auto size_vec = size->vec<int32>();
+        auto paddings_mat = paddings->matrix<int32>();
+        height =
+            c->MakeDim(size_vec(0) + paddings_mat(0, 0) + paddings_mat(0, 1));
+        width =
+            c->MakeDim(size_vec(1) + paddings_mat(1, 0) + paddings_mat(1, 1));
+      }
+      c->set_output(
+          0, c->MakeShape({c->Dim(input, 0), height, width, c->Dim(input, 3)}));
+      return OkStatus();
+    });
+
 // --------------------------------------------------------------------------
 REGISTER_OP("ScaleAndTranslate")
     .Input("images: T")
@@ -526,6 +568,50 @@ REGISTER_OP("DecodeAndCropJpeg")
       return OkStatus();
     });
 
+// --------------------------------------------------------------------------
+REGISTER_OP("DecodeAndCropJpegBatch")
+    .Input("contents: string")
+    .Input("crop_windows: int32")
+    .Attr("channels: int = 3")
+    .Attr("ratio: int = 1")
+    .Attr("fancy_upscaling: bool = true")
+    .Attr("try_recover_truncated: bool = false")
+    .Attr("acceptable_fraction: float = 1.0")
+    .Attr("dct_method: string = ''")
+    .Output("images: uint8")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle contents;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 1, &contents));
+      ShapeHandle crop_windows;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 2, &crop_windows));
+      DimensionHandle unused_dim;
+      TF_RETURN_IF_ERROR(
+          c->WithValue(c->Dim(crop_windows, 1), 4, &unused_dim));
+      DimensionHandle batch_size;
+      TF_RETURN_IF_ERROR(c->Merge(c->Dim(contents, 0), c->Dim(crop_windows, 0),
+                                  &batch_size));
+
+      int32_t channels;
+      TF_RETURN_IF_ERROR(c->GetAttr("channels", &channels));
+      if (channels != 1 && channels != 3) {
+        return errors::InvalidArgument("channels must be 1 or 3, got ",
+                                       channels);
+      }
+
+      // All crop windows are required to share a height and width, so the
+      // first window determines the spatial output dimensions.
+      DimensionHandle h = c->UnknownDim();
+      DimensionHandle w = c->UnknownDim();
+      const Tensor* crop_windows_t = c->input_tensor(1);
+      if (crop_windows_t != nullptr && crop_windows_t->dim_size(0) > 0) {
+        auto crop_windows_mat = crop_windows_t->matrix<int32>();
+        h = c->MakeDim(crop_windows_mat(0, 2));
+        w = c->MakeDim(crop_windows_mat(0, 3));
+      }
+      c->set_output(0, c->MakeShape({batch_size, h, w, c->MakeDim(channels)}));
+      return OkStatus();
+    });
+
 // --------------------------------------------------------------------------
 REGISTER_OP("EncodeJpeg")
     .Input("image: uint8")
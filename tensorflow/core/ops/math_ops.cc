@@ -1030,6 +1030,64 @@ _FusedConv2D output.
 expected to create these operators.
 )doc");
 
+REGISTER_OP("_FusedAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Input("scale: T")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .Attr("use_reciprocal_scale: bool = false")
+    .SetShapeFn([](shape_inference::InferenceContext* c) {
+      ShapeHandle query;
+      ShapeHandle value;
+      ShapeHandle output;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 2, &query));
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2), 2, &value));
+      TF_RETURN_IF_ERROR(
+          c->ReplaceDim(query, -1, c->Dim(value, -1), &output));
+      c->set_output(0, output);
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Computes softmax(scale * (query x key^T)) x value over the two innermost
+dimensions without materializing the batched attention-score tensor.
+
+`query`, `key` and `value` must have identical leading (batch) dimensions.
+`scale` is a scalar; if `use_reciprocal_scale` is true the scores are divided
+by it instead of multiplied (i.e. the pattern was scores / sqrt(d)).
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
+REGISTER_OP("_Sparse24MatMul")
+    .Input("a: T")
+    .Input("values: T")
+    .Input("metadata: uint8")
+    .Output("product: T")
+    .Attr("T: {float}")
+    .SetShapeFn([](shape_inference::InferenceContext* c) {
+      ShapeHandle a;
+      ShapeHandle values;
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(0), 2, &a));
+      TF_RETURN_IF_ERROR(c->WithRank(c->input(1), 2, &values));
+      c->set_output(0, c->Matrix(c->Dim(a, 0), c->Dim(values, 0)));
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Multiplies `a` by a weight matrix stored in packed 2:4 structured-sparse form.
+
+The dense weight is [k, n] with at most 2 non-zero values in every group of 4
+consecutive elements along the reduction (k) dimension.  `values` is [n, k/2]
+holding the two kept values of each group per output column, and `metadata` is
+[n, k/4] with one byte per group encoding the two kept in-group offsets as
+(first | second << 2).
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 // --------------------------------------------------------------------------
 
 // For operations where the output is a reduction function along some
@@ -1061,6 +1119,31 @@ REGISTER_OP("Mean")
     .Attr("Tidx: {int32, int64} = DT_INT32")
     .SetShapeFn(shape_inference::ReductionShape);
 
+REGISTER_OP("_FusedMoments")
+    .Input("input: T")
+    .Input("reduction_indices: Tidx")
+    .Output("mean: T")
+    .Output("variance: T")
+    .Attr("keep_dims: bool = false")
+    .Attr("T: {float, double}")
+    .Attr("Tidx: {int32, int64} = DT_INT32")
+    .SetShapeFn([](shape_inference::InferenceContext* c) {
+      TF_RETURN_IF_ERROR(shape_inference::ReductionShape(c));
+      c->set_output(1, c->output(0));
+      return OkStatus();
+    })
+    .Doc(R"doc(
+Computes the mean and variance of `input` along `reduction_indices` in a
+single pass over the data, as produced by the Mean + SquaredDifference + Mean
+subgraph of `tf.nn.moments`.
+
+`reduction_indices` must select a contiguous leading or trailing range of
+dimensions of `input`.
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 REGISTER_OP("Prod")
     .Input("input: T")
     .Input("reduction_indices: Tidx")
@@ -1423,6 +1506,30 @@ REGISTER_OP("UnsortedSegmentProd")
     .Attr("Tnumsegments: {int32,int64} = DT_INT32")
     .SetShapeFn(shape_inference::SegmentReductionWithNumSegmentsShapeFn);
 
+REGISTER_OP("_EmbeddingLookupSparse")
+    .Input("data: T")
+    .Input("indices: Tidx")
+    .Input("segment_ids: Tsegmentids")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .Attr("Tidx: {int32, int64} = DT_INT32")
+    .Attr("Tsegmentids: {int32, int64} = DT_INT32")
+    .Attr("combiner: {'sum', 'mean', 'sqrtn'} = 'sum'")
+    .SetShapeFn(SparseSegmentReductionShapeFn)
+    .Doc(R"doc(
+Fused embedding lookup over sparse ids.
+
+Computes the same result as a Gather of `data` rows at `indices` followed by a
+segment reduction over `segment_ids` (which must be sorted), without
+materializing the gathered intermediate. Rows are accumulated directly into
+the output and scaled according to `combiner`: 'sum' (no scaling), 'mean'
+(divide by the number of ids in the segment) or 'sqrtn' (divide by the square
+root of that count).
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
 REGISTER_OP("SparseSegmentSum")
     .Input("data: T")
     .Input("indices: Tidx")
@@ -439,4 +439,8 @@ REGISTER_OP("DisableCopyOnRead")
     .Input("resource: resource")
     .SetShapeFn(shape_inference::NoOutputs);
 
+REGISTER_OP("_FreezeVariable")
+    .Input("resource: resource")
+    .SetShapeFn(shape_inference::NoOutputs);
+
 }  // namespace tensorflow
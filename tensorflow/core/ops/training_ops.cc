@@ -826,6 +826,35 @@ REGISTER_OP("ResourceApplyAdam")
     .Attr("use_nesterov: bool = false")
     .SetShapeFn(ApplyAdamShapeFn</*is_resource=*/true>);
 
+// Counterpart of ResourceApplyAdam that updates N variables in a single
+// kernel invocation. Created by the grappler remapper when grouping
+// independent Adam updates that share the same hyperparameter inputs. Not
+// intended to be created directly; reserved for internal use.
+REGISTER_OP("_FusedApplyAdam")
+    .Input("var: N * resource")
+    .Input("m: N * resource")
+    .Input("v: N * resource")
+    .Input("beta1_power: T")
+    .Input("beta2_power: T")
+    .Input("lr: T")
+    .Input("beta1: T")
+    .Input("beta2: T")
+    .Input("epsilon: T")
+    .Input("grad: N * T")
+    .Attr("T: numbertype")
+    .Attr("N: int >= 1")
+    .Attr("use_locking: bool = false")
+    .Attr("use_nesterov: bool = false")
+    .SetShapeFn([](InferenceContext* c) {
+      int32_t n;
+      TF_RETURN_IF_ERROR(c->GetAttr("N", &n));
+      ShapeHandle unused;
+      for (int i = 0; i < 6; ++i) {
+        TF_RETURN_IF_ERROR(c->WithRank(c->input(3 * n + i), 0, &unused));
+      }
+      return OkStatus();
+    });
+
 template <bool is_resource>
 static Status ApplyAdamWithAmsgradShapeFn(InferenceContext* c) {
   ShapeHandle unused;
@@ -0,0 +1,140 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/continuous_profiler.h"
+
+#include <chrono>  // NOLINT (condition_variable::wait_for)
+#include <memory>
+#include <utility>
+
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/profiler/lib/profiler_session.h"
+#include "tensorflow/core/profiler/utils/xplane_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+
+ContinuousProfiler::ContinuousProfiler(const Options& options)
+    : options_(options) {}
+
+ContinuousProfiler::~ContinuousProfiler() { Stop(); }
+
+Status ContinuousProfiler::Start() {
+  mutex_lock lock(mu_);
+  if (thread_ != nullptr) {
+    return errors::FailedPrecondition(
+        "Continuous profiler is already running.");
+  }
+  stop_requested_ = false;
+  thread_.reset(Env::Default()->StartThread(
+      ThreadOptions(), "continuous_profiler", [this] { SamplingLoop(); }));
+  return OkStatus();
+}
+
+void ContinuousProfiler::Stop() {
+  std::unique_ptr<Thread> thread;
+  {
+    mutex_lock lock(mu_);
+    stop_requested_ = true;
+    stop_cv_.notify_all();
+    thread = std::move(thread_);
+  }
+  // Joins the sampling thread; must happen with mu_ released since the
+  // thread takes it to store its windows.
+  thread.reset();
+}
+
+bool ContinuousProfiler::IsRunning() const {
+  mutex_lock lock(mu_);
+  return thread_ != nullptr;
+}
+
+bool ContinuousProfiler::WaitForStop(int64_t ms) {
+  mutex_lock lock(mu_);
+  if (!stop_requested_ && ms > 0) {
+    stop_cv_.wait_for(lock, std::chrono::milliseconds(ms));
+  }
+  return stop_requested_;
+}
+
+void ContinuousProfiler::SamplingLoop() {
+  while (true) {
+    SampleOneWindow();
+    if (WaitForStop(options_.window_duration_ms - options_.trace_duration_ms)) {
+      return;
+    }
+  }
+}
+
+void ContinuousProfiler::SampleOneWindow() {
+  auto profile_options = ProfilerSession::DefaultOptions();
+  profile_options.set_host_tracer_level(options_.host_tracer_level);
+  profile_options.set_device_tracer_level(0);
+  profile_options.set_python_tracer_level(0);
+  profile_options.set_enable_hlo_proto(false);
+  std::unique_ptr<ProfilerSession> session =
+      ProfilerSession::Create(profile_options);
+  if (!session->Status().ok()) {
+    // Another profiler owns the profiler lock, e.g. an on-demand profile.
+    // Back off for this window instead of queueing behind it.
+    mutex_lock lock(mu_);
+    ++skipped_windows_;
+    return;
+  }
+  // Let the traced slice of the window record. A stop request only shortens
+  // the slice; whatever was recorded is still collected below.
+  WaitForStop(options_.trace_duration_ms);
+  XSpace space;
+  Status status = session->CollectData(&space);
+  session.reset();
+
+  mutex_lock lock(mu_);
+  if (!status.ok()) {
+    ++skipped_windows_;
+    return;
+  }
+  windows_.push_back(std::move(space));
+  while (windows_.size() > static_cast<size_t>(options_.max_windows)) {
+    windows_.pop_front();
+  }
+}
+
+Status ContinuousProfiler::FlushToXSpace(XSpace* space) const {
+  mutex_lock lock(mu_);
+  for (const XSpace& window : windows_) {
+    for (const XPlane& plane : window.planes()) {
+      MergePlanes(plane, FindOrAddMutablePlaneWithName(space, plane.name()));
+    }
+    for (const auto& error : window.errors()) {
+      *space->add_errors() = error;
+    }
+    for (const auto& warning : window.warnings()) {
+      *space->add_warnings() = warning;
+    }
+  }
+  return OkStatus();
+}
+
+int64_t ContinuousProfiler::num_windows() const {
+  mutex_lock lock(mu_);
+  return windows_.size();
+}
+
+int64_t ContinuousProfiler::num_skipped_windows() const {
+  mutex_lock lock(mu_);
+  return skipped_windows_;
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
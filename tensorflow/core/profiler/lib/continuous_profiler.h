@@ -0,0 +1,105 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
+#define TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+
+namespace tensorflow {
+namespace profiler {
+
+// An always-on, low-overhead sampling profiler ("flight recorder").
+//
+// A background thread repeatedly traces a short slice of every sampling
+// window with the host tracer (whose TraceMe events already land in
+// per-thread lock-free buffers) and retains the resulting XSpaces in a
+// bounded ring. With the default duty cycle of 10ms traced per 1s window,
+// tracing is off more than 99% of the time, so the profiler can stay enabled
+// in production; after a latency incident, FlushToXSpace returns the
+// retained history (the last 60s by default) in the standard XSpace format
+// consumed by the existing profiler tooling.
+//
+// The profiler cooperates with on-demand profiling: windows during which
+// another ProfilerSession holds the profiler lock are skipped, not queued.
+// Thread-safety: all methods may be called from any thread.
+class ContinuousProfiler {
+ public:
+  struct Options {
+    // Length of one sampling window.
+    int64_t window_duration_ms = 1000;
+    // Traced portion at the start of each window. The ratio of this to
+    // `window_duration_ms` is the tracing duty cycle, and thereby the upper
+    // bound on the steady-state overhead.
+    int64_t trace_duration_ms = 10;
+    // Number of most recent windows retained in the ring.
+    int64_t max_windows = 60;
+    // Host tracer verbosity for the sampled slices (TraceMe level). The
+    // default records only the most important events (kCritical).
+    int32_t host_tracer_level = 1;
+  };
+
+  explicit ContinuousProfiler(const Options& options);
+
+  // Stops sampling; retained windows are discarded with the object.
+  ~ContinuousProfiler();
+
+  // Starts the background sampling thread. Returns FailedPrecondition if
+  // sampling is already running.
+  Status Start();
+
+  // Stops the background sampling thread, keeping the retained windows so
+  // they can still be flushed. No-op if not running.
+  void Stop();
+
+  bool IsRunning() const;
+
+  // Merges the retained windows into `space`, oldest first, combining planes
+  // with the same name so the result looks like one discontinuous trace.
+  // Event timestamps are absolute, so the gaps between windows survive the
+  // merge. May be called while sampling is running.
+  Status FlushToXSpace(XSpace* space) const;
+
+  // Observability for monitoring and tests.
+  int64_t num_windows() const;
+  int64_t num_skipped_windows() const;
+
+ private:
+  void SamplingLoop();
+  void SampleOneWindow();
+  // Blocks for up to `ms` milliseconds; returns true if a stop was requested.
+  bool WaitForStop(int64_t ms);
+
+  const Options options_;
+
+  mutable mutex mu_;
+  condition_variable stop_cv_;
+  bool stop_requested_ TF_GUARDED_BY(mu_) = false;
+  std::deque<XSpace> windows_ TF_GUARDED_BY(mu_);
+  int64_t skipped_windows_ TF_GUARDED_BY(mu_) = 0;
+  std::unique_ptr<Thread> thread_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_LIB_CONTINUOUS_PROFILER_H_
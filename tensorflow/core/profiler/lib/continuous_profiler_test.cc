@@ -0,0 +1,92 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/continuous_profiler.h"
+
+#include <set>
+#include <string>
+
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/profiler/protobuf/xplane.pb.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+ContinuousProfiler::Options FastOptions() {
+  ContinuousProfiler::Options options;
+  options.window_duration_ms = 20;
+  options.trace_duration_ms = 5;
+  options.max_windows = 3;
+  return options;
+}
+
+TEST(ContinuousProfilerTest, StartStop) {
+  ContinuousProfiler profiler(FastOptions());
+  EXPECT_FALSE(profiler.IsRunning());
+  TF_ASSERT_OK(profiler.Start());
+  EXPECT_TRUE(profiler.IsRunning());
+  // A second Start while running is rejected.
+  EXPECT_FALSE(profiler.Start().ok());
+  profiler.Stop();
+  EXPECT_FALSE(profiler.IsRunning());
+  // Restarting after Stop is allowed.
+  TF_ASSERT_OK(profiler.Start());
+  profiler.Stop();
+}
+
+TEST(ContinuousProfilerTest, RetainsBoundedWindowHistory) {
+  ContinuousProfiler profiler(FastOptions());
+  TF_ASSERT_OK(profiler.Start());
+  // Run long enough for well over max_windows windows, emitting TraceMe
+  // events so the traced slices have something to record.
+  for (int i = 0; i < 40; ++i) {
+    TraceMe trace("continuous_profiler_test_event");
+    Env::Default()->SleepForMicroseconds(5 * 1000);
+  }
+  profiler.Stop();
+  EXPECT_GT(profiler.num_windows(), 0);
+  EXPECT_LE(profiler.num_windows(), FastOptions().max_windows);
+}
+
+TEST(ContinuousProfilerTest, FlushMergesPlanesByName) {
+  ContinuousProfiler profiler(FastOptions());
+  TF_ASSERT_OK(profiler.Start());
+  for (int i = 0; i < 40; ++i) {
+    TraceMe trace("continuous_profiler_test_event");
+    Env::Default()->SleepForMicroseconds(5 * 1000);
+  }
+  profiler.Stop();
+
+  XSpace space;
+  TF_ASSERT_OK(profiler.FlushToXSpace(&space));
+  // Windows are merged per plane, so plane names are unique even though
+  // several windows were retained.
+  std::set<std::string> plane_names;
+  for (const XPlane& plane : space.planes()) {
+    EXPECT_TRUE(plane_names.insert(plane.name()).second)
+        << "duplicate plane " << plane.name();
+  }
+  // Flushing is non-destructive and can be repeated.
+  XSpace space2;
+  TF_ASSERT_OK(profiler.FlushToXSpace(&space2));
+  EXPECT_EQ(space.planes_size(), space2.planes_size());
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
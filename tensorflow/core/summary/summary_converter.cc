@@ -214,21 +214,56 @@ Status AddTensorAsScalarToSummary(const Tensor& t, const string& tag,
   return OkStatus();
 }
 
-Status AddTensorAsHistogramToSummary(const Tensor& t, const string& tag,
-                                     Summary* s) {
-  Summary::Value* v = s->add_value();
-  v->set_tag(tag);
-  histogram::Histogram histo;
-  for (int64_t i = 0; i < t.NumElements(); i++) {
-    double double_val;
-    TF_RETURN_IF_ERROR(TensorValueAt<double>(t, i, &double_val));
+namespace {
+
+// Streams a flat float/double buffer into `histo` without the per-element
+// dtype dispatch (and Tensor copy) of TensorValueAt, which dominates the cost
+// of histogramming large tensors.
+template <typename T>
+Status AddFlatTensorToHistogram(const Tensor& t, const string& tag,
+                                histogram::Histogram* histo) {
+  const T* data = t.flat<T>().data();
+  const int64_t n = t.NumElements();
+  for (int64_t i = 0; i < n; i++) {
+    const double double_val = static_cast<double>(data[i]);
     if (Eigen::numext::isnan(double_val)) {
       return errors::InvalidArgument("Nan in summary histogram for: ", tag);
     } else if (Eigen::numext::isinf(double_val)) {
       return errors::InvalidArgument("Infinity in summary histogram for: ",
                                      tag);
     }
-    histo.Add(double_val);
+    histo->Add(double_val);
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status AddTensorAsHistogramToSummary(const Tensor& t, const string& tag,
+                                     Summary* s) {
+  Summary::Value* v = s->add_value();
+  v->set_tag(tag);
+  histogram::Histogram histo;
+  switch (t.dtype()) {
+    case DT_FLOAT:
+      TF_RETURN_IF_ERROR(AddFlatTensorToHistogram<float>(t, tag, &histo));
+      break;
+    case DT_DOUBLE:
+      TF_RETURN_IF_ERROR(AddFlatTensorToHistogram<double>(t, tag, &histo));
+      break;
+    default:
+      for (int64_t i = 0; i < t.NumElements(); i++) {
+        double double_val;
+        TF_RETURN_IF_ERROR(TensorValueAt<double>(t, i, &double_val));
+        if (Eigen::numext::isnan(double_val)) {
+          return errors::InvalidArgument("Nan in summary histogram for: ",
+                                         tag);
+        } else if (Eigen::numext::isinf(double_val)) {
+          return errors::InvalidArgument("Infinity in summary histogram for: ",
+                                         tag);
+        }
+        histo.Add(double_val);
+      }
   }
   histo.EncodeToProto(v->mutable_histo(), false /* Drop zero buckets */);
   return OkStatus();
@@ -15,6 +15,8 @@ limitations under the License.
 #include "tensorflow/core/summary/summary_file_writer.h"
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -24,12 +26,30 @@ limitations under the License.
 #include "tensorflow/core/framework/summary.pb.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/summary/summary_converter.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/events_writer.h"
 
 namespace tensorflow {
 namespace {
 
+// When TF_SUMMARY_ASYNC_WRITES=true, event serialization and file writes are
+// moved off the thread calling Write*() onto a per-writer background thread,
+// and histograms are computed on that thread as well. Flush() still drains
+// everything before returning, so readers observe the same files.
+bool AsyncWritesEnabled() {
+  static const bool enabled = []() {
+    bool value = false;
+    Status s = ReadBoolFromEnvVar("TF_SUMMARY_ASYNC_WRITES", false, &value);
+    if (!s.ok()) {
+      LOG(ERROR) << "Failed to read TF_SUMMARY_ASYNC_WRITES: " << s;
+    }
+    return value;
+  }();
+  return enabled;
+}
+
 class SummaryFileWriter : public SummaryWriterInterface {
  public:
   SummaryFileWriter(int max_queue, int flush_millis, Env* env)
@@ -37,7 +57,8 @@ class SummaryFileWriter : public SummaryWriterInterface {
         is_initialized_(false),
         max_queue_(max_queue),
         flush_millis_(flush_millis),
-        env_(env) {}
+        env_(env),
+        async_writes_(AsyncWritesEnabled()) {}
 
   Status Initialize(const string& logdir, const string& filename_suffix) {
     const Status is_dir = env_->IsDirectory(logdir);
@@ -63,6 +84,10 @@ class SummaryFileWriter : public SummaryWriterInterface {
         "Could not initialize events writer.");
     last_flush_ = env_->NowMicros();
     is_initialized_ = true;
+    if (async_writes_) {
+      writer_thread_.reset(env_->StartThread(
+          ThreadOptions(), "summary_writer", [this]() { BackgroundLoop(); }));
+    }
     return OkStatus();
   }
 
@@ -71,11 +96,28 @@ class SummaryFileWriter : public SummaryWriterInterface {
     if (!is_initialized_) {
       return errors::FailedPrecondition("Class was not properly initialized.");
     }
+    if (async_writes_) {
+      // Drain the background thread before touching the file ourselves.
+      flush_requested_ = true;
+      work_cv_.notify_one();
+      while (!queue_.empty() || writing_) {
+        drained_cv_.wait(ml);
+      }
+      Status deferred = deferred_status_;
+      deferred_status_ = OkStatus();
+      TF_RETURN_IF_ERROR(deferred);
+    }
     return InternalFlush();
   }
 
   ~SummaryFileWriter() override {
     (void)Flush();  // Ignore errors.
+    {
+      mutex_lock ml(mu_);
+      shutdown_ = true;
+      work_cv_.notify_one();
+    }
+    writer_thread_.reset();  // Joins the background thread, if any.
   }
 
   Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
@@ -113,6 +155,17 @@ class SummaryFileWriter : public SummaryWriterInterface {
 
   Status WriteHistogram(int64_t global_step, Tensor t,
                         const string& tag) override {
+    if (async_writes_) {
+      // Defer the O(N) pass over the tensor to the background thread; the
+      // Tensor is refcounted so the enqueue itself is cheap.
+      QueueEntry entry;
+      entry.is_histogram = true;
+      entry.step = global_step;
+      entry.wall_time = GetWallTime();
+      entry.histo_tensor = std::move(t);
+      entry.histo_tag = tag;
+      return EnqueueEntry(std::move(entry));
+    }
     std::unique_ptr<Event> e{new Event};
     e->set_step(global_step);
     e->set_wall_time(GetWallTime());
@@ -151,44 +204,138 @@ class SummaryFileWriter : public SummaryWriterInterface {
   }
 
   Status WriteEvent(std::unique_ptr<Event> event) override {
+    QueueEntry entry;
+    entry.event = std::move(event);
+    return EnqueueEntry(std::move(entry));
+  }
+
+  string DebugString() const override { return "SummaryFileWriter"; }
+
+ private:
+  // A queued unit of work: either an already-built Event, or a histogram
+  // request whose Event is materialized right before it is written.
+  struct QueueEntry {
+    std::unique_ptr<Event> event;
+    bool is_histogram = false;
+    int64_t step = 0;
+    double wall_time = 0;
+    Tensor histo_tensor;
+    string histo_tag;
+  };
+
+  double GetWallTime() {
+    return static_cast<double>(env_->NowMicros()) / 1.0e6;
+  }
+
+  Status EnqueueEntry(QueueEntry entry) {
     mutex_lock ml(mu_);
-    queue_.emplace_back(std::move(event));
+    queue_.push_back(std::move(entry));
     if (queue_.size() > max_queue_ ||
         env_->NowMicros() - last_flush_ > 1000 * flush_millis_) {
+      if (async_writes_) {
+        flush_requested_ = true;
+        work_cv_.notify_one();
+        return OkStatus();
+      }
       return InternalFlush();
     }
     return OkStatus();
   }
 
-  string DebugString() const override { return "SummaryFileWriter"; }
-
- private:
-  double GetWallTime() {
-    return static_cast<double>(env_->NowMicros()) / 1.0e6;
+  Status MaterializeEvent(QueueEntry* entry, std::unique_ptr<Event>* out) {
+    if (!entry->is_histogram) {
+      *out = std::move(entry->event);
+      return OkStatus();
+    }
+    std::unique_ptr<Event> e{new Event};
+    e->set_step(entry->step);
+    e->set_wall_time(entry->wall_time);
+    TF_RETURN_IF_ERROR(AddTensorAsHistogramToSummary(
+        entry->histo_tensor, entry->histo_tag, e->mutable_summary()));
+    *out = std::move(e);
+    return OkStatus();
   }
 
-  Status InternalFlush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    for (const std::unique_ptr<Event>& e : queue_) {
-      events_writer_->WriteEvent(*e);
+  // Writes and flushes a batch of entries. Touches events_writer_, so the
+  // caller must either hold mu_ with the background thread idle, or be the
+  // background thread itself (which has exclusive use of events_writer_
+  // while writing_ is set).
+  Status WriteBatch(std::vector<QueueEntry>* batch) {
+    Status status;
+    for (QueueEntry& entry : *batch) {
+      std::unique_ptr<Event> e;
+      const Status s = MaterializeEvent(&entry, &e);
+      if (s.ok()) {
+        events_writer_->WriteEvent(*e);
+      } else {
+        status.Update(s);
+      }
     }
-    queue_.clear();
+    batch->clear();
     TF_RETURN_WITH_CONTEXT_IF_ERROR(events_writer_->Flush(),
                                     "Could not flush events file.");
+    return status;
+  }
+
+  // Body of writer_thread_. Swaps the queue out under mu_ and writes the
+  // batch with the lock released, so Write*() calls only pay for an enqueue.
+  void BackgroundLoop() {
+    while (true) {
+      std::vector<QueueEntry> batch;
+      {
+        mutex_lock ml(mu_);
+        while (!shutdown_ && !flush_requested_) {
+          work_cv_.wait(ml);
+        }
+        if (shutdown_ && queue_.empty()) {
+          drained_cv_.notify_all();
+          return;
+        }
+        flush_requested_ = false;
+        queue_.swap(batch);
+        writing_ = true;
+      }
+      const Status s = WriteBatch(&batch);
+      {
+        mutex_lock ml(mu_);
+        if (!s.ok() && deferred_status_.ok()) {
+          deferred_status_ = s;
+        }
+        last_flush_ = env_->NowMicros();
+        writing_ = false;
+        drained_cv_.notify_all();
+      }
+    }
+  }
+
+  Status InternalFlush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    const Status s = WriteBatch(&queue_);
     last_flush_ = env_->NowMicros();
-    return OkStatus();
+    return s;
   }
 
   bool is_initialized_;
-  const int max_queue_;
+  const size_t max_queue_;
   const int flush_millis_;
   uint64 last_flush_;
   Env* env_;
+  const bool async_writes_;
   mutex mu_;
-  std::vector<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
-  // A pointer to allow deferred construction.
-  std::unique_ptr<EventsWriter> events_writer_ TF_GUARDED_BY(mu_);
+  condition_variable work_cv_;
+  condition_variable drained_cv_;
+  bool flush_requested_ TF_GUARDED_BY(mu_) = false;
+  bool writing_ TF_GUARDED_BY(mu_) = false;
+  bool shutdown_ TF_GUARDED_BY(mu_) = false;
+  Status deferred_status_ TF_GUARDED_BY(mu_);
+  std::vector<QueueEntry> queue_ TF_GUARDED_BY(mu_);
+  // A pointer to allow deferred construction. See WriteBatch for the access
+  // discipline shared with the background thread.
+  std::unique_ptr<EventsWriter> events_writer_;
   std::vector<std::pair<string, SummaryMetadata>> registered_summaries_
       TF_GUARDED_BY(mu_);
+  // Joined on destruction; must outlive nothing it touches, so it is
+  // declared last.
+  std::unique_ptr<Thread> writer_thread_;
 };
 
 }  // namespace
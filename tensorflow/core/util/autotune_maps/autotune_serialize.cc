@@ -16,6 +16,7 @@ limitations under the License.
 // For Google-internal use only.
 #include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 
+#include <cstdlib>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -24,6 +25,8 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/stream_executor/dnn.h"
 #include "xla/stream_executor/gpu/gpu_init.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/str_util.h"
 #include "tensorflow/core/util/activation_mode.h"
 #include "tensorflow/core/util/autotune_maps/autotune_map.pb.h"
@@ -169,6 +172,31 @@ Status PopulateConvMap(
   return OkStatus();
 }
 
+// Returns the DNN library (cuDNN/MIOpen) version of the first visible GPU
+// device, which versions the on-disk autotune cache.
+StatusOr<stream_executor::dnn::VersionInfo> GetDnnVersion() {
+  TF_ASSIGN_OR_RETURN(
+      se::Platform * platform,
+      se::MultiPlatformManager::PlatformWithName(se::GpuPlatformName()));
+  if (platform->VisibleDeviceCount() < 1) {
+    return errors::NotFound("No visible GPU devices.");
+  }
+  TF_ASSIGN_OR_RETURN(se::StreamExecutor * executor,
+                      platform->ExecutorForDevice(0));
+  auto *dnn = executor->AsDnn();
+  if (dnn == nullptr) {
+    return errors::NotFound("No DNN support for device 0.");
+  }
+  return dnn->GetVersion();
+}
+
+// Serializes writes to the cache file within this process; cross-process
+// safety comes from the write-to-temporary-then-rename protocol.
+mutex *GetAutotuneCacheFileMutex() {
+  static mutex *mu = new mutex;
+  return mu;
+}
+
 }  // namespace
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
@@ -203,6 +231,109 @@ Status LoadSerializedAutotuneMaps(absl::string_view s) {
   return OkStatus();
 }
 
+Status SaveAutotuneMapsToFile(const std::string &file_path) {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  mutex_lock lock(*GetAutotuneCacheFileMutex());
+  AutotuneCacheFileProto cache_proto;
+  TF_ASSIGN_OR_RETURN(stream_executor::dnn::VersionInfo dnn_version,
+                      GetDnnVersion());
+  *cache_proto.mutable_dnn_version() = dnn_version.ToProto();
+  TF_ASSIGN_OR_RETURN(*cache_proto.mutable_maps()->mutable_conv_map(),
+                      ConvMapToProto(*ConvAutotuneMap::GetInstance()));
+  TF_ASSIGN_OR_RETURN(*cache_proto.mutable_maps()->mutable_fused_conv_map(),
+                      ConvMapToProto(*FusedConvAutotuneMap::GetInstance()));
+
+  std::string serialized;
+  TF_RET_CHECK(tsl::SerializeToStringDeterministic(cache_proto, &serialized));
+
+  // Write to a temporary file and rename it into place so that concurrent
+  // readers (and other processes pointed at the same cache) never observe a
+  // partially written file.
+  Env *env = Env::Default();
+  const std::string tmp_path = file_path + ".tmp";
+  TF_RETURN_IF_ERROR(WriteStringToFile(env, tmp_path, serialized));
+  return env->RenameFile(tmp_path, file_path);
+#else
+  return errors::Unimplemented(
+      "SaveAutotuneMapsToFile is only supported on GPU builds.");
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+Status LoadAutotuneMapsFromFile(const std::string &file_path) {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  std::string serialized;
+  TF_RETURN_IF_ERROR(ReadFileToString(Env::Default(), file_path, &serialized));
+  AutotuneCacheFileProto cache_proto;
+  if (!cache_proto.ParseFromString(serialized)) {
+    return errors::InvalidArgument("Failed to parse the autotune cache file: ",
+                                   file_path);
+  }
+
+  // Autotune results are not transferable across DNN library versions:
+  // algorithm ids and their relative performance both change between
+  // releases. Reject the whole file and let the runtime re-autotune.
+  TF_ASSIGN_OR_RETURN(stream_executor::dnn::VersionInfo dnn_version,
+                      GetDnnVersion());
+  const auto &cached_version = cache_proto.dnn_version();
+  if (cached_version.major() != dnn_version.major_version() ||
+      cached_version.minor() != dnn_version.minor_version() ||
+      cached_version.patch() != dnn_version.patch()) {
+    return errors::Aborted(
+        "Aborted because the autotune cache file was written under DNN "
+        "library version ",
+        cached_version.major(), ".", cached_version.minor(), ".",
+        cached_version.patch(), " but the runtime version is ",
+        dnn_version.major_version(), ".", dnn_version.minor_version(), ".",
+        dnn_version.patch());
+  }
+
+  TF_RETURN_IF_ERROR(PopulateConvMap(cache_proto.maps().conv_map(),
+                                     ConvAutotuneMap::GetInstance()));
+  TF_RETURN_IF_ERROR(PopulateConvMap(cache_proto.maps().fused_conv_map(),
+                                     FusedConvAutotuneMap::GetInstance()));
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  return OkStatus();
+}
+
+void LoadAutotuneMapsFromCacheFileOnce() {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  static const bool loaded = [] {
+    const char *file_path = std::getenv("TF_AUTOTUNE_CACHE_FILE");
+    if (file_path == nullptr) {
+      return false;
+    }
+    Status s = LoadAutotuneMapsFromFile(file_path);
+    if (s.ok()) {
+      LOG(INFO) << "Loaded autotune maps from " << file_path;
+    } else if (errors::IsNotFound(s)) {
+      // A missing file is expected on the first run of a deployment; the
+      // cache will be written once autotuning produces results.
+      VLOG(1) << "Autotune cache file " << file_path
+              << " not found; starting with empty autotune maps.";
+    } else {
+      LOG(WARNING) << "Failed to load autotune maps from " << file_path << ": "
+                   << s;
+    }
+    return s.ok();
+  }();
+  (void)loaded;
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
+void SaveAutotuneMapsToCacheFile() {
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  const char *file_path = std::getenv("TF_AUTOTUNE_CACHE_FILE");
+  if (file_path == nullptr) {
+    return;
+  }
+  Status s = SaveAutotuneMapsToFile(file_path);
+  if (!s.ok()) {
+    LOG(WARNING) << "Failed to save autotune maps to " << file_path << ": "
+                 << s;
+  }
+#endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+}
+
 void ResetAutotuneMaps() {
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
   ConvAutotuneMap::GetInstance()->ClearMap();
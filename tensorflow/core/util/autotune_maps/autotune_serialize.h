@@ -40,6 +40,31 @@ Status LoadSerializedAutotuneMaps(absl::string_view s);
 // LoadSerializedAutotuneMaps.
 Status SerializeAutotuneMaps(std::string* output);
 
+// Serializes all the autotune maps into `file_path`, wrapped in a versioned
+// envelope recording the DNN library version. The file is written to a
+// temporary name and renamed into place, so readers never observe a partially
+// written cache.
+Status SaveAutotuneMapsToFile(const std::string& file_path);
+
+// Loads autotune maps from a file written by SaveAutotuneMapsToFile and uses
+// them to update the runtime autotune maps. Returns an error if the file was
+// written under a different DNN library version; entries whose GPU model or
+// ConvParameters version do not match the runtime are skipped or rejected as
+// in LoadSerializedAutotuneMaps.
+Status LoadAutotuneMapsFromFile(const std::string& file_path);
+
+// If TF_AUTOTUNE_CACHE_FILE is set, loads the autotune maps from that file
+// the first time this is called; later calls are no-ops. A missing file (e.g.
+// the first run of a deployment) is not an error. Intended to be called from
+// the autotune paths before the first cache lookup.
+void LoadAutotuneMapsFromCacheFileOnce();
+
+// If TF_AUTOTUNE_CACHE_FILE is set, re-serializes the autotune maps to that
+// file; logs and swallows failures. Intended to be called after autotuning
+// inserts a new result, so freshly tuned convolutions are persisted for the
+// next process.
+void SaveAutotuneMapsToCacheFile();
+
 // Resets all autotune maps. For test use only.
 void ResetAutotuneMaps();
 
@@ -19,8 +19,11 @@ limitations under the License.
 #include "tensorflow/core/util/autotune_maps/autotune_serialize.h"
 #include "xla/stream_executor/gpu/gpu_driver.h"
 #include "xla/stream_executor/gpu/gpu_init.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/autotune_maps/autotune_map.pb.h"
 #include "tensorflow/core/util/autotune_maps/conv_autotune_maps.h"
 #include "tensorflow/core/util/autotune_maps/conv_parameters.h"
 #include "tensorflow/core/util/autotune_maps/conv_parameters.pb.h"
@@ -180,6 +183,71 @@ TEST(AutotuneSerializeTest, VersionControl) {
                HasSubstr("Aborted because the loaded autotune results")));
   EXPECT_EQ(ConvAutotuneMap::GetInstance()->GetMap().size(), 0);
 }
+
+// Tests that the autotune maps survive a round trip through the on-disk cache
+// file written by SaveAutotuneMapsToFile.
+TEST(AutotuneSerializeTest, FileRoundTrip) {
+  TF_CHECK_OK(GpuDriver::Init());
+  ResetAutotuneMaps();
+  ConvParameters conv_params_example_a = {
+      GetStreamExec(),
+      /*batch=*/1,
+      /*in_depths=*/1,
+      /*in=*/{{1, 1}},
+      /*data_format=*/TensorFormat::FORMAT_NCHW,
+      /*out_depths=*/1,
+      /*filter=*/{{1, 1}},
+      /*dilation=*/{{1, 1}},
+      /*stride=*/{{1, 1}},
+      /*padding=*/{{1, 1}},
+      /*dtype=*/DataType::DT_INT8,
+      /*group_count=*/1};
+
+  AlgorithmDesc algorithm(/*algo_id=*/1, /*use_tensor_ops=*/true);
+  AlgorithmDesc algorithm_no_scratch(/*algo_id=*/1, /*use_tensor_ops=*/true);
+  AutotuneEntry<se::dnn::ConvOp> example_a(algorithm, algorithm_no_scratch);
+  ConvAutotuneMap::GetInstance()->Insert(conv_params_example_a, example_a);
+
+  const std::string file_path =
+      io::JoinPath(testing::TmpDir(), "autotune_cache_file");
+  TF_CHECK_OK(SaveAutotuneMapsToFile(file_path));
+
+  ResetAutotuneMaps();
+  TF_CHECK_OK(LoadAutotuneMapsFromFile(file_path));
+  EXPECT_EQ(ConvAutotuneMap::GetInstance()->GetMap().size(), 1);
+
+  AutotuneEntry<se::dnn::ConvOp> entry;
+  EXPECT_TRUE(
+      ConvAutotuneMap::GetInstance()->Find(conv_params_example_a, &entry));
+  EXPECT_EQ(entry, example_a);
+}
+
+// Tests that a cache file recording a different DNN library version is
+// rejected wholesale.
+TEST(AutotuneSerializeTest, FileDnnVersionMismatch) {
+  TF_CHECK_OK(GpuDriver::Init());
+  ResetAutotuneMaps();
+
+  const std::string file_path =
+      io::JoinPath(testing::TmpDir(), "autotune_cache_file_stale");
+  TF_CHECK_OK(SaveAutotuneMapsToFile(file_path));
+
+  // Rewrite the file with a bumped major version to simulate a cache written
+  // under a different DNN library release.
+  std::string serialized;
+  TF_CHECK_OK(ReadFileToString(Env::Default(), file_path, &serialized));
+  AutotuneCacheFileProto cache_proto;
+  ASSERT_TRUE(cache_proto.ParseFromString(serialized));
+  cache_proto.mutable_dnn_version()->set_major(
+      cache_proto.dnn_version().major() + 1);
+  TF_CHECK_OK(WriteStringToFile(Env::Default(), file_path,
+                                cache_proto.SerializeAsString()));
+
+  EXPECT_THAT(LoadAutotuneMapsFromFile(file_path),
+              StatusIs(error::ABORTED,
+                       HasSubstr("written under DNN library version")));
+  EXPECT_EQ(ConvAutotuneMap::GetInstance()->GetMap().size(), 0);
+}
 }  // namespace
 }  // namespace tensorflow
 #endif  // GOOGLE_CUDA || TENSORFLOW_USE_ROCM
@@ -415,8 +415,17 @@ bool ParseFeatureMapEntry(protobuf::io::CodedInputStream* stream,
   return true;
 }
 
+// A FeatureFilter decides, from its name alone, whether a feature entry is
+// appended to the parsed::Example. Entries rejected by the filter are dropped
+// right after their bytes have been scanned, so unwanted features never
+// occupy a slot in the output vector.
+struct AcceptAllFeatures {
+  bool operator()(StringPiece) const { return true; }
+};
+
+template <typename FeatureFilter>
 bool ParseFeatures(protobuf::io::CodedInputStream* stream,
-                   parsed::Example* example) {
+                   const FeatureFilter& filter, parsed::Example* example) {
   DCHECK(stream != nullptr);
   DCHECK(example != nullptr);
   uint32 length;
@@ -426,14 +435,16 @@ bool ParseFeatures(protobuf::io::CodedInputStream* stream,
     parsed::FeatureMapEntry feature_map_entry;
     if (!stream->ExpectTag(kDelimitedTag(1))) return false;
     if (!ParseFeatureMapEntry(stream, &feature_map_entry)) return false;
+    if (!filter(feature_map_entry.first)) continue;
     example->push_back(std::move(feature_map_entry));
   }
   stream->PopLimit(limit);
   return true;
 }
 
+template <typename FeatureFilter>
 bool ParseExample(protobuf::io::CodedInputStream* stream,
-                  parsed::Example* example) {
+                  const FeatureFilter& filter, parsed::Example* example) {
   DCHECK(stream != nullptr);
   DCHECK(example != nullptr);
   // Loop over the input stream which may contain multiple serialized Example
@@ -443,18 +454,24 @@ bool ParseExample(protobuf::io::CodedInputStream* stream,
     if (!stream->ExpectTag(kDelimitedTag(1))) {
       if (!SkipExtraneousTag(stream)) return false;
     } else {
-      if (!ParseFeatures(stream, example)) return false;
+      if (!ParseFeatures(stream, filter, example)) return false;
     }
   }
   return true;
 }
 
-bool ParseExample(StringPiece serialized, parsed::Example* example) {
+template <typename FeatureFilter>
+bool ParseExample(StringPiece serialized, const FeatureFilter& filter,
+                  parsed::Example* example) {
   DCHECK(example != nullptr);
   protobuf::io::CodedInputStream stream(
       reinterpret_cast<const uint8*>(serialized.data()), serialized.size());
   EnableAliasing(&stream);
-  return ParseExample(&stream, example);
+  return ParseExample(&stream, filter, example);
+}
+
+bool ParseExample(StringPiece serialized, parsed::Example* example) {
+  return ParseExample(serialized, AcceptAllFeatures(), example);
 }
 
 }  // namespace
@@ -599,8 +616,20 @@ Status FastParseSerializedExample(
   DCHECK(output_dense != nullptr);
   DCHECK(output_sparse != nullptr);
   DCHECK(output_ragged != nullptr);
+  // Prune features that are not in the config while scanning the proto, so
+  // they never occupy a slot in parsed_example. When stats are requested the
+  // unfiltered parse is used instead, since features_count must reflect the
+  // full feature map.
+  auto in_config = [&config_index, &hasher](StringPiece feature_name) {
+    std::pair<size_t, Type> d_and_type;
+    return config_index.Find(hasher(feature_name), &d_and_type);
+  };
   parsed::Example parsed_example;
-  if (!ParseExample(serialized_example, &parsed_example)) {
+  const bool parse_ok =
+      output_stats
+          ? ParseExample(serialized_example, &parsed_example)
+          : ParseExample(serialized_example, in_config, &parsed_example);
+  if (!parse_ok) {
     return errors::InvalidArgument("Could not parse example input, value: '",
                                    serialized_example, "'");
   }
@@ -1529,8 +1558,18 @@ Status FastParseSingleExample(const Config& config, StringPiece serialized,
     result->ragged_splits.emplace_back(splits_dtype, TensorShape({0}));
   }
 
+  // As in FastParseSerializedExample(), features absent from the config are
+  // pruned while scanning the proto unless the full feature map is needed for
+  // stats.
+  auto in_config = [&config_index, &hasher](StringPiece feature_name) {
+    std::pair<size_t, Type> d_and_type;
+    return config_index.Find(hasher(feature_name), &d_and_type);
+  };
   parsed::Example parsed_example;
-  if (!ParseExample(serialized, &parsed_example)) {
+  const bool parse_ok =
+      stats ? ParseExample(serialized, &parsed_example)
+            : ParseExample(serialized, in_config, &parsed_example);
+  if (!parse_ok) {
     return errors::InvalidArgument("Could not parse example input, value: '",
                                    serialized, "'");
   }
@@ -39,30 +39,32 @@ Status GuardedPhiloxRandom::Init(OpKernelConstruction* context) {
 }
 
 void GuardedPhiloxRandom::Init(int64_t seed, int64_t seed2) {
-  CHECK(!initialized_);
+  CHECK(!initialized_.load(std::memory_order_relaxed));
   if (seed == 0 && seed2 == 0) {
     // If both seeds are unspecified, use completely random seeds.
     seed = random::New64();
     seed2 = random::New64();
   }
-  mutex_lock lock(mu_);
   generator_ = random::PhiloxRandom(seed, seed2);
-  initialized_ = true;
+  // The release store publishes `generator_` to reserving threads.
+  initialized_.store(true, std::memory_order_release);
 }
 
 void GuardedPhiloxRandom::Init(random::PhiloxRandom::ResultType counter,
                                random::PhiloxRandom::Key key) {
-  CHECK(!initialized_);
-  mutex_lock lock(mu_);
+  CHECK(!initialized_.load(std::memory_order_relaxed));
   generator_ = random::PhiloxRandom(counter, key);
-  initialized_ = true;
+  initialized_.store(true, std::memory_order_release);
 }
 
 random::PhiloxRandom GuardedPhiloxRandom::ReserveSamples128(int64_t samples) {
-  CHECK(initialized_);
-  mutex_lock lock(mu_);
+  CHECK(initialized_.load(std::memory_order_acquire));
+  // Atomically claim a disjoint range of the counter space; concurrent
+  // callers proceed without locking.
+  uint64 offset = counter_offset_.fetch_add(static_cast<uint64>(samples),
+                                            std::memory_order_relaxed);
   auto local = generator_;
-  generator_.Skip(samples);
+  local.Skip(offset);
   return local;
 }
 
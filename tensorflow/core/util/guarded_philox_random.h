@@ -16,10 +16,11 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_GUARDED_PHILOX_RANDOM_H_
 #define TENSORFLOW_CORE_UTIL_GUARDED_PHILOX_RANDOM_H_
 
+#include <atomic>
+
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/lib/random/philox_random.h"
 #include "tensorflow/core/platform/macros.h"
-#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 
 namespace tensorflow {
@@ -37,10 +38,13 @@ namespace tensorflow {
 //     // Use sample
 //   }
 //
+// Reservations are lock free: each caller atomically claims a disjoint range
+// of the Philox counter space, so concurrent kernels never serialize on a
+// mutex. Init must complete before the first reservation.
 class GuardedPhiloxRandom {
  public:
   // Must call Init to finish initialization
-  GuardedPhiloxRandom() : initialized_(false) {}
+  GuardedPhiloxRandom() : counter_offset_(0), initialized_(false) {}
 
   // Initialize the generator from attributes "seed" and "seed2".
   // If both seeds are unspecified, use random seeds.
@@ -70,9 +74,11 @@ class GuardedPhiloxRandom {
   }
 
  private:
-  mutex mu_;
-  random::PhiloxRandom generator_ TF_GUARDED_BY(mu_);
-  bool initialized_;
+  // Set once by Init and read-only afterwards.
+  random::PhiloxRandom generator_;
+  // Number of 128-bit samples already handed out from `generator_`'s stream.
+  std::atomic<uint64> counter_offset_;
+  std::atomic<bool> initialized_;
 
   GuardedPhiloxRandom(const GuardedPhiloxRandom&) = delete;
   void operator=(const GuardedPhiloxRandom&) = delete;
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tensorflow/core/util/sparse/sparse_tensor.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "tensorflow/core/lib/strings/strcat.h"
 
 namespace tensorflow {
@@ -308,5 +312,49 @@ Status SparseTensor::IndicesValid() const {
   }
 }
 
+bool SparseTensor::SortIndicesByLinearizedKeys(
+    const VarDimArray& order, std::vector<int64_t>* reorder) const {
+  // Strides of the ordered dimensions; the last ordered dimension varies
+  // fastest, matching lexicographic comparison by `order`.
+  gtl::InlinedVector<int64_t, 8> stride(order.size());
+  int64_t volume = 1;
+  for (int d = order.size() - 1; d >= 0; --d) {
+    if (order[d] < 0 || order[d] >= static_cast<int64_t>(shape_.size())) {
+      return false;
+    }
+    const int64_t dim_size = shape_[order[d]];
+    if (dim_size <= 0 ||
+        volume > std::numeric_limits<int64_t>::max() / dim_size) {
+      return false;
+    }
+    stride[d] = volume;
+    volume *= dim_size;
+  }
+
+  const auto ix_t = ix_.matrix<int64_t>();
+  const int64_t n = num_entries();
+  std::vector<int64_t> keys(n);
+  for (int64_t i = 0; i < n; ++i) {
+    int64_t key = 0;
+    for (size_t d = 0; d < order.size(); ++d) {
+      const int64_t ix_i_d = ix_t(i, order[d]);
+      // An out-of-bounds index would break the equivalence between key
+      // comparison and lexicographic comparison; keep the comparison sort's
+      // behavior for such inputs.
+      if (!FastBoundsCheck(ix_i_d, shape_[order[d]])) return false;
+      key += ix_i_d * stride[d];
+    }
+    keys[i] = key;
+  }
+
+  // Break ties by the original position so that the permutation is
+  // deterministic for repeated indices.
+  std::sort(reorder->begin(), reorder->end(),
+            [&keys](const int64_t a, const int64_t b) {
+              return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+            });
+  return true;
+}
+
 }  // namespace sparse
 }  // namespace tensorflow
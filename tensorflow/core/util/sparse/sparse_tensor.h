@@ -206,6 +206,15 @@ class SparseTensor {
   // REQUIRES: `shape_.size() == 1`.
   bool IndicesValidVectorFastPath() const;
 
+  // Sorts `reorder` (a permutation of the rows of `ix_`) by the dimensions in
+  // `order`, comparing rows through a single linearized key instead of a
+  // column-by-column walk. Returns false, leaving `reorder` untouched, when
+  // the keys cannot represent the ordering exactly: an index is out of
+  // bounds, or the dense volume of the ordered dimensions overflows int64.
+  // The caller must then fall back to comparison sorting.
+  bool SortIndicesByLinearizedKeys(const VarDimArray& order,
+                                   std::vector<int64_t>* reorder) const;
+
   // Optimized implementation of `IndicesValid` for 2-D sparse tensors whose
   // indices fit within the range of an `int32`.
   // REQUIRES: `shape_.size() == 2`.
@@ -280,24 +289,28 @@ inline void SparseTensor::Reorder(const VarDimArray& order) {
   std::vector<int64_t> reorder(num_entries());
   std::iota(reorder.begin(), reorder.end(), 0);
 
-  // Sort to get order of indices
-  switch (order.size()) {
+  // Sort to get order of indices.  When every index is in bounds and the
+  // dense volume fits in int64, a linearized scalar key per row replaces the
+  // per-comparison column walk of DimComparator.
+  if (!SortIndicesByLinearizedKeys(order, &reorder)) {
+    switch (order.size()) {
 #define CASE_SORT(ORDER_SIZE)                                    \
   case ORDER_SIZE: {                                             \
     FixedDimComparator<ORDER_SIZE> sorter(ix_t, order, shape()); \
     std::sort(reorder.begin(), reorder.end(), sorter);           \
     break;                                                       \
   }
-    CASE_SORT(0);
-    CASE_SORT(1);
-    CASE_SORT(2);
-    CASE_SORT(3);
-    CASE_SORT(4);
-    CASE_SORT(5);
+      CASE_SORT(0);
+      CASE_SORT(1);
+      CASE_SORT(2);
+      CASE_SORT(3);
+      CASE_SORT(4);
+      CASE_SORT(5);
 #undef CASE_SORT
-    default: {
-      DimComparator sorter(ix_t, order, shape());
-      std::sort(reorder.begin(), reorder.end(), sorter);
+      default: {
+        DimComparator sorter(ix_t, order, shape());
+        std::sort(reorder.begin(), reorder.end(), sorter);
+      }
     }
   }
 
@@ -563,12 +576,21 @@ inline Status SparseTensor::Split(const SparseTensor& input_tensor,
     }
   }
 
+  // Entries are emitted in their input order and the split dimension is only
+  // shifted by a per-slice constant, so any ordering of the input carries
+  // over to each slice.
+  const bool input_ordered =
+      !input_tensor.order().empty() && input_tensor.order()[0] >= 0;
+
   result->clear();
   result->reserve(num_split);
   for (int i = 0; i < num_split; ++i) {
     SparseTensor tensor;
     Status create_status =
-        Create(output_indices[i], output_values[i], output_shapes[i], &tensor);
+        input_ordered ? Create(output_indices[i], output_values[i],
+                               output_shapes[i], input_tensor.order(), &tensor)
+                      : Create(output_indices[i], output_values[i],
+                               output_shapes[i], &tensor);
     if (!create_status.ok()) {
       return create_status;
     }
@@ -663,6 +685,12 @@ inline StatusOr<SparseTensor> SparseTensor::Slice(
     index++;
   }
 
+  // Entries are emitted in their input order and every index is only shifted
+  // by a constant, so any ordering of the input carries over to the slice.
+  if (!input_tensor.order().empty() && input_tensor.order()[0] >= 0) {
+    return SparseTensor(output_indices, output_values, output_shape,
+                        input_tensor.order());
+  }
   return SparseTensor(output_indices, output_values, output_shape);
 }
 
@@ -660,6 +660,35 @@ TEST(SparseTensorTest, Split) {
   EXPECT_EQ(st_list[1].indices().matrix<int64_t>()(0, 1), 0);
 }
 
+TEST(SparseTensorTest, SplitPropagatesOrder) {
+  Tensor ids(DT_INT64, TensorShape({2, 2}));
+  Tensor vals(DT_INT64, TensorShape({2}));
+
+  ids.matrix<int64_t>()(0, 0) = 0;
+  ids.matrix<int64_t>()(0, 1) = 0;
+  ids.matrix<int64_t>()(1, 0) = 3;
+  ids.matrix<int64_t>()(1, 1) = 1;
+
+  vals.vec<int64_t>()(0) = 1;
+  vals.vec<int64_t>()(1) = 2;
+
+  std::vector<int64_t> order{0, 1};
+  SparseTensor st;
+  TF_ASSERT_OK(
+      SparseTensor::Create(ids, vals, TensorShape({4, 3}), order, &st));
+
+  // Splitting moves entries in input order and only shifts the split
+  // dimension, so the slices stay in the input's order and do not need to be
+  // re-sorted.
+  std::vector<SparseTensor> st_list;
+  TF_ASSERT_OK(SparseTensor::Split<int64_t>(st, 0, 2, &st_list));
+  ASSERT_EQ(st_list.size(), 2);
+  for (const SparseTensor& part : st_list) {
+    EXPECT_EQ(part.order(), order);
+    TF_EXPECT_OK(part.IndicesValid());
+  }
+}
+
 TEST(SparseTensorTest, Slice) {
   const int N = 4;
   const int DIM = 2;
@@ -706,6 +735,31 @@ TEST(SparseTensorTest, Slice) {
   EXPECT_EQ(slice.indices().matrix<int64_t>()(2, 1), 2);
 }
 
+TEST(SparseTensorTest, SlicePropagatesOrder) {
+  Tensor ids(DT_INT64, TensorShape({2, 2}));
+  Tensor vals(DT_INT64, TensorShape({2}));
+
+  ids.matrix<int64_t>()(0, 0) = 0;
+  ids.matrix<int64_t>()(0, 1) = 0;
+  ids.matrix<int64_t>()(1, 0) = 1;
+  ids.matrix<int64_t>()(1, 1) = 1;
+
+  vals.vec<int64_t>()(0) = 1;
+  vals.vec<int64_t>()(1) = 2;
+
+  std::vector<int64_t> order{0, 1};
+  SparseTensor st;
+  TF_ASSERT_OK(
+      SparseTensor::Create(ids, vals, TensorShape({4, 3}), order, &st));
+
+  // Slicing only subtracts a constant from each index, so the result stays in
+  // the input's order and does not need to be re-sorted.
+  TF_ASSERT_OK_AND_ASSIGN(SparseTensor slice,
+                          SparseTensor::Slice<int64_t>(st, {0, 0}, {2, 2}));
+  EXPECT_EQ(slice.order(), st.order());
+  TF_EXPECT_OK(slice.IndicesValid());
+}
+
 TEST(SparseTensorTest, SliceReducesOutputDimension) {
   const int num_rows = 2;
   const int num_columns = 2;
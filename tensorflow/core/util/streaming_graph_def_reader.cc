@@ -0,0 +1,405 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/util/streaming_graph_def_reader.h"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/coding.h"
+#include "tensorflow/core/lib/io/buffered_inputstream.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/tstring.h"
+
+namespace tensorflow {
+namespace {
+
+// Field numbers of the protos we walk, from graph.proto, node_def.proto,
+// attr_value.proto and tensor.proto. Only the path leading to
+// TensorProto.tensor_content is parsed field-by-field; every other field is
+// copied through byte-for-byte and handed to the regular proto parser.
+constexpr uint64 kGraphDefNodeField = 1;
+constexpr uint64 kNodeDefAttrField = 5;
+constexpr uint64 kAttrEntryKeyField = 1;
+constexpr uint64 kAttrEntryValueField = 2;
+constexpr uint64 kAttrValueTensorField = 8;
+constexpr uint64 kTensorProtoDtypeField = 1;
+constexpr uint64 kTensorProtoShapeField = 2;
+constexpr uint64 kTensorProtoContentField = 4;
+
+constexpr uint64 kWireVarint = 0;
+constexpr uint64 kWireFixed64 = 1;
+constexpr uint64 kWireDelimited = 2;
+constexpr uint64 kWireFixed32 = 5;
+
+constexpr int kReadBufferSize = 256 << 10;
+
+// Reads one base-128 varint from `in`.
+Status ReadVarint(io::BufferedInputStream* in, uint64* value) {
+  *value = 0;
+  tstring byte;
+  for (int shift = 0; shift < 64; shift += 7) {
+    TF_RETURN_IF_ERROR(in->ReadNBytes(1, &byte));
+    const uint64 b = static_cast<unsigned char>(byte[0]);
+    *value |= (b & 0x7f) << shift;
+    if ((b & 0x80) == 0) {
+      return OkStatus();
+    }
+  }
+  return errors::DataLoss("Malformed varint in serialized GraphDef.");
+}
+
+// Reads `n` bytes from `in` and appends them to `*out`.
+Status AppendBytes(io::BufferedInputStream* in, uint64 n, string* out) {
+  tstring bytes;
+  TF_RETURN_IF_ERROR(in->ReadNBytes(static_cast<int64_t>(n), &bytes));
+  out->append(bytes.data(), bytes.size());
+  return OkStatus();
+}
+
+// Copies the field whose tag was just read through to `*out` verbatim.
+Status CopyField(io::BufferedInputStream* in, uint64 tag, string* out) {
+  core::PutVarint64(out, tag);
+  switch (tag & 0x7) {
+    case kWireVarint: {
+      uint64 value;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &value));
+      core::PutVarint64(out, value);
+      return OkStatus();
+    }
+    case kWireFixed64:
+      return AppendBytes(in, 8, out);
+    case kWireDelimited: {
+      uint64 length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &length));
+      core::PutVarint64(out, length);
+      return AppendBytes(in, length, out);
+    }
+    case kWireFixed32:
+      return AppendBytes(in, 4, out);
+    default:
+      return errors::DataLoss("Unsupported wire type ", tag & 0x7,
+                              " in serialized GraphDef.");
+  }
+}
+
+// Re-encodes the TensorProto of `length` bytes at the stream position into
+// `*out`, leaving out any tensor_content payload of at least
+// `min_deferred_bytes` bytes. A skipped payload sets `*deferred` and records
+// its file offset, dtype and shape in `*entry`.
+Status ParseTensorProto(io::BufferedInputStream* in, uint64 length,
+                        uint64 min_deferred_bytes, string* out,
+                        DeferredTensorEntry* entry, bool* deferred) {
+  const int64_t end = in->Tell() + static_cast<int64_t>(length);
+  while (in->Tell() < end) {
+    uint64 tag;
+    TF_RETURN_IF_ERROR(ReadVarint(in, &tag));
+    const uint64 field = tag >> 3;
+    if (field == kTensorProtoContentField && (tag & 0x7) == kWireDelimited) {
+      uint64 content_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &content_length));
+      if (content_length >= min_deferred_bytes) {
+        entry->offset = static_cast<uint64>(in->Tell());
+        entry->length = content_length;
+        *deferred = true;
+        TF_RETURN_IF_ERROR(in->SkipNBytes(content_length));
+        continue;
+      }
+      core::PutVarint64(out, tag);
+      core::PutVarint64(out, content_length);
+      TF_RETURN_IF_ERROR(AppendBytes(in, content_length, out));
+      continue;
+    }
+    if (field == kTensorProtoDtypeField && (tag & 0x7) == kWireVarint) {
+      uint64 dtype;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &dtype));
+      entry->dtype = static_cast<DataType>(dtype);
+      core::PutVarint64(out, tag);
+      core::PutVarint64(out, dtype);
+      continue;
+    }
+    if (field == kTensorProtoShapeField && (tag & 0x7) == kWireDelimited) {
+      uint64 shape_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &shape_length));
+      string shape_bytes;
+      TF_RETURN_IF_ERROR(AppendBytes(in, shape_length, &shape_bytes));
+      if (!entry->shape.ParseFromArray(shape_bytes.data(),
+                                       shape_bytes.size())) {
+        return errors::DataLoss(
+            "Malformed TensorShapeProto in serialized GraphDef.");
+      }
+      core::PutVarint64(out, tag);
+      core::PutVarint64(out, shape_length);
+      out->append(shape_bytes);
+      continue;
+    }
+    TF_RETURN_IF_ERROR(CopyField(in, tag, out));
+  }
+  if (in->Tell() != end) {
+    return errors::DataLoss("Truncated TensorProto in serialized GraphDef.");
+  }
+  return OkStatus();
+}
+
+// As ParseTensorProto, one level up: re-encodes an AttrValue, descending into
+// its tensor field when that field alone is large enough to hold a deferrable
+// payload.
+Status ParseAttrValue(io::BufferedInputStream* in, uint64 length,
+                      uint64 min_deferred_bytes, string* out,
+                      DeferredTensorEntry* entry, bool* deferred) {
+  const int64_t end = in->Tell() + static_cast<int64_t>(length);
+  while (in->Tell() < end) {
+    uint64 tag;
+    TF_RETURN_IF_ERROR(ReadVarint(in, &tag));
+    if ((tag >> 3) == kAttrValueTensorField && (tag & 0x7) == kWireDelimited) {
+      uint64 tensor_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &tensor_length));
+      if (tensor_length >= min_deferred_bytes) {
+        string tensor_bytes;
+        TF_RETURN_IF_ERROR(ParseTensorProto(in, tensor_length,
+                                            min_deferred_bytes, &tensor_bytes,
+                                            entry, deferred));
+        core::PutVarint64(out, tag);
+        core::PutVarint64(out, tensor_bytes.size());
+        out->append(tensor_bytes);
+      } else {
+        core::PutVarint64(out, tag);
+        core::PutVarint64(out, tensor_length);
+        TF_RETURN_IF_ERROR(AppendBytes(in, tensor_length, out));
+      }
+      continue;
+    }
+    TF_RETURN_IF_ERROR(CopyField(in, tag, out));
+  }
+  if (in->Tell() != end) {
+    return errors::DataLoss("Truncated AttrValue in serialized GraphDef.");
+  }
+  return OkStatus();
+}
+
+// Re-encodes one NodeDef.attr map entry, recording the attr key in `*entry`
+// so a deferred payload can be attributed to it.
+Status ParseAttrEntry(io::BufferedInputStream* in, uint64 length,
+                      uint64 min_deferred_bytes, string* out,
+                      DeferredTensorEntry* entry, bool* deferred) {
+  const int64_t end = in->Tell() + static_cast<int64_t>(length);
+  while (in->Tell() < end) {
+    uint64 tag;
+    TF_RETURN_IF_ERROR(ReadVarint(in, &tag));
+    const uint64 field = tag >> 3;
+    if (field == kAttrEntryKeyField && (tag & 0x7) == kWireDelimited) {
+      uint64 key_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &key_length));
+      string key;
+      TF_RETURN_IF_ERROR(AppendBytes(in, key_length, &key));
+      entry->attr_name = key;
+      core::PutVarint64(out, tag);
+      core::PutVarint64(out, key_length);
+      out->append(key);
+      continue;
+    }
+    if (field == kAttrEntryValueField && (tag & 0x7) == kWireDelimited) {
+      uint64 value_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &value_length));
+      if (value_length >= min_deferred_bytes) {
+        string value_bytes;
+        TF_RETURN_IF_ERROR(ParseAttrValue(in, value_length, min_deferred_bytes,
+                                          &value_bytes, entry, deferred));
+        core::PutVarint64(out, tag);
+        core::PutVarint64(out, value_bytes.size());
+        out->append(value_bytes);
+      } else {
+        core::PutVarint64(out, tag);
+        core::PutVarint64(out, value_length);
+        TF_RETURN_IF_ERROR(AppendBytes(in, value_length, out));
+      }
+      continue;
+    }
+    TF_RETURN_IF_ERROR(CopyField(in, tag, out));
+  }
+  if (in->Tell() != end) {
+    return errors::DataLoss("Truncated attr entry in serialized GraphDef.");
+  }
+  return OkStatus();
+}
+
+// Parses one NodeDef of `length` bytes, deferring oversized tensor payloads.
+// Deferred entries are returned without a node name; the caller fills it in
+// from the parsed node (the name field may follow the attr fields on the
+// wire, so it is not known until the whole node has been read).
+Status ParseNodeDef(io::BufferedInputStream* in, uint64 length,
+                    uint64 min_deferred_bytes, NodeDef* node,
+                    std::vector<DeferredTensorEntry>* deferred_entries) {
+  const int64_t end = in->Tell() + static_cast<int64_t>(length);
+  string node_bytes;
+  while (in->Tell() < end) {
+    uint64 tag;
+    TF_RETURN_IF_ERROR(ReadVarint(in, &tag));
+    if ((tag >> 3) == kNodeDefAttrField && (tag & 0x7) == kWireDelimited) {
+      uint64 entry_length;
+      TF_RETURN_IF_ERROR(ReadVarint(in, &entry_length));
+      if (entry_length >= min_deferred_bytes) {
+        DeferredTensorEntry entry;
+        bool deferred = false;
+        string entry_bytes;
+        TF_RETURN_IF_ERROR(ParseAttrEntry(in, entry_length, min_deferred_bytes,
+                                          &entry_bytes, &entry, &deferred));
+        core::PutVarint64(&node_bytes, tag);
+        core::PutVarint64(&node_bytes, entry_bytes.size());
+        node_bytes.append(entry_bytes);
+        if (deferred) {
+          deferred_entries->push_back(std::move(entry));
+        }
+      } else {
+        core::PutVarint64(&node_bytes, tag);
+        core::PutVarint64(&node_bytes, entry_length);
+        TF_RETURN_IF_ERROR(AppendBytes(in, entry_length, &node_bytes));
+      }
+      continue;
+    }
+    TF_RETURN_IF_ERROR(CopyField(in, tag, &node_bytes));
+  }
+  if (in->Tell() != end) {
+    return errors::DataLoss("Truncated NodeDef in serialized GraphDef.");
+  }
+  if (!node->ParseFromArray(node_bytes.data(), node_bytes.size())) {
+    return errors::DataLoss("Malformed NodeDef in serialized GraphDef.");
+  }
+  return OkStatus();
+}
+
+}  // namespace
+
+Status ReadGraphDefStreaming(Env* env, const string& fname,
+                             int64_t min_deferred_bytes, GraphDef* graph_def,
+                             DeferredTensorIndex* index) {
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(env->NewRandomAccessFile(fname, &file));
+  uint64 file_size = 0;
+  TF_RETURN_IF_ERROR(env->GetFileSize(fname, &file_size));
+  io::BufferedInputStream in(file.get(), kReadBufferSize);
+
+  // A non-positive threshold never defers; a payload cannot be larger than
+  // the whole file, so the maximum acts as "off". Containers are descended
+  // into only when they are large enough to hold a deferrable payload
+  // themselves, so small nodes take the ordinary parse path below.
+  const uint64 threshold = min_deferred_bytes > 0
+                               ? static_cast<uint64>(min_deferred_bytes)
+                               : std::numeric_limits<uint64>::max();
+
+  graph_def->Clear();
+  index->graph_def_path = fname;
+  index->entries.clear();
+
+  // Top-level fields other than the nodes (versions, library) are collected
+  // verbatim and merged at the end; they are small compared to the nodes.
+  string other_fields;
+  while (static_cast<uint64>(in.Tell()) < file_size) {
+    uint64 tag;
+    TF_RETURN_IF_ERROR(ReadVarint(&in, &tag));
+    if ((tag >> 3) == kGraphDefNodeField && (tag & 0x7) == kWireDelimited) {
+      uint64 node_length;
+      TF_RETURN_IF_ERROR(ReadVarint(&in, &node_length));
+      NodeDef* node = graph_def->add_node();
+      if (node_length >= threshold) {
+        std::vector<DeferredTensorEntry> node_entries;
+        TF_RETURN_IF_ERROR(
+            ParseNodeDef(&in, node_length, threshold, node, &node_entries));
+        for (DeferredTensorEntry& entry : node_entries) {
+          entry.node_name = node->name();
+          index->entries.push_back(std::move(entry));
+        }
+      } else {
+        tstring node_bytes;
+        TF_RETURN_IF_ERROR(
+            in.ReadNBytes(static_cast<int64_t>(node_length), &node_bytes));
+        if (!node->ParseFromArray(node_bytes.data(), node_bytes.size())) {
+          return errors::DataLoss("Malformed NodeDef in serialized GraphDef.");
+        }
+      }
+    } else {
+      TF_RETURN_IF_ERROR(CopyField(&in, tag, &other_fields));
+    }
+  }
+  if (!other_fields.empty()) {
+    GraphDef rest;
+    if (!rest.ParseFromString(other_fields)) {
+      return errors::DataLoss("Malformed serialized GraphDef: ", fname);
+    }
+    graph_def->MergeFrom(rest);
+  }
+  return OkStatus();
+}
+
+Status MaterializeDeferredTensor(Env* env, const DeferredTensorIndex& index,
+                                 const DeferredTensorEntry& entry,
+                                 Tensor* out) {
+  if (!DataTypeCanUseMemcpy(entry.dtype)) {
+    return errors::InvalidArgument(
+        "Deferred tensor for node \"", entry.node_name,
+        "\" has dtype ", DataTypeString(entry.dtype),
+        ", which has no raw tensor_content representation.");
+  }
+  TensorShape shape;
+  TF_RETURN_IF_ERROR(TensorShape::BuildTensorShape(entry.shape, &shape));
+  const int64_t expected_bytes =
+      shape.num_elements() * DataTypeSize(entry.dtype);
+  if (expected_bytes <= 0 ||
+      static_cast<uint64>(expected_bytes) != entry.length) {
+    return errors::DataLoss(
+        "Deferred tensor_content for node \"", entry.node_name, "\" has ",
+        entry.length, " bytes, but dtype ", DataTypeString(entry.dtype),
+        " and shape ", shape.DebugString(), " require ", expected_bytes,
+        " bytes.");
+  }
+
+  Tensor tensor(entry.dtype, shape);
+  char* dst = static_cast<char*>(tensor.data());
+  std::unique_ptr<ReadOnlyMemoryRegion> region;
+  if (env->NewReadOnlyMemoryRegionFromFile(index.graph_def_path, &region)
+          .ok()) {
+    if (entry.offset + entry.length > region->length()) {
+      return errors::DataLoss("Deferred tensor for node \"", entry.node_name,
+                              "\" lies outside of file ",
+                              index.graph_def_path);
+    }
+    // The pages behind the copy are clean file-backed mappings, so peak RSS
+    // stays bounded: the kernel can evict them as the copy proceeds.
+    memcpy(dst, static_cast<const char*>(region->data()) + entry.offset,
+           entry.length);
+  } else {
+    // Not all file systems support mmap; fall back to a positioned read
+    // straight into the tensor buffer.
+    std::unique_ptr<RandomAccessFile> file;
+    TF_RETURN_IF_ERROR(
+        env->NewRandomAccessFile(index.graph_def_path, &file));
+    StringPiece data;
+    TF_RETURN_IF_ERROR(file->Read(entry.offset, entry.length, &data, dst));
+    if (data.data() != dst) {
+      memmove(dst, data.data(), data.size());
+    }
+  }
+  *out = std::move(tensor);
+  return OkStatus();
+}
+
+}  // namespace tensorflow
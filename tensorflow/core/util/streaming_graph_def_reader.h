@@ -0,0 +1,84 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_UTIL_STREAMING_GRAPH_DEF_READER_H_
+#define TENSORFLOW_CORE_UTIL_STREAMING_GRAPH_DEF_READER_H_
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/env.h"
+
+namespace tensorflow {
+
+// Locates a large `tensor_content` payload that ReadGraphDefStreaming left
+// out of the parsed GraphDef. `offset` and `length` identify the raw bytes
+// of the payload inside the original serialized file.
+struct DeferredTensorEntry {
+  // Name of the node (typically a Const) whose attr held the payload.
+  string node_name;
+  // Name of the attr (typically "value").
+  string attr_name;
+  DataType dtype = DT_INVALID;
+  TensorShapeProto shape;
+  uint64 offset = 0;
+  uint64 length = 0;
+};
+
+// The deferred payloads of one serialized GraphDef, backed by the file they
+// were read from. The file must stay unmodified at `graph_def_path` for as
+// long as tensors are materialized from the index.
+struct DeferredTensorIndex {
+  string graph_def_path;
+  std::vector<DeferredTensorEntry> entries;
+};
+
+// Reads the binary-serialized GraphDef at `fname` incrementally, one node at
+// a time, instead of materializing the whole proto in memory the way
+// ReadBinaryProto does. Any `tensor_content` payload of at least
+// `min_deferred_bytes` bytes (in practice the embedded weights of Const
+// nodes) is skipped rather than read: the node is added to `graph_def` with
+// the payload absent and its file offset recorded in `index`, so load-time
+// memory is bounded by the size of the graph metadata. Deferred tensors can
+// later be constructed directly from the file with
+// MaterializeDeferredTensor, which maps the file instead of buffering it.
+//
+// Callers must materialize (or otherwise supply) the deferred payloads
+// before executing the affected nodes. A `min_deferred_bytes` of zero or
+// less defers nothing, which still parses node-by-node but yields exactly
+// the proto ReadBinaryProto would. Returns DataLoss if the file is not a
+// valid serialized GraphDef.
+Status ReadGraphDefStreaming(Env* env, const string& fname,
+                             int64_t min_deferred_bytes, GraphDef* graph_def,
+                             DeferredTensorIndex* index);
+
+// Builds the tensor described by `entry` by memory-mapping the original file
+// recorded in `index` and copying the payload out of the mapping, so no
+// intermediate serialization buffer is allocated. Falls back to a plain file
+// read on file systems without mmap support. Only dtypes with a memcpy-able
+// representation can be deferred payloads, so all index entries are
+// materializable. Returns DataLoss if the payload size does not match the
+// recorded dtype and shape.
+Status MaterializeDeferredTensor(Env* env, const DeferredTensorIndex& index,
+                                 const DeferredTensorEntry& entry, Tensor* out);
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_UTIL_STREAMING_GRAPH_DEF_READER_H_
@@ -0,0 +1,187 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/util/streaming_graph_def_reader.h"
+
+#include <string>
+
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/util/equal_graph_def.h"
+
+namespace tensorflow {
+namespace {
+
+constexpr int kLargeConstElements = 1000;
+// Well below the serialized size of the large constant, well above that of
+// everything else in the test graph.
+constexpr int64_t kDeferThreshold = 256;
+
+// A graph with a small constant (inline payload), a large constant (payload
+// above the deferral threshold), a non-const node, versions and a function
+// library, so every parse path is exercised.
+GraphDef MakeTestGraphDef(Tensor* large_tensor) {
+  GraphDef graph_def;
+  graph_def.mutable_versions()->set_producer(123);
+
+  NodeDef* small_const = graph_def.add_node();
+  small_const->set_name("small_const");
+  small_const->set_op("Const");
+  (*small_const->mutable_attr())["dtype"].set_type(DT_FLOAT);
+  Tensor small(DT_FLOAT, TensorShape({2}));
+  test::FillFn<float>(&small, [](int i) { return static_cast<float>(i); });
+  small.AsProtoTensorContent(
+      (*small_const->mutable_attr())["value"].mutable_tensor());
+
+  NodeDef* large_const = graph_def.add_node();
+  large_const->set_name("large_const");
+  large_const->set_op("Const");
+  (*large_const->mutable_attr())["dtype"].set_type(DT_FLOAT);
+  *large_tensor = Tensor(DT_FLOAT, TensorShape({kLargeConstElements}));
+  test::FillFn<float>(large_tensor,
+                      [](int i) { return static_cast<float>(i * i); });
+  large_tensor->AsProtoTensorContent(
+      (*large_const->mutable_attr())["value"].mutable_tensor());
+
+  NodeDef* add = graph_def.add_node();
+  add->set_name("add");
+  add->set_op("Add");
+  add->add_input("small_const");
+  add->add_input("large_const");
+  (*add->mutable_attr())["T"].set_type(DT_FLOAT);
+
+  FunctionDef* function = graph_def.mutable_library()->add_function();
+  function->mutable_signature()->set_name("SomeFunction");
+  return graph_def;
+}
+
+string WriteGraphDefFile(const GraphDef& graph_def, const string& basename) {
+  const string filename = io::JoinPath(testing::TmpDir(), basename);
+  string serialized;
+  EXPECT_TRUE(graph_def.SerializeToString(&serialized));
+  TF_EXPECT_OK(WriteStringToFile(Env::Default(), filename, serialized));
+  return filename;
+}
+
+TEST(StreamingGraphDefReaderTest, NoThresholdMatchesRegularParse) {
+  Tensor large_tensor;
+  const GraphDef graph_def = MakeTestGraphDef(&large_tensor);
+  const string filename = WriteGraphDefFile(graph_def, "no_threshold.pb");
+
+  GraphDef parsed;
+  DeferredTensorIndex index;
+  TF_ASSERT_OK(ReadGraphDefStreaming(Env::Default(), filename,
+                                     /*min_deferred_bytes=*/0, &parsed,
+                                     &index));
+  EXPECT_TRUE(index.entries.empty());
+  string diff;
+  EXPECT_TRUE(EqualGraphDef(parsed, graph_def, &diff)) << diff;
+  EXPECT_EQ(parsed.versions().producer(), 123);
+  ASSERT_EQ(parsed.library().function_size(), 1);
+  EXPECT_EQ(parsed.library().function(0).signature().name(), "SomeFunction");
+}
+
+TEST(StreamingGraphDefReaderTest, DefersLargePayloadAndMaterializes) {
+  Tensor large_tensor;
+  const GraphDef graph_def = MakeTestGraphDef(&large_tensor);
+  const string filename = WriteGraphDefFile(graph_def, "deferred.pb");
+
+  GraphDef parsed;
+  DeferredTensorIndex index;
+  TF_ASSERT_OK(ReadGraphDefStreaming(Env::Default(), filename, kDeferThreshold,
+                                     &parsed, &index));
+
+  // Only the large constant's payload is deferred, with its metadata intact.
+  ASSERT_EQ(index.entries.size(), 1);
+  const DeferredTensorEntry& entry = index.entries[0];
+  EXPECT_EQ(entry.node_name, "large_const");
+  EXPECT_EQ(entry.attr_name, "value");
+  EXPECT_EQ(entry.dtype, DT_FLOAT);
+  EXPECT_EQ(entry.length, kLargeConstElements * sizeof(float));
+
+  // The parsed graph matches the original except for the missing payload.
+  GraphDef expected = graph_def;
+  for (NodeDef& node : *expected.mutable_node()) {
+    if (node.name() == "large_const") {
+      (*node.mutable_attr())["value"]
+          .mutable_tensor()
+          ->clear_tensor_content();
+    }
+  }
+  string diff;
+  EXPECT_TRUE(EqualGraphDef(parsed, expected, &diff)) << diff;
+
+  Tensor materialized;
+  TF_ASSERT_OK(
+      MaterializeDeferredTensor(Env::Default(), index, entry, &materialized));
+  test::ExpectTensorEqual<float>(materialized, large_tensor);
+}
+
+TEST(StreamingGraphDefReaderTest, SmallPayloadsStayInline) {
+  Tensor large_tensor;
+  const GraphDef graph_def = MakeTestGraphDef(&large_tensor);
+  const string filename = WriteGraphDefFile(graph_def, "inline.pb");
+
+  GraphDef parsed;
+  DeferredTensorIndex index;
+  TF_ASSERT_OK(ReadGraphDefStreaming(Env::Default(), filename, kDeferThreshold,
+                                     &parsed, &index));
+  for (const NodeDef& node : parsed.node()) {
+    if (node.name() == "small_const") {
+      EXPECT_FALSE(
+          node.attr().at("value").tensor().tensor_content().empty());
+    }
+  }
+}
+
+TEST(StreamingGraphDefReaderTest, MaterializeRejectsCorruptedEntry) {
+  Tensor large_tensor;
+  const GraphDef graph_def = MakeTestGraphDef(&large_tensor);
+  const string filename = WriteGraphDefFile(graph_def, "corrupted_entry.pb");
+
+  GraphDef parsed;
+  DeferredTensorIndex index;
+  TF_ASSERT_OK(ReadGraphDefStreaming(Env::Default(), filename, kDeferThreshold,
+                                     &parsed, &index));
+  ASSERT_EQ(index.entries.size(), 1);
+
+  // A length that disagrees with the dtype and shape must be rejected.
+  DeferredTensorEntry bad_entry = index.entries[0];
+  bad_entry.length -= sizeof(float);
+  Tensor materialized;
+  EXPECT_FALSE(MaterializeDeferredTensor(Env::Default(), index, bad_entry,
+                                         &materialized)
+                   .ok());
+}
+
+TEST(StreamingGraphDefReaderTest, RejectsMalformedFile) {
+  const string filename = io::JoinPath(testing::TmpDir(), "malformed.pb");
+  TF_ASSERT_OK(
+      WriteStringToFile(Env::Default(), filename, "not a graph def proto"));
+
+  GraphDef parsed;
+  DeferredTensorIndex index;
+  EXPECT_FALSE(ReadGraphDefStreaming(Env::Default(), filename,
+                                     /*min_deferred_bytes=*/0, &parsed, &index)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -15,14 +15,19 @@ limitations under the License.
 
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/framework/variant.h"
@@ -40,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/platform/bfloat16.h"
 #include "tensorflow/core/platform/cord.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/mem.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/random.h"
@@ -253,6 +259,28 @@ Status WriteTensor(const Tensor& val, tsl::BufferedWritableFile* out,
   return out->Append(StringPiece(buf, *bytes_written));
 }
 
+// Serializes only the chunks of the non-string tensor "val" whose indices are
+// listed in entry.stored_chunks(), concatenated in index order.
+// "bytes_written" is treated in the same fashion as WriteTensor().
+// REQUIRES: entry.delta_encoded() && DataTypeCanUseMemcpy(val.dtype())
+Status WriteDeltaTensor(const Tensor& val, const BundleEntryProto& entry,
+                        tsl::BufferedWritableFile* out, size_t* bytes_written) {
+  DCHECK(entry.delta_encoded());
+  DCHECK(DataTypeCanUseMemcpy(val.dtype())) << val.dtype();
+  const int64_t total_bytes = val.TotalBytes();
+  const int64_t chunk_bytes = entry.chunk_bytes();
+  const char* buf = GetBackingBuffer(val);
+  *bytes_written = 0;
+  for (int32 index : entry.stored_chunks()) {
+    const int64_t begin = static_cast<int64_t>(index) * chunk_bytes;
+    const int64_t len = std::min(chunk_bytes, total_bytes - begin);
+    TF_RETURN_IF_ERROR(out->Append(StringPiece(buf + begin, len)));
+    *bytes_written += len;
+  }
+  VLOG(1) << "Appending " << *bytes_written << " delta bytes to file";
+  return OkStatus();
+}
+
 // Serializes string tensor "val".  "bytes_written" is treated in the same
 // fashion as WriteTensor().
 //
@@ -362,6 +390,28 @@ Status WriteVariantTensor(const Tensor& val, tsl::BufferedWritableFile* out,
   return OkStatus();
 }
 
+// Tensor buffer aliasing a tensor payload inside a memory-mapped bundle data
+// file.  Holds a reference on the mapping so the pages remain valid for the
+// lifetime of every tensor returned from it.
+class MmapTensorBuffer : public TensorBuffer {
+ public:
+  MmapTensorBuffer(std::shared_ptr<ReadOnlyMemoryRegion> region, void* data,
+                   size_t size)
+      : TensorBuffer(data), region_(std::move(region)), size_(size) {}
+
+  size_t size() const override { return size_; }
+  TensorBuffer* root_buffer() override { return this; }
+  bool OwnsMemory() const override { return false; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(size_);
+    proto->set_allocator_name("mmap");
+  }
+
+ private:
+  std::shared_ptr<ReadOnlyMemoryRegion> region_;
+  size_t size_;
+};
+
 // Returns whether "slice_spec" is a full slice, with respect to the full shape.
 //
 // This can happen say, when "slice_spec" is
@@ -448,21 +498,39 @@ BundleWriter::BundleWriter(Env* env, StringPiece prefix, const Options& options)
   out_ = std::make_unique<tsl::BufferedWritableFile>(
       std::move(wrapper), 8 << 20 /* 8MB write buffer */);
 
-  VLOG(1) << "Writing to file " << data_path_;
-}
+  if (options_.async_write) {
+    async_writer_ = std::make_unique<thread::ThreadPool>(
+        env_, "bundle_async_writer", 1 /* ordered queue */);
+  }
 
-Status BundleWriter::Add(StringPiece key, const Tensor& val) {
-  if (!status_.ok()) return status_;
-  CHECK_NE(key, kHeaderEntryKey);
-  const string key_string(key);
-  if (entries_.find(key_string) != entries_.end()) {
-    status_ = errors::InvalidArgument("Adding duplicate key: ", key);
-    return status_;
+  if (!options_.delta_base_prefix.empty()) {
+    if (options_.delta_chunk_bytes <= 0) {
+      status_ = errors::InvalidArgument(
+          "BundleWriter::Options::delta_base_prefix requires "
+          "delta_chunk_bytes > 0");
+      return;
+    }
+    if (env_->FileExists(MetaFilename(options_.delta_base_prefix)).ok()) {
+      base_reader_ =
+          std::make_unique<BundleReader>(env_, options_.delta_base_prefix);
+      if (!base_reader_->status().ok()) {
+        // An unreadable base is an error rather than a silent full save: the
+        // caller named a bundle it expects restores to depend on.
+        status_ = base_reader_->status();
+        return;
+      }
+    } else {
+      // First save of a delta chain: no base yet, save everything.
+      VLOG(1) << "No bundle found at delta base prefix "
+              << options_.delta_base_prefix << "; performing a full save";
+    }
   }
 
-  BundleEntryProto* entry = &entries_[key_string];
-  entry->set_dtype(val.dtype());
-  val.shape().AsProto(entry->mutable_shape());
+  VLOG(1) << "Writing to file " << data_path_;
+}
+
+Status BundleWriter::WriteEntryPayload(const Tensor& val,
+                                       BundleEntryProto* entry) {
   entry->set_shard_id(0);
   entry->set_offset(size_);
 
@@ -470,20 +538,116 @@ Status BundleWriter::Add(StringPiece key, const Tensor& val) {
   size_t data_bytes_written = 0;
   uint32 crc32c = 0;
   out_->reset_crc32();
+  Status status;
   if (val.dtype() == DT_STRING) {
-    status_ = WriteStringTensor(val, out_.get(), &data_bytes_written, &crc32c);
+    status = WriteStringTensor(val, out_.get(), &data_bytes_written, &crc32c);
   } else if (val.dtype() == DT_VARIANT) {
-    status_ = WriteVariantTensor(val, out_.get(), &data_bytes_written, &crc32c);
+    status = WriteVariantTensor(val, out_.get(), &data_bytes_written, &crc32c);
+  } else if (entry->delta_encoded()) {
+    status = WriteDeltaTensor(val, *entry, out_.get(), &data_bytes_written);
+    crc32c = out_->crc32();
   } else {
-    status_ = WriteTensor(val, out_.get(), &data_bytes_written);
+    status = WriteTensor(val, out_.get(), &data_bytes_written);
     crc32c = out_->crc32();
   }
 
-  if (status_.ok()) {
+  if (status.ok()) {
     entry->set_size(data_bytes_written);
     entry->set_crc32c(crc32c::Mask(crc32c));
     size_ += data_bytes_written;
-    status_ = PadAlignment(out_.get(), options_.data_alignment, &size_);
+    status = PadAlignment(out_.get(), options_.data_alignment, &size_);
+  }
+  return status;
+}
+
+void BundleWriter::MaybeDeltaEncode(StringPiece key, const Tensor& val,
+                                    BundleEntryProto* entry) {
+  const int64_t chunk_bytes = options_.delta_chunk_bytes;
+  const int64_t total_bytes = val.TotalBytes();
+  if (total_bytes == 0) return;
+  const StringPiece data = val.tensor_data();
+  const int64_t num_chunks = (total_bytes + chunk_bytes - 1) / chunk_bytes;
+  entry->set_chunk_bytes(chunk_bytes);
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    const int64_t begin = i * chunk_bytes;
+    const int64_t len = std::min(chunk_bytes, total_bytes - begin);
+    entry->add_chunk_hashes(Fingerprint64(data.substr(begin, len)));
+  }
+  if (base_reader_ == nullptr) return;
+
+  // Looks up the base bundle's metadata entry for the same key.  Note that
+  // the base entry's chunk hashes always describe the full tensor content,
+  // even if the base entry is itself delta-encoded, so hash comparison works
+  // across chains of delta saves.
+  base_reader_->Seek(key);
+  if (!base_reader_->Valid() || base_reader_->key() != key) return;
+  BundleEntryProto base_entry;
+  const StringPiece base_value = base_reader_->value();
+  if (!base_entry.ParseFromArray(base_value.data(), base_value.size())) return;
+  if (base_entry.dtype() != entry->dtype() ||
+      TensorShape(base_entry.shape()) != TensorShape(entry->shape()) ||
+      base_entry.chunk_bytes() != chunk_bytes ||
+      base_entry.chunk_hashes_size() != entry->chunk_hashes_size()) {
+    return;
+  }
+  std::vector<int32> changed;
+  for (int i = 0; i < entry->chunk_hashes_size(); ++i) {
+    if (entry->chunk_hashes(i) != base_entry.chunk_hashes(i)) {
+      changed.push_back(i);
+    }
+  }
+  if (changed.size() == static_cast<size_t>(entry->chunk_hashes_size())) {
+    // Every chunk changed; a plain full write carries less metadata.
+    return;
+  }
+  entry->set_delta_encoded(true);
+  for (int32 index : changed) entry->add_stored_chunks(index);
+}
+
+Status BundleWriter::AddAsync(const Tensor& val, BundleEntryProto* entry) {
+  // Snapshot on the calling thread: the caller (e.g. a training loop) may
+  // mutate the variable in place before the background write runs, so the
+  // bytes must be stable when queued.
+  Tensor snapshot = tensor::DeepCopy(val);
+  async_writer_->Schedule([this, entry, snapshot = std::move(snapshot)]() {
+    Status s = WriteEntryPayload(snapshot, entry);
+    if (!s.ok()) {
+      mutex_lock l(mu_);
+      async_status_.Update(s);
+    }
+  });
+  return OkStatus();
+}
+
+Status BundleWriter::Add(StringPiece key, const Tensor& val) {
+  if (!status_.ok()) return status_;
+  if (async_writer_ != nullptr) {
+    // Surface errors from previously queued writes as early as possible.
+    mutex_lock l(mu_);
+    if (!async_status_.ok()) {
+      status_ = async_status_;
+      return status_;
+    }
+  }
+  CHECK_NE(key, kHeaderEntryKey);
+  const string key_string(key);
+  if (entries_.find(key_string) != entries_.end()) {
+    status_ = errors::InvalidArgument("Adding duplicate key: ", key);
+    return status_;
+  }
+
+  BundleEntryProto* entry = &entries_[key_string];
+  entry->set_dtype(val.dtype());
+  val.shape().AsProto(entry->mutable_shape());
+
+  if (options_.delta_chunk_bytes > 0 && DataTypeCanUseMemcpy(val.dtype())) {
+    MaybeDeltaEncode(key, val, entry);
+  }
+
+  if (async_writer_ != nullptr) {
+    status_ = AddAsync(val, entry);
+  } else {
+    status_ = WriteEntryPayload(val, entry);
   }
   return status_;
 }
@@ -532,6 +696,13 @@ Status BundleWriter::AddSlice(StringPiece full_tensor_key,
 // TODO(zongheng): on metadata write failure or !status_.ok(), consider removing
 // the orphaned data file.
 Status BundleWriter::Finish() {
+  if (async_writer_ != nullptr) {
+    // Durability barrier: joining the writer thread makes every queued
+    // payload visible in out_ and completes the entries' payload fields.
+    async_writer_.reset();
+    mutex_lock l(mu_);
+    status_.Update(async_status_);
+  }
   if (out_) {
     status_.Update(out_->Close());
     out_ = nullptr;
@@ -563,6 +734,9 @@ Status BundleWriter::Finish() {
     VersionDef* version = header.mutable_version();
     version->set_producer(kTensorBundleVersion);
     version->set_min_consumer(kTensorBundleMinConsumer);
+    if (base_reader_ != nullptr) {
+      header.set_delta_base_prefix(options_.delta_base_prefix);
+    }
 
     builder.Add(kHeaderEntryKey, header.SerializeAsString());
 
@@ -598,6 +772,10 @@ struct MergeState {
   BundleHeaderProto_Endianness endianness;
   VersionDef version;
 
+  // Delta base prefix, if any of the merged bundles was delta-saved.  All
+  // bundles naming a base must name the same one.
+  string delta_base_prefix;
+
   // Tensor key -> BundleEntryProto.
   std::map<string, BundleEntryProto> entries;
   // Data file path -> new shard id in the final merged bundle.
@@ -654,6 +832,16 @@ static Status MergeOneBundle(Env* env, StringPiece prefix,
             merge_version, " vs. curr ", curr_version);
       }
     }
+    if (!header.delta_base_prefix().empty()) {
+      if (merge_state->delta_base_prefix.empty()) {
+        merge_state->delta_base_prefix = header.delta_base_prefix();
+      } else if (merge_state->delta_base_prefix != header.delta_base_prefix()) {
+        return errors::InvalidArgument(
+            "Merging delta bundles with conflicting base prefixes: ",
+            merge_state->delta_base_prefix, " vs. ",
+            header.delta_base_prefix());
+      }
+    }
     num_shards = header.num_shards();
     iter->Next();
   }
@@ -747,6 +935,9 @@ Status MergeBundles(Env* env, gtl::ArraySlice<tstring> prefixes,
     header.set_num_shards(merge.num_shards);
     header.set_endianness(merge.endianness);
     *header.mutable_version() = merge.version;
+    if (!merge.delta_base_prefix.empty()) {
+      header.set_delta_base_prefix(merge.delta_base_prefix);
+    }
     builder.Add(kHeaderEntryKey, header.SerializeAsString());
     // All others.
     for (const auto& p : merge.entries) {
@@ -816,6 +1007,7 @@ BundleReader::BundleReader(
     return;
   }
   num_shards_ = header.num_shards();
+  delta_base_prefix_ = header.delta_base_prefix();
   if ((header.endianness() == BundleHeaderProto::BIG && port::kLittleEndian) ||
       (header.endianness() == BundleHeaderProto::LITTLE &&
        !port::kLittleEndian)) {
@@ -825,6 +1017,11 @@ BundleReader::BundleReader(
                           kTensorBundleMinProducer, "Checkpoint", "checkpoint");
 }
 
+BundleReader::BundleReader(Env* env, StringPiece prefix, Options options)
+    : BundleReader(env, prefix, options.enable_multi_threading_for_testing) {
+  use_mmap_ = options.use_mmap;
+}
+
 BundleReader::~BundleReader() {
   delete metadata_;
   delete iter_;
@@ -869,9 +1066,87 @@ Status BundleReader::GetBundleEntryProto(StringPiece key,
   return OkStatus();
 }
 
-Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
+Status BundleReader::GetInputBuffer(int32_t shard_id,
+                                    io::InputBuffer** buffered_file) {
+  io::InputBuffer* buffer = data_[shard_id];
+  if (buffer == nullptr) {
+    std::unique_ptr<RandomAccessFile> file = nullptr;
+    TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
+        DataFilename(prefix_, shard_id, num_shards_), &file));
+    buffer = new io::InputBuffer(file.release(), kBufferSize);
+    // The InputBuffer and RandomAccessFile objects are both released in dtor.
+    data_[shard_id] = buffer;
+  }
+  *buffered_file = buffer;
+  return OkStatus();
+}
+
+Status BundleReader::GetValue(StringPiece tensor_key,
+                              const BundleEntryProto& entry, Tensor* val) {
+  io::InputBuffer* buffered_file = nullptr;
+  TF_RETURN_IF_ERROR(GetInputBuffer(entry.shard_id(), &buffered_file));
+  return GetValue(tensor_key, entry, buffered_file, val);
+}
+
+Status BundleReader::GetMappedShard(
+    int32_t shard_id, std::shared_ptr<ReadOnlyMemoryRegion>* region) {
+  mutex_lock l(mmap_mu_);
+  auto it = mmaps_.find(shard_id);
+  if (it == mmaps_.end()) {
+    std::unique_ptr<ReadOnlyMemoryRegion> mapping;
+    TF_RETURN_IF_ERROR(env_->NewReadOnlyMemoryRegionFromFile(
+        DataFilename(prefix_, shard_id, num_shards_), &mapping));
+    it = mmaps_
+             .emplace(shard_id,
+                      std::shared_ptr<ReadOnlyMemoryRegion>(mapping.release()))
+             .first;
+  }
+  *region = it->second;
+  return OkStatus();
+}
+
+Status BundleReader::GetValue(StringPiece tensor_key,
+                              const BundleEntryProto& entry,
+                              io::InputBuffer* buffered_file, Tensor* val) {
+  // Delta-encoded entries are reconstructed from the base bundle plus the
+  // stored chunks; in particular they can never alias a memory mapping of
+  // this bundle's data file.
+  if (entry.delta_encoded()) {
+    return GetDeltaValue(tensor_key, entry, buffered_file, val);
+  }
+
   Tensor* ret = val;
   const TensorShape stored_shape(TensorShape(entry.shape()));
+
+  // In mmap mode, fixed-width tensors of matching endianness are returned as
+  // views of the mapped data file: no bytes are copied, and N processes
+  // restoring the same bundle share one page-cache copy of the payload.
+  if (use_mmap_ && !need_to_swap_bytes_ &&
+      DataTypeCanUseMemcpy(entry.dtype())) {
+    const int64_t expected_bytes =
+        stored_shape.num_elements() * DataTypeSize(entry.dtype());
+    std::shared_ptr<ReadOnlyMemoryRegion> region;
+    if (GetMappedShard(entry.shard_id(), &region).ok() &&
+        static_cast<int64_t>(entry.size()) == expected_bytes &&
+        entry.offset() + entry.size() <= region->length()) {
+      char* data =
+          const_cast<char*>(static_cast<const char*>(region->data())) +
+          entry.offset();
+      if (reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment ==
+          0) {
+        // The stored checksum is intentionally not validated here: the pages
+        // are faulted in lazily by the kernel, and touching all of them to
+        // checksum would defeat the O(metadata) restore this mode provides.
+        auto* buffer =
+            new MmapTensorBuffer(std::move(region), data, entry.size());
+        *val = Tensor(entry.dtype(), stored_shape, buffer);
+        buffer->Unref();
+        return OkStatus();
+      }
+    }
+    // Fall through to the copying path: the file cannot be mapped, or the
+    // payload is not suitably sized/aligned for in-place use.
+  }
   if (val->NumElements() == 0) {
     ret = new Tensor(entry.dtype(), stored_shape);
   }
@@ -898,16 +1173,6 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
     }
   }
 
-  // Open the data file if it has not been opened.
-  io::InputBuffer* buffered_file = data_[entry.shard_id()];
-  if (buffered_file == nullptr) {
-    std::unique_ptr<RandomAccessFile> file = nullptr;
-    TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
-        DataFilename(prefix_, entry.shard_id(), num_shards_), &file));
-    buffered_file = new io::InputBuffer(file.release(), kBufferSize);
-    // The InputBuffer and RandomAccessFile objects are both released in dtor.
-    data_[entry.shard_id()] = buffered_file;
-  }
   CHECK(buffered_file != nullptr);
 
   TF_RETURN_IF_ERROR(buffered_file->Seek(entry.offset()));
@@ -1010,13 +1275,119 @@ Status BundleReader::GetValue(const BundleEntryProto& entry, Tensor* val) {
   return OkStatus();
 }
 
+Status BundleReader::GetDeltaValue(StringPiece tensor_key,
+                                   const BundleEntryProto& entry,
+                                   io::InputBuffer* buffered_file,
+                                   Tensor* val) {
+  DCHECK(entry.delta_encoded());
+  if (need_to_swap_bytes_) {
+    return errors::Unimplemented(
+        "TensorBundle at ", prefix_,
+        " is of a different endianness than this machine's hardware, and "
+        "contains delta-encoded tensors.  Byte-swapping of delta-encoded "
+        "tensors is not currently implemented.");
+  }
+  if (!DataTypeCanUseMemcpy(entry.dtype()) || entry.chunk_bytes() <= 0) {
+    return errors::DataLoss("Delta-encoded entry ", tensor_key,
+                            " has invalid dtype ",
+                            DataTypeString(entry.dtype()), " or chunk size ",
+                            entry.chunk_bytes());
+  }
+  if (delta_base_prefix_.empty()) {
+    return errors::DataLoss(
+        "Entry ", tensor_key,
+        " is delta-encoded but the bundle header names no base bundle");
+  }
+
+  const TensorShape stored_shape(TensorShape(entry.shape()));
+  Tensor* ret = val;
+  std::unique_ptr<Tensor> owned;
+  if (val->NumElements() == 0) {
+    owned = std::make_unique<Tensor>(entry.dtype(), stored_shape);
+    ret = owned.get();
+  }
+  const int64_t total_bytes = ret->TotalBytes();
+  const int64_t chunk_bytes = entry.chunk_bytes();
+
+  // Restores the base bundle's version of the tensor into the destination
+  // buffer; the chunks stored in this bundle are then patched in on top.  If
+  // the base is itself a delta bundle, its own GetDeltaValue() recurses down
+  // the chain.  The base reader is not thread-safe, so RestoreAll's worker
+  // threads serialize here.
+  {
+    mutex_lock l(delta_mu_);
+    if (delta_base_reader_ == nullptr) {
+      delta_base_reader_ =
+          std::make_unique<BundleReader>(env_, delta_base_prefix_);
+      if (!delta_base_reader_->status().ok()) {
+        Status s = delta_base_reader_->status();
+        delta_base_reader_.reset();
+        return errors::DataLoss("Unable to open the base bundle at ",
+                                delta_base_prefix_,
+                                " required to restore delta-encoded entry ",
+                                tensor_key, ": ", s.message());
+      }
+    }
+    TF_RETURN_IF_ERROR(delta_base_reader_->Lookup(tensor_key, ret));
+  }
+
+  char* backing_buffer = const_cast<char*>(ret->tensor_data().data());
+  TF_RETURN_IF_ERROR(buffered_file->Seek(entry.offset()));
+  uint32 actual_crc32c = 0;
+  int64_t delta_bytes = 0;
+  for (int32 index : entry.stored_chunks()) {
+    const int64_t begin = static_cast<int64_t>(index) * chunk_bytes;
+    if (index < 0 || begin >= total_bytes) {
+      return errors::DataLoss("Delta-encoded entry ", tensor_key,
+                              " stores out-of-range chunk ", index);
+    }
+    const int64_t len = std::min(chunk_bytes, total_bytes - begin);
+    size_t unused_bytes_read;
+    TF_RETURN_IF_ERROR(buffered_file->ReadNBytes(len, backing_buffer + begin,
+                                                 &unused_bytes_read));
+    actual_crc32c = crc32c::Extend(actual_crc32c, backing_buffer + begin, len);
+    delta_bytes += len;
+  }
+  if (delta_bytes != static_cast<int64_t>(entry.size())) {
+    return errors::DataLoss("Invalid size in delta bundle entry: key ",
+                            tensor_key, "; stored size ", entry.size(),
+                            "; chunks cover ", delta_bytes, " bytes");
+  }
+  if (crc32c::Unmask(entry.crc32c()) != actual_crc32c) {
+    return errors::DataLoss(
+        "TensorBundle at ", prefix_, " shard ", entry.shard_id(), " (",
+        entry.size(), " delta bytes): Checksum does not match: stored ",
+        strings::Printf("%08u", crc32c::Unmask(entry.crc32c())),
+        " vs. calculated on the restored bytes ", actual_crc32c);
+  }
+
+  // Validates the reconstructed content against the recorded chunk hashes.
+  // This also catches restoring against a base bundle other than the one
+  // this delta was encoded against.
+  for (int i = 0; i < entry.chunk_hashes_size(); ++i) {
+    const int64_t begin = static_cast<int64_t>(i) * chunk_bytes;
+    const int64_t len = std::min(chunk_bytes, total_bytes - begin);
+    if (Fingerprint64(StringPiece(backing_buffer + begin, len)) !=
+        entry.chunk_hashes(i)) {
+      return errors::DataLoss(
+          "Delta-restored tensor ", tensor_key, " does not match its recorded "
+          "content hash at chunk ", i, "; the base bundle at ",
+          delta_base_prefix_,
+          " may differ from the one this delta was encoded against");
+    }
+  }
+
+  *val = *ret;
+  return OkStatus();
+}
+
 Status BundleReader::Lookup(StringPiece key, Tensor* val) {
   CHECK(val != nullptr);
   BundleEntryProto entry;
   TF_RETURN_IF_ERROR(GetBundleEntryProto(key, &entry));
 
   if (entry.slices().empty()) {
-    return GetValue(entry, val);
+    return GetValue(key, entry, val);
   } else {
     return GetSliceValue(
         key, entry,
@@ -1024,6 +1395,102 @@ Status BundleReader::Lookup(StringPiece key, Tensor* val) {
   }
 }
 
+Status BundleReader::RestoreAll(gtl::ArraySlice<string> keys,
+                                gtl::ArraySlice<Tensor*> vals,
+                                int max_parallelism) {
+  if (keys.size() != vals.size()) {
+    return errors::InvalidArgument("RestoreAll was given ", keys.size(),
+                                   " keys but ", vals.size(), " tensors");
+  }
+
+  // Metadata pass, on the calling thread: the table iterator is not
+  // thread-safe.  Partitioned tensors are set aside for the slice path.
+  struct PendingRestore {
+    size_t index;
+    BundleEntryProto entry;
+  };
+  std::vector<PendingRestore> pending;
+  pending.reserve(keys.size());
+  std::vector<size_t> partitioned;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    CHECK(vals[i] != nullptr);
+    BundleEntryProto entry;
+    TF_RETURN_IF_ERROR(GetBundleEntryProto(keys[i], &entry));
+    if (entry.slices().empty()) {
+      pending.push_back({i, std::move(entry)});
+    } else {
+      partitioned.push_back(i);
+    }
+  }
+
+  // Sort by (shard, offset) so that each data file is swept forward exactly
+  // once, then carve the sorted sequence into contiguous per-worker ranges so
+  // the sweep stays sequential within each worker.
+  std::sort(pending.begin(), pending.end(),
+            [](const PendingRestore& a, const PendingRestore& b) {
+              if (a.entry.shard_id() != b.entry.shard_id()) {
+                return a.entry.shard_id() < b.entry.shard_id();
+              }
+              return a.entry.offset() < b.entry.offset();
+            });
+
+  const int num_workers = std::max<int>(
+      1, std::min<int64_t>(max_parallelism, pending.size()));
+  if (num_workers <= 1) {
+    for (const PendingRestore& p : pending) {
+      TF_RETURN_IF_ERROR(GetValue(keys[p.index], p.entry, vals[p.index]));
+    }
+  } else {
+    // Each worker opens its own file handles: the per-shard readers owned by
+    // this class hold seek positions and cannot be shared across threads.
+    auto restore_range = [this, &pending, &keys, &vals](size_t begin,
+                                                        size_t end) -> Status {
+      struct ShardFile {
+        std::unique_ptr<RandomAccessFile> file;
+        std::unique_ptr<io::InputBuffer> buffer;
+      };
+      std::unordered_map<int32_t, ShardFile> shards;
+      for (size_t i = begin; i < end; ++i) {
+        const PendingRestore& p = pending[i];
+        ShardFile& shard = shards[p.entry.shard_id()];
+        if (shard.buffer == nullptr) {
+          TF_RETURN_IF_ERROR(env_->NewRandomAccessFile(
+              DataFilename(prefix_, p.entry.shard_id(), num_shards_),
+              &shard.file));
+          shard.buffer =
+              std::make_unique<io::InputBuffer>(shard.file.get(), kBufferSize);
+        }
+        TF_RETURN_IF_ERROR(GetValue(keys[p.index], p.entry, shard.buffer.get(),
+                                    vals[p.index]));
+      }
+      return OkStatus();
+    };
+
+    const size_t range_size = (pending.size() + num_workers - 1) / num_workers;
+    std::vector<Status> statuses(num_workers);
+    {
+      thread::ThreadPool pool(Env::Default(), "bundle_restore_all",
+                              num_workers);
+      for (int w = 0; w < num_workers; ++w) {
+        const size_t begin = w * range_size;
+        const size_t end = std::min(begin + range_size, pending.size());
+        pool.Schedule([&restore_range, &statuses, w, begin, end]() {
+          statuses[w] = restore_range(begin, end);
+        });
+      }
+      // The pool destructor joins all scheduled work.
+    }
+    for (const Status& status : statuses) {
+      TF_RETURN_IF_ERROR(status);
+    }
+  }
+
+  for (size_t i : partitioned) {
+    TF_RETURN_IF_ERROR(Lookup(keys[i], vals[i]));
+  }
+  return OkStatus();
+}
+
 Status BundleReader::ReadCurrent(Tensor* val) {
   CHECK(val != nullptr);
   BundleEntryProto entry;
@@ -1034,7 +1501,7 @@ Status BundleReader::ReadCurrent(Tensor* val) {
   }
 
   if (entry.slices().empty()) {
-    return GetValue(entry, val);
+    return GetValue(iter_->key(), entry, val);
   } else {
     return GetSliceValue(
         iter_->key(), entry,
@@ -1104,6 +1571,7 @@ Status BundleReader::GetSliceValue(StringPiece full_tensor_key,
   // The union of the slices in "details" covers "slice_spec".  Performs the
   // copies from each.
   BundleEntryProto stored_slice_entry = full_tensor_entry;
+  string stored_slice_key = full_tensor_key_string;
   for (const auto& slice_tag_pair : details) {
     // Seeks for the stored slice.
     const TensorSlice& stored_slice = slice_tag_pair.first;
@@ -1111,11 +1579,10 @@ Status BundleReader::GetSliceValue(StringPiece full_tensor_key,
     // We already have the entry for the full tensor, so don't query again if
     // the slice is full.
     if (!stored_slice.IsFull()) {
-      const string encoded_stored_slice_name =
+      stored_slice_key =
           checkpoint::EncodeTensorNameSlice(full_tensor_key_string,
                                             stored_slice);
-      status_ =
-          GetBundleEntryProto(encoded_stored_slice_name, &stored_slice_entry);
+      status_ = GetBundleEntryProto(stored_slice_key, &stored_slice_entry);
       if (!status_.ok()) return status_;
     }
 
@@ -1136,12 +1603,13 @@ Status BundleReader::GetSliceValue(StringPiece full_tensor_key,
       VLOG(1) << "Optimized for common case: directly copying into "
                  "pre-allocated buffer; spec: "
               << slice_spec.DebugString();
-      status_ = GetValue(stored_slice_entry, val);
+      status_ = GetValue(stored_slice_key, stored_slice_entry, val);
       return status_;
     }
 
     Tensor stored_slice_tensor(stored_slice_entry.dtype(), stored_slice_shape);
-    status_ = GetValue(stored_slice_entry, &stored_slice_tensor);
+    status_ =
+        GetValue(stored_slice_key, stored_slice_entry, &stored_slice_tensor);
     if (!status_.ok()) return status_;
 
     // Copies the intersection over.
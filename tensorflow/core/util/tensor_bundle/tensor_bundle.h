@@ -75,6 +75,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/tensor_slice.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/lib/io/cache.h"
 #include "tensorflow/core/lib/io/inputbuffer.h"
@@ -83,6 +84,7 @@ limitations under the License.
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/file_system.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/tstring.h"
 #include "tensorflow/core/protobuf/tensor_bundle.pb.h"
@@ -106,6 +108,8 @@ extern const int kTensorBundleVersion;
 // corresponding value is a BundleHeaderProto.
 extern const char* const kHeaderEntryKey;
 
+class BundleReader;
+
 // Builds a string-string table of tensor names to BundleEntryProto (metadata).
 //
 // On construction, attempts to create a directory given by the dirname of
@@ -118,7 +122,34 @@ class BundleWriter {
     Options() {}
     // Alignment, in bytes, for tensor data.
     // Must be >= 1. The default size of 1 densely packs tensors.
+    // Set this to the page size (typically 4096) for bundles that will be
+    // consumed with BundleReader::Options::use_mmap, so that payloads can be
+    // aliased directly out of the file mapping.
     int data_alignment{1};
+
+    // When set, Add()/AddSlice() snapshot the tensor on the calling thread
+    // and return immediately; checksumming and file writes happen on a
+    // background thread, overlapping checkpoint I/O with the caller's next
+    // step.  Errors from background writes surface on a later Add() or, at
+    // the latest, on Finish(), which blocks until every queued payload has
+    // been handed to the data file.
+    bool async_write = false;
+
+    // When > 0, Add() records a Fingerprint64 content hash of every
+    // "delta_chunk_bytes"-sized chunk of each fixed-width tensor payload in
+    // its metadata entry, so that a later save can delta-encode against this
+    // bundle without re-reading its data files.
+    int64_t delta_chunk_bytes = 0;
+
+    // When non-empty, this bundle is saved as a delta against the bundle at
+    // this prefix: for tensors whose dtype, shape and chunking match the base
+    // bundle's entry of the same key, only the chunks whose content hash
+    // changed are written to the data file.  Restoring such entries requires
+    // the base bundle to remain readable at this prefix (chains of deltas are
+    // followed transitively).  If no bundle exists at the prefix, the save
+    // silently degrades to a full save, so the first checkpoint of a chain
+    // can use the same options.  Requires delta_chunk_bytes > 0.
+    std::string delta_base_prefix;
   };
   BundleWriter(Env* env, absl::string_view prefix,
                const Options& options = Options());
@@ -153,6 +184,24 @@ class BundleWriter {
   Status status() const { return status_; }
 
  private:
+  // Queues "val" for the background writer thread.  Assumes key uniqueness
+  // has already been checked and "entry" carries dtype and shape.
+  Status AddAsync(const Tensor& val, BundleEntryProto* entry);
+
+  // Fills in "entry"'s chunk hashes for "val" and, when a base bundle is
+  // available and the base entry for "key" matches dtype/shape/chunking,
+  // marks the entry delta-encoded with the indices of the changed chunks.
+  // Only runs on the calling thread of Add(), which keeps base_reader_
+  // access single-threaded even in async mode.
+  // REQUIRES: DataTypeCanUseMemcpy(val.dtype())
+  void MaybeDeltaEncode(absl::string_view key, const Tensor& val,
+                        BundleEntryProto* entry);
+
+  // Appends the payload of "val" to the data file, filling in "entry"'s
+  // offset, size and crc32c.  In async mode this only runs on the writer
+  // thread, which exclusively owns out_ and size_ until Finish().
+  Status WriteEntryPayload(const Tensor& val, BundleEntryProto* entry);
+
   Env* const env_;  // Not owned.
   const Options options_;
   const std::string prefix_;
@@ -164,6 +213,19 @@ class BundleWriter {
   std::map<std::string, BundleEntryProto> entries_;
   Status status_;
 
+  // Metadata reader for Options::delta_base_prefix.  Null when delta saving
+  // is off or no bundle exists at the base prefix.  Only used to look up the
+  // base entry protos; base payloads are never read during a save.
+  std::unique_ptr<BundleReader> base_reader_;
+
+  // Async write pipeline (Options::async_write): a single-threaded pool used
+  // as an ordered work queue.  The worker fills in each entry's payload
+  // fields through stable std::map node pointers; the calling thread only
+  // inserts new nodes, which does not disturb nodes the worker points at.
+  std::unique_ptr<thread::ThreadPool> async_writer_;
+  mutex mu_;
+  Status async_status_ TF_GUARDED_BY(mu_);
+
   BundleWriter(const BundleWriter&) = delete;
   void operator=(const BundleWriter&) = delete;
 };
@@ -200,8 +262,30 @@ Status MergeBundles(Env* env, gtl::ArraySlice<tstring> prefixes,
 // All threads accessing the same BundleReader must synchronize.
 class BundleReader {
  public:
+  struct Options {
+    Options() {}
+
+    // When set, each data file is memory-mapped on first access, and tensors
+    // whose payloads can be used in place (fixed-width dtype, matching
+    // endianness, alignment of at least Allocator::kAllocatorAlignment) are
+    // returned as read-only views of the mapping instead of being copied into
+    // freshly allocated buffers.  Processes restoring the same bundle then
+    // share a single page-cache copy of the data, and payloads are paged in
+    // on demand -- the stored checksum is not eagerly validated for aliased
+    // tensors, since touching every page would defeat the lazy mapping.
+    //
+    // Bundles meant for mmap consumption should be written with
+    // BundleWriter::Options::data_alignment set to the page size; payloads
+    // that are not suitably aligned silently fall back to the copying path.
+    // Tensors returned as views must not be mutated in place.
+    bool use_mmap = false;
+
+    bool enable_multi_threading_for_testing = false;
+  };
+
   BundleReader(Env* const env, absl::string_view prefix,
                bool enable_multi_threading_for_testing = false);
+  BundleReader(Env* const env, absl::string_view prefix, Options options);
   ~BundleReader();
 
   // Is ok() iff the reader construction is successful (completed the read of
@@ -251,6 +335,21 @@ class BundleReader {
   // REQUIRES: status().ok()
   Status Lookup(absl::string_view key, Tensor* val) TF_MUST_USE_RESULT;
 
+  // Looks up all tensors keyed by "keys" as one batch.  "vals[i]" receives
+  // the tensor keyed by "keys[i]" and follows the contract of Lookup().
+  //
+  // The entries are sorted by (shard id, file offset) so that each data file
+  // is read in a single forward sweep, and non-partitioned tensors are read
+  // and decoded concurrently on up to "max_parallelism" threads, each with
+  // its own file handle.  Partitioned tensors are restored on the calling
+  // thread, since the slice machinery relies on reader-local caches.
+  //
+  // On error, any element of "vals" may contain nonsense data.
+  // REQUIRES: status().ok() && keys.size() == vals.size()
+  // REQUIRES: all elements of "vals" are non-null
+  Status RestoreAll(gtl::ArraySlice<string> keys, gtl::ArraySlice<Tensor*> vals,
+                    int max_parallelism) TF_MUST_USE_RESULT;
+
   // Looks up the tensor pointed to by the internal iterator.
   //
   // On error, "val" may contain nonsense data.
@@ -304,11 +403,44 @@ class BundleReader {
   Status GetBundleEntryProto(absl::string_view key,
                              BundleEntryProto* entry) TF_MUST_USE_RESULT;
 
-  // Reads the tensor value described by the metadata proto "entry".
+  // Returns the buffered reader for data shard "shard_id", opening the
+  // underlying file on first use.  The returned buffer is owned by this class
+  // and must not be used concurrently from several threads.
+  Status GetInputBuffer(int32_t shard_id,
+                        io::InputBuffer** buffered_file) TF_MUST_USE_RESULT;
+
+  // Returns the shared memory mapping of data shard "shard_id", mapping the
+  // file on first use.  Only called when Options::use_mmap is set.
+  // Thread-safe.
+  Status GetMappedShard(int32_t shard_id,
+                        std::shared_ptr<ReadOnlyMemoryRegion>* region)
+      TF_MUST_USE_RESULT;
+
+  // Reads the tensor value described by the metadata proto "entry", keyed by
+  // "tensor_key" in the metadata table.
   // Usage for "val" follows the comment of "Lookup()".
-  Status GetValue(const BundleEntryProto& entry,
+  Status GetValue(absl::string_view tensor_key, const BundleEntryProto& entry,
                   Tensor* val) TF_MUST_USE_RESULT;
 
+  // As above, but reads from the supplied buffered reader instead of the
+  // per-shard reader owned by this class.  Only touches reader state that is
+  // immutable after construction, so concurrent calls with distinct buffers
+  // are safe -- except for delta-encoded entries, whose base lookups are
+  // serialized on delta_mu_.
+  Status GetValue(absl::string_view tensor_key, const BundleEntryProto& entry,
+                  io::InputBuffer* buffered_file,
+                  Tensor* val) TF_MUST_USE_RESULT;
+
+  // Reconstructs the delta-encoded tensor "tensor_key": restores the base
+  // bundle's version of the tensor into "val", then patches in the chunks
+  // stored in this bundle.  The base bundle is the one recorded in this
+  // bundle's header; chains of delta bundles are followed recursively.
+  // REQUIRES: entry.delta_encoded()
+  Status GetDeltaValue(absl::string_view tensor_key,
+                       const BundleEntryProto& entry,
+                       io::InputBuffer* buffered_file,
+                       Tensor* val) TF_MUST_USE_RESULT;
+
   // Reads the slice described by "slice_spec".  The corresponding full tensor
   // has key "ful_tensor_key" and metadata proto "full_tensor_entry".
   // REQUIRES: full_tensor_entry.slices_size() > 0
@@ -328,6 +460,22 @@ class BundleReader {
   // Owned the InputBuffer objects and their underlying RandomAccessFile's.
   std::unordered_map<int32_t, io::InputBuffer*> data_;
 
+  // Shared memory mappings of the data files, populated on first use when
+  // Options::use_mmap is set.  Tensors returned as views keep their own
+  // reference on the mapping, so entries may outlive this reader.
+  bool use_mmap_ = false;
+  mutex mmap_mu_;
+  std::unordered_map<int32_t, std::shared_ptr<ReadOnlyMemoryRegion>> mmaps_
+      TF_GUARDED_BY(mmap_mu_);
+
+  // Base bundle for delta-encoded entries, opened on first use from the
+  // prefix recorded in this bundle's header.  The reader is not thread-safe,
+  // so creation and lookups are serialized on delta_mu_ (RestoreAll may call
+  // GetValue from several worker threads).
+  std::string delta_base_prefix_;
+  mutex delta_mu_;
+  std::unique_ptr<BundleReader> delta_base_reader_ TF_GUARDED_BY(delta_mu_);
+
   // Maps each partitioned tensor's key to its stored slices (represented in a
   // TensorSliceSet).  Populated on-demand.
   std::unordered_map<std::string, checkpoint::TensorSliceSet*> tensor_slices_;
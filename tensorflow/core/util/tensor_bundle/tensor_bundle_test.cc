@@ -951,6 +951,256 @@ TEST(TensorBundleTest, SortForSequentialAccess) {
                           "tensor-1-2", "tensor-1-1", "tensor-1-0"));
 }
 
+TEST(TensorBundleTest, RestoreAll) {
+  Env* env = Env::Default();
+  const std::vector<string> kBundlePrefixes = {Prefix("batch-worker0"),
+                                               Prefix("batch-worker1")};
+  BundleWriter writer0(env, kBundlePrefixes[0]);
+  for (int i = 0; i < 3; ++i) {
+    TF_EXPECT_OK(writer0.Add(strings::StrCat("tensor-0-", i),
+                             Constant_2x3<float>(static_cast<float>(i))));
+  }
+  TF_ASSERT_OK(writer0.Finish());
+
+  BundleWriter writer1(env, kBundlePrefixes[1]);
+  for (int i = 2; i >= 0; --i) {
+    TF_EXPECT_OK(writer1.Add(strings::StrCat("tensor-1-", i),
+                             Constant_2x3<float>(static_cast<float>(10 + i))));
+  }
+  TF_ASSERT_OK(writer1.Finish());
+
+  const string kMerged = Prefix("batch-merged");
+  TF_ASSERT_OK(
+      MergeBundles(env, {kBundlePrefixes[0], kBundlePrefixes[1]}, kMerged));
+
+  BundleReader reader(env, kMerged);
+  TF_ASSERT_OK(reader.status());
+  // Keys deliberately interleave the two shards and are not in offset order.
+  const std::vector<string> keys = {"tensor-1-0", "tensor-0-1", "tensor-1-2",
+                                    "tensor-0-0", "tensor-1-1", "tensor-0-2"};
+  const std::vector<float> expected = {10., 1., 12., 0., 11., 2.};
+  for (int max_parallelism : {1, 3}) {
+    std::vector<Tensor> tensors(keys.size(),
+                                Tensor(DT_FLOAT, TensorShape({2, 3})));
+    std::vector<Tensor*> vals;
+    for (Tensor& t : tensors) vals.push_back(&t);
+    TF_ASSERT_OK(reader.RestoreAll(keys, vals, max_parallelism));
+    for (size_t i = 0; i < keys.size(); ++i) {
+      test::ExpectTensorEqual<float>(tensors[i],
+                                     Constant_2x3<float>(expected[i]));
+    }
+  }
+
+  // Mismatched keys/vals sizes should be rejected.
+  std::vector<Tensor*> no_vals;
+  EXPECT_FALSE(reader.RestoreAll(keys, no_vals, 1).ok());
+}
+
+TEST(TensorBundleTest, AsyncWrite) {
+  {
+    BundleWriter::Options options;
+    options.async_write = true;
+    BundleWriter writer(Env::Default(), Prefix("async"), options);
+    Tensor mutated = Constant_2x3<float>(1.);
+    TF_EXPECT_OK(writer.Add("async_a", mutated));
+    // The payload must have been snapshotted: mutating the source tensor
+    // after Add() returns must not change what gets written.
+    mutated.flat<float>().setConstant(-1.);
+    TF_EXPECT_OK(writer.Add("async_b", Constant_100x100<int>(7)));
+    Tensor strings(DT_STRING, TensorShape({2}));
+    strings.flat<tstring>()(0) = "hello";
+    strings.flat<tstring>()(1) = "world";
+    TF_EXPECT_OK(writer.Add("strings", strings));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  {
+    // Duplicate keys are still rejected on the calling thread.
+    BundleWriter::Options options;
+    options.async_write = true;
+    BundleWriter writer(Env::Default(), Prefix("async_dup"), options);
+    TF_EXPECT_OK(writer.Add("key", Constant_2x3<float>(1.)));
+    EXPECT_FALSE(writer.Add("key", Constant_2x3<float>(2.)).ok());
+  }
+  BundleReader reader(Env::Default(), Prefix("async"));
+  TF_ASSERT_OK(reader.status());
+  Expect<float>(&reader, "async_a", Constant_2x3<float>(1.));
+  Expect<int>(&reader, "async_b", Constant_100x100<int>(7));
+  Tensor strings(DT_STRING, TensorShape({2}));
+  TF_ASSERT_OK(reader.Lookup("strings", &strings));
+  EXPECT_EQ(strings.flat<tstring>()(0), "hello");
+  EXPECT_EQ(strings.flat<tstring>()(1), "world");
+}
+
+TEST(TensorBundleTest, MmapBackedRestore) {
+  {
+    BundleWriter::Options options;
+    options.data_alignment = 4096;
+    BundleWriter writer(Env::Default(), Prefix("mmap"), options);
+    TF_ASSERT_OK(writer.Add("mapped_a", Constant_2x3<float>(1.)));
+    TF_ASSERT_OK(writer.Add("mapped_b", Constant_100x100<int>(7)));
+    Tensor strings(DT_STRING, TensorShape({2}));
+    strings.flat<tstring>()(0) = "hello";
+    strings.flat<tstring>()(1) = "world";
+    TF_ASSERT_OK(writer.Add("strings", strings));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options options;
+  options.use_mmap = true;
+  BundleReader reader(Env::Default(), Prefix("mmap"), options);
+  TF_ASSERT_OK(reader.status());
+
+  Expect<float>(&reader, "mapped_a", Constant_2x3<float>(1.));
+  Expect<int>(&reader, "mapped_b", Constant_100x100<int>(7));
+
+  // Two lookups of the same key must alias the same mapped payload instead of
+  // copying it.
+  Tensor first(DT_FLOAT, TensorShape({2, 3}));
+  Tensor second(DT_FLOAT, TensorShape({2, 3}));
+  TF_ASSERT_OK(reader.Lookup("mapped_a", &first));
+  TF_ASSERT_OK(reader.Lookup("mapped_a", &second));
+  EXPECT_EQ(first.tensor_data().data(), second.tensor_data().data());
+
+  // String tensors cannot be aliased and fall back to the copying path.
+  Tensor strings(DT_STRING, TensorShape({2}));
+  TF_ASSERT_OK(reader.Lookup("strings", &strings));
+  EXPECT_EQ(strings.flat<tstring>()(0), "hello");
+  EXPECT_EQ(strings.flat<tstring>()(1), "world");
+}
+
+TEST(TensorBundleTest, DeltaSave) {
+  const int64_t kChunk = 100 * sizeof(float);  // One row of a 100x100 tensor.
+  Tensor base_big = Constant_100x100<float>(1.);
+  {
+    BundleWriter::Options options;
+    options.delta_chunk_bytes = kChunk;
+    BundleWriter writer(Env::Default(), Prefix("delta-base"), options);
+    TF_ASSERT_OK(writer.Add("big", base_big));
+    TF_ASSERT_OK(writer.Add("small", Constant_2x3<int>(3)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  uint64 base_data_size;
+  TF_ASSERT_OK(Env::Default()->GetFileSize(
+      DataFilename(Prefix("delta-base"), 0, 1), &base_data_size));
+
+  // Second save: one row of "big" changes, "small" is untouched.
+  Tensor delta_big = tensor::DeepCopy(base_big);
+  for (int i = 0; i < 100; ++i) delta_big.matrix<float>()(42, i) = -1.;
+  {
+    BundleWriter::Options options;
+    options.delta_chunk_bytes = kChunk;
+    options.delta_base_prefix = Prefix("delta-base");
+    BundleWriter writer(Env::Default(), Prefix("delta-1"), options);
+    TF_ASSERT_OK(writer.Add("big", delta_big));
+    TF_ASSERT_OK(writer.Add("small", Constant_2x3<int>(3)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  // Only the single changed chunk is stored in the delta's data file.
+  uint64 delta_data_size;
+  TF_ASSERT_OK(Env::Default()->GetFileSize(
+      DataFilename(Prefix("delta-1"), 0, 1), &delta_data_size));
+  EXPECT_LT(delta_data_size, base_data_size / 10);
+  {
+    BundleReader reader(Env::Default(), Prefix("delta-1"));
+    TF_ASSERT_OK(reader.status());
+    Expect<float>(&reader, "big", delta_big);
+    Expect<int>(&reader, "small", Constant_2x3<int>(3));
+  }
+  // The base bundle restores unchanged.
+  {
+    BundleReader reader(Env::Default(), Prefix("delta-base"));
+    TF_ASSERT_OK(reader.status());
+    Expect<float>(&reader, "big", base_big);
+  }
+
+  // Third save deltas against the second: restoring follows the chain
+  // delta-2 -> delta-1 -> delta-base.
+  Tensor chained_big = tensor::DeepCopy(delta_big);
+  for (int i = 0; i < 100; ++i) chained_big.matrix<float>()(7, i) = 2.;
+  {
+    BundleWriter::Options options;
+    options.delta_chunk_bytes = kChunk;
+    options.delta_base_prefix = Prefix("delta-1");
+    BundleWriter writer(Env::Default(), Prefix("delta-2"), options);
+    TF_ASSERT_OK(writer.Add("big", chained_big));
+    TF_ASSERT_OK(writer.Add("small", Constant_2x3<int>(3)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader reader(Env::Default(), Prefix("delta-2"));
+  TF_ASSERT_OK(reader.status());
+  Expect<float>(&reader, "big", chained_big);
+  Expect<int>(&reader, "small", Constant_2x3<int>(3));
+  Tensor big(DT_FLOAT, TensorShape({100, 100}));
+  Tensor small(DT_INT32, TensorShape({2, 3}));
+  TF_ASSERT_OK(
+      reader.RestoreAll({"big", "small"}, {&big, &small},
+                        /*max_parallelism=*/2));
+  test::ExpectTensorEqual<float>(big, chained_big);
+}
+
+TEST(TensorBundleTest, DeltaSaveMissingOrMismatchedBase) {
+  {
+    // No bundle at the base prefix: degrades to a full save that still
+    // restores without the base.
+    BundleWriter::Options options;
+    options.delta_chunk_bytes = 512;
+    options.delta_base_prefix = Prefix("delta-nonexistent");
+    BundleWriter writer(Env::Default(), Prefix("delta-first"), options);
+    TF_ASSERT_OK(writer.status());
+    TF_ASSERT_OK(writer.Add("a", Constant_100x100<float>(1.)));
+    TF_ASSERT_OK(writer.Finish());
+    BundleReader reader(Env::Default(), Prefix("delta-first"));
+    TF_ASSERT_OK(reader.status());
+    Expect<float>(&reader, "a", Constant_100x100<float>(1.));
+  }
+  {
+    // A tensor whose shape changed relative to the base is written in full.
+    BundleWriter::Options options;
+    options.delta_chunk_bytes = 512;
+    options.delta_base_prefix = Prefix("delta-first");
+    BundleWriter writer(Env::Default(), Prefix("delta-reshaped"), options);
+    TF_ASSERT_OK(writer.Add("a", Constant_2x3<float>(1.)));
+    TF_ASSERT_OK(writer.Finish());
+    BundleReader reader(Env::Default(), Prefix("delta-reshaped"));
+    TF_ASSERT_OK(reader.status());
+    Expect<float>(&reader, "a", Constant_2x3<float>(1.));
+  }
+  {
+    // delta_base_prefix without a chunk size is rejected up front.
+    BundleWriter::Options options;
+    options.delta_base_prefix = Prefix("delta-first");
+    BundleWriter writer(Env::Default(), Prefix("delta-bad-options"), options);
+    EXPECT_FALSE(writer.status().ok());
+  }
+}
+
+TEST(TensorBundleTest, RestoreAllPartitioned) {
+  // A partitioned tensor falls back to the slice path inside RestoreAll().
+  {
+    BundleWriter writer(Env::Default(), Prefix("batch-sliced"));
+    TF_ASSERT_OK(writer.AddSlice("partitioned", TensorShape({4, 3}),
+                                 TensorSlice::ParseOrDie("0,2:-"),
+                                 Constant_2x3<float>(1.)));
+    TF_ASSERT_OK(writer.AddSlice("partitioned", TensorShape({4, 3}),
+                                 TensorSlice::ParseOrDie("2,2:-"),
+                                 Constant_2x3<float>(2.)));
+    TF_ASSERT_OK(writer.Add("whole", Constant_2x3<float>(3.)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader reader(Env::Default(), Prefix("batch-sliced"));
+  TF_ASSERT_OK(reader.status());
+  Tensor partitioned(DT_FLOAT, TensorShape({4, 3}));
+  Tensor whole(DT_FLOAT, TensorShape({2, 3}));
+  TF_ASSERT_OK(reader.RestoreAll({"partitioned", "whole"},
+                                 {&partitioned, &whole},
+                                 /*max_parallelism=*/2));
+  Tensor expected_partitioned(DT_FLOAT, TensorShape({4, 3}));
+  for (int i = 0; i < 12; ++i) {
+    expected_partitioned.flat<float>()(i) = i < 6 ? 1. : 2.;
+  }
+  test::ExpectTensorEqual<float>(partitioned, expected_partitioned);
+  test::ExpectTensorEqual<float>(whole, Constant_2x3<float>(3.));
+}
+
 TEST(TensorBundleTest, Error) {
   {  // Dup keys.
     BundleWriter writer(Env::Default(), Prefix("dup"));
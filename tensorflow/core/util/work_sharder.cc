@@ -16,10 +16,15 @@ limitations under the License.
 #include "tensorflow/core/util/work_sharder.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <string>
+#include <unordered_map>
 
 #include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env_time.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tsl/profiler/lib/traceme.h"
 #include "tsl/util/env_var.h"
 
@@ -43,8 +48,108 @@ bool UseEigenParallelFor() {
   return result;
 }
 
+// Online cost model for Shard2(): an EWMA of measured per-unit cost in
+// nanoseconds, keyed by the caller-provided cost key. Entries are never
+// evicted; keys are op names plus shape signatures, a small set in practice.
+class ShardCostModel {
+ public:
+  static ShardCostModel* Global() {
+    static ShardCostModel* model = new ShardCostModel;
+    return model;
+  }
+
+  // Returns the current estimate, or kDefaultCostNs for unseen keys.
+  double GetCost(StringPiece key) {
+    mutex_lock l(mu_);
+    auto it = costs_.find(string(key));
+    return it == costs_.end() ? kDefaultCostNs : it->second;
+  }
+
+  void Update(StringPiece key, double measured_cost_ns) {
+    mutex_lock l(mu_);
+    auto insert_result = costs_.emplace(string(key), measured_cost_ns);
+    if (!insert_result.second) {
+      double& cost = insert_result.first->second;
+      cost += kAlpha * (measured_cost_ns - cost);
+    }
+  }
+
+ private:
+  // Assume unseen work is cheap; the claim cursor keeps cores busy even when
+  // the estimate is off, so a bad first guess only costs some chunking
+  // overhead.
+  static constexpr double kDefaultCostNs = 100.0;
+  static constexpr double kAlpha = 0.25;
+
+  mutex mu_;
+  std::unordered_map<string, double> costs_ TF_GUARDED_BY(mu_);
+};
+
 }  // namespace
 
+void Shard2(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+            StringPiece cost_key, std::function<void(int64_t, int64_t)> work) {
+  CHECK_GE(total, 0);
+  if (total == 0) {
+    return;
+  }
+  max_parallelism = std::min(max_parallelism, GetPerThreadMaxParallelism());
+  const uint64 start_ns = EnvTime::NowNanos();
+  if (max_parallelism <= 1) {
+    work(0, total);
+    ShardCostModel::Global()->Update(
+        cost_key,
+        static_cast<double>(EnvTime::NowNanos() - start_ns) / total);
+    return;
+  }
+
+  // Size chunks so each costs roughly kTargetChunkCostNs, but keep enough
+  // chunks around that early finishers have something to steal.
+  static constexpr double kTargetChunkCostNs = 10000.0;  // 10us
+  const double cost_per_unit = ShardCostModel::Global()->GetCost(cost_key);
+  int64_t chunk_size = std::max<int64_t>(
+      1, static_cast<int64_t>(kTargetChunkCostNs / cost_per_unit));
+  const int num_workers = std::max<int>(
+      1, std::min<int64_t>({static_cast<int64_t>(max_parallelism),
+                            static_cast<int64_t>(workers->NumThreads()) + 1,
+                            (total + chunk_size - 1) / chunk_size}));
+  chunk_size = std::min(chunk_size,
+                        std::max<int64_t>(1, total / (num_workers * 4)));
+
+  tsl::profiler::TraceMe trace_me([&]() {
+    return tsl::profiler::TraceMeEncode("Shard2", {{"total", total},
+                                                   {"chunk_size", chunk_size},
+                                                   {"num_workers", num_workers}});
+  });
+
+  // The claim cursor: a participant owns [i, min(i + chunk_size, total)) iff
+  // its fetch_add returned i. No locks are taken on the claim path.
+  std::atomic<int64_t> next(0);
+  auto run_chunks = [&next, chunk_size, total, &work]() {
+    for (int64_t start = next.fetch_add(chunk_size, std::memory_order_relaxed);
+         start < total;
+         start = next.fetch_add(chunk_size, std::memory_order_relaxed)) {
+      work(start, std::min(start + chunk_size, total));
+    }
+  };
+
+  BlockingCounter counter(num_workers - 1);
+  for (int i = 0; i < num_workers - 1; ++i) {
+    workers->Schedule([&run_chunks, &counter]() {
+      run_chunks();
+      counter.DecrementCount();
+    });
+  }
+  run_chunks();
+  counter.Wait();
+
+  // Approximate busy time as wall time times the number of participants.
+  const double measured_cost_ns =
+      static_cast<double>(EnvTime::NowNanos() - start_ns) * num_workers /
+      total;
+  ShardCostModel::Global()->Update(cost_key, measured_cost_ns);
+}
+
 /* ABSL_CONST_INIT */ thread_local int per_thread_max_parallelism = 1000000;
 
 void SetPerThreadMaxParallelism(int max_parallelism) {
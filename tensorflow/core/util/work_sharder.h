@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <functional>
 
+#include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/platform/types.h"
 
@@ -59,6 +60,22 @@ namespace tensorflow {
 void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
            int64_t cost_per_unit, std::function<void(int64_t, int64_t)> work);
 
+// Like Shard(), but does not trust a caller-guessed cost_per_unit. Work is
+// split into small chunks that the participating threads claim with an atomic
+// cursor, so threads that finish early steal the remaining chunks instead of
+// idling behind a bad static split. The measured per-unit cost is folded into
+// a process-wide EWMA keyed by "cost_key" (typically op name plus a shape
+// signature) and used to size chunks on subsequent calls with the same key.
+//
+// Kernels can migrate to Shard2() incrementally; the work callable has the
+// same contract as for Shard().
+//
+// REQUIRES: max_parallelism >= 0
+// REQUIRES: workers != nullptr
+// REQUIRES: total >= 0
+void Shard2(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+            StringPiece cost_key, std::function<void(int64_t, int64_t)> work);
+
 // Each thread has an associated option to express the desired maximum
 // parallelism. Its default is a very large quantity.
 //
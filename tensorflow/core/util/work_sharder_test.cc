@@ -79,6 +79,41 @@ TEST(Shard, Basic) {
   }
 }
 
+TEST(Shard2, Basic) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  for (auto workers : {1, 2, 3, 7, 16, 100}) {
+    for (auto total : {0, 1, 7, 64, 1000, 9999}) {
+      mutex mu;
+      int64_t num_done_work = 0;
+      std::vector<bool> work(total, false);
+      // Repeated calls with the same key exercise the cost-model update.
+      Shard2(workers, &threads, total, "Shard2BasicTest",
+             [=, &mu, &num_done_work, &work](int64_t start, int64_t limit) {
+               EXPECT_GE(start, 0);
+               EXPECT_LE(limit, total);
+               mutex_lock l(mu);
+               for (; start < limit; ++start) {
+                 EXPECT_FALSE(work[start]);  // No duplicate
+                 ++num_done_work;
+                 work[start] = true;
+               }
+             });
+      EXPECT_EQ(num_done_work, total);
+    }
+  }
+}
+
+TEST(Shard2, HonorsPerThreadMaxParallelism) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  ScopedPerThreadMaxParallelism s(1);
+  std::atomic<int64_t> num_elements(0);
+  Shard2(16, &threads, 1000, "Shard2SerialTest",
+         [&num_elements](int64_t start, int64_t limit) {
+           num_elements += limit - start;
+         });
+  EXPECT_EQ(num_elements.load(), 1000);
+}
+
 TEST(Shard, OverflowTest) {
   thread::ThreadPool threads(Env::Default(), "test", 3);
   for (auto workers : {1, 2, 3}) {
@@ -133,6 +133,13 @@ DTensorMlirPassRunner::ImportGraphToMlir(
       mlir::IntegerAttr::get(mlir::IntegerType::get(&context_, /*width=*/64),
                              topo_dist));
 
+  int64_t max_bucket_bytes =
+      dtensor::AllReduceCombineOptimizationMaxBucketBytes();
+  module->setAttr(
+      dtensor::kAllReduceMaxBucketBytes,
+      mlir::IntegerAttr::get(mlir::IntegerType::get(&context_, /*width=*/64),
+                             max_bucket_bytes));
+
   if (dtensor::EnableMultiDeviceMode()) {
     module->setAttr(dtensor::kEnableMultiDeviceMode,
                     mlir::BoolAttr::get(&context_, true));
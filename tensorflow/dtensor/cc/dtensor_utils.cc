@@ -176,6 +176,24 @@ int AllReduceCombineOptimizationTopologicalDistance() {
   return topo_dist;
 }
 
+int64_t AllReduceCombineOptimizationMaxBucketBytes() {
+  int64_t bucket_bytes;
+  absl::Status status = tsl::ReadInt64FromEnvVar(
+      "DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_BUCKET_BYTES",
+      /*default_val=*/0, &bucket_bytes);
+  if (!status.ok()) {
+    LOG(WARNING) << "Invalid DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_BUCKET"
+                    "_BYTES, using the default value 0.";
+    return 0;
+  } else if (bucket_bytes < 0) {
+    LOG(WARNING) << "Invalid DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_BUCKET"
+                    "_BYTES, value must be a positive integer, using the "
+                    "default value 0.";
+    return 0;
+  }
+  return bucket_bytes;
+}
+
 bool EnableMultiDeviceMode() {
   bool multi_device_mode;
   absl::Status status = tsl::ReadBoolFromEnvVar(
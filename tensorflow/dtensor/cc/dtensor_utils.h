@@ -84,6 +84,15 @@ int AllReduceCombineOptimizationGroupSize();
 // extended grouping.
 int AllReduceCombineOptimizationTopologicalDistance();
 
+// Returns the maximum total payload, in bytes, of one merged AllReduce
+// produced by dtensor_allreduce_combine_optimization. Groups larger than this
+// are split into multiple bucketed launches, so the first bucket's collective
+// can start while later buckets are still being produced. The input value
+// should be in range of [0, INT64_MAX]; zero disables bucketing. It is
+// advised to pick a value of a few tens of megabytes so per-launch overheads
+// stay amortized without serializing the whole step behind one launch.
+int64_t AllReduceCombineOptimizationMaxBucketBytes();
+
 // Returns whether to perform multi-device expansion.
 bool EnableMultiDeviceMode();
 }  // namespace dtensor
@@ -631,6 +631,52 @@ createSubgroupsByTopoDist(
   return all_reduce_new_groups;
 }
 
+// Extended grouping logic to bound the payload of one merged AllReduce.
+// This function further breaks down the current groups so that the total
+// payload of each merged launch stays within max_bucket_bytes, similar to the
+// gradient bucketing performed by tf.distribute. Bucketed launches keep
+// per-launch overheads amortized while allowing the first bucket's collective
+// to overlap with the production of later buckets. Note that a single
+// AllReduce larger than max_bucket_bytes forms a bucket of its own; it is
+// never split. When max_bucket_bytes is too big, the function will act as
+// aggressive grouping. When max_bucket_bytes is too small, the function will
+// act as having no extended grouping.
+std::vector<std::vector<mlir::TF::DTensorAllReduceOp>>
+createSubgroupsByMaxBucketBytes(
+    std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_groups,
+    int64_t max_bucket_bytes) {
+  VLOG(4) << "max payload bytes of an all-reduce group: " << max_bucket_bytes;
+  // Disable extended grouping if the bucket size is set to zero or less.
+  if (max_bucket_bytes <= 0) return all_reduce_groups;
+  std::vector<std::vector<mlir::TF::DTensorAllReduceOp>> all_reduce_new_groups;
+  for (const auto& all_reduce_group : all_reduce_groups) {
+    std::vector<mlir::TF::DTensorAllReduceOp> new_group;
+    int64_t bucket_bytes = 0;
+    for (mlir::TF::DTensorAllReduceOp all_reduce : all_reduce_group) {
+      auto ranked_type =
+          all_reduce.getType().dyn_cast<mlir::RankedTensorType>();
+      // Only all-reduces with static shapes are collected for combining, so
+      // the payload size is always known here.
+      DCHECK(ranked_type && ranked_type.hasStaticShape());
+      const int64_t all_reduce_bytes =
+          ranked_type.getNumElements() *
+          (ranked_type.getElementType().getIntOrFloatBitWidth() / 8);
+      if (!new_group.empty() &&
+          bucket_bytes + all_reduce_bytes > max_bucket_bytes) {
+        all_reduce_new_groups.push_back(new_group);
+        new_group.clear();
+        bucket_bytes = 0;
+      }
+      new_group.push_back(all_reduce);
+      bucket_bytes += all_reduce_bytes;
+    }
+    if (!new_group.empty()) all_reduce_new_groups.push_back(new_group);
+  }
+  VLOG(4) << "current number of groups: " << all_reduce_new_groups.size()
+          << " after grouping by max bucket bytes.";
+  return all_reduce_new_groups;
+}
+
 // Compute the topological level for each AllReduce op in a cluster. The level
 // is defined as 1 + max operands' depth in the compute graph. If an op do not
 // depend on any input/operand, then it is level 0.
@@ -738,6 +784,15 @@ struct DTensorAllReduceCombineOptimization
                   .getInt());
         }
 
+        // Experimental extended grouping: maximum payload bytes per launch
+        if (module->hasAttrOfType<mlir::IntegerAttr>(
+                kAllReduceMaxBucketBytes)) {
+          all_reduce_groups = createSubgroupsByMaxBucketBytes(
+              all_reduce_groups,
+              module->getAttrOfType<mlir::IntegerAttr>(kAllReduceMaxBucketBytes)
+                  .getInt());
+        }
+
         // Maintain relative order of ALLReduces within the block.
         std::sort(all_reduce_groups.begin(), all_reduce_groups.end(),
                   [](std::vector<mlir::TF::DTensorAllReduceOp> lhs,
@@ -273,3 +273,36 @@ module attributes {dtensor.all_reduce_combiner.topological_distance = 2} {
     "func.return"() : () -> ()
   }
 }
+
+// -----
+module attributes {dtensor.all_reduce_combiner.max_bucket_bytes = 128} {
+  // Check that when
+  // DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_BUCKET_BYTES is set, independent
+  // DTensorAllReduce ops of the same element type and group assignment are
+  // split into buckets whose total payload stays within the byte limit. Use of
+  // dummy AllReduces (of the same input) gaurantees ops to be grouped together
+  // if envvar is not specified.
+  // Each AllReduce below carries a 4x4xf32 payload, i.e. 64 bytes. Without the
+  // envvar set, the 3 AllReduces form a single group. With
+  // DTENSOR_ALLREDUCE_COMBINE_OPTIMIZATION_MAX_BUCKET_BYTES=128, we expect:
+  // bucket 1: 2 all reduces (128 bytes, merged)
+  // bucket 2: 1 all reduce (64 bytes, left as is)
+  // CHECK-LABEL: func @main
+  func.func @main() {
+    // CHECK:      %[[ALL_REDUCE_1:.*]] = "tf.DTensorAllReduce"
+    // CHECK-SAME:   (tensor<1024xf32>, tensor<2x2xi32>) -> tensor<1024xf32>
+    // CHECK:      %[[ALL_REDUCE_2:.*]] = "tf.DTensorAllReduce"
+    // CHECK-SAME:   (tensor<4x4xf32>, tensor<2x2xi32>) -> tensor<4x4xf32>
+    %0 = "tf_device.cluster"() ({
+      %1 = "tf.Const"() {value = dense<0.0> : tensor<4x4xf32>} : () -> tensor<4x4xf32>
+      %2 = "tf.Const"() {value = dense<[[0, 1], [2, 3]]> : tensor<2x2xi32>} : () -> tensor<2x2xi32>
+      %3 = "tf.DTensorAllReduce"(%1, %2) {_layout = ["sharding_specs:x,y, mesh:|x=2,y=2|*GPU"], device_type = "GPU", reduce_op = "Add"} : (tensor<4x4xf32>, tensor<2x2xi32>) -> tensor<4x4xf32>
+      %4 = "tf.DTensorAllReduce"(%1, %2) {_layout = ["sharding_specs:x,y, mesh:|x=2,y=2|*GPU"], device_type = "GPU", reduce_op = "Add"} : (tensor<4x4xf32>, tensor<2x2xi32>) -> tensor<4x4xf32>
+      %5 = "tf.DTensorAllReduce"(%1, %2) {_layout = ["sharding_specs:x,y, mesh:|x=2,y=2|*GPU"], device_type = "GPU", reduce_op = "Add"} : (tensor<4x4xf32>, tensor<2x2xi32>) -> tensor<4x4xf32>
+      %6 = "tf.Add"(%4, %5) : (tensor<4x4xf32>, tensor<4x4xf32>) -> tensor<4x4xf32>
+      %7 = "tf.Add"(%3, %6) : (tensor<4x4xf32>, tensor<4x4xf32>) -> tensor<4x4xf32>
+      "tf_device.return"(%7) : (tensor<4x4xf32>) -> ()
+    }) : () -> tensor<4x4xf32>
+    "func.return"() : () -> ()
+  }
+}
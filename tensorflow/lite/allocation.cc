@@ -22,6 +22,7 @@ limitations under the License.
 #include <cstdint>
 #include <cstdio>
 #include <memory>
+#include <utility>
 
 #include "tensorflow/lite/core/api/error_reporter.h"
 
@@ -112,4 +113,23 @@ size_t MemoryAllocation::bytes() const { return buffer_size_bytes_; }
 
 bool MemoryAllocation::valid() const { return buffer_ != nullptr; }
 
+SharedAllocation::SharedAllocation(std::shared_ptr<const Allocation> allocation,
+                                   ErrorReporter* error_reporter)
+    : Allocation(error_reporter, Allocation::Type::kShared),
+      shared_allocation_(std::move(allocation)) {}
+
+SharedAllocation::~SharedAllocation() {}
+
+const void* SharedAllocation::base() const {
+  return shared_allocation_ ? shared_allocation_->base() : nullptr;
+}
+
+size_t SharedAllocation::bytes() const {
+  return shared_allocation_ ? shared_allocation_->bytes() : 0;
+}
+
+bool SharedAllocation::valid() const {
+  return shared_allocation_ != nullptr && shared_allocation_->valid();
+}
+
 }  // namespace tflite
@@ -37,6 +37,7 @@ class Allocation {
     kMMap,
     kFileCopy,
     kMemory,
+    kShared,
   };
 
   /// Base pointer of this allocation
@@ -148,6 +149,25 @@ class MemoryAllocation : public Allocation {
   size_t buffer_size_bytes_ = 0;
 };
 
+class SharedAllocation : public Allocation {
+ public:
+  /// Provides a view of an allocation that is shared with other users, e.g.
+  /// several FlatBufferModel instances referencing a single copy of the model
+  /// weights. The underlying allocation is kept alive for as long as any view
+  /// of it exists.
+  /// Note: `type()` reports `Type::kShared`, not the type of the underlying
+  /// allocation.
+  SharedAllocation(std::shared_ptr<const Allocation> allocation,
+                   ErrorReporter* error_reporter);
+  ~SharedAllocation() override;
+  const void* base() const override;
+  size_t bytes() const override;
+  bool valid() const override;
+
+ private:
+  std::shared_ptr<const Allocation> shared_allocation_;
+};
+
 }  // namespace tflite
 
 #endif  // TENSORFLOW_LITE_ALLOCATION_H_
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <sys/stat.h>
 
+#include <memory>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -142,4 +143,46 @@ TEST(MMAPAllocation, TestValidFileDescriptorWithOffset) {
 }
 #endif  // defined(__linux__)
 
+TEST(SharedAllocation, TestViewsShareBuffer) {
+  const char buffer[] = "test buffer";
+
+  TestErrorReporter error_reporter;
+  auto memory_allocation = std::make_shared<MemoryAllocation>(
+      buffer, sizeof(buffer), &error_reporter);
+  ASSERT_TRUE(memory_allocation->valid());
+
+  SharedAllocation view_1(memory_allocation, &error_reporter);
+  SharedAllocation view_2(memory_allocation, &error_reporter);
+
+  EXPECT_TRUE(view_1.valid());
+  EXPECT_TRUE(view_2.valid());
+  EXPECT_EQ(view_1.base(), memory_allocation->base());
+  EXPECT_EQ(view_2.base(), memory_allocation->base());
+  EXPECT_EQ(view_1.bytes(), memory_allocation->bytes());
+}
+
+TEST(SharedAllocation, TestKeepsUnderlyingAllocationAlive) {
+  const char buffer[] = "test buffer";
+
+  TestErrorReporter error_reporter;
+  auto memory_allocation = std::make_shared<MemoryAllocation>(
+      buffer, sizeof(buffer), &error_reporter);
+  const void* base = memory_allocation->base();
+
+  SharedAllocation view(memory_allocation, &error_reporter);
+  // Dropping the caller's reference must not invalidate the view.
+  memory_allocation.reset();
+
+  EXPECT_TRUE(view.valid());
+  EXPECT_EQ(view.base(), base);
+}
+
+TEST(SharedAllocation, TestNullAllocation) {
+  TestErrorReporter error_reporter;
+  SharedAllocation view(nullptr, &error_reporter);
+  EXPECT_FALSE(view.valid());
+  EXPECT_EQ(view.base(), nullptr);
+  EXPECT_EQ(view.bytes(), 0);
+}
+
 }  // namespace tflite
@@ -65,6 +65,15 @@ std::intptr_t ArenaPlanner::BasePointer(TfLiteAllocationType type) {
 TfLiteStatus ArenaPlanner::ResetAllocations() {
   TF_LITE_ENSURE_STATUS(arena_.ClearPlan());
   TF_LITE_ENSURE_STATUS(persistent_arena_.ClearPlan());
+  // Keep the outgoing plan around: tensors whose usage interval and size class
+  // are unchanged when the next plan is calculated can keep their offsets, so
+  // that e.g. `ResizeInputTensor` only re-plans the tensors it affected.
+  if (std::any_of(allocs_.begin(), allocs_.end(),
+                  [](const ArenaAllocWithUsageInterval& alloc) {
+                    return alloc.size > 0;
+                  })) {
+    prior_allocs_ = std::move(allocs_);
+  }
   allocs_.clear();
   allocs_.resize(graph_info_->num_tensors());
   // NOMUTANTS -- Setting last_active_node_ to kLastActiveNodeUndefined causes
@@ -86,7 +95,7 @@ TfLiteStatus ArenaPlanner::ResetAllocationsAfter(int node) {
     }
   }
   if (last_active_node_ > node) {
-    arena_.CalculateActiveAllocs(allocs_, node);
+    arena_.CalculateActiveAllocs(ArenaRwAllocs(), node);
   } else {
     arena_.PurgeAfter(node);
   }
@@ -102,6 +111,31 @@ int ArenaPlanner::FindSharedTensor(int tensor_index) {
   return tensor_index;
 }
 
+bool ArenaPlanner::InSameSizeClass(size_t prior_size, size_t new_size) const {
+  if (new_size > prior_size) {
+    return false;
+  }
+  // The slack left by keeping the larger allocation is bounded by 1/8th of
+  // it, with a floor of the tensor alignment so small tensors always qualify.
+  const size_t slack = prior_size - new_size;
+  return slack <=
+         std::max(static_cast<size_t>(tensor_alignment_), prior_size / 8);
+}
+
+std::vector<ArenaAllocWithUsageInterval> ArenaPlanner::ArenaRwAllocs() {
+  // Only kTfLiteArenaRw allocations live in `arena_`; persistent ones must
+  // not be mixed into its active list.
+  const TfLiteTensor* tensors = graph_info_->tensors();
+  std::vector<ArenaAllocWithUsageInterval> rw_allocs;
+  rw_allocs.reserve(allocs_.size());
+  for (int i = 0; i < static_cast<int>(allocs_.size()); ++i) {
+    if (tensors[i].allocation_type == kTfLiteArenaRw) {
+      rw_allocs.push_back(allocs_[i]);
+    }
+  }
+  return rw_allocs;
+}
+
 bool ArenaPlanner::InputTensorCanBeShared(const TfLiteTensor& input_tensor,
                                           const TfLiteTensor& output_tensor,
                                           int input_id, int output_id,
@@ -489,6 +523,29 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
   tensors_allocated->reserve(tensors_to_allocate.size());
   // Deallocate if the tensor was already allocated.
   TfLiteTensor* tensors = graph_info_->tensors();
+  // Carry offsets over from the plan in place before the last
+  // `ResetAllocations`. Tensors whose usage interval and size class did not
+  // change keep their old offsets, so only the tensors actually affected by a
+  // resize are planned below. This is only safe on a full re-plan: all
+  // restored entries then come from the same prior plan and cannot overlap
+  // each other, and everything else is planned around them.
+  bool restored_prior_allocs = false;
+  if (!prior_allocs_.empty() && last_active_node_ == kLastActiveNodeUndefined) {
+    for (const auto& tensor_index : tensors_to_allocate) {
+      if (static_cast<size_t>(tensor_index) >= prior_allocs_.size()) continue;
+      const ArenaAllocWithUsageInterval& prior = prior_allocs_[tensor_index];
+      const TfLiteTensor& tensor = tensors[tensor_index];
+      if (allocs_[tensor_index].size == 0 && prior.size > 0 &&
+          tensor.allocation_type == kTfLiteArenaRw &&
+          actual_tensor_id_.count(tensor_index) == 0 &&
+          prior.first_node == alloc_node_[tensor_index] &&
+          prior.last_node == dealloc_node_[tensor_index] &&
+          InSameSizeClass(prior.size, tensor.bytes)) {
+        allocs_[tensor_index] = prior;
+        restored_prior_allocs = true;
+      }
+    }
+  }
   for (const auto& tensor_index : tensors_to_allocate) {
     TfLiteTensor& tensor = tensors[tensor_index];
     // Only arena allocated tensors are allocated here.
@@ -501,6 +558,12 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     }
   }
 
+  if (restored_prior_allocs) {
+    // Rebuild the arena's active allocs (and high water mark) from the
+    // restored entries so that newly planned tensors pack around them.
+    arena_.CalculateActiveAllocs(ArenaRwAllocs(), first_node);
+    last_active_node_ = first_node;
+  }
   if (tensors_allocated->empty()) {
     last_active_node_ = last_node;
     return kTfLiteOk;
@@ -120,12 +120,25 @@ class ArenaPlanner : public MemoryPlanner {
   // Return the index of the tensor owing `tensor_index's` buffer.
   int FindSharedTensor(int tensor_index);
 
+  // Whether a prior allocation of `prior_size` bytes may be kept for a tensor
+  // which now needs `new_size` bytes, i.e. both sizes fall in the same size
+  // class.
+  bool InSameSizeClass(size_t prior_size, size_t new_size) const;
+
+  // Returns the subset of `allocs_` that lives in the kTfLiteArenaRw arena.
+  std::vector<ArenaAllocWithUsageInterval> ArenaRwAllocs();
+
   TfLiteContext* context_;
   std::unique_ptr<GraphInfo> graph_info_;
 
   // Stores allocation data for all tensors.
   std::vector<ArenaAllocWithUsageInterval> allocs_;
 
+  // Allocation data from before the last ResetAllocations(). Used during
+  // re-planning to keep stable offsets for tensors whose usage interval and
+  // size class did not change.
+  std::vector<ArenaAllocWithUsageInterval> prior_allocs_;
+
   // Map of Tensors allocated by each node.
   // NOLINTNEXTLINE - absl::flat_hash_set increases binary size by 106kB.
   std::vector<std::unordered_set<int32_t>> nodes_to_tensors_;
@@ -370,6 +370,99 @@ TEST_F(ArenaPlannerTest, AllocsCorrectlyReset) {
   EXPECT_EQ(GetOffset(1), 4);
 }
 
+TEST_F(ArenaPlannerTest, ResetKeepsOffsetsOfUnchangedTensors) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  // Alloc(+) and dealloc(-) order: +0 +1 +2 +4 +5 -2 +3 -4 -5
+  EXPECT_EQ(GetOffset(0), 0);
+  EXPECT_EQ(GetOffset(1), 4);
+  EXPECT_EQ(GetOffset(5), 12);
+  EXPECT_EQ(GetOffset(4), 32);
+  EXPECT_EQ(GetOffset(3), 48);
+  EXPECT_EQ(GetOffset(2), 48);
+
+  // Re-plan as `AllocateTensors` does after `ResizeInputTensor`, with only
+  // tensor 1 grown. All other tensors keep their offsets; tensor 1 no longer
+  // fits in any gap between them and moves to the end of the arena.
+  ResetAllocations();
+  (*graph.tensors())[1].bytes += 64;
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_EQ(GetOffset(0), 0);
+  EXPECT_EQ(GetOffset(5), 12);
+  EXPECT_EQ(GetOffset(4), 32);
+  EXPECT_EQ(GetOffset(3), 48);
+  EXPECT_EQ(GetOffset(2), 48);
+  EXPECT_EQ(GetOffset(1), 60);
+}
+
+TEST_F(ArenaPlannerTest, ResetKeepsOffsetsAfterShrinkWithinSizeClass) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  // Shrink tensor 5 slightly. It stays in the same size class, so re-planning
+  // keeps every offset and no tensor is repacked.
+  ResetAllocations();
+  (*graph.tensors())[5].bytes -= 2;
+  Execute(0, graph.nodes().size() - 1);
+
+  EXPECT_EQ(GetOffset(0), 0);
+  EXPECT_EQ(GetOffset(1), 4);
+  EXPECT_EQ(GetOffset(5), 12);
+  EXPECT_EQ(GetOffset(4), 32);
+  EXPECT_EQ(GetOffset(3), 48);
+  EXPECT_EQ(GetOffset(2), 48);
+}
+
+TEST_F(ArenaPlannerTest, ResetAfterReleaseRestoresPriorOffsets) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+
+  // Shrink tensor 4 far below its size class, forcing it to be repacked while
+  // everything else keeps its offset. Releasing the arena first means the
+  // restored offsets must also restore the arena's high water mark, or the
+  // re-acquired buffer would be too small for the tensors above the repacked
+  // one.
+  ReleaseNonPersistentMemory();
+  ASSERT_FALSE(HasNonPersistentMemory());
+  ResetAllocations();
+  (*graph.tensors())[4].bytes = 3;
+  Execute(0, graph.nodes().size() - 1);
+  ASSERT_TRUE(HasNonPersistentMemory());
+
+  EXPECT_EQ(GetOffset(0), 0);
+  EXPECT_EQ(GetOffset(1), 4);
+  EXPECT_EQ(GetOffset(5), 12);
+  EXPECT_EQ(GetOffset(4), 32);
+  EXPECT_EQ(GetOffset(3), 48);
+  EXPECT_EQ(GetOffset(2), 48);
+}
+
 TEST_F(ArenaPlannerTest, SimpleGraphInputsPreserved) {
   TestGraph graph({0, 1},
                   {
@@ -26,7 +26,29 @@ extern "C" {
 // Constant that identifies the TfLiteStableDelegate ABI version that the
 // delegate supports. This will get incremented if there are changes to the
 // struct. The version is in semver 2 format (see https://semver.org).
-#define TFL_STABLE_DELEGATE_ABI_VERSION "1.0.0"
+#define TFL_STABLE_DELEGATE_ABI_VERSION "1.1.0"
+
+// Describes the asynchronous execution capabilities of a stable delegate.
+//
+// A stable delegate that populates this struct must provide delegate kernels
+// implementing the TfLiteAsyncKernel interface (see
+// tensorflow/lite/core/async/c/async_kernel.h). Applications then drive the
+// delegate through TfLiteAsyncSignatureRunner: InvokeAsync() submits an
+// inference without blocking and synchronization objects (e.g. sync fence
+// file descriptors) are exchanged through the attribute maps attached to the
+// task's input and output buffers. This allows e.g. overlapping GPU inference
+// of one camera frame with CPU preprocessing of the next one.
+typedef struct TfLiteStableDelegateAsyncCapabilities {
+  // Null-terminated array of the buffer object type names that the delegate
+  // can register for input and output tensors, e.g. "ahardware_buffer_blob".
+  const char* const* supported_buffer_types;
+
+  // Null-terminated array of the synchronization object type names that the
+  // delegate can wait on for input buffers and signal for output buffers,
+  // e.g. "sync_fence_fd". See
+  // tensorflow/lite/core/async/interop/c/types.h.
+  const char* const* supported_synchronization_types;
+} TfLiteStableDelegateAsyncCapabilities;
 
 // Contains stable delegate metadata and implementation.
 typedef struct TfLiteStableDelegate {
@@ -45,6 +67,16 @@ typedef struct TfLiteStableDelegate {
 
   // Provides the implementation of the delegate plugin.
   const TfLiteOpaqueDelegatePlugin* delegate_plugin;
+
+  // Optional. Describes the delegate's asynchronous execution capabilities;
+  // null if the delegate only supports synchronous invocation.
+  //
+  // This field was added in ABI version 1.1.0. Callers must check that
+  // 'delegate_abi_version' is at least "1.1.0" before reading it, as the
+  // field does not exist in delegates built against earlier versions of this
+  // struct (see e.g. GetStableDelegateAsyncCapabilities() in
+  // tensorflow/lite/delegates/utils/experimental/stable_delegate/delegate_loader.h).
+  const TfLiteStableDelegateAsyncCapabilities* async_capabilities;
 } TfLiteStableDelegate;
 
 #ifdef __cplusplus
@@ -248,6 +248,33 @@ TfLiteStatus Interpreter::Invoke() {
   return kTfLiteOk;
 }
 
+TfLiteStatus Interpreter::InvokeBatch(int batch_size) {
+  ScopedRuntimeInstrumentationProfile scoped_runtime_event(root_profiler_.get(),
+                                                           "invoke batch");
+
+  // "Resets" cancellation flag so cancellation that happens before this invoke
+  // will not take effect.
+  if (cancellation_enabled_) (void)continue_invocation_.test_and_set();
+
+  // Denormal floating point numbers could cause significant slowdown on
+  // platforms like x86, therefore, we suppress denormals here to prevent this
+  // from happening.
+  ruy::ScopedSuppressDenormals suppress_denormals;
+
+  TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(
+      scoped_runtime_event, primary_subgraph().InvokeBatch(batch_size));
+
+  if (!allow_buffer_handle_output_) {
+    for (int tensor_index : outputs()) {
+      TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(
+          scoped_runtime_event,
+          primary_subgraph().EnsureTensorDataIsReadable(tensor_index));
+    }
+  }
+
+  return kTfLiteOk;
+}
+
 TfLiteStatus Interpreter::AddTensors(int tensors_to_add,
                                      int* first_new_tensor_index) {
   return primary_subgraph().AddTensors(tensors_to_add, first_new_tensor_index);
@@ -508,6 +508,20 @@ class Interpreter {
   /// Returns status of success or failure.
   TfLiteStatus Invoke();
 
+  /// \warning This is an experimental API and subject to change. \n
+  /// \brief Invoke the interpreter `batch_size` times in one call, amortizing
+  /// per-invocation fixed costs across the batch.
+  ///
+  /// The graph keeps its per-example input and output shapes; instead, every
+  /// input and output tensor must use a custom allocation (see
+  /// `SetCustomAllocationForTensor`) holding `batch_size` examples laid out
+  /// back to back. Each invocation points the tensors at the next example, so
+  /// callers write all examples up front and read all results afterwards
+  /// without per-example copies. After the call the tensors point at the
+  /// first example of the batch. Returns the status of the first failing
+  /// invocation, or kTfLiteOk if all succeed.
+  TfLiteStatus InvokeBatch(int batch_size);
+
   /// Set the number of threads available to the interpreter.
   ///
   /// NOTE: `num_threads` should be >= -1. Setting `num_threads` to 0 has the
@@ -298,6 +298,24 @@ std::unique_ptr<FlatBufferModel> FlatBufferModel::VerifyAndBuildFromAllocation(
   return BuildFromAllocation(std::move(allocation), error_reporter);
 }
 
+std::unique_ptr<FlatBufferModel> FlatBufferModel::BuildFromSharedAllocation(
+    std::shared_ptr<Allocation> allocation, ErrorReporter* error_reporter) {
+  error_reporter = ValidateErrorReporter(error_reporter);
+  return BuildFromAllocation(
+      std::make_unique<SharedAllocation>(std::move(allocation), error_reporter),
+      error_reporter);
+}
+
+std::unique_ptr<FlatBufferModel>
+FlatBufferModel::VerifyAndBuildFromSharedAllocation(
+    std::shared_ptr<Allocation> allocation, TfLiteVerifier* extra_verifier,
+    ErrorReporter* error_reporter) {
+  error_reporter = ValidateErrorReporter(error_reporter);
+  return VerifyAndBuildFromAllocation(
+      std::make_unique<SharedAllocation>(std::move(allocation), error_reporter),
+      extra_verifier, error_reporter);
+}
+
 std::unique_ptr<FlatBufferModel> FlatBufferModel::BuildFromModel(
     const tflite::Model* caller_owned_model_spec,
     ErrorReporter* error_reporter) {
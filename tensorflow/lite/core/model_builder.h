@@ -146,6 +146,33 @@ class FlatBufferModel {
       TfLiteVerifier* extra_verifier = nullptr,
       ErrorReporter* error_reporter = DefaultErrorReporter());
 
+  /// Builds a model from an allocation that may be shared with other models.
+  /// Since read-only weight tensors (kTfLiteMmapRo) reference the model
+  /// allocation directly, all interpreter instances built from models sharing
+  /// one allocation use a single copy of the weights; only the mutable
+  /// activation arenas are per-instance. The allocation is kept alive for the
+  /// lifetime of the returned model.
+  /// Caller retains ownership of `error_reporter` and must ensure its lifetime
+  /// is longer than the FlatBufferModel instance.
+  /// Returns a nullptr in case of failure (e.g., the allocation is invalid).
+  static std::unique_ptr<FlatBufferModel> BuildFromSharedAllocation(
+      std::shared_ptr<Allocation> allocation,
+      ErrorReporter* error_reporter = DefaultErrorReporter());
+
+  /// Verifies whether the content of the allocation is legit, then builds a
+  /// model sharing the provided allocation, as BuildFromSharedAllocation does.
+  /// The extra_verifier argument is an additional optional verifier for the
+  /// buffer. By default, we always check with tflite::VerifyModelBuffer. If
+  /// extra_verifier is supplied, the buffer is checked against the
+  /// extra_verifier after the check against tflite::VerifyModelBuilder.
+  /// Caller retains ownership of `error_reporter` and must ensure its lifetime
+  /// is longer than the FlatBufferModel instance.
+  /// Returns a nullptr in case of failure.
+  static std::unique_ptr<FlatBufferModel> VerifyAndBuildFromSharedAllocation(
+      std::shared_ptr<Allocation> allocation,
+      TfLiteVerifier* extra_verifier = nullptr,
+      ErrorReporter* error_reporter = DefaultErrorReporter());
+
   /// Builds a model directly from a flatbuffer pointer
   /// Caller retains ownership of the buffer and should keep it alive until the
   /// returned object is destroyed. Caller retains ownership of `error_reporter`
@@ -491,6 +491,49 @@ TEST(BasicFlatBufferModel, TestBuildFromAllocation) {
   ASSERT_NE(interpreter, nullptr);
 }
 
+// Test that several models (and thus their interpreters' read-only weight
+// tensors) can share a single allocation.
+TEST(BasicFlatBufferModel, TestBuildFromSharedAllocation) {
+  TestErrorReporter reporter;
+  std::shared_ptr<Allocation> model_allocation(new FileCopyAllocation(
+      "tensorflow/lite/testdata/test_model.bin", &reporter));
+  ASSERT_TRUE(model_allocation->valid());
+
+  auto model_1 = FlatBufferModel::BuildFromSharedAllocation(model_allocation);
+  auto model_2 = FlatBufferModel::BuildFromSharedAllocation(model_allocation);
+  ASSERT_TRUE(model_1);
+  ASSERT_TRUE(model_2);
+
+  // Both models reference the one buffer rather than private copies.
+  EXPECT_EQ(model_1->allocation()->base(), model_allocation->base());
+  EXPECT_EQ(model_2->allocation()->base(), model_allocation->base());
+
+  std::unique_ptr<Interpreter> interpreter_1;
+  std::unique_ptr<Interpreter> interpreter_2;
+  ASSERT_EQ(
+      InterpreterBuilder(*model_1, TrivialResolver(&dummy_reg))(&interpreter_1),
+      kTfLiteOk);
+  ASSERT_EQ(
+      InterpreterBuilder(*model_2, TrivialResolver(&dummy_reg))(&interpreter_2),
+      kTfLiteOk);
+  ASSERT_NE(interpreter_1, nullptr);
+  ASSERT_NE(interpreter_2, nullptr);
+
+  // The models stay usable after the caller drops its reference.
+  model_allocation.reset();
+  ASSERT_TRUE(model_1->initialized());
+  ASSERT_TRUE(model_2->initialized());
+}
+
+TEST(BasicFlatBufferModel, TestBuildFromSharedNullAllocation) {
+  TestErrorReporter reporter;
+  std::shared_ptr<Allocation> model_allocation;
+
+  auto model =
+      FlatBufferModel::BuildFromSharedAllocation(std::move(model_allocation));
+  ASSERT_FALSE(model);
+}
+
 TEST(BasicFlatBufferModel, TestBuildFromNullAllocation) {
   TestErrorReporter reporter;
   std::unique_ptr<Allocation> model_allocation;
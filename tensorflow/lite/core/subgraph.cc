@@ -23,6 +23,7 @@ limitations under the License.
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -40,6 +41,7 @@ limitations under the License.
 #include "tensorflow/lite/core/c/c_api_types.h"
 #include "tensorflow/lite/core/c/common.h"
 #include "tensorflow/lite/experimental/resource/resource_base.h"
+#include "tensorflow/lite/external_cpu_backend_context.h"
 #include "tensorflow/lite/graph_info.h"
 #include "tensorflow/lite/memory_planner.h"
 #include "tensorflow/lite/minimal_logging.h"
@@ -77,6 +79,12 @@ struct TfLiteSparsityDeleter {
 using ScopedTfLiteSparsity =
     std::unique_ptr<TfLiteSparsity, TfLiteSparsityDeleter>;
 
+template <typename T>
+T AlignTo(size_t alignment, T value) {
+  return value % alignment == 0 ? value
+                                : value + (alignment - value % alignment);
+}
+
 TfLiteStatus ReportOpError(TfLiteContext* context, const TfLiteNode& node,
                            const TfLiteRegistration& registration,
                            int node_index, const char* message) {
@@ -1042,9 +1050,75 @@ TfLiteStatus Subgraph::AllocateTensors() {
       }
     }
   }
+
+  if (ShouldDoubleBufferBoundaryTensors()) {
+    TF_LITE_ENSURE_STATUS(PrepareBoundaryTensorDoubleBuffers());
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::PrepareBoundaryTensorDoubleBuffers() {
+  // A tensor crosses a partition boundary if its producer and one of its
+  // consumers run under different delegates (the CPU partition counts as the
+  // null delegate).
+  std::map<int, TfLiteDelegate*> producing_delegate;
+  for (int node_index : execution_plan_) {
+    const TfLiteNode& node = nodes_and_registration_[node_index].first;
+    for (int i = 0; i < node.outputs->size; ++i) {
+      const int tensor_index = node.outputs->data[i];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      producing_delegate[tensor_index] = node.delegate;
+    }
+  }
+  for (int node_index : execution_plan_) {
+    const TfLiteNode& node = nodes_and_registration_[node_index].first;
+    for (int i = 0; i < node.inputs->size; ++i) {
+      const int tensor_index = node.inputs->data[i];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const auto producer = producing_delegate.find(tensor_index);
+      if (producer == producing_delegate.end() ||
+          producer->second == node.delegate) {
+        continue;
+      }
+      TfLiteTensor& tensor = tensors_[tensor_index];
+      // Only plain arena tensors can be moved to a dedicated double buffer;
+      // tensors already converted on a previous plan are refreshed below.
+      const bool already_double_buffered =
+          boundary_tensor_double_buffers_.count(tensor_index) != 0;
+      if (!already_double_buffered &&
+          tensor.allocation_type != kTfLiteArenaRw) {
+        continue;
+      }
+      if (tensor.is_variable || tensor.bytes == 0) continue;
+      BoundaryTensorDoubleBuffer& entry =
+          boundary_tensor_double_buffers_[tensor_index];
+      if (tensor.bytes > entry.stride) {
+        entry.stride = AlignTo(kDefaultTensorAlignment, tensor.bytes);
+        entry.buffer.reset(
+            new char[2 * entry.stride + kDefaultTensorAlignment - 1]);
+        entry.aligned_base = reinterpret_cast<char*>(
+            AlignTo(kDefaultTensorAlignment,
+                    reinterpret_cast<intptr_t>(entry.buffer.get())));
+        custom_allocations_[tensor_index] = {entry.aligned_base,
+                                             2 * entry.stride};
+      }
+      tensor.allocation_type = kTfLiteCustom;
+      tensor.data.raw = entry.aligned_base +
+                        (boundary_tensor_back_half_ ? entry.stride : 0);
+    }
+  }
   return kTfLiteOk;
 }
 
+void Subgraph::SwapBoundaryTensorBuffers() {
+  boundary_tensor_back_half_ = !boundary_tensor_back_half_;
+  for (const auto& index_and_buffer : boundary_tensor_double_buffers_) {
+    const BoundaryTensorDoubleBuffer& entry = index_and_buffer.second;
+    tensors_[index_and_buffer.first].data.raw =
+        entry.aligned_base + (boundary_tensor_back_half_ ? entry.stride : 0);
+  }
+}
+
 // TODO(b/115961645): Support non-zero default values.
 TfLiteStatus Subgraph::ResetVariableTensors() {
   for (auto& tensor : tensors_) {
@@ -1582,6 +1656,59 @@ TfLiteStatus Subgraph::Invoke() {
   telemetry::TelemetryReportEvent(&context_, "Invoke", status);
   return status;
 }
+
+TfLiteStatus Subgraph::InvokeBatch(int batch_size) {
+  if (batch_size < 1) {
+    ReportError("InvokeBatch called with invalid batch size %d.", batch_size);
+    return kTfLiteError;
+  }
+  if (batch_size == 1) return Invoke();
+
+  // Collect the batched buffers. Every input and output must use a custom
+  // allocation holding `batch_size` back-to-back examples; the subgraph keeps
+  // its per-example shapes, so ops and delegates never see a batch dimension.
+  std::vector<std::pair<TfLiteTensor*, char*>> batched_views;
+  std::vector<int> io_tensors(inputs_);
+  io_tensors.insert(io_tensors.end(), outputs_.begin(), outputs_.end());
+  for (int tensor_index : io_tensors) {
+    if (tensor_index == kTfLiteOptionalTensor) continue;
+    TfLiteTensor* tensor = &tensors_[tensor_index];
+    if (tensor->allocation_type != kTfLiteCustom) {
+      ReportError(
+          "InvokeBatch requires a custom allocation for every input and "
+          "output tensor, but tensor %d has none.",
+          tensor_index);
+      return kTfLiteError;
+    }
+    const auto alloc = custom_allocations_.find(tensor_index);
+    TF_LITE_ENSURE(&context_, alloc != custom_allocations_.end());
+    if (alloc->second.bytes < static_cast<size_t>(batch_size) * tensor->bytes) {
+      ReportError(
+          "Custom allocation for tensor %d holds %zu bytes, but a batch of "
+          "%d examples needs %zu bytes.",
+          tensor_index, alloc->second.bytes, batch_size,
+          static_cast<size_t>(batch_size) * tensor->bytes);
+      return kTfLiteError;
+    }
+    batched_views.emplace_back(tensor,
+                               static_cast<char*>(alloc->second.data));
+  }
+
+  TfLiteStatus status = kTfLiteOk;
+  for (int i = 0; i < batch_size && status == kTfLiteOk; ++i) {
+    for (const auto& view : batched_views) {
+      view.first->data.raw = view.second + i * view.first->bytes;
+    }
+    status = InvokeImpl();
+  }
+  // Leave the tensors pointing at the first example of the batch.
+  for (const auto& view : batched_views) {
+    view.first->data.raw = view.second;
+  }
+  telemetry::TelemetryReportEvent(&context_, "InvokeBatch", status);
+  return status;
+}
+
 TfLiteStatus Subgraph::InvokeImpl() {
   if (!consistent_) {
     ReportError("Invoke called on model that is not consistent.");
@@ -1596,6 +1723,20 @@ TfLiteStatus Subgraph::InvokeImpl() {
     ReportError("Non-persistent memory is not available.");
     return kTfLiteError;
   }
+  // When compute threads are pinned to a core mask, re-apply the pinning and
+  // adapt the thread count to the cores' current frequency ceilings: cores
+  // may have been thermally throttled (or the affinity overridden) since the
+  // previous invocation.
+  auto* cpu_backend_context = static_cast<ExternalCpuBackendContext*>(
+      GetExternalContext(kTfLiteCpuBackendContext));
+  if (cpu_backend_context != nullptr &&
+      cpu_backend_context->has_cpu_affinity_mask()) {
+    cpu_backend_context->RefreshSchedulingForInvocation(
+        context_.recommended_num_threads);
+  }
+  if (!boundary_tensor_double_buffers_.empty()) {
+    SwapBoundaryTensorBuffers();
+  }
   TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler_.get(), "Invoke");
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   tensorflow::profiler::TraceMe* trace_subgraph =
@@ -294,6 +294,15 @@ class Subgraph {
   // Returns status of success or failure.
   TfLiteStatus Invoke();
 
+  // Invoke the subgraph `batch_size` times, amortizing per-invocation fixed
+  // costs across the batch. The subgraph keeps its per-example tensor shapes;
+  // instead, every input and output tensor must use a custom allocation (see
+  // `SetCustomAllocationForTensor`) holding `batch_size` examples laid out
+  // back to back, and each invocation points the tensors at the next example.
+  // After the call the tensors point at the first example of the batch.
+  // WARNING: This is an experimental API and subject to change.
+  TfLiteStatus InvokeBatch(int batch_size);
+
   // Entry point for C node plugin API to report an error.
   void ReportError(const char* format, ...);
 
@@ -474,6 +483,14 @@ class Subgraph {
     return (options_ && options_->GetDisableDelegateClustering());
   }
 
+  // WARNING: This is an experimental API and subject to change.
+  // True if tensors crossing a partition boundary should get two alternating
+  // buffer halves so callers can pipeline partitions of consecutive
+  // invocations.
+  bool ShouldDoubleBufferBoundaryTensors() const {
+    return (options_ && options_->GetDoubleBufferBoundaryTensors());
+  }
+
   // Retrieves the corresponding TfLiteContext of a subgraph given a subgraph
   // index and switches to the delegate context for this subgraph. If an invalid
   // subgraph index is given, returns kTfLiteError.
@@ -923,6 +940,16 @@ class Subgraph {
   // tensors if configured.
   void MaybeReleaseDynamicTensors(const TfLiteNode& node, size_t node_index);
 
+  // Moves every partition boundary tensor out of the shared arena into a
+  // dedicated allocation holding two alternating halves. Called from
+  // `AllocateTensors` when `SetDoubleBufferBoundaryTensors` is enabled.
+  TfLiteStatus PrepareBoundaryTensorDoubleBuffers();
+
+  // Flips every double-buffered boundary tensor to its other buffer half, so
+  // the halves written by the previous invocation stay readable. Called at the
+  // start of every invocation.
+  void SwapBoundaryTensorBuffers();
+
   // The state of the Subgraph.
   enum State {
     // The Subgraph isn't ready to be invoked.
@@ -1049,6 +1076,24 @@ class Subgraph {
   // Maps tensor index to custom allocation for all applicable tensors.
   std::map<int, TfLiteCustomAllocation> custom_allocations_;
 
+  // Backing storage for a double-buffered partition boundary tensor: two
+  // alternating halves of `stride` bytes each, registered with
+  // `custom_allocations_`.
+  struct BoundaryTensorDoubleBuffer {
+    // Owns `2 * stride` bytes plus alignment headroom.
+    std::unique_ptr<char[]> buffer;
+    char* aligned_base = nullptr;
+    // Aligned size of one buffer half.
+    size_t stride = 0;
+  };
+
+  // Maps tensor index to its double buffer for all partition boundary
+  // tensors. Only populated when `SetDoubleBufferBoundaryTensors` is enabled.
+  std::map<int, BoundaryTensorDoubleBuffer> boundary_tensor_double_buffers_;
+
+  // Which buffer half the current invocation writes; flipped on every Invoke.
+  bool boundary_tensor_back_half_ = false;
+
   // Tracking bit for whether a tensor was resized in the course of an op
   // invocation. This is a useful hint to ensure that dynamic tensor outputs
   // trigger downstream reallocation after op invocation.
@@ -174,6 +174,46 @@ TEST_F(TestDelegate, ComplexDelegate) {
             delegate_->FakeFusedRegistration().custom_name);
 }
 
+TEST_F(TestDelegate, DoubleBufferedBoundaryTensors) {
+  // Delegating only node 0 makes tensor 2 a partition boundary: it is produced
+  // by the delegate and consumed by the undelegated node 2.
+  delegate_ = std::unique_ptr<SimpleDelegate>(new SimpleDelegate({0}));
+  interpreter_->ModifyGraphWithDelegate(delegate_->get_tf_lite_delegate());
+
+  InterpreterOptions options;
+  options.SetDoubleBufferBoundaryTensors();
+  interpreter_->ApplyOptions(&options);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  constexpr int kBoundaryTensorIndex = 2;
+  TfLiteTensor* boundary_tensor = interpreter_->tensor(kBoundaryTensorIndex);
+  EXPECT_EQ(boundary_tensor->allocation_type, kTfLiteCustom);
+
+  // Frame 1: node 0 computes 2 * input0 into the boundary tensor.
+  std::vector<float> input = {1.0f, 2.0f, 3.0f};
+  memcpy(interpreter_->typed_tensor<float>(0), input.data(), 3 * sizeof(float));
+  memcpy(interpreter_->typed_tensor<float>(1), input.data(), 3 * sizeof(float));
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  const float* frame1_boundary = boundary_tensor->data.f;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(interpreter_->tensor(4)->data.f[i], 3.0f * input[i]) << i;
+  }
+
+  // Frame 2 writes the other buffer half, so frame 1's boundary data remains
+  // readable while the next frame is computed.
+  std::vector<float> input2 = {4.0f, 5.0f, 6.0f};
+  memcpy(interpreter_->typed_tensor<float>(0), input2.data(),
+         3 * sizeof(float));
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  EXPECT_NE(boundary_tensor->data.f, frame1_boundary);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(boundary_tensor->data.f[i], 2.0f * input2[i]) << i;
+    EXPECT_EQ(interpreter_->tensor(4)->data.f[i], 2.0f * input2[i] + input[i])
+        << i;
+    EXPECT_EQ(frame1_boundary[i], 2.0f * input[i]) << i;
+  }
+}
+
 TEST_F(TestDelegate, SetBufferHandleToInput) {
   delegate_ = std::unique_ptr<SimpleDelegate>(new SimpleDelegate({0, 1, 2}));
   TfLiteDelegate* delegate = delegate_->get_tf_lite_delegate();
@@ -33,6 +33,8 @@ limitations under the License.
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/tstring.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
@@ -149,6 +151,71 @@ tensorflow::Status GetSubgraphNamesForFunctionExecution(
   return ::tensorflow::OkStatus();
 }
 
+// Creates a new EagerContext with its own device manager from the given
+// session options.
+tensorflow::Status CreateEagerContext(
+    const tensorflow::SessionOptions& session_options,
+    tensorflow::EagerContext** eager_context) {
+  std::vector<std::unique_ptr<tensorflow::Device>> devices;
+
+  TF_RETURN_IF_ERROR(tensorflow::DeviceFactory::AddDevices(
+      session_options, "/job:localhost/replica:0/task:0", &devices));
+
+  auto device_mgr =
+      std::make_unique<tensorflow::StaticDeviceMgr>(std::move(devices));
+  // Note that Rendezvous is ref-counted so it will be automatically deleted.
+  auto rendezvous = tsl::core::RefCountPtr<tensorflow::IntraProcessRendezvous>(
+      new tensorflow::IntraProcessRendezvous(device_mgr.get()));
+  *eager_context = new tensorflow::EagerContext(
+      session_options,
+      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_SILENT,
+      /*async=*/false, device_mgr.release(), /*device_mgr_owned*/ true,
+      std::move(rendezvous), nullptr);
+  return tensorflow::Status();
+}
+
+// Tracks the process-wide EagerContext that is shared by all DelegateData
+// instances whose models do not register per-instance resources (see
+// DelegateData::Prepare). The context is created on first use and destroyed
+// together with the last DelegateData using it.
+struct SharedEagerContext {
+  tensorflow::mutex mu;
+  tensorflow::EagerContext* context TF_GUARDED_BY(mu) = nullptr;
+  int num_users TF_GUARDED_BY(mu) = 0;
+};
+
+SharedEagerContext* GetSharedEagerContext() {
+  static SharedEagerContext* shared_context = new SharedEagerContext;
+  return shared_context;
+}
+
+tensorflow::Status AcquireSharedEagerContext(
+    const tensorflow::SessionOptions& session_options,
+    tensorflow::EagerContext** eager_context) {
+  SharedEagerContext* shared_context = GetSharedEagerContext();
+  tensorflow::mutex_lock l(shared_context->mu);
+  if (shared_context->context == nullptr) {
+    // The session options of later users are ignored, consistent with how
+    // redundant calls to DelegateData::Prepare already behave.
+    TF_RETURN_IF_ERROR(
+        CreateEagerContext(session_options, &shared_context->context));
+  }
+  ++shared_context->num_users;
+  *eager_context = shared_context->context;
+  return tensorflow::Status();
+}
+
+void ReleaseSharedEagerContext(tensorflow::EagerContext* eager_context) {
+  SharedEagerContext* shared_context = GetSharedEagerContext();
+  tensorflow::mutex_lock l(shared_context->mu);
+  DCHECK_EQ(shared_context->context, eager_context);
+  if (--shared_context->num_users == 0) {
+    shared_context->context->HostCPU()->ClearResourceMgr();
+    shared_context->context->Unref();
+    shared_context->context = nullptr;
+  }
+}
+
 }  // namespace
 
 tensorflow::Status RegisterFunctionDefForSubgraphs(
@@ -193,10 +260,16 @@ DelegateData::DelegateData() {}
 
 DelegateData::~DelegateData() {
   if (eager_context_) {
-    // Notify the eager context to clean up the resource being held before
-    // destructing the `DelegateData`.
-    eager_context_->HostCPU()->ClearResourceMgr();
-    eager_context_->Unref();
+    if (eager_context_shared_) {
+      // Other DelegateData instances may still be using the shared context,
+      // so its resource manager must not be cleared here.
+      ReleaseSharedEagerContext(eager_context_);
+    } else {
+      // Notify the eager context to clean up the resource being held before
+      // destructing the `DelegateData`.
+      eager_context_->HostCPU()->ClearResourceMgr();
+      eager_context_->Unref();
+    }
   }
 }
 
@@ -212,21 +285,24 @@ tensorflow::Status DelegateData::Prepare(
         "flex_delegate must be non-null when main_subgraph is provided.");
   }
 
-  std::vector<std::unique_ptr<tensorflow::Device>> devices;
-
-  TF_RETURN_IF_ERROR(tensorflow::DeviceFactory::AddDevices(
-      session_options, "/job:localhost/replica:0/task:0", &devices));
+  // Models without additional subgraphs register nothing into the eager
+  // context's resource manager, so such instances can all share one
+  // process-wide context and amortize its cost (devices, function library
+  // runtime, kernels) across interpreters. Models with subgraphs (e.g.
+  // control flow bodies) register per-instance FunctionDefs and subgraph
+  // resources keyed by subgraph name, which could collide between
+  // interpreters, so they keep a private context.
+  const bool can_share_eager_context =
+      main_subgraph == nullptr || main_subgraph->GetSubgraphs() == nullptr ||
+      main_subgraph->GetSubgraphs()->empty();
+  if (can_share_eager_context) {
+    TF_RETURN_IF_ERROR(
+        AcquireSharedEagerContext(session_options, &eager_context_));
+    eager_context_shared_ = true;
+    return tensorflow::Status();
+  }
 
-  auto device_mgr =
-      std::make_unique<tensorflow::StaticDeviceMgr>(std::move(devices));
-  // Note that Rendezvous is ref-counted so it will be automatically deleted.
-  auto rendezvous = tsl::core::RefCountPtr<tensorflow::IntraProcessRendezvous>(
-      new tensorflow::IntraProcessRendezvous(device_mgr.get()));
-  eager_context_ = new tensorflow::EagerContext(
-      session_options,
-      tensorflow::ContextDevicePlacementPolicy::DEVICE_PLACEMENT_SILENT,
-      /*async=*/false, device_mgr.release(), /*device_mgr_owned*/ true,
-      std::move(rendezvous), nullptr);
+  TF_RETURN_IF_ERROR(CreateEagerContext(session_options, &eager_context_));
 
   if (main_subgraph) {
     TF_RETURN_IF_ERROR(RegisterFunctionDefForSubgraphs(
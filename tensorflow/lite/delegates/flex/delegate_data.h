@@ -41,6 +41,11 @@ class DelegateData {
   // This must be called at least once before execution. After preparation
   // succeeds, redundant calls will be ignored (even if the session_options
   // differ).
+  // Instances whose models have no additional subgraphs share one
+  // process-wide EagerContext, amortizing its cost across interpreters; the
+  // session_options of the instance that creates the shared context win.
+  // Models with additional subgraphs register per-instance resources into the
+  // context's resource manager and therefore get a private context.
   // When `main_subgraph` parameter is provided, this function will register
   // FunctionDefs associated with each of the subgraphs attached to the
   // `main_subgraph` which is delegated by 'flex_delegate'.
@@ -77,6 +82,9 @@ class DelegateData {
  private:
   // Will be null until Prepare() is called and completes successfully.
   tensorflow::EagerContext* eager_context_ = nullptr;
+  // True if 'eager_context_' is the process-wide shared context rather than
+  // one owned exclusively by this instance.
+  bool eager_context_shared_ = false;
   // Not owned by DelegateData.
   tensorflow::CancellationManager* cancellation_manager_ = nullptr;
   // TODO(b/112439500): Clean up stale BufferMap instances after adding the
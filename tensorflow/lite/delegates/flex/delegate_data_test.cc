@@ -57,6 +57,18 @@ TEST(DelegateDataTest, Basic) {
             data.GetBufferMap(&dummy_context2));
 }
 
+TEST(DelegateDataTest, SharedEagerContext) {
+  // Instances prepared without a main subgraph register no per-instance
+  // resources and share one process-wide EagerContext.
+  DelegateData data1;
+  DelegateData data2;
+  tensorflow::SessionOptions session_options;
+  EXPECT_TRUE(data1.Prepare(session_options).ok());
+  EXPECT_TRUE(data2.Prepare(session_options).ok());
+  ASSERT_NE(data1.GetEagerContext(), nullptr);
+  EXPECT_EQ(data1.GetEagerContext(), data2.GetEagerContext());
+}
+
 TEST(DelegateDataTest, CheckFunctionDef) {
   tensorflow::StaticDeviceMgr device_mgr(tensorflow::DeviceFactory::NewDevice(
       "CPU", {}, "/job:localhost/replica:0/task:0/device:CPU:0"));
@@ -19,15 +19,19 @@ limitations under the License.
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "flatbuffers/flexbuffers.h"  // from @flatbuffers
 #include "tensorflow/core/common_runtime/eager/context.h"
+#include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/status.h"
+#include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/protobuf/error_codes.pb.h"
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/context_util.h"
@@ -179,6 +183,71 @@ struct OpDataInfo {
   std::set<int> already_transferred_outputs;
 };
 
+// Process-wide cache of instantiated fallback kernels, keyed by the
+// canonicalized op signature (op name plus attributes) and the eager context
+// the kernel was built against. TensorFlow OpKernels are stateless once
+// constructed (mutable op state lives in the resource manager and the
+// OpKernelContext), so nodes with the same signature -- possibly in different
+// interpreters sharing an eager context -- can run the same kernel instance.
+// The cache holds weak references so a kernel is destroyed together with the
+// last OpNode using it.
+class OpKernelRunnerCache {
+ public:
+  static OpKernelRunnerCache* Global() {
+    static OpKernelRunnerCache* const cache = new OpKernelRunnerCache;
+    return cache;
+  }
+
+  tensorflow::StatusOr<std::shared_ptr<tensorflow::tfrt_stub::OpKernelRunner>>
+  GetOrCreate(tensorflow::EagerContext* eager_context, const string& op_name,
+              const tensorflow::NodeDef& nodedef, int num_inputs) {
+    // Kernels reference the function library runtime and host device of the
+    // eager context they were created with, so the context takes part in the
+    // cache key.
+    const string key =
+        std::to_string(reinterpret_cast<uintptr_t>(eager_context)) + "/" +
+        tensorflow::Canonicalize(nodedef.op(), tensorflow::AttrSlice(nodedef));
+    {
+      tensorflow::mutex_lock lock(mu_);
+      auto it = runners_.find(key);
+      if (it != runners_.end()) {
+        if (auto runner = it->second.lock()) return runner;
+        runners_.erase(it);
+      }
+    }
+
+    // Instantiate the kernel outside the lock since construction can be
+    // expensive.
+    TF_ASSIGN_OR_RETURN(auto runner,
+                        tensorflow::tfrt_stub::OpKernelRunner::Create(
+                            op_name, num_inputs, /*attr_builder=*/
+                            [&nodedef](tensorflow::AttrValueMap* attr_value_map)
+                                -> tensorflow::Status {
+                              *attr_value_map = nodedef.attr();
+                              return ::tensorflow::OkStatus();
+                            },
+                            *eager_context->pflr(),
+                            eager_context->local_device_mgr()->HostCPU()));
+    auto shared_runner =
+        std::make_shared<tensorflow::tfrt_stub::OpKernelRunner>(
+            std::move(runner));
+
+    tensorflow::mutex_lock lock(mu_);
+    auto& entry = runners_[key];
+    if (auto existing = entry.lock()) return existing;
+    entry = shared_runner;
+    return shared_runner;
+  }
+
+ private:
+  OpKernelRunnerCache() = default;
+
+  tensorflow::mutex mu_;
+  std::unordered_map<std::string,
+                     std::weak_ptr<tensorflow::tfrt_stub::OpKernelRunner>>
+      runners_ TF_GUARDED_BY(mu_);
+};
+
 // A single node within the larger 'op'. Note that this kernel executes many
 // TensorFlow ops within a single TF Lite op.
 class OpNode {
@@ -207,7 +276,8 @@ class OpNode {
   int NumInputs() const { return inputs_.Size(); }
   int NumOutputs() const { return outputs_.Size(); }
 
-  const tensorflow::tfrt_stub::OpKernelRunner& op_kernel_runner() const {
+  const std::shared_ptr<tensorflow::tfrt_stub::OpKernelRunner>&
+  op_kernel_runner() const {
     return op_kernel_runner_;
   }
 
@@ -252,16 +322,12 @@ class OpNode {
 
   tensorflow::Status BuildOpKernelRunner(
       tensorflow::EagerContext* eager_context) {
-    // Create tensorflow::OpKernel on host CPU.
+    // Fetch the tensorflow::OpKernel for the host CPU, reusing an already
+    // instantiated kernel when another node with the same op signature has
+    // built one against this eager context.
     TF_ASSIGN_OR_RETURN(op_kernel_runner_,
-                        tensorflow::tfrt_stub::OpKernelRunner::Create(
-                            name_, inputs_.Size(), /*attr_builder=*/
-                            [this](tensorflow::AttrValueMap* attr_value_map) {
-                              *attr_value_map = nodedef_.attr();
-                              return ::tensorflow::OkStatus();
-                            },
-                            *eager_context->pflr(),
-                            eager_context->local_device_mgr()->HostCPU()));
+                        OpKernelRunnerCache::Global()->GetOrCreate(
+                            eager_context, name_, nodedef_, inputs_.Size()));
 
     return ::tensorflow::OkStatus();
   }
@@ -395,7 +461,7 @@ class OpNode {
   // List of outputs, as TF Lite tensor indices.
   OpOutputs outputs_;
 
-  tensorflow::tfrt_stub::OpKernelRunner op_kernel_runner_;
+  std::shared_ptr<tensorflow::tfrt_stub::OpKernelRunner> op_kernel_runner_;
 };
 
 // The larger 'op', which contains all the nodes in a supported subgraph.
@@ -415,7 +481,7 @@ struct OpData {
 tensorflow::Status DelegateKernel::ExecuteOpKernelRunner(
     tensorflow::tfrt_stub::OpKernelRunState* run_state, TfLiteContext* context,
     OpNode* node_data) {
-  const auto& op_kernel_runner = node_data->op_kernel_runner();
+  const auto& op_kernel_runner = *node_data->op_kernel_runner();
 
   if (op_kernel_runner.op_kernel()->num_outputs() != node_data->NumOutputs()) {
     return tensorflow::errors::Internal(
@@ -611,7 +677,7 @@ TfLiteStatus DelegateKernel::Prepare(TfLiteContext* context, TfLiteNode* node) {
                          node_data->name().c_str());
       return kTfLiteError;
     }
-    TF_LITE_ENSURE(context, node_data->op_kernel_runner());
+    TF_LITE_ENSURE(context, node_data->op_kernel_runner() != nullptr);
 
     for (int i = 0; i < node_data->inputs().Size(); ++i) {
       ++tensor_ref_count[node_data->inputs().TfLiteIndex(i)];
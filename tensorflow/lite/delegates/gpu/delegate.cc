@@ -203,6 +203,22 @@ class Delegate {
     return telemetry_settings_.get();
   }
 
+  // Records that the tensor at `tensor_index` is backed by the user-provided
+  // GL SSBO `buffer_id`. Only allowed before delegate kernels are created;
+  // the binding is baked into the tensor's object def at preparation time.
+  bool BindGlBufferToTensor(uint32_t buffer_id, int tensor_index) {
+    if (num_delegate_kernels_ > 0 || tensor_index < 0) {
+      return false;
+    }
+    gl_buffer_by_tensor_[tensor_index] = buffer_id;
+    return true;
+  }
+  // Returns the GL SSBO bound to `tensor_index`, or nullptr if none.
+  const uint32_t* FindGlBufferForTensor(int tensor_index) const {
+    const auto it = gl_buffer_by_tensor_.find(tensor_index);
+    return it != gl_buffer_by_tensor_.end() ? &it->second : nullptr;
+  }
+
  private:
   TfLiteDelegate delegate_;
   TfLiteGpuDelegateOptionsV2 options_;
@@ -210,6 +226,9 @@ class Delegate {
 
   std::unique_ptr<Serialization> serialization_;
 
+  // Maps tensor index to the id of the user-provided GL SSBO backing it.
+  absl::flat_hash_map<int, uint32_t> gl_buffer_by_tensor_;
+
   std::unique_ptr<TfLiteTelemetryGpuDelegateSettings> telemetry_settings_;
 
   bool async_;
@@ -244,6 +263,9 @@ class DelegateKernelCore {
     return quant_conversion_map_;
   }
   const std::unique_ptr<InferenceRunner>& runner() const { return runner_; }
+  const uint32_t* FindGlBufferForTensor(int tensor_index) const {
+    return delegate_->FindGlBufferForTensor(tensor_index);
+  }
 
   absl::Status Setup(TfLiteContext* context,
                      const TfLiteDelegateParams* delegate_params);
@@ -311,7 +333,9 @@ ObjectDef DelegateKernelCore::GetObjectDef(int index,
   default_object_def.data_type = data_type;
   default_object_def.data_layout = DataLayout::BHWC;
   default_object_def.object_type =
-      delegate_->async() ? ObjectType::OPENGL_SSBO : ObjectType::CPU_MEMORY;
+      delegate_->async() || delegate_->FindGlBufferForTensor(index) != nullptr
+          ? ObjectType::OPENGL_SSBO
+          : ObjectType::CPU_MEMORY;
   default_object_def.user_provided = true;
   return default_object_def;
 }
@@ -668,6 +692,11 @@ class DelegateKernel {
   }
 
   TensorObject GetTensorObject(int index, TfLiteContext* context) const {
+    if (const uint32_t* gl_buffer_id = core_.FindGlBufferForTensor(index)) {
+      OpenGlBuffer buffer;
+      buffer.id = *gl_buffer_id;
+      return buffer;
+    }
     auto& tensor = context->tensors[index];
     return MakeCpuMemory(absl::MakeSpan(tensor.data.raw, tensor.bytes));
   }
@@ -1419,3 +1448,18 @@ TfLiteDelegate* TfLiteGpuDelegateV2CreateAsync(
 void TfLiteGpuDelegateV2Delete(TfLiteDelegate* delegate) {
   delete tflite::gpu::GetDelegate(delegate);
 }
+
+TfLiteStatus TfLiteGpuDelegateV2BindGlBufferToTensor(TfLiteDelegate* delegate,
+                                                     uint32_t buffer,
+                                                     int tensor_index) {
+  auto* gpu_delegate = tflite::gpu::GetDelegate(delegate);
+  if (!gpu_delegate ||
+      !gpu_delegate->BindGlBufferToTensor(buffer, tensor_index)) {
+    TFLITE_LOG_PROD(
+        tflite::TFLITE_LOG_ERROR,
+        "TfLiteGpuDelegateV2BindGlBufferToTensor must be called with a valid "
+        "tensor index before the delegate is added to the interpreter.");
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
@@ -46,6 +46,23 @@ TFL_CAPI_EXPORT TfLiteDelegate* TfLiteGpuDelegateV2CreateAsync(
 // Destroys a delegate created with `TfLiteGpuDelegateV2Create` call.
 TFL_CAPI_EXPORT void TfLiteGpuDelegateV2Delete(TfLiteDelegate* delegate);
 
+// Binds the OpenGL SSBO identified by `buffer` as the storage of the tensor at
+// `tensor_index`, so the delegate reads (or writes) that buffer directly
+// instead of staging the data through the tensor's CPU memory. This enables
+// zero-copy ingestion of camera frames: import the camera AHardwareBuffer into
+// a GL buffer object (e.g. with eglGetNativeClientBufferANDROID and
+// glBufferStorageExternalEXT) and bind that buffer to the input tensor, saving
+// both the application-side copy into the tensor and the delegate's upload.
+//
+// Must be called *before* `Interpreter::ModifyGraphWithDelegate`; the binding
+// is baked into the delegate kernels at preparation time. The buffer must
+// outlive the delegate, must hold the tensor data in the delegate's layout
+// (float32, BHWC), and must be at least as large as the tensor. Requires a
+// backend with OpenGL support (the GL backend, or OpenCL with GL sharing);
+// otherwise delegate preparation fails.
+TFL_CAPI_EXPORT TfLiteStatus TfLiteGpuDelegateV2BindGlBufferToTensor(
+    TfLiteDelegate* delegate, uint32_t buffer, int tensor_index);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
@@ -30,6 +30,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -43,6 +44,48 @@ namespace delegates {
 namespace {
 
 static const char kDelegatedNodesSuffix[] = "_dnodes";
+static const char kSubgraphPlanSuffix[] = "_plan";
+
+// Bumped whenever the SubgraphPlanSnapshot wire format changes, so older
+// cached plans are rejected instead of misparsed.
+constexpr uint32_t kSubgraphPlanVersion = 1;
+
+inline void AppendRaw(const void* data, size_t size, std::string* out) {
+  out->append(reinterpret_cast<const char*>(data), size);
+}
+
+template <typename T>
+inline void AppendScalar(T value, std::string* out) {
+  AppendRaw(&value, sizeof(T), out);
+}
+
+template <typename T>
+inline bool ReadScalar(const std::string& in, size_t* pos, T* out) {
+  if (in.size() - *pos < sizeof(T)) return false;
+  memcpy(out, in.data() + *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+
+template <typename T>
+inline bool ReadVector(const std::string& in, size_t* pos,
+                       std::vector<T>* out) {
+  int32_t size = 0;
+  if (!ReadScalar(in, pos, &size) || size < 0 ||
+      (in.size() - *pos) / sizeof(T) < static_cast<size_t>(size)) {
+    return false;
+  }
+  out->resize(size);
+  memcpy(out->data(), in.data() + *pos, size * sizeof(T));
+  *pos += size * sizeof(T);
+  return true;
+}
+
+template <typename T>
+inline void AppendVector(const std::vector<T>& in, std::string* out) {
+  AppendScalar<int32_t>(in.size(), out);
+  AppendRaw(in.data(), in.size() * sizeof(T), out);
+}
 
 // Farmhash Fingerprint
 inline uint64_t CombineFingerprints(uint64_t l, uint64_t h) {
@@ -318,5 +361,78 @@ TfLiteStatus GetDelegatedNodes(TfLiteContext* context,
   return kTfLiteOk;
 }
 
+TfLiteStatus SaveSubgraphPlan(TfLiteContext* context,
+                              Serialization* serialization,
+                              const std::string& plan_id,
+                              const SubgraphPlanSnapshot& plan) {
+  std::string payload;
+  AppendVector(plan.execution_plan, &payload);
+  AppendScalar<int32_t>(plan.delegated_partitions.size(), &payload);
+  for (const std::vector<int32_t>& partition : plan.delegated_partitions) {
+    AppendVector(partition, &payload);
+  }
+  AppendVector(plan.arena_offsets, &payload);
+
+  std::string blob;
+  blob.reserve(sizeof(uint32_t) + sizeof(uint64_t) + payload.size());
+  AppendScalar<uint32_t>(kSubgraphPlanVersion, &blob);
+  AppendScalar<uint64_t>(::util::Fingerprint64(payload.data(), payload.size()),
+                         &blob);
+  blob += payload;
+
+  auto entry = serialization->GetEntryForDelegate(plan_id + kSubgraphPlanSuffix,
+                                                  context);
+  return entry.SetData(context, blob.data(), blob.size());
+}
+
+TfLiteStatus GetSubgraphPlan(TfLiteContext* context,
+                             Serialization* serialization,
+                             const std::string& plan_id,
+                             SubgraphPlanSnapshot* plan) {
+  if (!plan) return kTfLiteError;
+  auto entry = serialization->GetEntryForDelegate(plan_id + kSubgraphPlanSuffix,
+                                                  context);
+  std::string blob;
+  TF_LITE_ENSURE_STATUS(entry.GetData(context, &blob));
+
+  size_t pos = 0;
+  uint32_t version = 0;
+  uint64_t checksum = 0;
+  if (!ReadScalar(blob, &pos, &version) || !ReadScalar(blob, &pos, &checksum)) {
+    TF_LITE_KERNEL_LOG(context, "Truncated subgraph plan for %s",
+                       plan_id.c_str());
+    return kTfLiteDelegateDataReadError;
+  }
+  if (version != kSubgraphPlanVersion) {
+    TF_LITE_KERNEL_LOG(context, "Stale subgraph plan version %d for %s",
+                       version, plan_id.c_str());
+    return kTfLiteDelegateDataReadError;
+  }
+  if (checksum !=
+      ::util::Fingerprint64(blob.data() + pos, blob.size() - pos)) {
+    TF_LITE_KERNEL_LOG(context, "Corrupt subgraph plan for %s",
+                       plan_id.c_str());
+    return kTfLiteDelegateDataReadError;
+  }
+
+  SubgraphPlanSnapshot result;
+  int32_t num_partitions = 0;
+  if (!ReadVector(blob, &pos, &result.execution_plan) ||
+      !ReadScalar(blob, &pos, &num_partitions) || num_partitions < 0) {
+    return kTfLiteDelegateDataReadError;
+  }
+  result.delegated_partitions.resize(num_partitions);
+  for (int32_t i = 0; i < num_partitions; ++i) {
+    if (!ReadVector(blob, &pos, &result.delegated_partitions[i])) {
+      return kTfLiteDelegateDataReadError;
+    }
+  }
+  if (!ReadVector(blob, &pos, &result.arena_offsets) || pos != blob.size()) {
+    return kTfLiteDelegateDataReadError;
+  }
+  *plan = std::move(result);
+  return kTfLiteOk;
+}
+
 }  // namespace delegates
 }  // namespace tflite
@@ -225,6 +225,39 @@ TfLiteStatus GetDelegatedNodes(TfLiteContext* context,
                                const std::string& delegate_id,
                                TfLiteIntArray** node_ids);
 
+// Snapshot of the one-time planning work done the first time an interpreter
+// for a model is prepared: node execution order, delegate partitions, and the
+// arena offsets computed by the memory planner. Clients can persist this
+// after the first AllocateTensors() and feed it back on later process starts
+// to skip re-planning. The Serialization's model_token should be derived from
+// the model flatbuffer via StrFingerprint(), so a changed model never matches
+// a stale plan.
+struct SubgraphPlanSnapshot {
+  // Node indices in execution order.
+  std::vector<int32_t> execution_plan;
+  // For each applied delegate, the node ids it claimed, in application order.
+  std::vector<std::vector<int32_t>> delegated_partitions;
+  // Byte offset of each tensor in the memory arena, or -1 for tensors that
+  // are not arena-allocated.
+  std::vector<int64_t> arena_offsets;
+};
+
+// Persists `plan` under `plan_id` for the given model & context.
+// Returns kTfLiteOk on success, kTfLiteDelegateDataWriteError on I/O issues.
+TfLiteStatus SaveSubgraphPlan(TfLiteContext* context,
+                              Serialization* serialization,
+                              const std::string& plan_id,
+                              const SubgraphPlanSnapshot& plan);
+
+// Retrieves a plan saved earlier with SaveSubgraphPlan. The stored payload
+// carries a format version and a 64-bit checksum; data that is stale, corrupt
+// or truncated yields kTfLiteDelegateDataReadError, a missing entry
+// kTfLiteDelegateDataNotFound.
+TfLiteStatus GetSubgraphPlan(TfLiteContext* context,
+                             Serialization* serialization,
+                             const std::string& plan_id,
+                             SubgraphPlanSnapshot* plan);
+
 }  // namespace delegates
 }  // namespace tflite
 
@@ -367,6 +367,70 @@ TEST_F(SerializationTest, CachingDelegatedNodes) {
   TfLiteIntArrayFree(empty_nodes_array);
 }
 
+TEST_F(SerializationTest, CachingSubgraphPlan) {
+  std::string model_token = "model1";
+  std::string test_dir = getSerializationDir();
+  SerializationParams serialization_params = {model_token.c_str(),
+                                              test_dir.c_str()};
+  Serialization serialization(serialization_params);
+  TfLiteContext context = GenerateTfLiteContext(/*num_tensors*/ 30);
+
+  SubgraphPlanSnapshot plan;
+  plan.execution_plan = {0, 1, 3, 2, 4};
+  plan.delegated_partitions = {{1, 3}, {4}};
+  plan.arena_offsets = {0, 64, -1, 128, 256};
+
+  SubgraphPlanSnapshot read_back;
+  ASSERT_EQ(GetSubgraphPlan(&context, &serialization, "primary", &read_back),
+            kTfLiteDelegateDataNotFound);
+
+  ASSERT_EQ(SaveSubgraphPlan(&context, &serialization, "primary", plan),
+            kTfLiteOk);
+  ASSERT_EQ(GetSubgraphPlan(&context, &serialization, "primary", &read_back),
+            kTfLiteOk);
+  EXPECT_EQ(read_back.execution_plan, plan.execution_plan);
+  EXPECT_EQ(read_back.delegated_partitions, plan.delegated_partitions);
+  EXPECT_EQ(read_back.arena_offsets, plan.arena_offsets);
+
+  // nullptr invalid.
+  ASSERT_EQ(GetSubgraphPlan(&context, &serialization, "primary", nullptr),
+            kTfLiteError);
+}
+
+TEST_F(SerializationTest, SubgraphPlanRejectsCorruptData) {
+  std::string model_token = "model1";
+  std::string test_dir = getSerializationDir();
+  SerializationParams serialization_params = {model_token.c_str(),
+                                              test_dir.c_str()};
+  Serialization serialization(serialization_params);
+  TfLiteContext context = GenerateTfLiteContext(/*num_tensors*/ 30);
+
+  SubgraphPlanSnapshot plan;
+  plan.execution_plan = {0, 1, 2};
+  plan.arena_offsets = {0, 32, 64};
+  ASSERT_EQ(SaveSubgraphPlan(&context, &serialization, "corrupt_test", plan),
+            kTfLiteOk);
+
+  // Flip a payload byte behind the cache's back; the checksum must catch it.
+  auto entry =
+      serialization.GetEntryForDelegate("corrupt_test_plan", &context);
+  std::string blob;
+  ASSERT_EQ(entry.GetData(&context, &blob), kTfLiteOk);
+  blob.back() ^= 0xff;
+  ASSERT_EQ(entry.SetData(&context, blob.data(), blob.size()), kTfLiteOk);
+
+  SubgraphPlanSnapshot read_back;
+  ASSERT_EQ(
+      GetSubgraphPlan(&context, &serialization, "corrupt_test", &read_back),
+      kTfLiteDelegateDataReadError);
+
+  // A truncated blob is rejected as well.
+  ASSERT_EQ(entry.SetData(&context, blob.data(), sizeof(uint32_t)), kTfLiteOk);
+  ASSERT_EQ(
+      GetSubgraphPlan(&context, &serialization, "corrupt_test", &read_back),
+      kTfLiteDelegateDataReadError);
+}
+
 }  // namespace
 }  // namespace delegates
 }  // namespace tflite
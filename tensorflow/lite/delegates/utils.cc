@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <cstring>
 #include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -193,6 +194,85 @@ TfLiteStatus GraphPartitionHelper::PrepareSupportedNodes(
   return kTfLiteOk;
 }
 
+std::string PartitionCostProfile::Serialize() const {
+  std::stringstream stream;
+  stream << transfer_us_per_mb << " " << partition_overhead_us;
+  stream << " " << cpu_latency_us.size();
+  for (const auto& entry : cpu_latency_us) {
+    stream << " " << entry.first << " " << entry.second;
+  }
+  stream << " " << delegate_latency_us.size();
+  for (const auto& entry : delegate_latency_us) {
+    stream << " " << entry.first << " " << entry.second;
+  }
+  return stream.str();
+}
+
+bool PartitionCostProfile::Deserialize(const std::string& data,
+                                       PartitionCostProfile* profile) {
+  std::stringstream stream(data);
+  if (!(stream >> profile->transfer_us_per_mb >>
+        profile->partition_overhead_us)) {
+    return false;
+  }
+  for (auto* latency_map :
+       {&profile->cpu_latency_us, &profile->delegate_latency_us}) {
+    size_t num_entries = 0;
+    if (!(stream >> num_entries)) return false;
+    for (size_t i = 0; i < num_entries; ++i) {
+      int node_id;
+      int64_t latency_us;
+      if (!(stream >> node_id >> latency_us)) return false;
+      (*latency_map)[node_id] = latency_us;
+    }
+  }
+  return true;
+}
+
+int64_t CostAwareGraphPartitionHelper::EstimatedSavingUs(
+    const TfLiteDelegateParams& partition) const {
+  int64_t saving_us = 0;
+  for (int node_id : TfLiteIntArrayView(partition.nodes_to_replace)) {
+    const auto cpu_it = profile_.cpu_latency_us.find(node_id);
+    if (cpu_it != profile_.cpu_latency_us.end()) saving_us += cpu_it->second;
+    const auto delegate_it = profile_.delegate_latency_us.find(node_id);
+    if (delegate_it != profile_.delegate_latency_us.end()) {
+      saving_us -= delegate_it->second;
+    }
+  }
+  // Account for the data crossing the partition boundary. Constant input
+  // tensors are excluded as delegates typically upload them once at
+  // initialization time rather than on every invocation.
+  int64_t transfer_bytes = 0;
+  for (const auto* tensor_indices :
+       {partition.input_tensors, partition.output_tensors}) {
+    if (tensor_indices == nullptr) continue;
+    for (int tensor_id : TfLiteIntArrayView(tensor_indices)) {
+      const TfLiteTensor& tensor = context_->tensors[tensor_id];
+      if (IsConstantTensor(&tensor)) continue;
+      transfer_bytes += static_cast<int64_t>(tensor.bytes);
+    }
+  }
+  saving_us -= profile_.partition_overhead_us +
+               (profile_.transfer_us_per_mb * transfer_bytes) / (1 << 20);
+  return saving_us;
+}
+
+std::vector<int>
+CostAwareGraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
+    int n, int min_nodes_per_partition) {
+  auto first_n_partitions =
+      GetFirstNLargestPartitions(n, min_nodes_per_partition);
+  std::vector<int> ops_to_replace;
+  for (const auto p : first_n_partitions) {
+    if (EstimatedSavingUs(*p) < 0) continue;
+    auto nodes = p->nodes_to_replace;
+    ops_to_replace.insert(ops_to_replace.end(), nodes->data,
+                          nodes->data + nodes->size);
+  }
+  return ops_to_replace;
+}
+
 std::vector<int>
 FP16GraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
     int n, int min_nodes_per_partition) {
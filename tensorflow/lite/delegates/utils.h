@@ -18,6 +18,7 @@ limitations under the License.
 
 // Utility functions and classes for implementing delegates.
 
+#include <cstdint>
 #include <functional>
 #include <limits>
 #include <set>
@@ -214,6 +215,65 @@ class GraphPartitionHelper {
   TfLiteIntArray* supported_nodes_ = nullptr;  // owns the memory
 };
 
+// A per-device latency profile used by CostAwareGraphPartitionHelper to
+// decide which partitions actually benefit from delegation. The per-node
+// latencies are measured once per device per backend (e.g. with the
+// per-operator profiler in tensorflow/lite/profiling) and the profile can be
+// cached across application launches via Serialize()/Deserialize(), e.g.
+// through tensorflow/lite/delegates/serialization.h.
+struct PartitionCostProfile {
+  // Measured per-node latencies in microseconds, keyed by node index in the
+  // (pre-delegation) execution plan.
+  std::unordered_map<int, int64_t> cpu_latency_us;
+  std::unordered_map<int, int64_t> delegate_latency_us;
+
+  // Cost of transferring one megabyte of tensor data across a CPU/delegate
+  // partition boundary, in microseconds.
+  int64_t transfer_us_per_mb = 0;
+
+  // Fixed per-partition dispatch overhead, in microseconds.
+  int64_t partition_overhead_us = 0;
+
+  // Serializes the profile into a printable string so that clients can cache
+  // it across application launches.
+  std::string Serialize() const;
+
+  // Parses a string produced by Serialize(). Returns false on malformed
+  // input, in which case '*profile' is left unspecified.
+  static bool Deserialize(const std::string& data,
+                          PartitionCostProfile* profile);
+};
+
+// Specialized partitioner that only delegates partitions whose measured
+// latency on the delegate, including boundary-transfer costs, is not larger
+// than their measured latency on the CPU. Nodes without measurements
+// contribute no latency difference, so with an empty profile this behaves
+// exactly like GraphPartitionHelper.
+class CostAwareGraphPartitionHelper : public GraphPartitionHelper {
+ public:
+  CostAwareGraphPartitionHelper(TfLiteContext* context,
+                                IsNodeSupportedFn is_node_supported_fn,
+                                PartitionCostProfile profile)
+      : GraphPartitionHelper(context, std::move(is_node_supported_fn)),
+        profile_(std::move(profile)) {}
+
+ protected:
+  // Drops partitions that the profile estimates to be slower on the delegate
+  // than on the CPU, then selects among the remaining ones like the base
+  // class.
+  std::vector<int> GetNodesOfFirstNLargestPartitionsImpl(
+      int n, int min_nodes_per_partition) override;
+
+ private:
+  // Returns the estimated end-to-end latency saving, in microseconds, of
+  // delegating the given partition. This includes the cost of transferring
+  // the partition's non-constant boundary tensors; a negative value means the
+  // partition is faster on the CPU.
+  int64_t EstimatedSavingUs(const TfLiteDelegateParams& partition) const;
+
+  const PartitionCostProfile profile_;
+};
+
 // Specialized partitioner for graphs that possibly contain fp16 tensors.
 //
 // From nodes that accept fp16 inputs, this delegates the following:
@@ -51,7 +51,7 @@ const TfLiteOpaqueDelegatePlugin sample_stable_delegate_plugin = {
 const TfLiteStableDelegate sample_stable_delegate = {
     TFL_STABLE_DELEGATE_ABI_VERSION, tflite::example::kSampleStableDelegateName,
     tflite::example::kSampleStableDelegateVersion,
-    &sample_stable_delegate_plugin};
+    &sample_stable_delegate_plugin, /*async_capabilities=*/nullptr};
 
 }  // namespace
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <string.h>
 
 #include <cerrno>
+#include <cstdio>
 #include <string>
 
 #include "tensorflow/lite/acceleration/configuration/c/stable_delegate.h"
@@ -63,6 +64,24 @@ const TfLiteStableDelegate* LoadDelegateFromSharedLibrary(
   return reinterpret_cast<const TfLiteStableDelegate*>(symbol_pointer);
 }
 
+const TfLiteStableDelegateAsyncCapabilities* GetStableDelegateAsyncCapabilities(
+    const TfLiteStableDelegate* stable_delegate) {
+  if (!stable_delegate || !stable_delegate->delegate_abi_version) {
+    return nullptr;
+  }
+  // The 'async_capabilities' field was added in ABI version 1.1.0; reading it
+  // from a delegate built against an earlier struct layout would be
+  // out-of-bounds. Delegates with a different major version may have changed
+  // the struct layout altogether, so only accept 1.x with x >= 1.
+  int major = 0, minor = 0;
+  if (sscanf(stable_delegate->delegate_abi_version, "%d.%d", &major, &minor) !=
+          2 ||
+      major != 1 || minor < 1) {
+    return nullptr;
+  }
+  return stable_delegate->async_capabilities;
+}
+
 void* LoadSymbolFromSharedLibrary(const std::string& delegate_path,
                                   const std::string& delegate_symbol) {
   // TODO(b/268483011): Use android_dlopen_ext to support loading from an offset
@@ -42,6 +42,15 @@ const TfLiteStableDelegate* LoadDelegateFromSharedLibrary(
 void* LoadSymbolFromSharedLibrary(const std::string& delegate_path,
                                   const std::string& delegate_symbol);
 
+// Returns the asynchronous execution capabilities of the given stable
+// delegate, or null if the delegate only supports synchronous invocation.
+// This also returns null for delegates built against a stable delegate ABI
+// version earlier than 1.1.0, whose TfLiteStableDelegate struct does not
+// contain the 'async_capabilities' field; use this helper instead of reading
+// the field directly to stay compatible with such delegates.
+const TfLiteStableDelegateAsyncCapabilities* GetStableDelegateAsyncCapabilities(
+    const TfLiteStableDelegate* stable_delegate);
+
 // TODO(b/239825926): Add ABI version check when loading TfLiteStableDelegate.
 
 }  // namespace utils
@@ -67,6 +67,34 @@ TEST(TfLiteDelegateLoaderUtilsTest, Simple) {
   stable_delegate_handle->delegate_plugin->destroy(delegate);
 }
 
+TEST(TfLiteDelegateLoaderUtilsTest, AsyncCapabilities) {
+  const char* const kSyncTypes[] = {"sync_fence_fd", nullptr};
+  const TfLiteStableDelegateAsyncCapabilities async_capabilities = {
+      /*supported_buffer_types=*/nullptr,
+      /*supported_synchronization_types=*/kSyncTypes};
+  TfLiteStableDelegate stable_delegate = {
+      TFL_STABLE_DELEGATE_ABI_VERSION, "test_delegate", "1.0.0",
+      /*delegate_plugin=*/nullptr, &async_capabilities};
+
+  EXPECT_EQ(tflite::delegates::utils::GetStableDelegateAsyncCapabilities(
+                &stable_delegate),
+            &async_capabilities);
+
+  // The field must not be read from delegates built against ABI versions
+  // before 1.1.0 or with a different major version.
+  stable_delegate.delegate_abi_version = "1.0.0";
+  EXPECT_EQ(tflite::delegates::utils::GetStableDelegateAsyncCapabilities(
+                &stable_delegate),
+            nullptr);
+  stable_delegate.delegate_abi_version = "2.0.0";
+  EXPECT_EQ(tflite::delegates::utils::GetStableDelegateAsyncCapabilities(
+                &stable_delegate),
+            nullptr);
+  EXPECT_EQ(
+      tflite::delegates::utils::GetStableDelegateAsyncCapabilities(nullptr),
+      nullptr);
+}
+
 TEST(TfLiteDelegateLoaderUtilsTest, WrongSymbolReturnsNullptr) {
   void* symbol_pointer = LoadSymbolFromSharedLibrary(
       "tensorflow/lite/delegates/utils/experimental/"
@@ -26,8 +26,8 @@ extern "C" {
  */
 extern TFL_STABLE_DELEGATE_EXPORT const TfLiteStableDelegate
     TFL_TheStableDelegate = {TFL_STABLE_DELEGATE_ABI_VERSION, "XNNPACKDelegate",
-                             TfLiteVersion(),
-                             TfLiteXnnpackDelegatePluginCApi()};
+                             TfLiteVersion(), TfLiteXnnpackDelegatePluginCApi(),
+                             /*async_capabilities=*/nullptr};
 #ifdef __cplusplus
 }  // extern "C"
 #endif
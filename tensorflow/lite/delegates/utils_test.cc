@@ -295,6 +295,56 @@ TEST(GraphPartitionHelper, CheckPartitionsWithSupportedNodeList) {
   EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
 }
 
+TEST(PartitionCostProfile, SerializeAndDeserialize) {
+  PartitionCostProfile profile;
+  profile.cpu_latency_us[0] = 100;
+  profile.cpu_latency_us[3] = 250;
+  profile.delegate_latency_us[0] = 40;
+  profile.transfer_us_per_mb = 500;
+  profile.partition_overhead_us = 20;
+
+  PartitionCostProfile parsed;
+  EXPECT_TRUE(PartitionCostProfile::Deserialize(profile.Serialize(), &parsed));
+  EXPECT_EQ(profile.cpu_latency_us, parsed.cpu_latency_us);
+  EXPECT_EQ(profile.delegate_latency_us, parsed.delegate_latency_us);
+  EXPECT_EQ(profile.transfer_us_per_mb, parsed.transfer_us_per_mb);
+  EXPECT_EQ(profile.partition_overhead_us, parsed.partition_overhead_us);
+
+  EXPECT_FALSE(PartitionCostProfile::Deserialize("not a profile", &parsed));
+  EXPECT_FALSE(PartitionCostProfile::Deserialize("500 20 1 0", &parsed));
+}
+
+TEST(CostAwareGraphPartitionHelper, CheckPartitionSelection) {
+  // The mocked TfLiteContext has 4 partitions: {1}, {0,3,7,8}, {2,4,9}, {5,6}.
+  // Mark {0,3,7,8} as slower on the delegate and {2,4,9} as faster; leave the
+  // remaining nodes unmeasured so their partitions are kept.
+  PartitionCostProfile profile;
+  for (int node_id : {0, 3, 7, 8}) {
+    profile.cpu_latency_us[node_id] = 10;
+    profile.delegate_latency_us[node_id] = 50;
+  }
+  for (int node_id : {2, 4, 9}) {
+    profile.cpu_latency_us[node_id] = 50;
+    profile.delegate_latency_us[node_id] = 10;
+  }
+
+  MockTfLiteContext mocked_context;
+  CostAwareGraphPartitionHelper helper(&mocked_context, IsNodeSupported,
+                                       profile);
+  EXPECT_EQ(kTfLiteOk, helper.Partition(nullptr));
+  EXPECT_EQ(4, helper.num_partitions());
+
+  auto nodes = helper.GetNodesOfFirstNLargestPartitions(10, 0);
+  EXPECT_THAT(nodes, testing::ElementsAreArray({2, 4, 9, 5, 6, 1}));
+
+  // An empty profile keeps all partitions, like GraphPartitionHelper.
+  CostAwareGraphPartitionHelper empty_profile_helper(
+      &mocked_context, IsNodeSupported, PartitionCostProfile());
+  EXPECT_EQ(kTfLiteOk, empty_profile_helper.Partition(nullptr));
+  nodes = empty_profile_helper.GetNodesOfFirstNLargestPartitions(10, 0);
+  EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9, 5, 6, 1}));
+}
+
 }  // namespace
 }  // namespace delegates
 }  // namespace tflite
@@ -178,6 +178,60 @@ TEST(XNNPACK_WEIGHTS_CACHE, SoftFinalization) {
   ASSERT_EQ(kTfLiteOk, interpreter2->Invoke());
 }
 
+TEST(XNNPACK_WEIGHTS_CACHE, FingerprintRegistry) {
+  std::vector<char> buffer = Conv2DTester().CreateTfLiteModel();
+  const Model* model = GetModel(buffer.data());
+  DummyOpResolver resolver;
+
+  constexpr char kFingerprint[] = "weights_cache_test_conv_2d";
+  TfLiteXNNPackDelegateWeightsCache* weights_cache =
+      TfLiteXNNPackDelegateWeightsCacheAcquire(kFingerprint);
+  ASSERT_NE(weights_cache, nullptr);
+
+  TfLiteXNNPackDelegateOptions delegate_options =
+      TfLiteXNNPackDelegateOptionsDefault();
+  delegate_options.weights_cache = weights_cache;
+
+  // Populate the cache with a first interpreter, then destroy the interpreter
+  // and delegate and release the cache.
+  {
+    std::unique_ptr<Interpreter> interpreter1;
+    ASSERT_EQ(kTfLiteOk, InterpreterBuilder(model, resolver)(&interpreter1));
+    ASSERT_EQ(kTfLiteOk, interpreter1->AllocateTensors());
+    std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+        delegate1(TfLiteXNNPackDelegateCreate(&delegate_options),
+                  TfLiteXNNPackDelegateDelete);
+    ASSERT_EQ(kTfLiteOk, interpreter1->ModifyGraphWithDelegate(delegate1.get()));
+    ASSERT_TRUE(
+        TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(weights_cache));
+    ASSERT_EQ(kTfLiteOk, interpreter1->Invoke());
+  }
+  TfLiteXNNPackDelegateWeightsCacheRelease(weights_cache);
+
+  // Re-acquiring the same fingerprint returns the surviving cache; eviction
+  // fails while it is in use.
+  ASSERT_EQ(weights_cache,
+            TfLiteXNNPackDelegateWeightsCacheAcquire(kFingerprint));
+  EXPECT_FALSE(TfLiteXNNPackDelegateWeightsCacheEvict(kFingerprint));
+
+  // A second interpreter reuses the packed weights.
+  std::unique_ptr<Interpreter> interpreter2;
+  ASSERT_EQ(kTfLiteOk, InterpreterBuilder(model, resolver)(&interpreter2));
+  ASSERT_EQ(kTfLiteOk, interpreter2->AllocateTensors());
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      delegate2(TfLiteXNNPackDelegateCreate(&delegate_options),
+                TfLiteXNNPackDelegateDelete);
+  ASSERT_EQ(kTfLiteOk, interpreter2->ModifyGraphWithDelegate(delegate2.get()));
+  ASSERT_EQ(kTfLiteOk, interpreter2->Invoke());
+  interpreter2.reset();
+  delegate2.reset();
+
+  TfLiteXNNPackDelegateWeightsCacheRelease(weights_cache);
+  EXPECT_TRUE(TfLiteXNNPackDelegateWeightsCacheEvict(kFingerprint));
+  // Evicting an unregistered fingerprint is a no-op that succeeds.
+  EXPECT_TRUE(TfLiteXNNPackDelegateWeightsCacheEvict(kFingerprint));
+}
+
 // Dummy class to use with parameterized test.
 class WeightsCacheTest : public testing::TestWithParam<size_t> {};
 
@@ -24,6 +24,7 @@ limitations under the License.
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT(build/c++11)
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -6893,6 +6894,82 @@ void TfLiteXNNPackDelegateWeightsCacheDelete(
   xnn_deinitialize();
 }
 
+namespace {
+
+// Process-wide registry of weights caches keyed by model fingerprint, so the
+// packed weights of recently used models survive interpreter and delegate
+// destruction.
+struct WeightsCacheRegistry {
+  struct Entry {
+    TfLiteXNNPackDelegateWeightsCache* cache = nullptr;
+    int num_uses = 0;
+  };
+  std::mutex mutex;
+  std::unordered_map<std::string, Entry> caches;
+};
+
+WeightsCacheRegistry& GetWeightsCacheRegistry() {
+  // Deliberately leaked: registered caches live for the process lifetime
+  // unless explicitly evicted.
+  static WeightsCacheRegistry* registry = new WeightsCacheRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+TfLiteXNNPackDelegateWeightsCache* TfLiteXNNPackDelegateWeightsCacheAcquire(
+    const char* model_fingerprint) {
+  if (model_fingerprint == nullptr) {
+    return nullptr;
+  }
+  WeightsCacheRegistry& registry = GetWeightsCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  WeightsCacheRegistry::Entry& entry = registry.caches[model_fingerprint];
+  if (entry.cache == nullptr) {
+    entry.cache = TfLiteXNNPackDelegateWeightsCacheCreate();
+    if (entry.cache == nullptr) {
+      registry.caches.erase(model_fingerprint);
+      return nullptr;
+    }
+  }
+  ++entry.num_uses;
+  return entry.cache;
+}
+
+void TfLiteXNNPackDelegateWeightsCacheRelease(
+    TfLiteXNNPackDelegateWeightsCache* cache) {
+  if (cache == nullptr) {
+    return;
+  }
+  WeightsCacheRegistry& registry = GetWeightsCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& fingerprint_and_entry : registry.caches) {
+    WeightsCacheRegistry::Entry& entry = fingerprint_and_entry.second;
+    if (entry.cache == cache && entry.num_uses > 0) {
+      --entry.num_uses;
+      return;
+    }
+  }
+}
+
+bool TfLiteXNNPackDelegateWeightsCacheEvict(const char* model_fingerprint) {
+  if (model_fingerprint == nullptr) {
+    return false;
+  }
+  WeightsCacheRegistry& registry = GetWeightsCacheRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  const auto it = registry.caches.find(model_fingerprint);
+  if (it == registry.caches.end()) {
+    return true;
+  }
+  if (it->second.num_uses > 0) {
+    return false;
+  }
+  TfLiteXNNPackDelegateWeightsCacheDelete(it->second.cache);
+  registry.caches.erase(it);
+  return true;
+}
+
 TfLiteXNNPackDelegateOptions TfLiteXNNPackDelegateOptionsDefault() {
   TfLiteXNNPackDelegateOptions options = {0};
 
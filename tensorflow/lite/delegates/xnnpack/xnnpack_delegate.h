@@ -133,6 +133,36 @@ TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheFinalizeHard(
 TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheDelete(
     struct TfLiteXNNPackDelegateWeightsCache* cache);
 
+// Returns the weights cache registered under `model_fingerprint`, creating and
+// registering a new one on first use. Registered caches outlive the delegates
+// and interpreters using them and are shared across concurrent interpreters,
+// so swapping back to a recently used model reuses its packed weights instead
+// of repacking them. `model_fingerprint` must uniquely identify the model
+// contents, e.g. a hash of the model flatbuffer. Finalize the returned cache
+// with TfLiteXNNPackDelegateWeightsCacheFinalizeSoft (NOT hard finalization),
+// so that delegates instantiated later can still insert entries. Each
+// successful call must be balanced by a call to
+// TfLiteXNNPackDelegateWeightsCacheRelease. Returns NULL on error.
+// This function is thread-safe.
+TFL_CAPI_EXPORT struct TfLiteXNNPackDelegateWeightsCache*
+TfLiteXNNPackDelegateWeightsCacheAcquire(const char* model_fingerprint);
+
+// Releases one use of a weights cache returned by
+// `TfLiteXNNPackDelegateWeightsCacheAcquire`. The cache stays registered (and
+// its packed weights stay resident) after the last use is released, until it
+// is evicted with TfLiteXNNPackDelegateWeightsCacheEvict.
+// This function is thread-safe.
+TFL_CAPI_EXPORT void TfLiteXNNPackDelegateWeightsCacheRelease(
+    struct TfLiteXNNPackDelegateWeightsCache* cache);
+
+// Deletes the weights cache registered under `model_fingerprint`, freeing its
+// packed weights. Returns false if the cache is still in use, i.e. has more
+// acquires than releases; returns true if it was evicted or was not
+// registered.
+// This function is thread-safe.
+TFL_CAPI_EXPORT bool TfLiteXNNPackDelegateWeightsCacheEvict(
+    const char* model_fingerprint);
+
 #ifdef __cplusplus
 }
 #endif  // __cplusplus
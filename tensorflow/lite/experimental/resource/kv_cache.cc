@@ -0,0 +1,84 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/experimental/resource/kv_cache.h"
+
+#include <cstring>
+#include <memory>
+
+namespace tflite {
+namespace resource {
+
+void KVCacheResource::Init(int max_tokens, int entry_size) {
+  if (max_tokens == max_tokens_ && entry_size == entry_size_) {
+    return;
+  }
+  max_tokens_ = max_tokens;
+  entry_size_ = entry_size;
+  keys_.assign(static_cast<size_t>(max_tokens) * entry_size, 0.f);
+  values_.assign(static_cast<size_t>(max_tokens) * entry_size, 0.f);
+  next_slot_ = 0;
+  num_tokens_ = 0;
+}
+
+void KVCacheResource::Append(const float* key, const float* value) {
+  memcpy(keys_.data() + static_cast<size_t>(next_slot_) * entry_size_, key,
+         entry_size_ * sizeof(float));
+  memcpy(values_.data() + static_cast<size_t>(next_slot_) * entry_size_, value,
+         entry_size_ * sizeof(float));
+  next_slot_ = (next_slot_ + 1) % max_tokens_;
+  if (num_tokens_ < max_tokens_) {
+    ++num_tokens_;
+  }
+}
+
+void KVCacheResource::Reset() {
+  next_slot_ = 0;
+  num_tokens_ = 0;
+}
+
+const float* KVCacheResource::GetKey(int index) const {
+  const int slot =
+      num_tokens_ < max_tokens_ ? index : (next_slot_ + index) % max_tokens_;
+  return keys_.data() + static_cast<size_t>(slot) * entry_size_;
+}
+
+const float* KVCacheResource::GetValue(int index) const {
+  const int slot =
+      num_tokens_ < max_tokens_ ? index : (next_slot_ + index) % max_tokens_;
+  return values_.data() + static_cast<size_t>(slot) * entry_size_;
+}
+
+void CreateKVCacheIfNotAvailable(ResourceMap* resources, int resource_id,
+                                 int max_tokens, int entry_size) {
+  auto it = resources->find(resource_id);
+  if (it == resources->end()) {
+    it = resources->emplace(resource_id, std::make_unique<KVCacheResource>())
+             .first;
+  }
+  static_cast<KVCacheResource*>(it->second.get())
+      ->Init(max_tokens, entry_size);
+}
+
+KVCacheResource* GetKVCache(ResourceMap* resources, int resource_id) {
+  auto it = resources->find(resource_id);
+  if (it != resources->end()) {
+    return static_cast<KVCacheResource*>(it->second.get());
+  }
+  return nullptr;
+}
+
+}  // namespace resource
+}  // namespace tflite
@@ -0,0 +1,99 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_KV_CACHE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_KV_CACHE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "tensorflow/lite/experimental/resource/resource_base.h"
+
+namespace tflite {
+namespace resource {
+
+/// WARNING: Experimental interface, subject to change.
+// A per-sequence key/value cache for autoregressive transformer decoding.
+// The cache stores the keys and values of the most recent `max_tokens`
+// tokens, each a flat float vector of `entry_size` elements (typically
+// num_heads * head_dim). Appending beyond the capacity overwrites the
+// oldest token (ring-buffer eviction), so a decode step appends one token
+// and attends over a bounded window instead of recomputing the whole
+// sequence's K/V projections.
+class KVCacheResource : public ResourceBase {
+ public:
+  KVCacheResource() {}
+  KVCacheResource(KVCacheResource&& other)
+      : keys_(std::move(other.keys_)),
+        values_(std::move(other.values_)),
+        max_tokens_(other.max_tokens_),
+        entry_size_(other.entry_size_),
+        next_slot_(other.next_slot_),
+        num_tokens_(other.num_tokens_) {}
+
+  KVCacheResource(const KVCacheResource&) = delete;
+  KVCacheResource& operator=(const KVCacheResource&) = delete;
+
+  // Allocates storage for `max_tokens` entries of `entry_size` floats each.
+  // Re-initializing with a different geometry discards any cached tokens.
+  void Init(int max_tokens, int entry_size);
+
+  // Appends one token's key and value (`entry_size` floats each). When the
+  // cache is full the oldest token is evicted to make room.
+  void Append(const float* key, const float* value);
+
+  // Forgets all cached tokens. Keeps the storage and geometry.
+  void Reset();
+
+  // Key/value of cached token `index`, where index 0 is the oldest cached
+  // token and `num_tokens() - 1` the most recently appended one.
+  const float* GetKey(int index) const;
+  const float* GetValue(int index) const;
+
+  int num_tokens() const { return num_tokens_; }
+  int max_tokens() const { return max_tokens_; }
+  int entry_size() const { return entry_size_; }
+
+  // Returns true if this cache has been initialized with `Init`.
+  bool IsInitialized() override { return max_tokens_ > 0; }
+
+  size_t GetMemoryUsage() override {
+    return (keys_.size() + values_.size()) * sizeof(float);
+  }
+
+ private:
+  // Flat [max_tokens, entry_size] ring buffers, fully owned by the resource.
+  std::vector<float> keys_;
+  std::vector<float> values_;
+  int max_tokens_ = 0;
+  int entry_size_ = 0;
+  // The slot the next `Append` writes to.
+  int next_slot_ = 0;
+  int num_tokens_ = 0;
+};
+
+// Creates a KV cache with the given geometry, shared among all the subgraphs
+// with the given resource id if there is an existing one.
+// WARNING: Experimental interface, subject to change.
+void CreateKVCacheIfNotAvailable(ResourceMap* resources, int resource_id,
+                                 int max_tokens, int entry_size);
+
+// Returns the corresponding KV cache, or nullptr if none.
+// WARNING: Experimental interface, subject to change.
+KVCacheResource* GetKVCache(ResourceMap* resources, int resource_id);
+
+}  // namespace resource
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_RESOURCE_KV_CACHE_H_
@@ -0,0 +1,114 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/resource/kv_cache.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace resource {
+namespace {
+
+TEST(KVCacheTest, InitAndAppend) {
+  KVCacheResource cache;
+  EXPECT_FALSE(cache.IsInitialized());
+
+  cache.Init(/*max_tokens=*/3, /*entry_size=*/2);
+  EXPECT_TRUE(cache.IsInitialized());
+  EXPECT_EQ(3, cache.max_tokens());
+  EXPECT_EQ(2, cache.entry_size());
+  EXPECT_EQ(0, cache.num_tokens());
+  EXPECT_EQ(2 * 3 * 2 * sizeof(float), cache.GetMemoryUsage());
+
+  std::vector<float> key = {1.f, 2.f};
+  std::vector<float> value = {3.f, 4.f};
+  cache.Append(key.data(), value.data());
+  EXPECT_EQ(1, cache.num_tokens());
+  EXPECT_EQ(1.f, cache.GetKey(0)[0]);
+  EXPECT_EQ(2.f, cache.GetKey(0)[1]);
+  EXPECT_EQ(3.f, cache.GetValue(0)[0]);
+  EXPECT_EQ(4.f, cache.GetValue(0)[1]);
+}
+
+TEST(KVCacheTest, RingBufferEviction) {
+  KVCacheResource cache;
+  cache.Init(/*max_tokens=*/2, /*entry_size=*/1);
+
+  for (float token = 1.f; token <= 3.f; ++token) {
+    const float key = token;
+    const float value = token * 10.f;
+    cache.Append(&key, &value);
+  }
+  // Token 1 was evicted; index 0 is the oldest surviving token.
+  EXPECT_EQ(2, cache.num_tokens());
+  EXPECT_EQ(2.f, cache.GetKey(0)[0]);
+  EXPECT_EQ(20.f, cache.GetValue(0)[0]);
+  EXPECT_EQ(3.f, cache.GetKey(1)[0]);
+  EXPECT_EQ(30.f, cache.GetValue(1)[0]);
+}
+
+TEST(KVCacheTest, Reset) {
+  KVCacheResource cache;
+  cache.Init(/*max_tokens=*/2, /*entry_size=*/1);
+  const float key = 1.f;
+  const float value = 2.f;
+  cache.Append(&key, &value);
+  EXPECT_EQ(1, cache.num_tokens());
+
+  cache.Reset();
+  EXPECT_EQ(0, cache.num_tokens());
+  EXPECT_TRUE(cache.IsInitialized());
+
+  cache.Append(&key, &value);
+  EXPECT_EQ(1, cache.num_tokens());
+  EXPECT_EQ(1.f, cache.GetKey(0)[0]);
+}
+
+TEST(KVCacheTest, ReinitWithNewGeometryDiscardsTokens) {
+  KVCacheResource cache;
+  cache.Init(/*max_tokens=*/2, /*entry_size=*/1);
+  const float key = 1.f;
+  const float value = 2.f;
+  cache.Append(&key, &value);
+
+  cache.Init(/*max_tokens=*/4, /*entry_size=*/1);
+  EXPECT_EQ(0, cache.num_tokens());
+  EXPECT_EQ(4, cache.max_tokens());
+}
+
+TEST(KVCacheTest, CreateAndGetFromResourceMap) {
+  ResourceMap resources;
+  EXPECT_EQ(nullptr, GetKVCache(&resources, 1));
+
+  CreateKVCacheIfNotAvailable(&resources, 1, /*max_tokens=*/2,
+                              /*entry_size=*/1);
+  auto* cache = GetKVCache(&resources, 1);
+  ASSERT_NE(nullptr, cache);
+  EXPECT_EQ(2, cache->max_tokens());
+
+  // Creating again with the same geometry keeps the existing cache.
+  const float key = 1.f;
+  const float value = 2.f;
+  cache->Append(&key, &value);
+  CreateKVCacheIfNotAvailable(&resources, 1, /*max_tokens=*/2,
+                              /*entry_size=*/1);
+  EXPECT_EQ(cache, GetKVCache(&resources, 1));
+  EXPECT_EQ(1, GetKVCache(&resources, 1)->num_tokens());
+}
+
+}  // namespace
+}  // namespace resource
+}  // namespace tflite
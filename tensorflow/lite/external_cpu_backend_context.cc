@@ -14,6 +14,14 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/external_cpu_backend_context.h"
 
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
 #include "tensorflow/lite/core/c/common.h"
 
 namespace tflite {
@@ -29,6 +37,49 @@ TfLiteStatus RefreshExternalCpuBackendContext(TfLiteContext* context) {
   }
   return kTfLiteOk;
 }
+
+// Applies `cpu_mask` to the calling thread. Returns false when thread
+// affinity is unsupported on this platform or the kernel rejects the mask.
+bool ApplyCpuAffinityMask(uint64_t cpu_mask) {
+#if defined(__ANDROID__) || defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu = 0; cpu < 64; ++cpu) {
+    if (cpu_mask & (UINT64_C(1) << cpu)) {
+      CPU_SET(cpu, &cpu_set);
+    }
+  }
+  return sched_setaffinity(/*pid=*/0, sizeof(cpu_set), &cpu_set) == 0;
+#else
+  (void)cpu_mask;
+  return false;
+#endif
+}
+
+// Reads a single cpufreq value (in kHz) for `cpu` from sysfs. Returns false
+// when the file is missing or unreadable.
+bool ReadCpuFreqKhz(int cpu, const char* file, int64_t* value) {
+  char path[128];
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/%s", cpu,
+           file);
+  FILE* f = fopen(path, "r");
+  if (f == nullptr) {
+    return false;
+  }
+  long long raw_value = 0;  // NOLINT - matches the %lld scanf format.
+  const bool ok = fscanf(f, "%lld", &raw_value) == 1;
+  fclose(f);
+  *value = raw_value;
+  return ok;
+}
+
+// A core counts as throttled when its current frequency ceiling
+// (scaling_max_freq, which the thermal framework lowers) falls below this
+// percentage of the hardware maximum (cpuinfo_max_freq). The ceiling is used
+// rather than the instantaneous frequency so that cores idling at a low
+// DVFS state are not misclassified.
+constexpr int kThrottledFreqCeilingPercent = 90;
+
 }  // namespace
 
 ExternalCpuBackendContext::ExternalCpuBackendContext()
@@ -37,4 +88,46 @@ ExternalCpuBackendContext::ExternalCpuBackendContext()
   this->Refresh = RefreshExternalCpuBackendContext;
 }
 
+TfLiteStatus ExternalCpuBackendContext::SetCpuAffinityMask(uint64_t cpu_mask) {
+  if (cpu_mask == 0 || !ApplyCpuAffinityMask(cpu_mask)) {
+    return kTfLiteError;
+  }
+  cpu_affinity_mask_ = cpu_mask;
+  return kTfLiteOk;
+}
+
+int ExternalCpuBackendContext::NumUnthrottledCpus() const {
+  int num_unthrottled = 0;
+  for (int cpu = 0; cpu < 64; ++cpu) {
+    if (!(cpu_affinity_mask_ & (UINT64_C(1) << cpu))) {
+      continue;
+    }
+    int64_t ceiling_khz = 0;
+    int64_t max_khz = 0;
+    if (!ReadCpuFreqKhz(cpu, "scaling_max_freq", &ceiling_khz) ||
+        !ReadCpuFreqKhz(cpu, "cpuinfo_max_freq", &max_khz) || max_khz <= 0 ||
+        ceiling_khz * 100 >= max_khz * kThrottledFreqCeilingPercent) {
+      ++num_unthrottled;
+    }
+  }
+  return num_unthrottled;
+}
+
+void ExternalCpuBackendContext::RefreshSchedulingForInvocation(
+    int recommended_num_threads) {
+  if (cpu_affinity_mask_ == 0) {
+    return;
+  }
+  // Other code may have changed the thread's affinity since the mask was set.
+  ApplyCpuAffinityMask(cpu_affinity_mask_);
+  if (internal_backend_context_ == nullptr) {
+    return;
+  }
+  int num_threads = std::max(NumUnthrottledCpus(), 1);
+  if (recommended_num_threads != -1) {
+    num_threads = std::min(num_threads, recommended_num_threads);
+  }
+  internal_backend_context_->SetMaxNumThreads(num_threads);
+}
+
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXTERNAL_CPU_BACKEND_CONTEXT_H_
 #define TENSORFLOW_LITE_EXTERNAL_CPU_BACKEND_CONTEXT_H_
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 
@@ -92,10 +93,39 @@ class ExternalCpuBackendContext : public TfLiteExternalContext {
     return internal_backend_context_.get();
   }
 
+  // Pins the calling thread to the cores in `cpu_mask` (bit i selects CPU i),
+  // e.g. the big cluster of a big.LITTLE SoC, so the OS scheduler cannot
+  // migrate compute threads onto slower cores mid-inference. Kernel worker
+  // threads inherit the affinity of the thread that creates them, so set the
+  // mask before the first invocation and invoke from the pinned thread.
+  // Returns kTfLiteError if the mask is empty, rejected by the kernel, or
+  // thread affinity is not supported on this platform.
+  // WARNING: This is an experimental API and subject to change.
+  TfLiteStatus SetCpuAffinityMask(uint64_t cpu_mask);
+
+  bool has_cpu_affinity_mask() const { return cpu_affinity_mask_ != 0; }
+
+  // Re-applies the affinity mask and clamps the number of compute threads to
+  // the cores of the mask whose frequency ceiling is currently near the
+  // hardware maximum, so thermally throttled cores do not serialize the whole
+  // invocation. Called by the runtime at the start of each invocation when an
+  // affinity mask is set; `recommended_num_threads` is the interpreter's
+  // thread setting (-1 if unset) and acts as an upper bound.
+  // WARNING: This is an experimental API and subject to change.
+  void RefreshSchedulingForInvocation(int recommended_num_threads);
+
  private:
+  // Returns the number of cores in the affinity mask that are not thermally
+  // throttled, judged by their current cpufreq policy ceiling. Cores whose
+  // frequency information is unavailable count as unthrottled.
+  int NumUnthrottledCpus() const;
+
   // Note the actual internal backend context object is lazily initialized.
   std::unique_ptr<TfLiteInternalBackendContext> internal_backend_context_;
 
+  // Bitmask of the CPUs compute threads are pinned to; 0 when unset.
+  uint64_t cpu_affinity_mask_ = 0;
+
   ExternalCpuBackendContext(const ExternalCpuBackendContext&) = delete;
   ExternalCpuBackendContext& operator=(const ExternalCpuBackendContext&) =
       delete;
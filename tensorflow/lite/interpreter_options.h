@@ -29,7 +29,8 @@ class InterpreterOptions {
       : experimental_preserve_all_tensors_(false),
         experimental_ensure_dynamic_tensors_are_released_(false),
         experimental_optimize_memory_for_large_tensors_(0),
-        experimental_disable_delegate_clustering_(false) {}
+        experimental_disable_delegate_clustering_(false),
+        experimental_double_buffer_boundary_tensors_(false) {}
 
   /// Preserving all intermediates tensors for debugging.
   /// WARNING: This is an experimental API and subject to change.
@@ -86,6 +87,25 @@ class InterpreterOptions {
     return experimental_disable_delegate_clustering_;
   }
 
+  /// Give each tensor crossing a partition boundary (produced and consumed by
+  /// differently-delegated partitions, including the CPU partition) two
+  /// alternating buffer halves instead of an arena slot. One invocation's
+  /// boundary data then stays readable while the next invocation writes the
+  /// other half, which lets callers pipeline partitions of consecutive frames
+  /// on separate threads. Delegates must read tensor data pointers at
+  /// invocation time, as is already required for custom allocations.
+  /// WARNING: This is an experimental API and subject to change.
+  void SetDoubleBufferBoundaryTensors(bool value = true) {
+    experimental_double_buffer_boundary_tensors_ = value;
+  }
+
+  /// Returns if the `experimental_double_buffer_boundary_tensors_` feature is
+  /// enabled.
+  /// WARNING: This is an experimental API and subject to change.
+  bool GetDoubleBufferBoundaryTensors() {
+    return experimental_double_buffer_boundary_tensors_;
+  }
+
   // If value == true, disable delegate clustering (see above), otherwise,
   // enable it.
   // WARNING: This is an experimental API and subject to change.
@@ -98,6 +118,7 @@ class InterpreterOptions {
   bool experimental_ensure_dynamic_tensors_are_released_;
   int experimental_optimize_memory_for_large_tensors_;
   bool experimental_disable_delegate_clustering_;
+  bool experimental_double_buffer_boundary_tensors_;
 };
 
 }  // namespace tflite
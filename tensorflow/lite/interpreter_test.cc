@@ -1948,6 +1948,62 @@ TEST_F(TestCustomAllocation, CustomInputAndOutputAllocs) {
   VerifyInvoke();
 }
 
+TEST_F(TestCustomAllocation, InvokeBatch) {
+  constexpr int kBatchSize = 2;
+  // Give every IO tensor a custom allocation holding kBatchSize examples.
+  std::map<int, TfLiteCustomAllocation> allocs;
+  for (int io_tensor_idx : {0, 1, 3, 4, 6}) {
+    const TfLiteTensor* tensor = interpreter_->tensor(io_tensor_idx);
+    auto alloc = NewCustomAlloc(kBatchSize * tensor->bytes,
+                                /*required_alignment=*/kDefaultTensorAlignment);
+    ASSERT_EQ(interpreter_->SetCustomAllocationForTensor(io_tensor_idx, alloc),
+              kTfLiteOk);
+    allocs[io_tensor_idx] = alloc;
+  }
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  // Write both examples up front.
+  std::vector<float> input0 = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<float> input1 = {10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f};
+  memcpy(allocs[0].data, input0.data(), input0.size() * sizeof(float));
+  memcpy(allocs[1].data, input1.data(), input1.size() * sizeof(float));
+
+  ASSERT_EQ(interpreter_->InvokeBatch(kBatchSize), kTfLiteOk);
+
+  // Output 3 = 2 * input1, output 4 = 2 * input0 + input1, output 6 =
+  // input0 + variable (zero-initialized), for each example.
+  const float* output3 = static_cast<const float*>(allocs[3].data);
+  const float* output4 = static_cast<const float*>(allocs[4].data);
+  const float* output6 = static_cast<const float*>(allocs[6].data);
+  for (int i = 0; i < kBatchSize * 3; ++i) {
+    EXPECT_EQ(output3[i], 2.0f * input1[i]) << i;
+    EXPECT_EQ(output4[i], 2.0f * input0[i] + input1[i]) << i;
+    EXPECT_EQ(output6[i], input0[i]) << i;
+  }
+  // The tensors are left pointing at the first example of the batch.
+  EXPECT_EQ(interpreter_->tensor(3)->data.data, allocs[3].data);
+}
+
+TEST_F(TestCustomAllocation, InvokeBatch_MissingCustomAllocs) {
+  // Only the inputs get custom allocations; outputs still live in the arena.
+  AssignCustomAllocForTensor(interpreter_->inputs()[0],
+                             /*required_alignment=*/kDefaultTensorAlignment);
+  AssignCustomAllocForTensor(interpreter_->inputs()[1],
+                             /*required_alignment=*/kDefaultTensorAlignment);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->InvokeBatch(2), kTfLiteError);
+}
+
+TEST_F(TestCustomAllocation, InvokeBatch_InsufficientBytes) {
+  // Allocations sized for a single example cannot hold a batch of two.
+  for (int io_tensor_idx : {0, 1, 3, 4, 6}) {
+    AssignCustomAllocForTensor(io_tensor_idx,
+                               /*required_alignment=*/kDefaultTensorAlignment);
+  }
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->InvokeBatch(2), kTfLiteError);
+}
+
 // Ensure that custom allocs work for tensors on persistent arena as well.
 TEST_F(TestCustomAllocation, CustomAlloc_VariableTensor) {
   // Set custom allocation for one input tensor.
@@ -123,6 +123,10 @@ struct OpData {
   int32_t groups = 1;
 
   TfLiteType quantized_bias_type = kTfLiteNoType;
+
+  // Caches a constant int4 filter unpacked to int8, so the unpack (and its
+  // allocation) happens once instead of on every invocation.
+  std::unique_ptr<int8_t[]> unpacked_int4_filter = nullptr;
 };
 
 inline PaddingType RuntimePaddingType(TfLitePadding padding) {
@@ -769,14 +773,27 @@ void EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
   }
 
   const int8_t* filter_data;
-  const size_t bytes_unpacked = filter->bytes * 2;
-  auto unpacked_filter_data = std::make_unique<int8_t[]>(bytes_unpacked);
+  std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
 
   if (filter->type == kTfLiteInt4) {
-    tflite::tensor_utils::UnpackDenseInt4IntoInt8(
-        GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
-        unpacked_filter_data.get());
-    filter_data = unpacked_filter_data.get();
+    if (IsConstantTensor(filter)) {
+      // Unpack constant filters once and reuse the cached copy on later
+      // invocations.
+      if (data->unpacked_int4_filter == nullptr) {
+        data->unpacked_int4_filter =
+            std::make_unique<int8_t[]>(filter->bytes * 2);
+        tflite::tensor_utils::UnpackDenseInt4IntoInt8(
+            GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
+            data->unpacked_int4_filter.get());
+      }
+      filter_data = data->unpacked_int4_filter.get();
+    } else {
+      unpacked_filter_data = std::make_unique<int8_t[]>(filter->bytes * 2);
+      tflite::tensor_utils::UnpackDenseInt4IntoInt8(
+          GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
+          unpacked_filter_data.get());
+      filter_data = unpacked_filter_data.get();
+    }
   } else {
     filter_data = GetTensorData<int8>(filter);
   }
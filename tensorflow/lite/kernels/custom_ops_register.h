@@ -27,6 +27,7 @@ TfLiteRegistration* Register_HASHTABLE();
 TfLiteRegistration* Register_HASHTABLE_FIND();
 TfLiteRegistration* Register_HASHTABLE_IMPORT();
 TfLiteRegistration* Register_HASHTABLE_SIZE();
+TfLiteRegistration* Register_INCREMENTAL_ATTENTION();
 TfLiteRegistration* Register_IRFFT2D();
 TfLiteRegistration* Register_MAX_POOL_3D();
 TfLiteRegistration* Register_MULTINOMIAL();
@@ -136,6 +136,9 @@ struct OpData {
   // Used for 4bit hybrid
   std::unique_ptr<optimized_4bit::OpData4Bit> op_data_4bit = nullptr;
   TfLiteType quantized_bias_type = kTfLiteNoType;
+  // Caches a constant int4 filter unpacked to int8, so the unpack (and its
+  // allocation) happens once instead of on every invocation.
+  std::unique_ptr<int8_t[]> unpacked_int4_filter = nullptr;
 };
 
 constexpr int kInputTensor = 0;
@@ -667,6 +670,29 @@ TfLiteStatus EvalPie(TfLiteContext* context, TfLiteNode* node,
   return kTfLiteOk;
 }
 
+// Returns the int4 `filter` unpacked to int8. Constant filters are unpacked
+// once and cached in `data`; otherwise `scoped_buffer` owns the unpacked data
+// for the duration of the call.
+const int8_t* GetInt4FilterUnpackedToInt8(
+    const TfLiteTensor* filter, OpData* data,
+    std::unique_ptr<int8_t[]>* scoped_buffer) {
+  const int num_elements = GetTensorShape(filter).FlatSize();
+  if (IsConstantTensor(filter)) {
+    if (data->unpacked_int4_filter == nullptr) {
+      data->unpacked_int4_filter =
+          std::make_unique<int8_t[]>(filter->bytes * 2);
+      tensor_utils::UnpackDenseInt4IntoInt8(GetTensorData<int8_t>(filter),
+                                            num_elements,
+                                            data->unpacked_int4_filter.get());
+    }
+    return data->unpacked_int4_filter.get();
+  }
+  *scoped_buffer = std::make_unique<int8_t[]>(filter->bytes * 2);
+  tensor_utils::UnpackDenseInt4IntoInt8(GetTensorData<int8_t>(filter),
+                                        num_elements, scoped_buffer->get());
+  return scoped_buffer->get();
+}
+
 TfLiteStatus EvalHybridDense(
     TfLiteContext* context, TfLiteNode* node,
     TfLiteFullyConnectedParams* params, OpData* data, const TfLiteTensor* input,
@@ -713,12 +739,8 @@ TfLiteStatus EvalHybridDense(
   const int8_t* filter_data = nullptr;
   std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
   if (filter->type == kTfLiteInt4) {
-    const size_t bytes_unpacked = filter->bytes * 2;
-    unpacked_filter_data = std::make_unique<int8_t[]>(bytes_unpacked);
-    tflite::tensor_utils::UnpackDenseInt4IntoInt8(
-        GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
-        unpacked_filter_data.get());
-    filter_data = unpacked_filter_data.get();
+    filter_data =
+        GetInt4FilterUnpackedToInt8(filter, data, &unpacked_filter_data);
   } else {
     filter_data = GetTensorData<int8_t>(filter);
   }
@@ -1051,7 +1073,7 @@ TfLiteStatus EvalHybrid(TfLiteContext* context, TfLiteNode* node,
 
 namespace {
 template <KernelType kernel_type>
-void FullyConnectedInt8(const OpData* data, const TfLiteTensor* input,
+void FullyConnectedInt8(OpData* data, const TfLiteTensor* input,
                         const TfLiteTensor* filter, const TfLiteTensor* bias,
                         TfLiteTensor* output,
                         CpuBackendContext* cpu_backend_context) {
@@ -1070,12 +1092,8 @@ void FullyConnectedInt8(const OpData* data, const TfLiteTensor* input,
   std::unique_ptr<int8_t[]> unpacked_filter_data = nullptr;
 
   if (filter->type == kTfLiteInt4) {
-    const size_t bytes_unpacked = filter->bytes * 2;
-    unpacked_filter_data = std::make_unique<int8_t[]>(bytes_unpacked);
-    tflite::tensor_utils::UnpackDenseInt4IntoInt8(
-        GetTensorData<int8_t>(filter), GetTensorShape(filter).FlatSize(),
-        unpacked_filter_data.get());
-    filter_data = unpacked_filter_data.get();
+    filter_data =
+        GetInt4FilterUnpackedToInt8(filter, data, &unpacked_filter_data);
   } else {
     filter_data = GetTensorData<int8>(filter);
   }
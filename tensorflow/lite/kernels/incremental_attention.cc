@@ -0,0 +1,178 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "tensorflow/lite/core/c/common.h"
+#include "tensorflow/lite/core/subgraph.h"
+#include "tensorflow/lite/experimental/resource/kv_cache.h"
+#include "tensorflow/lite/kernels/custom_ops_register.h"
+#include "tensorflow/lite/kernels/internal/tensor_ctypes.h"
+#include "tensorflow/lite/kernels/kernel_util.h"
+
+namespace tflite {
+namespace ops {
+namespace custom {
+namespace incremental_attention {
+
+// Single-token attention step over a persistent KV cache. Each invocation
+// appends one token's key and value to the cache identified by the resource
+// id, then computes scaled dot-product attention of the query against every
+// cached token. Caching the K/V projections makes a decode step O(T) in the
+// sequence length instead of the O(T^2) of re-attending from scratch, and the
+// cache's ring-buffer eviction bounds memory to the most recent
+// `max_cache_tokens` tokens.
+//
+// Inputs:
+//   0: cache resource id, int32 scalar.
+//   1: cache capacity in tokens, int32 scalar.
+//   2: query, float32 [num_heads, head_dim].
+//   3: key, float32 [num_heads, head_dim].
+//   4: value, float32 [num_heads, head_dim].
+// Output:
+//   0: attention result, float32 [num_heads, head_dim].
+
+constexpr int kCacheIdTensor = 0;
+constexpr int kMaxCacheTokensTensor = 1;
+constexpr int kQueryTensor = 2;
+constexpr int kKeyTensor = 3;
+constexpr int kValueTensor = 4;
+constexpr int kOutputTensor = 0;
+
+TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
+  TF_LITE_ENSURE_EQ(context, NumInputs(node), 5);
+  TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
+
+  const TfLiteTensor* cache_id;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kCacheIdTensor, &cache_id));
+  TF_LITE_ENSURE_TYPES_EQ(context, cache_id->type, kTfLiteInt32);
+  TF_LITE_ENSURE_EQ(context, NumElements(cache_id), 1);
+
+  const TfLiteTensor* max_cache_tokens;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kMaxCacheTokensTensor,
+                                          &max_cache_tokens));
+  TF_LITE_ENSURE_TYPES_EQ(context, max_cache_tokens->type, kTfLiteInt32);
+  TF_LITE_ENSURE_EQ(context, NumElements(max_cache_tokens), 1);
+
+  const TfLiteTensor* query;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kQueryTensor, &query));
+  const TfLiteTensor* key;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kKeyTensor, &key));
+  const TfLiteTensor* value;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kValueTensor, &value));
+  TF_LITE_ENSURE_TYPES_EQ(context, query->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, key->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_TYPES_EQ(context, value->type, kTfLiteFloat32);
+  TF_LITE_ENSURE_EQ(context, NumDimensions(query), 2);
+  TF_LITE_ENSURE(context, HaveSameShapes(query, key));
+  TF_LITE_ENSURE(context, HaveSameShapes(query, value));
+
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+  TF_LITE_ENSURE_TYPES_EQ(context, output->type, kTfLiteFloat32);
+  return context->ResizeTensor(context, output,
+                               TfLiteIntArrayCopy(query->dims));
+}
+
+TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
+  const TfLiteTensor* cache_id;
+  TF_LITE_ENSURE_OK(context,
+                    GetInputSafe(context, node, kCacheIdTensor, &cache_id));
+  const TfLiteTensor* max_cache_tokens;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kMaxCacheTokensTensor,
+                                          &max_cache_tokens));
+  const TfLiteTensor* query;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kQueryTensor, &query));
+  const TfLiteTensor* key;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kKeyTensor, &key));
+  const TfLiteTensor* value;
+  TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, kValueTensor, &value));
+  TfLiteTensor* output;
+  TF_LITE_ENSURE_OK(context,
+                    GetOutputSafe(context, node, kOutputTensor, &output));
+
+  const int num_heads = query->dims->data[0];
+  const int head_dim = query->dims->data[1];
+  const int entry_size = num_heads * head_dim;
+  const int capacity = *GetTensorData<int32_t>(max_cache_tokens);
+  TF_LITE_ENSURE(context, capacity > 0);
+
+  Subgraph* subgraph = reinterpret_cast<Subgraph*>(context->impl_);
+  auto& resources = subgraph->resources();
+  resource::CreateKVCacheIfNotAvailable(&resources,
+                                        *GetTensorData<int32_t>(cache_id),
+                                        capacity, entry_size);
+  auto* cache =
+      resource::GetKVCache(&resources, *GetTensorData<int32_t>(cache_id));
+  TF_LITE_ENSURE(context, cache != nullptr);
+
+  cache->Append(GetTensorData<float>(key), GetTensorData<float>(value));
+
+  const float* query_data = GetTensorData<float>(query);
+  float* output_data = GetTensorData<float>(output);
+  const int num_tokens = cache->num_tokens();
+  const float scale = 1.f / std::sqrt(static_cast<float>(head_dim));
+  std::vector<float> scores(num_tokens);
+
+  for (int h = 0; h < num_heads; ++h) {
+    const float* q = query_data + h * head_dim;
+    // Scaled dot-product scores against every cached token, softmax
+    // normalized with the usual max subtraction for stability.
+    float max_score = std::numeric_limits<float>::lowest();
+    for (int t = 0; t < num_tokens; ++t) {
+      const float* k = cache->GetKey(t) + h * head_dim;
+      float score = 0.f;
+      for (int d = 0; d < head_dim; ++d) {
+        score += q[d] * k[d];
+      }
+      scores[t] = score * scale;
+      max_score = std::max(max_score, scores[t]);
+    }
+    float sum = 0.f;
+    for (int t = 0; t < num_tokens; ++t) {
+      scores[t] = std::exp(scores[t] - max_score);
+      sum += scores[t];
+    }
+    float* out = output_data + h * head_dim;
+    for (int d = 0; d < head_dim; ++d) {
+      out[d] = 0.f;
+    }
+    for (int t = 0; t < num_tokens; ++t) {
+      const float weight = scores[t] / sum;
+      const float* v = cache->GetValue(t) + h * head_dim;
+      for (int d = 0; d < head_dim; ++d) {
+        out[d] += weight * v[d];
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace incremental_attention
+
+TfLiteRegistration* Register_INCREMENTAL_ATTENTION() {
+  static TfLiteRegistration r = {nullptr, nullptr,
+                                 incremental_attention::Prepare,
+                                 incremental_attention::Eval};
+  return &r;
+}
+
+}  // namespace custom
+}  // namespace ops
+}  // namespace tflite
@@ -0,0 +1,153 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cmath>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorflow/lite/kernels/custom_ops_register.h"
+#include "tensorflow/lite/kernels/test_util.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/testing/util.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+class IncrementalAttentionModel : public SingleOpModel {
+ public:
+  IncrementalAttentionModel(int num_heads, int head_dim, int max_tokens) {
+    cache_id_ = AddConstInput(TensorType_INT32, {0}, {});
+    max_tokens_ = AddConstInput(TensorType_INT32, {max_tokens}, {});
+    query_ = AddInput({TensorType_FLOAT32, {num_heads, head_dim}});
+    key_ = AddInput({TensorType_FLOAT32, {num_heads, head_dim}});
+    value_ = AddInput({TensorType_FLOAT32, {num_heads, head_dim}});
+    output_ = AddOutput({TensorType_FLOAT32, {num_heads, head_dim}});
+    SetCustomOp("IncrementalAttention", {},
+                ops::custom::Register_INCREMENTAL_ATTENTION);
+    BuildInterpreter({{},
+                      {},
+                      {num_heads, head_dim},
+                      {num_heads, head_dim},
+                      {num_heads, head_dim}});
+  }
+
+  // Runs one decode step: appends (key, value) to the cache and returns the
+  // attention output for `query`.
+  std::vector<float> Step(const std::vector<float>& query,
+                          const std::vector<float>& key,
+                          const std::vector<float>& value) {
+    PopulateTensor(query_, query);
+    PopulateTensor(key_, key);
+    PopulateTensor(value_, value);
+    EXPECT_EQ(Invoke(), kTfLiteOk);
+    return ExtractVector<float>(output_);
+  }
+
+ private:
+  int cache_id_;
+  int max_tokens_;
+  int query_;
+  int key_;
+  int value_;
+  int output_;
+};
+
+// Attention of `query` over explicit token lists, computed step-by-step the
+// slow way as the reference for the cached kernel.
+std::vector<float> ReferenceAttention(
+    const std::vector<float>& query, const std::vector<std::vector<float>>& keys,
+    const std::vector<std::vector<float>>& values, int num_heads,
+    int head_dim) {
+  const int num_tokens = keys.size();
+  std::vector<float> output(num_heads * head_dim, 0.f);
+  for (int h = 0; h < num_heads; ++h) {
+    std::vector<float> scores(num_tokens);
+    float sum = 0.f;
+    for (int t = 0; t < num_tokens; ++t) {
+      float score = 0.f;
+      for (int d = 0; d < head_dim; ++d) {
+        score += query[h * head_dim + d] * keys[t][h * head_dim + d];
+      }
+      scores[t] = std::exp(score / std::sqrt(static_cast<float>(head_dim)));
+      sum += scores[t];
+    }
+    for (int t = 0; t < num_tokens; ++t) {
+      for (int d = 0; d < head_dim; ++d) {
+        output[h * head_dim + d] +=
+            scores[t] / sum * values[t][h * head_dim + d];
+      }
+    }
+  }
+  return output;
+}
+
+TEST(IncrementalAttentionTest, SingleTokenReturnsItsValue) {
+  IncrementalAttentionModel m(/*num_heads=*/1, /*head_dim=*/2,
+                              /*max_tokens=*/4);
+  // With one cached token the softmax weight is 1, so the output is the
+  // token's value regardless of the query.
+  auto output = m.Step({0.5f, -1.f}, {1.f, 2.f}, {3.f, 4.f});
+  EXPECT_THAT(output, ElementsAreArray(ArrayFloatNear({3.f, 4.f})));
+}
+
+TEST(IncrementalAttentionTest, AttendsOverCachedTokens) {
+  const int num_heads = 2;
+  const int head_dim = 2;
+  IncrementalAttentionModel m(num_heads, head_dim, /*max_tokens=*/8);
+
+  std::vector<std::vector<float>> keys = {{1.f, 0.f, 0.f, 1.f},
+                                          {0.f, 1.f, 1.f, 0.f},
+                                          {0.5f, 0.5f, -0.5f, 0.5f}};
+  std::vector<std::vector<float>> values = {{1.f, 2.f, 3.f, 4.f},
+                                            {5.f, 6.f, 7.f, 8.f},
+                                            {-1.f, -2.f, -3.f, -4.f}};
+  std::vector<float> query = {1.f, -1.f, 0.5f, 2.f};
+
+  std::vector<float> output;
+  for (int t = 0; t < static_cast<int>(keys.size()); ++t) {
+    output = m.Step(query, keys[t], values[t]);
+  }
+  EXPECT_THAT(output, ElementsAreArray(ArrayFloatNear(ReferenceAttention(
+                          query, keys, values, num_heads, head_dim))));
+}
+
+TEST(IncrementalAttentionTest, EvictsOldestTokenWhenFull) {
+  const int num_heads = 1;
+  const int head_dim = 2;
+  IncrementalAttentionModel m(num_heads, head_dim, /*max_tokens=*/2);
+
+  std::vector<std::vector<float>> keys = {
+      {1.f, 0.f}, {0.f, 1.f}, {1.f, 1.f}, {-1.f, 0.f}};
+  std::vector<std::vector<float>> values = {
+      {1.f, 2.f}, {3.f, 4.f}, {5.f, 6.f}, {7.f, 8.f}};
+  std::vector<float> query = {2.f, -1.f};
+
+  std::vector<float> output;
+  for (int t = 0; t < static_cast<int>(keys.size()); ++t) {
+    output = m.Step(query, keys[t], values[t]);
+  }
+  // Only the last two tokens fit in the cache; the first two were evicted.
+  std::vector<std::vector<float>> cached_keys(keys.end() - 2, keys.end());
+  std::vector<std::vector<float>> cached_values(values.end() - 2,
+                                                values.end());
+  EXPECT_THAT(output,
+              ElementsAreArray(ArrayFloatNear(ReferenceAttention(
+                  query, cached_keys, cached_values, num_heads, head_dim))));
+}
+
+}  // namespace
+}  // namespace tflite
@@ -1056,6 +1056,10 @@ inline void LstmStepFloat(
 //   quantized_input_ptr (same size as input_ptr)
 //   quantized_output_state_ptr (same size as output_state_ptr)
 //   quantized_output_scratch (same size as cell_state_ptr)
+//
+// When `input_prequantized` is true, `quantized_input_ptr`, `input_sf` and
+// `input_zp` already hold this step's quantized input (the caller quantized
+// the whole sequence in one pass) and the input quantization here is skipped.
 // Temporary pre-allocated storage for recovered values:
 //   recovered_cell_weights (same size as cell_to_*_weights)
 //
@@ -1125,9 +1129,9 @@ inline void LstmStepHybrid(
     float* output_ptr, int32_t* input_zp, int32_t* aux_input_zp,
     int32_t* output_state_zp, int32_t* row_sums, int row_sums_size,
     bool* compute_row_sums, bool asymmetric_quantize_inputs,
-    bool recurrent_to_input_is_diag, bool recurrent_to_forget_is_diag,
-    bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
-    CpuBackendContext* context) {
+    bool input_prequantized, bool recurrent_to_input_is_diag,
+    bool recurrent_to_forget_is_diag, bool recurrent_to_cell_is_diag,
+    bool recurrent_to_output_is_diag, CpuBackendContext* context) {
   ruy::profiler::ScopeLabel label("LstmStepHybrid");
   // Since we have already checked that weights are all there or none, we
   // can check the existence of only one to the get the condition.
@@ -1216,7 +1220,7 @@ inline void LstmStepHybrid(
   const bool is_output_state_all_zeros =
       tensor_utils::IsZeroVector(output_state_ptr, n_batch * n_output);
   // Quantize inputs.
-  if (!is_input_all_zeros) {
+  if (!is_input_all_zeros && !input_prequantized) {
     tensor_utils::BatchQuantizeFloats(input_ptr, n_batch, n_input,
                                       quantized_input_ptr, input_sf, input_zp,
                                       asymmetric_quantize_inputs);
@@ -2083,6 +2087,26 @@ TfLiteStatus EvalHybrid(
     row_sums_ptr = GetTensorData<int32_t>(row_sums);
   }
 
+  // Batched-timestep quantization: when the scaling factor (and zero point)
+  // temporaries are sized for the whole sequence rather than one step (see
+  // UnidirectionalSequenceLSTM's Prepare), quantize every timestep of the
+  // input in a single pass here instead of once per step, to amortize the
+  // quantization work over the sequence. Each step below then indexes its
+  // quantized slice.
+  const bool input_prequantized =
+      max_time > 1 &&
+      GetTensorShape(input_quantized).FlatSize() >=
+          max_time * n_batch * n_input &&
+      GetTensorShape(input_sf).FlatSize() >= max_time * n_batch &&
+      (!params->asymmetric_quantize_inputs ||
+       GetTensorShape(input_zp).FlatSize() >= max_time * n_batch);
+  if (input_prequantized) {
+    tensor_utils::BatchQuantizeFloats(
+        GetTensorData<float>(input), max_time * n_batch, n_input,
+        GetTensorData<int8_t>(input_quantized), GetTensorData<float>(input_sf),
+        input_zp_ptr, params->asymmetric_quantize_inputs);
+  }
+
   if (time_major) {
     // Feed the sequence into the LSTM step-by-step.
     const int input_step = n_batch * n_input;
@@ -2098,6 +2122,13 @@ TfLiteStatus EvalHybrid(
       }
       float* output_ptr =
           GetTensorData<float>(output) + t_rel * output_step + output_offset;
+      const int step_offset = input_prequantized ? t_rel : 0;
+      int8_t* quantized_input_ptr =
+          GetTensorData<int8_t>(input_quantized) + step_offset * input_step;
+      float* input_sf_ptr =
+          GetTensorData<float>(input_sf) + step_offset * n_batch;
+      int32_t* step_input_zp_ptr =
+          input_zp_ptr ? input_zp_ptr + step_offset * n_batch : nullptr;
       LstmStepHybrid(
           input_ptr, GetTensorData<int8_t>(input_to_input_weights),
           GetTensorData<uint8_t>(input_to_input_weights_ledger),
@@ -2155,19 +2186,19 @@ TfLiteStatus EvalHybrid(
           GetTensorData<float>(projection_bias), params, n_batch, n_cell,
           n_input, aux_input_size, n_output, output_batch_leading_dim,
           input_gate_scratch, forget_gate_scratch, cell_gate_scratch,
-          output_gate_scratch, GetTensorData<float>(input_sf),
+          output_gate_scratch, input_sf_ptr,
           GetTensorData<float>(aux_input_sf),
           GetTensorData<float>(output_state_sf),
           GetTensorData<float>(prod_scaling_factors),
-          GetTensorData<float>(recovered_cell_weights),
-          GetTensorData<int8_t>(input_quantized),
+          GetTensorData<float>(recovered_cell_weights), quantized_input_ptr,
           GetTensorData<int8_t>(aux_input_quantized),
           GetTensorData<int8_t>(output_state_quantized),
           GetTensorData<int8_t>(cell_state_quantized),
           GetTensorData<float>(output_state), GetTensorData<float>(cell_state),
           GetTensorData<int32_t>(output_scratch_buffer), output_ptr,
-          input_zp_ptr, aux_input_zp_ptr, output_state_zp_ptr, row_sums_ptr,
-          row_sums_size, compute_row_sums, params->asymmetric_quantize_inputs,
+          step_input_zp_ptr, aux_input_zp_ptr, output_state_zp_ptr,
+          row_sums_ptr, row_sums_size, compute_row_sums,
+          params->asymmetric_quantize_inputs, input_prequantized,
           recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
           recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
     }
@@ -2200,6 +2231,12 @@ TfLiteStatus EvalHybrid(
         float* forget_gate_scratch_ptr = forget_gate_scratch + b * n_cell;
         float* cell_gate_scratch_ptr = cell_gate_scratch + b * n_cell;
         float* output_gate_scratch_ptr = output_gate_scratch + b * n_cell;
+        const int step_offset = input_prequantized ? time_offset : 0;
+        int8_t* quantized_input_ptr =
+            GetTensorData<int8_t>(input_quantized) + step_offset * input_step;
+        float* input_sf_ptr = GetTensorData<float>(input_sf) + step_offset;
+        int32_t* step_input_zp_ptr =
+            input_zp_ptr ? input_zp_ptr + step_offset : nullptr;
 
         LstmStepHybrid(
             input_ptr, GetTensorData<int8_t>(input_to_input_weights),
@@ -2259,21 +2296,20 @@ TfLiteStatus EvalHybrid(
             /*n_batch=*/1, n_cell, n_input, aux_input_size, n_output,
             output_batch_leading_dim, input_gate_scratch_ptr,
             forget_gate_scratch_ptr, cell_gate_scratch_ptr,
-            output_gate_scratch_ptr, GetTensorData<float>(input_sf),
+            output_gate_scratch_ptr, input_sf_ptr,
             GetTensorData<float>(aux_input_sf),
             GetTensorData<float>(output_state_sf),
             GetTensorData<float>(prod_scaling_factors),
-            GetTensorData<float>(recovered_cell_weights),
-            GetTensorData<int8_t>(input_quantized),
+            GetTensorData<float>(recovered_cell_weights), quantized_input_ptr,
             GetTensorData<int8_t>(aux_input_quantized),
             GetTensorData<int8_t>(output_state_quantized),
             GetTensorData<int8_t>(cell_state_quantized), output_state_ptr,
             cell_state_ptr, GetTensorData<int32_t>(output_scratch_buffer),
-            output_ptr, input_zp_ptr, aux_input_zp_ptr, output_state_zp_ptr,
-            row_sums_ptr, row_sums_size, compute_row_sums,
-            params->asymmetric_quantize_inputs, recurrent_to_input_is_diag,
-            recurrent_to_forget_is_diag, recurrent_to_cell_is_diag,
-            recurrent_to_output_is_diag, context);
+            output_ptr, step_input_zp_ptr, aux_input_zp_ptr,
+            output_state_zp_ptr, row_sums_ptr, row_sums_size, compute_row_sums,
+            params->asymmetric_quantize_inputs, input_prequantized,
+            recurrent_to_input_is_diag, recurrent_to_forget_is_diag,
+            recurrent_to_cell_is_diag, recurrent_to_output_is_diag, context);
       }
     }
   }
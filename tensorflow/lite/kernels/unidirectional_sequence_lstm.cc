@@ -918,6 +918,7 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
       reinterpret_cast<TfLiteUnidirectionalSequenceLSTMParams*>(
           node->builtin_data);
   const bool time_major = params->time_major;
+  const int max_time = time_major ? input->dims->data[0] : input->dims->data[1];
   const int n_batch = time_major ? input->dims->data[1] : input->dims->data[0];
   const int n_input = input->dims->data[2];
 
@@ -1080,10 +1081,15 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
         GetTemporarySafe(context, node, kInputScalingFactors, &input_sf));
     input_sf->type = kTfLiteFloat32;
     input_sf->allocation_type = kTfLiteArenaRw;
+    // The input scaling factors (and the input zero points below) cover the
+    // whole sequence rather than a single step, so the hybrid kernel can
+    // quantize all timesteps of the input in one pass (see
+    // lstm_eval::EvalHybrid).
     int scaling_dims[1] = {n_batch};
-    if (!TfLiteIntArrayEqualsArray(input_sf->dims, 1, scaling_dims)) {
+    int input_scaling_dims[1] = {max_time * n_batch};
+    if (!TfLiteIntArrayEqualsArray(input_sf->dims, 1, input_scaling_dims)) {
       TfLiteIntArray* input_sf_size = TfLiteIntArrayCreate(1);
-      input_sf_size->data[0] = n_batch;
+      input_sf_size->data[0] = max_time * n_batch;
       TF_LITE_ENSURE_OK(
           context, context->ResizeTensor(context, input_sf, input_sf_size));
     }
@@ -1162,9 +1168,9 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
         context, GetTemporarySafe(context, node, kInputZeroPoints, &input_zp));
     input_zp->type = kTfLiteFloat32;
     input_zp->allocation_type = kTfLiteArenaRw;
-    if (!TfLiteIntArrayEqualsArray(input_zp->dims, 1, scaling_dims)) {
+    if (!TfLiteIntArrayEqualsArray(input_zp->dims, 1, input_scaling_dims)) {
       TfLiteIntArray* input_zp_size = TfLiteIntArrayCreate(1);
-      input_zp_size->data[0] = n_batch;
+      input_zp_size->data[0] = max_time * n_batch;
       TF_LITE_ENSURE_OK(
           context, context->ResizeTensor(context, input_zp, input_zp_size));
     }
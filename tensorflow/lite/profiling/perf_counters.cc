@@ -0,0 +1,107 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace tflite {
+namespace profiling {
+namespace perf {
+
+#ifdef __linux__
+namespace {
+
+// Owns the perf_event file descriptors of one thread. Counters are opened in
+// the constructor and closed in the destructor so that each profiled thread
+// pays the perf_event_open cost only once.
+class ThreadPerfCounters {
+ public:
+  ThreadPerfCounters()
+      : cycles_fd_(OpenCounter(PERF_COUNT_HW_CPU_CYCLES)),
+        cache_misses_fd_(OpenCounter(PERF_COUNT_HW_CACHE_MISSES)) {}
+
+  ~ThreadPerfCounters() {
+    if (cycles_fd_ >= 0) close(cycles_fd_);
+    if (cache_misses_fd_ >= 0) close(cache_misses_fd_);
+  }
+
+  bool IsValid() const { return cycles_fd_ >= 0 && cache_misses_fd_ >= 0; }
+
+  PerfCounterValues Read() const {
+    PerfCounterValues values;
+    ReadCounter(cycles_fd_, &values.cpu_cycles);
+    ReadCounter(cache_misses_fd_, &values.cache_misses);
+    return values;
+  }
+
+ private:
+  static int OpenCounter(uint64_t config) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Count the calling thread on whichever CPU it runs.
+    return syscall(__NR_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1,
+                   /*group_fd=*/-1, /*flags=*/0);
+  }
+
+  static void ReadCounter(int fd, uint64_t* value) {
+    uint64_t count = 0;
+    if (fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count)) {
+      *value = count;
+    }
+  }
+
+  int cycles_fd_;
+  int cache_misses_fd_;
+};
+
+const ThreadPerfCounters& PerThreadCounters() {
+  static thread_local ThreadPerfCounters counters;
+  return counters;
+}
+
+}  // namespace
+#endif  // __linux__
+
+bool IsSupported() {
+#ifdef __linux__
+  return PerThreadCounters().IsValid();
+#else
+  return false;
+#endif
+}
+
+PerfCounterValues GetPerfCounterValues() {
+  PerfCounterValues values;
+#ifdef __linux__
+  values = PerThreadCounters().Read();
+#endif
+  return values;
+}
+
+}  // namespace perf
+}  // namespace profiling
+}  // namespace tflite
@@ -0,0 +1,68 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_PERF_COUNTERS_H_
+#define TENSORFLOW_LITE_PROFILING_PERF_COUNTERS_H_
+
+#include <cstdint>
+
+namespace tflite {
+namespace profiling {
+namespace perf {
+
+// A snapshot of hardware performance counter values for the calling thread.
+// The generic PERF_COUNT_HW_* events used here map onto the native PMU
+// events of the underlying architecture (e.g. the cycle and last-level cache
+// refill counters of the Arm PMU).
+struct PerfCounterValues {
+  // Number of CPU cycles consumed by the calling thread.
+  uint64_t cpu_cycles = 0;
+
+  // Number of cache misses incurred by the calling thread. Together with the
+  // cache line size this approximates the memory traffic of a region of code.
+  uint64_t cache_misses = 0;
+
+  PerfCounterValues operator+(const PerfCounterValues& obj) const {
+    PerfCounterValues res;
+    res.cpu_cycles = cpu_cycles + obj.cpu_cycles;
+    res.cache_misses = cache_misses + obj.cache_misses;
+    return res;
+  }
+
+  PerfCounterValues operator-(const PerfCounterValues& obj) const {
+    PerfCounterValues res;
+    res.cpu_cycles = cpu_cycles - obj.cpu_cycles;
+    res.cache_misses = cache_misses - obj.cache_misses;
+    return res;
+  }
+};
+
+// Indicates whether hardware performance counters could be opened for the
+// calling thread. This currently only works on Linux-based systems and may
+// additionally fail at runtime, e.g. when perf_event_open is restricted by
+// /proc/sys/kernel/perf_event_paranoid.
+bool IsSupported();
+
+// Returns the current counter values of the calling thread. The counters are
+// opened lazily on the first call from each thread. If the counters are
+// unavailable, all values are zero. Note that the values only cover work done
+// on the calling thread; cycles spent on kernel worker threads are not
+// included.
+PerfCounterValues GetPerfCounterValues();
+
+}  // namespace perf
+}  // namespace profiling
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_PROFILING_PERF_COUNTERS_H_
@@ -0,0 +1,62 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/profiling/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+namespace tflite {
+namespace profiling {
+namespace perf {
+
+TEST(PerfCounterValues, AddAndSub) {
+  PerfCounterValues values1, values2;
+  values1.cpu_cycles = 500;
+  values1.cache_misses = 30;
+
+  values2.cpu_cycles = 300;
+  values2.cache_misses = 10;
+
+  const auto add_values = values1 + values2;
+  EXPECT_EQ(800, add_values.cpu_cycles);
+  EXPECT_EQ(40, add_values.cache_misses);
+
+  const auto sub_values = values1 - values2;
+  EXPECT_EQ(200, sub_values.cpu_cycles);
+  EXPECT_EQ(20, sub_values.cache_misses);
+}
+
+TEST(PerfCounterValues, GetPerfCounterValues) {
+  // Opening the counters may legitimately fail, e.g. when perf_event_open is
+  // restricted by perf_event_paranoid. Only check values when it succeeded.
+  if (!IsSupported()) {
+    const PerfCounterValues values = GetPerfCounterValues();
+    EXPECT_EQ(0, values.cpu_cycles);
+    EXPECT_EQ(0, values.cache_misses);
+    return;
+  }
+
+  const PerfCounterValues begin = GetPerfCounterValues();
+  // Burn some cycles so that the counters advance.
+  volatile int sum = 0;
+  for (int i = 0; i < 100000; ++i) sum += i;
+  const PerfCounterValues end = GetPerfCounterValues();
+
+  EXPECT_GT(end.cpu_cycles, begin.cpu_cycles);
+  EXPECT_GE(end.cache_misses, begin.cache_misses);
+}
+
+}  // namespace perf
+}  // namespace profiling
+}  // namespace tflite
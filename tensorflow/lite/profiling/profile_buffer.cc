@@ -42,6 +42,8 @@ uint32_t ProfileBuffer::BeginEvent(const char* tag,
   event_buffer_[index].elapsed_time = 0;
   if (event_type != Profiler::EventType::OPERATOR_INVOKE_EVENT) {
     event_buffer_[index].begin_mem_usage = memory::GetMemoryUsage();
+  } else {
+    event_buffer_[index].begin_perf_counters = perf::GetPerfCounterValues();
   }
   current_index_++;
   return index;
@@ -66,6 +68,8 @@ void ProfileBuffer::EndEvent(uint32_t event_handle,
   if (event_buffer_[event_index].event_type !=
       Profiler::EventType::OPERATOR_INVOKE_EVENT) {
     event_buffer_[event_index].end_mem_usage = memory::GetMemoryUsage();
+  } else {
+    event_buffer_[event_index].end_perf_counters = perf::GetPerfCounterValues();
   }
   if (event_metadata1) {
     event_buffer_[event_index].event_metadata = *event_metadata1;
@@ -24,6 +24,7 @@ limitations under the License.
 
 #include "tensorflow/lite/core/api/profiler.h"
 #include "tensorflow/lite/profiling/memory_info.h"
+#include "tensorflow/lite/profiling/perf_counters.h"
 #include "tensorflow/lite/profiling/time.h"
 
 namespace tflite {
@@ -50,6 +51,12 @@ struct ProfileEvent {
   // The memory usage when the event ends.
   memory::MemoryUsage end_mem_usage;
 
+  // Hardware performance counter values when the event begins/ends. These are
+  // only collected for operator invocation events and are all-zero when the
+  // counters are unavailable (see perf::IsSupported()).
+  perf::PerfCounterValues begin_perf_counters;
+  perf::PerfCounterValues end_perf_counters;
+
   // The field containing the type of event. This must be one of the event types
   // in EventType.
   EventType event_type;
@@ -20,6 +20,7 @@ limitations under the License.
 #include <string>
 
 #include "tensorflow/lite/profiling/memory_info.h"
+#include "tensorflow/lite/profiling/perf_counters.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
 namespace tflite {
@@ -139,6 +140,12 @@ void ProfileSummarizer::ProcessProfiles(
 
       stats_calculator->AddNodeStats(node_name_in_stats, type_in_stats,
                                      node_num, node_exec_time, 0 /*memory */);
+
+      auto& counter_stat = perf_counter_stats_[node_name_in_stats];
+      counter_stat.values =
+          counter_stat.values +
+          (event->end_perf_counters - event->begin_perf_counters);
+      counter_stat.run_count++;
     } else if (event->event_type ==
                Profiler::EventType::DELEGATE_OPERATOR_INVOKE_EVENT) {
       const std::string node_name(event->tag);
@@ -203,6 +210,24 @@ void ProfileSummarizer::ProcessProfiles(
   }
 }
 
+std::string ProfileSummarizer::GetPerfCounterString() const {
+  if (!perf::IsSupported() || perf_counter_stats_.empty()) {
+    return "";
+  }
+  std::stringstream stream;
+  stream << "Hardware performance counters (per-invocation averages):"
+         << std::endl;
+  for (const auto& stat : perf_counter_stats_) {
+    if (stat.second.run_count == 0) continue;
+    stream << "\t" << stat.first << ": cpu_cycles="
+           << stat.second.values.cpu_cycles / stat.second.run_count
+           << " cache_misses="
+           << stat.second.values.cache_misses / stat.second.run_count
+           << std::endl;
+  }
+  return stream.str();
+}
+
 tensorflow::StatsCalculator* ProfileSummarizer::GetStatsCalculator(
     uint32_t subgraph_index) {
   if (stats_calculator_map_.count(subgraph_index) == 0) {
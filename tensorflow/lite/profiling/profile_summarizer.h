@@ -24,6 +24,7 @@ limitations under the License.
 
 #include "tensorflow/core/util/stats_calculator.h"
 #include "tensorflow/lite/core/interpreter.h"
+#include "tensorflow/lite/profiling/perf_counters.h"
 #include "tensorflow/lite/profiling/profile_buffer.h"
 #include "tensorflow/lite/profiling/profile_summary_formatter.h"
 
@@ -43,10 +44,12 @@ class ProfileSummarizer {
                        const tflite::Interpreter& interpreter);
 
   // Returns a string detailing the accumulated runtime stats in the format of
-  // summary_formatter_.
+  // summary_formatter_. When hardware performance counters are available, a
+  // per-operator counter summary is appended.
   std::string GetOutputString() {
     return summary_formatter_->GetOutputString(stats_calculator_map_,
-                                               *delegate_stats_calculator_);
+                                               *delegate_stats_calculator_) +
+           GetPerfCounterString();
   }
 
   std::string GetShortSummary() {
@@ -65,10 +68,25 @@ class ProfileSummarizer {
   }
 
  private:
+  // Accumulated hardware performance counter values of one operator across
+  // invocations.
+  struct PerfCounterStat {
+    perf::PerfCounterValues values;
+    int64_t run_count = 0;
+  };
+
+  // Returns a table of per-operator hardware counter averages, or an empty
+  // string when the counters are unavailable.
+  std::string GetPerfCounterString() const;
+
   // Map storing stats per subgraph.
   std::map<uint32_t, std::unique_ptr<tensorflow::StatsCalculator>>
       stats_calculator_map_;
 
+  // Map from operator name (as reported in the stats above) to accumulated
+  // hardware counter values.
+  std::map<std::string, PerfCounterStat> perf_counter_stats_;
+
   std::unique_ptr<tensorflow::StatsCalculator> delegate_stats_calculator_;
 
   // Summary formatter for customized output formats.
@@ -221,8 +221,10 @@ void SimpleMemoryArena::CalculateActiveAllocs(
     const std::vector<ArenaAllocWithUsageInterval>& allocs, int32_t node) {
   active_allocs_.clear();
   for (int i = 0; i < allocs.size(); ++i) {
-    if (allocs[i].first_node <= node && allocs[i].last_node >= node) {
+    if (allocs[i].size > 0 && allocs[i].last_node >= node) {
       active_allocs_.push_back(allocs[i]);
+      high_water_mark_ =
+          std::max(high_water_mark_, allocs[i].offset + allocs[i].size);
     }
   }
   std::sort(active_allocs_.begin(), active_allocs_.end());
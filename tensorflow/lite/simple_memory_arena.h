@@ -130,8 +130,11 @@ class SimpleMemoryArena {
   // will have no impact on the result but it may be much slower.
   void PurgeAfter(int32_t node);
 
-  // Calculate the active allocs at `node`. Call this if the active allocs at
-  // `node` are unknown.
+  // Calculate the allocs in `allocs` which are still in use at or after
+  // `node` and make them the active allocs, accounting for them in the high
+  // water mark. Call this if the active allocs at `node` are unknown, e.g.
+  // when rebuilding the arena state from a planner's saved allocations. All
+  // entries of `allocs` must belong to this arena.
   void CalculateActiveAllocs(
       const std::vector<ArenaAllocWithUsageInterval>& allocs, int32_t node);
 
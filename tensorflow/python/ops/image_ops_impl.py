@@ -3202,6 +3202,13 @@ decode_and_crop_jpeg = tf_export(
     v1=['io.decode_and_crop_jpeg', 'image.decode_and_crop_jpeg'])(
         dispatch.add_dispatch_support(gen_image_ops.decode_and_crop_jpeg))
 
+decode_and_crop_jpeg_batch = tf_export(
+    'io.decode_and_crop_jpeg_batch',
+    'image.decode_and_crop_jpeg_batch',
+    v1=['io.decode_and_crop_jpeg_batch', 'image.decode_and_crop_jpeg_batch'])(
+        dispatch.add_dispatch_support(
+            gen_image_ops.decode_and_crop_jpeg_batch))
+
 decode_bmp = tf_export(
     'io.decode_bmp',
     'image.decode_bmp',
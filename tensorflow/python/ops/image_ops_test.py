@@ -4547,6 +4547,39 @@ class JpegTest(test_util.TensorFlowTestCase):
         image1_crop, image2 = self.evaluate([image1_crop, image2])
         self.assertAllEqual(image1_crop, image2)
 
+  def testCropAndDecodeJpegBatch(self):
+    with self.cached_session():
+      base = "tensorflow/core/lib/jpeg/testdata"
+      jpeg0 = io_ops.read_file(os.path.join(base, "jpeg_merge_test1.jpg"))
+
+      # All windows share a height and width, so the batch decodes to a
+      # dense tensor.
+      crop_windows = [[0, 0, 15, 10], [6, 5, 15, 10], [241, 118, 15, 10]]
+      contents = array_ops_stack.stack([jpeg0] * len(crop_windows))
+      images = image_ops.decode_and_crop_jpeg_batch(contents, crop_windows)
+
+      # Each slice equals the single-image fused decode+crop.
+      singles = [
+          image_ops.decode_and_crop_jpeg(jpeg0, crop_window, channels=3)
+          for crop_window in crop_windows
+      ]
+      images, singles = self.evaluate([images, singles])
+      self.assertEqual(images.shape, (3, 15, 10, 3))
+      for i in range(len(crop_windows)):
+        self.assertAllEqual(images[i], singles[i])
+
+  def testCropAndDecodeJpegBatchWithMismatchedWindows(self):
+    with self.cached_session():
+      base = "tensorflow/core/lib/jpeg/testdata"
+      jpeg0 = io_ops.read_file(os.path.join(base, "jpeg_merge_test1.jpg"))
+      contents = array_ops_stack.stack([jpeg0, jpeg0])
+      with self.assertRaisesRegex(
+          (ValueError, errors.InvalidArgumentError),
+          "share the same height and width"):
+        result = image_ops.decode_and_crop_jpeg_batch(
+            contents, [[0, 0, 15, 10], [0, 0, 16, 10]])
+        self.evaluate(result)
+
   def testCropAndDecodeJpegWithInvalidCropWindow(self):
     with self.cached_session() as sess:
       # Encode it, then decode it, then encode it
@@ -722,9 +722,12 @@ CoordinationServiceStandaloneImpl::GetTaskState(
     auto& state_info = states_info.emplace_back();
     Status error;
     {
-      mutex_lock l(state_mu_);
-      state_info.set_state(cluster_state_[task_name]->GetState());
-      error = cluster_state_[task_name]->GetStatus();
+      tf_shared_lock l(state_mu_);
+      const auto it = cluster_state_.find(task_name);
+      if (it != cluster_state_.end()) {
+        state_info.set_state(it->second->GetState());
+        error = it->second->GetStatus();
+      }
     }
     *state_info.mutable_task() = task;
     state_info.set_error_code(error.raw_code());
@@ -742,29 +745,35 @@ Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
   const std::string& task_name = GetTaskName(task);
   Status s = OkStatus();
   {
-    mutex_lock l(state_mu_);
-    if (!cluster_state_.contains(task_name)) {
+    // Heartbeats from every task in the cluster funnel into this service, so
+    // they take a shared lock and may be processed concurrently: this path
+    // only reads the cluster state (the per-task heartbeat timestamp has its
+    // own mutex), and serializing heartbeats behind an exclusive lock
+    // saturates the leader on large clusters.
+    tf_shared_lock l(state_mu_);
+    const auto it = cluster_state_.find(task_name);
+    if (it == cluster_state_.end()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Unexpected heartbeat request from task: ", task_name,
           ". This usually implies an earlier error that caused coordination "
           "service to shut down before the workers disconnect. Check the task "
           "leader's logs for an earlier error to debug the root cause."));
     }
-    if (!cluster_state_[task_name]->GetStatus().ok()) {
-      return cluster_state_[task_name]->GetStatus();
-    } else if (cluster_state_[task_name]->GetState() ==
+    TaskState* task_state = it->second.get();
+    if (!task_state->GetStatus().ok()) {
+      return task_state->GetStatus();
+    } else if (task_state->GetState() ==
                    CoordinatedTaskState::TASKSTATE_DISCONNECTED &&
                // We accept heartbeats for a short grace period to account for
                // the lag time between the service recording the state change
                // and the agent stopping heartbeats.
                Env::Default()->NowMicros() >
-                   cluster_state_[task_name]
-                       ->GetDisconnectedGracePeriodMicros()) {
+                   task_state->GetDisconnectedGracePeriodMicros()) {
       return MakeCoordinationError(errors::InvalidArgument(
           "Task with task_name=", task_name,
           " must be registered before sending heartbeat messages"));
     }
-    s = cluster_state_[task_name]->RecordHeartbeat(incarnation);
+    s = task_state->RecordHeartbeat(incarnation);
   }
 
   // Set and propagate any heartbeat errors.
@@ -136,6 +136,15 @@ const ::grpc::ChannelArguments* GetDefaultChannelArguments() {
       VLOG(5) << "Disabling TCP connection sharing";
       args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, true);
     }
+    if (rpc_options->eager_channel_creation()) {
+      // Keep eagerly established connections alive through idle periods so
+      // the warm-up is not undone before the first step; allow pings on
+      // otherwise idle connections.
+      args.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, 60 * 1000);
+      args.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, 20 * 1000);
+      args.SetInt(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+      args.SetInt(GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+    }
   }
   return args;
 }
@@ -365,9 +374,14 @@ GrpcChannelCache* NewGrpcChannelCache(const GrpcChannelSpec& spec,
         new SparseGrpcChannelCache(job.job_id, job.host_ports, channel_func,
                                    options.num_channels_per_target()));
   }
-  return caches.size() == 1 ? caches[0]
-                            : new MultiGrpcChannelCache(
-                                  caches, options.num_channels_per_target());
+  GrpcChannelCache* cache =
+      caches.size() == 1 ? caches[0]
+                         : new MultiGrpcChannelCache(
+                               caches, options.num_channels_per_target());
+  if (options.eager_channel_creation()) {
+    cache->WarmupChannels();
+  }
+  return cache;
 }
 
 }  // namespace tsl
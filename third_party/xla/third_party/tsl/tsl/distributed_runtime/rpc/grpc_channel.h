@@ -73,6 +73,11 @@ class GrpcChannelCache {
   // E.g., /job:mnist/task:2
   virtual SharedGrpcChannelPtr FindWorkerChannel(const string& target) = 0;
 
+  // Eagerly creates the channels for every known worker and kicks off
+  // connection establishment, so the first RPC to each target does not pay
+  // TCP/TLS and HTTP/2 setup. Default implementation does nothing.
+  virtual void WarmupChannels() {}
+
   // Translates a string in the form `/job:X/task:Z` into a host_port.
   virtual string TranslateTask(const string& task) = 0;
 };
@@ -41,6 +41,21 @@ class GenericCachingChannelCache : public ChannelCacheT {
 
   ~GenericCachingChannelCache() override {}
 
+  void WarmupChannels() override {
+    std::vector<string> workers;
+    this->ListWorkers(&workers);
+    for (const string& worker : workers) {
+      // The first call creates all num_channels_per_target_ channels for the
+      // target; the remaining iterations round-robin over them so each one
+      // starts connecting.
+      for (int i = 0; i < num_channels_per_target_; ++i) {
+        SharedGrpcChannelPtr channel = FindWorkerChannel(worker);
+        if (channel == nullptr) break;
+        channel->GetState(/*try_to_connect=*/true);
+      }
+    }
+  }
+
   SharedGrpcChannelPtr FindWorkerChannel(const string& target) override {
     {
       mutex_lock l(mu_);
@@ -293,6 +293,33 @@ TEST(GrpcChannelTest, HostPortsMultiGrpcMultiChannelPerTarget) {
   }
 }
 
+TEST(GrpcChannelTest, EagerChannelCreation) {
+  GrpcChannelSpec spec;
+  TF_EXPECT_OK(
+      spec.AddHostPortsJob("mnist", {{0, "a:1"}, {1, "b:2"}, {2, "c:3"}}));
+  int num_channels_created = 0;
+  ChannelCreationFunction channel_func =
+      [&num_channels_created](const string& target) -> SharedGrpcChannelPtr {
+    SharedGrpcChannelPtr channel;
+    TF_CHECK_OK(NewHostPortGrpcChannel(target, nullptr, &channel));
+    ++num_channels_created;
+    return channel;
+  };
+  tensorflow::RPCOptions rpc_options;
+  rpc_options.set_num_channels_per_target(2);
+  rpc_options.set_eager_channel_creation(true);
+  std::unique_ptr<GrpcChannelCache> cc(
+      NewGrpcChannelCache(spec, channel_func, rpc_options));
+
+  // All channels were created at cache construction time...
+  EXPECT_EQ(3 * 2, num_channels_created);
+
+  // ...and later lookups are served from the cache.
+  EXPECT_NE(nullptr, cc->FindWorkerChannel("/job:mnist/replica:0/task:0"));
+  EXPECT_NE(nullptr, cc->FindWorkerChannel("/job:mnist/replica:0/task:2"));
+  EXPECT_EQ(3 * 2, num_channels_created);
+}
+
 TEST(GrpcChannelTest, SparseHostPorts) {
   GrpcChannelSpec spec;
   TF_EXPECT_OK(
@@ -43,7 +43,7 @@ void CancellationManager::StartCancel() {
 }
 
 void CancellationManager::StartCancelWithStatus(const Status& status) {
-  gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+  State* state = nullptr;
   std::forward_list<CancellationManager*> children_to_cancel;
   Notification* cancelled_notification = nullptr;
   {
@@ -53,7 +53,7 @@ void CancellationManager::StartCancelWithStatus(const Status& status) {
     }
     is_cancelling_ = true;
     if (state_) {
-      std::swap(state_->callbacks, callbacks_to_run);
+      state = state_.get();
 
       // Remove all children from the list of children.
       CancellationManager* child = state_->first_child;
@@ -67,20 +67,36 @@ void CancellationManager::StartCancelWithStatus(const Status& status) {
       cancelled_notification = &state_->cancelled_notification;
     }
   }
-  // We call these callbacks without holding mu_, so that concurrent
-  // calls to DeregisterCallback, which can happen asynchronously, do
-  // not block. The callbacks remain valid because any concurrent call
-  // to DeregisterCallback will block until the
-  // cancelled_notification_ is notified.
-  for (auto key_and_value : callbacks_to_run) {
-    CallbackConfiguration& config = key_and_value.second;
-    if (!status.ok() && config.log_error) {
-      LOG(WARNING) << "Cancellation callback \"" << config.name
-                   << "\" is triggered due to a "
-                   << (StatusGroup::IsDerived(status) ? "derived" : "root")
-                   << " error: " << status.ToString();
+  if (state) {
+    // Detach and run the registered callbacks shard by shard. A registration
+    // that acquires the shard mutex before the swap has its callback invoked
+    // below; one that acquires it afterwards observes the shard's `cancelled`
+    // bit and fails.
+    //
+    // We call these callbacks without holding any locks, so that concurrent
+    // calls to DeregisterCallback, which can happen asynchronously, do
+    // not block. The callbacks remain valid because any concurrent call
+    // to DeregisterCallback will block until the
+    // cancelled_notification_ is notified.
+    for (int i = 0; i < kNumCallbackShards; ++i) {
+      State::CallbackShard& shard = state->callback_shards[i];
+      gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+      {
+        mutex_lock l(shard.mu);
+        shard.cancelled = true;
+        std::swap(shard.callbacks, callbacks_to_run);
+      }
+      for (auto key_and_value : callbacks_to_run) {
+        CallbackConfiguration& config = key_and_value.second;
+        if (!status.ok() && config.log_error) {
+          LOG(WARNING) << "Cancellation callback \"" << config.name
+                       << "\" is triggered due to a "
+                       << (StatusGroup::IsDerived(status) ? "derived" : "root")
+                       << " error: " << status.ToString();
+        }
+        config.callback();
+      }
     }
-    config.callback();
   }
   for (CancellationManager* child : children_to_cancel) {
     child->StartCancelWithStatus(status);
@@ -111,41 +127,59 @@ bool CancellationManager::RegisterCallbackWithErrorLogging(
 bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
                                                  CallbackConfiguration config) {
   DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
-  mutex_lock l(mu_);
-  bool should_register = !is_cancelled_ && !is_cancelling_;
-  if (should_register) {
-    if (!state_) {
-      state_ = absl::make_unique<State>();
-    }
-    std::swap(state_->callbacks[token], config);
+  State* state = EnsureState();
+  if (state == nullptr) {
+    return false;
+  }
+  State::CallbackShard& shard =
+      state->callback_shards[token % kNumCallbackShards];
+  mutex_lock l(shard.mu);
+  if (shard.cancelled) {
+    return false;
   }
-  return should_register;
+  std::swap(shard.callbacks[token], config);
+  return true;
 }
 
 bool CancellationManager::DeregisterCallback(CancellationToken token) {
-  mu_.lock();
-  if (is_cancelled_) {
-    mu_.unlock();
-    return false;
-  } else if (is_cancelling_) {
-    Notification* cancelled_notification =
-        state_ ? &state_->cancelled_notification : nullptr;
-    mu_.unlock();
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    // No callback was ever registered, so there is nothing to deregister;
+    // report whether this manager has been cancelled.
+    mutex_lock l(mu_);
+    return !is_cancelled_.load(std::memory_order_relaxed) && !is_cancelling_;
+  }
+  State::CallbackShard& shard =
+      state->callback_shards[token % kNumCallbackShards];
+  shard.mu.lock();
+  if (shard.cancelled) {
+    shard.mu.unlock();
     // Wait for all of the cancellation callbacks to be called. This
     // wait ensures that the caller of DeregisterCallback does not
     // return immediately and free objects that may be used in the
     // execution of any currently pending callbacks in StartCancel.
-    if (cancelled_notification) {
-      cancelled_notification->WaitForNotification();
-    }
+    state->cancelled_notification.WaitForNotification();
     return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
-    mu_.unlock();
-    return true;
   }
+  shard.callbacks.erase(token);
+  shard.mu.unlock();
+  return true;
+}
+
+CancellationManager::State* CancellationManager::EnsureState() {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state != nullptr) {
+    return state;
+  }
+  mutex_lock l(mu_);
+  if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+    return nullptr;
+  }
+  if (!state_) {
+    state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
+  }
+  return state_.get();
 }
 
 bool CancellationManager::RegisterChild(CancellationManager* child) {
@@ -157,6 +191,7 @@ bool CancellationManager::RegisterChild(CancellationManager* child) {
 
   if (!state_) {
     state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
   }
 
   // Push `child` onto the front of the list of children.
@@ -208,15 +243,19 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 }
 
 bool CancellationManager::TryDeregisterCallback(CancellationToken token) {
-  mutex_lock lock(mu_);
-  if (is_cancelled_ || is_cancelling_) {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    mutex_lock lock(mu_);
+    return !is_cancelled_.load(std::memory_order_relaxed) && !is_cancelling_;
+  }
+  State::CallbackShard& shard =
+      state->callback_shards[token % kNumCallbackShards];
+  mutex_lock lock(shard.mu);
+  if (shard.cancelled) {
     return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
-    return true;
   }
+  shard.callbacks.erase(token);
+  return true;
 }
 
 CancellationManager::~CancellationManager() {
@@ -161,6 +161,11 @@ class CancellationManager {
   bool IsCancelling();
 
  private:
+  // Number of shards across which registered callbacks are distributed, so
+  // that concurrent calls to RegisterCallback and DeregisterCallback contend
+  // on a per-shard mutex rather than on `mu_`.
+  static constexpr int kNumCallbackShards = 8;
+
   struct CallbackConfiguration {
     CancelCallback callback;
     std::string name;
@@ -168,8 +173,18 @@ class CancellationManager {
   };
 
   struct State {
+    struct CallbackShard {
+      mutex mu;
+      // Set to true when StartCancel() detaches this shard's callbacks.
+      // Registrations that observe this bit fail; registrations that complete
+      // before it is set are guaranteed to have their callbacks invoked.
+      bool cancelled TF_GUARDED_BY(mu) = false;
+      gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks
+          TF_GUARDED_BY(mu);
+    };
+
     Notification cancelled_notification;
-    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks;
+    CallbackShard callback_shards[kNumCallbackShards];
 
     // If this CancellationManager has any children, this member points to the
     // head of a doubly-linked list of its children.
@@ -179,6 +194,12 @@ class CancellationManager {
   bool RegisterCallbackConfig(CancellationToken token,
                               CallbackConfiguration config);
 
+  // Returns the lazily-created state, or nullptr if this manager has already
+  // been cancelled (in which case there is nothing to register against).
+  // Allocation takes `mu_` once; subsequent calls read `state_ptr_` without
+  // locking.
+  State* EnsureState();
+
   bool RegisterChild(CancellationManager* child);
   void DeregisterChild(CancellationManager* child);
 
@@ -203,6 +224,10 @@ class CancellationManager {
 
   mutex mu_;
   std::unique_ptr<State> state_ TF_GUARDED_BY(mu_);
+
+  // Points to `*state_` once it has been allocated. Lets the callback
+  // registration fast path find the shards without taking `mu_`.
+  std::atomic<State*> state_ptr_{nullptr};
 };
 
 // Registers the given cancellation callback, returning a function that can be
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tsl/framework/cancellation.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -221,6 +222,33 @@ TEST(Cancellation, TryDeregisterDuringCancel) {
   cancel_complete.WaitForNotification();
 }
 
+TEST(Cancellation, ConcurrentRegistrationDuringCancel) {
+  // Races many registrations against StartCancel(). Every registration that
+  // succeeds must have its callback invoked exactly once.
+  for (int round = 0; round < 10; ++round) {
+    CancellationManager manager;
+    std::atomic<int> num_registered(0);
+    std::atomic<int> num_invoked(0);
+    {
+      thread::ThreadPool w(Env::Default(), "test", 8);
+      for (int i = 0; i < 8; ++i) {
+        w.Schedule([&manager, &num_registered, &num_invoked]() {
+          for (int j = 0; j < 100; ++j) {
+            auto token = manager.get_cancellation_token();
+            if (manager.RegisterCallback(
+                    token, [&num_invoked]() { num_invoked++; })) {
+              num_registered++;
+            }
+          }
+        });
+      }
+      w.Schedule([&manager]() { manager.StartCancel(); });
+    }  // Joins all threads.
+    EXPECT_TRUE(manager.IsCancelled());
+    EXPECT_EQ(num_invoked.load(), num_registered.load());
+  }
+}
+
 TEST(Cancellation, Parent_CancelManyChildren) {
   CancellationManager parent;
   std::vector<std::unique_ptr<CancellationManager>> children;
@@ -16,7 +16,12 @@ limitations under the License.
 #include <stddef.h>
 #include <stdint.h>
 
-// SSE4.2 accelerated CRC32c.
+// Hardware accelerated CRC32c: SSE4.2 on x86-64, and the CRC32 extension on
+// AArch64.  Large buffers are processed as three independent streams over
+// fixed-size lanes that are then merged with a precomputed GF(2) shift
+// operator; the crc32 instructions have multi-cycle latency but single-cycle
+// throughput, so interleaving three streams roughly triples throughput over
+// a single dependent chain.
 
 // See if the SSE4.2 crc32c instruction is available.
 #undef USE_SSE_CRC32C
@@ -41,10 +46,22 @@ limitations under the License.
 #include <nmmintrin.h>
 #endif
 
+// See if the ARMv8 CRC32 instructions are available.
+#undef USE_ARM_CRC32C
+#if !defined(USE_SSE_CRC32C) && defined(__aarch64__) && \
+    defined(__ARM_FEATURE_CRC32)
+#define USE_ARM_CRC32C 1
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
 namespace tsl {
 namespace crc32c {
 
-#ifndef USE_SSE_CRC32C
+#if !defined(USE_SSE_CRC32C) && !defined(USE_ARM_CRC32C)
 
 bool CanAccelerate() { return false; }
 uint32_t AcceleratedExtend(uint32_t crc, const char *buf, size_t size) {
@@ -54,8 +71,104 @@ uint32_t AcceleratedExtend(uint32_t crc, const char *buf, size_t size) {
 
 #else
 
-// SSE4.2 optimized crc32c computation.
+namespace {
+
+// Single-step wrappers over the per-architecture crc32c instructions.
+#if defined(USE_SSE_CRC32C)
+inline uint32_t CrcByte(uint32_t crc, uint8_t b) {
+  return _mm_crc32_u8(crc, b);
+}
+inline uint32_t CrcWord64(uint32_t crc, uint64_t w) {
+  return static_cast<uint32_t>(_mm_crc32_u64(crc, w));
+}
+#else  // USE_ARM_CRC32C
+inline uint32_t CrcByte(uint32_t crc, uint8_t b) { return __crc32cb(crc, b); }
+inline uint32_t CrcWord64(uint32_t crc, uint64_t w) {
+  return __crc32cd(crc, w);
+}
+#endif
+
+// The CRC32C generator polynomial, reversed (LSB-first).
+constexpr uint32_t kPolynomial = 0x82f63b78u;
+
+// Bytes fed to each of the three streams before their CRCs are merged.
+// Large enough that the merge cost (eight table lookups) is negligible,
+// small enough that medium-sized records still hit the interleaved loop.
+constexpr size_t kLaneSize = 2048;
+
+// The CRC register update is linear over GF(2), so advancing a register
+// through N zero bytes is multiplication by a 32x32 bit matrix (cf. zlib's
+// crc32_combine).  Matrix "m" is represented by the images of the 32 basis
+// vectors: m[i] = M * e_i.
+uint32_t MatrixTimes(const uint32_t m[32], uint32_t vec) {
+  uint32_t sum = 0;
+  for (int i = 0; vec != 0; vec >>= 1, ++i) {
+    if (vec & 1) sum ^= m[i];
+  }
+  return sum;
+}
+
+// The merge operator for one lane, expanded into four byte-indexed tables so
+// it can be applied with four lookups instead of 32 conditional xors.
+struct LaneShiftOperator {
+  uint32_t table[4][256];
+};
+
+LaneShiftOperator BuildLaneShiftOperator() {
+  // Operator that advances a CRC register through a single zero byte:
+  // reg' = (reg >> 8) ^ crc_table[reg & 0xff].
+  uint32_t base[32];
+  for (int i = 0; i < 32; ++i) {
+    const uint32_t reg = 1u << i;
+    uint32_t crc = reg & 0xff;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+    }
+    base[i] = (reg >> 8) ^ crc;
+  }
+
+  // Raise it to the kLaneSize'th power by repeated squaring.
+  uint32_t result[32];
+  for (int i = 0; i < 32; ++i) result[i] = 1u << i;  // Identity.
+  uint32_t tmp[32];
+  for (size_t n = kLaneSize; n != 0; n >>= 1) {
+    if (n & 1) {
+      for (int i = 0; i < 32; ++i) tmp[i] = MatrixTimes(base, result[i]);
+      for (int i = 0; i < 32; ++i) result[i] = tmp[i];
+    }
+    for (int i = 0; i < 32; ++i) tmp[i] = MatrixTimes(base, base[i]);
+    for (int i = 0; i < 32; ++i) base[i] = tmp[i];
+  }
+
+  LaneShiftOperator op;
+  for (int j = 0; j < 4; ++j) {
+    for (uint32_t b = 0; b < 256; ++b) {
+      op.table[j][b] = MatrixTimes(result, b << (8 * j));
+    }
+  }
+  return op;
+}
+
+// Advances CRC register "crc" through kLaneSize zero bytes.
+inline uint32_t ShiftLane(const LaneShiftOperator &op, uint32_t crc) {
+  return op.table[0][crc & 0xff] ^ op.table[1][(crc >> 8) & 0xff] ^
+         op.table[2][(crc >> 16) & 0xff] ^ op.table[3][crc >> 24];
+}
+
+}  // namespace
+
+#if defined(USE_SSE_CRC32C)
 bool CanAccelerate() { return __builtin_cpu_supports("sse4.2"); }
+#else  // USE_ARM_CRC32C
+bool CanAccelerate() {
+#if defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+  // The CRC32 extension was enabled at compile time.
+  return true;
+#endif
+}
+#endif
 
 uint32_t AcceleratedExtend(uint32_t crc, const char *buf, size_t size) {
   const uint8_t *p = reinterpret_cast<const uint8_t *>(buf);
@@ -70,23 +183,42 @@ uint32_t AcceleratedExtend(uint32_t crc, const char *buf, size_t size) {
   if (x <= e) {
     // Process bytes until finished or p is 8-byte aligned
     while (p != x) {
-      l = _mm_crc32_u8(l, *p);
+      l = CrcByte(l, *p);
       p++;
     }
   }
 
-  // Process bytes 16 at a time
-  uint64_t l64 = l;
+  // Main loop: three interleaved streams over kLaneSize lanes.  Streams one
+  // and two start from a zero register, so the lane CRCs combine linearly:
+  //   reg(lane0 || lane1 || lane2) = shift(shift(c0) ^ c1) ^ c2.
+  if (static_cast<size_t>(e - p) >= 3 * kLaneSize) {
+    static const LaneShiftOperator kShift = BuildLaneShiftOperator();
+    do {
+      uint32_t c0 = l;
+      uint32_t c1 = 0;
+      uint32_t c2 = 0;
+      const uint8_t *p1 = p + kLaneSize;
+      const uint8_t *p2 = p + 2 * kLaneSize;
+      for (size_t i = 0; i < kLaneSize; i += 8) {
+        c0 = CrcWord64(c0, *reinterpret_cast<const uint64_t *>(p + i));
+        c1 = CrcWord64(c1, *reinterpret_cast<const uint64_t *>(p1 + i));
+        c2 = CrcWord64(c2, *reinterpret_cast<const uint64_t *>(p2 + i));
+      }
+      l = ShiftLane(kShift, ShiftLane(kShift, c0) ^ c1) ^ c2;
+      p += 3 * kLaneSize;
+    } while (static_cast<size_t>(e - p) >= 3 * kLaneSize);
+  }
+
+  // Process remaining bytes 16 at a time on a single stream.
   while ((e - p) >= 16) {
-    l64 = _mm_crc32_u64(l64, *reinterpret_cast<const uint64_t *>(p));
-    l64 = _mm_crc32_u64(l64, *reinterpret_cast<const uint64_t *>(p + 8));
+    l = CrcWord64(l, *reinterpret_cast<const uint64_t *>(p));
+    l = CrcWord64(l, *reinterpret_cast<const uint64_t *>(p + 8));
     p += 16;
   }
 
   // Process remaining bytes one at a time.
-  l = l64;
   while (p < e) {
-    l = _mm_crc32_u8(l, *p);
+    l = CrcByte(l, *p);
     p++;
   }
 
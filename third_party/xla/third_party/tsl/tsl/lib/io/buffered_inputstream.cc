@@ -15,19 +15,29 @@ limitations under the License.
 
 #include "tsl/lib/io/buffered_inputstream.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
+
 #include "absl/status/status.h"
 #include "tsl/lib/io/random_inputstream.h"
+#include "tsl/platform/env.h"
 
 namespace tsl {
 namespace io {
 
 BufferedInputStream::BufferedInputStream(InputStreamInterface* input_stream,
                                          size_t buffer_bytes,
-                                         bool owns_input_stream)
+                                         bool owns_input_stream,
+                                         bool enable_readahead)
     : input_stream_(input_stream),
       size_(buffer_bytes),
       owns_input_stream_(owns_input_stream) {
   buf_.reserve(size_);
+  if (enable_readahead) {
+    readahead_pool_ = std::make_unique<thread::ThreadPool>(
+        Env::Default(), "buffered_inputstream_readahead", 1);
+  }
 }
 
 BufferedInputStream::BufferedInputStream(RandomAccessFile* file,
@@ -36,22 +46,69 @@ BufferedInputStream::BufferedInputStream(RandomAccessFile* file,
                           true) {}
 
 BufferedInputStream::~BufferedInputStream() {
+  // Joins any in-flight readahead before input_stream_ may be deleted.
+  readahead_pool_.reset();
   if (owns_input_stream_) {
     delete input_stream_;
   }
 }
 
+void BufferedInputStream::WaitForReadahead() {
+  if (readahead_pool_ == nullptr) {
+    return;
+  }
+  mutex_lock l(readahead_mu_);
+  while (readahead_pending_) {
+    readahead_cv_.wait(l);
+  }
+}
+
+void BufferedInputStream::ScheduleReadahead() {
+  readahead_base_pos_ = input_stream_->Tell();
+  {
+    mutex_lock l(readahead_mu_);
+    readahead_pending_ = true;
+  }
+  readahead_valid_ = true;
+  readahead_pool_->Schedule([this]() {
+    Status s = input_stream_->ReadNBytes(size_, &readahead_buf_);
+    mutex_lock l(readahead_mu_);
+    readahead_status_ = s;
+    readahead_pending_ = false;
+    readahead_cv_.notify_all();
+  });
+}
+
+int64_t BufferedInputStream::UnderlyingTell() const {
+  // When a readahead is outstanding, input_stream_ may be mid-read; the
+  // position captured when it was scheduled is the offset just past buf_.
+  if (readahead_valid_) {
+    return readahead_base_pos_;
+  }
+  return input_stream_->Tell();
+}
+
 Status BufferedInputStream::FillBuffer() {
   if (!file_status_.ok()) {
     pos_ = 0;
     limit_ = 0;
     return file_status_;
   }
-  Status s = input_stream_->ReadNBytes(size_, &buf_);
+  Status s;
+  if (readahead_valid_) {
+    WaitForReadahead();
+    std::swap(buf_, readahead_buf_);
+    s = readahead_status_;
+    readahead_valid_ = false;
+  } else {
+    s = input_stream_->ReadNBytes(size_, &buf_);
+  }
   pos_ = 0;
   limit_ = buf_.size();
   if (!s.ok()) {
     file_status_ = s;
+  } else if (readahead_pool_ != nullptr) {
+    ScheduleReadahead();
   }
   return s;
 }
@@ -144,9 +201,27 @@ Status BufferedInputStream::SkipNBytes(int64_t bytes_to_skip) {
     // Otherwise, we already have read limit_ - pos_, so skip the rest. At this
     // point we need to get fresh data into the buffer, so reset pos_ and
     // limit_.
-    Status s = input_stream_->SkipNBytes(bytes_to_skip - (limit_ - pos_));
+    int64_t remaining = bytes_to_skip - (limit_ - pos_);
     pos_ = 0;
     limit_ = 0;
+    if (readahead_valid_) {
+      WaitForReadahead();
+      readahead_valid_ = false;
+      if (remaining < static_cast<int64_t>(readahead_buf_.size())) {
+        // The skip lands inside the prefetched buffer; consume it in place.
+        std::swap(buf_, readahead_buf_);
+        pos_ = remaining;
+        limit_ = buf_.size();
+        if (!readahead_status_.ok()) {
+          file_status_ = readahead_status_;
+        } else {
+          ScheduleReadahead();
+        }
+        return OkStatus();
+      }
+      remaining -= readahead_buf_.size();
+    }
+    Status s = input_stream_->SkipNBytes(remaining);
     if (absl::IsOutOfRange(s)) {
       file_status_ = s;
     }
@@ -156,7 +231,7 @@ Status BufferedInputStream::SkipNBytes(int64_t bytes_to_skip) {
 }
 
 int64_t BufferedInputStream::Tell() const {
-  return input_stream_->Tell() - (limit_ - pos_);
+  return UnderlyingTell() - (limit_ - pos_);
 }
 
 Status BufferedInputStream::Seek(int64_t position) {
@@ -166,7 +241,7 @@ Status BufferedInputStream::Seek(int64_t position) {
   }
 
   // Position of the buffer's lower limit within file.
-  const int64_t buf_lower_limit = input_stream_->Tell() - limit_;
+  const int64_t buf_lower_limit = UnderlyingTell() - limit_;
   if (position < buf_lower_limit) {
     // Seek before buffer, reset input stream and skip 'position' bytes.
     TF_RETURN_IF_ERROR(Reset());
@@ -207,6 +282,10 @@ template Status BufferedInputStream::ReadAll<std::string>(std::string* result);
 template Status BufferedInputStream::ReadAll<tstring>(tstring* result);
 
 Status BufferedInputStream::Reset() {
+  if (readahead_valid_) {
+    WaitForReadahead();
+    readahead_valid_ = false;
+  }
   TF_RETURN_IF_ERROR(input_stream_->Reset());
   pos_ = 0;
   limit_ = 0;
@@ -16,10 +16,13 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_BUFFERED_INPUTSTREAM_H_
 #define TENSORFLOW_TSL_LIB_IO_BUFFERED_INPUTSTREAM_H_
 
+#include <memory>
 #include <string>
 
 #include "tsl/lib/io/inputstream_interface.h"
 #include "tsl/platform/file_system.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/threadpool.h"
 
 namespace tsl {
 namespace io {
@@ -30,10 +33,16 @@ class BufferedInputStream : public InputStreamInterface {
  public:
   // Does not take ownership of input_stream unless owns_input_stream is set
   // to true. input_stream must outlive *this then.
+  //
+  // If enable_readahead is true, the next buffer is fetched from input_stream
+  // on a background thread while the caller consumes the current one, so
+  // sequential reads overlap I/O with processing. input_stream must then not
+  // be accessed by anyone else for the lifetime of *this.
   // TODO(rohanj): Remove owns_input_stream once the constructor below is
   // removed.
   BufferedInputStream(InputStreamInterface* input_stream, size_t buffer_bytes,
-                      bool owns_input_stream = false);
+                      bool owns_input_stream = false,
+                      bool enable_readahead = false);
 
   // For backwards compatibility, expose an interface that is similar to what
   // InputBuffer exposes. Does not take ownership of file. file must outlive
@@ -99,6 +108,15 @@ class BufferedInputStream : public InputStreamInterface {
   template <typename StringType>
   Status ReadLineHelper(StringType* result, bool include_eol);
 
+  // Enqueues a read of the next buffer on readahead_pool_.
+  void ScheduleReadahead();
+  // Blocks until there is no readahead in flight. After this returns, the
+  // calling thread may access input_stream_ and the readahead_* members.
+  void WaitForReadahead();
+  // Position of input_stream_ excluding any prefetched-but-unconsumed bytes.
+  // Does not block on an in-flight readahead.
+  int64_t UnderlyingTell() const;
+
   InputStreamInterface* input_stream_;  // not owned.
   size_t size_;                         // buffer size.
   tstring buf_;                         // the buffer itself.
@@ -110,6 +128,24 @@ class BufferedInputStream : public InputStreamInterface {
   // buffer allocations.
   Status file_status_ = OkStatus();
 
+  // Readahead state. Non-null iff readahead is enabled. The pool has a single
+  // thread, so at most one prefetch is ever in flight. readahead_buf_ holds
+  // bytes that logically follow buf_[limit_); it and readahead_status_ are
+  // written by the pool thread and may only be touched by the caller after
+  // WaitForReadahead(), which establishes the necessary synchronization.
+  std::unique_ptr<thread::ThreadPool> readahead_pool_;
+  mutex readahead_mu_;
+  condition_variable readahead_cv_;
+  bool readahead_pending_ TF_GUARDED_BY(readahead_mu_) = false;
+  // Whether readahead_buf_ holds (or will hold) prefetched data. Caller
+  // thread only.
+  bool readahead_valid_ = false;
+  // Position of input_stream_ when the readahead was scheduled, i.e. the
+  // stream offset just past buf_. Lets Tell() answer without blocking.
+  int64_t readahead_base_pos_ = 0;
+  tstring readahead_buf_;
+  Status readahead_status_;
+
   BufferedInputStream(const BufferedInputStream&) = delete;
   void operator=(const BufferedInputStream&) = delete;
 };
@@ -296,6 +296,78 @@ TEST(BufferedInputStream, ReadNBytes) {
   }
 }
 
+TEST(BufferedInputStream, Readahead_ReadNBytes) {
+  Env* env = Env::Default();
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+
+  for (auto buf_size : BufferSizes()) {
+    std::unique_ptr<RandomAccessInputStream> input_stream(
+        new RandomAccessInputStream(file.get()));
+    tstring read;
+    BufferedInputStream in(input_stream.get(), buf_size,
+                           /*owns_input_stream=*/false,
+                           /*enable_readahead=*/true);
+    EXPECT_EQ(0, in.Tell());
+    TF_ASSERT_OK(in.ReadNBytes(3, &read));
+    EXPECT_EQ(read, "012");
+    EXPECT_EQ(3, in.Tell());
+    TF_ASSERT_OK(in.ReadNBytes(4, &read));
+    EXPECT_EQ(read, "3456");
+    EXPECT_EQ(7, in.Tell());
+    EXPECT_TRUE(errors::IsOutOfRange(in.ReadNBytes(5, &read)));
+    EXPECT_EQ(read, "789");
+    EXPECT_EQ(10, in.Tell());
+    EXPECT_TRUE(errors::IsOutOfRange(in.ReadNBytes(5, &read)));
+    EXPECT_EQ(read, "");
+    EXPECT_EQ(10, in.Tell());
+  }
+}
+
+TEST(BufferedInputStream, Readahead_SkipSeekReset) {
+  Env* env = Env::Default();
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+
+  for (auto buf_size : BufferSizes()) {
+    std::unique_ptr<RandomAccessInputStream> input_stream(
+        new RandomAccessInputStream(file.get()));
+    tstring read;
+    BufferedInputStream in(input_stream.get(), buf_size,
+                           /*owns_input_stream=*/false,
+                           /*enable_readahead=*/true);
+
+    // Read a byte first so that a readahead is in flight when we skip.
+    TF_ASSERT_OK(in.ReadNBytes(1, &read));
+    EXPECT_EQ(read, "0");
+    // Skip landing either inside or beyond the prefetched buffer, depending
+    // on buf_size.
+    TF_ASSERT_OK(in.SkipNBytes(4));
+    EXPECT_EQ(5, in.Tell());
+    TF_ASSERT_OK(in.ReadNBytes(2, &read));
+    EXPECT_EQ(read, "56");
+    EXPECT_EQ(7, in.Tell());
+
+    // Seek backwards and re-read.
+    TF_ASSERT_OK(in.Seek(1));
+    TF_ASSERT_OK(in.ReadNBytes(4, &read));
+    EXPECT_EQ(read, "1234");
+    EXPECT_EQ(5, in.Tell());
+
+    // Reset rewinds and drops any prefetched data.
+    TF_ASSERT_OK(in.Reset());
+    EXPECT_EQ(0, in.Tell());
+    TF_ASSERT_OK(in.ReadNBytes(3, &read));
+    EXPECT_EQ(read, "012");
+  }
+}
+
 TEST(BufferedInputStream, OutOfRangeCache) {
   for (auto buf_size : BufferSizes()) {
     if (buf_size < 11) {
@@ -0,0 +1,174 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/file_read_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/hash.h"
+#include "tsl/platform/logging.h"
+#include "tsl/util/env_var.h"
+
+namespace tsl {
+namespace io {
+
+ShardedFileBlockCache::ShardedFileBlockCache(
+    int num_shards, size_t block_size, size_t max_bytes, uint64 max_staleness,
+    RamFileBlockCache::BlockFetcher block_fetcher, Env* env)
+    : block_size_(block_size),
+      max_bytes_(max_bytes),
+      max_staleness_(max_staleness) {
+  const size_t shard_bytes =
+      std::max<size_t>(max_bytes / num_shards, block_size);
+  shards_.reserve(num_shards);
+  for (int i = 0; i < num_shards; ++i) {
+    shards_.push_back(std::make_unique<RamFileBlockCache>(
+        block_size, shard_bytes, max_staleness, block_fetcher, env));
+  }
+}
+
+RamFileBlockCache* ShardedFileBlockCache::shard(const string& filename) const {
+  return shards_[std::hash<string>()(filename) % shards_.size()].get();
+}
+
+Status ShardedFileBlockCache::Read(const string& filename, size_t offset,
+                                   size_t n, char* buffer,
+                                   size_t* bytes_transferred) {
+  return shard(filename)->Read(filename, offset, n, buffer, bytes_transferred);
+}
+
+bool ShardedFileBlockCache::ValidateAndUpdateFileSignature(
+    const string& filename, int64_t file_signature) {
+  return shard(filename)->ValidateAndUpdateFileSignature(filename,
+                                                         file_signature);
+}
+
+void ShardedFileBlockCache::RemoveFile(const string& filename) {
+  shard(filename)->RemoveFile(filename);
+}
+
+void ShardedFileBlockCache::Flush() {
+  for (auto& shard : shards_) {
+    shard->Flush();
+  }
+}
+
+size_t ShardedFileBlockCache::CacheSize() const {
+  size_t total = 0;
+  for (const auto& shard : shards_) {
+    total += shard->CacheSize();
+  }
+  return total;
+}
+
+Status CachingRandomAccessFile::Read(uint64 offset, size_t n,
+                                     StringPiece* result,
+                                     char* scratch) const {
+  *result = StringPiece();
+  size_t bytes_transferred;
+  TF_RETURN_IF_ERROR(
+      cache_->Read(filename_, offset, n, scratch, &bytes_transferred));
+  *result = StringPiece(scratch, bytes_transferred);
+  if (bytes_transferred < n) {
+    return errors::OutOfRange("EOF reached, ", result->size(),
+                              " bytes were read out of ", n,
+                              " bytes requested.");
+  }
+  return OkStatus();
+}
+
+namespace {
+
+constexpr int kReadCacheShards = 16;
+constexpr int64_t kDefaultReadCacheBlockSize = 16 * 1024 * 1024;
+
+// Fetches one block by (re)opening the file through the default Env. A short
+// read at the end of the file is reported as success; the block cache
+// interprets a partial block as EOF.
+Status FetchBlock(const string& filename, size_t offset, size_t n,
+                  char* buffer, size_t* bytes_transferred) {
+  *bytes_transferred = 0;
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewRandomAccessFile(filename, &file));
+  StringPiece result;
+  Status s = file->Read(offset, n, &result, buffer);
+  if (result.size() > 0 && result.data() != buffer) {
+    memmove(buffer, result.data(), result.size());
+  }
+  *bytes_transferred = result.size();
+  if (errors::IsOutOfRange(s)) {
+    return OkStatus();
+  }
+  return s;
+}
+
+int64_t ReadCacheEnvVar(const char* name, int64_t default_value) {
+  int64_t value;
+  Status s = ReadInt64FromEnvVar(name, default_value, &value);
+  if (!s.ok()) {
+    LOG(ERROR) << s.message();
+    return default_value;
+  }
+  return value;
+}
+
+}  // namespace
+
+FileBlockCache* GetProcessFileReadCache() {
+  static FileBlockCache* const cache = []() -> FileBlockCache* {
+    const int64_t max_bytes =
+        ReadCacheEnvVar("TF_FILE_READ_CACHE_MAX_BYTES", 0);
+    if (max_bytes <= 0) {
+      return nullptr;
+    }
+    int64_t block_size = ReadCacheEnvVar("TF_FILE_READ_CACHE_BLOCK_SIZE",
+                                         kDefaultReadCacheBlockSize);
+    if (block_size <= 0) {
+      block_size = kDefaultReadCacheBlockSize;
+    }
+    VLOG(1) << "Process-wide file read cache is enabled with max_bytes = "
+            << max_bytes << " and block_size = " << block_size;
+    return new ShardedFileBlockCache(kReadCacheShards, block_size, max_bytes,
+                                     /*max_staleness=*/0, &FetchBlock);
+  }();
+  return cache;
+}
+
+Status MaybeCacheFileReads(Env* env, const string& fname,
+                           std::unique_ptr<RandomAccessFile>* file) {
+  FileBlockCache* cache = GetProcessFileReadCache();
+  if (cache == nullptr) {
+    return OkStatus();
+  }
+  FileStatistics stat;
+  TF_RETURN_IF_ERROR(env->Stat(fname, &stat));
+  // Treat (length, mtime) as the file's generation so that blocks cached
+  // before the file was overwritten are not served.
+  const int64_t signature = static_cast<int64_t>(
+      Hash64Combine(static_cast<uint64>(stat.length),
+                    static_cast<uint64>(stat.mtime_nsec)));
+  cache->ValidateAndUpdateFileSignature(fname, signature);
+  file->reset(new CachingRandomAccessFile(fname, cache));
+  return OkStatus();
+}
+
+}  // namespace io
+}  // namespace tsl
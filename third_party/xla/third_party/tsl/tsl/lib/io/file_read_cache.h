@@ -0,0 +1,124 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_IO_FILE_READ_CACHE_H_
+#define TENSORFLOW_TSL_LIB_IO_FILE_READ_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tsl/platform/cloud/file_block_cache.h"
+#include "tsl/platform/cloud/ram_file_block_cache.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/stringpiece.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace io {
+
+/// \brief A filesystem-agnostic block cache that partitions its contents (and
+/// the locks guarding them) across several RamFileBlockCache shards.
+///
+/// Files are assigned to shards by filename hash, so concurrent readers of
+/// different files do not serialize on a single cache mutex.
+class ShardedFileBlockCache : public FileBlockCache {
+ public:
+  /// The overall `max_bytes` budget is divided evenly among `num_shards`
+  /// shards (but never below one block per shard). See RamFileBlockCache for
+  /// the meaning of the remaining parameters.
+  ShardedFileBlockCache(int num_shards, size_t block_size, size_t max_bytes,
+                        uint64 max_staleness,
+                        RamFileBlockCache::BlockFetcher block_fetcher,
+                        Env* env = Env::Default());
+
+  Status Read(const string& filename, size_t offset, size_t n, char* buffer,
+              size_t* bytes_transferred) override;
+
+  bool ValidateAndUpdateFileSignature(const string& filename,
+                                      int64_t file_signature) override;
+
+  void RemoveFile(const string& filename) override;
+
+  void Flush() override;
+
+  size_t block_size() const override { return block_size_; }
+  size_t max_bytes() const override { return max_bytes_; }
+  uint64 max_staleness() const override { return max_staleness_; }
+
+  /// The current size (in bytes) of the cache, summed over all shards.
+  size_t CacheSize() const override;
+
+  bool IsCacheEnabled() const override {
+    return block_size_ > 0 && max_bytes_ > 0;
+  }
+
+ private:
+  RamFileBlockCache* shard(const string& filename) const;
+
+  const size_t block_size_;
+  const size_t max_bytes_;
+  const uint64 max_staleness_;
+  std::vector<std::unique_ptr<RamFileBlockCache>> shards_;
+};
+
+/// \brief A read-only random access file that serves reads from a shared
+/// block cache, so concurrent readers of the same (hot) file share one copy
+/// of its blocks instead of each re-reading them from the filesystem.
+///
+/// The cache is not owned and must outlive the file.
+class CachingRandomAccessFile : public RandomAccessFile {
+ public:
+  CachingRandomAccessFile(const string& filename, FileBlockCache* cache)
+      : filename_(filename), cache_(cache) {}
+
+  Status Name(StringPiece* result) const override {
+    *result = filename_;
+    return OkStatus();
+  }
+
+  /// Returns `OUT_OF_RANGE` if fewer than n bytes were stored in `*result`
+  /// because of EOF. Thread safe.
+  Status Read(uint64 offset, size_t n, StringPiece* result,
+              char* scratch) const override;
+
+ private:
+  const string filename_;
+  FileBlockCache* const cache_;  // not owned.
+};
+
+/// Returns the process-wide read cache, or nullptr if it is disabled (the
+/// default). The cache is configured once, from environment variables:
+///
+///   TF_FILE_READ_CACHE_MAX_BYTES   total budget in bytes; 0 (the default)
+///                                  disables the cache.
+///   TF_FILE_READ_CACHE_BLOCK_SIZE  block size in bytes (default 16 MB).
+///
+/// Blocks are fetched by (re)opening the file through Env::Default(), so any
+/// registered filesystem can sit underneath.
+FileBlockCache* GetProcessFileReadCache();
+
+/// If the process-wide read cache is enabled, replaces *file with a file that
+/// reads `fname` through it; otherwise leaves *file untouched. The file's
+/// size and modification time act as its generation, so blocks cached from an
+/// overwritten file are not served.
+Status MaybeCacheFileReads(Env* env, const string& fname,
+                           std::unique_ptr<RandomAccessFile>* file);
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_LIB_IO_FILE_READ_CACHE_H_
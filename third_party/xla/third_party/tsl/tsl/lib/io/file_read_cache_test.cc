@@ -0,0 +1,168 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/file_read_cache.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "tsl/lib/core/status_test_util.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/strcat.h"
+#include "tsl/platform/test.h"
+
+namespace tsl {
+namespace io {
+namespace {
+
+// Serves byte (offset + i) % 256 for any filename and counts fetches.
+Status DeterministicFetcher(int* num_fetches, const string& filename,
+                            size_t offset, size_t n, char* buffer,
+                            size_t* bytes_transferred) {
+  ++*num_fetches;
+  for (size_t i = 0; i < n; ++i) {
+    buffer[i] = static_cast<char>((offset + i) % 256);
+  }
+  *bytes_transferred = n;
+  return OkStatus();
+}
+
+TEST(ShardedFileBlockCacheTest, ReadAndEvict) {
+  int num_fetches = 0;
+  auto fetcher = [&num_fetches](const string& filename, size_t offset,
+                                size_t n, char* buffer,
+                                size_t* bytes_transferred) {
+    return DeterministicFetcher(&num_fetches, filename, offset, n, buffer,
+                                bytes_transferred);
+  };
+  ShardedFileBlockCache cache(/*num_shards=*/4, /*block_size=*/16,
+                              /*max_bytes=*/1024, /*max_staleness=*/0,
+                              fetcher);
+  EXPECT_TRUE(cache.IsCacheEnabled());
+
+  char buffer[32];
+  size_t bytes_transferred = 0;
+  // Reads of different files land in (generally) different shards, and
+  // repeated reads are served from cache.
+  for (int i = 0; i < 8; ++i) {
+    const string filename = strings::StrCat("/file_", i);
+    TF_ASSERT_OK(cache.Read(filename, 8, 16, buffer, &bytes_transferred));
+    EXPECT_EQ(16, bytes_transferred);
+    EXPECT_EQ(8, static_cast<unsigned char>(buffer[0]));
+  }
+  const int fetches_after_first_pass = num_fetches;
+  for (int i = 0; i < 8; ++i) {
+    const string filename = strings::StrCat("/file_", i);
+    TF_ASSERT_OK(cache.Read(filename, 8, 16, buffer, &bytes_transferred));
+    EXPECT_EQ(16, bytes_transferred);
+  }
+  EXPECT_EQ(fetches_after_first_pass, num_fetches);
+  EXPECT_GT(cache.CacheSize(), 0);
+
+  // Flush drops all shards; the next read fetches again.
+  cache.Flush();
+  EXPECT_EQ(0, cache.CacheSize());
+  TF_ASSERT_OK(cache.Read("/file_0", 8, 16, buffer, &bytes_transferred));
+  EXPECT_GT(num_fetches, fetches_after_first_pass);
+}
+
+TEST(ShardedFileBlockCacheTest, SignatureChangeEvictsFile) {
+  int num_fetches = 0;
+  auto fetcher = [&num_fetches](const string& filename, size_t offset,
+                                size_t n, char* buffer,
+                                size_t* bytes_transferred) {
+    return DeterministicFetcher(&num_fetches, filename, offset, n, buffer,
+                                bytes_transferred);
+  };
+  ShardedFileBlockCache cache(/*num_shards=*/4, /*block_size=*/16,
+                              /*max_bytes=*/1024, /*max_staleness=*/0,
+                              fetcher);
+  char buffer[16];
+  size_t bytes_transferred = 0;
+  EXPECT_TRUE(cache.ValidateAndUpdateFileSignature("/file", 1));
+  TF_ASSERT_OK(cache.Read("/file", 0, 16, buffer, &bytes_transferred));
+  EXPECT_EQ(1, num_fetches);
+  // Same signature: still cached.
+  EXPECT_TRUE(cache.ValidateAndUpdateFileSignature("/file", 1));
+  TF_ASSERT_OK(cache.Read("/file", 0, 16, buffer, &bytes_transferred));
+  EXPECT_EQ(1, num_fetches);
+  // New signature: the cached blocks are dropped and re-fetched.
+  EXPECT_FALSE(cache.ValidateAndUpdateFileSignature("/file", 2));
+  TF_ASSERT_OK(cache.Read("/file", 0, 16, buffer, &bytes_transferred));
+  EXPECT_EQ(2, num_fetches);
+}
+
+TEST(CachingRandomAccessFileTest, ReadThroughCache) {
+  Env* env = Env::Default();
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+
+  int num_fetches = 0;
+  auto fetcher = [env, &num_fetches](const string& filename, size_t offset,
+                                     size_t n, char* buffer,
+                                     size_t* bytes_transferred) {
+    ++num_fetches;
+    *bytes_transferred = 0;
+    std::unique_ptr<RandomAccessFile> file;
+    TF_RETURN_IF_ERROR(env->NewRandomAccessFile(filename, &file));
+    StringPiece result;
+    Status s = file->Read(offset, n, &result, buffer);
+    if (result.size() > 0 && result.data() != buffer) {
+      memmove(buffer, result.data(), result.size());
+    }
+    *bytes_transferred = result.size();
+    return errors::IsOutOfRange(s) ? OkStatus() : s;
+  };
+  ShardedFileBlockCache cache(/*num_shards=*/4, /*block_size=*/4,
+                              /*max_bytes=*/64, /*max_staleness=*/0, fetcher);
+  CachingRandomAccessFile file(fname, &cache);
+
+  char scratch[16];
+  StringPiece result;
+  TF_ASSERT_OK(file.Read(2, 6, &result, scratch));
+  EXPECT_EQ("234567", result);
+  const int fetches_after_first_read = num_fetches;
+  // A second reader of the same bytes is served from the cache.
+  CachingRandomAccessFile file2(fname, &cache);
+  TF_ASSERT_OK(file2.Read(2, 6, &result, scratch));
+  EXPECT_EQ("234567", result);
+  EXPECT_EQ(fetches_after_first_read, num_fetches);
+  // Reading past EOF returns OUT_OF_RANGE with the available bytes.
+  EXPECT_TRUE(errors::IsOutOfRange(file.Read(8, 8, &result, scratch)));
+  EXPECT_EQ("89", result);
+}
+
+TEST(ProcessFileReadCacheTest, DisabledByDefault) {
+  // TF_FILE_READ_CACHE_MAX_BYTES is not set in the test environment, so the
+  // process-wide cache is disabled and files are left untouched.
+  EXPECT_EQ(nullptr, GetProcessFileReadCache());
+
+  Env* env = Env::Default();
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+  RandomAccessFile* raw = file.get();
+  TF_ASSERT_OK(MaybeCacheFileReads(env, fname, &file));
+  EXPECT_EQ(raw, file.get());
+}
+
+}  // namespace
+}  // namespace io
+}  // namespace tsl
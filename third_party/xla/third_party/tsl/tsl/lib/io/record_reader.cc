@@ -61,7 +61,8 @@ RecordReader::RecordReader(RandomAccessFile* file,
       last_read_failed_(false) {
   if (options.buffer_size > 0) {
     input_stream_.reset(new BufferedInputStream(input_stream_.release(),
-                                                options.buffer_size, true));
+                                                options.buffer_size, true,
+                                                options.readahead));
   }
 #if defined(IS_SLIM_BUILD)
   if (options.compression_type != RecordReaderOptions::NONE) {
@@ -46,6 +46,11 @@ struct RecordReaderOptions {
   // compressed files.) Consider using SequentialRecordReader.
   int64_t buffer_size = 0;
 
+  // If readahead is true (and buffer_size is non-zero), the next buffer is
+  // fetched on a background thread while records are consumed from the
+  // current one, overlapping file I/O with record processing.
+  bool readahead = false;
+
   static RecordReaderOptions CreateRecordReaderOptions(
       const string& compression_type);
 
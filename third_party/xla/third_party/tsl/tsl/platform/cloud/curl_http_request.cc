@@ -18,8 +18,10 @@ limitations under the License.
 #include <algorithm>
 
 #include "tsl/lib/gtl/map_util.h"
+#include "tsl/lib/monitoring/sampler.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/macros.h"
+#include "tsl/platform/mutex.h"
 #include "tsl/platform/scanner.h"
 #include "tsl/platform/str_util.h"
 #include "tsl/platform/types.h"
@@ -34,6 +36,36 @@ namespace {
 // Set to 1 to enable verbose debug output from curl.
 constexpr uint64 kVerboseOutput = 0;
 
+// Records the wall time of completed requests, so that connection problems
+// (e.g. repeated TLS handshakes when connection reuse degrades) show up in
+// exported metrics.
+void RecordHttpRequestLatency(HttpRequest::RequestMethod method,
+                              uint64 latency_usec) {
+  static auto* latency_histogram = monitoring::Sampler<1>::New(
+      {"/tensorflow/network/http_request/latency",
+       "HTTP request latency in milliseconds, by request method.", "method"},
+      // Powers-of-two buckets from 1 ms to ~35 minutes.
+      monitoring::Buckets::Exponential(1, 2, 22));
+  latency_histogram->GetCell(HttpRequest::RequestMethodName(method))
+      ->Add(latency_usec / 1000.0);
+}
+
+// The curl share handle leaves locking to the client, since the shared caches
+// are accessed from every thread that performs a request.
+mutex* GetCurlShareLocks() {
+  static mutex* locks = new mutex[CURL_LOCK_DATA_LAST];
+  return locks;
+}
+
+void CurlShareLock(CURL* handle, curl_lock_data data, curl_lock_access access,
+                   void* userptr) {
+  GetCurlShareLocks()[data].lock();
+}
+
+void CurlShareUnlock(CURL* handle, curl_lock_data data, void* userptr) {
+  GetCurlShareLocks()[data].unlock();
+}
+
 // Proxy to the real libcurl implementation.
 class LibCurlProxy : public LibCurl {
  public:
@@ -99,6 +131,30 @@ class LibCurlProxy : public LibCurl {
     return ::curl_easy_cleanup(curl);
   }
 
+  CURLSH* curl_share_handle() override {
+    // Initialized once and deliberately never cleaned up: requests may be in
+    // flight until process exit, and the shared caches must outlive them all.
+    static CURLSH* share_handle = []() -> CURLSH* {
+      CURLSH* handle = ::curl_share_init();
+      if (handle == nullptr) {
+        LOG(ERROR) << "Couldn't initialize a curl share handle; connections "
+                      "will not be reused across HTTP requests.";
+        return nullptr;
+      }
+      ::curl_share_setopt(handle, CURLSHOPT_LOCKFUNC, CurlShareLock);
+      ::curl_share_setopt(handle, CURLSHOPT_UNLOCKFUNC, CurlShareUnlock);
+      // Sharing established connections keeps them alive across request
+      // objects, which is what avoids repeated TCP+TLS handshakes; the DNS
+      // and TLS session caches speed up the connections that do have to be
+      // opened.
+      ::curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+      ::curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+      ::curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      return handle;
+    }();
+    return share_handle;
+  }
+
   char* curl_easy_escape(CURL* curl, const char* str, int length) override {
     return ::curl_easy_escape(curl, str, length);
   }
@@ -140,6 +196,15 @@ CurlHttpRequest::CurlHttpRequest(LibCurl* libcurl, Env* env)
   // Do not use signals for timeouts - does not work in multi-threaded programs.
   CHECK_CURL_OK(libcurl_->curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L));
 
+  // Reuse connections, TLS sessions and DNS resolutions across request
+  // objects, so that bursts of requests (e.g. on block cache misses) don't
+  // pay a TCP and TLS handshake each.
+  CURLSH* share_handle = libcurl_->curl_share_handle();
+  if (share_handle != nullptr) {
+    CHECK_CURL_OK(libcurl_->curl_easy_setopt(
+        curl_, CURLOPT_SHARE, reinterpret_cast<void*>(share_handle)));
+  }
+
   // TODO(b/74351157): Enable HTTP/2.
   CHECK_CURL_OK(libcurl_->curl_easy_setopt(curl_, CURLOPT_HTTP_VERSION,
                                            CURL_HTTP_VERSION_1_1));
@@ -444,7 +509,9 @@ Status CurlHttpRequest::Send() {
     stats_->RecordRequest(this, uri_, method_);
   }
 
+  const uint64 start_usec = env_->NowMicros();
   const CURLcode curl_result = libcurl_->curl_easy_perform(curl_);
+  RecordHttpRequestLatency(method_, env_->NowMicros() - start_usec);
   TF_RETURN_IF_ERROR(CURLcodeToStatus(curl_result, error_buffer));
 
   double written_size = 0;
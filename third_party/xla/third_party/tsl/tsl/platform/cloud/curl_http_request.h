@@ -264,6 +264,14 @@ class LibCurl {
   virtual CURLcode curl_easy_getinfo(CURL* curl, CURLINFO info,
                                      double* value) TF_MUST_USE_RESULT = 0;
   virtual void curl_easy_cleanup(CURL* curl) = 0;
+
+  /// \brief Returns a process-wide share handle that reuses connections, TLS
+  /// sessions and DNS resolutions across requests.
+  ///
+  /// May return nullptr (the default, used in tests), in which case no state
+  /// is shared between requests.
+  virtual CURLSH* curl_share_handle() { return nullptr; }
+
   virtual curl_slist* curl_slist_append(curl_slist* list, const char* str) = 0;
   virtual void curl_slist_free_all(curl_slist* list) = 0;
   virtual char* curl_easy_escape(CURL* curl, const char* str, int length) = 0;
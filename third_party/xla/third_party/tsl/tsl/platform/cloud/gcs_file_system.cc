@@ -41,6 +41,7 @@ limitations under the License.
 #endif
 #include "absl/base/macros.h"
 #include "json/json.h"
+#include "tsl/platform/blocking_counter.h"
 #include "tsl/platform/cloud/curl_http_request.h"
 #include "tsl/platform/cloud/file_block_cache.h"
 #include "tsl/platform/cloud/google_auth_provider.h"
@@ -135,6 +136,17 @@ constexpr char kThrottleBucket[] = "GCS_THROTTLE_BUCKET_SIZE";
 constexpr char kTokensPerRequest[] = "GCS_TOKENS_PER_REQUEST";
 // The environment variable to configure the initial tokens (format: <int64_t>)
 constexpr char kInitialTokens[] = "GCS_INITIAL_TOKENS";
+// The environment variable that controls the maximum number of concurrent
+// ranged GETs a single large read may be split into (format: <int64_t>).
+// A value of 0 or 1 (the default) keeps the sequential single-request path.
+constexpr char kParallelReadConnections[] = "GCS_PARALLEL_READ_CONNECTIONS";
+// Bounds for the adaptive per-connection chunk size used by parallel reads.
+constexpr size_t kMinParallelReadChunkSize = 4 * 1024 * 1024;
+constexpr size_t kMaxParallelReadChunkSize = 64 * 1024 * 1024;
+// The target wall time of a single ranged GET. The adaptive chunk size aims
+// to keep each connection busy for about this long, so slow connections get
+// smaller chunks (more overlap) and fast ones larger chunks (less overhead).
+constexpr double kParallelReadTargetSeconds = 0.5;
 // The environment variable for GCS retry init_delay_time_us (format: <int64_t>)
 constexpr char kRetryConfigInitialDelayTimeUs[] =
     "GCS_RETRY_CONFIG_INIT_DELAY_TIME_US";
@@ -968,6 +980,15 @@ GcsFileSystem::GcsFileSystem(bool make_default_cache) {
   GetEnvVar(kAllowedBucketLocations, SplitByCommaToLowercaseSet,
             &allowed_locations_);
 
+  int64_t parallel_read_connections;
+  if (GetEnvVar(kParallelReadConnections, strings::safe_strto64,
+                &parallel_read_connections) &&
+      parallel_read_connections > 1) {
+    max_parallel_read_connections_ = parallel_read_connections;
+    VLOG(1) << "GCS parallel reads ENABLED, up to "
+            << max_parallel_read_connections_ << " connections per read.";
+  }
+
   StringPiece append_mode;
   GetEnvVar(kAppendMode, StringPieceIdentity, &append_mode);
   if (append_mode == kComposeAppend) {
@@ -1103,6 +1124,53 @@ Status GcsFileSystem::LoadBufferFromGCS(const string& fname, size_t offset,
   profiler::TraceMe activity(
       [fname]() { return absl::StrCat("LoadBufferFromGCS ", fname); });
 
+  if (max_parallel_read_connections_ > 1) {
+    const size_t chunk_size = ParallelReadChunkSize();
+    if (n >= 2 * chunk_size) {
+      // Only fan out when the range is known to lie entirely within the file;
+      // every chunk is then expected to come back complete, which preserves
+      // the short-read (EOF) semantics of the single-request path.
+      GcsFileStat stat;
+      if (stat_cache_->Lookup(fname, &stat) &&
+          offset + n <= static_cast<size_t>(stat.base.length)) {
+        return LoadBufferFromGCSParallel(fname, bucket, object, offset, n,
+                                         chunk_size, buffer, bytes_transferred);
+      }
+    }
+  }
+
+  TF_RETURN_IF_ERROR(LoadChunkFromGCS(fname, bucket, object, offset, n, buffer,
+                                      bytes_transferred));
+
+  size_t bytes_read = *bytes_transferred;
+  activity.AppendMetadata([bytes_read]() {
+    return profiler::TraceMeEncode({{"block_size", bytes_read}});
+  });
+
+  if (bytes_read < n) {
+    // Check stat cache to see if we encountered an interrupted read.
+    GcsFileStat stat;
+    if (stat_cache_->Lookup(fname, &stat)) {
+      if (offset + bytes_read < stat.base.length) {
+        return errors::Internal(strings::Printf(
+            "File contents are inconsistent for file: %s @ %lu.", fname.c_str(),
+            offset));
+      }
+      VLOG(2) << "Successful integrity check for: gs://" << bucket << "/"
+              << object << " @ " << offset;
+    }
+  }
+
+  return OkStatus();
+}
+
+Status GcsFileSystem::LoadChunkFromGCS(const string& fname,
+                                       const string& bucket,
+                                       const string& object, size_t offset,
+                                       size_t n, char* buffer,
+                                       size_t* bytes_transferred) {
+  *bytes_transferred = 0;
+
   std::unique_ptr<HttpRequest> request;
   TF_RETURN_WITH_CONTEXT_IF_ERROR(CreateHttpRequest(&request),
                                   "when reading gs://", bucket, "/", object);
@@ -1124,9 +1192,6 @@ Status GcsFileSystem::LoadBufferFromGCS(const string& fname, size_t offset,
   *bytes_transferred = bytes_read;
   VLOG(1) << "Successful read of gs://" << bucket << "/" << object << " @ "
           << offset << " of size: " << bytes_read;
-  activity.AppendMetadata([bytes_read]() {
-    return profiler::TraceMeEncode({{"block_size", bytes_read}});
-  });
 
   if (stats_ != nullptr) {
     stats_->RecordBlockRetrieved(fname, offset, bytes_read);
@@ -1134,23 +1199,95 @@ Status GcsFileSystem::LoadBufferFromGCS(const string& fname, size_t offset,
 
   throttle_.RecordResponse(bytes_read);
 
-  if (bytes_read < n) {
-    // Check stat cache to see if we encountered an interrupted read.
-    GcsFileStat stat;
-    if (stat_cache_->Lookup(fname, &stat)) {
-      if (offset + bytes_read < stat.base.length) {
-        return errors::Internal(strings::Printf(
-            "File contents are inconsistent for file: %s @ %lu.", fname.c_str(),
-            offset));
-      }
-      VLOG(2) << "Successful integrity check for: gs://" << bucket << "/"
-              << object << " @ " << offset;
+  return OkStatus();
+}
+
+Status GcsFileSystem::LoadBufferFromGCSParallel(
+    const string& fname, const string& bucket, const string& object,
+    size_t offset, size_t n, size_t chunk_size, char* buffer,
+    size_t* bytes_transferred) {
+  *bytes_transferred = 0;
+
+  // Cap the fan-out at the configured connection limit by growing the chunk
+  // size instead.
+  size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+  if (num_chunks > static_cast<size_t>(max_parallel_read_connections_)) {
+    num_chunks = max_parallel_read_connections_;
+    chunk_size = (n + num_chunks - 1) / num_chunks;
+  }
+  VLOG(1) << "Parallel read of gs://" << bucket << "/" << object << " @ "
+          << offset << " of size " << n << " using " << num_chunks
+          << " connections with chunk size " << chunk_size;
+
+  std::vector<Status> statuses(num_chunks);
+  std::vector<size_t> chunk_bytes(num_chunks, 0);
+  auto read_chunk = [&](size_t i) {
+    const size_t chunk_start = i * chunk_size;
+    const size_t this_chunk_size = std::min(chunk_size, n - chunk_start);
+    const uint64 start_usec = Env::Default()->NowMicros();
+    statuses[i] =
+        LoadChunkFromGCS(fname, bucket, object, offset + chunk_start,
+                         this_chunk_size, buffer + chunk_start,
+                         &chunk_bytes[i]);
+    if (statuses[i].ok()) {
+      RecordParallelReadThroughput(chunk_bytes[i],
+                                   Env::Default()->NowMicros() - start_usec);
     }
+  };
+
+  BlockingCounter counter(num_chunks - 1);
+  std::vector<std::unique_ptr<Thread>> threads;
+  threads.reserve(num_chunks - 1);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    threads.emplace_back(Env::Default()->StartThread(
+        ThreadOptions(), "gcs_parallel_read", [&read_chunk, &counter, i]() {
+          read_chunk(i);
+          counter.DecrementCount();
+        }));
   }
+  // The first chunk is read on the calling thread.
+  read_chunk(0);
+  counter.Wait();
+  threads.clear();
 
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    TF_RETURN_IF_ERROR(statuses[i]);
+    total_bytes += chunk_bytes[i];
+  }
+  if (total_bytes < n) {
+    // The caller checked that the range lies within the file, so every chunk
+    // must come back complete.
+    return errors::Internal(strings::Printf(
+        "File contents are inconsistent for file: %s @ %lu.", fname.c_str(),
+        offset));
+  }
+  *bytes_transferred = total_bytes;
   return OkStatus();
 }
 
+size_t GcsFileSystem::ParallelReadChunkSize() {
+  mutex_lock l(parallel_read_mu_);
+  const double target_bytes =
+      connection_bytes_per_sec_ * kParallelReadTargetSeconds;
+  return std::min(kMaxParallelReadChunkSize,
+                  std::max(kMinParallelReadChunkSize,
+                           static_cast<size_t>(target_bytes)));
+}
+
+void GcsFileSystem::RecordParallelReadThroughput(size_t bytes,
+                                                 uint64 elapsed_usec) {
+  if (elapsed_usec == 0) {
+    return;
+  }
+  const double bytes_per_sec = bytes * 1000000.0 / elapsed_usec;
+  mutex_lock l(parallel_read_mu_);
+  // A moving average so that the chunk size tracks current network conditions
+  // rather than a startup measurement.
+  connection_bytes_per_sec_ =
+      0.75 * connection_bytes_per_sec_ + 0.25 * bytes_per_sec;
+}
+
 /// Initiates a new upload session.
 Status GcsFileSystem::CreateNewUploadSession(
     uint64 start_offset, const std::string& object_to_upload,
@@ -289,6 +289,10 @@ class GcsFileSystem : public FileSystem {
       size_t block_size, size_t max_bytes, uint64 max_staleness);
 
   /// Loads file contents from GCS for a given filename, offset, and length.
+  ///
+  /// When parallel reads are enabled (see GCS_PARALLEL_READ_CONNECTIONS) and
+  /// the range is large and known to lie within the file, the read is split
+  /// into concurrent ranged GETs with an adaptive per-connection chunk size.
   virtual Status LoadBufferFromGCS(const string& fname, size_t offset, size_t n,
                                    char* buffer, size_t* bytes_transferred);
 
@@ -407,6 +411,27 @@ class GcsFileSystem : public FileSystem {
   // Clear all the caches related to the file with name `filename`.
   void ClearFileCaches(const string& fname);
 
+  /// Issues a single ranged GET for [offset, offset + n) of a GCS object.
+  Status LoadChunkFromGCS(const string& fname, const string& bucket,
+                          const string& object, size_t offset, size_t n,
+                          char* buffer, size_t* bytes_transferred);
+
+  /// Loads [offset, offset + n) with concurrent ranged GETs of `chunk_size`
+  /// bytes each. The caller must ensure that the range lies entirely within
+  /// the file, so every chunk is expected to come back complete.
+  Status LoadBufferFromGCSParallel(const string& fname, const string& bucket,
+                                   const string& object, size_t offset,
+                                   size_t n, size_t chunk_size, char* buffer,
+                                   size_t* bytes_transferred);
+
+  /// Returns the current adaptive chunk size for parallel reads, derived from
+  /// the observed per-connection throughput.
+  size_t ParallelReadChunkSize();
+
+  /// Folds the observed throughput of one ranged GET into the adaptive
+  /// per-connection throughput estimate.
+  void RecordParallelReadThroughput(size_t bytes, uint64 elapsed_usec);
+
   mutex mu_;
   std::unique_ptr<AuthProvider> auth_provider_ TF_GUARDED_BY(mu_);
   std::shared_ptr<HttpRequest::Factory> http_request_factory_;
@@ -436,6 +461,18 @@ class GcsFileSystem : public FileSystem {
   std::unordered_set<string> allowed_locations_;
   bool compose_append_;
 
+  // The maximum number of concurrent ranged GETs a single large read may be
+  // split into. A value of 0 or 1 keeps the sequential single-request path.
+  int64_t max_parallel_read_connections_ = 1;
+
+  // Protects the adaptive throughput estimate for parallel reads.
+  mutex parallel_read_mu_;
+  // Exponentially-weighted moving average of the observed throughput of a
+  // single GCS connection, in bytes per second. Used to size ranged GETs so
+  // that each connection stays busy for roughly a fixed wall time.
+  double connection_bytes_per_sec_ TF_GUARDED_BY(parallel_read_mu_) =
+      32.0 * 1024 * 1024;
+
   GcsStatsInterface* stats_ = nullptr;  // Not owned.
 
   // Additional header material to be transmitted with all GCS requests